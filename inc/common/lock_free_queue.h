@@ -0,0 +1,257 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INC_COMMON_LOCK_FREE_QUEUE_H_
+#define INC_COMMON_LOCK_FREE_QUEUE_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+
+#include "common/blocking_queue.h"
+
+static const size_t kQueueCacheLineSize = 64;
+
+// Bounded multi-producer multi-consumer ring with the interface of BlockingQueue, so any BlockingQueue user can
+// switch to it by changing the type. Producers and consumers claim slots with a CAS on their own counter and hand
+// the slots over through a per-slot sequence number, push and pop take no lock and allocate nothing.
+// A thread that finds the ring full (empty) yields for a while, then parks on a condition variable;
+// the mutex is only taken when some thread is parked.
+template <typename T>
+class LockFreeQueue {
+ public:
+  explicit LockFreeQueue(uint32_t max_size = kDefaultMaxQueueSize)
+      : capacity_((max_size == 0) ? 1 : max_size), slots_(nullptr), is_stoped_(false) {
+    storage_.reset(new char[capacity_ * sizeof(Slot) + kQueueCacheLineSize]);
+    // slots start on a cache line, so neighbouring slots written by different threads share as few lines as possible
+    uintptr_t addr = reinterpret_cast<uintptr_t>(storage_.get());
+    addr = (addr + kQueueCacheLineSize - 1) / kQueueCacheLineSize * kQueueCacheLineSize;
+    slots_ = reinterpret_cast<Slot *>(addr);
+    for (uint64_t i = 0; i < capacity_; ++i) {
+      Slot *slot = new (&slots_[i]) Slot();
+      slot->sequence.store(i * 2, std::memory_order_relaxed);
+    }
+  }
+
+  ~LockFreeQueue() {
+    for (uint64_t i = 0; i < capacity_; ++i) {
+      slots_[i].~Slot();
+    }
+  }
+
+  LockFreeQueue(const LockFreeQueue &) = delete;
+  LockFreeQueue &operator=(const LockFreeQueue &) = delete;
+
+  bool Pop(T &item) {
+    for (uint32_t spin = 0;; ++spin) {
+      if (is_stoped_.load(std::memory_order_acquire)) {
+        return false;
+      }
+      if (TryPop(item)) {
+        WakeUp(full_waiters_, full_cond_);
+        return true;
+      }
+      if (spin < kSpinCount) {
+        std::this_thread::yield();
+        continue;
+      }
+      Park(empty_waiters_, empty_cond_, [this]() { return CanPop(); });
+    }
+  }
+
+  bool Push(const T &item, bool is_wait = true) {
+    for (uint32_t spin = 0;; ++spin) {
+      if (is_stoped_.load(std::memory_order_acquire)) {
+        return false;
+      }
+      if (TryPush(item)) {
+        WakeUp(empty_waiters_, empty_cond_);
+        return true;
+      }
+      if (!is_wait && IsFull()) {
+        return false;
+      }
+      if (spin < kSpinCount) {
+        std::this_thread::yield();
+        continue;
+      }
+      Park(full_waiters_, full_cond_, [this]() { return CanPush(); });
+    }
+  }
+
+  void Stop() {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      is_stoped_.store(true, std::memory_order_release);
+    }
+
+    full_cond_.notify_all();
+    empty_cond_.notify_all();
+  }
+
+  void Restart() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    is_stoped_.store(false, std::memory_order_release);
+  }
+
+  // if the queue stop , the function to release the unprocessed items will be call.
+  // Unlike BlockingQueue the items are moved out of the queue.
+  std::list<T> GetRemainItems() {
+    std::list<T> items;
+    if (!is_stoped_.load(std::memory_order_acquire)) {
+      return items;
+    }
+
+    T item;
+    while (TryPop(item)) {
+      items.push_back(std::move(item));
+    }
+    return items;
+  }
+
+  bool IsFull() {
+    uint64_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+    uint64_t enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+    return (enqueue_pos >= dequeue_pos) && (enqueue_pos - dequeue_pos >= capacity_);
+  }
+
+  void Clear() {
+    T item;
+    while (TryPop(item)) {
+    }
+    WakeUp(full_waiters_, full_cond_);
+  }
+
+ private:
+  static const uint32_t kSpinCount = 64;
+
+  struct Slot {
+    // 2 * pos: the slot may be written by the producer of pos, 2 * pos + 1: it may be read by the consumer of pos.
+    // Doubling keeps the two states apart even if the ring holds one item.
+    std::atomic<uint64_t> sequence;
+    T data;
+    char pad[kQueueCacheLineSize - (sizeof(std::atomic<uint64_t>) + sizeof(T)) % kQueueCacheLineSize];
+  };
+
+  bool TryPush(const T &item) {
+    uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    for (;;) {
+      slot = &slots_[pos % capacity_];
+      uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+      int64_t diff = static_cast<int64_t>(sequence - pos * 2);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // the consumer of pos - capacity_ has not released the slot, the ring is full
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    slot->data = item;
+    slot->sequence.store(pos * 2 + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool TryPop(T &item) {
+    uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    for (;;) {
+      slot = &slots_[pos % capacity_];
+      uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+      int64_t diff = static_cast<int64_t>(sequence - (pos * 2 + 1));
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // the producer of pos has not filled the slot, the ring is empty
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    item = std::move(slot->data);
+    // do not keep the item alive in the ring
+    slot->data = T();
+    slot->sequence.store((pos + capacity_) * 2, std::memory_order_release);
+    return true;
+  }
+
+  bool CanPush() const {
+    uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    uint64_t sequence = slots_[pos % capacity_].sequence.load(std::memory_order_acquire);
+    return static_cast<int64_t>(sequence - pos * 2) >= 0;
+  }
+
+  bool CanPop() const {
+    uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    uint64_t sequence = slots_[pos % capacity_].sequence.load(std::memory_order_acquire);
+    return static_cast<int64_t>(sequence - (pos * 2 + 1)) >= 0;
+  }
+
+  template <typename Ready>
+  void Park(std::atomic<uint32_t> &waiters, std::condition_variable &cond, Ready ready) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    (void)waiters.fetch_add(1, std::memory_order_seq_cst);
+    // pairs with the fence in WakeUp: either the waker sees the waiter, or the waiter sees the new state
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    cond.wait(lock, [this, &ready]() { return is_stoped_.load(std::memory_order_acquire) || ready(); });
+    (void)waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  void WakeUp(std::atomic<uint32_t> &waiters, std::condition_variable &cond) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    {
+      // the waiter checks its condition under the mutex, taking it here keeps the notify from being lost
+      std::lock_guard<std::mutex> lock(mutex_);
+    }
+    cond.notify_one();
+  }
+
+  const uint64_t capacity_;
+  std::unique_ptr<char[]> storage_;
+  Slot *slots_;
+
+  // producers and consumers update their own counter, keep the two on different cache lines
+  char pad0_[kQueueCacheLineSize];
+  std::atomic<uint64_t> enqueue_pos_{0};
+  char pad1_[kQueueCacheLineSize - sizeof(std::atomic<uint64_t>)];
+  std::atomic<uint64_t> dequeue_pos_{0};
+  char pad2_[kQueueCacheLineSize - sizeof(std::atomic<uint64_t>)];
+
+  std::atomic<bool> is_stoped_;
+  std::atomic<uint32_t> empty_waiters_{0};
+  std::atomic<uint32_t> full_waiters_{0};
+  std::mutex mutex_;
+  std::condition_variable empty_cond_;
+  std::condition_variable full_cond_;
+};
+
+#endif  // INC_COMMON_LOCK_FREE_QUEUE_H_
@@ -41,11 +41,29 @@ const char *const OPTION_EXEC_DUMP_PATH = "ge.exec.dumpPath";
 // Hccl flag, if ge.exec.hcclFlag =1, it means load plugin for opskernel, else:ge.exec.hcclFlag =0
 const char *const OPTION_EXEC_HCCL_FLAG = "ge.exec.hcclFlag";
 const char *const OPTION_EXEC_ATOMIC_FLAG = "ge.exec.enable_atomic";
+// Number of requests a loaded model keeps in flight, ge.exec.modelPipelineDepth >= 2 overlaps the input and output
+// copies of neighbouring requests with the execution, else the requests run one after another
+const char *const OPTION_EXEC_MODEL_PIPELINE_DEPTH = "ge.exec.modelPipelineDepth";
+// Number of the worker threads the graph builds and model loads of the process share, bounded by the hardware
+// concurrency, default is the hardware concurrency
+const char *const OPTION_EXEC_THREAD_NUM = "ge.exec.threadNum";
+// Chrome trace file the spans of the graph passes, builds, loads and runs are written to at finalization, the
+// environment variable GE_TRACE_FILE is used if it is not set. Default value is "", which disables the tracing
+const char *const OPTION_EXEC_TRACE_FILE = "ge.exec.traceFile";
 
 // Option key: memory init
 const char *const GRAPH_MEMORY_MAX_SIZE = "ge.graphMemoryMaxSize";
 const char *const VARIABLE_MEMORY_MAX_SIZE = "ge.variableMemoryMaxSize";
 
+// Configure the directory of the compiled graph cache by Session constructor options param,
+// a graph built before with the same content and options is loaded from it instead of being built again,
+// the directory may be shared by processes. Default value is "", which disables the cache
+const std::string GRAPH_CACHE_DIR = "ge.graphCacheDir";
+
+// Configure the max size in bytes of the compiled graph cache by Session constructor options param,
+// the least recently used models are evicted beyond it, default value is "2147483648"
+const std::string GRAPH_CACHE_MAX_SIZE = "ge.graphCacheMaxSize";
+
 // Configure stream num by Session constructor options param,
 // its value should be int32_t type, default value is "1"
 const std::string STREAM_NUM = "ge.streamNum";
@@ -44,13 +44,16 @@ inline bool IsLogEnable(int module_name, int log_level) noexcept {
   return false;
 }
 
+// the stages are recorded as spans instead of logged when ge::Tracer is on, stage names must be string literals
 #define GE_TIMESTAMP_START(stage) uint64_t startUsec_##stage = ge::GetCurrentTimestap()
 
-#define GE_TIMESTAMP_END(stage, stage_name)                                           \
-  do {                                                                                \
-    uint64_t endUsec_##stage = ge::GetCurrentTimestap();                              \
-    GEEVENT("[GEPERFTRACE] The time cost of %s is [%lu] micro second.", (stage_name), \
-            (endUsec_##stage - startUsec_##stage));                                   \
+#define GE_TIMESTAMP_END(stage, stage_name)                                             \
+  do {                                                                                  \
+    uint64_t costUsec_##stage = ge::TraceStage((stage_name), startUsec_##stage);        \
+    if (!ge::IsTraceOn()) {                                                             \
+      GEEVENT("[GEPERFTRACE] The time cost of %s is [%lu] micro second.", (stage_name), \
+              costUsec_##stage);                                                        \
+    }                                                                                   \
   } while (0);
 
 #define GE_TIMESTAMP_CALLNUM_START(stage)                \
@@ -60,13 +63,17 @@ inline bool IsLogEnable(int module_name, int log_level) noexcept {
 
 #define GE_TIMESTAMP_RESTART(stage) (startUsec_##stage = ge::GetCurrentTimestap())
 
-#define GE_TIMESTAMP_ADD(stage)                                   \
-  time_of##stage += ge::GetCurrentTimestap() - startUsec_##stage; \
+#define GE_TIMESTAMP_ADD(stage)                                \
+  time_of##stage += ge::TraceStage(#stage, startUsec_##stage); \
   call_num_of##stage++
 
-#define GE_TIMESTAMP_CALLNUM_END(stage, stage_name)                                                                 \
-  GEEVENT("[GEPERFTRACE] The time cost of %s is [%lu] micro second, call num is %lu", (stage_name), time_of##stage, \
-          call_num_of##stage)
+#define GE_TIMESTAMP_CALLNUM_END(stage, stage_name)                                                                \
+  do {                                                                                                             \
+    if (!ge::IsTraceOn()) {                                                                                        \
+      GEEVENT("[GEPERFTRACE] The time cost of %s is [%lu] micro second, call num is %lu", (stage_name),            \
+              time_of##stage, call_num_of##stage);                                                                 \
+    }                                                                                                              \
+  } while (0)
 
 #define GE_LOG_ERROR(MOD_NAME, ERROR_CODE, fmt, ...)                                           \
   dlog_error(static_cast<int>(MOD_NAME), "%s: ErrorNo: %d(%s) " fmt, __FUNCTION__, ERROR_CODE, \
@@ -20,6 +20,8 @@
 #include <memory>
 #include <string>
 
+#include <google/protobuf/message_lite.h>
+
 #include "common/fmk_types.h"
 #include "common/helper/om_file_helper.h"
 #include "common/types.h"
@@ -34,7 +36,15 @@ class ModelHelper {
 
   Status SaveToOmModel(const GeModelPtr &ge_model, const SaveParam &save_param, const std::string &output_file);
   Status SaveOriginalGraphToOmModel(const ge::Graph &graph, const std::string &output_file);
-  Status LoadModel(const ge::ModelData &model_data);
+  ///
+  /// @ingroup ge
+  /// @brief Load a GeModel from om model data
+  /// @param [in] model_data om model data
+  /// @param [in] refer_weights refer to the weights in the model data instead of copying them, the caller keeps
+  ///             the model data alive until GeModel::ClearWeightRef, e.g. until the weights are on the device
+  /// @return SUCCESS / others
+  ///
+  Status LoadModel(const ge::ModelData &model_data, bool refer_weights = false);
 
   ModelFileHeader *GetFileHeader() { return file_header_; }
 
@@ -49,6 +59,7 @@ class ModelHelper {
   // Encrypted model need delete temp model and unencrypted model need not delete model
   uint8_t *model_addr_tmp_ = nullptr;
   uint32_t model_len_tmp_ = 0;
+  bool refer_weights_ = false;
   GeModelPtr model_;
 
   ModelHelper(const ModelHelper &);
@@ -62,6 +73,9 @@ class ModelHelper {
   Status ReleaseLocalModelData() noexcept;
   Status SaveModelPartition(std::shared_ptr<OmFileSaveHelper> &om_file_save_helper, ModelPartitionType type,
                             const uint8_t *data, size_t size);
+  // the message is serialized into the file when it is saved, it must outlive the save
+  Status SaveModelPartition(std::shared_ptr<OmFileSaveHelper> &om_file_save_helper, ModelPartitionType type,
+                            const google::protobuf::MessageLite &message);
 };
 }  // namespace ge
 #endif  // INC_FRAMEWORK_COMMON_HELPER_MODEL_HELPER_H_
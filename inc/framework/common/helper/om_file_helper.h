@@ -17,6 +17,7 @@
 #ifndef INC_FRAMEWORK_COMMON_HELPER_OM_FILE_HELPER_H_
 #define INC_FRAMEWORK_COMMON_HELPER_OM_FILE_HELPER_H_
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -40,6 +41,22 @@ struct OmFileContext {
   uint32_t model_data_len_;
 };
 
+///
+/// Destination of a partition that is written while the file is saved, every Write appends to the partition
+///
+class PartitionOutput {
+ public:
+  virtual ~PartitionOutput() = default;
+
+  virtual Status Write(const void *data, size_t size) = 0;
+};
+
+///
+/// Writes the content of a partition into the output, it may run on any thread while the other partitions are
+/// written. It must write exactly the size the partition is added with.
+///
+using PartitionProducer = std::function<Status(PartitionOutput &output)>;
+
 struct SaveParam {
   int32_t encode_mode;
   std::string ek_file;
@@ -78,6 +95,16 @@ class OmFileSaveHelper {
 
   Status AddPartition(ModelPartition &partition);
 
+  ///
+  /// @ingroup domi_omg
+  /// @brief add a partition whose content is only produced when the model is saved, so it is never held in memory
+  /// @param [in] type partition type
+  /// @param [in] size size of the content in bytes
+  /// @param [in] producer writes the content
+  /// @return Status result of function
+  ///
+  Status AddPartition(ModelPartitionType type, uint32_t size, const PartitionProducer &producer);
+
   const vector<ModelPartition> &GetModelPartitions() const;
 
   Status SaveModel(const SaveParam &save_param, const char *target_file);
@@ -86,6 +113,8 @@ class OmFileSaveHelper {
 
   ModelFileHeader model_header_;
   OmFileContext context_;
+  // one per partition of context_, empty for the partitions added with their data
+  vector<PartitionProducer> partition_producers_;
 };
 }  // namespace ge
 #endif  // INC_FRAMEWORK_COMMON_HELPER_OM_FILE_HELPER_H_
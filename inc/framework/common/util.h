@@ -330,6 +330,22 @@ std::string ToString(const google::protobuf::RepeatedField<T> &rpd_field) {
 ///
 uint64_t GetCurrentTimestap();
 
+///
+/// @ingroup domi_common
+/// @brief Whether the stages are traced instead of logged, see GE_TIMESTAMP_END.
+/// @return true if the tracer is on
+///
+bool IsTraceOn();
+
+///
+/// @ingroup domi_common
+/// @brief Ends a stage, it is recorded as a span if the tracer is on.
+/// @param [in] name name of the stage, a string literal
+/// @param [in] start timestamp the stage started
+/// @return Time cost of the stage, in microseconds (US)
+///
+uint64_t TraceStage(const char *name, uint64_t start);
+
 ///
 /// @ingroup domi_common
 /// @brief Check whether the product of two int64 numbers exceeds the int64 range.
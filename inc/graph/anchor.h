@@ -88,6 +88,8 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY Anchor : public std::enable
  public:
   // Get all peer anchors connected to current anchor
   Vistor<AnchorPtr> GetPeerAnchors() const;
+  // Get the number of peer anchors, without building the vector
+  size_t GetPeerAnchorsSize() const { return peer_anchors_.size(); }
   // Get the first peer anchor
   AnchorPtr GetFirstPeerAnchor() const;
 
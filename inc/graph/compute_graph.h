@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "detail/attributes_holder.h"
+#include "detail/node_storage.h"
 #include "graph/anchor.h"
 #include "graph/node.h"
 #include "graph/op_desc.h"
@@ -215,7 +216,8 @@ class ComputeGraph : public std::enable_shared_from_this<ComputeGraph>, public A
   friend class ModelSerializeImp;
   friend class GraphDebugImp;
   friend class OnnxUtils;
-  std::vector<NodePtr> nodes_;
+  friend class NodeStorage;
+  NodeStorage nodes_;
   std::vector<NodePtr> input_nodes_;
   std::vector<std::shared_ptr<ComputeGraph>> sub_graph_;
   std::string name_;
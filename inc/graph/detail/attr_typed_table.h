@@ -0,0 +1,119 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INC_GRAPH_DETAIL_ATTR_TYPED_TABLE_H_
+#define INC_GRAPH_DETAIL_ATTR_TYPED_TABLE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "graph/detail/attributes_holder.h"
+
+namespace ge {
+///
+/// Interned attr keys. Every name listed in ge_attr_define.def gets an id when the library is
+/// loaded. The id is found by the address of the constant, so a caller passing the constant does
+/// not pay for hashing the key, other strings are found by their content.
+/// The keys are only registered during static initialization, after that the registry is read only.
+///
+class AttrKeyRegistry {
+ public:
+  static AttrKeyRegistry &Instance();
+
+  void Register(const std::string *const *names, size_t num);
+
+  ///
+  /// Find the id of a key by its address, or else by its content.
+  ///
+  bool Find(const std::string &name, uint32_t &id) const;
+
+ private:
+  AttrKeyRegistry() = default;
+
+  std::unordered_map<const std::string *, uint32_t> address_ids_;
+  std::unordered_map<std::string, uint32_t> content_ids_;
+};
+
+class AttrKeyRegistrar {
+ public:
+  AttrKeyRegistrar(const std::string *const *names, size_t num) {
+    AttrKeyRegistry::Instance().Register(names, num);
+  }
+};
+
+///
+/// Typed copy of the int, float, bool and list int attrs with interned keys of an attr holder.
+/// The proto attr map stays complete and is what the serializer and the dumpers read. The table
+/// is a cache of it: the holder marks it stale whenever it hands out its mutable proto map, and
+/// the next read rebuilds it. AttrHolder::WriteAttrMapItem and DelAttr, the write path of
+/// AttrHolder and AttrUtils, bring a table that was in sync before the write back in sync
+/// with the written item, so a single write does not cost a rebuild.
+/// Holders sharing a proto map, as shallow copies of an OpDesc do, share the table as well.
+///
+class AttrTypedTable {
+ public:
+  ///
+  /// Read an attr, the table must be in sync. A miss does not mean the attr is absent.
+  ///
+  bool Get(const std::string &name, int64_t &value) const;
+  bool Get(const std::string &name, float &value) const;
+  bool Get(const std::string &name, bool &value) const;
+  bool Get(const std::string &name, std::vector<int64_t> &value) const;
+
+  bool InSync() const { return in_sync_.load(std::memory_order_acquire); }
+
+  ///
+  /// Rebuild a stale table from the proto map. Safe to call from concurrent readers.
+  ///
+  void Sync(const ProtoAttrMap &attr_map);
+
+  void MarkStale() { in_sync_.store(false, std::memory_order_release); }
+
+  ///
+  /// Take a write of the item name of a table that was in sync before the write, attr_def is
+  /// nullptr when the item was erased. The table is in sync afterwards.
+  ///
+  void Follow(const std::string &name, const proto::AttrDef *attr_def);
+
+ private:
+  enum ValueKind : uint8_t { kInt, kFloat, kBool, kListInt };
+
+  struct Entry {
+    uint32_t id;
+    ValueKind kind;
+    int64_t int_value;
+    float float_value;
+    bool bool_value;
+    std::vector<int64_t> list_int_value;
+  };
+
+  static bool IdLess(const Entry &entry, uint32_t id);
+  const Entry *Find(const std::string &name, ValueKind kind) const;
+  void Update(uint32_t id, const proto::AttrDef &attr_def);
+  void Erase(uint32_t id);
+
+  // sorted by id
+  std::vector<Entry> entries_;
+  std::atomic<bool> in_sync_{false};
+  std::mutex sync_mutex_;
+};
+}  // namespace ge
+
+#endif  // INC_GRAPH_DETAIL_ATTR_TYPED_TABLE_H_
@@ -17,6 +17,7 @@
 #ifndef INC_GRAPH_DETAIL_ATTRIBUTES_HOLDER_H_
 #define INC_GRAPH_DETAIL_ATTRIBUTES_HOLDER_H_
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -39,6 +40,7 @@ class Map;
 namespace ge {
 using std::string;
 class GeAttrValue;
+class AttrTypedTable;
 
 namespace proto {
 class AttrDef;
@@ -137,6 +139,12 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY AttrHolder {
   const std::unordered_set<string> GetAllAttrNames() const;
   const std::map<string, GeAttrValue> GetAllAttrs() const;
 
+  ///
+  /// The write path of the attr map: write the item of name, added when absent, and keep typed_attrs_
+  /// in step with it. Writes through MutableAttrMap() alone leave typed_attrs_ stale.
+  ///
+  bool WriteAttrMapItem(const string &name, const std::function<void(proto::AttrDef &)> &write);
+
   virtual ProtoAttrMapHelper MutableAttrMap() = 0;
   virtual ConstProtoAttrMapHelper GetAttrMap() const = 0;
 
@@ -146,6 +154,9 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY AttrHolder {
 
   std::vector<string> requiredAttrs_;
 
+  // Only set by holders that mark it stale in MutableAttrMap(), see AttrTypedTable
+  std::shared_ptr<AttrTypedTable> typed_attrs_;
+
  private:
   AnyMap extAttrs_;
 };
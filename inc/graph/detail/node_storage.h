@@ -0,0 +1,114 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INC_GRAPH_DETAIL_NODE_STORAGE_H_
+#define INC_GRAPH_DETAIL_NODE_STORAGE_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ge {
+class Node;
+using NodePtr = std::shared_ptr<Node>;
+class OpDesc;
+
+///
+/// Ordered node list of a ComputeGraph. Every node owns a slot, and the slots
+/// are linked in the node order, so push back, remove, contains and find are
+/// O(1) amortized and inserting in front of the index-th node is O(index).
+/// The slot and name indexes are kept up to date by the modifying methods
+/// and by the renames of the nodes, the const methods only read them.
+///
+class NodeStorage {
+ public:
+  NodeStorage() = default;
+  ~NodeStorage() = default;
+
+  size_t size() const { return node_num_; }
+  bool empty() const { return node_num_ == 0; }
+
+  ///
+  /// Get the nodes in order, O(n).
+  ///
+  std::vector<NodePtr> GetNodes() const;
+
+  ///
+  /// Get the first node, nullptr if empty.
+  ///
+  NodePtr Front() const;
+
+  void PushBack(const NodePtr &node);
+
+  ///
+  /// Insert the node in front of the index-th node, O(index).
+  ///
+  void Insert(size_t index, const NodePtr &node);
+
+  bool Remove(const NodePtr &node);
+
+  bool Contains(const NodePtr &node) const;
+
+  ///
+  /// Find the node named `name`. A graph normally has one node of a name,
+  /// if there are more the first of them in order is returned. The name the
+  /// node is indexed by is checked against its current name, a stale entry
+  /// falls back to an O(n) scan.
+  ///
+  NodePtr Find(const std::string &name) const;
+
+  void Clear();
+
+  ///
+  /// Called by OpDesc::SetName, moves the node of the op desc to its new
+  /// name in the index of the graph holding it.
+  ///
+  static void OnOpDescRenamed(const OpDesc &op_desc);
+
+  ///
+  /// Called by Node::UpdateOpDesc, indexes the node by the name of its new
+  /// op desc in the graph holding it.
+  ///
+  static void OnOpDescUpdated(const NodePtr &node);
+
+ private:
+  struct Slot {
+    NodePtr node;
+    // name the node is indexed by
+    std::string name;
+    size_t prev;
+    size_t next;
+  };
+
+  size_t AllocSlot(const NodePtr &node);
+  void Link(size_t pos, size_t next);
+  void Rename(const NodePtr &node);
+  void EraseName(const std::string &name, size_t pos);
+
+  std::vector<Slot> slots_;
+  std::vector<size_t> free_slots_;
+  size_t head_ = kNoSlot;
+  size_t tail_ = kNoSlot;
+  std::unordered_map<const Node *, size_t> slot_index_;
+  std::unordered_multimap<std::string, size_t> name_index_;
+  size_t node_num_ = 0;
+
+  static const size_t kNoSlot;
+};
+}  // namespace ge
+
+#endif  // INC_GRAPH_DETAIL_NODE_STORAGE_H_
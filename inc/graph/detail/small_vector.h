@@ -0,0 +1,128 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INC_GRAPH_DETAIL_SMALL_VECTOR_H_
+#define INC_GRAPH_DETAIL_SMALL_VECTOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace ge {
+///
+/// Vector of trivially copyable values that keeps up to N elements inline and
+/// only goes to the heap beyond that. Used for shape dims, where almost every
+/// shape has no more than a handful of dimensions.
+///
+template <typename T, size_t N>
+class SmallVector {
+  static_assert(std::is_trivially_copyable<T>::value, "SmallVector only holds trivially copyable types");
+
+ public:
+  SmallVector() = default;
+  ~SmallVector() = default;
+
+  SmallVector(const SmallVector &other) { assign(other.begin(), other.end()); }
+
+  SmallVector(SmallVector &&other) noexcept { MoveFrom(other); }
+
+  SmallVector &operator=(const SmallVector &other) {
+    if (&other != this) {
+      assign(other.begin(), other.end());
+    }
+    return *this;
+  }
+
+  SmallVector &operator=(SmallVector &&other) noexcept {
+    if (&other != this) {
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  T *data() { return heap_ != nullptr ? heap_.get() : inline_; }
+  const T *data() const { return heap_ != nullptr ? heap_.get() : inline_; }
+
+  T *begin() { return data(); }
+  T *end() { return data() + size_; }
+  const T *begin() const { return data(); }
+  const T *end() const { return data() + size_; }
+
+  T &operator[](size_t idx) { return data()[idx]; }
+  const T &operator[](size_t idx) const { return data()[idx]; }
+
+  void clear() { size_ = 0; }
+
+  void reserve(size_t capacity) {
+    if (capacity <= capacity_) {
+      return;
+    }
+    std::unique_ptr<T[]> heap(new T[capacity]);
+    std::copy(begin(), end(), heap.get());
+    heap_ = std::move(heap);
+    capacity_ = capacity;
+  }
+
+  void push_back(const T &value) {
+    if (size_ == capacity_) {
+      reserve(capacity_ * 2);
+    }
+    data()[size_++] = value;
+  }
+
+  void resize(size_t size) {
+    reserve(size);
+    if (size > size_) {
+      std::fill(data() + size_, data() + size, T());
+    }
+    size_ = size;
+  }
+
+  template <typename It>
+  void assign(It first, It last) {
+    clear();
+    reserve(static_cast<size_t>(std::distance(first, last)));
+    for (; first != last; ++first) {
+      data()[size_++] = *first;
+    }
+  }
+
+ private:
+  void MoveFrom(SmallVector &other) {
+    if (other.heap_ != nullptr) {
+      heap_ = std::move(other.heap_);
+      capacity_ = other.capacity_;
+      size_ = other.size_;
+      other.capacity_ = N;
+    } else {
+      assign(other.begin(), other.end());
+    }
+    other.size_ = 0;
+  }
+
+  T inline_[N];
+  std::unique_ptr<T[]> heap_;
+  size_t size_ = 0;
+  size_t capacity_ = N;
+};
+}  // namespace ge
+
+#endif  // INC_GRAPH_DETAIL_SMALL_VECTOR_H_
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "detail/attributes_holder.h"
+#include "detail/small_vector.h"
 #include "graph/buffer.h"
 #include "graph/ge_error_codes.h"
 #include "graph/types.h"
@@ -49,12 +50,22 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeShape {
   GeShape &operator=(GeShape &&other);
 
  private:
+  static const size_t kInlineDimNum = 8;
+
+  // Only set while the shape references the ShapeDef of a tensor descriptor,
+  // a standalone shape keeps its dims inline in dims_.
+  // The inline dims changed the size of GeShape and GeTensorDesc, see RELEASE.md
   GeIrProtoHelper<proto::ShapeDef> shape_def_;
+  SmallVector<int64_t, kInlineDimNum> dims_;
   friend class GeTensorDesc;
   // Create geshape from proto obj
   GeShape(const ProtoMsgOwner &protoOnwer, proto::ShapeDef *protoMsg);
 
-  void RefTo(const GeShape &shape) { shape_def_ = shape.shape_def_; }
+  void RefTo(const GeShape &shape) {
+    shape_def_ = shape.shape_def_;
+    dims_ = shape.dims_;
+  }
+  void CopyDimsFrom(const GeShape &other);
 };
 
 class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeTensorDesc : public AttrHolder {
@@ -110,8 +121,6 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeTensorDesc : public AttrH
   using AttrHolder::HasAttr;
   using AttrHolder::SetAttr;
 
-  void Init();
-
   // Create getensordesc from proto obj
   GeTensorDesc(const ProtoMsgOwner &protoOnwer, proto::TensorDescriptor *protoMsg);
   friend class GeTensor;
@@ -119,12 +128,54 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeTensorDesc : public AttrH
   friend class ModelSerializeImp;
   friend class OnnxUtils;
 
-  GeIrProtoHelper<proto::TensorDescriptor> tensor_descriptor_;
-  // Reference from tensorDescriptor_, do not direct use
+  // Values of a standalone desc read on every build step. They are kept typed and
+  // only written to a descriptor proto when the desc is serialized, see MaterializeTo
+  struct TypedValue {
+    Format format = FORMAT_ND;
+    Format origin_format = FORMAT_ND;
+    DataType data_type = DT_FLOAT;
+    DataType origin_data_type = DT_UNDEFINED;
+    bool has_origin_format = true;
+    bool has_origin_data_type = false;
+    int64_t size = 0;
+    int64_t weight_size = 0;
+    int64_t real_dim_cnt = 0;
+    int64_t data_offset = 0;
+  };
+
+  // A standalone desc creates the proto when its attrs are used, one referencing the
+  // proto of a model or a tensor (proto_ref_) reads and writes the proto only
+  mutable GeIrProtoHelper<proto::TensorDescriptor> tensor_descriptor_;
+  // Reference from tensorDescriptor_ if proto_ref_, do not direct use
   mutable GeShape __shape_;
-
-  void RefTo(const GeTensorDesc &tensorDesc) { tensor_descriptor_ = tensorDesc.tensor_descriptor_; }
+  TypedValue value_;
+  bool proto_ref_ = false;
+  // The attr map was handed out for writing, the typed values stored in attrs are read from it
+  bool attrs_in_proto_ = false;
+  // The proto exists and its attr map holds the typed values stored in attrs. Const readers
+  // of one desc may sync the map together, so it is set under a lock, see GetAttrMap
+  mutable std::atomic<bool> attrs_synced_{false};
+
+  void RefTo(const GeTensorDesc &tensorDesc) {
+    tensor_descriptor_ = tensorDesc.tensor_descriptor_;
+    proto_ref_ = tensorDesc.proto_ref_;
+  }
   GeShape &ShapeReference() const;
+
+  // The proto to read the fields without a typed value from, a default one if a
+  // standalone desc has not created its proto yet
+  const proto::TensorDescriptor *ProtoMsg() const;
+  // The proto, created for a standalone desc if it does not exist yet
+  proto::TensorDescriptor *MutableProtoMsg() const;
+  // Write the desc with its typed values to proto_msg, false if it references no proto
+  bool MaterializeTo(proto::TensorDescriptor &proto_msg) const;
+  // Replace the desc with the values of proto_msg
+  void LoadFrom(const proto::TensorDescriptor &proto_msg);
+  void LoadTypedAttrs(const proto::TensorDescriptor &proto_msg);
+  void WriteTypedAttrs(proto::TensorDescriptor &proto_msg) const;
+  void SyncAttrsToProto() const;
+  void CopyFrom(const GeTensorDesc &desc);
+  bool TypedAttrsValid() const { return !proto_ref_ && !attrs_in_proto_; }
 };
 
 class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeTensor {
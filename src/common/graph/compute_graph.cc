@@ -54,8 +54,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY size_t ComputeGraph::GetAllNodesS
   return s;
 }
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY ComputeGraph::Vistor<NodePtr> ComputeGraph::GetAllNodes() const {
-  vector<NodePtr> all_nodes(nodes_.size());
-  (void)std::copy(nodes_.begin(), nodes_.end(), all_nodes.begin());
+  vector<NodePtr> all_nodes(nodes_.GetNodes());
   for (const auto &sub_graph : sub_graph_) {
     if (sub_graph == nullptr) {
       GELOGW("sub graph is nullptr");
@@ -69,7 +68,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY ComputeGraph::Vistor<NodePtr> Com
 }
 size_t ComputeGraph::GetDirectNodesSize() const { return nodes_.size(); }
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY ComputeGraph::Vistor<NodePtr> ComputeGraph::GetDirectNode() const {
-  return Vistor<NodePtr>(shared_from_this(), nodes_);
+  return Vistor<NodePtr>(shared_from_this(), nodes_.GetNodes());
 }
 ComputeGraph::Vistor<NodePtr> ComputeGraph::GetInputNodes() const {
   return Vistor<NodePtr>(shared_from_this(), input_nodes_);
@@ -83,15 +82,7 @@ ComputeGraph::Vistor<NodePtr> ComputeGraph::GetOutputNodes() const {
   return Vistor<NodePtr>(shared_from_this(), result);
 }
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY NodePtr ComputeGraph::FindNode(const std::string &name) const {
-  for (const auto &node : nodes_) {
-    if (node == nullptr) {
-      continue;
-    }
-    if (node->GetName() == name) {
-      return node;
-    }
-  }
-  return nullptr;
+  return nodes_.Find(name);
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool ComputeGraph::GraphAttrsAreEqual(
@@ -173,7 +164,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool ComputeGraph::operator==(con
   }
 
   // Secondly: Node equal means the link relationship between node and node itself equal
-  for (const auto &left_node : nodes_) {
+  for (const auto &left_node : nodes_.GetNodes()) {
     if (left_node == nullptr) {
       GELOGE(GRAPH_FAILED, "left_node is nullptr");
       return false;
@@ -203,14 +194,11 @@ NodePtr ComputeGraph::AddNodeFront(NodePtr node) {
     return nullptr;
   }
   node->GetOpDesc()->SetId(nodes_.size());
-  if (nodes_[0] == nullptr) {
-    GELOGE(GRAPH_FAILED, "nodes_ size or nodes_[0] is nullptr");
-    return nullptr;
-  }
-  if (nodes_.size() > 0 && nodes_[0]->GetType() == DATA) {
-    (void)nodes_.insert(nodes_.begin() + 1, node);
+  NodePtr front = nodes_.Front();
+  if (front != nullptr && front->GetType() == DATA) {
+    nodes_.Insert(1, node);
   } else {
-    (void)nodes_.insert(nodes_.begin(), node);
+    nodes_.Insert(0, node);
   }
   return node;
 }
@@ -233,7 +221,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY NodePtr ComputeGraph::AddNode(Nod
     return nullptr;
   }
   node->GetOpDesc()->SetId((int64_t)GetDirectNodesSize());
-  nodes_.push_back(node);
+  nodes_.PushBack(node);
   return node;
 }
 
@@ -254,7 +242,7 @@ NodePtr ComputeGraph::AddInputNode(NodePtr node) {
     return nullptr;
   }
   input_nodes_.push_back(node);
-  if (std::find(nodes_.begin(), nodes_.end(), node) == nodes_.end()) {
+  if (!nodes_.Contains(node)) {
     GE_CHK_BOOL_EXEC(AddNode(node) != nullptr, return nullptr, "add node failed");
   }
   return node;
@@ -280,7 +268,7 @@ NodePtr ComputeGraph::AddOutputNode(NodePtr node) {
     output_nodes_info_.emplace_back(std::make_pair(node, 0));
   }
 
-  if (std::find(nodes_.begin(), nodes_.end(), node) == nodes_.end()) {
+  if (!nodes_.Contains(node)) {
     GE_CHK_BOOL_EXEC(AddNode(node) != nullptr, return nullptr, "add node failed");
   }
   return result;
@@ -299,10 +287,7 @@ graphStatus ComputeGraph::RemoveConstInput(const NodePtr &node) {
                              "Remove edge from const op failed.");
       if (out_anchor->GetOwnerNode()->GetOutDataNodes().size() == 0) {
         GELOGI("Remove const op %s.", out_anchor->GetOwnerNode()->GetName().c_str());
-        auto iter = find(nodes_.begin(), nodes_.end(), out_anchor->GetOwnerNode());
-        if (iter != nodes_.end()) {
-          (void)nodes_.erase(iter);
-        }
+        (void)nodes_.Remove(out_anchor->GetOwnerNode());
       }
     }
   }
@@ -329,9 +314,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::RemoveN
     return GRAPH_FAILED;
   }
 
-  auto iter = find(nodes_.begin(), nodes_.end(), node);
-  if (iter != nodes_.end()) {
-    (void)nodes_.erase(iter);
+  if (nodes_.Remove(node)) {
     return GRAPH_SUCCESS;
   }
   return GRAPH_FAILED;
@@ -397,7 +380,7 @@ graphStatus ComputeGraph::RemoveSubGraph(const std::shared_ptr<ComputeGraph> &su
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::InsertEventNodes() {
-  std::vector<NodePtr> node_vec = nodes_;
+  std::vector<NodePtr> node_vec = nodes_.GetNodes();
   for (const auto &node : GetAllNodes()) {
     if (node == nullptr || node->GetOpDesc() == nullptr) {
       GELOGW("node or OpDescPtr is nullptr.");
@@ -427,14 +410,14 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::InsertE
       (void)node_vec.insert(src_iter + 1, node);
     }
   }
-  nodes_.clear();
+  nodes_.Clear();
   for (size_t i = 0; i < node_vec.size(); ++i) {
     NodePtr node = node_vec[i];
     if (node == nullptr || node->GetOpDesc() == nullptr) {
       GELOGW("node or OpDescPtr is nullptr.");
     } else {
       node->GetOpDesc()->SetId((int64_t)i);
-      nodes_.push_back(node);
+      nodes_.PushBack(node);
     }
   }
   return GRAPH_SUCCESS;
@@ -580,7 +563,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::Topolog
     }
     GE_LOGE("Failed to do topo sorting total %zu, itered %zu, exist closed loop in graph.", nodes_.size(),
             node_vec.size());
-    for (auto &node : nodes_) {
+    for (auto &node : nodes_.GetNodes()) {
       if (itered_nodes_set.count(node.get()) == 0) {
         GE_LOGE("The node %s does not itered when topological sorting", node->GetName().c_str());
       }
@@ -588,11 +571,11 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::Topolog
     return GRAPH_FAILED;
   }
 
-  nodes_.clear();
+  nodes_.Clear();
   for (size_t i = 0; i < node_vec.size(); i++) {
     NodePtr node = node_vec[i];   // [node: should not be null]
     node->GetOpDesc()->SetId(i);  // [node->GetOpDesc(): should not be null]
-    nodes_.push_back(node);
+    nodes_.PushBack(node);
   }
   is_valid_flag_ = true;
   return GRAPH_SUCCESS;
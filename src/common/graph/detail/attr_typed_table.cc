@@ -0,0 +1,182 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/detail/attr_typed_table.h"
+
+#include <algorithm>
+
+#include "proto/ge_ir.pb.h"
+
+namespace ge {
+AttrKeyRegistry &AttrKeyRegistry::Instance() {
+  static AttrKeyRegistry registry;
+  return registry;
+}
+
+void AttrKeyRegistry::Register(const std::string *const *names, size_t num) {
+  for (size_t i = 0; i < num; ++i) {
+    if (names[i] == nullptr) {
+      continue;
+    }
+    auto ret = content_ids_.emplace(*names[i], static_cast<uint32_t>(content_ids_.size()));
+    address_ids_[names[i]] = ret.first->second;
+  }
+}
+
+bool AttrKeyRegistry::Find(const std::string &name, uint32_t &id) const {
+  auto address_iter = address_ids_.find(&name);
+  if (address_iter != address_ids_.end()) {
+    id = address_iter->second;
+    return true;
+  }
+  auto iter = content_ids_.find(name);
+  if (iter == content_ids_.end()) {
+    return false;
+  }
+  id = iter->second;
+  return true;
+}
+
+bool AttrTypedTable::IdLess(const Entry &entry, uint32_t id) { return entry.id < id; }
+
+const AttrTypedTable::Entry *AttrTypedTable::Find(const std::string &name, ValueKind kind) const {
+  uint32_t id = 0;
+  if (entries_.empty() || !AttrKeyRegistry::Instance().Find(name, id)) {
+    return nullptr;
+  }
+  auto iter = std::lower_bound(entries_.begin(), entries_.end(), id, IdLess);
+  if (iter == entries_.end() || iter->id != id || iter->kind != kind) {
+    return nullptr;
+  }
+  return &(*iter);
+}
+
+bool AttrTypedTable::Get(const std::string &name, int64_t &value) const {
+  auto entry = Find(name, kInt);
+  if (entry == nullptr) {
+    return false;
+  }
+  value = entry->int_value;
+  return true;
+}
+
+bool AttrTypedTable::Get(const std::string &name, float &value) const {
+  auto entry = Find(name, kFloat);
+  if (entry == nullptr) {
+    return false;
+  }
+  value = entry->float_value;
+  return true;
+}
+
+bool AttrTypedTable::Get(const std::string &name, bool &value) const {
+  auto entry = Find(name, kBool);
+  if (entry == nullptr) {
+    return false;
+  }
+  value = entry->bool_value;
+  return true;
+}
+
+bool AttrTypedTable::Get(const std::string &name, std::vector<int64_t> &value) const {
+  auto entry = Find(name, kListInt);
+  if (entry == nullptr) {
+    return false;
+  }
+  value = entry->list_int_value;
+  return true;
+}
+
+void AttrTypedTable::Sync(const ProtoAttrMap &attr_map) {
+  std::lock_guard<std::mutex> lock(sync_mutex_);
+  if (InSync()) {
+    return;
+  }
+  entries_.clear();
+  uint32_t id = 0;
+  for (const auto &item : attr_map) {
+    if (AttrKeyRegistry::Instance().Find(item.first, id)) {
+      Update(id, item.second);
+    }
+  }
+  in_sync_.store(true, std::memory_order_release);
+}
+
+void AttrTypedTable::Follow(const std::string &name, const proto::AttrDef *attr_def) {
+  uint32_t id = 0;
+  if (AttrKeyRegistry::Instance().Find(name, id)) {
+    if (attr_def != nullptr) {
+      Update(id, *attr_def);
+    } else {
+      Erase(id);
+    }
+  }
+  in_sync_.store(true, std::memory_order_release);
+}
+
+void AttrTypedTable::Update(uint32_t id, const proto::AttrDef &attr_def) {
+  auto iter = std::lower_bound(entries_.begin(), entries_.end(), id, IdLess);
+  bool found = iter != entries_.end() && iter->id == id;
+
+  // the same kinds the proto getters of AttrUtils accept, anything else is read from the proto
+  Entry entry{id, kInt, 0, 0.0f, false, {}};
+  switch (attr_def.value_case()) {
+    case proto::AttrDef::kI:
+      entry.int_value = attr_def.i();
+      break;
+    case proto::AttrDef::kF:
+      entry.kind = kFloat;
+      entry.float_value = attr_def.f();
+      break;
+    case proto::AttrDef::kB:
+      entry.kind = kBool;
+      entry.bool_value = attr_def.b();
+      break;
+    case proto::AttrDef::kList: {
+      auto &list = attr_def.list();
+      bool is_list_int = (list.val_type() == proto::AttrDef_ListValue_ListValueType_VT_LIST_INT) ||
+                         (list.val_type() == proto::AttrDef_ListValue_ListValueType_VT_LIST_NONE && list.i_size() > 0);
+      if (is_list_int) {
+        entry.kind = kListInt;
+        entry.list_int_value.assign(list.i().begin(), list.i().end());
+        break;
+      }
+      if (found) {
+        (void)entries_.erase(iter);
+      }
+      return;
+    }
+    default:
+      if (found) {
+        (void)entries_.erase(iter);
+      }
+      return;
+  }
+
+  if (found) {
+    *iter = std::move(entry);
+  } else {
+    (void)entries_.insert(iter, std::move(entry));
+  }
+}
+
+void AttrTypedTable::Erase(uint32_t id) {
+  auto iter = std::lower_bound(entries_.begin(), entries_.end(), id, IdLess);
+  if (iter != entries_.end() && iter->id == id) {
+    (void)entries_.erase(iter);
+  }
+}
+}  // namespace ge
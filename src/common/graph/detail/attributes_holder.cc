@@ -21,6 +21,7 @@
 #include "debug/ge_log.h"
 #include "debug/ge_util.h"
 #include "framework/common/debug/ge_log.h"
+#include "graph/detail/attr_typed_table.h"
 #include "graph/ge_attr_value.h"
 #include "proto/ge_ir.pb.h"
 
@@ -28,25 +29,44 @@ namespace ge {
 using std::map;
 using std::unordered_set;
 void AttrHolder::CopyAttrsFrom(const AttrHolder &holder) { MutableAttrMap().CopyValueFrom(holder.GetAttrMap()); }
+
+bool AttrHolder::WriteAttrMapItem(const string &name, const std::function<void(proto::AttrDef &)> &write) {
+  // MutableAttrMap() marks the table stale, one that was in sync before only misses this item
+  bool follow = typed_attrs_ != nullptr && typed_attrs_->InSync();
+  auto proto_map = MutableAttrMap().GetProtoMsg();
+  if (proto_map == nullptr) {
+    GELOGE(GRAPH_FAILED, "%s attr map is nullptr", name.c_str());
+    return false;
+  }
+  auto &attr_def = (*proto_map)[name];
+  write(attr_def);
+  if (follow) {
+    typed_attrs_->Follow(name, &attr_def);
+  }
+  return true;
+}
+
 graphStatus AttrHolder::SetAttr(const std::string &name, const GeAttrValue &value) {
   if (value.IsEmpty()) {
     GELOGE(GRAPH_FAILED, "value is empty, key %s", name.c_str());
     return GRAPH_FAILED;
   }
-  auto proto_map = MutableAttrMap().GetProtoMsg();
   auto proto_val = value.value_.GetProtoMsg();
-  if (proto_map == nullptr || proto_val == nullptr) {
+  if (proto_val == nullptr) {
     return GRAPH_FAILED;
   }
-  auto it = proto_map->find(name);
-  if (it != proto_map->end()) {
-    if (it->second.value_case() != proto::AttrDef::VALUE_NOT_SET &&
-        it->second.value_case() != proto_val->value_case()) {
-      return GRAPH_FAILED;
-    }
+  bool ret = false;
+  if (!WriteAttrMapItem(name, [proto_val, &ret](proto::AttrDef &attr_def) {
+        if (attr_def.value_case() != proto::AttrDef::VALUE_NOT_SET &&
+            attr_def.value_case() != proto_val->value_case()) {
+          return;
+        }
+        attr_def = *proto_val;
+        ret = true;
+      })) {
+    return GRAPH_FAILED;
   }
-  (*proto_map)[name] = *proto_val;
-  return GRAPH_SUCCESS;
+  return ret ? GRAPH_SUCCESS : GRAPH_FAILED;
 }
 
 graphStatus AttrHolder::AddRequiredAttr(const std::string &name) {
@@ -82,16 +102,20 @@ bool AttrHolder::HasAttr(const std::string &name) const {
 }
 
 graphStatus AttrHolder::DelAttr(const std::string &name) {
+  bool follow = typed_attrs_ != nullptr && typed_attrs_->InSync();
   auto proto_map = MutableAttrMap().GetProtoMsg();
   if (proto_map == nullptr) {
     return GRAPH_FAILED;
   }
   auto it = proto_map->find(name);
-  if (it != proto_map->end()) {
+  bool found = it != proto_map->end();
+  if (found) {
     (void)proto_map->erase(it);
-    return GRAPH_SUCCESS;
   }
-  return GRAPH_FAILED;
+  if (follow) {
+    typed_attrs_->Follow(name, nullptr);
+  }
+  return found ? GRAPH_SUCCESS : GRAPH_FAILED;
 }
 
 const std::map<string, GeAttrValue> AttrHolder::GetAllAttrs() const {
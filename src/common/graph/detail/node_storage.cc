@@ -0,0 +1,208 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/detail/node_storage.h"
+
+#include <cstdint>
+
+#include "graph/compute_graph.h"
+#include "graph/node.h"
+#include "graph/op_desc.h"
+
+namespace ge {
+namespace {
+// ext attr of an op desc in a graph, the node holding it
+const char *const kOwnerNodeAttr = "_node_storage_owner";
+}  // namespace
+
+const size_t NodeStorage::kNoSlot = SIZE_MAX;
+
+std::vector<NodePtr> NodeStorage::GetNodes() const {
+  std::vector<NodePtr> nodes;
+  nodes.reserve(node_num_);
+  for (size_t pos = head_; pos != kNoSlot; pos = slots_[pos].next) {
+    nodes.push_back(slots_[pos].node);
+  }
+  return nodes;
+}
+
+NodePtr NodeStorage::Front() const { return (head_ == kNoSlot) ? nullptr : slots_[head_].node; }
+
+void NodeStorage::PushBack(const NodePtr &node) {
+  if (node == nullptr) {
+    return;
+  }
+  Link(AllocSlot(node), kNoSlot);
+}
+
+void NodeStorage::Insert(size_t index, const NodePtr &node) {
+  if (node == nullptr) {
+    return;
+  }
+  size_t next = head_;
+  for (size_t i = 0; (i < index) && (next != kNoSlot); ++i) {
+    next = slots_[next].next;
+  }
+  Link(AllocSlot(node), next);
+}
+
+bool NodeStorage::Remove(const NodePtr &node) {
+  if (node == nullptr) {
+    return false;
+  }
+  auto iter = slot_index_.find(node.get());
+  if (iter == slot_index_.end()) {
+    return false;
+  }
+  size_t pos = iter->second;
+  (void)slot_index_.erase(iter);
+  Slot &slot = slots_[pos];
+  EraseName(slot.name, pos);
+  if (slot.prev == kNoSlot) {
+    head_ = slot.next;
+  } else {
+    slots_[slot.prev].next = slot.next;
+  }
+  if (slot.next == kNoSlot) {
+    tail_ = slot.prev;
+  } else {
+    slots_[slot.next].prev = slot.prev;
+  }
+  slot.node = nullptr;
+  slot.name.clear();
+  free_slots_.push_back(pos);
+  --node_num_;
+  return true;
+}
+
+bool NodeStorage::Contains(const NodePtr &node) const {
+  return (node != nullptr) && (slot_index_.count(node.get()) > 0);
+}
+
+NodePtr NodeStorage::Find(const std::string &name) const {
+  auto range = name_index_.equal_range(name);
+  if (range.first == range.second) {
+    return nullptr;
+  }
+  auto first = range.first;
+  if ((++range.first == range.second) && (slots_[first->second].node->GetName() == name)) {
+    return slots_[first->second].node;
+  }
+  // the names are duplicated, which is rare, or the index is stale because the node was renamed
+  // through an op desc not known to the graph, the first node in order holding the name is taken
+  for (size_t pos = head_; pos != kNoSlot; pos = slots_[pos].next) {
+    if (slots_[pos].node->GetName() == name) {
+      return slots_[pos].node;
+    }
+  }
+  return nullptr;
+}
+
+void NodeStorage::Clear() {
+  slots_.clear();
+  free_slots_.clear();
+  head_ = kNoSlot;
+  tail_ = kNoSlot;
+  slot_index_.clear();
+  name_index_.clear();
+  node_num_ = 0;
+}
+
+void NodeStorage::OnOpDescRenamed(const OpDesc &op_desc) {
+  // the ext attrs are copied with the op desc, and so is the op def holding the name, a copy renamed
+  // renames the node as well. The node is reindexed by the name it reads now, which is unchanged
+  // if the op desc renamed does not share the op def with the node.
+  NodePtr node = op_desc.TryGetExtAttr(kOwnerNodeAttr, std::weak_ptr<Node>()).lock();
+  if (node == nullptr) {
+    return;
+  }
+  ComputeGraphPtr graph = node->GetOwnerComputeGraph();
+  if (graph != nullptr) {
+    graph->nodes_.Rename(node);
+  }
+}
+
+void NodeStorage::OnOpDescUpdated(const NodePtr &node) {
+  if ((node == nullptr) || (node->GetOpDesc() == nullptr)) {
+    return;
+  }
+  (void)node->GetOpDesc()->SetExtAttr(kOwnerNodeAttr, std::weak_ptr<Node>(node));
+  ComputeGraphPtr graph = node->GetOwnerComputeGraph();
+  if (graph != nullptr) {
+    graph->nodes_.Rename(node);
+  }
+}
+
+size_t NodeStorage::AllocSlot(const NodePtr &node) {
+  size_t pos = slots_.size();
+  if (free_slots_.empty()) {
+    slots_.emplace_back();
+  } else {
+    pos = free_slots_.back();
+    free_slots_.pop_back();
+  }
+  Slot &slot = slots_[pos];
+  slot.node = node;
+  slot.name = node->GetName();
+  (void)slot_index_.emplace(node.get(), pos);
+  (void)name_index_.emplace(slot.name, pos);
+  ++node_num_;
+  if (node->GetOpDesc() != nullptr) {
+    (void)node->GetOpDesc()->SetExtAttr(kOwnerNodeAttr, std::weak_ptr<Node>(node));
+  }
+  return pos;
+}
+
+void NodeStorage::Link(size_t pos, size_t next) {
+  size_t prev = (next == kNoSlot) ? tail_ : slots_[next].prev;
+  slots_[pos].prev = prev;
+  slots_[pos].next = next;
+  if (prev == kNoSlot) {
+    head_ = pos;
+  } else {
+    slots_[prev].next = pos;
+  }
+  if (next == kNoSlot) {
+    tail_ = pos;
+  } else {
+    slots_[next].prev = pos;
+  }
+}
+
+void NodeStorage::Rename(const NodePtr &node) {
+  auto iter = slot_index_.find(node.get());
+  if (iter == slot_index_.end()) {
+    return;
+  }
+  Slot &slot = slots_[iter->second];
+  if (slot.name == node->GetName()) {
+    return;
+  }
+  EraseName(slot.name, iter->second);
+  slot.name = node->GetName();
+  (void)name_index_.emplace(slot.name, iter->second);
+}
+
+void NodeStorage::EraseName(const std::string &name, size_t pos) {
+  auto range = name_index_.equal_range(name);
+  for (auto iter = range.first; iter != range.second; ++iter) {
+    if (iter->second == pos) {
+      (void)name_index_.erase(iter);
+      return;
+    }
+  }
+}
+}  // namespace ge
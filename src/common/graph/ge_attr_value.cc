@@ -23,6 +23,7 @@
 #include "graph/model_serialize.h"
 #include "proto/ge_ir.pb.h"
 #include "detail/model_serialize_imp.h"
+#include "graph/detail/attr_typed_table.h"
 #include "graph/debug/ge_attr_define.h"
 #include "debug/ge_log.h"
 #include "debug/ge_util.h"
@@ -339,19 +340,35 @@ class AttrUtilsHelper {
     return true;
   }
 
-  inline static bool MutableAttrMapItem(AttrHolder *obj, const string &name, proto::AttrDef *&attr_def) {
-    if (obj == nullptr) {
-      GELOGE(FAILED, " %s obj is nullptr", name.c_str());
+  ///
+  /// Read an int, float, bool or list int attr from the typed table of obj. A miss does not mean the
+  /// attr is absent, the caller falls back to the proto map.
+  ///
+  template <typename T>
+  inline static bool GetTypedAttr(const AttrHolder *obj, const string &name, T &value) {
+    if (obj == nullptr || obj->typed_attrs_ == nullptr) {
       return false;
     }
-    auto attr_map = obj->MutableAttrMap().GetProtoMsg();
-    if (attr_map == nullptr) {
-      GELOGE(FAILED, "%s attr map is nullptr", name.c_str());
+    if (!obj->typed_attrs_->InSync()) {
+      auto attr_map = obj->GetAttrMap().GetProtoMsg();
+      if (attr_map == nullptr) {
+        return false;
+      }
+      obj->typed_attrs_->Sync(*attr_map);
+    }
+    return obj->typed_attrs_->Get(name, value);
+  }
+
+  ///
+  /// Get or add the item of name and write it, the write tells whether it succeeded through its captures.
+  ///
+  inline static bool WriteAttrMapItem(AttrHolder *obj, const string &name,
+                                      const std::function<void(proto::AttrDef &)> &write) {
+    if (obj == nullptr) {
+      GELOGE(FAILED, " %s obj is nullptr", name.c_str());
       return false;
     }
-    // Get or add
-    attr_def = &((*attr_map)[name]);
-    return true;
+    return obj->WriteAttrMapItem(name, write);
   }
 };
 
@@ -394,11 +411,7 @@ bool GeAttrValueImp::SetValue(proto::AttrDef &proto_attr_val, const GeTensorDesc
   if (!AttrUtilsHelper::SetValueCheckType(proto_attr_val, proto::AttrDef::kTd)) {
     return false;
   }
-  auto proto_msg = value.tensor_descriptor_.GetProtoMsg();
-  if (proto_msg == nullptr) {
-    return false;
-  }
-  *proto_attr_val.mutable_td() = *proto_msg;
+  return value.MaterializeTo(*proto_attr_val.mutable_td());
   return true;
 }
 
@@ -411,12 +424,10 @@ bool GeAttrValueImp::SetValue(proto::AttrDef &proto_attr_val, const vector<GeTen
   GE_CHECK_NOTNULL_EXEC(list, return false);
   list->clear_td();
   for (const auto &item : value) {
-    auto proto_msg = item.tensor_descriptor_.GetProtoMsg();
-    if (proto_msg == nullptr) {
+    if (!item.MaterializeTo(*list->add_td())) {
       proto_attr_val.clear_list();
       return false;
     }
-    *list->add_td() = *proto_msg;
   }
   return true;
 }
@@ -662,11 +673,10 @@ bool GeAttrValueImp::GetValue(const proto::AttrDef &proto_attr_val, const ProtoM
   if (!AttrUtilsHelper::GetValueCheckType(proto_attr_val, proto::AttrDef::kTd)) {
     return false;
   }
-  auto proto_msg = value.tensor_descriptor_.GetProtoMsg();
-  if (proto_msg == nullptr) {
+  if (value.MutableProtoMsg() == nullptr) {
     return false;
   }
-  *proto_msg = proto_attr_val.td();
+  value.LoadFrom(proto_attr_val.td());
   return true;
 }
 
@@ -679,11 +689,10 @@ bool GeAttrValueImp::GetValue(const proto::AttrDef &proto_attr_val, const ProtoM
   auto &list = proto_attr_val.list();
   for (const auto &item : list.td()) {
     value.emplace_back(GeTensorDesc());
-    auto proto_msg = value.back().tensor_descriptor_.GetProtoMsg();
-    if (proto_msg == nullptr) {
+    if (value.back().MutableProtoMsg() == nullptr) {
       return false;
     }
-    *proto_msg = item;
+    value.back().LoadFrom(item);
   }
   return true;
 }
@@ -932,11 +941,13 @@ bool AttrUtils::HasAttr(ConstAttrHolderAdapter &&obj, const string &name) {
 #define ATTR_UTILS_SET_IMP(FuncName, Type)                                                                    \
   GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool AttrUtils::Set##FuncName(                               \
       AttrHolderAdapter &&obj, const string &name, const Type &value) {                                       \
-    proto::AttrDef *proto_attr_val = nullptr;                                                                 \
-    if (!AttrUtilsHelper::MutableAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) { \
+    bool ret = false;                                                                                         \
+    if (!AttrUtilsHelper::WriteAttrMapItem(obj.get(), name, [&value, &ret](proto::AttrDef &proto_attr_val) {  \
+          ret = GeAttrValueImp::SetValue(proto_attr_val, value);                                              \
+        })) {                                                                                                 \
       return false;                                                                                           \
     }                                                                                                         \
-    if (!GeAttrValueImp::SetValue(*proto_attr_val, value)) {                                                  \
+    if (!ret) {                                                                                               \
       GELOGW("Set" #FuncName " failed key %s", name.c_str());                                                 \
       return false;                                                                                           \
     }                                                                                                         \
@@ -957,13 +968,35 @@ bool AttrUtils::HasAttr(ConstAttrHolderAdapter &&obj, const string &name) {
     return true;                                                                                                  \
   }
 
+// The typed table answers first, the proto map answers what it does not hold
+#define ATTR_UTILS_GET_TYPED_IMP(FuncName, Type)                                                                  \
+  GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool AttrUtils::Get##FuncName(ConstAttrHolderAdapter &&obj,      \
+                                                                               const string &name, Type &value) { \
+    if (AttrUtilsHelper::GetTypedAttr(obj.get(), name, value)) {                                                  \
+      return true;                                                                                                \
+    }                                                                                                             \
+    const proto::AttrDef *proto_attr_val = nullptr;                                                               \
+    if (!AttrUtilsHelper::GetAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {         \
+      return false;                                                                                               \
+    }                                                                                                             \
+    if (!GeAttrValueImp::GetValue(*proto_attr_val, obj->GetAttrMap().GetProtoOwner(), value)) {                   \
+      GELOGW("Get" #FuncName " failed key %s", name.c_str());                                                     \
+      return false;                                                                                               \
+    }                                                                                                             \
+    return true;                                                                                                  \
+  }
+
 #define ATTR_UTILS_SET_GET_IMP(FuncName, Type) \
   ATTR_UTILS_SET_IMP(FuncName, Type)           \
   ATTR_UTILS_GET_IMP(FuncName, Type)
 
-ATTR_UTILS_SET_GET_IMP(Int, int64_t)
-ATTR_UTILS_SET_GET_IMP(Float, float)
-ATTR_UTILS_SET_GET_IMP(Bool, bool)
+#define ATTR_UTILS_SET_GET_TYPED_IMP(FuncName, Type) \
+  ATTR_UTILS_SET_IMP(FuncName, Type)                 \
+  ATTR_UTILS_GET_TYPED_IMP(FuncName, Type)
+
+ATTR_UTILS_SET_GET_TYPED_IMP(Int, int64_t)
+ATTR_UTILS_SET_GET_TYPED_IMP(Float, float)
+ATTR_UTILS_SET_GET_TYPED_IMP(Bool, bool)
 ATTR_UTILS_SET_GET_IMP(Str, string)
 ATTR_UTILS_SET_GET_IMP(TensorDesc, GeTensorDesc)
 ATTR_UTILS_SET_IMP(Tensor, GeTensorPtr)
@@ -974,7 +1007,7 @@ ATTR_UTILS_SET_GET_IMP(Bytes, Buffer)
 ATTR_UTILS_SET_GET_IMP(Graph, ComputeGraphPtr)
 ATTR_UTILS_SET_GET_IMP(ListListInt, vector<vector<int64_t>>)
 
-ATTR_UTILS_SET_GET_IMP(ListInt, vector<int64_t>)
+ATTR_UTILS_SET_GET_TYPED_IMP(ListInt, vector<int64_t>)
 ATTR_UTILS_SET_IMP(ListInt, vector<int32_t>)
 ATTR_UTILS_SET_IMP(ListInt, vector<uint32_t>)
 ATTR_UTILS_SET_GET_IMP(ListFloat, vector<float>)
@@ -1041,11 +1074,13 @@ bool AttrUtils::MutableListTensor(AttrHolderAdapter &&obj, const string &name, v
 }
 
 bool AttrUtils::SetListInt(AttrHolderAdapter &&obj, const string &name, std::initializer_list<int64_t> &&value) {
-  proto::AttrDef *proto_attr_val = nullptr;
-  if (!AttrUtilsHelper::MutableAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
+  bool ret = false;
+  if (!AttrUtilsHelper::WriteAttrMapItem(obj.get(), name, [&value, &ret](proto::AttrDef &proto_attr_val) {
+        ret = GeAttrValueImp::SetValue(proto_attr_val, value);
+      })) {
     return false;
   }
-  return GeAttrValueImp::SetValue(*proto_attr_val, value);
+  return ret;
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool AttrUtils::GetInt(ConstAttrHolderAdapter &&obj, const string &name,
@@ -1164,11 +1199,13 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool AttrUtils::GetListOpDesc(Con
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool AttrUtils::SetZeroCopyBytes(AttrHolderAdapter &&obj,
                                                                                 const string &name, Buffer &&buffer) {
   // Value will be moved
-  proto::AttrDef *proto_attr_val = nullptr;
-  if (!AttrUtilsHelper::MutableAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
+  bool ret = false;
+  if (!AttrUtilsHelper::WriteAttrMapItem(obj.get(), name, [&obj, &buffer, &ret](proto::AttrDef &proto_attr_val) {
+        ret = GeAttrValueImp::SetZeroCopyBytes(proto_attr_val, obj->GetAttrMap().GetProtoOwner(), std::move(buffer));
+      })) {
     return false;
   }
-  return GeAttrValueImp::SetZeroCopyBytes(*proto_attr_val, obj->GetAttrMap().GetProtoOwner(), std::move(buffer));
+  return ret;
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool AttrUtils::GetZeroCopyBytes(ConstAttrHolderAdapter &&obj,
@@ -1182,11 +1219,13 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool AttrUtils::GetZeroCopyBytes(
 
 bool AttrUtils::SetZeroCopyListBytes(AttrHolderAdapter &&obj, const string &name, vector<Buffer> &list_buffer) {
   // Value will be moved
-  proto::AttrDef *proto_attr_val = nullptr;
-  if (!AttrUtilsHelper::MutableAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
+  bool ret = false;
+  if (!AttrUtilsHelper::WriteAttrMapItem(obj.get(), name, [&obj, &list_buffer, &ret](proto::AttrDef &proto_attr_val) {
+        ret = GeAttrValueImp::SetZeroCopyListBytes(proto_attr_val, obj->GetAttrMap().GetProtoOwner(), list_buffer);
+      })) {
     return false;
   }
-  return GeAttrValueImp::SetZeroCopyListBytes(*proto_attr_val, obj->GetAttrMap().GetProtoOwner(), list_buffer);
+  return ret;
 }
 
 bool AttrUtils::GetZeroCopyListBytes(ConstAttrHolderAdapter &&obj, const string &name, vector<Buffer> &list_buffer) {
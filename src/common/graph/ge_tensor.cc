@@ -20,6 +20,9 @@
 #include <cstring>
 #include <iostream>
 #include <map>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
 
 #include "debug/ge_attr_define.h"
 #include "debug/ge_util.h"
@@ -33,7 +36,7 @@
 #include "utils/type_utils.h"
 
 namespace ge {
-static const char *const kKeyDataTypeSelfDefined = "__tensor_desc_data_type__";
+static const std::string kKeyDataTypeSelfDefined = "__tensor_desc_data_type__";
 
 static const std::map<DataType, ::ge::proto::DataType> kDataTypeMap = {
     {DT_UNDEFINED, proto::DT_UNDEFINED},
@@ -69,18 +72,148 @@ static const std::map<DataType, int> kDataTypeSelfDefinedMap = {
     {DT_QINT8, 18}, {DT_QINT16, 19},        {DT_QINT32, 20},         {DT_QUINT8, 21},    {DT_QUINT16, 22},
 };
 
-GeShape::GeShape() { shape_def_.InitDefault(); }
+namespace {
+template <typename DimRange>
+int64_t GetShapeSizeOf(const DimRange &dims) {
+  if (dims.empty()) {
+    return 0;
+  }
+  int64_t res = 1;
+  for (auto dim : dims) {
+    res *= dim;
+  }
+  return res;
+}
 
-// Default
-GeShape::GeShape(std::vector<int64_t> s) : GeShape() {
-  auto proto_msg = shape_def_.GetProtoMsg();
-  if (proto_msg != nullptr) {
-    for (auto i : s) {
-      proto_msg->add_dim(i);
+template <typename DimRange>
+std::string DimsToString(const DimRange &dims) {
+  std::stringstream ss;
+  bool first = true;
+  for (auto dim : dims) {
+    if (first) {
+      first = false;
+    } else {
+      ss << ",";
+    }
+    ss << dim;
+  }
+  return ss.str();
+}
+///
+/// Reverse tables of kDataTypeMap/kDataTypeSelfDefinedMap, so reading the data
+/// type of a desc is a hash lookup instead of a walk over the forward map
+///
+const std::unordered_map<int, DataType> &GetProtoToDataTypeMap() {
+  static const std::unordered_map<int, DataType> proto_to_data_type = []() {
+    std::unordered_map<int, DataType> reverse_map;
+    for (const auto &it : kDataTypeMap) {
+      (void)reverse_map.emplace(static_cast<int>(it.second), it.first);
+    }
+    return reverse_map;
+  }();
+  return proto_to_data_type;
+}
+
+const std::unordered_map<int64_t, DataType> &GetSelfDefinedToDataTypeMap() {
+  static const std::unordered_map<int64_t, DataType> self_defined_to_data_type = []() {
+    std::unordered_map<int64_t, DataType> reverse_map;
+    for (const auto &it : kDataTypeSelfDefinedMap) {
+      (void)reverse_map.emplace(it.second, it.first);
     }
+    return reverse_map;
+  }();
+  return self_defined_to_data_type;
+}
+
+///
+/// Read a string attr straight from the descriptor proto, without going
+/// through AttrUtils and a GeAttrValue copy. Returns nullptr if the attr is
+/// absent or not a string.
+///
+const std::string *GetDescStrAttr(const proto::TensorDescriptor *tensor_descriptor_msg, const std::string &name) {
+  if (tensor_descriptor_msg == nullptr || tensor_descriptor_msg->attr().empty()) {
+    return nullptr;
   }
+  auto iter = tensor_descriptor_msg->attr().find(name);
+  if (iter == tensor_descriptor_msg->attr().end() || iter->second.value_case() != proto::AttrDef::kS) {
+    return nullptr;
+  }
+  return &iter->second.s();
+}
+
+///
+/// A proto created for a standalone desc starts from this, the values the
+/// desc had in its proto before it kept them typed
+///
+const proto::TensorDescriptor &GetDefaultDescProto() {
+  static const proto::TensorDescriptor default_desc_proto = []() {
+    proto::TensorDescriptor desc_proto;
+    desc_proto.set_has_out_attr(true);
+    desc_proto.set_device_type("NPU");
+    return desc_proto;
+  }();
+  return default_desc_proto;
+}
+
+DataType GetProtoDataType(const proto::TensorDescriptor *tensor_descriptor_msg) {
+  auto &attr_map = tensor_descriptor_msg->attr();
+  auto it_data_type = attr_map.empty() ? attr_map.end() : attr_map.find(kKeyDataTypeSelfDefined);
+  if (it_data_type != attr_map.end()) {
+    auto &self_defined_map = GetSelfDefinedToDataTypeMap();
+    auto it = self_defined_map.find(it_data_type->second.i());
+    return it != self_defined_map.end() ? it->second : DT_UNDEFINED;
+  }
+  auto &proto_map = GetProtoToDataTypeMap();
+  auto it = proto_map.find(static_cast<int>(tensor_descriptor_msg->dtype()));
+  return it != proto_map.end() ? it->second : DT_UNDEFINED;
+}
+
+void SetProtoDataType(proto::TensorDescriptor *tensor_descriptor_msg, DataType data_type) {
+  auto &attr_maps = *(tensor_descriptor_msg->mutable_attr());
+  (void)attr_maps.erase(kKeyDataTypeSelfDefined);
+
+  auto it = kDataTypeMap.find(data_type);
+  if (it != kDataTypeMap.end()) {
+    tensor_descriptor_msg->set_dtype(it->second);
+    return;
+  }
+  auto it2 = kDataTypeSelfDefinedMap.find(data_type);
+  if (it2 != kDataTypeSelfDefinedMap.end()) {
+    attr_maps[kKeyDataTypeSelfDefined].set_i(it2->second);
+  }
+}
+
+std::string OriginFormatToString(Format origin_format) {
+  return (origin_format == FORMAT_RESERVED) ? "RESERVED" : TypeUtils::FormatToSerialString(origin_format);
+}
+
+Format OriginFormatFromString(const std::string &origin_format_str) {
+  return (origin_format_str == "RESERVED") ? FORMAT_RESERVED : TypeUtils::SerialStringToFormat(origin_format_str);
 }
 
+std::string OriginDataTypeToString(DataType origin_data_type) {
+  return (origin_data_type == DT_UNDEFINED) ? "RESERVED" : TypeUtils::DataTypeToSerialString(origin_data_type);
+}
+
+DataType OriginDataTypeFromString(const std::string &origin_data_type_str) {
+  return (origin_data_type_str == "RESERVED") ? DT_UNDEFINED : TypeUtils::SerialStringToDataType(origin_data_type_str);
+}
+
+///
+/// Taken by a const reader syncing the typed values into the attr map of a desc,
+/// which is rare, every desc syncs at most once between two writes
+///
+std::mutex &GetAttrsSyncMutex() {
+  static std::mutex attrs_sync_mutex;
+  return attrs_sync_mutex;
+}
+}  // namespace
+
+GeShape::GeShape() {}
+
+// Default
+GeShape::GeShape(std::vector<int64_t> s) { dims_.assign(s.begin(), s.end()); }
+
 size_t GeShape::GetDimNum() const {
   auto proto_msg = shape_def_.GetProtoMsg();
   if (proto_msg != nullptr) {
@@ -90,7 +223,7 @@ size_t GeShape::GetDimNum() const {
       return 0;
     }
   }
-  return 0;
+  return dims_.size();
 }
 
 int64_t GeShape::GetDim(size_t idx) const {
@@ -99,8 +232,9 @@ int64_t GeShape::GetDim(size_t idx) const {
     if (proto_msg->dim_size() > static_cast<int>(idx)) {
       return proto_msg->dim(static_cast<int>(idx));
     }
+    return 0;
   }
-  return 0;
+  return idx < dims_.size() ? dims_[idx] : 0;
 }
 
 graphStatus GeShape::SetDim(size_t idx, int64_t value) {
@@ -117,52 +251,68 @@ graphStatus GeShape::SetDim(size_t idx, int64_t value) {
       return GRAPH_FAILED;
     }
     proto_msg->set_dim(static_cast<int>(idx), value);
+    return GRAPH_SUCCESS;
+  }
+  if (dims_.empty()) {
+    GELOGE(GRAPH_FAILED, "shape is empty");
+    return GRAPH_FAILED;
   }
+  if (idx >= dims_.size()) {
+    GELOGE(GRAPH_FAILED, "idx is out of range");
+    return GRAPH_FAILED;
+  }
+  dims_[idx] = value;
   return GRAPH_SUCCESS;
 }
 
 std::vector<int64_t> GeShape::GetDims() const {
-  vector<int64_t> dims;
   auto proto_msg = shape_def_.GetProtoMsg();
   if (proto_msg != nullptr) {
-    for (auto i : proto_msg->dim()) {
-      dims.push_back(i);
-    }
+    return std::vector<int64_t>(proto_msg->dim().begin(), proto_msg->dim().end());
   }
-  return dims;
+  return std::vector<int64_t>(dims_.begin(), dims_.end());
 }
 
 std::string GeShape::ToString() const {
   auto proto_msg = shape_def_.GetProtoMsg();
-  if (proto_msg == nullptr) {
-    return "";
-  }
-
-  std::stringstream ss;
-  bool first = true;
-  for (auto i : proto_msg->dim()) {
-    if (first) {
-      first = false;
-    } else {
-      ss << ",";
-    }
-    ss << i;
+  if (proto_msg != nullptr) {
+    return DimsToString(proto_msg->dim());
   }
-  return ss.str();
+  return DimsToString(dims_);
 }
 
 int64_t GeShape::GetShapeSize() const {
-  int64_t res = 1;
   auto proto_msg = shape_def_.GetProtoMsg();
   if (proto_msg != nullptr) {
-    if (proto_msg->dim().empty()) {
-      return 0;
-    }
-    for (auto i : proto_msg->dim()) {
-      res *= i;
+    return GetShapeSizeOf(proto_msg->dim());
+  }
+  return GetShapeSizeOf(dims_);
+}
+
+void GeShape::CopyDimsFrom(const GeShape &other) {
+  auto proto_msg = shape_def_.GetProtoMsg();
+  auto other_proto_msg = other.shape_def_.GetProtoMsg();
+  if (proto_msg == nullptr) {
+    if (other_proto_msg != nullptr) {
+      dims_.assign(other_proto_msg->dim().begin(), other_proto_msg->dim().end());
+    } else {
+      dims_ = other.dims_;
     }
+    return;
+  }
+  if (other_proto_msg == proto_msg) {
+    return;
+  }
+  if (other_proto_msg != nullptr) {
+    *proto_msg = *other_proto_msg;
+    return;
+  }
+  auto dims = proto_msg->mutable_dim();
+  dims->Clear();
+  dims->Reserve(static_cast<int>(other.dims_.size()));
+  for (auto dim : other.dims_) {
+    dims->Add(dim);
   }
-  return res;
 }
 
 const string TENSOR_UTILS_SIZE = "size";
@@ -186,49 +336,59 @@ const string TENSOR_UTILS_ORIGIN_DATA_TYPE = "origin_data_type";
 
 GeShape::GeShape(const ProtoMsgOwner &proto_owner, proto::ShapeDef *proto_msg) : shape_def_(proto_owner, proto_msg) {}
 
-GeShape::GeShape(const GeShape &other) : GeShape() { shape_def_.CopyValueFrom(other.shape_def_); }
+GeShape::GeShape(const GeShape &other) { CopyDimsFrom(other); }
 
-GeShape::GeShape(GeShape &&other) : GeShape() { shape_def_.MoveValueFrom(std::move(other.shape_def_)); }
+GeShape::GeShape(GeShape &&other) {
+  if (other.shape_def_.GetProtoMsg() == nullptr) {
+    dims_ = std::move(other.dims_);
+  } else {
+    CopyDimsFrom(other);
+  }
+}
 
 GeShape &GeShape::operator=(const GeShape &other) {
   if (&other != this) {
-    shape_def_.CopyValueFrom(other.shape_def_);
+    CopyDimsFrom(other);
   }
   return *this;
 }
 
 GeShape &GeShape::operator=(GeShape &&other) {
   if (&other != this) {
-    shape_def_.CopyValueFrom(std::move(other.shape_def_));
+    CopyDimsFrom(other);
   }
   return *this;
 }
 
-GeTensorDesc::GeTensorDesc() {
-  tensor_descriptor_.InitDefault();
-  SetDataType(DT_FLOAT);
-  Init();
-}
+GeTensorDesc::GeTensorDesc() {}
 
 // Default
 GeTensorDesc::GeTensorDesc(GeShape shape, Format format, DataType dt) : GeTensorDesc() {
   SetFormat(format);
   SetDataType(dt);
-  ShapeReference() = std::move(shape);
+  __shape_ = std::move(shape);
 }
 
 // Default
-GeTensorDesc::GeTensorDesc(const GeTensorDesc &desc) : GeTensorDesc() {
-  tensor_descriptor_.CopyValueFrom(desc.tensor_descriptor_);
-}
+GeTensorDesc::GeTensorDesc(const GeTensorDesc &desc) : GeTensorDesc() { CopyFrom(desc); }
 
 // Default
 GeTensorDesc::GeTensorDesc(GeTensorDesc &&desc) : GeTensorDesc() {
-  tensor_descriptor_.MoveValueFrom(std::move(desc.tensor_descriptor_));
+  if (desc.proto_ref_) {
+    CopyFrom(desc);
+    return;
+  }
+  value_ = desc.value_;
+  __shape_.dims_ = std::move(desc.__shape_.dims_);
+  attrs_in_proto_ = desc.attrs_in_proto_;
+  attrs_synced_ = desc.attrs_synced_.load();
+  tensor_descriptor_ = desc.tensor_descriptor_;
+  desc.tensor_descriptor_ = GeIrProtoHelper<proto::TensorDescriptor>();
+  desc.attrs_synced_ = false;
 }
 
 GeTensorDesc::GeTensorDesc(const ProtoMsgOwner &proto_owner, proto::TensorDescriptor *proto_msg)
-    : tensor_descriptor_(proto_owner, proto_msg) {
+    : tensor_descriptor_(proto_owner, proto_msg), proto_ref_(true) {
   if (proto_msg != nullptr && !proto_msg->has_out_attr()) {
     proto_msg->set_has_out_attr(true);
 
@@ -283,9 +443,13 @@ GeTensorDesc::GeTensorDesc(const ProtoMsgOwner &proto_owner, proto::TensorDescri
 }
 
 bool GeTensorDesc::GeTensorDescAttrsAreEqual(const GeTensorDesc &r_ge_tensor_desc) const {
-  const auto &tensor_descriptor = this->tensor_descriptor_.GetProtoMsg();
-  const auto &r_tensor_descriptor = r_ge_tensor_desc.tensor_descriptor_.GetProtoMsg();
-  if ((tensor_descriptor != nullptr) && (r_tensor_descriptor != nullptr)) {
+  proto::TensorDescriptor tensor_descriptor_msg;
+  proto::TensorDescriptor r_tensor_descriptor_msg;
+  bool has_proto = MaterializeTo(tensor_descriptor_msg);
+  bool r_has_proto = r_ge_tensor_desc.MaterializeTo(r_tensor_descriptor_msg);
+  if (has_proto && r_has_proto) {
+    const auto *tensor_descriptor = &tensor_descriptor_msg;
+    const auto *r_tensor_descriptor = &r_tensor_descriptor_msg;
     // Message TensorDescriptor in ge_ir.proto
     return (IsEqual(tensor_descriptor->name(), r_tensor_descriptor->name(), "TensorDescriptor.name()") &&
             IsEqual(tensor_descriptor->dtype(), r_tensor_descriptor->dtype(), "TensorDescriptor.dtype()") &&
@@ -317,7 +481,7 @@ bool GeTensorDesc::GeTensorDescAttrsAreEqual(const GeTensorDesc &r_ge_tensor_des
             IsEqual(tensor_descriptor->cmps_tab_offset(), r_tensor_descriptor->cmps_tab_offset(),
                     "TensorDescriptor.cmps_tab_offset()"));
   } else {
-    return ((tensor_descriptor == nullptr) && (r_tensor_descriptor == nullptr));
+    return (!has_proto && !r_has_proto);
   }
 }
 
@@ -326,6 +490,9 @@ bool GeTensorDesc::operator==(const GeTensorDesc &r_ge_tensor_desc) const {
 }
 
 GeShape &GeTensorDesc::ShapeReference() const {
+  if (!proto_ref_) {
+    return __shape_;
+  }
   if (tensor_descriptor_.GetProtoMsg() != nullptr) {
     GeShape refShape(tensor_descriptor_.GetProtoOwner(), tensor_descriptor_.GetProtoMsg()->mutable_shape());
     __shape_.RefTo(refShape);
@@ -336,28 +503,166 @@ GeShape &GeTensorDesc::ShapeReference() const {
   return __shape_;
 }
 
-void GeTensorDesc::Init() {
-  SetFormat(FORMAT_ND);
-  SetOriginFormat(FORMAT_ND);
-  TensorUtils::SetDeviceType(*this, DeviceType::NPU);
-  if (tensor_descriptor_.GetProtoMsg() == nullptr) {
-    GELOGE(GRAPH_FAILED, "ProtoType nullptr.");
+const proto::TensorDescriptor *GeTensorDesc::ProtoMsg() const {
+  auto proto_msg = tensor_descriptor_.GetProtoMsg();
+  if ((proto_msg == nullptr) && !proto_ref_) {
+    return &GetDefaultDescProto();
+  }
+  return proto_msg;
+}
+
+proto::TensorDescriptor *GeTensorDesc::MutableProtoMsg() const {
+  if (!proto_ref_ && (tensor_descriptor_.GetProtoMsg() == nullptr)) {
+    tensor_descriptor_.InitDefault();
+    auto proto_msg = tensor_descriptor_.GetProtoMsg();
+    if (proto_msg != nullptr) {
+      *proto_msg = GetDefaultDescProto();
+    }
+  }
+  return tensor_descriptor_.GetProtoMsg();
+}
+
+void GeTensorDesc::WriteTypedAttrs(proto::TensorDescriptor &proto_msg) const {
+  SetProtoDataType(&proto_msg, value_.data_type);
+  auto attr_map = proto_msg.mutable_attr();
+  if (value_.has_origin_format) {
+    (*attr_map)[TENSOR_UTILS_ORIGIN_FORMAT].set_s(OriginFormatToString(value_.origin_format));
+  } else {
+    (void)attr_map->erase(TENSOR_UTILS_ORIGIN_FORMAT);
+  }
+  if (value_.has_origin_data_type) {
+    (*attr_map)[TENSOR_UTILS_ORIGIN_DATA_TYPE].set_s(OriginDataTypeToString(value_.origin_data_type));
+  } else {
+    (void)attr_map->erase(TENSOR_UTILS_ORIGIN_DATA_TYPE);
+  }
+}
+
+void GeTensorDesc::SyncAttrsToProto() const {
+  if (!TypedAttrsValid() || attrs_synced_) {
     return;
   }
-  tensor_descriptor_.GetProtoMsg()->set_has_out_attr(true);
+  auto proto_msg = MutableProtoMsg();
+  if (proto_msg == nullptr) {
+    return;
+  }
+  WriteTypedAttrs(*proto_msg);
+  attrs_synced_ = true;
+}
+
+bool GeTensorDesc::MaterializeTo(proto::TensorDescriptor &proto_msg) const {
+  auto own_msg = tensor_descriptor_.GetProtoMsg();
+  if (proto_ref_) {
+    if (own_msg == nullptr) {
+      return false;
+    }
+    proto_msg = *own_msg;
+    return true;
+  }
+  proto_msg = (own_msg != nullptr) ? *own_msg : GetDefaultDescProto();
+  if (TypedAttrsValid()) {
+    WriteTypedAttrs(proto_msg);
+  }
+  proto_msg.set_layout(TypeUtils::FormatToSerialString(value_.format));
+  auto dims = proto_msg.mutable_shape()->mutable_dim();
+  dims->Clear();
+  dims->Reserve(static_cast<int>(__shape_.dims_.size()));
+  for (auto dim : __shape_.dims_) {
+    dims->Add(dim);
+  }
+  proto_msg.set_size(value_.size);
+  proto_msg.set_weight_size(value_.weight_size);
+  proto_msg.set_real_dim_cnt(value_.real_dim_cnt);
+  proto_msg.set_data_offset(value_.data_offset);
+  return true;
+}
+
+void GeTensorDesc::LoadFrom(const proto::TensorDescriptor &proto_msg) {
+  auto dst_msg = MutableProtoMsg();
+  if (dst_msg == nullptr) {
+    return;
+  }
+  if (dst_msg != &proto_msg) {
+    *dst_msg = proto_msg;
+  }
+  if (proto_ref_) {
+    return;
+  }
+  value_.format = TypeUtils::SerialStringToFormat(dst_msg->layout());
+  value_.size = dst_msg->size();
+  value_.weight_size = dst_msg->weight_size();
+  value_.real_dim_cnt = dst_msg->real_dim_cnt();
+  value_.data_offset = dst_msg->data_offset();
+  __shape_.dims_.assign(dst_msg->shape().dim().begin(), dst_msg->shape().dim().end());
+  LoadTypedAttrs(*dst_msg);
+}
+
+void GeTensorDesc::LoadTypedAttrs(const proto::TensorDescriptor &proto_msg) {
+  value_.data_type = GetProtoDataType(&proto_msg);
+  auto origin_format_str = GetDescStrAttr(&proto_msg, TENSOR_UTILS_ORIGIN_FORMAT);
+  value_.has_origin_format = (origin_format_str != nullptr);
+  value_.origin_format = value_.has_origin_format ? OriginFormatFromString(*origin_format_str) : FORMAT_RESERVED;
+  auto origin_data_type_str = GetDescStrAttr(&proto_msg, TENSOR_UTILS_ORIGIN_DATA_TYPE);
+  value_.has_origin_data_type = (origin_data_type_str != nullptr);
+  value_.origin_data_type =
+      value_.has_origin_data_type ? OriginDataTypeFromString(*origin_data_type_str) : DT_UNDEFINED;
+  attrs_in_proto_ = false;
+  attrs_synced_ = true;
+}
+
+void GeTensorDesc::CopyFrom(const GeTensorDesc &desc) {
+  if (proto_ref_) {
+    auto proto_msg = tensor_descriptor_.GetProtoMsg();
+    if (proto_msg != nullptr) {
+      (void)desc.MaterializeTo(*proto_msg);
+    }
+    return;
+  }
+  if (desc.proto_ref_) {
+    auto src_msg = desc.tensor_descriptor_.GetProtoMsg();
+    if (src_msg != nullptr) {
+      LoadFrom(*src_msg);
+    }
+    return;
+  }
+  value_ = desc.value_;
+  __shape_.dims_ = desc.__shape_.dims_;
+  attrs_in_proto_ = desc.attrs_in_proto_;
+  attrs_synced_ = desc.attrs_synced_.load();
+  auto src_msg = desc.tensor_descriptor_.GetProtoMsg();
+  if (src_msg == nullptr) {
+    tensor_descriptor_ = GeIrProtoHelper<proto::TensorDescriptor>();
+    return;
+  }
+  auto proto_msg = MutableProtoMsg();
+  if (proto_msg != nullptr) {
+    *proto_msg = *src_msg;
+    // the attr map of the copy is not handed out yet, the values stored in attrs are typed again
+    if (attrs_in_proto_) {
+      LoadTypedAttrs(*proto_msg);
+    }
+  }
 }
 
 ProtoAttrMapHelper GeTensorDesc::MutableAttrMap() {
-  if (tensor_descriptor_.GetProtoMsg() != nullptr) {
-    return ProtoAttrMapHelper(tensor_descriptor_.GetProtoOwner(), tensor_descriptor_.GetProtoMsg()->mutable_attr());
+  auto proto_msg = MutableProtoMsg();
+  if (proto_msg == nullptr) {
+    return ProtoAttrMapHelper(tensor_descriptor_.GetProtoOwner(), nullptr);
   }
-  return ProtoAttrMapHelper(tensor_descriptor_.GetProtoOwner(), nullptr);
+  // the attrs may be written through the map from now on, so the typed values kept in
+  // attrs are moved to it and read from it
+  SyncAttrsToProto();
+  attrs_in_proto_ = true;
+  return ProtoAttrMapHelper(tensor_descriptor_.GetProtoOwner(), proto_msg->mutable_attr());
 }
 
 ConstProtoAttrMapHelper GeTensorDesc::GetAttrMap() const {
-  if (tensor_descriptor_.GetProtoMsg() != nullptr) {
-    return ConstProtoAttrMapHelper(tensor_descriptor_.GetProtoOwner(),
-                                   tensor_descriptor_.GetProtoMsg()->mutable_attr());
+  if (TypedAttrsValid() && !attrs_synced_) {
+    std::lock_guard<std::mutex> lock(GetAttrsSyncMutex());
+    SyncAttrsToProto();
+  }
+  auto proto_msg = tensor_descriptor_.GetProtoMsg();
+  if (proto_msg != nullptr) {
+    return ConstProtoAttrMapHelper(tensor_descriptor_.GetProtoOwner(), proto_msg->mutable_attr());
   }
   return ConstProtoAttrMapHelper(tensor_descriptor_.GetProtoOwner(), nullptr);
 }
@@ -387,6 +692,9 @@ void GeTensorDesc::SetOriginShape(const GeShape &origin_shape) {
 }
 
 Format GeTensorDesc::GetFormat() const {
+  if (!proto_ref_) {
+    return value_.format;
+  }
   auto tensor_descriptor_msg = tensor_descriptor_.GetProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     return TypeUtils::SerialStringToFormat(tensor_descriptor_msg->layout());
@@ -395,6 +703,10 @@ Format GeTensorDesc::GetFormat() const {
 }
 
 void GeTensorDesc::SetFormat(Format format) {
+  if (!proto_ref_) {
+    value_.format = format;
+    return;
+  }
   auto tensor_descriptor_msg = tensor_descriptor_.GetProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     tensor_descriptor_msg->set_layout(TypeUtils::FormatToSerialString(format));
@@ -402,88 +714,72 @@ void GeTensorDesc::SetFormat(Format format) {
 }
 
 Format GeTensorDesc::GetOriginFormat() const {
-  std::string origin_format_str;
-  if (!AttrUtils::GetStr(this, TENSOR_UTILS_ORIGIN_FORMAT, origin_format_str)) {
-    // Can not get the certificate and it's not set, return directly
-    return FORMAT_RESERVED;
+  if (TypedAttrsValid()) {
+    return value_.has_origin_format ? value_.origin_format : FORMAT_RESERVED;
   }
-  if (origin_format_str == "RESERVED") {
+  auto origin_format_str = GetDescStrAttr(tensor_descriptor_.GetProtoMsg(), TENSOR_UTILS_ORIGIN_FORMAT);
+  if (origin_format_str == nullptr) {
+    // Can not get the certificate and it's not set, return directly
     return FORMAT_RESERVED;
   }
-  return TypeUtils::SerialStringToFormat(origin_format_str);
+  return OriginFormatFromString(*origin_format_str);
 }
 
 void GeTensorDesc::SetOriginFormat(Format origin_format) {
-  std::string origin_format_str = "RESERVED";
-  if (origin_format != FORMAT_RESERVED) {
-    origin_format_str = TypeUtils::FormatToSerialString(origin_format);
+  if (TypedAttrsValid()) {
+    value_.origin_format = origin_format;
+    value_.has_origin_format = true;
+    attrs_synced_ = false;
+    return;
   }
-  (void)AttrUtils::SetStr(this, TENSOR_UTILS_ORIGIN_FORMAT, origin_format_str);
+  (void)AttrUtils::SetStr(this, TENSOR_UTILS_ORIGIN_FORMAT, OriginFormatToString(origin_format));
 }
 
 DataType GeTensorDesc::GetDataType() const {
+  if (TypedAttrsValid()) {
+    return value_.data_type;
+  }
   auto tensor_descriptor_msg = tensor_descriptor_.GetProtoMsg();
   if (tensor_descriptor_msg == nullptr) {
     return DT_UNDEFINED;
   }
-  auto &attr_map = *(tensor_descriptor_msg->mutable_attr());
-  // Data type
-  auto it_data_type = attr_map.find(kKeyDataTypeSelfDefined);
-  if (it_data_type != attr_map.end()) {
-    int64_t data_type_proto = it_data_type->second.i();
-    for (auto it : kDataTypeSelfDefinedMap) {
-      if (it.second == data_type_proto) {
-        return it.first;
-      }
-    }
-  } else {
-    auto data_type_proto = tensor_descriptor_msg->dtype();
-    for (auto it : kDataTypeMap) {
-      if (it.second == data_type_proto) {
-        return it.first;
-      }
-    }
-  }
-  return DT_UNDEFINED;
+  return GetProtoDataType(tensor_descriptor_msg);
 }
 
 void GeTensorDesc::SetDataType(DataType dataType) {
-  auto tensor_descriptor_msg = tensor_descriptor_.GetProtoMsg();
-  if (tensor_descriptor_msg == nullptr) {
-    return;
-  }
-  auto &attr_maps = *(tensor_descriptor_msg->mutable_attr());
-  (void)attr_maps.erase(kKeyDataTypeSelfDefined);
-
-  // Data type
-  auto it = kDataTypeMap.find(dataType);
-  if (it != kDataTypeMap.end()) {
-    tensor_descriptor_msg->set_dtype(it->second);
+  if (TypedAttrsValid()) {
+    // a data type known to neither of the maps is not set, as the proto can not hold it
+    if ((kDataTypeMap.count(dataType) > 0) || (kDataTypeSelfDefinedMap.count(dataType) > 0)) {
+      value_.data_type = dataType;
+      attrs_synced_ = false;
+    }
     return;
   }
-  auto it2 = kDataTypeSelfDefinedMap.find(dataType);
-  if (it2 != kDataTypeSelfDefinedMap.end()) {
-    attr_maps[kKeyDataTypeSelfDefined].set_i(it2->second);
+  auto tensor_descriptor_msg = tensor_descriptor_.GetProtoMsg();
+  if (tensor_descriptor_msg != nullptr) {
+    SetProtoDataType(tensor_descriptor_msg, dataType);
   }
 }
 
 void GeTensorDesc::SetOriginDataType(DataType origin_data_type) {
-  std::string origin_data_type_str = "RESERVED";
-  if (origin_data_type != DT_UNDEFINED) {
-    origin_data_type_str = TypeUtils::DataTypeToSerialString(origin_data_type);
+  if (TypedAttrsValid()) {
+    value_.origin_data_type = origin_data_type;
+    value_.has_origin_data_type = true;
+    attrs_synced_ = false;
+    return;
   }
-  (void)AttrUtils::SetStr(this, TENSOR_UTILS_ORIGIN_DATA_TYPE, origin_data_type_str);
+  (void)AttrUtils::SetStr(this, TENSOR_UTILS_ORIGIN_DATA_TYPE, OriginDataTypeToString(origin_data_type));
 }
 
 DataType GeTensorDesc::GetOriginDataType() const {
-  std::string origin_data_type_str;
-  if (!AttrUtils::GetStr(this, TENSOR_UTILS_ORIGIN_DATA_TYPE, origin_data_type_str)) {
-    return DT_UNDEFINED;
+  if (TypedAttrsValid()) {
+    return value_.has_origin_data_type ? value_.origin_data_type : DT_UNDEFINED;
   }
-  if (origin_data_type_str == "RESERVED") {
+  auto origin_data_type_str = GetDescStrAttr(tensor_descriptor_.GetProtoMsg(), TENSOR_UTILS_ORIGIN_DATA_TYPE);
+  if (origin_data_type_str == nullptr) {
     return DT_UNDEFINED;
   }
-  return TypeUtils::SerialStringToDataType(origin_data_type_str);
+  return OriginDataTypeFromString(*origin_data_type_str);
 }
 
 graphStatus GeTensorDesc::IsValid() const {
@@ -499,14 +795,14 @@ GeTensorDesc GeTensorDesc::Clone() const { return *this; }
 
 GeTensorDesc &GeTensorDesc::operator=(const GeTensorDesc &desc) {
   if (&desc != this) {
-    tensor_descriptor_.CopyValueFrom(desc.tensor_descriptor_);
+    CopyFrom(desc);
   }
   return *this;
 }
 
 GeTensorDesc &GeTensorDesc::operator=(GeTensorDesc &&desc) {
   if (&desc != this) {
-    tensor_descriptor_.CopyValueFrom(std::move(desc.tensor_descriptor_));
+    CopyFrom(desc);
   }
   return *this;
 }
@@ -647,21 +943,32 @@ GeTensor &GeTensor::operator=(const GeTensor &other) {
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::GetSize(const GeTensorDesc &tensor_desc,
                                                                                 uint32_t &size) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  if (!tensor_desc.proto_ref_) {
+    size = static_cast<uint32_t>(tensor_desc.value_.size);
+    return GRAPH_SUCCESS;
+  }
+  auto tensor_descriptor_msg = tensor_desc.ProtoMsg();
   GE_CHECK_NOTNULL(tensor_descriptor_msg);
   size = static_cast<uint32_t>(tensor_descriptor_msg->size());
   return GRAPH_SUCCESS;
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetSize(GeTensorDesc &tensor_desc, uint32_t size) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  if (!tensor_desc.proto_ref_) {
+    tensor_desc.value_.size = size;
+    return;
+  }
+  auto tensor_descriptor_msg = tensor_desc.MutableProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     tensor_descriptor_msg->set_size(size);
   }
 }
 
 uint32_t TensorUtils::GetWeightSize(const GeTensorDesc &tensor_desc) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  if (!tensor_desc.proto_ref_) {
+    return static_cast<uint32_t>(tensor_desc.value_.weight_size);
+  }
+  auto tensor_descriptor_msg = tensor_desc.ProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     return static_cast<uint32_t>(tensor_descriptor_msg->weight_size());
   }
@@ -704,7 +1011,11 @@ uint8_t *TensorUtils::GetWeightAddr(const GeTensor &tensor, uint8_t *base) {
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetWeightSize(GeTensorDesc &tensor_desc,
                                                                                uint32_t size) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  if (!tensor_desc.proto_ref_) {
+    tensor_desc.value_.weight_size = size;
+    return;
+  }
+  auto tensor_descriptor_msg = tensor_desc.MutableProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     tensor_descriptor_msg->set_weight_size(size);
   }
@@ -712,14 +1023,14 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetWeightSize(G
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::GetReuseInput(const GeTensorDesc &tensor_desc,
                                                                                       bool &flag) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.ProtoMsg();
   GE_CHECK_NOTNULL(tensor_descriptor_msg);
   flag = tensor_descriptor_msg->reuse_input();
   return GRAPH_SUCCESS;
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetReuseInput(GeTensorDesc &tensor_desc, bool flag) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.MutableProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     tensor_descriptor_msg->set_reuse_input(flag);
   }
@@ -727,14 +1038,14 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetReuseInput(G
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::GetOutputTensor(const GeTensorDesc &tensor_desc,
                                                                                         bool &flag) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.ProtoMsg();
   GE_CHECK_NOTNULL(tensor_descriptor_msg);
   flag = tensor_descriptor_msg->output_tensor();
   return GRAPH_SUCCESS;
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetOutputTensor(GeTensorDesc &tensor_desc, bool flag) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.MutableProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     tensor_descriptor_msg->set_output_tensor(flag);
   }
@@ -749,7 +1060,7 @@ static map<string, uint32_t> str_to_device_map{
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::GetDeviceType(const GeTensorDesc &tensor_desc,
                                                                                       DeviceType &type) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.ProtoMsg();
   GE_CHECK_NOTNULL(tensor_descriptor_msg);
   string type_str = tensor_descriptor_msg->device_type();
   type = DeviceType(str_to_device_map[type_str]);
@@ -759,7 +1070,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::GetDevic
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetDeviceType(GeTensorDesc &tensor_desc,
                                                                                DeviceType type) {
   auto type_str = device_to_str_map[type];
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.MutableProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     tensor_descriptor_msg->set_device_type(type_str);
   }
@@ -767,14 +1078,14 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetDeviceType(G
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::GetInputTensor(const GeTensorDesc &tensor_desc,
                                                                                        bool &flag) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.ProtoMsg();
   GE_CHECK_NOTNULL(tensor_descriptor_msg);
   flag = tensor_descriptor_msg->input_tensor();
   return GRAPH_SUCCESS;
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetInputTensor(GeTensorDesc &tensor_desc, bool flag) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.MutableProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     tensor_descriptor_msg->set_input_tensor(flag);
   }
@@ -782,7 +1093,11 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetInputTensor(
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::GetRealDimCnt(const GeTensorDesc &tensor_desc,
                                                                                       uint32_t &cnt) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  if (!tensor_desc.proto_ref_) {
+    cnt = static_cast<uint32_t>(tensor_desc.value_.real_dim_cnt);
+    return GRAPH_SUCCESS;
+  }
+  auto tensor_descriptor_msg = tensor_desc.ProtoMsg();
   GE_CHECK_NOTNULL(tensor_descriptor_msg);
   cnt = static_cast<uint32_t>(tensor_descriptor_msg->real_dim_cnt());
   return GRAPH_SUCCESS;
@@ -790,7 +1105,11 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::GetRealD
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetRealDimCnt(GeTensorDesc &tensor_desc,
                                                                                uint32_t cnt) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  if (!tensor_desc.proto_ref_) {
+    tensor_desc.value_.real_dim_cnt = cnt;
+    return;
+  }
+  auto tensor_descriptor_msg = tensor_desc.MutableProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     tensor_descriptor_msg->set_real_dim_cnt(cnt);
   }
@@ -798,7 +1117,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetRealDimCnt(G
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus
 TensorUtils::GetReuseInputIndex(const GeTensorDesc &tensor_desc, uint32_t &idx) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.ProtoMsg();
   GE_CHECK_NOTNULL(tensor_descriptor_msg);
 
   idx = static_cast<uint32_t>(tensor_descriptor_msg->reuse_input_index());
@@ -807,7 +1126,7 @@ TensorUtils::GetReuseInputIndex(const GeTensorDesc &tensor_desc, uint32_t &idx)
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetReuseInputIndex(GeTensorDesc &tensor_desc,
                                                                                     uint32_t idx) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.MutableProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     tensor_descriptor_msg->set_reuse_input_index(idx);
   }
@@ -815,7 +1134,11 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetReuseInputIn
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::GetDataOffset(const GeTensorDesc &tensor_desc,
                                                                                       int64_t &offset) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  if (!tensor_desc.proto_ref_) {
+    offset = tensor_desc.value_.data_offset;
+    return GRAPH_SUCCESS;
+  }
+  auto tensor_descriptor_msg = tensor_desc.ProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     offset = tensor_descriptor_msg->data_offset();
     return GRAPH_SUCCESS;
@@ -827,7 +1150,11 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::GetDataO
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetDataOffset(GeTensorDesc &tensor_desc,
                                                                                int64_t offset) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  if (!tensor_desc.proto_ref_) {
+    tensor_desc.value_.data_offset = offset;
+    return;
+  }
+  auto tensor_descriptor_msg = tensor_desc.MutableProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     tensor_descriptor_msg->set_data_offset(offset);
   }
@@ -835,7 +1162,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetDataOffset(G
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::GetCmpsSize(const GeTensorDesc &tensor_desc,
                                                                                     uint32_t &cmp_size) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.ProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     cmp_size = static_cast<uint32_t>(tensor_descriptor_msg->cmps_size());
   }
@@ -844,7 +1171,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::GetCmpsS
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetCmpsSize(GeTensorDesc &tensor_desc,
                                                                              uint32_t cmp_size) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.MutableProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     tensor_descriptor_msg->set_cmps_size(cmp_size);
   }
@@ -852,7 +1179,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetCmpsSize(GeT
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::GetCmpsTab(const GeTensorDesc &tensor_desc,
                                                                                    vector<uint8_t> &vec) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.ProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     string str = tensor_descriptor_msg->cmps_tab();
     vec.assign(str.begin(), str.end());
@@ -862,7 +1189,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::GetCmpsT
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetCmpsTab(GeTensorDesc &tensor_desc,
                                                                             const uint8_t *data, size_t size) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.MutableProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     GE_CHK_BOOL_EXEC(data != nullptr, return, "data is null.");
     string str((const char *)data, size);
@@ -872,7 +1199,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetCmpsTab(GeTe
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus
 TensorUtils::GetCmpsTabOffset(const GeTensorDesc &tensor_desc, int64_t &tab_offset) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.ProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     tab_offset = tensor_descriptor_msg->cmps_tab_offset();
   }
@@ -881,7 +1208,7 @@ TensorUtils::GetCmpsTabOffset(const GeTensorDesc &tensor_desc, int64_t &tab_offs
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void TensorUtils::SetCmpsTabOffset(GeTensorDesc &tensor_desc,
                                                                                   int64_t tab_offset) {
-  auto tensor_descriptor_msg = tensor_desc.tensor_descriptor_.GetProtoMsg();
+  auto tensor_descriptor_msg = tensor_desc.MutableProtoMsg();
   if (tensor_descriptor_msg != nullptr) {
     tensor_descriptor_msg->set_cmps_tab_offset(tab_offset);
   }
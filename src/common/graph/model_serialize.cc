@@ -98,8 +98,8 @@ bool ModelSerializeImp::SerializeOpDesc(const ConstOpDescPtr &op_desc, proto::Op
       auto size = static_cast<uint32_t>(op_desc->GetInputsSize());
       for (uint32_t i = 0; i < size; i++) {
         auto tensor_desc = op_desc->GetInputDescPtr(i);
-        if (tensor_desc != nullptr && tensor_desc->tensor_descriptor_.GetProtoMsg() != nullptr) {
-          *op_def_proto->add_input_desc() = *(tensor_desc->tensor_descriptor_.GetProtoMsg());
+        if (tensor_desc != nullptr && !tensor_desc->MaterializeTo(*op_def_proto->add_input_desc())) {
+          op_def_proto->mutable_input_desc()->RemoveLast();
         }
       }
     }
@@ -108,8 +108,8 @@ bool ModelSerializeImp::SerializeOpDesc(const ConstOpDescPtr &op_desc, proto::Op
       auto size = static_cast<uint32_t>(op_desc->GetOutputsSize());
       for (uint32_t i = 0; i < size; i++) {
         auto tensor_desc = op_desc->GetOutputDescPtr(i);
-        if (tensor_desc != nullptr && tensor_desc->tensor_descriptor_.GetProtoMsg() != nullptr) {
-          *op_def_proto->add_output_desc() = *(tensor_desc->tensor_descriptor_.GetProtoMsg());
+        if (tensor_desc != nullptr && !tensor_desc->MaterializeTo(*op_def_proto->add_output_desc())) {
+          op_def_proto->mutable_output_desc()->RemoveLast();
         }
       }
     }
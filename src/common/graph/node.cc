@@ -22,6 +22,7 @@
 #include "debug/ge_util.h"
 #include "external/graph/operator_factory.h"
 #include "framework/common/debug/ge_log.h"
+#include "graph/detail/node_storage.h"
 #include "graph/ge_tensor.h"
 #include "graph/operator_factory_impl.h"
 #include "graph/shape_refiner.h"
@@ -791,6 +792,10 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus Node::UpdateOpDesc(co
                    "Outputs count expected to be same, orginial OpDesc %zu, Param OpDesc %zu", op_->GetOutputsSize(),
                    op_desc->GetOutputsSize());
   op_ = op_desc;
+  // a node held by a graph is owned by a shared ptr
+  if (GetOwnerComputeGraph() != nullptr) {
+    NodeStorage::OnOpDescUpdated(shared_from_this());
+  }
   return GRAPH_SUCCESS;
 }
 
@@ -20,6 +20,8 @@
 #include "debug/ge_util.h"
 #include "external/graph/operator.h"
 #include "framework/common/debug/ge_log.h"
+#include "graph/detail/attr_typed_table.h"
+#include "graph/detail/node_storage.h"
 #include "graph/ge_attr_value.h"
 #include "graph/ge_tensor.h"
 #include "graph/operator_factory_impl.h"
@@ -67,6 +69,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY OpDesc::OpDesc() {
   if (op_def_.GetProtoMsg() != nullptr) {
     op_def_.GetProtoMsg()->set_has_out_attr(true);
   }
+  typed_attrs_ = ComGraphMakeShared<AttrTypedTable>();
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY OpDesc::~OpDesc() {}
@@ -76,6 +79,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY OpDesc::OpDesc(const std::string
   if (op_def_.GetProtoMsg() != nullptr) {
     op_def_.GetProtoMsg()->set_has_out_attr(true);
   }
+  typed_attrs_ = ComGraphMakeShared<AttrTypedTable>();
   SetName(name);
   SetType(type);
 }
@@ -153,6 +157,8 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY OpDesc::OpDesc(const ProtoMsgOwne
       *op_def->mutable_output_desc() = *(output_desc_mutable_list->mutable_td());
     }
   }
+  // built from the attr map on the first typed read
+  typed_attrs_ = ComGraphMakeShared<AttrTypedTable>();
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY string OpDesc::GetName() const {
@@ -167,6 +173,8 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void OpDesc::SetName(const std::s
   auto proto_msg = op_def_.GetProtoMsg();
   if (proto_msg != nullptr) {
     proto_msg->set_name(name);
+    // the graph holding the node finds it by the new name
+    NodeStorage::OnOpDescRenamed(*this);
   }
 }
 
@@ -813,6 +821,10 @@ ProtoAttrMapHelper OpDesc::MutableAttrMap() {
     GELOGE(GRAPH_FAILED, "op def get proto msg failed");
     return GeIrProtoHelper<ProtoAttrMap>();
   }
+  // the caller may write any item, AttrHolder::WriteAttrMapItem brings the table back in sync
+  if (typed_attrs_ != nullptr) {
+    typed_attrs_->MarkStale();
+  }
   return ProtoAttrMapHelper(op_def_.GetProtoOwner(), op_def_.GetProtoMsg()->mutable_attr());
 }
 
@@ -282,8 +282,9 @@ void OnnxUtils::AddAttrProtoForOpInAndOutDesc(onnx::NodeProto *node_proto, const
         auto layout_origin = TypeUtils::FormatToSerialString(input_desc->GetOriginFormat());
         AddAttrProto(node_proto, onnx::AttributeProto_AttributeType_STRING,
                      "input_desc_origin_layout:" + std::to_string(i), &layout_origin);
-        auto tensor_descriptor = input_desc->tensor_descriptor_.GetProtoMsg();
-        if (tensor_descriptor != nullptr) {
+        proto::TensorDescriptor tensor_descriptor_msg;
+        if (input_desc->MaterializeTo(tensor_descriptor_msg)) {
+          auto tensor_descriptor = &tensor_descriptor_msg;
           auto size = tensor_descriptor->size();
           AddAttrProto(node_proto, onnx::AttributeProto_AttributeType_INT, "input_desc_size:" + std::to_string(i),
                        &size);
@@ -346,8 +347,9 @@ void OnnxUtils::AddAttrProtoForOpInAndOutDesc(onnx::NodeProto *node_proto, const
         auto layout_origin = TypeUtils::FormatToSerialString(output_desc->GetOriginFormat());
         AddAttrProto(node_proto, onnx::AttributeProto_AttributeType_STRING,
                      "output_desc_origin_layout:" + std::to_string(i), &layout_origin);
-        auto tensor_descriptor = output_desc->tensor_descriptor_.GetProtoMsg();
-        if (tensor_descriptor != nullptr) {
+        proto::TensorDescriptor tensor_descriptor_msg;
+        if (output_desc->MaterializeTo(tensor_descriptor_msg)) {
+          auto tensor_descriptor = &tensor_descriptor_msg;
           auto size = tensor_descriptor->size();
           AddAttrProto(node_proto, onnx::AttributeProto_AttributeType_INT, "output_desc_size:" + std::to_string(i),
                        &size);
@@ -19,10 +19,14 @@
 #include <fcntl.h>
 #include <securec.h>
 #include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
 #include <cstdlib>
 #include <fstream>
 #include <vector>
 
+#include "common/task_executor.h"
 #include "framework/common/debug/ge_log.h"
 #include "framework/common/debug/log.h"
 #include "framework/common/util.h"
@@ -32,6 +36,77 @@ const int kFileOpSuccess = 0;
 const char TEE_PASSCODE_FILE_SUFFIX[] = ".PASSCODE";
 const char TEE_DAVINCI_FILE_SUFFIX[] = ".om";
 const size_t TEE_DAVINCI_FILE_SUFFIX_SIZE = 3;
+// bytes written by one pwrite, below SSIZE_MAX everywhere
+const size_t kMaxWriteSize = 1UL << 30;
+
+// Writes a partition at its offset in the file, never beyond the size it is declared with
+class FilePartitionOutput : public ge::PartitionOutput {
+ public:
+  FilePartitionOutput(int32_t fd, uint64_t offset, uint64_t size) : fd_(fd), offset_(offset), size_(size) {}
+
+  ~FilePartitionOutput() override = default;
+
+  ge::Status Write(const void *data, size_t size) override;
+
+  uint64_t GetWrittenSize() const { return written_; }
+
+ private:
+  int32_t fd_;
+  uint64_t offset_;
+  uint64_t size_;
+  uint64_t written_ = 0;
+};
+
+ge::Status WriteDataAt(const void *data, size_t size, uint64_t offset, int32_t fd) {
+  GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(size == 0 || data == nullptr, return ge::PARAM_INVALID);
+
+  // pwrite may write less than asked, and no more than SSIZE_MAX at once
+  const char *begin = static_cast<const char *>(data);
+  size_t written = 0;
+  while (written < size) {
+    size_t count = std::min(size - written, kMaxWriteSize);
+    ssize_t write_count = pwrite(fd, begin + written, count, static_cast<off_t>(offset + written));
+    if (write_count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (write_count <= 0) {
+      GELOGE(ge::FAILED, "Write data failed at offset %lu, errno = %d", offset + written, errno);
+      return ge::FAILED;
+    }
+    written += static_cast<size_t>(write_count);
+  }
+  return ge::SUCCESS;
+}
+
+ge::Status WritePartition(const ge::ModelPartition &partition, const ge::PartitionProducer &producer, uint64_t offset,
+                          int32_t fd) {
+  if (producer == nullptr) {
+    return WriteDataAt(partition.data, partition.size, offset, fd);
+  }
+
+  FilePartitionOutput output(fd, offset, partition.size);
+  ge::Status ret = producer(output);
+  GE_CHK_BOOL_RET_STATUS(ret == ge::SUCCESS, ret, "Produce partition of type %d failed.",
+                         static_cast<int>(partition.type));
+  // a short partition would leave a hole of zeros in the file
+  GE_CHK_BOOL_RET_STATUS(output.GetWrittenSize() == partition.size, ge::FAILED,
+                         "Partition of type %d is %lu bytes, but %u bytes are declared.",
+                         static_cast<int>(partition.type), output.GetWrittenSize(), partition.size);
+  return ge::SUCCESS;
+}
+
+ge::Status FilePartitionOutput::Write(const void *data, size_t size) {
+  GE_CHK_BOOL_RET_STATUS(size <= size_ - written_, ge::FAILED, "Partition is longer than its declared size %lu.",
+                         size_);
+  if (size == 0) {
+    return ge::SUCCESS;
+  }
+  ge::Status ret = WriteDataAt(data, size, offset_ + written_, fd_);
+  if (ret == ge::SUCCESS) {
+    written_ += size;
+  }
+  return ret;
+}
 }  //  namespace
 
 namespace ge {
@@ -100,29 +175,51 @@ Status FileSaver::SaveWithFileHeader(const std::string &file_path, const ModelFi
 
 Status FileSaver::SaveWithFileHeader(const std::string &file_path, const ModelFileHeader &file_header,
                                      ModelPartitionTable &model_partition_table,
-                                     const std::vector<ModelPartition> &partition_datas) {
+                                     const std::vector<ModelPartition> &partition_datas,
+                                     const std::vector<PartitionProducer> &partition_producers) {
   GE_CHK_BOOL_RET_STATUS(
       !partition_datas.empty() && model_partition_table.num != 0 && model_partition_table.num == partition_datas.size(),
       FAILED, "Invalid param:partition data size(%u), model_partition_table.num(%zu).", model_partition_table.num,
       partition_datas.size());
+  GE_CHK_BOOL_RET_STATUS(partition_producers.empty() || partition_producers.size() == partition_datas.size(), FAILED,
+                         "Invalid param:partition producer size(%zu), partition data size(%zu).",
+                         partition_producers.size(), partition_datas.size());
+  // The layout is fixed by the sizes: header | partition table | partitions in the order of the table
+  uint64_t table_size = SIZE_OF_MODEL_PARTITION_TABLE(model_partition_table);
+  std::vector<uint64_t> offsets;
+  uint64_t offset = sizeof(ModelFileHeader) + table_size;
+  for (const auto &partition_data : partition_datas) {
+    offsets.push_back(offset);
+    offset += partition_data.size;
+  }
+  const PartitionProducer no_producer;
+  auto producer_of = [&partition_producers, &no_producer](size_t index) -> const PartitionProducer & {
+    return partition_producers.empty() ? no_producer : partition_producers[index];
+  };
+
   // Open file
   int32_t fd = 0;
   GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(OpenFile(fd, file_path) != SUCCESS, return FAILED);
   Status ret = SUCCESS;
   do {
     // Write file header
-    GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(
-        WriteData(static_cast<const void *>(&file_header), sizeof(ModelFileHeader), fd) != SUCCESS, ret = FAILED;
-        break);
+    GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(WriteDataAt(&file_header, sizeof(ModelFileHeader), 0, fd) != SUCCESS,
+                                   ret = FAILED;
+                                   break);
     // Write model partition table
-    uint32_t table_size = static_cast<uint32_t>(SIZE_OF_MODEL_PARTITION_TABLE(model_partition_table));
     GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(
-        WriteData(static_cast<const void *>(&model_partition_table), table_size, fd) != SUCCESS, ret = FAILED; break);
-    // Write partition data
-    for (const auto &partition_data : partition_datas) {
-      GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(
-          WriteData(static_cast<const void *>(partition_data.data), partition_data.size, fd) != SUCCESS, ret = FAILED;
-          break);
+        WriteDataAt(&model_partition_table, table_size, sizeof(ModelFileHeader), fd) != SUCCESS, ret = FAILED; break);
+    // Write partition data, the partitions do not overlap so they are written on the workers together
+    std::vector<Status> results(partition_datas.size(), SUCCESS);
+    auto write_func = [&](size_t begin, size_t end) -> Status {
+      for (size_t i = begin; i < end; ++i) {
+        results[i] = WritePartition(partition_datas[i], producer_of(i), offsets[i], fd);
+      }
+      return SUCCESS;
+    };
+    (void)TaskExecutor::Instance().ParallelFor(partition_datas.size(), 1, write_func);
+    for (size_t i = 0; i < results.size(); ++i) {
+      GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(results[i] != SUCCESS, ret = FAILED; break, "Write partition %zu failed.", i);
     }
   } while (0);
   // Close file
@@ -190,8 +287,16 @@ FileSaver::SaveToFile(const string &file_path, const ge::ModelData &model, const
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status
 FileSaver::SaveToFile(const string &file_path, ModelFileHeader &file_header, ModelPartitionTable &model_partition_table,
                       const std::vector<ModelPartition> &partition_datas) {
+  return SaveToFile(file_path, file_header, model_partition_table, partition_datas, {});
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status
+FileSaver::SaveToFile(const string &file_path, ModelFileHeader &file_header, ModelPartitionTable &model_partition_table,
+                      const std::vector<ModelPartition> &partition_datas,
+                      const std::vector<PartitionProducer> &partition_producers) {
   file_header.is_encrypt = ModelEncryptType::UNENCRYPTED;
-  const Status ret = SaveWithFileHeader(file_path, file_header, model_partition_table, partition_datas);
+  const Status ret =
+      SaveWithFileHeader(file_path, file_header, model_partition_table, partition_datas, partition_producers);
   GE_CHK_BOOL_RET_STATUS(ret == SUCCESS, FAILED, "Save file failed, file_path:%s, file header len:%u.",
                          file_path.c_str(), file_header.length);
   return SUCCESS;
@@ -73,6 +73,18 @@ class FileSaver {
                            ModelPartitionTable &model_partition_table,
                            const std::vector<ModelPartition> &partition_datas);
 
+  ///
+  /// @ingroup domi_common
+  /// @brief save model, no encryption, the partitions with a producer are written by it straight into the file
+  /// @param [in] partition_producers one per partition, empty or holding an empty producer for the partitions
+  ///        whose data is given
+  /// @return Status  result
+  ///
+  static Status SaveToFile(const string &file_path, ModelFileHeader &model_file_header,
+                           ModelPartitionTable &model_partition_table,
+                           const std::vector<ModelPartition> &partition_datas,
+                           const std::vector<PartitionProducer> &partition_producers);
+
  protected:
   ///
   /// @ingroup domi_common
@@ -97,9 +109,16 @@ class FileSaver {
   static Status SaveWithFileHeader(const string &file_path, const ModelFileHeader &file_header, const void *data,
                                    int len);
 
+  ///
+  /// @ingroup domi_common
+  /// @brief save partitioned model to file, every part is written at its offset so the partitions are written
+  ///        in parallel
+  /// @return Status  result
+  ///
   static Status SaveWithFileHeader(const std::string &file_path, const ModelFileHeader &file_header,
                                    ModelPartitionTable &model_partition_table,
-                                   const std::vector<ModelPartition> &partition_datas);
+                                   const std::vector<ModelPartition> &partition_datas,
+                                   const std::vector<PartitionProducer> &partition_producers);
 };
 }  // namespace ge
 #endif  // GE_COMMON_AUTH_FILE_SAVER_H_
@@ -17,9 +17,11 @@
 #include "common/formats/format_transfers/datatype_transfer.h"
 
 #include <stdint.h>
+#include <algorithm>
 #include <map>
 #include <utility>
 
+#include "common/formats/utils/formats_cast_utils.h"
 #include "common/formats/utils/formats_trans_utils.h"
 #include "common/fp16_t.h"
 #include "common/ge/ge_util.h"
@@ -31,6 +33,9 @@ namespace ge {
 namespace formats {
 
 namespace {
+// elements cast by one task when a large buffer is split across threads
+const int64_t kCastElementsPerTask = 64 * 1024;
+
 enum DataTypeTransMode {
   kTransferWithDatatypeFloatToFloat16,
   kTransferWithDatatypeFloatToInt32,
@@ -63,53 +68,54 @@ std::map<std::pair<DataType, DataType>, DataTypeTransMode> trans_mode_map{
     {std::pair<DataType, DataType>(DT_INT64, DT_INT32), kTransferWithDatatypeInt64ToInt32}};
 
 template <typename SrcT, typename DstT>
-Status TransDataSrc2Dst(const CastArgs &args, uint8_t *dst, const size_t data_size) {
+Status TransDataSrc2Dst(const uint8_t *src, uint8_t *dst, const size_t data_size) {
   SrcT src_data;
   for (size_t idx = 0; idx != data_size; idx++) {
-    src_data = reinterpret_cast<const SrcT *>(args.data)[idx];
+    src_data = reinterpret_cast<const SrcT *>(src)[idx];
     reinterpret_cast<DstT *>(dst)[idx] = static_cast<DstT>(src_data);
   }
   return SUCCESS;
 }
 
 template <typename SrcT>
-Status TransDataSrc2Fp16(const CastArgs &args, uint8_t *dst, const size_t data_size) {
+Status TransDataSrc2Fp16(const uint8_t *src, uint8_t *dst, const size_t data_size) {
   fp16_t src_data;
   for (size_t idx = 0; idx != data_size; idx++) {
-    src_data = reinterpret_cast<const SrcT *>(args.data)[idx];
+    src_data = reinterpret_cast<const SrcT *>(src)[idx];
     reinterpret_cast<uint16_t *>(dst)[idx] = src_data.val;
   }
   return SUCCESS;
 }
 
-Status CastKernel(const CastArgs &args, uint8_t *dst, const size_t data_size, const DataTypeTransMode trans_mode) {
+Status CastKernel(const CastArgs &args, const uint8_t *src, uint8_t *dst, const size_t data_size,
+                  const DataTypeTransMode trans_mode) {
   switch (trans_mode) {
     case kTransferWithDatatypeFloatToFloat16:
-      return TransDataSrc2Fp16<float>(args, dst, data_size);
+      return TransDataSrc2Fp16<float>(src, dst, data_size);
     case kTransferWithDatatypeFloatToInt32:
-      return TransDataSrc2Dst<float, int32_t>(args, dst, data_size);
+      return TransDataSrc2Dst<float, int32_t>(src, dst, data_size);
     case kTransferWithDatatypeFloat16ToFloat:
-      return TransDataSrc2Dst<fp16_t, float>(args, dst, data_size);
+      return TransDataSrc2Dst<fp16_t, float>(src, dst, data_size);
     case kTransferWithDatatypeFloat16ToInt32:
-      return TransDataSrc2Dst<fp16_t, int32_t>(args, dst, data_size);
+      return TransDataSrc2Dst<fp16_t, int32_t>(src, dst, data_size);
     case kTransferWithDatatypeInt32ToFloat:
-      return TransDataSrc2Dst<int32_t, float>(args, dst, data_size);
+      return TransDataSrc2Dst<int32_t, float>(src, dst, data_size);
     case kTransferWithDatatypeInt32ToFloat16:
-      return TransDataSrc2Fp16<int32_t>(args, dst, data_size);
+      return TransDataSrc2Fp16<int32_t>(src, dst, data_size);
     case kTransferWithDatatypeInt32ToUint8:
-      return TransDataSrc2Dst<int32_t, uint8_t>(args, dst, data_size);
+      return TransDataSrc2Dst<int32_t, uint8_t>(src, dst, data_size);
     case kTransferWithDatatypeInt32ToInt8:
-      return TransDataSrc2Dst<int32_t, int8_t>(args, dst, data_size);
+      return TransDataSrc2Dst<int32_t, int8_t>(src, dst, data_size);
     case kTransferWithDatatypeUint8ToFloat:
-      return TransDataSrc2Dst<uint8_t, float>(args, dst, data_size);
+      return TransDataSrc2Dst<uint8_t, float>(src, dst, data_size);
     case kTransferWithDatatypeUint8ToInt32:
-      return TransDataSrc2Dst<uint8_t, int32_t>(args, dst, data_size);
+      return TransDataSrc2Dst<uint8_t, int32_t>(src, dst, data_size);
     case kTransferWithDatatypeInt8ToFloat:
-      return TransDataSrc2Dst<int8_t, float>(args, dst, data_size);
+      return TransDataSrc2Dst<int8_t, float>(src, dst, data_size);
     case kTransferWithDatatypeInt8ToInt32:
-      return TransDataSrc2Dst<int8_t, int32_t>(args, dst, data_size);
+      return TransDataSrc2Dst<int8_t, int32_t>(src, dst, data_size);
     case kTransferWithDatatypeInt64ToInt32:
-      return TransDataSrc2Dst<int64_t, int32_t>(args, dst, data_size);
+      return TransDataSrc2Dst<int64_t, int32_t>(src, dst, data_size);
     default:
       GELOGE(PARAM_INVALID, "Trans data type from %s to %s is not supported.",
              TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
@@ -117,6 +123,29 @@ Status CastKernel(const CastArgs &args, uint8_t *dst, const size_t data_size, co
       return UNSUPPORTED;
   }
 }
+
+///
+/// Casts with the vectorized kernel of the cpu when there is one and finishes
+/// the tail of each task with CastKernel. Large buffers are split into tasks
+/// of kCastElementsPerTask elements and cast in parallel.
+///
+Status CastInParallel(const CastArgs &args, uint8_t *dst, const int dst_type_size,
+                      const DataTypeTransMode trans_mode) {
+  const int src_type_size = GetSizeByDataType(args.src_data_type);
+  const VectorCastFunc vector_cast = GetVectorCastFunc(args.src_data_type, args.dst_data_type);
+  const int64_t data_size = static_cast<int64_t>(args.src_data_size);
+  const int64_t task_num = Ceil(data_size, kCastElementsPerTask);
+  const int64_t total_bytes = data_size * (src_type_size + dst_type_size);
+  return ParallelFor(task_num, total_bytes, [&](int64_t begin, int64_t end) -> Status {
+    int64_t offset = begin * kCastElementsPerTask;
+    size_t num = static_cast<size_t>(std::min(end * kCastElementsPerTask, data_size) - offset);
+    const uint8_t *src_begin = args.data + offset * src_type_size;
+    uint8_t *dst_begin = dst + offset * dst_type_size;
+    size_t vector_num = (vector_cast == nullptr) ? 0 : vector_cast(src_begin, dst_begin, num);
+    return CastKernel(args, src_begin + vector_num * src_type_size, dst_begin + vector_num * dst_type_size,
+                      num - vector_num, trans_mode);
+  });
+}
 }  // namespace
 
 Status DataTypeTransfer::TransDataType(const CastArgs &args, TransResult &result) {
@@ -153,7 +182,7 @@ Status DataTypeTransfer::TransDataType(const CastArgs &args, TransResult &result
     return OUT_OF_MEMORY;
   }
 
-  if (CastKernel(args, dst.get(), args.src_data_size, trans_mode) != SUCCESS) {
+  if (CastInParallel(args, dst.get(), size, trans_mode) != SUCCESS) {
     GELOGE(INTERNAL_ERROR, "Failed to cast data from %s to %s, data size %zu",
            TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
            TypeUtils::DataTypeToSerialString(args.dst_data_type).c_str(), args.src_data_size);
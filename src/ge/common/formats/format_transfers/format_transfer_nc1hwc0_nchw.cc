@@ -19,6 +19,7 @@
 #include <securec.h>
 #include <memory>
 
+#include "common/formats/utils/formats_5d_trans_utils.h"
 #include "common/formats/utils/formats_definitions.h"
 #include "common/formats/utils/formats_trans_utils.h"
 #include "framework/common/debug/ge_log.h"
@@ -67,7 +68,8 @@ Status CheckArgsForNc1hwc0ToNchw(const TransArgs &args) {
   return SUCCESS;
 }
 
-Status GetDstDataAfterTrans(const TransArgs &args, TransResult &result, const int size, const int64_t total_size) {
+Status GetDstDataAfterTransByElement(const TransArgs &args, TransResult &result, const int size,
+                                     const int64_t total_size) {
   std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[total_size], std::default_delete<uint8_t[]>());
   if (dst == nullptr) {
     GELOGE(OUT_OF_MEMORY, "Failed to trans format from %s to %s, can not alloc the memory for dst buf %ld, shape %s",
@@ -121,30 +123,44 @@ Status GetDstDataAfterTrans(const TransArgs &args, TransResult &result, const in
   result.length = static_cast<size_t>(total_size);
   return SUCCESS;
 }
-}  // namespace
 
-Status FormatTransferNc1hwc0Nchw::TransFormat(const TransArgs &args, TransResult &result) {
-  if (CheckArgsForNc1hwc0ToNchw(args) != SUCCESS) {
-    return PARAM_INVALID;
-  }
-  int size = GetSizeByDataType(args.src_data_type);
-  auto total_size = GetItemNumByShape(args.dst_shape) * size;
-  if (total_size <= 0) {
-    GELOGE(INTERNAL_ERROR, "Get %ld total size from dst shape %s, src shape %s", total_size,
-           ShapeToString(args.dst_shape).c_str(), ShapeToString(args.src_shape).c_str());
-    return PARAM_INVALID;
+Status GetDstDataAfterTrans(const TransArgs &args, TransResult &result, const int size, const int64_t total_size) {
+  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[total_size], std::default_delete<uint8_t[]>());
+  if (dst == nullptr) {
+    GELOGE(OUT_OF_MEMORY, "Failed to trans format from %s to %s, can not alloc the memory for dst buf %ld, shape %s",
+           TypeUtils::FormatToSerialString(args.src_format).c_str(),
+           TypeUtils::FormatToSerialString(args.dst_format).c_str(), total_size, ShapeToString(args.dst_shape).c_str());
+    return OUT_OF_MEMORY;
   }
-  GELOGD("Begin to trans format from NC1HWC0 to NCHW, src shape %s, data type %s, dst shape %s, memory size %ld",
-         ShapeToString(args.src_shape).c_str(), TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
-         ShapeToString(args.dst_shape).c_str(), total_size);
-  if (GetDstDataAfterTrans(args, result, size, total_size) != SUCCESS) {
-    GELOGE(INTERNAL_ERROR, "Failed to get data after trans, src shape %s, data type %s, dst shape %s, memory size %ld",
-           ShapeToString(args.src_shape).c_str(), TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
-           ShapeToString(args.dst_shape).c_str(), total_size);
-    return INTERNAL_ERROR;
+
+  auto c = args.dst_shape.at(kNchwC);
+  Trans5dParams params;
+  params.n = args.src_shape.at(kNc1hwc0N);
+  params.c = c;
+  params.hw = args.src_shape.at(kNc1hwc0H) * args.src_shape.at(kNc1hwc0W);
+  params.c1 = args.src_shape.at(kNc1hwc0C1);
+  params.c0 = args.src_shape.at(kNc1hwc0C0);
+  params.n_stride = c * params.hw;
+  params.c_stride = params.hw;
+  params.hw_stride = 1;
+  params.size = size;
+  auto ret = TransDataFrom5d(params, args.data, dst.get());
+  if (ret != SUCCESS) {
+    return ret;
   }
+  result.data = dst;
+  result.length = static_cast<size_t>(total_size);
   return SUCCESS;
 }
+}  // namespace
+
+Status FormatTransferNc1hwc0Nchw::TransFormat(const TransArgs &args, TransResult &result) {
+  return TransFormatWith(args, result, CheckArgsForNc1hwc0ToNchw, GetDstDataAfterTrans);
+}
+
+Status FormatTransferNc1hwc0Nchw::TransFormatByElement(const TransArgs &args, TransResult &result) {
+  return TransFormatWith(args, result, CheckArgsForNc1hwc0ToNchw, GetDstDataAfterTransByElement);
+}
 
 Status FormatTransferNc1hwc0Nchw::TransShape(Format src_format, const std::vector<int64_t> &src_shape,
                                              DataType data_type, Format dst_format, std::vector<int64_t> &dst_shape) {
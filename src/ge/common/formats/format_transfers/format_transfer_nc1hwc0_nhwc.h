@@ -26,6 +26,8 @@ namespace formats {
 class FormatTransferNc1hwc0Nhwc : public FormatTransfer {
  public:
   Status TransFormat(const TransArgs &args, TransResult &result) override;
+  // Element-by-element reference of TransFormat, kept to verify the blocked implementation
+  Status TransFormatByElement(const TransArgs &args, TransResult &result);
   Status TransShape(Format src_format, const std::vector<int64_t> &src_shape, DataType data_type, Format dst_format,
                     std::vector<int64_t> &dst_shape) override;
 };
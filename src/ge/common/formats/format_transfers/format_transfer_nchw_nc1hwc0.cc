@@ -19,6 +19,7 @@
 #include <securec.h>
 #include <memory>
 
+#include "common/formats/utils/formats_5d_trans_utils.h"
 #include "common/formats/utils/formats_definitions.h"
 #include "common/formats/utils/formats_trans_utils.h"
 #include "framework/common/debug/ge_log.h"
@@ -74,25 +75,9 @@ Status CheckArgsForNchwToNc1hwc0(const TransArgs &args) {
 
   return SUCCESS;
 }
-}  // namespace
 
-Status FormatTransferNchwNc1hwc0::TransFormat(const TransArgs &args, TransResult &result) {
-  if (CheckArgsForNchwToNc1hwc0(args) != SUCCESS) {
-    return PARAM_INVALID;
-  }
-  // Guarantee the validity of parameters in check function
-  int size = GetSizeByDataType(args.src_data_type);
-  auto total_size = GetItemNumByShape(args.dst_shape) * size;
-  if (total_size <= 0) {
-    GELOGE(INTERNAL_ERROR, "Get %ld total size from dst shape %s, src shape %s", total_size,
-           ShapeToString(args.dst_shape).c_str(), ShapeToString(args.src_shape).c_str());
-    return PARAM_INVALID;
-  }
-  GELOGD(
-      "Begin to trans format from NCHW to NC1HWC0, src shape %s, data type "
-      "%s, dst shape %s memory size %ld",
-      ShapeToString(args.src_shape).c_str(), TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
-      ShapeToString(args.dst_shape).c_str(), total_size);
+Status GetDstDataAfterTransByElement(const TransArgs &args, TransResult &result, const int size,
+                                     const int64_t total_size) {
   std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[total_size], std::default_delete<uint8_t[]>());
   if (dst == nullptr) {
     GELOGE(OUT_OF_MEMORY,
@@ -170,6 +155,46 @@ Status FormatTransferNchwNc1hwc0::TransFormat(const TransArgs &args, TransResult
   return SUCCESS;
 }
 
+Status GetDstDataAfterTrans(const TransArgs &args, TransResult &result, const int size, const int64_t total_size) {
+  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[total_size], std::default_delete<uint8_t[]>());
+  if (dst == nullptr) {
+    GELOGE(OUT_OF_MEMORY,
+           "Failed to trans format from %s to %s, can not alloc the memory for"
+           " dst buf %ld, shape %s",
+           TypeUtils::FormatToSerialString(args.src_format).c_str(),
+           TypeUtils::FormatToSerialString(args.dst_format).c_str(), total_size, ShapeToString(args.dst_shape).c_str());
+    return OUT_OF_MEMORY;
+  }
+
+  auto c = args.src_shape.at(kNchwC);
+  Trans5dParams params;
+  params.n = args.src_shape.at(kNchwN);
+  params.c = c;
+  params.hw = args.src_shape.at(kNchwH) * args.src_shape.at(kNchwW);
+  params.c1 = args.dst_shape.at(kNc1hwc0C1);
+  params.c0 = args.dst_shape.at(kNc1hwc0C0);
+  params.n_stride = c * params.hw;
+  params.c_stride = params.hw;
+  params.hw_stride = 1;
+  params.size = size;
+  auto ret = TransDataTo5d(params, args.data, dst.get());
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  result.data = dst;
+  result.length = static_cast<size_t>(total_size);
+  return SUCCESS;
+}
+}  // namespace
+
+Status FormatTransferNchwNc1hwc0::TransFormat(const TransArgs &args, TransResult &result) {
+  return TransFormatWith(args, result, CheckArgsForNchwToNc1hwc0, GetDstDataAfterTrans);
+}
+
+Status FormatTransferNchwNc1hwc0::TransFormatByElement(const TransArgs &args, TransResult &result) {
+  return TransFormatWith(args, result, CheckArgsForNchwToNc1hwc0, GetDstDataAfterTransByElement);
+}
+
 Status FormatTransferNchwNc1hwc0::TransShape(Format src_format, const std::vector<int64_t> &src_shape,
                                              DataType data_type, Format dst_format, std::vector<int64_t> &dst_shape) {
   if (src_format == FORMAT_NCHW) {
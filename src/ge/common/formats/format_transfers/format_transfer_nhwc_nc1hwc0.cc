@@ -19,6 +19,7 @@
 #include <securec.h>
 #include <memory>
 
+#include "common/formats/utils/formats_5d_trans_utils.h"
 #include "common/formats/utils/formats_definitions.h"
 #include "common/formats/utils/formats_trans_utils.h"
 #include "framework/common/debug/ge_log.h"
@@ -86,7 +87,8 @@ Status CheckArgsForNhwcToNc1hwc0(const TransArgs &args) {
   return SUCCESS;
 }
 
-Status GetDstDataAfterTrans(const TransArgs &args, TransResult &result, const int size, const int64_t total_size) {
+Status GetDstDataAfterTransByElement(const TransArgs &args, TransResult &result, const int size,
+                                     const int64_t total_size) {
   std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[total_size], std::default_delete<uint8_t[]>());
   if (dst == nullptr) {
     GELOGE(OUT_OF_MEMORY, "Failed to trans format from %s to %s, can not alloc the memory for dst buf %ld, shape %s",
@@ -152,30 +154,47 @@ Status GetDstDataAfterTrans(const TransArgs &args, TransResult &result, const in
   result.length = static_cast<size_t>(total_size);
   return SUCCESS;
 }
-}  // namespace
 
-Status FormatTransferNhwcNc1hwc0::TransFormat(const TransArgs &args, TransResult &result) {
-  if (CheckArgsForNhwcToNc1hwc0(args) != SUCCESS) {
-    return PARAM_INVALID;
-  }
-  int size = GetSizeByDataType(args.src_data_type);
-  auto total_size = GetItemNumByShape(args.dst_shape) * size;
-  if (total_size <= 0) {
-    GELOGE(INTERNAL_ERROR, "Get %ld total size from dst shape %s, src shape %s", total_size,
-           ShapeToString(args.dst_shape).c_str(), ShapeToString(args.src_shape).c_str());
-    return PARAM_INVALID;
+Status GetDstDataAfterTrans(const TransArgs &args, TransResult &result, const int size, const int64_t total_size) {
+  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[total_size], std::default_delete<uint8_t[]>());
+  if (dst == nullptr) {
+    GELOGE(OUT_OF_MEMORY, "Failed to trans format from %s to %s, can not alloc the memory for dst buf %ld, shape %s",
+           TypeUtils::FormatToSerialString(args.src_format).c_str(),
+           TypeUtils::FormatToSerialString(args.dst_format).c_str(), total_size, ShapeToString(args.dst_shape).c_str());
+    return OUT_OF_MEMORY;
   }
-  GELOGD("Begin to trans format from NHWC to NC1HWC0, src shape %s, data type %s, dst shape %s, memory size %ld",
-         ShapeToString(args.src_shape).c_str(), TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
-         ShapeToString(args.dst_shape).c_str(), total_size);
-  if (GetDstDataAfterTrans(args, result, size, total_size) != SUCCESS) {
-    GELOGE(INTERNAL_ERROR, "Failed to get data after trans, src shape %s, data type %s, dst shape %s, memory size %ld",
-           ShapeToString(args.src_shape).c_str(), TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
-           ShapeToString(args.dst_shape).c_str(), total_size);
-    return INTERNAL_ERROR;
+
+  auto n = args.src_shape.at(kNhwcN);
+  auto h = args.src_shape.at(kNhwcH);
+  auto w = args.src_shape.at(kNhwcW);
+  auto c = args.src_shape.at(kNhwcC);
+  Trans5dParams params;
+  params.n = n;
+  params.c = c;
+  params.hw = h * w;
+  params.c1 = args.dst_shape.at(kNc1hwc0C1);
+  params.c0 = args.dst_shape.at(kNc1hwc0C0);
+  params.n_stride = params.hw * c;
+  params.c_stride = 1;
+  params.hw_stride = c;
+  params.size = size;
+  auto ret = TransDataTo5d(params, args.data, dst.get());
+  if (ret != SUCCESS) {
+    return ret;
   }
+  result.data = dst;
+  result.length = static_cast<size_t>(total_size);
   return SUCCESS;
 }
+}  // namespace
+
+Status FormatTransferNhwcNc1hwc0::TransFormat(const TransArgs &args, TransResult &result) {
+  return TransFormatWith(args, result, CheckArgsForNhwcToNc1hwc0, GetDstDataAfterTrans);
+}
+
+Status FormatTransferNhwcNc1hwc0::TransFormatByElement(const TransArgs &args, TransResult &result) {
+  return TransFormatWith(args, result, CheckArgsForNhwcToNc1hwc0, GetDstDataAfterTransByElement);
+}
 
 Status FormatTransferNhwcNc1hwc0::TransShape(Format src_format, const std::vector<int64_t> &src_shape,
                                              DataType data_type, Format dst_format, std::vector<int64_t> &dst_shape) {
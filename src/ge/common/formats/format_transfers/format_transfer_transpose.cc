@@ -17,6 +17,7 @@
 #include "common/formats/format_transfers/format_transfer_transpose.h"
 
 #include <securec.h>
+#include <algorithm>
 #include <memory>
 
 #include "common/formats/utils/formats_trans_utils.h"
@@ -131,6 +132,249 @@ std::vector<int64_t> TransShapeByPerm(const std::vector<int64_t> &src_shape, con
   }
   return dst_shape;
 }
+// edge of the square tiles the 2-D transpose kernel recurses down to, in elements
+const int64_t kTransposeTileSize = 32;
+// rows of the 2-D transpose plane handled by one parallel task
+const int64_t kTransposeStripRows = 256;
+
+///
+/// A transpose reduced to its essential axes: size 1 dims are dropped and dims
+/// that stay adjacent and in order are merged. The innermost dst axis is either
+/// the innermost src axis, then whole rows are copied, or another src axis, then
+/// the two innermost axes form a 2-D plane that is transposed tile by tile.
+/// The remaining axes are outer loops. Strides are in elements.
+///
+struct TransposePlan {
+  int64_t elem_size;
+  std::vector<int64_t> outer_dims;
+  std::vector<int64_t> outer_src_strides;
+  std::vector<int64_t> outer_dst_strides;
+  bool row_copy;
+  // plane: extent of the innermost dst axis, 1 for row copies
+  int64_t rows;
+  // plane: extent of the innermost src axis, row copies: row length
+  int64_t cols;
+  int64_t src_row_stride;
+  int64_t dst_col_stride;
+};
+
+void SimplifyTranspose(const std::vector<int64_t> &src_shape, const std::vector<int64_t> &perm_arg,
+                       std::vector<int64_t> &shape, std::vector<int64_t> &perm) {
+  std::vector<int64_t> kept_index(src_shape.size(), -1);
+  std::vector<int64_t> kept_shape;
+  for (size_t i = 0; i < src_shape.size(); ++i) {
+    if (src_shape[i] != 1) {
+      kept_index[i] = static_cast<int64_t>(kept_shape.size());
+      kept_shape.push_back(src_shape[i]);
+    }
+  }
+  std::vector<int64_t> kept_perm;
+  for (auto axis : perm_arg) {
+    if (kept_index[axis] >= 0) {
+      kept_perm.push_back(kept_index[axis]);
+    }
+  }
+  if (kept_perm.empty()) {
+    shape = {1};
+    perm = {0};
+    return;
+  }
+
+  // groups of dst axes that are consecutive in src, in dst order
+  std::vector<int64_t> group_first_axis;
+  std::vector<int64_t> group_dims;
+  for (size_t i = 0; i < kept_perm.size(); ++i) {
+    if (i == 0 || kept_perm[i] != kept_perm[i - 1] + 1) {
+      group_first_axis.push_back(kept_perm[i]);
+      group_dims.push_back(kept_shape[kept_perm[i]]);
+    } else {
+      group_dims.back() *= kept_shape[kept_perm[i]];
+    }
+  }
+  std::vector<size_t> src_order(group_first_axis.size());
+  for (size_t i = 0; i < src_order.size(); ++i) {
+    src_order[i] = i;
+  }
+  std::sort(src_order.begin(), src_order.end(),
+            [&group_first_axis](size_t lhs, size_t rhs) { return group_first_axis[lhs] < group_first_axis[rhs]; });
+  shape.resize(src_order.size());
+  perm.resize(src_order.size());
+  for (size_t i = 0; i < src_order.size(); ++i) {
+    shape[i] = group_dims[src_order[i]];
+    perm[src_order[i]] = static_cast<int64_t>(i);
+  }
+}
+
+TransposePlan MakeTransposePlan(std::vector<int64_t> src_shape, std::vector<int64_t> perm_arg, int64_t data_size) {
+  TransposePlan plan;
+  plan.elem_size = data_size;
+  if (data_size != sizeof(uint8_t) && data_size != sizeof(uint16_t) && data_size != sizeof(uint32_t) &&
+      data_size != sizeof(uint64_t)) {
+    // elements without a typed kernel are moved as an innermost axis of bytes
+    perm_arg.push_back(static_cast<int64_t>(src_shape.size()));
+    src_shape.push_back(data_size);
+    plan.elem_size = 1;
+  }
+  std::vector<int64_t> shape;
+  std::vector<int64_t> perm;
+  SimplifyTranspose(src_shape, perm_arg, shape, perm);
+
+  size_t rank = shape.size();
+  auto src_strides = GenHeads(shape);
+  auto dst_strides = GenHeads(TransShapeByPerm(shape, perm));
+  size_t inner = rank - 1;
+  plan.row_copy = (static_cast<size_t>(perm[inner]) == inner);
+  size_t src_inner_pos = inner;
+  if (plan.row_copy) {
+    plan.rows = 1;
+    plan.src_row_stride = 0;
+    plan.dst_col_stride = 1;
+  } else {
+    src_inner_pos =
+        static_cast<size_t>(std::find(perm.begin(), perm.end(), static_cast<int64_t>(inner)) - perm.begin());
+    plan.rows = shape[perm[inner]];
+    plan.src_row_stride = src_strides[perm[inner]];
+    plan.dst_col_stride = dst_strides[src_inner_pos];
+  }
+  plan.cols = shape[inner];
+  for (size_t i = 0; i < inner; ++i) {
+    if (i != src_inner_pos) {
+      plan.outer_dims.push_back(shape[perm[i]]);
+      plan.outer_src_strides.push_back(src_strides[perm[i]]);
+      plan.outer_dst_strides.push_back(dst_strides[i]);
+    }
+  }
+  return plan;
+}
+
+///
+/// Walks the outer loops of a plan in dst order and tracks the element offsets
+///
+class OuterIndex {
+ public:
+  OuterIndex(const TransposePlan &plan, int64_t linear)
+      : plan_(plan), indexes_(plan.outer_dims.size()), src_offset_(0), dst_offset_(0) {
+    for (auto i = static_cast<int64_t>(indexes_.size()) - 1; i >= 0; --i) {
+      indexes_[i] = linear % plan.outer_dims[i];
+      linear /= plan.outer_dims[i];
+      src_offset_ += indexes_[i] * plan.outer_src_strides[i];
+      dst_offset_ += indexes_[i] * plan.outer_dst_strides[i];
+    }
+  }
+
+  void Next() {
+    for (auto i = static_cast<int64_t>(indexes_.size()) - 1; i >= 0; --i) {
+      src_offset_ += plan_.outer_src_strides[i];
+      dst_offset_ += plan_.outer_dst_strides[i];
+      if (++indexes_[i] < plan_.outer_dims[i]) {
+        return;
+      }
+      src_offset_ -= plan_.outer_src_strides[i] * plan_.outer_dims[i];
+      dst_offset_ -= plan_.outer_dst_strides[i] * plan_.outer_dims[i];
+      indexes_[i] = 0;
+    }
+  }
+
+  int64_t SrcOffset() const { return src_offset_; }
+  int64_t DstOffset() const { return dst_offset_; }
+
+ private:
+  const TransposePlan &plan_;
+  std::vector<int64_t> indexes_;
+  int64_t src_offset_;
+  int64_t dst_offset_;
+};
+
+///
+/// dst[row + col * dst_col_stride] = src[row * src_row_stride + col], halving
+/// the longer side until the block fits a tile so both sides stay in cache
+///
+template <typename T>
+void TransposePlane(const T *src, T *dst, int64_t rows, int64_t cols, int64_t src_row_stride,
+                    int64_t dst_col_stride) {
+  if (rows <= kTransposeTileSize && cols <= kTransposeTileSize) {
+    for (int64_t col = 0; col < cols; ++col) {
+      T *dst_col = dst + col * dst_col_stride;
+      const T *src_col = src + col;
+      for (int64_t row = 0; row < rows; ++row) {
+        dst_col[row] = src_col[row * src_row_stride];
+      }
+    }
+    return;
+  }
+  if (rows >= cols) {
+    int64_t half = rows / 2;
+    TransposePlane(src, dst, half, cols, src_row_stride, dst_col_stride);
+    TransposePlane(src + half * src_row_stride, dst + half, rows - half, cols, src_row_stride, dst_col_stride);
+  } else {
+    int64_t half = cols / 2;
+    TransposePlane(src, dst, rows, half, src_row_stride, dst_col_stride);
+    TransposePlane(src + half, dst + half * dst_col_stride, rows, cols - half, src_row_stride, dst_col_stride);
+  }
+}
+
+template <typename T>
+Status TransposePlaneTasks(const TransposePlan &plan, const uint8_t *src, uint8_t *dst, int64_t begin, int64_t end) {
+  int64_t strips = Ceil(plan.rows, kTransposeStripRows);
+  auto src_data = reinterpret_cast<const T *>(src);
+  auto dst_data = reinterpret_cast<T *>(dst);
+  OuterIndex outer(plan, begin / strips);
+  for (int64_t task = begin; task < end; ++task) {
+    int64_t strip = task % strips;
+    if (task != begin && strip == 0) {
+      outer.Next();
+    }
+    int64_t row = strip * kTransposeStripRows;
+    TransposePlane(src_data + outer.SrcOffset() + row * plan.src_row_stride, dst_data + outer.DstOffset() + row,
+                   std::min(kTransposeStripRows, plan.rows - row), plan.cols, plan.src_row_stride,
+                   plan.dst_col_stride);
+  }
+  return SUCCESS;
+}
+
+Status CopyRowTasks(const TransposePlan &plan, const uint8_t *src, uint8_t *dst, int64_t dst_size, int64_t begin,
+                    int64_t end) {
+  int64_t row_size = plan.cols * plan.elem_size;
+  OuterIndex outer(plan, begin);
+  for (int64_t task = begin; task < end; ++task, outer.Next()) {
+    int64_t dst_offset = outer.DstOffset() * plan.elem_size;
+    int64_t src_offset = outer.SrcOffset() * plan.elem_size;
+    for (int64_t copied = 0; copied < row_size;) {
+      auto copy_size = std::min(row_size - copied, static_cast<int64_t>(SECUREC_MEM_MAX_LEN));
+      auto ret = memcpy_s(dst + dst_offset + copied, static_cast<size_t>(dst_size - dst_offset - copied),
+                          src + src_offset + copied, static_cast<size_t>(copy_size));
+      if (ret != EOK) {
+        GELOGE(INTERNAL_ERROR, "Failed to transpose, failed to write to dst offset %ld, size %ld",
+               dst_offset + copied, copy_size);
+        return INTERNAL_ERROR;
+      }
+      copied += copy_size;
+    }
+  }
+  return SUCCESS;
+}
+
+Status TransposeByPlan(const TransposePlan &plan, const uint8_t *src, uint8_t *dst, int64_t dst_size) {
+  int64_t outer_num = GetItemNumByShape(plan.outer_dims);
+  if (plan.row_copy) {
+    return ParallelFor(outer_num, dst_size, [&](int64_t begin, int64_t end) {
+      return CopyRowTasks(plan, src, dst, dst_size, begin, end);
+    });
+  }
+  int64_t task_num = outer_num * Ceil(plan.rows, kTransposeStripRows);
+  return ParallelFor(task_num, dst_size, [&](int64_t begin, int64_t end) {
+    switch (plan.elem_size) {
+      case sizeof(uint8_t):
+        return TransposePlaneTasks<uint8_t>(plan, src, dst, begin, end);
+      case sizeof(uint16_t):
+        return TransposePlaneTasks<uint16_t>(plan, src, dst, begin, end);
+      case sizeof(uint32_t):
+        return TransposePlaneTasks<uint32_t>(plan, src, dst, begin, end);
+      default:
+        return TransposePlaneTasks<uint64_t>(plan, src, dst, begin, end);
+    }
+  });
+}
 }  // namespace
 
 Status Transpose(const uint8_t *src, const std::vector<int64_t> &src_shape, DataType src_data_type,
@@ -139,6 +383,37 @@ Status Transpose(const uint8_t *src, const std::vector<int64_t> &src_shape, Data
     return PARAM_INVALID;
   }
 
+  auto dst_shape = TransShapeByPerm(src_shape, perm_arg);
+  int64_t data_size = GetSizeByDataType(src_data_type);
+  int64_t dst_size = data_size * GetItemNumByShape(dst_shape);
+  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[dst_size], std::default_delete<uint8_t[]>());
+  if (dst == nullptr) {
+    GELOGE(OUT_OF_MEMORY, "Failed to transpose, failed to alloc the memory for dst buf %ld", dst_size);
+    return OUT_OF_MEMORY;
+  }
+
+  GELOGD("Begin to transpose, src shape %s, perm arg %s, dst shape %s, data type %s", JoinToString(src_shape).c_str(),
+         JoinToString(perm_arg).c_str(), JoinToString(dst_shape).c_str(),
+         TypeUtils::DataTypeToSerialString(src_data_type).c_str());
+
+  auto ret = TransposeByPlan(MakeTransposePlan(src_shape, perm_arg, data_size), src, dst.get(), dst_size);
+  if (ret != SUCCESS) {
+    GELOGE(INTERNAL_ERROR, "Failed to transpose, src shape %s, perm arg %s, dst shape %s",
+           ShapeToString(src_shape).c_str(), ShapeToString(perm_arg).c_str(), ShapeToString(dst_shape).c_str());
+    return ret;
+  }
+
+  result.data = dst;
+  result.length = static_cast<size_t>(dst_size);
+  return SUCCESS;
+}
+
+Status TransposeByElement(const uint8_t *src, const std::vector<int64_t> &src_shape, DataType src_data_type,
+                          const std::vector<int64_t> &perm_arg, TransResult &result) {
+  if (!IsTransposeArgValid(src, src_shape, src_data_type, perm_arg)) {
+    return PARAM_INVALID;
+  }
+
   auto dst_shape = TransShapeByPerm(src_shape, perm_arg);
   auto src_origin_ordered_heads = GenHeads(src_shape);
   auto src_heads = TransShapeByPerm(src_origin_ordered_heads, perm_arg);
@@ -27,6 +27,10 @@ namespace formats {
 Status Transpose(const uint8_t *src, const std::vector<int64_t> &src_shape, DataType src_data_type,
                  const std::vector<int64_t> &perm_arg, TransResult &result);
 
+// Element-by-element reference of Transpose, kept to verify the tiled implementation
+Status TransposeByElement(const uint8_t *src, const std::vector<int64_t> &src_shape, DataType src_data_type,
+                          const std::vector<int64_t> &perm_arg, TransResult &result);
+
 Status TransposeWithShapeCheck(const uint8_t *src, const std::vector<int64_t> &src_shape,
                                const std::vector<int64_t> &dst_shape, DataType src_data_type,
                                const std::vector<int64_t> &perm_arg, TransResult &result);
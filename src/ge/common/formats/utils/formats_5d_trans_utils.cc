@@ -0,0 +1,184 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/formats/utils/formats_5d_trans_utils.h"
+
+#include <securec.h>
+#include <algorithm>
+
+#include "common/formats/utils/formats_trans_utils.h"
+#include "framework/common/debug/ge_log.h"
+
+namespace ge {
+namespace formats {
+namespace {
+struct BlockInfo {
+  // element offset of the (n, c1) block in the 5D tensor
+  int64_t offset_5d;
+  // element offset of the first channel of the block in the 4D tensor
+  int64_t offset_4d;
+  // channels of the block that exist in the 4D tensor
+  int64_t valid_c;
+};
+
+BlockInfo GetBlockInfo(const Trans5dParams &params, int64_t block_idx) {
+  int64_t n_idx = block_idx / params.c1;
+  int64_t c1_idx = block_idx % params.c1;
+  BlockInfo info;
+  info.offset_5d = block_idx * params.hw * params.c0;
+  info.offset_4d = n_idx * params.n_stride + c1_idx * params.c0 * params.c_stride;
+  info.valid_c = std::min(params.c0, params.c - c1_idx * params.c0);
+  return info;
+}
+
+template <typename T>
+void GatherBlock(const Trans5dParams &params, const BlockInfo &info, const uint8_t *src, uint8_t *dst) {
+  auto src_data = reinterpret_cast<const T *>(src) + info.offset_4d;
+  auto dst_data = reinterpret_cast<T *>(dst) + info.offset_5d;
+  for (int64_t hw_idx = 0; hw_idx < params.hw; ++hw_idx) {
+    const T *src_item = src_data + hw_idx * params.hw_stride;
+    T *dst_item = dst_data + hw_idx * params.c0;
+    for (int64_t c0_idx = 0; c0_idx < info.valid_c; ++c0_idx) {
+      dst_item[c0_idx] = src_item[c0_idx * params.c_stride];
+    }
+    for (int64_t c0_idx = info.valid_c; c0_idx < params.c0; ++c0_idx) {
+      dst_item[c0_idx] = 0;
+    }
+  }
+}
+
+template <typename T>
+void ScatterBlock(const Trans5dParams &params, const BlockInfo &info, const uint8_t *src, uint8_t *dst) {
+  auto src_data = reinterpret_cast<const T *>(src) + info.offset_5d;
+  auto dst_data = reinterpret_cast<T *>(dst) + info.offset_4d;
+  for (int64_t c0_idx = 0; c0_idx < info.valid_c; ++c0_idx) {
+    const T *src_item = src_data + c0_idx;
+    T *dst_item = dst_data + c0_idx * params.c_stride;
+    for (int64_t hw_idx = 0; hw_idx < params.hw; ++hw_idx) {
+      dst_item[hw_idx * params.hw_stride] = src_item[hw_idx * params.c0];
+    }
+  }
+}
+
+Status CopyElementsByByte(const Trans5dParams &params, const BlockInfo &info, const uint8_t *src, uint8_t *dst,
+                          bool to_5d) {
+  auto pad_size = static_cast<size_t>((params.c0 - info.valid_c) * params.size);
+  for (int64_t hw_idx = 0; hw_idx < params.hw; ++hw_idx) {
+    if (to_5d && pad_size > 0) {
+      auto pad_offset = (info.offset_5d + hw_idx * params.c0 + info.valid_c) * params.size;
+      auto ret = memset_s(dst + pad_offset, pad_size, 0, pad_size);
+      if (ret != EOK) {
+        GELOGE(INTERNAL_ERROR, "Failed to set padding to 0 at 5D offset %ld, err-code %d", pad_offset, ret);
+        return INTERNAL_ERROR;
+      }
+    }
+    for (int64_t c0_idx = 0; c0_idx < info.valid_c; ++c0_idx) {
+      int64_t idx_5d = info.offset_5d + hw_idx * params.c0 + c0_idx;
+      int64_t idx_4d = info.offset_4d + hw_idx * params.hw_stride + c0_idx * params.c_stride;
+      auto dst_item = dst + (to_5d ? idx_5d : idx_4d) * params.size;
+      auto src_item = src + (to_5d ? idx_4d : idx_5d) * params.size;
+      auto ret = memcpy_s(dst_item, static_cast<size_t>(params.size), src_item, static_cast<size_t>(params.size));
+      if (ret != EOK) {
+        GELOGE(INTERNAL_ERROR, "Failed to copy element, 5D index %ld, 4D index %ld, err-code %d", idx_5d, idx_4d, ret);
+        return INTERNAL_ERROR;
+      }
+    }
+  }
+  return SUCCESS;
+}
+
+Status CopyStridedBlock(const Trans5dParams &params, const BlockInfo &info, const uint8_t *src, uint8_t *dst,
+                        bool to_5d) {
+  switch (params.size) {
+    case sizeof(uint8_t):
+      to_5d ? GatherBlock<uint8_t>(params, info, src, dst) : ScatterBlock<uint8_t>(params, info, src, dst);
+      return SUCCESS;
+    case sizeof(uint16_t):
+      to_5d ? GatherBlock<uint16_t>(params, info, src, dst) : ScatterBlock<uint16_t>(params, info, src, dst);
+      return SUCCESS;
+    case sizeof(uint32_t):
+      to_5d ? GatherBlock<uint32_t>(params, info, src, dst) : ScatterBlock<uint32_t>(params, info, src, dst);
+      return SUCCESS;
+    case sizeof(uint64_t):
+      to_5d ? GatherBlock<uint64_t>(params, info, src, dst) : ScatterBlock<uint64_t>(params, info, src, dst);
+      return SUCCESS;
+    default:
+      return CopyElementsByByte(params, info, src, dst, to_5d);
+  }
+}
+
+Status CopyChannelRuns(const Trans5dParams &params, const BlockInfo &info, const uint8_t *src, uint8_t *dst,
+                       bool to_5d) {
+  auto run_size = static_cast<size_t>(info.valid_c * params.size);
+  auto pad_size = static_cast<size_t>((params.c0 - info.valid_c) * params.size);
+  for (int64_t hw_idx = 0; hw_idx < params.hw; ++hw_idx) {
+    auto ptr_5d = (info.offset_5d + hw_idx * params.c0) * params.size;
+    auto ptr_4d = (info.offset_4d + hw_idx * params.hw_stride) * params.size;
+    auto ret = to_5d ? memcpy_s(dst + ptr_5d, run_size, src + ptr_4d, run_size)
+                     : memcpy_s(dst + ptr_4d, run_size, src + ptr_5d, run_size);
+    if (ret != EOK) {
+      GELOGE(INTERNAL_ERROR, "Failed to copy channel run at hw %ld, 5D offset %ld, 4D offset %ld, err-code %d", hw_idx,
+             ptr_5d, ptr_4d, ret);
+      return INTERNAL_ERROR;
+    }
+    if (to_5d && pad_size > 0) {
+      ret = memset_s(dst + ptr_5d + run_size, pad_size, 0, pad_size);
+      if (ret != EOK) {
+        GELOGE(INTERNAL_ERROR, "Failed to set padding to 0 at 5D offset %zu, err-code %d", ptr_5d + run_size, ret);
+        return INTERNAL_ERROR;
+      }
+    }
+  }
+  return SUCCESS;
+}
+
+Status TransBlocks(const Trans5dParams &params, const uint8_t *src, uint8_t *dst, bool to_5d) {
+  if (params.c1 <= 0 || params.c0 <= 0 || params.size <= 0) {
+    GELOGE(PARAM_INVALID, "Invalid 5D trans params, c1 %ld, c0 %ld, size %ld", params.c1, params.c0, params.size);
+    return PARAM_INVALID;
+  }
+  int64_t block_num = params.n * params.c1;
+  int64_t total_bytes = block_num * params.hw * params.c0 * params.size;
+  return ParallelFor(block_num, total_bytes, [&params, src, dst, to_5d](int64_t begin, int64_t end) -> Status {
+    for (int64_t block_idx = begin; block_idx < end; ++block_idx) {
+      auto info = GetBlockInfo(params, block_idx);
+      if (params.c_stride == 1) {
+        // Channels are contiguous in the 4D tensor (NHWC), move a whole run per H*W position
+        auto ret = CopyChannelRuns(params, info, src, dst, to_5d);
+        if (ret != SUCCESS) {
+          return ret;
+        }
+        continue;
+      }
+      auto ret = CopyStridedBlock(params, info, src, dst, to_5d);
+      if (ret != SUCCESS) {
+        return ret;
+      }
+    }
+    return SUCCESS;
+  });
+}
+}  // namespace
+
+Status TransDataTo5d(const Trans5dParams &params, const uint8_t *src, uint8_t *dst) {
+  return TransBlocks(params, src, dst, true);
+}
+
+Status TransDataFrom5d(const Trans5dParams &params, const uint8_t *src, uint8_t *dst) {
+  return TransBlocks(params, src, dst, false);
+}
+}  // namespace formats
+}  // namespace ge
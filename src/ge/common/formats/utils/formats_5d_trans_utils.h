@@ -0,0 +1,57 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_FORMATS_UTILS_FORMATS_5D_TRANS_UTILS_H_
+#define GE_COMMON_FORMATS_UTILS_FORMATS_5D_TRANS_UTILS_H_
+
+#include <cstdint>
+
+#include "framework/common/ge_inner_error_codes.h"
+
+namespace ge {
+namespace formats {
+/**
+ * Describes a transfer between a 4D tensor (NCHW or NHWC) and NC1HWC0. The 4D
+ * tensor is seen as [N, C, H*W] with the element strides below, so both 4D
+ * layouts share one kernel.
+ */
+struct Trans5dParams {
+  int64_t n;
+  int64_t c;
+  int64_t hw;
+  int64_t c1;
+  int64_t c0;
+  // element strides of the 4D tensor
+  int64_t n_stride;
+  int64_t c_stride;
+  int64_t hw_stride;
+  // bytes of one element
+  int64_t size;
+};
+
+/**
+ * Copy a 4D tensor to NC1HWC0, channel runs at a time, and zero the padded
+ * channels of the last C1 block. dst must hold n * c1 * hw * c0 elements.
+ */
+Status TransDataTo5d(const Trans5dParams &params, const uint8_t *src, uint8_t *dst);
+
+/**
+ * Copy a NC1HWC0 tensor back to a 4D tensor, dropping the padded channels
+ */
+Status TransDataFrom5d(const Trans5dParams &params, const uint8_t *src, uint8_t *dst);
+}  // namespace formats
+}  // namespace ge
+#endif  // GE_COMMON_FORMATS_UTILS_FORMATS_5D_TRANS_UTILS_H_
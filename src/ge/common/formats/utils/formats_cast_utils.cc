@@ -0,0 +1,392 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/formats/utils/formats_cast_utils.h"
+
+#include <climits>
+#include <map>
+#include <utility>
+
+#include "common/fp16_t.h"
+#include "framework/common/debug/ge_log.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define GE_CAST_USE_AVX2
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define GE_CAST_USE_NEON
+#endif
+
+namespace ge {
+namespace formats {
+namespace {
+using CastFuncMap = std::map<std::pair<DataType, DataType>, VectorCastFunc>;
+
+// fp16_t differs from IEEE conversions in a few corner cases, the vector code
+// converts with the hardware and then patches these lanes:
+// fp32 -> fp16 overflow and NaN saturate to +-kFp16Max instead of inf/NaN,
+// fp16 inf/NaN -> fp32 keep their mantissa under the exponent kFp16InvalidFp32Exp,
+// fp16 inf/NaN -> int32 give INT32_MAX + sign.
+const uint32_t kFp16ExpMask = 0x7C00;
+const uint32_t kFp16SignMask = 0x8000;
+const uint32_t kFp16ManMask = 0x03FF;
+const uint32_t kFp16Max = 0x7BFF;
+const uint32_t kFp16InvalidFp32Exp = 0x47800000;  // (31 - 15 + 127) << 23
+const uint32_t kFp16ToFp32SignShift = 16;
+const uint32_t kFp16ToFp32ManShift = 13;
+const uint32_t kFp16SignIndex = 15;
+
+uint16_t Int32MinToFp16() {
+  // fp16_t does not special case INT32_MIN, keep whatever it gives
+  static const uint16_t value = []() {
+    fp16_t fp16;
+    fp16 = static_cast<int32_t>(INT_MIN);
+    return fp16.val;
+  }();
+  return value;
+}
+
+#ifdef GE_CAST_USE_AVX2
+#define GE_CAST_AVX2_TARGET __attribute__((target("avx2,f16c")))
+const size_t kAvx2Lanes = 8;
+
+bool IsAvx2F16cSupported() {
+  unsigned int eax = 0;
+  unsigned int ebx = 0;
+  unsigned int ecx = 0;
+  unsigned int edx = 0;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0 || (ecx & bit_F16C) == 0) {
+    return false;
+  }
+  // checks the os saves the ymm registers as well
+  return __builtin_cpu_supports("avx2") != 0;
+}
+
+GE_CAST_AVX2_TARGET inline __m128i SaturateFp16(__m128i fp16) {
+  const __m128i exp_mask = _mm_set1_epi16(static_cast<int16_t>(kFp16ExpMask));
+  __m128i invalid = _mm_cmpeq_epi16(_mm_and_si128(fp16, exp_mask), exp_mask);
+  __m128i saturated = _mm_or_si128(_mm_and_si128(fp16, _mm_set1_epi16(static_cast<int16_t>(kFp16SignMask))),
+                                   _mm_set1_epi16(static_cast<int16_t>(kFp16Max)));
+  return _mm_blendv_epi8(fp16, saturated, invalid);
+}
+
+GE_CAST_AVX2_TARGET inline __m128i FloatToFp16(__m256 value) {
+  return SaturateFp16(_mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT));
+}
+
+GE_CAST_AVX2_TARGET inline __m256i InvalidFp16Mask(__m256i fp16_bits) {
+  const __m256i exp_mask = _mm256_set1_epi32(kFp16ExpMask);
+  return _mm256_cmpeq_epi32(_mm256_and_si256(fp16_bits, exp_mask), exp_mask);
+}
+
+// fp16_bits holds the fp16 values zero extended to 32 bits
+GE_CAST_AVX2_TARGET inline __m256 Fp16ToFloat(__m128i fp16, __m256i fp16_bits) {
+  __m256i invalid_value = _mm256_or_si256(
+      _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(fp16_bits, _mm256_set1_epi32(kFp16SignMask)),
+                                        kFp16ToFp32SignShift),
+                      _mm256_set1_epi32(kFp16InvalidFp32Exp)),
+      _mm256_slli_epi32(_mm256_and_si256(fp16_bits, _mm256_set1_epi32(kFp16ManMask)), kFp16ToFp32ManShift));
+  return _mm256_blendv_ps(_mm256_cvtph_ps(fp16), _mm256_castsi256_ps(invalid_value),
+                          _mm256_castsi256_ps(InvalidFp16Mask(fp16_bits)));
+}
+
+GE_CAST_AVX2_TARGET size_t Avx2FloatToFp16(const uint8_t *src, uint8_t *dst, size_t num) {
+  const float *src_data = reinterpret_cast<const float *>(src);
+  size_t idx = 0;
+  for (; idx + kAvx2Lanes <= num; idx += kAvx2Lanes) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst) + idx / kAvx2Lanes,
+                     FloatToFp16(_mm256_loadu_ps(src_data + idx)));
+  }
+  return idx;
+}
+
+GE_CAST_AVX2_TARGET size_t Avx2FloatToInt32(const uint8_t *src, uint8_t *dst, size_t num) {
+  const float *src_data = reinterpret_cast<const float *>(src);
+  size_t idx = 0;
+  for (; idx + kAvx2Lanes <= num; idx += kAvx2Lanes) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst) + idx / kAvx2Lanes,
+                        _mm256_cvttps_epi32(_mm256_loadu_ps(src_data + idx)));
+  }
+  return idx;
+}
+
+GE_CAST_AVX2_TARGET size_t Avx2Fp16ToFloat(const uint8_t *src, uint8_t *dst, size_t num) {
+  float *dst_data = reinterpret_cast<float *>(dst);
+  size_t idx = 0;
+  for (; idx + kAvx2Lanes <= num; idx += kAvx2Lanes) {
+    __m128i fp16 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src) + idx / kAvx2Lanes);
+    _mm256_storeu_ps(dst_data + idx, Fp16ToFloat(fp16, _mm256_cvtepu16_epi32(fp16)));
+  }
+  return idx;
+}
+
+GE_CAST_AVX2_TARGET size_t Avx2Fp16ToInt32(const uint8_t *src, uint8_t *dst, size_t num) {
+  size_t idx = 0;
+  for (; idx + kAvx2Lanes <= num; idx += kAvx2Lanes) {
+    __m128i fp16 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src) + idx / kAvx2Lanes);
+    __m256i fp16_bits = _mm256_cvtepu16_epi32(fp16);
+    // fp16_t rounds half to even whatever the mxcsr rounding mode is
+    __m256 rounded =
+        _mm256_round_ps(Fp16ToFloat(fp16, fp16_bits), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256i invalid_value =
+        _mm256_add_epi32(_mm256_set1_epi32(INT_MAX), _mm256_srli_epi32(fp16_bits, kFp16SignIndex));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst) + idx / kAvx2Lanes,
+                        _mm256_blendv_epi8(_mm256_cvttps_epi32(rounded), invalid_value, InvalidFp16Mask(fp16_bits)));
+  }
+  return idx;
+}
+
+GE_CAST_AVX2_TARGET size_t Avx2Int32ToFloat(const uint8_t *src, uint8_t *dst, size_t num) {
+  float *dst_data = reinterpret_cast<float *>(dst);
+  size_t idx = 0;
+  for (; idx + kAvx2Lanes <= num; idx += kAvx2Lanes) {
+    _mm256_storeu_ps(dst_data + idx,
+                     _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(src) + idx / kAvx2Lanes)));
+  }
+  return idx;
+}
+
+GE_CAST_AVX2_TARGET size_t Avx2Int32ToFp16(const uint8_t *src, uint8_t *dst, size_t num) {
+  // int32 values that are not exact in fp32 saturate in fp16 anyway, so going through fp32 does not double round
+  const __m128i int_min_fp16 = _mm_set1_epi16(static_cast<int16_t>(Int32MinToFp16()));
+  const __m256i int_min = _mm256_set1_epi32(INT_MIN);
+  size_t idx = 0;
+  for (; idx + kAvx2Lanes <= num; idx += kAvx2Lanes) {
+    __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src) + idx / kAvx2Lanes);
+    __m256i is_min = _mm256_cmpeq_epi32(value, int_min);
+    __m128i is_min16 = _mm_packs_epi32(_mm256_castsi256_si128(is_min), _mm256_extracti128_si256(is_min, 1));
+    __m128i fp16 = FloatToFp16(_mm256_cvtepi32_ps(value));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst) + idx / kAvx2Lanes,
+                     _mm_blendv_epi8(fp16, int_min_fp16, is_min16));
+  }
+  return idx;
+}
+
+// keeps the low byte of each int32, the same truncation as static_cast
+GE_CAST_AVX2_TARGET size_t Avx2Int32ToInt8(const uint8_t *src, uint8_t *dst, size_t num) {
+  const __m256i low_bytes = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 4, 8, 12,
+                                             -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m256i gather = _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0);
+  size_t idx = 0;
+  for (; idx + kAvx2Lanes <= num; idx += kAvx2Lanes) {
+    __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src) + idx / kAvx2Lanes);
+    __m256i bytes = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(value, low_bytes), gather);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + idx), _mm256_castsi256_si128(bytes));
+  }
+  return idx;
+}
+
+GE_CAST_AVX2_TARGET inline __m256i LoadUint8AsInt32(const uint8_t *src) {
+  return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src)));
+}
+
+GE_CAST_AVX2_TARGET inline __m256i LoadInt8AsInt32(const uint8_t *src) {
+  return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src)));
+}
+
+GE_CAST_AVX2_TARGET size_t Avx2Uint8ToFloat(const uint8_t *src, uint8_t *dst, size_t num) {
+  float *dst_data = reinterpret_cast<float *>(dst);
+  size_t idx = 0;
+  for (; idx + kAvx2Lanes <= num; idx += kAvx2Lanes) {
+    _mm256_storeu_ps(dst_data + idx, _mm256_cvtepi32_ps(LoadUint8AsInt32(src + idx)));
+  }
+  return idx;
+}
+
+GE_CAST_AVX2_TARGET size_t Avx2Uint8ToInt32(const uint8_t *src, uint8_t *dst, size_t num) {
+  size_t idx = 0;
+  for (; idx + kAvx2Lanes <= num; idx += kAvx2Lanes) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst) + idx / kAvx2Lanes, LoadUint8AsInt32(src + idx));
+  }
+  return idx;
+}
+
+GE_CAST_AVX2_TARGET size_t Avx2Int8ToFloat(const uint8_t *src, uint8_t *dst, size_t num) {
+  float *dst_data = reinterpret_cast<float *>(dst);
+  size_t idx = 0;
+  for (; idx + kAvx2Lanes <= num; idx += kAvx2Lanes) {
+    _mm256_storeu_ps(dst_data + idx, _mm256_cvtepi32_ps(LoadInt8AsInt32(src + idx)));
+  }
+  return idx;
+}
+
+GE_CAST_AVX2_TARGET size_t Avx2Int8ToInt32(const uint8_t *src, uint8_t *dst, size_t num) {
+  size_t idx = 0;
+  for (; idx + kAvx2Lanes <= num; idx += kAvx2Lanes) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst) + idx / kAvx2Lanes, LoadInt8AsInt32(src + idx));
+  }
+  return idx;
+}
+
+// keeps the low half of each int64, the same truncation as static_cast
+GE_CAST_AVX2_TARGET size_t Avx2Int64ToInt32(const uint8_t *src, uint8_t *dst, size_t num) {
+  const __m256i low_halves = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+  const __m256i *src_data = reinterpret_cast<const __m256i *>(src);
+  __m128i *dst_data = reinterpret_cast<__m128i *>(dst);
+  size_t idx = 0;
+  for (; idx + kAvx2Lanes <= num; idx += kAvx2Lanes) {
+    size_t block = idx / kAvx2Lanes;
+    __m256i low = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(src_data + block * 2), low_halves);
+    __m256i high = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(src_data + block * 2 + 1), low_halves);
+    _mm_storeu_si128(dst_data + block * 2, _mm256_castsi256_si128(low));
+    _mm_storeu_si128(dst_data + block * 2 + 1, _mm256_castsi256_si128(high));
+  }
+  return idx;
+}
+
+void AddPlatformCastFuncs(CastFuncMap &funcs) {
+  if (!IsAvx2F16cSupported()) {
+    GELOGI("The cpu does not support avx2 and f16c, data type casts run in scalar.");
+    return;
+  }
+  funcs[std::make_pair(DT_FLOAT, DT_FLOAT16)] = Avx2FloatToFp16;
+  funcs[std::make_pair(DT_FLOAT, DT_INT32)] = Avx2FloatToInt32;
+  funcs[std::make_pair(DT_FLOAT16, DT_FLOAT)] = Avx2Fp16ToFloat;
+  funcs[std::make_pair(DT_FLOAT16, DT_INT32)] = Avx2Fp16ToInt32;
+  funcs[std::make_pair(DT_INT32, DT_FLOAT)] = Avx2Int32ToFloat;
+  funcs[std::make_pair(DT_INT32, DT_FLOAT16)] = Avx2Int32ToFp16;
+  funcs[std::make_pair(DT_INT32, DT_UINT8)] = Avx2Int32ToInt8;
+  funcs[std::make_pair(DT_INT32, DT_INT8)] = Avx2Int32ToInt8;
+  funcs[std::make_pair(DT_UINT8, DT_FLOAT)] = Avx2Uint8ToFloat;
+  funcs[std::make_pair(DT_UINT8, DT_INT32)] = Avx2Uint8ToInt32;
+  funcs[std::make_pair(DT_INT8, DT_FLOAT)] = Avx2Int8ToFloat;
+  funcs[std::make_pair(DT_INT8, DT_INT32)] = Avx2Int8ToInt32;
+  funcs[std::make_pair(DT_INT64, DT_INT32)] = Avx2Int64ToInt32;
+}
+#elif defined(GE_CAST_USE_NEON)
+const size_t kNeonLanes = 4;
+
+inline uint16x4_t FloatToFp16(float32x4_t value) {
+  uint16x4_t fp16 = vreinterpret_u16_f16(vcvt_f16_f32(value));
+  const uint16x4_t exp_mask = vdup_n_u16(kFp16ExpMask);
+  uint16x4_t invalid = vceq_u16(vand_u16(fp16, exp_mask), exp_mask);
+  uint16x4_t saturated = vorr_u16(vand_u16(fp16, vdup_n_u16(kFp16SignMask)), vdup_n_u16(kFp16Max));
+  return vbsl_u16(invalid, saturated, fp16);
+}
+
+inline uint32x4_t InvalidFp16Mask(uint32x4_t fp16) {
+  const uint32x4_t exp_mask = vdupq_n_u32(kFp16ExpMask);
+  return vceqq_u32(vandq_u32(fp16, exp_mask), exp_mask);
+}
+
+inline float32x4_t Fp16ToFloat(uint16x4_t fp16) {
+  uint32x4_t value = vreinterpretq_u32_f32(vcvt_f32_f16(vreinterpret_f16_u16(fp16)));
+  uint32x4_t fp16_bits = vmovl_u16(fp16);
+  uint32x4_t invalid_value =
+      vorrq_u32(vorrq_u32(vshlq_n_u32(vandq_u32(fp16_bits, vdupq_n_u32(kFp16SignMask)), kFp16ToFp32SignShift),
+                          vdupq_n_u32(kFp16InvalidFp32Exp)),
+                vshlq_n_u32(vandq_u32(fp16_bits, vdupq_n_u32(kFp16ManMask)), kFp16ToFp32ManShift));
+  return vreinterpretq_f32_u32(vbslq_u32(InvalidFp16Mask(fp16_bits), invalid_value, value));
+}
+
+size_t NeonFloatToFp16(const uint8_t *src, uint8_t *dst, size_t num) {
+  const float *src_data = reinterpret_cast<const float *>(src);
+  uint16_t *dst_data = reinterpret_cast<uint16_t *>(dst);
+  size_t idx = 0;
+  for (; idx + kNeonLanes <= num; idx += kNeonLanes) {
+    vst1_u16(dst_data + idx, FloatToFp16(vld1q_f32(src_data + idx)));
+  }
+  return idx;
+}
+
+size_t NeonFloatToInt32(const uint8_t *src, uint8_t *dst, size_t num) {
+  const float *src_data = reinterpret_cast<const float *>(src);
+  int32_t *dst_data = reinterpret_cast<int32_t *>(dst);
+  size_t idx = 0;
+  for (; idx + kNeonLanes <= num; idx += kNeonLanes) {
+    vst1q_s32(dst_data + idx, vcvtq_s32_f32(vld1q_f32(src_data + idx)));
+  }
+  return idx;
+}
+
+size_t NeonFp16ToFloat(const uint8_t *src, uint8_t *dst, size_t num) {
+  const uint16_t *src_data = reinterpret_cast<const uint16_t *>(src);
+  float *dst_data = reinterpret_cast<float *>(dst);
+  size_t idx = 0;
+  for (; idx + kNeonLanes <= num; idx += kNeonLanes) {
+    vst1q_f32(dst_data + idx, Fp16ToFloat(vld1_u16(src_data + idx)));
+  }
+  return idx;
+}
+
+size_t NeonFp16ToInt32(const uint8_t *src, uint8_t *dst, size_t num) {
+  const uint16_t *src_data = reinterpret_cast<const uint16_t *>(src);
+  int32_t *dst_data = reinterpret_cast<int32_t *>(dst);
+  size_t idx = 0;
+  for (; idx + kNeonLanes <= num; idx += kNeonLanes) {
+    uint16x4_t fp16 = vld1_u16(src_data + idx);
+    uint32x4_t fp16_bits = vmovl_u16(fp16);
+    // fp16_t rounds half to even
+    uint32x4_t value = vreinterpretq_u32_s32(vcvtnq_s32_f32(Fp16ToFloat(fp16)));
+    uint32x4_t invalid_value = vaddq_u32(vdupq_n_u32(INT_MAX), vshrq_n_u32(fp16_bits, kFp16SignIndex));
+    vst1q_s32(dst_data + idx, vreinterpretq_s32_u32(vbslq_u32(InvalidFp16Mask(fp16_bits), invalid_value, value)));
+  }
+  return idx;
+}
+
+size_t NeonInt32ToFloat(const uint8_t *src, uint8_t *dst, size_t num) {
+  const int32_t *src_data = reinterpret_cast<const int32_t *>(src);
+  float *dst_data = reinterpret_cast<float *>(dst);
+  size_t idx = 0;
+  for (; idx + kNeonLanes <= num; idx += kNeonLanes) {
+    vst1q_f32(dst_data + idx, vcvtq_f32_s32(vld1q_s32(src_data + idx)));
+  }
+  return idx;
+}
+
+size_t NeonInt32ToFp16(const uint8_t *src, uint8_t *dst, size_t num) {
+  // int32 values that are not exact in fp32 saturate in fp16 anyway, so going through fp32 does not double round
+  const int32_t *src_data = reinterpret_cast<const int32_t *>(src);
+  uint16_t *dst_data = reinterpret_cast<uint16_t *>(dst);
+  const uint16x4_t int_min_fp16 = vdup_n_u16(Int32MinToFp16());
+  size_t idx = 0;
+  for (; idx + kNeonLanes <= num; idx += kNeonLanes) {
+    int32x4_t value = vld1q_s32(src_data + idx);
+    uint16x4_t is_min = vmovn_u32(vceqq_s32(value, vdupq_n_s32(INT_MIN)));
+    vst1_u16(dst_data + idx, vbsl_u16(is_min, int_min_fp16, FloatToFp16(vcvtq_f32_s32(value))));
+  }
+  return idx;
+}
+
+void AddPlatformCastFuncs(CastFuncMap &funcs) {
+  // the integer casts are left to the compiler
+  funcs[std::make_pair(DT_FLOAT, DT_FLOAT16)] = NeonFloatToFp16;
+  funcs[std::make_pair(DT_FLOAT, DT_INT32)] = NeonFloatToInt32;
+  funcs[std::make_pair(DT_FLOAT16, DT_FLOAT)] = NeonFp16ToFloat;
+  funcs[std::make_pair(DT_FLOAT16, DT_INT32)] = NeonFp16ToInt32;
+  funcs[std::make_pair(DT_INT32, DT_FLOAT)] = NeonInt32ToFloat;
+  funcs[std::make_pair(DT_INT32, DT_FLOAT16)] = NeonInt32ToFp16;
+}
+#else
+void AddPlatformCastFuncs(CastFuncMap &funcs) {}
+#endif
+
+CastFuncMap BuildVectorCastFuncs() {
+  CastFuncMap funcs;
+  AddPlatformCastFuncs(funcs);
+  return funcs;
+}
+}  // namespace
+
+VectorCastFunc GetVectorCastFunc(DataType src_data_type, DataType dst_data_type) {
+  static const CastFuncMap funcs = BuildVectorCastFuncs();
+  auto iter = funcs.find(std::make_pair(src_data_type, dst_data_type));
+  return iter == funcs.end() ? nullptr : iter->second;
+}
+}  // namespace formats
+}  // namespace ge
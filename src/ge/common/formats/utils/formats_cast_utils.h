@@ -0,0 +1,44 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_FORMATS_UTILS_FORMATS_CAST_UTILS_H_
+#define GE_COMMON_FORMATS_UTILS_FORMATS_CAST_UTILS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "external/graph/types.h"
+
+namespace ge {
+namespace formats {
+/**
+ * Vectorized body of a data type cast. It converts the longest prefix of the
+ * num elements that fits its vector width and returns how many elements were
+ * converted; the caller finishes the tail with the scalar cast. The results are
+ * bit-exact with the scalar cast, including the fp16_t saturation rules.
+ */
+using VectorCastFunc = size_t (*)(const uint8_t *src, uint8_t *dst, size_t num);
+
+/**
+ * Get the vectorized cast between the data types for the running cpu
+ * @param src_data_type
+ * @param dst_data_type
+ * @return nullptr if the cpu has no vectorized cast for the data types
+ */
+VectorCastFunc GetVectorCastFunc(DataType src_data_type, DataType dst_data_type);
+}  // namespace formats
+}  // namespace ge
+#endif  // GE_COMMON_FORMATS_UTILS_FORMATS_CAST_UTILS_H_
@@ -16,15 +16,23 @@
 
 #include "common/formats/utils/formats_trans_utils.h"
 
+#include <algorithm>
 #include <cstdint>
 
 #include "common/formats/utils/formats_definitions.h"
+#include "common/task_executor.h"
 #include "framework/common/debug/ge_log.h"
 #include "framework/common/ge_inner_error_codes.h"
 #include "graph/utils/type_utils.h"
 
 namespace ge {
 namespace formats {
+namespace {
+const int64_t kParallelTransMinBytes = 4 * 1024 * 1024;
+// bytes moved by one range of a parallel job, small enough for the workers to balance the load by stealing
+const int64_t kParallelTransRangeBytes = 1024 * 1024;
+}  // namespace
+
 int64_t GetCubeSizeByDataType(DataType data_type) {
   // Current cube does not support 4 bytes and longer data
   auto size = GetSizeByDataType(data_type);
@@ -94,5 +102,47 @@ bool IsShapeEqual(const GeShape &src, const GeShape &dst) {
   }
   return true;
 }
+
+Status TransFormatWith(const TransArgs &args, TransResult &result,
+                       const std::function<Status(const TransArgs &)> &check_args, const DstDataGetter &get_dst_data) {
+  if (check_args(args) != SUCCESS) {
+    return PARAM_INVALID;
+  }
+  // Guarantee the validity of parameters in check function
+  int size = GetSizeByDataType(args.src_data_type);
+  auto total_size = GetItemNumByShape(args.dst_shape) * size;
+  if (total_size <= 0) {
+    GELOGE(INTERNAL_ERROR, "Get %ld total size from dst shape %s, src shape %s", total_size,
+           ShapeToString(args.dst_shape).c_str(), ShapeToString(args.src_shape).c_str());
+    return PARAM_INVALID;
+  }
+  GELOGD("Begin to trans format from %s to %s, src shape %s, data type %s, dst shape %s, memory size %ld",
+         TypeUtils::FormatToSerialString(args.src_format).c_str(),
+         TypeUtils::FormatToSerialString(args.dst_format).c_str(), ShapeToString(args.src_shape).c_str(),
+         TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(), ShapeToString(args.dst_shape).c_str(),
+         total_size);
+  if (get_dst_data(args, result, size, total_size) != SUCCESS) {
+    GELOGE(INTERNAL_ERROR, "Failed to get data after trans, src shape %s, data type %s, dst shape %s, memory size %ld",
+           ShapeToString(args.src_shape).c_str(), TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
+           ShapeToString(args.dst_shape).c_str(), total_size);
+    return INTERNAL_ERROR;
+  }
+  return SUCCESS;
+}
+
+Status ParallelFor(int64_t task_num, int64_t total_bytes, const std::function<Status(int64_t, int64_t)> &func) {
+  if (task_num <= 0) {
+    return SUCCESS;
+  }
+  int64_t range_num = std::min(task_num, total_bytes / kParallelTransRangeBytes);
+  if (range_num <= 1 || total_bytes < kParallelTransMinBytes) {
+    return func(0, task_num);
+  }
+  auto grain_size = static_cast<size_t>(Ceil(task_num, range_num));
+  return TaskExecutor::Instance().ParallelFor(static_cast<size_t>(task_num), grain_size,
+                                              [&func](size_t begin, size_t end) -> Status {
+                                                return func(static_cast<int64_t>(begin), static_cast<int64_t>(end));
+                                              });
+}
 }  // namespace formats
 }  // namespace ge
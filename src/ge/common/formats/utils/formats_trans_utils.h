@@ -18,11 +18,14 @@
 #define GE_COMMON_FORMATS_UTILS_FORMATS_TRANS_UTILS_H_
 
 #include <cstdint>
+#include <functional>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "common/formats/format_transfers/format_transfer.h"
 #include "external/graph/types.h"
+#include "framework/common/ge_inner_error_codes.h"
 #include "graph/ge_tensor.h"
 
 namespace ge {
@@ -67,6 +70,30 @@ T Ceil(T n1, T n2) {
   return (n2 != 0) ? (n1 - 1) / n2 + 1 : 0;
 }
 
+using DstDataGetter = std::function<Status(const TransArgs &, TransResult &, const int, const int64_t)>;
+
+/**
+ * Check the args, get the dst memory size from the dst shape and let get_dst_data fill the result
+ * @param args
+ * @param result
+ * @param check_args the check of the transfer, PARAM_INVALID is returned when it fails
+ * @param get_dst_data called as get_dst_data(args, result, element size, dst memory size)
+ * @return
+ */
+Status TransFormatWith(const TransArgs &args, TransResult &result,
+                       const std::function<Status(const TransArgs &)> &check_args, const DstDataGetter &get_dst_data);
+
+/**
+ * Split [0, task_num) into contiguous ranges and run func on them on the
+ * workers of the TaskExecutor when the job moves at least
+ * kParallelTransMinBytes. func must only touch data owned by its own range.
+ * @param task_num
+ * @param total_bytes bytes moved by the whole job, used to decide whether the workers pay off
+ * @param func called as func(begin, end)
+ * @return the first failure returned by func, SUCCESS otherwise
+ */
+Status ParallelFor(int64_t task_num, int64_t total_bytes, const std::function<Status(int64_t, int64_t)> &func);
+
 }  // namespace formats
 }  // namespace ge
 #endif  // GE_COMMON_FORMATS_UTILS_FORMATS_TRANS_UTILS_H_
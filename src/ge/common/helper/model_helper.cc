@@ -16,21 +16,46 @@
 
 #include "framework/common/helper/model_helper.h"
 
+#include <climits>
+
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
 #include "common/ge/ge_util.h"
 #include "framework/common/debug/ge_log.h"
 #include "framework/common/debug/log.h"
 #include "framework/common/util.h"
 #include "framework/omg/version.h"
 #include "graph/debug/ge_attr_define.h"
+#include "graph/detail/model_serialize_imp.h"
 #include "graph/load/new_model_manager/davinci_model_parser.h"
 #include "graph/utils/attr_utils.h"
 #include "graph/utils/graph_utils.h"
+#include "proto/ge_ir.pb.h"
 
 using std::string;
 using ge::TBEKernelStore;
 using ge::TBEKernelPtr;
 using domi::ModelTaskDef;
 
+namespace {
+// bytes the serialized messages are gathered in before they are written to the file
+const int kSerializeBufferSize = 1024 * 1024;
+
+class PartitionOutputStream : public google::protobuf::io::CopyingOutputStream {
+ public:
+  explicit PartitionOutputStream(ge::PartitionOutput &output) : output_(output) {}
+
+  ~PartitionOutputStream() override = default;
+
+  bool Write(const void *buffer, int size) override {
+    return output_.Write(buffer, static_cast<size_t>(size)) == ge::SUCCESS;
+  }
+
+ private:
+  ge::PartitionOutput &output_;
+};
+}  // namespace
+
 namespace ge {
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY ModelHelper::~ModelHelper() { (void)ReleaseLocalModelData(); }
 
@@ -55,6 +80,30 @@ Status ModelHelper::SaveModelPartition(std::shared_ptr<OmFileSaveHelper> &om_fil
   return SUCCESS;
 }
 
+Status ModelHelper::SaveModelPartition(std::shared_ptr<OmFileSaveHelper> &om_file_save_helper, ModelPartitionType type,
+                                       const google::protobuf::MessageLite &message) {
+  // protobuf serializes no message beyond INT_MAX bytes
+  size_t size = message.ByteSizeLong();
+  if (size < 1 || size > INT_MAX) {
+    GELOGE(PARAM_INVALID, "Add model partition failed, partition size %zu invalid", size);
+    return PARAM_INVALID;
+  }
+  const google::protobuf::MessageLite *partition_message = &message;
+  auto producer = [partition_message](PartitionOutput &output) -> Status {
+    // gives the same bytes as SerializePartialToArray
+    PartitionOutputStream stream(output);
+    google::protobuf::io::CopyingOutputStreamAdaptor adaptor(&stream, kSerializeBufferSize);
+    bool serialized = partition_message->SerializePartialToZeroCopyStream(&adaptor);
+    serialized = adaptor.Flush() && serialized;
+    return serialized ? SUCCESS : FAILED;
+  };
+  if (om_file_save_helper->AddPartition(type, static_cast<uint32_t>(size), producer) != SUCCESS) {
+    GELOGE(PARAM_INVALID, "Add model partition failed, partition size %zu", size);
+    return PARAM_INVALID;
+  }
+  return SUCCESS;
+}
+
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelHelper::SaveToOmModel(const GeModelPtr &ge_model,
                                                                                    const SaveParam &save_param,
                                                                                    const std::string &output_file) {
@@ -75,26 +124,29 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelHelper::SaveToOmMod
   model_tmp->SetVersion(ge_model->GetVersion());
   model_tmp->SetAttr(ge_model->MutableAttrMap());
 
-  ge::Buffer model_buffer;
-  model_tmp->Save(model_buffer);
-  GELOGI("MODEL_DEF size is %zu", model_buffer.GetSize());
-  if (model_buffer.GetSize() > 0) {
-    if (SaveModelPartition(om_file_save_helper, ModelPartitionType::MODEL_DEF, model_buffer.GetData(),
-                           model_buffer.GetSize()) != SUCCESS) {
+  // Nothing is serialized or copied before the file is written, the messages are serialized straight into it
+  proto::ModelDef model_def;
+  ModelSerializeImp serialize_imp;
+  if (!serialize_imp.SerializeModel(*model_tmp, &model_def)) {
+    GELOGW("Serialize model %s failed, the model def is not saved", ge_model->GetName().c_str());
+    model_def.Clear();
+  }
+  GELOGI("MODEL_DEF size is %zu", model_def.ByteSizeLong());
+  if (model_def.ByteSizeLong() > 0) {
+    if (SaveModelPartition(om_file_save_helper, ModelPartitionType::MODEL_DEF, model_def) != SUCCESS) {
       GELOGE(PARAM_INVALID, "Add model graph partition failed");
       return PARAM_INVALID;
     }
   }
 
-  auto ge_model_weight = ge_model->GetWeight();
-  GELOGI("WEIGHTS_DATA size is %zu", ge_model_weight.GetSize());
-  if (SaveModelPartition(om_file_save_helper, ModelPartitionType::WEIGHTS_DATA, ge_model_weight.GetData(),
-                         ge_model_weight.GetSize()) != SUCCESS) {
+  GELOGI("WEIGHTS_DATA size is %zu", ge_model->GetWeightSize());
+  if (SaveModelPartition(om_file_save_helper, ModelPartitionType::WEIGHTS_DATA, ge_model->GetWeightData(),
+                         ge_model->GetWeightSize()) != SUCCESS) {
     GELOGE(PARAM_INVALID, "Add weight partition failed");
     return PARAM_INVALID;
   }
 
-  TBEKernelStore tbe_kernel_store = ge_model->GetTBEKernelStore();
+  const TBEKernelStore &tbe_kernel_store = ge_model->GetTBEKernelStore();
   GELOGI("TBE_KERNELS size is %zu", tbe_kernel_store.DataSize());
   if (tbe_kernel_store.DataSize() > 0) {
     if (SaveModelPartition(om_file_save_helper, ModelPartitionType::TBE_KERNELS, tbe_kernel_store.Data(),
@@ -104,31 +156,15 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelHelper::SaveToOmMod
     }
   }
 
-  // no need to check value, DATA->NetOutput
-  (void)tbe_kernel_store.Load(tbe_kernel_store.Data(), tbe_kernel_store.DataSize());
-
   std::shared_ptr<ModelTaskDef> model_task_def = ge_model->GetModelTaskDefPtr();
   if (model_task_def == nullptr) {
     GELOGE(MEMALLOC_FAILED, "Create model task def ptr failed");
     return FAILED;
   }
-  size_t partition_task_size = model_task_def->ByteSizeLong();
-  GE_IF_BOOL_EXEC(partition_task_size == 0 || partition_task_size > INT_MAX,
-                  GELOGE(FAILED, "Model_def's byte size (%zu) is invalid!", partition_task_size);
-                  return FAILED);
-
-  ge::Buffer task_buffer(partition_task_size);
-  if (task_buffer.GetSize() == 0) {
-    GELOGE(MEMALLOC_FAILED, "Alloc model task def buffer failed");
-    return MEMALLOC_FAILED;
-  }
-  (void)model_task_def->SerializePartialToArray(task_buffer.GetData(), static_cast<int>(partition_task_size));
-
   GELOGI("TASK_INFO op_size:%d, stream_num:%u", model_task_def->op().size(), model_task_def->stream_num());
-  GELOGI("TASK_INFO size is %zu", partition_task_size);
+  GELOGI("TASK_INFO size is %zu", model_task_def->ByteSizeLong());
 
-  if (SaveModelPartition(om_file_save_helper, ModelPartitionType::TASK_INFO, task_buffer.GetData(),
-                         partition_task_size) != SUCCESS) {
+  if (SaveModelPartition(om_file_save_helper, ModelPartitionType::TASK_INFO, *model_task_def) != SUCCESS) {
     GELOGE(PARAM_INVALID, "Add model task def partition failed");
     return PARAM_INVALID;
   }
@@ -232,7 +268,8 @@ ModelHelper::SaveOriginalGraphToOmModel(const ge::Graph &graph, const std::strin
   return (ret == SUCCESS ? SUCCESS : FAILED);
 }
 
-FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelHelper::LoadModel(const ge::ModelData &model_data) {
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelHelper::LoadModel(const ge::ModelData &model_data,
+                                                                                 bool refer_weights) {
   if (model_data.model_data == nullptr || model_data.model_len == 0) {
     GELOGE(FAILED, "Model_data is nullptr, or model_data_size is 0");
     return FAILED;
@@ -253,6 +290,7 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelHelper::LoadModel(c
   }
 
   file_header_ = reinterpret_cast<ModelFileHeader *>(model_data.model_data);
+  refer_weights_ = refer_weights;
 
   OmFileLoadHelper om_load_helper;
   if (om_load_helper.Init(model_addr_tmp_, model_len_tmp_) != SUCCESS) {
@@ -306,6 +344,8 @@ Status ModelHelper::LoadModelData(OmFileLoadHelper &om_load_helper) {
     GELOGE(INTERNAL_ERROR, "Load model failed.");
     return INTERNAL_ERROR;
   }
+  // the graph has been parsed, the pages of a mapped model file are not read again
+  DavinciModelParser::ReleasePages(partition_model_def.data, partition_model_def.size);
 
   SetModelToGeModel(model);
 
@@ -326,8 +366,14 @@ Status ModelHelper::LoadWeights(OmFileLoadHelper &om_load_helper) {
     GELOGE(FAILED, "Get weight model partition failed.");
     return FAILED;
   }
-  ge::Buffer weight = ge::Buffer::CopyFrom(partition.data, partition.size);
-  model_->SetWeight(weight);
+  if (refer_weights_) {
+    // uploaded to the device straight from the model data, a mapped model file is read sequentially once
+    model_->SetWeightRef(partition.data, partition.size);
+  } else {
+    ge::Buffer weight = ge::Buffer::CopyFrom(partition.data, partition.size);
+    model_->SetWeight(weight);
+    DavinciModelParser::ReleasePages(partition.data, partition.size);
+  }
 
   GELOGI("GetWeight size:%u", partition.size);
   return SUCCESS;
@@ -347,6 +393,7 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelHelper::LoadTask(Om
       return INTERNAL_ERROR;
     }
     GELOGI("TASK_INFO op_size:%d, stream_num:%u", task->op().size(), task->stream_num());
+    DavinciModelParser::ReleasePages(task_partition.data, task_partition.size);
   }
   model_->SetModelTaskDef(task);
   return SUCCESS;
@@ -363,6 +410,7 @@ Status ModelHelper::LoadTBEKernelStore(OmFileLoadHelper &om_load_helper) {
     } else {
       GELOGW("Load tbe kernels failed");
     }
+    DavinciModelParser::ReleasePages(partition_kernel_def.data, partition_kernel_def.size);
   }
   model_->SetTBEKernelStore(kernel_store);
   return SUCCESS;
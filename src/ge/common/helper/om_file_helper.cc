@@ -167,10 +167,28 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status OmFileSaveHelper::AddPar
     return FAILED;
   }
   context_.partition_datas_.push_back(partition);
+  partition_producers_.emplace_back(nullptr);
   context_.model_data_len_ += partition.size;
   return SUCCESS;
 }
 
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status
+OmFileSaveHelper::AddPartition(ModelPartitionType type, uint32_t size, const PartitionProducer &producer) {
+  GE_CHK_BOOL_RET_STATUS(producer != nullptr, PARAM_INVALID, "Partition producer of type %d is null.",
+                         static_cast<int>(type));
+  if (CheckUint32AddOverflow(context_.model_data_len_, size) != SUCCESS) {
+    GELOGE(FAILED, "UINT32 %u and %u addition can result in overflow!", context_.model_data_len_, size);
+    return FAILED;
+  }
+  ModelPartition partition;
+  partition.type = type;
+  partition.size = size;
+  context_.partition_datas_.push_back(partition);
+  partition_producers_.push_back(producer);
+  context_.model_data_len_ += size;
+  return SUCCESS;
+}
+
 Status OmFileSaveHelper::SaveModel(const SaveParam &save_param, const char *output_file) {
   (void)save_param.cert_file;
   (void)save_param.ek_file;
@@ -204,8 +222,8 @@ Status OmFileSaveHelper::SaveModelToFile(const char *output_file) {
   GELOGI("Sizeof(ModelFileHeader):%zu,sizeof(ModelPartitionTable):%u, model_data_len:%u, model_total_len:%zu",
          sizeof(ModelFileHeader), size_of_table, model_data_len, model_header_.length + sizeof(ModelFileHeader));
 
-  std::vector<ModelPartition> partition_datas = context_.partition_datas_;
-  Status ret = FileSaver::SaveToFile(output_file, model_header_, *partition_table, partition_datas);
+  Status ret = FileSaver::SaveToFile(output_file, model_header_, *partition_table, context_.partition_datas_,
+                                     partition_producers_);
   if (ret == SUCCESS) {
     GELOGI("Save model success without encrypt.");
   }
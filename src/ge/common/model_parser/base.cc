@@ -16,16 +16,61 @@
 
 #include "common/model_parser/base.h"
 
+#include <fcntl.h>
 #include <securec.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/sysinfo.h>
+#include <unistd.h>
 #include <fstream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "framework/common/debug/ge_log.h"
 #include "framework/common/debug/log.h"
 #include "framework/common/util.h"
 
+namespace {
+// start address -> length of the model files mapped by MapFromFile
+std::mutex g_mapped_files_mutex;
+std::map<uintptr_t, size_t> g_mapped_files;
+
+// Only ranges inside one mapped model file are advised, madvise must never drop the pages of heap memory.
+// to_inner: shrink the range to the pages it covers completely, else grow it to whole pages
+void AdviseMappedRange(const void *addr, size_t size, int advice, bool to_inner) {
+  if ((addr == nullptr) || (size == 0)) {
+    return;
+  }
+  uintptr_t begin = reinterpret_cast<uintptr_t>(addr);
+  uintptr_t end = begin + size;
+  std::lock_guard<std::mutex> lock(g_mapped_files_mutex);
+  auto iter = g_mapped_files.upper_bound(begin);
+  if (iter == g_mapped_files.begin()) {
+    return;
+  }
+  --iter;
+  if (end > iter->first + iter->second) {
+    return;
+  }
+
+  uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  if (to_inner) {
+    begin = (begin + page_size - 1) / page_size * page_size;
+    end = end / page_size * page_size;
+  } else {
+    begin = begin / page_size * page_size;
+  }
+  if (begin >= end) {
+    return;
+  }
+  if (madvise(reinterpret_cast<void *>(begin), end - begin, advice) != 0) {
+    GELOGW("Advise %d on model data failed, size:%zu.", advice, static_cast<size_t>(end - begin));
+  }
+}
+}  // namespace
+
 namespace ge {
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY ModelParserBase::ModelParserBase() {}
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY ModelParserBase::~ModelParserBase() {}
@@ -71,6 +116,87 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelParserBase::LoadFro
   return SUCCESS;
 }
 
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelParserBase::MapFromFile(const char *model_path,
+                                                                                     const char *key, int32_t priority,
+                                                                                     ge::ModelData &model_data) {
+  std::string real_path = RealPath(model_path);
+  if (real_path.empty()) {
+    GELOGE(PARAM_INVALID, "Model file path '%s' is invalid", model_path);
+    return PARAM_INVALID;
+  }
+
+  int fd = open(real_path.c_str(), O_RDONLY);
+  GE_CHK_BOOL_RET_STATUS(fd >= 0, FAILED, "Open file failed! path:%s", model_path);
+
+  struct stat file_stat;
+  if ((fstat(fd, &file_stat) != 0) || (file_stat.st_size < 1) || (file_stat.st_size > UINT32_MAX)) {
+    (void)close(fd);
+    GELOGE(FAILED, "File size not valid. path:%s", model_path);
+    return FAILED;
+  }
+  size_t len = static_cast<size_t>(file_stat.st_size);
+
+  // Private and writable like the buffer of LoadFromFile, nothing is written back to the file
+  void *data = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  // the mapping keeps its own reference to the file
+  (void)close(fd);
+  if (data == MAP_FAILED) {
+    GELOGE(MEMALLOC_FAILED, "Map model file failed. (need:%zu)", len);
+    return MEMALLOC_FAILED;
+  }
+  {
+    std::lock_guard<std::mutex> lock(g_mapped_files_mutex);
+    g_mapped_files[reinterpret_cast<uintptr_t>(data)] = len;
+  }
+
+  // Set the model data parameter
+  model_data.model_data = data;
+  model_data.model_len = static_cast<uint32_t>(len);
+  model_data.priority = priority;
+  model_data.key = (key == nullptr) ? "" : key;
+
+  GELOGI("Map model file %s, size:%zu.", model_path, len);
+  return SUCCESS;
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY void ModelParserBase::FreeModelData(ge::ModelData &model_data) {
+  if (model_data.model_data == nullptr) {
+    return;
+  }
+
+  size_t mapped_len = 0;
+  {
+    std::lock_guard<std::mutex> lock(g_mapped_files_mutex);
+    auto iter = g_mapped_files.find(reinterpret_cast<uintptr_t>(model_data.model_data));
+    if (iter != g_mapped_files.end()) {
+      mapped_len = iter->second;
+      (void)g_mapped_files.erase(iter);
+    }
+  }
+
+  if (mapped_len != 0) {
+    if (munmap(model_data.model_data, mapped_len) != 0) {
+      GELOGW("Unmap model file failed, size:%zu.", mapped_len);
+    }
+  } else {
+    delete[] static_cast<char *>(model_data.model_data);
+  }
+  model_data.model_data = nullptr;
+  model_data.model_len = 0;
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY void ModelParserBase::AdviseSequential(const void *addr,
+                                                                                        size_t size) {
+  AdviseMappedRange(addr, size, MADV_SEQUENTIAL, false);
+  // start the readahead now, the pages are read while the caller prepares the upload
+  AdviseMappedRange(addr, size, MADV_WILLNEED, false);
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY void ModelParserBase::ReleasePages(const void *addr, size_t size) {
+  // pages shared with a neighbouring range may still be read, keep them
+  AdviseMappedRange(addr, size, MADV_DONTNEED, true);
+}
+
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelParserBase::ParseModelContent(const ge::ModelData &model,
                                                                                            uint8_t *&model_data,
                                                                                            uint32_t &model_len) {
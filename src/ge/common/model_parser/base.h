@@ -50,6 +50,43 @@ class ModelParserBase {
   static Status LoadFromFile(const char *model_file, const char *model_key, int32_t priority,
                              ge::ModelData &model_data);
 
+  ///
+  /// @ingroup hiai
+  /// @brief Map a model file read-only instead of reading it, the partitions stay views into the mapped pages
+  ///        and only the pages touched are read from disk. Release the model data with FreeModelData
+  /// @param [in] model_file  model path
+  /// @param [in] model_key   model secret key
+  /// @param [in] priority    modle priority
+  /// @param [out] model_data model data
+  /// @return Status  result
+  ///
+  static Status MapFromFile(const char *model_file, const char *model_key, int32_t priority,
+                            ge::ModelData &model_data);
+
+  ///
+  /// @ingroup hiai
+  /// @brief Release the model data of LoadFromFile or MapFromFile
+  /// @param [in|out] model_data model data, reset to null
+  ///
+  static void FreeModelData(ge::ModelData &model_data);
+
+  ///
+  /// @ingroup hiai
+  /// @brief Hint that a range of a mapped model file is read once from the start, no-op for other memory
+  /// @param [in] addr  start of the range
+  /// @param [in] size  length of the range
+  ///
+  static void AdviseSequential(const void *addr, size_t size);
+
+  ///
+  /// @ingroup hiai
+  /// @brief Drop the pages of a range of a mapped model file that has been consumed, e.g. weights uploaded to
+  ///        the device. They are read from disk again if touched later. No-op for other memory
+  /// @param [in] addr  start of the range
+  /// @param [in] size  length of the range
+  ///
+  static void ReleasePages(const void *addr, size_t size);
+
   ///
   /// @ingroup domi_ome
   /// @brief Parse model contents from the ModelData
@@ -21,6 +21,7 @@
 #include "framework/common/debug/ge_log.h"
 #include "framework/common/debug/log.h"
 #include "framework/common/string_util.h"
+#include "framework/common/util.h"
 #include "runtime/base.h"
 
 using Json = nlohmann::json;
@@ -244,6 +245,7 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY ge::Status ProfilingManager::St
 
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY void ProfilingManager::StopProfiling() {
 #ifdef DAVINCI_SUPPORT_PROFILING
+  run_reporter_.Stop();
   Msprof::Engine::Reporter *reporter = PluginImpl::GetPluginReporter();
   if (reporter != nullptr) {
     int ret = reporter->Flush();
@@ -269,32 +271,24 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY void ProfilingManager::StopProf
 }
 
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY void ProfilingManager::ReportProfilingData(
-    const std::map<uint32_t, std::string> &op_task_id_map) {
+    uint32_t model_id, uint32_t data_index, const std::map<uint32_t, std::string> &op_task_id_map) {
 #ifdef DAVINCI_SUPPORT_PROFILING
   Msprof::Engine::Reporter *reporter = PluginImpl::GetPluginReporter();
   if (reporter == nullptr) {
     GELOGI("Profiling report is nullptr!");
     return;
   }
-  std::string data;
-  for (const auto &iter : op_task_id_map) {
-    data = iter.second + ' ' + std::to_string(iter.first) + ';';
-    Msprof::Engine::ReporterData reporter_data{};
-    reporter_data.deviceId = device_id_;
-    reporter_data.data = (unsigned char *)data.c_str();
-    reporter_data.dataLen = data.size();
-    int ret = memcpy_s(reporter_data.tag, MSPROF_ENGINE_MAX_TAG_LEN + 1, "framework", sizeof("framework"));
-    if (ret != EOK) {
-      GELOGE(ret, "Report data tag memcpy error!");
-      return;
-    }
-    ret = reporter->Report(&reporter_data);
-    if (ret != SUCCESS) {
-      GELOGE(ret, "Reporter data fail!");
-      return;
-    }
+  if (run_reporter_.Start(reporter, device_id_) != SUCCESS) {
+    GELOGE(FAILED, "Start profiling reporter failed!");
+    return;
+  }
+  if (run_reporter_.ReportTaskTable(model_id, op_task_id_map) != SUCCESS) {
+    GELOGE(FAILED, "Report task table of model %u failed!", model_id);
+    return;
+  }
+  if (!run_reporter_.Push({model_id, data_index, GetCurrentTimestap()})) {
+    GELOGD("Profiling record of model %u lost, ring is full.", model_id);
   }
-  GELOGI("Report profiling data for GE end.");
 #endif
 }
 
@@ -319,6 +313,8 @@ int PluginImpl::Init(const Msprof::Engine::Reporter *reporter) {
 
 int PluginImpl::UnInit() {
   GELOGI("PluginImpl Uninit");
+  // the queued records go to the reporter before it is gone
+  ProfilingManager::Instance().StopReport();
   reporter_ = nullptr;
   return 0;
 }
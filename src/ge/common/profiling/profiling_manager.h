@@ -24,6 +24,7 @@
 #include "framework/common/ge_inner_error_codes.h"
 #include "framework/common/ge_types.h"
 #include "external/register/register_types.h"
+#include "common/profiling/profiling_reporter.h"
 #include "toolchain/prof_engine.h"
 #include "toolchain/prof_mgr_core.h"
 
@@ -46,7 +47,18 @@ class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY ProfilingManager {
   bool ProfilingLoadFlag() const { return is_load_; }
   bool ProfilingOn() const { return is_profiling_; }
   int32_t GetOpTraceIterNum() const { return op_trace_iter_num_; }
-  void ReportProfilingData(const std::map<uint32_t, std::string> &op_task_id_map);
+  ///
+  /// @ingroup ge
+  /// @brief report a run of a model, the task table of the model is sent with the first run of a profiling session
+  /// @param [in] model_id id of the model
+  /// @param [in] data_index index of the request
+  /// @param [in] op_task_id_map task id to op name of the model
+  ///
+  void ReportProfilingData(uint32_t model_id, uint32_t data_index,
+                           const std::map<uint32_t, std::string> &op_task_id_map);
+  // send the records queued and stop sending them
+  void StopReport() { run_reporter_.Stop(); }
+  ProfilingReportStats GetReportStats() const { return run_reporter_.GetStats(); }
   void SetProfilingConfig(const string &profiling_cfg);
 
  private:
@@ -61,6 +73,7 @@ class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY ProfilingManager {
   void *prof_handle = nullptr;
   string recv_profiling_config_;
   string send_profiling_config_;
+  ProfilingReporter run_reporter_;
 };
 
 ///
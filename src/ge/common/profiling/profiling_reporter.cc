@@ -0,0 +1,314 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/profiling/profiling_reporter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <system_error>
+
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/debug/log.h"
+#include "securec.h"
+
+namespace ge {
+namespace {
+// every blob starts with a head, all fields are in host byte order:
+// task table: head, then per task uint32 task id, uint16 name length and the name without '\0'
+// run records: head, then the ProfilingRunRecords
+const uint32_t kTaskTableMagic = 0x4B534154;  // "TASK"
+const uint32_t kRunRecordMagic = 0x534E5552;  // "RUNS"
+const uint16_t kReportVersion = 1;
+const size_t kMaxReportLen = 64 * 1024;
+const size_t kMaxNameLen = UINT16_MAX;
+const char *const kTaskTableTag = "framework_task_table";
+const char *const kRunRecordTag = "framework_model_run";
+const int64_t kFlushIntervalMs = 100;
+
+struct ReportHead {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t reserved;
+  // id of the model of a task table, 0 for run records
+  uint32_t model_id;
+  // tasks or records in the blob
+  uint32_t num;
+};
+
+void AppendData(std::vector<uint8_t> &data, const void *src, size_t len) {
+  auto begin = static_cast<const uint8_t *>(src);
+  data.insert(data.end(), begin, begin + len);
+}
+
+void InitBlob(std::vector<uint8_t> &data, uint32_t magic, uint32_t model_id) {
+  ReportHead head = {magic, kReportVersion, 0, model_id, 0};
+  data.clear();
+  AppendData(data, &head, sizeof(head));
+}
+
+void SetBlobNum(std::vector<uint8_t> &data, uint32_t num) {
+  (void)memcpy_s(data.data() + offsetof(ReportHead, num), sizeof(uint32_t), &num, sizeof(num));
+}
+}  // namespace
+
+const size_t ProfilingReporter::kDefaultCapacity;
+const size_t ProfilingReporter::kBatchSize;
+const size_t ProfilingReporter::kReportedCacheSize;
+
+ProfilingReporter::ProfilingReporter(size_t capacity) {
+  size_t size = 2;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  cells_.reset(new Cell[size]);
+  for (size_t i = 0; i < size; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  mask_ = size - 1;
+  wake_num_ = std::min(kBatchSize, size / 2);
+  for (auto &slot : reported_cache_) {
+    slot.store(0, std::memory_order_relaxed);
+  }
+}
+
+ProfilingReporter::~ProfilingReporter() { Stop(); }
+
+Status ProfilingReporter::Start(Msprof::Engine::Reporter *reporter, int32_t device_id) {
+  GE_CHECK_NOTNULL(reporter);
+  // every run calls Start, only a new session takes the lock
+  if (reporter_.load(std::memory_order_acquire) == reporter) {
+    return SUCCESS;
+  }
+  std::lock_guard<std::mutex> lock(session_mutex_);
+  if (reporter_.load() == reporter) {
+    return SUCCESS;
+  }
+  if (reporter_.load() != nullptr) {
+    GELOGI("Profiling reporter changed, restart the session.");
+    StopSession();
+  }
+
+  device_id_ = device_id;
+  {
+    std::lock_guard<std::mutex> table_lock(table_mutex_);
+    reported_models_.clear();
+    ++session_id_;
+  }
+  stopping_ = false;
+  reporter_.store(reporter);
+  try {
+    flush_thread_ = std::thread(&ProfilingReporter::FlushFunc, this);
+  } catch (const std::system_error &e) {
+    // the records are sent by Flush and Stop then
+    GELOGW("Create profiling flush thread failed, %s.", e.what());
+  }
+  GELOGI("Profiling reporter started, device id:%d.", device_id);
+  return SUCCESS;
+}
+
+void ProfilingReporter::Stop() {
+  std::lock_guard<std::mutex> lock(session_mutex_);
+  StopSession();
+}
+
+void ProfilingReporter::StopSession() {
+  if (reporter_.load() == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> wait_lock(wait_mutex_);
+    stopping_ = true;
+  }
+  wait_cond_.notify_all();
+  if (flush_thread_.joinable()) {
+    try {
+      flush_thread_.join();
+    } catch (const std::system_error &e) {
+      GELOGW("Join profiling flush thread failed, %s.", e.what());
+    }
+  }
+
+  Flush();
+  reporter_.store(nullptr);
+  ProfilingReportStats stats = GetStats();
+  GELOGI("Profiling reporter stopped, records reported:%lu, overflow:%lu, dropped:%lu.", stats.reported_num,
+         stats.overflow_num, stats.drop_num);
+}
+
+Status ProfilingReporter::ReportTaskTable(uint32_t model_id, const std::map<uint32_t, std::string> &op_task_id_map) {
+  if (reporter_.load(std::memory_order_relaxed) == nullptr) {
+    return SUCCESS;
+  }
+  std::atomic<uint64_t> &slot = reported_cache_[model_id % kReportedCacheSize];
+  uint64_t key = ReportedKey(session_id_.load(std::memory_order_acquire), model_id);
+  if (slot.load(std::memory_order_acquire) == key) {
+    return SUCCESS;
+  }
+  std::lock_guard<std::mutex> lock(table_mutex_);
+  if (!reported_models_.insert(model_id).second) {
+    slot.store(key, std::memory_order_release);
+    return SUCCESS;
+  }
+
+  std::vector<uint8_t> data;
+  data.reserve(kMaxReportLen);
+  InitBlob(data, kTaskTableMagic, model_id);
+  uint32_t task_num = 0;
+  for (const auto &task_op : op_task_id_map) {
+    auto name_len = static_cast<uint16_t>(std::min(task_op.second.size(), kMaxNameLen));
+    size_t entry_len = sizeof(task_op.first) + sizeof(name_len) + name_len;
+    if ((task_num > 0) && (data.size() + entry_len > kMaxReportLen)) {
+      SetBlobNum(data, task_num);
+      if (SendData(kTaskTableTag, data) != SUCCESS) {
+        (void)reported_models_.erase(model_id);
+        return FAILED;
+      }
+      InitBlob(data, kTaskTableMagic, model_id);
+      task_num = 0;
+    }
+    AppendData(data, &task_op.first, sizeof(task_op.first));
+    AppendData(data, &name_len, sizeof(name_len));
+    AppendData(data, task_op.second.data(), name_len);
+    ++task_num;
+  }
+  SetBlobNum(data, task_num);
+  if (SendData(kTaskTableTag, data) != SUCCESS) {
+    (void)reported_models_.erase(model_id);
+    return FAILED;
+  }
+  slot.store(key, std::memory_order_release);
+  GELOGI("Report task table of model %u, task num:%zu.", model_id, op_task_id_map.size());
+  return SUCCESS;
+}
+
+bool ProfilingReporter::Push(const ProfilingRunRecord &record) {
+  if (reporter_.load(std::memory_order_relaxed) == nullptr) {
+    return false;
+  }
+
+  Cell *cell = nullptr;
+  size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    cell = &cells_[pos & mask_];
+    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    if (sequence == pos) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (sequence < pos) {
+      // the cell still holds the record of the former round
+      ++overflow_num_;
+      return false;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+  cell->record = record;
+  cell->sequence.store(pos + 1, std::memory_order_release);
+
+  if (pos + 1 - dequeue_pos_.load(std::memory_order_relaxed) == wake_num_) {
+    wait_cond_.notify_one();
+  }
+  return true;
+}
+
+bool ProfilingReporter::Pop(ProfilingRunRecord &record) {
+  size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+  Cell &cell = cells_[pos & mask_];
+  if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+    return false;
+  }
+  record = cell.record;
+  cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+  dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+  return true;
+}
+
+void ProfilingReporter::Flush() {
+  std::lock_guard<std::mutex> lock(flush_mutex_);
+  std::vector<ProfilingRunRecord> records;
+  records.reserve(kBatchSize);
+  ProfilingRunRecord record;
+  while (Pop(record)) {
+    records.push_back(record);
+    if (records.size() == kBatchSize) {
+      SendBatch(records);
+      records.clear();
+    }
+  }
+  if (!records.empty()) {
+    SendBatch(records);
+  }
+}
+
+void ProfilingReporter::FlushFunc() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(wait_mutex_);
+      // a push may miss the wait, the interval bounds the delay then
+      (void)wait_cond_.wait_for(lock, std::chrono::milliseconds(kFlushIntervalMs), [this] {
+        return stopping_ ||
+               (enqueue_pos_.load(std::memory_order_relaxed) - dequeue_pos_.load(std::memory_order_relaxed) >=
+                wake_num_);
+      });
+      if (stopping_) {
+        return;
+      }
+    }
+    Flush();
+  }
+}
+
+void ProfilingReporter::SendBatch(const std::vector<ProfilingRunRecord> &records) {
+  std::vector<uint8_t> data;
+  InitBlob(data, kRunRecordMagic, 0);
+  SetBlobNum(data, static_cast<uint32_t>(records.size()));
+  AppendData(data, records.data(), records.size() * sizeof(ProfilingRunRecord));
+  if (SendData(kRunRecordTag, data) != SUCCESS) {
+    drop_num_ += records.size();
+    return;
+  }
+  reported_num_ += records.size();
+}
+
+Status ProfilingReporter::SendData(const char *tag, const std::vector<uint8_t> &data) {
+  Msprof::Engine::Reporter *reporter = reporter_.load();
+  if (reporter == nullptr) {
+    return FAILED;
+  }
+  Msprof::Engine::ReporterData reporter_data{};
+  reporter_data.deviceId = device_id_;
+  reporter_data.data = const_cast<unsigned char *>(data.data());
+  reporter_data.dataLen = data.size();
+  int ret = strncpy_s(reporter_data.tag, MSPROF_ENGINE_MAX_TAG_LEN + 1, tag, MSPROF_ENGINE_MAX_TAG_LEN);
+  if (ret != EOK) {
+    GELOGE(FAILED, "Report data tag %s copy error!", tag);
+    return FAILED;
+  }
+  ret = reporter->Report(&reporter_data);
+  if (ret != 0) {
+    GELOGW("Report %zu bytes of %s failed, ret:%d.", data.size(), tag, ret);
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+ProfilingReportStats ProfilingReporter::GetStats() const {
+  return {reported_num_.load(), overflow_num_.load(), drop_num_.load()};
+}
+}  // namespace ge
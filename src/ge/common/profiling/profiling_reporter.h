@@ -0,0 +1,172 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_PROFILING_PROFILING_REPORTER_H_
+#define GE_COMMON_PROFILING_PROFILING_REPORTER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "framework/common/ge_inner_error_codes.h"
+#include "toolchain/prof_reporter.h"
+
+namespace ge {
+// record of one model run, sent to the profiler in batches
+struct ProfilingRunRecord {
+  uint32_t model_id;
+  uint32_t data_index;
+  // host time the run ended, in us
+  uint64_t timestamp;
+};
+
+struct ProfilingReportStats {
+  // records sent to the profiler
+  uint64_t reported_num;
+  // records lost as the ring was full
+  uint64_t overflow_num;
+  // records lost as the profiler refused the batch holding them
+  uint64_t drop_num;
+};
+
+///
+/// Sends the profiling data of the model runs without slowing them down.
+/// The task id to op name table of a model is sent once per profiling session as one binary blob, the runs push
+/// records to a lock-free ring that a background thread sends in batches.
+///
+class ProfilingReporter {
+ public:
+  ///
+  /// @param [in] capacity number of records the ring holds, rounded up to a power of 2
+  ///
+  explicit ProfilingReporter(size_t capacity = kDefaultCapacity);
+
+  ~ProfilingReporter();
+
+  ///
+  /// @ingroup ge
+  /// @brief start a profiling session sending to the reporter, nothing to do if it is started with the same one
+  /// @param [in] reporter reporter of the profiler
+  /// @param [in] device_id device of the data
+  /// @return Status result of function
+  ///
+  Status Start(Msprof::Engine::Reporter *reporter, int32_t device_id);
+
+  ///
+  /// @ingroup ge
+  /// @brief send the records left and end the session, the tables are sent again in the next one
+  ///
+  void Stop();
+
+  bool IsStarted() const { return reporter_.load() != nullptr; }
+
+  ///
+  /// @ingroup ge
+  /// @brief send the task id to op name table of a model if it is not sent yet in this session
+  /// @param [in] model_id id of the model, unique for every load
+  /// @param [in] op_task_id_map task id to op name
+  /// @return Status result of function
+  ///
+  Status ReportTaskTable(uint32_t model_id, const std::map<uint32_t, std::string> &op_task_id_map);
+
+  ///
+  /// @ingroup ge
+  /// @brief queue the record of a run, never blocks
+  /// @return false if the record is lost as the ring is full or the session is not started
+  ///
+  bool Push(const ProfilingRunRecord &record);
+
+  ///
+  /// @ingroup ge
+  /// @brief send the queued records on the calling thread
+  ///
+  void Flush();
+
+  ProfilingReportStats GetStats() const;
+
+  ProfilingReporter(const ProfilingReporter &) = delete;
+  ProfilingReporter &operator=(const ProfilingReporter &) = delete;
+
+  static const size_t kDefaultCapacity = 4096;
+  // records of one batch
+  static const size_t kBatchSize = 256;
+  // slots of the reported table cache
+  static const size_t kReportedCacheSize = 64;
+
+ private:
+  // a cell is free for the producer of position pos when sequence is pos, ready for the consumer when pos + 1
+  struct Cell {
+    std::atomic<size_t> sequence;
+    ProfilingRunRecord record;
+  };
+
+  // under session_mutex_
+  void StopSession();
+
+  bool Pop(ProfilingRunRecord &record);
+
+  void FlushFunc();
+
+  // sends the records popped, under flush_mutex_
+  void SendBatch(const std::vector<ProfilingRunRecord> &records);
+
+  Status SendData(const char *tag, const std::vector<uint8_t> &data);
+
+  // key of a model in the reported table cache, never 0 so a free slot misses
+  static uint64_t ReportedKey(uint32_t session_id, uint32_t model_id) {
+    return (static_cast<uint64_t>(session_id) << 32) | model_id;
+  }
+
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_;
+  // records in the ring that wake the flush thread
+  size_t wake_num_;
+  std::atomic<size_t> enqueue_pos_{0};
+  std::atomic<size_t> dequeue_pos_{0};
+
+  std::atomic<Msprof::Engine::Reporter *> reporter_{nullptr};
+  int32_t device_id_ = 0;
+  std::atomic<uint64_t> reported_num_{0};
+  std::atomic<uint64_t> overflow_num_{0};
+  std::atomic<uint64_t> drop_num_{0};
+
+  // Start and Stop
+  std::mutex session_mutex_;
+  // one consumer at a time
+  std::mutex flush_mutex_;
+  std::mutex table_mutex_;
+  std::set<uint32_t> reported_models_;
+  // bumped by every new session, starts from 1
+  std::atomic<uint32_t> session_id_{0};
+  // models whose table is sent, indexed by model id, read without a lock by the runs
+  // a model sharing the slot of another one falls back to reported_models_
+  std::atomic<uint64_t> reported_cache_[kReportedCacheSize];
+
+  std::thread flush_thread_;
+  std::mutex wait_mutex_;
+  std::condition_variable wait_cond_;
+  bool stopping_ = false;
+};
+}  // namespace ge
+
+#endif  // GE_COMMON_PROFILING_PROFILING_REPORTER_H_
@@ -0,0 +1,64 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_RW_LOCK_H_
+#define GE_COMMON_RW_LOCK_H_
+
+#include <pthread.h>
+
+namespace ge {
+///
+/// Reader writer lock, the readers share it and a writer excludes everyone. It is not recursive in either mode.
+/// It is Lockable for the writers so std::lock_guard takes it, ReadLockGuard takes it for a reader.
+///
+class RwLock {
+ public:
+  RwLock() { (void)pthread_rwlock_init(&lock_, nullptr); }
+
+  ~RwLock() { (void)pthread_rwlock_destroy(&lock_); }
+
+  void lock() { (void)pthread_rwlock_wrlock(&lock_); }
+
+  bool try_lock() { return pthread_rwlock_trywrlock(&lock_) == 0; }
+
+  void unlock() { (void)pthread_rwlock_unlock(&lock_); }
+
+  void lock_shared() { (void)pthread_rwlock_rdlock(&lock_); }
+
+  void unlock_shared() { (void)pthread_rwlock_unlock(&lock_); }
+
+  RwLock(const RwLock &) = delete;
+  RwLock &operator=(const RwLock &) = delete;
+
+ private:
+  pthread_rwlock_t lock_;
+};
+
+class ReadLockGuard {
+ public:
+  explicit ReadLockGuard(RwLock &lock) : lock_(lock) { lock_.lock_shared(); }
+
+  ~ReadLockGuard() { lock_.unlock_shared(); }
+
+  ReadLockGuard(const ReadLockGuard &) = delete;
+  ReadLockGuard &operator=(const ReadLockGuard &) = delete;
+
+ private:
+  RwLock &lock_;
+};
+}  // namespace ge
+
+#endif  // GE_COMMON_RW_LOCK_H_
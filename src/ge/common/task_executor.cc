@@ -0,0 +1,242 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/task_executor.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <system_error>
+
+#include "framework/common/debug/log.h"
+#include "framework/common/fmk_error_codes.h"
+#include "register/register_types.h"
+
+namespace ge {
+namespace {
+const size_t kNotWorker = SIZE_MAX;
+// index of the worker running on this thread
+thread_local size_t current_worker = kNotWorker;
+
+uint32_t GetHardwareConcurrency() {
+  uint32_t concurrency = std::thread::hardware_concurrency();
+  return concurrency == 0 ? 1 : concurrency;
+}
+
+// ranges of one ParallelFor, shared with the tasks that help to run them
+struct ParallelForContext {
+  size_t count = 0;
+  size_t grain_size = 0;
+  size_t range_num = 0;
+  const std::function<Status(size_t, size_t)> *func = nullptr;
+  std::atomic<size_t> next_range{0};
+  std::atomic<size_t> done_range_num{0};
+  std::atomic<bool> failed{false};
+  std::mutex mutex;
+  std::condition_variable cond;
+  Status result = SUCCESS;
+};
+
+void RunRanges(ParallelForContext &context) {
+  size_t range = 0;
+  while ((range = context.next_range.fetch_add(1)) < context.range_num) {
+    // func is only valid until the last range is done, it is not touched after
+    if (!context.failed.load()) {
+      size_t begin = range * context.grain_size;
+      size_t end = std::min(context.count, begin + context.grain_size);
+      Status ret = FAILED;
+      try {
+        ret = (*context.func)(begin, end);
+      } catch (...) {
+        GELOGE(FAILED, "Range [%zu, %zu) throws an exception.", begin, end);
+      }
+      if (ret != SUCCESS) {
+        std::lock_guard<std::mutex> lock(context.mutex);
+        if (!context.failed.load()) {
+          context.result = ret;
+          context.failed.store(true);
+        }
+      }
+    }
+    if (context.done_range_num.fetch_add(1) + 1 == context.range_num) {
+      std::lock_guard<std::mutex> lock(context.mutex);
+      context.cond.notify_all();
+    }
+  }
+}
+}  // namespace
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY TaskExecutor &TaskExecutor::Instance() {
+  static TaskExecutor instance;
+  return instance;
+}
+
+TaskExecutor::~TaskExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stopped_ = true;
+    sleep_cond_.notify_all();
+  }
+  for (std::thread &thread : threads_) {
+    if (!thread.joinable()) {
+      continue;
+    }
+    // the process may exit from a task
+    if (thread.get_id() == std::this_thread::get_id()) {
+      thread.detach();
+      continue;
+    }
+    try {
+      thread.join();
+    } catch (const std::system_error &e) {
+      GELOGW("Join worker failed, %s.", e.what());
+    }
+  }
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status TaskExecutor::SetThreadNum(uint32_t thread_num) {
+  uint32_t max_thread_num = GetHardwareConcurrency();
+  if (thread_num == 0 || thread_num > max_thread_num) {
+    thread_num = max_thread_num;
+  }
+  std::lock_guard<std::mutex> lock(sleep_mutex_);
+  if (started_.load()) {
+    GELOGW("Task executor is started with %u threads, ignore thread num %u.", thread_num_, thread_num);
+    return FAILED;
+  }
+  thread_num_ = thread_num;
+  GELOGI("Task executor thread num is %u.", thread_num_);
+  return SUCCESS;
+}
+
+void TaskExecutor::Start() {
+  std::lock_guard<std::mutex> lock(sleep_mutex_);
+  if (thread_num_ == 0) {
+    thread_num_ = GetHardwareConcurrency();
+  }
+  for (uint32_t i = 0; i < thread_num_; ++i) {
+    workers_.emplace_back(new (std::nothrow) Worker());
+    if (workers_.back() == nullptr) {
+      GELOGE(MEMALLOC_FAILED, "Make worker failed.");
+      workers_.pop_back();
+      break;
+    }
+  }
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    try {
+      threads_.emplace_back(&TaskExecutor::WorkerFunc, this, i);
+    } catch (const std::system_error &e) {
+      // the tasks in the deques of the workers without a thread are stolen by the others
+      GELOGW("Create worker %zu failed, %s.", i, e.what());
+    }
+  }
+  if (threads_.empty()) {
+    GELOGE(FAILED, "Create no worker of the task executor.");
+  }
+  GELOGI("Task executor starts %zu of %zu workers.", threads_.size(), workers_.size());
+  started_.store(true);
+}
+
+void TaskExecutor::Submit(ThreadTask &&task) {
+  std::call_once(start_flag_, &TaskExecutor::Start, this);
+  if (threads_.empty()) {
+    task();
+    return;
+  }
+  size_t index = current_worker;
+  if (index == kNotWorker) {
+    index = next_worker_.fetch_add(1) % workers_.size();
+  }
+  {
+    std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+    workers_[index]->tasks.push_back(std::move(task));
+  }
+  pending_num_.fetch_add(1);
+  // a worker going to sleep counts itself before it checks pending_num_
+  if (sleeping_num_.load() > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    sleep_cond_.notify_one();
+  }
+}
+
+bool TaskExecutor::PopTask(size_t index, ThreadTask &task) {
+  {
+    Worker &worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.tasks.empty()) {
+      task = std::move(worker.tasks.back());
+      worker.tasks.pop_back();
+      pending_num_.fetch_sub(1);
+      return true;
+    }
+  }
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    Worker &victim = *workers_[(index + i) % workers_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      pending_num_.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+void TaskExecutor::WorkerFunc(size_t index) {
+  current_worker = index;
+  while (true) {
+    ThreadTask task;
+    if (PopTask(index, task)) {
+      task();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    sleeping_num_.fetch_add(1);
+    sleep_cond_.wait(lock, [this]() { return stopped_ || pending_num_.load() > 0; });
+    sleeping_num_.fetch_sub(1);
+    // the tasks left are run before the workers stop
+    if (stopped_ && pending_num_.load() == 0) {
+      return;
+    }
+  }
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status
+TaskExecutor::ParallelFor(size_t count, size_t grain_size, const std::function<Status(size_t, size_t)> &func) {
+  if (count == 0) {
+    return SUCCESS;
+  }
+  GE_CHK_BOOL_RET_STATUS(func != nullptr, PARAM_INVALID, "Func of parallel for is null.");
+  auto context = ge::MakeShared<ParallelForContext>();
+  GE_CHECK_NOTNULL(context);
+  context->count = count;
+  context->grain_size = std::max<size_t>(grain_size, 1);
+  context->range_num = (count + context->grain_size - 1) / context->grain_size;
+  context->func = &func;
+
+  // every helper runs ranges until none is left, a helper that starts late finds none and returns at once
+  std::call_once(start_flag_, &TaskExecutor::Start, this);
+  size_t helper_num = std::min(context->range_num - 1, threads_.size());
+  for (size_t i = 0; i < helper_num; ++i) {
+    Submit([context]() { RunRanges(*context); });
+  }
+  RunRanges(*context);
+
+  std::unique_lock<std::mutex> lock(context->mutex);
+  context->cond.wait(lock, [&context]() { return context->done_range_num.load() == context->range_num; });
+  return context->result;
+}
+}  // namespace ge
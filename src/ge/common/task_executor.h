@@ -0,0 +1,124 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_TASK_EXECUTOR_H_
+#define GE_COMMON_TASK_EXECUTOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "common/ge/ge_util.h"
+#include "common/thread_pool.h"
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/ge_inner_error_codes.h"
+
+namespace ge {
+///
+/// Worker threads shared by the builds and loads of the whole process, started on the first use.
+/// Every worker owns a deque, it runs its own tasks newest first and steals the oldest tasks of the other workers
+/// when it runs out, so tasks committed by a task stay on the worker that committed them.
+///
+class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY TaskExecutor {
+ public:
+  static TaskExecutor &Instance();
+
+  ///
+  /// @ingroup ge
+  /// @brief set the number of workers, only before they are started
+  /// @param [in] thread_num 0 for the hardware concurrency, bounded by it
+  /// @return Status result of function
+  ///
+  Status SetThreadNum(uint32_t thread_num);
+
+  uint32_t GetThreadNum() const { return thread_num_; }
+
+  ///
+  /// @ingroup ge
+  /// @brief run a task on a worker. A task must not wait for the future of another task, the workers may all be
+  ///        waiting then, use ParallelFor for nested work
+  /// @return future of the result of the task
+  ///
+  template <class Func, class... Args>
+  auto commit(Func &&func, Args &&... args) -> std::future<decltype(func(args...))> {
+    using RetType = decltype(func(args...));
+    auto bind_func = std::bind(std::forward<Func>(func), std::forward<Args>(args)...);
+    auto task = ge::MakeShared<std::packaged_task<RetType()>>(bind_func);
+    if (task == nullptr) {
+      GELOGE(MEMALLOC_FAILED, "Make shared failed.");
+      return std::future<RetType>();
+    }
+    std::future<RetType> future = task->get_future();
+    Submit([task]() { (*task)(); });
+    return future;
+  }
+
+  ///
+  /// @ingroup ge
+  /// @brief split [0, count) into ranges of grain_size and run func on them on the workers and the calling thread.
+  ///        The calling thread only runs ranges of this call, so it may be a worker itself and keeps its own state
+  /// @param [in] count number of items
+  /// @param [in] grain_size max number of items of a range, ranges of cheap items should be long
+  /// @param [in] func called with [begin, end) of every range, the ranges left are skipped after a failure
+  /// @return Status the failure of the first range that failed, SUCCESS if none
+  ///
+  Status ParallelFor(size_t count, size_t grain_size, const std::function<Status(size_t, size_t)> &func);
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<ThreadTask> tasks;
+  };
+
+  TaskExecutor() = default;
+
+  ~TaskExecutor();
+
+  TaskExecutor(const TaskExecutor &) = delete;
+  TaskExecutor &operator=(const TaskExecutor &) = delete;
+
+  void Start();
+
+  void Submit(ThreadTask &&task);
+
+  // pops the newest task of the worker or steals the oldest one of the others
+  bool PopTask(size_t index, ThreadTask &task);
+
+  void WorkerFunc(size_t index);
+
+  std::once_flag start_flag_;
+  std::atomic<bool> started_{false};
+  uint32_t thread_num_ = 0;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  // tasks in the deques, the workers sleep when it is 0
+  std::atomic<size_t> pending_num_{0};
+  std::atomic<size_t> sleeping_num_{0};
+  std::atomic<size_t> next_worker_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cond_;
+  bool stopped_ = false;
+};
+}  // namespace ge
+
+#endif  // GE_COMMON_TASK_EXECUTOR_H_
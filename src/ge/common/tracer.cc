@@ -0,0 +1,283 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/tracer.h"
+
+#include <cxxabi.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+#include "common/ge/ge_util.h"
+#include "framework/common/debug/ge_log.h"
+
+namespace ge {
+namespace {
+const size_t kMaxSummaryLogNum = 32;
+
+thread_local uint64_t thread_request_id = 0;
+
+std::atomic<uint64_t> next_request_id{1};
+
+// nearest rank percentile of the sorted durations
+uint64_t Percentile(const std::vector<uint64_t> &durations, size_t percent) {
+  return durations[(durations.size() - 1) * percent / 100];
+}
+
+void AppendJsonString(std::string &json, const char *str) {
+  json += '"';
+  for (const char *c = str; *c != '\0'; ++c) {
+    if ((*c == '"') || (*c == '\\')) {
+      json += '\\';
+      json += *c;
+    } else if (static_cast<unsigned char>(*c) < 0x20) {
+      char escaped[8] = {0};
+      (void)snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(*c));
+      json += escaped;
+    } else {
+      json += *c;
+    }
+  }
+  json += '"';
+}
+}  // namespace
+
+std::atomic<bool> Tracer::on_{false};
+
+const size_t Tracer::kDefaultCapacity;
+
+Tracer &Tracer::Instance() {
+  static Tracer instance;
+  return instance;
+}
+
+void Tracer::Start(const std::string &file, size_t capacity) {
+  std::lock_guard<std::mutex> lock(rings_mutex_);
+  file_ = file;
+  capacity_.store(std::max<size_t>(capacity, 1));
+  // rings still held by the threads are dropped as they are of an old generation
+  generation_.fetch_add(1);
+  rings_.clear();
+  thread_num_ = 0;
+  on_.store(true);
+  GELOGI("Tracer started, file:%s, capacity:%zu.", file.c_str(), capacity);
+}
+
+Status Tracer::Stop() {
+  if (!on_.exchange(false)) {
+    return SUCCESS;
+  }
+
+  std::vector<TraceStats> stats = Summarize();
+  for (size_t i = 0; (i < stats.size()) && (i < kMaxSummaryLogNum); ++i) {
+    GEEVENT("[GEPERFTRACE] %s: count %zu, total %lu, p50 %lu, p90 %lu, p99 %lu, max %lu micro second.",
+            stats[i].name.c_str(), stats[i].count, stats[i].total, stats[i].p50, stats[i].p90, stats[i].p99,
+            stats[i].max);
+  }
+  uint64_t drop_num = GetDropNum();
+  if (drop_num > 0) {
+    GELOGW("Tracer dropped %lu spans, raise the capacity to keep them.", drop_num);
+  }
+
+  std::string file;
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    file = file_;
+  }
+  if (file.empty()) {
+    return SUCCESS;
+  }
+  return Dump(file);
+}
+
+void Tracer::Record(const char *name, uint64_t start, uint64_t end) {
+  if (!IsOn() || (name == nullptr)) {
+    return;
+  }
+  Ring *ring = GetRing();
+  if (ring == nullptr) {
+    return;
+  }
+  uint64_t write_num = ring->write_num.load(std::memory_order_relaxed);
+  ring->events[write_num & ring->mask] = {name, start, end, thread_request_id, ring->thread_index};
+  ring->write_num.store(write_num + 1, std::memory_order_release);
+}
+
+Tracer::Ring *Tracer::GetRing() {
+  static thread_local std::shared_ptr<Ring> thread_ring;
+  if ((thread_ring != nullptr) && (thread_ring->generation == generation_.load(std::memory_order_relaxed))) {
+    return thread_ring.get();
+  }
+
+  auto ring = MakeShared<Ring>();
+  if (ring == nullptr) {
+    return nullptr;
+  }
+  size_t size = 2;
+  while (size < capacity_.load()) {
+    size <<= 1;
+  }
+  ring->events.reset(new (std::nothrow) TraceEvent[size]);
+  if (ring->events == nullptr) {
+    GELOGW("Malloc %zu trace events failed.", size);
+    return nullptr;
+  }
+  ring->mask = size - 1;
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    ring->generation = generation_.load();
+    ring->thread_index = thread_num_++;
+    rings_.push_back(ring);
+  }
+  thread_ring = ring;
+  return ring.get();
+}
+
+const char *Tracer::Intern(const std::string &name) {
+  std::lock_guard<std::mutex> lock(names_mutex_);
+  // nodes of the set never move
+  return names_.insert(name).first->c_str();
+}
+
+const char *Tracer::TypeName(const std::type_info &info) {
+  {
+    std::lock_guard<std::mutex> lock(names_mutex_);
+    auto iter = type_names_.find(&info);
+    if (iter != type_names_.end()) {
+      return iter->second;
+    }
+  }
+
+  int status = 0;
+  char *demangled = abi::__cxa_demangle(info.name(), nullptr, nullptr, &status);
+  std::string name = ((status == 0) && (demangled != nullptr)) ? demangled : info.name();
+  free(demangled);
+  const char *interned = Intern(name);
+  std::lock_guard<std::mutex> lock(names_mutex_);
+  type_names_[&info] = interned;
+  return interned;
+}
+
+std::vector<TraceEvent> Tracer::Collect() const {
+  std::vector<std::shared_ptr<Ring>> rings;
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings = rings_;
+  }
+
+  std::vector<TraceEvent> events;
+  for (const auto &ring : rings) {
+    uint64_t size = ring->mask + 1;
+    uint64_t end = ring->write_num.load(std::memory_order_acquire);
+    uint64_t begin = (end > size) ? (end - size) : 0;
+    std::vector<TraceEvent> ring_events;
+    ring_events.reserve(end - begin);
+    for (uint64_t i = begin; i < end; ++i) {
+      ring_events.push_back(ring->events[i & ring->mask]);
+    }
+    // the owner may have overwritten the oldest ones while they were copied
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t latest = ring->write_num.load(std::memory_order_relaxed);
+    uint64_t valid_begin = (latest + 1 > size) ? (latest + 1 - size) : 0;
+    for (uint64_t i = std::max(begin, valid_begin); i < end; ++i) {
+      events.push_back(ring_events[i - begin]);
+    }
+  }
+  std::sort(events.begin(), events.end(),
+            [](const TraceEvent &lhs, const TraceEvent &rhs) { return lhs.start < rhs.start; });
+  return events;
+}
+
+std::vector<TraceStats> Tracer::Summarize() const {
+  std::map<std::string, std::vector<uint64_t>> name_durations;
+  for (const auto &event : Collect()) {
+    name_durations[event.name].push_back((event.end > event.start) ? (event.end - event.start) : 0);
+  }
+
+  std::vector<TraceStats> stats;
+  for (auto &name_duration : name_durations) {
+    std::vector<uint64_t> &durations = name_duration.second;
+    std::sort(durations.begin(), durations.end());
+    uint64_t total = 0;
+    for (uint64_t duration : durations) {
+      total += duration;
+    }
+    stats.push_back({name_duration.first, durations.size(), total, Percentile(durations, 50),
+                     Percentile(durations, 90), Percentile(durations, 99), durations.back()});
+  }
+  std::stable_sort(stats.begin(), stats.end(),
+                   [](const TraceStats &lhs, const TraceStats &rhs) { return lhs.total > rhs.total; });
+  return stats;
+}
+
+Status Tracer::Dump(const std::string &file) const {
+  std::vector<TraceEvent> events = Collect();
+  std::string json = "{\"traceEvents\":[";
+  std::string pid = std::to_string(getpid());
+  for (size_t i = 0; i < events.size(); ++i) {
+    const TraceEvent &event = events[i];
+    json += (i == 0) ? "\n{\"name\":" : ",\n{\"name\":";
+    AppendJsonString(json, event.name);
+    json += ",\"cat\":\"ge\",\"ph\":\"X\",\"pid\":" + pid + ",\"tid\":" + std::to_string(event.thread_index) +
+            ",\"ts\":" + std::to_string(event.start) +
+            ",\"dur\":" + std::to_string((event.end > event.start) ? (event.end - event.start) : 0) +
+            ",\"args\":{\"request\":" + std::to_string(event.request_id) + "}}";
+  }
+  json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  std::ofstream out(file, std::ios::out | std::ios::trunc);
+  if (!out.is_open()) {
+    GELOGE(FAILED, "Open trace file %s failed.", file.c_str());
+    return FAILED;
+  }
+  out << json;
+  out.close();
+  if (out.fail()) {
+    GELOGE(FAILED, "Write trace file %s failed.", file.c_str());
+    return FAILED;
+  }
+  GELOGI("Write %zu spans to trace file %s.", events.size(), file.c_str());
+  return SUCCESS;
+}
+
+uint64_t Tracer::GetDropNum() const {
+  std::lock_guard<std::mutex> lock(rings_mutex_);
+  uint64_t drop_num = 0;
+  for (const auto &ring : rings_) {
+    uint64_t write_num = ring->write_num.load();
+    drop_num += (write_num > ring->mask + 1) ? (write_num - ring->mask - 1) : 0;
+  }
+  return drop_num;
+}
+
+uint64_t Tracer::NewRequestId() { return next_request_id.fetch_add(1); }
+
+uint64_t Tracer::GetRequestId() { return thread_request_id; }
+
+void Tracer::SetRequestId(uint64_t request_id) { thread_request_id = request_id; }
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY bool IsTraceOn() { return Tracer::IsOn(); }
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY uint64_t TraceStage(const char *name, uint64_t start) {
+  uint64_t end = GetCurrentTimestap();
+  Tracer::Instance().Record(name, start, end);
+  return (end > start) ? (end - start) : 0;
+}
+}  // namespace ge
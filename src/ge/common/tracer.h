@@ -0,0 +1,227 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_TRACER_H_
+#define GE_COMMON_TRACER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_set>
+#include <vector>
+
+#include "framework/common/fmk_types.h"
+#include "framework/common/ge_inner_error_codes.h"
+#include "framework/common/util.h"
+
+namespace ge {
+// a span of a stage, times are in us as GetCurrentTimestap
+struct TraceEvent {
+  const char *name;
+  uint64_t start;
+  uint64_t end;
+  // request the stage ran for, 0 if none
+  uint64_t request_id;
+  // index of the thread that recorded it
+  uint32_t thread_index;
+};
+
+struct TraceStats {
+  std::string name;
+  size_t count;
+  // durations in us
+  uint64_t total;
+  uint64_t p50;
+  uint64_t p90;
+  uint64_t p99;
+  uint64_t max;
+};
+
+///
+/// Records the spans of the stages into per thread rings, nothing is shared on the recording path.
+/// A ring keeps the newest spans of its thread, the older ones are overwritten and counted as dropped.
+/// When it is off a span costs a relaxed load, the spans are written as chrome trace events when it stops.
+///
+class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Tracer {
+ public:
+  static Tracer &Instance();
+
+  static bool IsOn() { return on_.load(std::memory_order_relaxed); }
+
+  ///
+  /// @ingroup ge
+  /// @brief start tracing, the spans recorded before are cleared
+  /// @param [in] file chrome trace file written when it stops, empty not to write one
+  /// @param [in] capacity spans a thread keeps, rounded up to a power of 2
+  ///
+  void Start(const std::string &file, size_t capacity = kDefaultCapacity);
+
+  ///
+  /// @ingroup ge
+  /// @brief stop tracing, log the summary of the stages and write the trace file
+  /// @return Status result of function
+  ///
+  Status Stop();
+
+  ///
+  /// @ingroup ge
+  /// @brief record a span of the calling thread under its current request
+  /// @param [in] name name of the stage, must outlive the tracer, see Intern
+  ///
+  void Record(const char *name, uint64_t start, uint64_t end);
+
+  ///
+  /// @ingroup ge
+  /// @brief name kept by the tracer, for the names built at runtime
+  ///
+  const char *Intern(const std::string &name);
+
+  ///
+  /// @ingroup ge
+  /// @brief demangled name of a type, such as the class of a pass
+  ///
+  const char *TypeName(const std::type_info &info);
+
+  ///
+  /// @ingroup ge
+  /// @brief spans of all threads ordered by start, spans being overwritten meanwhile are skipped
+  ///
+  std::vector<TraceEvent> Collect() const;
+
+  ///
+  /// @ingroup ge
+  /// @brief duration percentiles of every stage, ordered by the total time
+  ///
+  std::vector<TraceStats> Summarize() const;
+
+  ///
+  /// @ingroup ge
+  /// @brief write the spans as chrome trace event json
+  /// @return Status result of function
+  ///
+  Status Dump(const std::string &file) const;
+
+  // spans overwritten before they were collected
+  uint64_t GetDropNum() const;
+
+  static uint64_t NewRequestId();
+
+  static uint64_t GetRequestId();
+
+  static void SetRequestId(uint64_t request_id);
+
+  Tracer(const Tracer &) = delete;
+  Tracer &operator=(const Tracer &) = delete;
+
+  static const size_t kDefaultCapacity = 16384;
+
+ private:
+  // written by its thread only
+  struct Ring {
+    uint32_t thread_index = 0;
+    uint64_t generation = 0;
+    size_t mask = 0;
+    std::unique_ptr<TraceEvent[]> events;
+    // spans written ever, the newest mask + 1 of them are kept
+    std::atomic<uint64_t> write_num{0};
+  };
+
+  Tracer() = default;
+
+  ~Tracer() = default;
+
+  // ring of the calling thread for the current generation
+  Ring *GetRing();
+
+  static std::atomic<bool> on_;
+
+  std::string file_;
+  std::atomic<size_t> capacity_{kDefaultCapacity};
+  // bumped by Start, the threads take new rings then
+  std::atomic<uint64_t> generation_{0};
+
+  mutable std::mutex rings_mutex_;
+  std::vector<std::shared_ptr<Ring>> rings_;
+  uint32_t thread_num_ = 0;
+
+  std::mutex names_mutex_;
+  std::unordered_set<std::string> names_;
+  std::map<const std::type_info *, const char *> type_names_;
+};
+
+///
+/// Records the span of its scope if tracing is on when it is created.
+///
+class TraceScope {
+ public:
+  explicit TraceScope(const char *name) : name_(Tracer::IsOn() ? name : nullptr) { Begin(); }
+
+  explicit TraceScope(const std::string &name)
+      : name_(Tracer::IsOn() ? Tracer::Instance().Intern(name) : nullptr) {
+    Begin();
+  }
+
+  explicit TraceScope(const std::type_info &info)
+      : name_(Tracer::IsOn() ? Tracer::Instance().TypeName(info) : nullptr) {
+    Begin();
+  }
+
+  ~TraceScope() {
+    if (name_ != nullptr) {
+      Tracer::Instance().Record(name_, start_, GetCurrentTimestap());
+    }
+  }
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+ private:
+  void Begin() { start_ = (name_ != nullptr) ? GetCurrentTimestap() : 0; }
+
+  const char *name_;
+  uint64_t start_ = 0;
+};
+
+///
+/// Sets the request of the spans the calling thread records in its scope.
+///
+class TraceRequestScope {
+ public:
+  explicit TraceRequestScope(uint64_t request_id) : last_request_id_(Tracer::GetRequestId()) {
+    Tracer::SetRequestId(request_id);
+  }
+
+  ~TraceRequestScope() { Tracer::SetRequestId(last_request_id_); }
+
+  TraceRequestScope(const TraceRequestScope &) = delete;
+  TraceRequestScope &operator=(const TraceRequestScope &) = delete;
+
+ private:
+  uint64_t last_request_id_;
+};
+}  // namespace ge
+
+#define GE_TRACE_CONCAT_INNER(a, b) a##b
+#define GE_TRACE_CONCAT(a, b) GE_TRACE_CONCAT_INNER(a, b)
+
+// span of the rest of the scope, named by a string literal, a std::string or a type_info
+#define GE_TRACE_SCOPE(name) ge::TraceScope GE_TRACE_CONCAT(trace_scope_, __LINE__)(name)
+
+#endif  // GE_COMMON_TRACER_H_
@@ -348,12 +348,10 @@ Status GeExecutor::LoadDataFromFile(const std::string &path, ModelData &model_da
   GELOGI("load model_data from file: %s.", path.c_str());
   std::string key_path;
   int32_t priority = 0;
+  // the caller owns the model data and releases it with delete[], so it is read to the heap
   Status ret = GraphLoader::LoadDataFromFile(path, key_path, priority, model_data);
   if (ret != SUCCESS) {
-    if (model_data.model_data != nullptr) {
-      delete[] static_cast<char *>(model_data.model_data);
-      model_data.model_data = nullptr;
-    }
+    DavinciModelParser::FreeModelData(model_data);
   }
 
   return ret;
@@ -426,7 +424,8 @@ Status GeExecutor::ExecModel(uint32_t model_id, void *stream, const ge::RunModel
 Status GeExecutor::GetMemAndWeightSize(const std::string &path, size_t &mem_size, size_t &weight_size) {
   ModelData model;
   std::string key;
-  Status ret = ge::GraphLoader::LoadDataFromFile(path, key, 0, model);
+  // only the header and the task partition are read, the weights pages of the mapping are never touched
+  Status ret = ge::GraphLoader::LoadDataFromFile(path, key, 0, model, true);
   if ((ret != SUCCESS) || (model.model_data == nullptr)) {
     GELOGE(ret, "Load data from file failed. ret = %d", ret);
     return ret;
@@ -434,8 +433,7 @@ Status GeExecutor::GetMemAndWeightSize(const std::string &path, size_t &mem_size
 
   ret = ge::ModelManager::GetModelMemAndWeightSize(model, mem_size, weight_size);
 
-  delete[] static_cast<char *>(model.model_data);
-  model.model_data = nullptr;
+  DavinciModelParser::FreeModelData(model);
 
   return ret;
 }
@@ -120,7 +120,13 @@ string MemoryBlock::String() {
 }
 
 BlockMemAssigner::BlockMemAssigner(ge::ComputeGraphPtr compute_graph)
-    : mem_offset_(0), compute_graph_(std::move(compute_graph)) {}
+    : mem_offset_(0), compute_graph_(std::move(compute_graph)), ge_disable_reuse_mem_env_("0") {
+  (void)ge::GetContext().GetOption(kDisableReuseMemory, ge_disable_reuse_mem_env_);
+  if (compute_graph_ != nullptr) {
+    auto direct_nodes = compute_graph_->GetDirectNode();
+    nodes_.assign(direct_nodes.begin(), direct_nodes.end());
+  }
+}
 
 BlockMemAssigner::~BlockMemAssigner() {
   for (MemoryBlock *memory_block : memory_blocks_) {
@@ -131,7 +137,7 @@ BlockMemAssigner::~BlockMemAssigner() {
 void BlockMemAssigner::GetOutAndWorkSpaceMem(vector<int64_t> &all_memory_size) {
   vector<int64_t> temp;
 
-  for (const NodePtr &n : compute_graph_->GetDirectNode()) {
+  for (const NodePtr &n : nodes_) {
     auto node_op_desc = n->GetOpDesc();
     GE_IF_BOOL_EXEC(node_op_desc == nullptr, continue);
     for (const auto &output_desc : node_op_desc->GetAllOutputsDescPtr()) {
@@ -240,63 +246,69 @@ bool CanReuseByStream(const std::unordered_set<int64_t> &reuse_stream, MemoryBlo
   return can_reuse;
 }
 
+bool BlockMemAssigner::IsReuseMemory(const NodePtr &n, uint32_t out_index,
+                                     const vector<bool> &workspace_reuse_flag) const {
+  GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(n == nullptr, return false, "Input parameter n is null.");
+  auto node_op_desc = n->GetOpDesc();
+  GE_IF_BOOL_EXEC(node_op_desc == nullptr, return false);
+  if (ge_disable_reuse_mem_env_ == "1") {
+    return false;
+  }
+  if ((workspace_reuse_flag.size() > out_index) && (workspace_reuse_flag[out_index] == false)) {
+    return false;
+  }
+  int64_t convergence_label;
+  if (ge::AttrUtils::GetInt(node_op_desc, kL2FusionDynamicConvergeOp, convergence_label)) {
+    return false;
+  }
+  if (static_cast<size_t>(out_index) >= n->GetAllOutDataAnchors().size()) {
+    return false;
+  }
+  bool out_flg = false;
+  GE_IF_BOOL_EXEC(n->GetOutDataNodes().empty(), out_flg = true);
+  for (auto in_anchor : n->GetOutDataAnchor(out_index)->GetPeerInDataAnchors()) {
+    if (IsDirectOutputNode(in_anchor->GetOwnerNode(), in_anchor->GetIdx())) {
+      out_flg = true;
+    }
+    break;
+  }
+  auto op_type = node_op_desc->GetType();
+  return !out_flg && (op_type != DATA_TYPE) && (op_type != AIPP_DATA_TYPE) && (op_type != CONSTANT) &&
+      (op_type != NETOUTPUT) && (op_type != PROPOSAL) && (op_type != ANN_DATA_TYPE) && (op_type != ZEROSLIKE) &&
+      (op_type != CONSTANTOP);
+}
+
 MemoryBlock *BlockMemAssigner::ApplyMemory(size_t block_size, size_t real_size, MemoryType mem_type, const NodePtr &n,
                                            uint32_t out_index, const vector<bool> &workspace_reuse_flag) {
   GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(n == nullptr, return nullptr, "Input parameter n is null.");
   auto node_op_desc = n->GetOpDesc();
   GE_IF_BOOL_EXEC(node_op_desc == nullptr, return nullptr);
 
-  string ge_disable_reuse_mem_env = "0";
-  (void)ge::GetContext().GetOption(kDisableReuseMemory, ge_disable_reuse_mem_env);
-  if (ge_disable_reuse_mem_env != "1") {
-    int64_t convergence_label;
-    bool reuse_mem_flag = true;
-    if ((workspace_reuse_flag.size() > out_index) && (workspace_reuse_flag[out_index] == false)) {
-      reuse_mem_flag = false;
-    }
-    if (!ge::AttrUtils::GetInt(node_op_desc, kL2FusionDynamicConvergeOp, convergence_label)) {
-      bool out_flg = false;
-      GE_IF_BOOL_EXEC(n->GetOutDataNodes().empty(), out_flg = true);
-      if (static_cast<size_t>(out_index) < n->GetAllOutDataAnchors().size()) {
-        for (auto in_anchor : n->GetOutDataAnchor(out_index)->GetPeerInDataAnchors()) {
-          if (IsDirectOutputNode(in_anchor->GetOwnerNode(), in_anchor->GetIdx())) {
-            out_flg = true;
-            break;
-          } else {
-            break;
-          }
+  if (IsReuseMemory(n, out_index, workspace_reuse_flag)) {
+    auto stream_id = node_op_desc->GetStreamId();
+    auto map_iter = reusable_streams_map_.find(stream_id);
+    if (map_iter != reusable_streams_map_.end()) {
+      for (auto it = reusable_blocks_.begin(); it != reusable_blocks_.end(); ++it) {
+        MemoryBlock *reusable_block = *it;
+        bool is_data = false;
+        for (auto node_type : reusable_block->NodeTypeIndexList()) {
+          GE_IF_BOOL_EXEC(node_type.node_ != nullptr, string type = node_type.node_->GetType();
+                          bool flag = (type == DATA_TYPE) || (type == ENTER) || (type == REFENTER) ||
+                              (type == AIPP_DATA_TYPE) || (type == NEXTITERATION) || (type == REFNEXTITERATION);
+                          GE_IF_BOOL_EXEC(flag, is_data = true; break;););
         }
-        auto op_type = node_op_desc->GetType();
-        bool is_reuse_memory = !out_flg && reuse_mem_flag && (op_type != DATA_TYPE) && (op_type != AIPP_DATA_TYPE) &&
-            (op_type != CONSTANT) && (op_type != NETOUTPUT) && (op_type != PROPOSAL) &&
-            (op_type != ANN_DATA_TYPE) && (op_type != ZEROSLIKE) && (op_type != CONSTANTOP);
-        auto stream_id = node_op_desc->GetStreamId();
-        auto map_iter = reusable_streams_map_.find(stream_id);
-        if (is_reuse_memory && map_iter != reusable_streams_map_.end()) {
-          for (auto it = reusable_blocks_.begin(); it != reusable_blocks_.end(); ++it) {
-            MemoryBlock *reusable_block = *it;
-            bool is_data = false;
-            for (auto node_type : reusable_block->NodeTypeIndexList()) {
-              GE_IF_BOOL_EXEC(node_type.node_ != nullptr, string type = node_type.node_->GetType();
-                  bool flag = (type == DATA_TYPE) || (type == ENTER) || (type == REFENTER) ||
-                      (type == AIPP_DATA_TYPE) || (type == NEXTITERATION) ||
-                      (type == REFNEXTITERATION);
-                  GE_IF_BOOL_EXEC(flag, is_data = true; break;););
-            }
-            GE_IF_BOOL_EXEC(is_data == true, continue);
-
-            // A node can reuse blocks of the same stream and preorder streams
-            if (CanReuseBySize(reusable_block_counts_, *reusable_block, block_size) &&
-                CanReuseByStream(map_iter->second, *reusable_block)) {
-              GELOGD("Cross stream mem reuse, target stream:%ld, current stream:%ld", reusable_block->stream_id_,
-                     stream_id);
-              reusable_block->AddNodeTypeIndex({n, mem_type, out_index}, real_size);
-              reusable_block->ref_count_++;
-              ReduceReusableBlockCount(*reusable_block, reusable_block_counts_);
-              reusable_blocks_.erase(it);
-              return reusable_block;
-            }
-          }
+        GE_IF_BOOL_EXEC(is_data == true, continue);
+
+        // A node can reuse blocks of the same stream and preorder streams
+        if (CanReuseBySize(reusable_block_counts_, *reusable_block, block_size) &&
+            CanReuseByStream(map_iter->second, *reusable_block)) {
+          GELOGD("Cross stream mem reuse, target stream:%ld, current stream:%ld", reusable_block->stream_id_,
+                 stream_id);
+          reusable_block->AddNodeTypeIndex({n, mem_type, out_index}, real_size);
+          reusable_block->ref_count_++;
+          ReduceReusableBlockCount(*reusable_block, reusable_block_counts_);
+          reusable_blocks_.erase(it);
+          return reusable_block;
         }
       }
     }
@@ -468,8 +480,7 @@ void BlockMemAssigner::ReleaseInputNodeOutMemory(const NodePtr &n,
 void BlockMemAssigner::AssignMemoryWithReuse(vector<int64_t> &ranges) {
   // Init reusable streams map
   InitReusableStreamMap();
-  string ge_disable_reuse_mem_env = "0";
-  (void)ge::GetContext().GetOption("ge.exec.disableReuseMemory", ge_disable_reuse_mem_env);
+  const string &ge_disable_reuse_mem_env = ge_disable_reuse_mem_env_;
 
   if (ge_disable_reuse_mem_env == "1") {
     GEEVENT("Reuse memory close");
@@ -477,7 +488,7 @@ void BlockMemAssigner::AssignMemoryWithReuse(vector<int64_t> &ranges) {
     GEEVENT("Reuse memory open");
   }
 
-  for (const NodePtr &n : compute_graph_->GetDirectNode()) {
+  for (const NodePtr &n : nodes_) {
     auto node_op_desc = n->GetOpDesc();
     GE_IF_BOOL_EXEC(node_op_desc == nullptr, continue);
     int64_t stream_id = node_op_desc->GetStreamId();
@@ -732,7 +743,7 @@ void BlockMemAssigner::InitReusableStreamMap() {
 
 void BlockMemAssigner::FindHeadAndTailNodesForStream(map<int64_t, pair<NodePtr, NodePtr>> &stream_head_tail_node_map,
                                                      unordered_map<int64_t, int64_t> &stream_mem_map) {
-  for (const auto &n : compute_graph_->GetDirectNode()) {
+  for (const auto &n : nodes_) {
     GE_IF_BOOL_EXEC(n->GetOpDesc() == nullptr, GELOGW("Op desc is nullptr"); continue);
     auto stream_id = n->GetOpDesc()->GetStreamId();
     // traverse to find streams's first and last node.
@@ -125,7 +125,7 @@ class BlockMemAssigner : public MemAssigner {
   /// @param [in] ranges memory range provided
   /// @author
   ///
-  void AssignMemoryWithReuse(std::vector<int64_t> &ranges);
+  virtual void AssignMemoryWithReuse(std::vector<int64_t> &ranges);
 
   void SetOpMemOffset();
 
@@ -181,14 +181,35 @@ class BlockMemAssigner : public MemAssigner {
   ///
   bool CheckIsZeroMemNodeType(const std::string &node_type) const;
 
+  ///
+  /// @ingroup GE
+  /// @brief Determine whether the output or workspace may be placed in memory released by other ops.
+  /// @param [in] n node in compute_graph_
+  /// @param [in] out_index output or workspace index
+  /// @param [in] workspace_reuse_flag reuse flag for workspace
+  /// @return bool true: may reuse released memory; false: needs memory of its own
+  /// @author
+  ///
+  bool IsReuseMemory(const ge::NodePtr &n, uint32_t out_index, const std::vector<bool> &workspace_reuse_flag) const;
+
   size_t mem_offset_;
 
   ge::ComputeGraphPtr compute_graph_;
 
+  // direct nodes of compute_graph_ when the assigner is created, the assigners of HybridMemAssigner run on
+  // workers and only walk their own copy
+  std::vector<ge::NodePtr> nodes_;
+
   std::vector<MemoryBlock *> memory_blocks_;
 
   std::vector<NodeTypeIndex> zero_memory_list_;
 
+  // save stream_id and reusable stream_ids
+  std::unordered_map<int64_t, std::unordered_set<int64_t>> reusable_streams_map_;
+
+  // value of ge.exec.disableReuseMemory, read when the assigner is created since options are thread local
+  std::string ge_disable_reuse_mem_env_;
+
  private:
   ///
   /// @ingroup GE
@@ -264,9 +285,10 @@ class BlockMemAssigner : public MemAssigner {
   std::unordered_map<int64_t, std::vector<MemoryBlock *>> stream_workspace_blocks_;
 
   std::unordered_map<std::string, std::vector<MemoryBlock *>> node_out_blocks_;
-
-  // save stream_id and reusable stream_ids
-  std::unordered_map<int64_t, std::unordered_set<int64_t>> reusable_streams_map_;
 };
+
+bool IsDirectOutputNode(const NodePtr &node, int idx);
+
+bool IsOutputBlock(const ge::InDataAnchorPtr &in_data_anchor);
 }  // namespace ge
 #endif  // GE_GRAPH_BUILD_MEMORY_BLOCK_MEM_ASSIGNER_H_
@@ -16,11 +16,14 @@
 
 #include "graph/build/memory/hybrid_mem_assigner.h"
 
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "common/task_executor.h"
 #include "framework/common/debug/ge_log.h"
 #include "graph/build/memory/binary_block_mem_assigner.h"
+#include "graph/build/memory/lifetime_mem_assigner.h"
 #include "graph/build/memory/max_block_mem_assigner.h"
 
 namespace ge {
@@ -43,31 +46,44 @@ Status HybridMemAssigner::AssignMemory(std::unique_ptr<BlockMemAssigner> &block_
 }
 
 Status HybridMemAssigner::Assign() {
-  std::unique_ptr<BlockMemAssigner> binary_assigner(new (std::nothrow) BinaryBlockMemAssigner(compute_graph_));
-  GE_CHECK_NOTNULL(binary_assigner);
-
-  std::unique_ptr<BlockMemAssigner> max_assigner(new (std::nothrow) MaxBlockMemAssigner(compute_graph_));
-  GE_CHECK_NOTNULL(max_assigner);
-
-  size_t bin_mem_size = 0;
-  size_t max_mem_size = 0;
-
-  GE_CHK_STATUS_RET(AssignMemory(binary_assigner, bin_mem_size), "BinaryBlock Method AssignMemory Fail!");
-  GE_CHK_STATUS_RET(AssignMemory(max_assigner, max_mem_size), "MaxBlock Method AssignMemory Fail!");
+  // The assigners are created on the calling thread, they read the session options which are thread local
+  std::vector<std::pair<std::string, std::unique_ptr<BlockMemAssigner>>> assigners;
+  assigners.emplace_back("binary-block",
+                         std::unique_ptr<BlockMemAssigner>(new (std::nothrow) BinaryBlockMemAssigner(compute_graph_)));
+  assigners.emplace_back("max-block",
+                         std::unique_ptr<BlockMemAssigner>(new (std::nothrow) MaxBlockMemAssigner(compute_graph_)));
+  assigners.emplace_back("lifetime",
+                         std::unique_ptr<BlockMemAssigner>(new (std::nothrow) LifetimeMemAssigner(compute_graph_)));
+  for (const auto &assigner : assigners) {
+    GE_CHECK_NOTNULL(assigner.second);
+  }
 
-  std::unique_ptr<BlockMemAssigner> priority_assigner;
+  // Every assigner walks the copy of the nodes it made when created, so they run on the workers together
+  std::vector<size_t> mem_sizes(assigners.size(), 0);
+  std::vector<Status> rets(assigners.size(), SUCCESS);
+  auto assign_func = [&assigners, &mem_sizes, &rets, this](size_t begin, size_t end) -> Status {
+    for (size_t i = begin; i < end; ++i) {
+      rets[i] = AssignMemory(assigners[i].second, mem_sizes[i]);
+    }
+    return SUCCESS;
+  };
+  (void)TaskExecutor::Instance().ParallelFor(assigners.size(), 1, assign_func);
 
-  GELOGI("Binary-block memory size:%zu, max-block memory size:%zu", bin_mem_size, max_mem_size);
-  if (bin_mem_size <= max_mem_size) {
-    GELOGI("Use binary-block memory assigner method");
-    priority_assigner = std::move(binary_assigner);
-  } else {
-    GELOGI("Use max-block memory assigner method");
-    priority_assigner = std::move(max_assigner);
+  size_t priority = 0;
+  for (size_t i = 0; i < assigners.size(); ++i) {
+    if (rets[i] != SUCCESS) {
+      GELOGE(rets[i], "%s method AssignMemory fail!", assigners[i].first.c_str());
+      return rets[i];
+    }
+    GEEVENT("Feature map memory size of %s assigner:%zu", assigners[i].first.c_str(), mem_sizes[i]);
+    if (mem_sizes[i] < mem_sizes[priority]) {
+      priority = i;
+    }
   }
 
-  priority_assigner->SetOpMemOffset();
-  mem_offset_ = priority_assigner->GetMemOffset();
+  GELOGI("Use %s memory assigner method", assigners[priority].first.c_str());
+  assigners[priority].second->SetOpMemOffset();
+  mem_offset_ = assigners[priority].second->GetMemOffset();
   return SUCCESS;
 }
 }  // namespace ge
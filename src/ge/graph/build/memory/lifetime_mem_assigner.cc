@@ -0,0 +1,306 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/build/memory/lifetime_mem_assigner.h"
+
+#include <algorithm>
+
+#include "framework/common/debug/ge_log.h"
+#include "graph/debug/ge_attr_define.h"
+#include "graph/utils/tensor_utils.h"
+
+namespace {
+const char *const kAttrNameWorkspaceReuseFlag = "workspace_reuse_flag";
+}  // namespace
+
+namespace ge {
+Status LifetimeMemAssigner::GetMemoryRanges(std::vector<int64_t> &ranges) {
+  std::vector<int64_t> all_memory_size;
+
+  GetOutAndWorkSpaceMem(all_memory_size);
+
+  // Lifetimes are packed with their own sizes, the range only tells whether there is anything to assign
+  auto it = std::max_element(std::begin(all_memory_size), std::end(all_memory_size));
+  if (it != std::end(all_memory_size)) {
+    ranges.emplace_back(*it);
+  }
+  return SUCCESS;
+}
+
+void LifetimeMemAssigner::AssignMemoryWithReuse(std::vector<int64_t> &ranges) {
+  (void)ranges;
+  InitReusableStreamMap();
+  ComputeLifetimes();
+  PlaceLifetimes();
+
+  GELOGI("Lifetime memory assigner placed %zu tensors of %zu ops, memory size:%zu", lifetimes_.size(),
+         node_steps_.size(), mem_offset_);
+  GELOGD("Assigned memory blocks:");
+  for (auto mem_block : memory_blocks_) {
+    GELOGD("%s", mem_block->String().c_str());
+    (void)mem_block;  // Fix warning
+  }
+}
+
+void LifetimeMemAssigner::ComputeLifetimes() {
+  size_t step = 0;
+  for (const NodePtr &n : nodes_) {
+    node_steps_[n.get()] = step++;
+  }
+
+  for (const NodePtr &n : nodes_) {
+    auto node_op_desc = n->GetOpDesc();
+    GE_IF_BOOL_EXEC(node_op_desc == nullptr, continue);
+    for (uint32_t i = 0; i < static_cast<uint32_t>(node_op_desc->GetOutputsSize()); i++) {
+      uint32_t size = 0;
+      auto output_op_desc = node_op_desc->GetOutputDescPtr(i);
+      if (output_op_desc != nullptr) {
+        GE_IF_BOOL_EXEC(ge::TensorUtils::GetSize(*output_op_desc, size) != SUCCESS, GELOGI("Get size failed"));
+      }
+      if ((size == 0) || CheckIsZeroMemNodeType(n->GetType())) {
+        zero_memory_list_.emplace_back(n, kOutput, i);
+        continue;
+      }
+      AddOutputLifetime(n, i, size);
+    }
+    AddWorkspaceLifetimes(n);
+  }
+}
+
+void LifetimeMemAssigner::AddOutputLifetime(const NodePtr &n, uint32_t index, size_t size) {
+  bool reuse_input = false;
+  uint32_t reuse_input_index = 0;
+  auto output_op_desc = n->GetOpDesc()->GetOutputDescPtr(index);
+  if (output_op_desc != nullptr) {
+    GE_IF_BOOL_EXEC(ge::TensorUtils::GetReuseInput(*output_op_desc, reuse_input) != SUCCESS,
+                    GELOGI("Get reuse_input failed"));
+    GE_IF_BOOL_EXEC(ge::TensorUtils::GetReuseInputIndex(*output_op_desc, reuse_input_index) != SUCCESS,
+                    GELOGI("Get reuse_input_index failed"));
+  }
+
+  size_t lifetime_index = lifetimes_.size();
+  if (reuse_input) {
+    // The output lives in the memory of the input it reuses, so the two share one lifetime
+    auto in_data_anchor = n->GetInDataAnchor(reuse_input_index);
+    GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(in_data_anchor == nullptr, return, "In data anchor is null.");
+    auto peer_out_anchor = in_data_anchor->GetPeerOutAnchor();
+    GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(peer_out_anchor == nullptr, return, "Peer out data anchor is null.");
+    auto iter = out_lifetimes_.find(
+        std::make_pair(peer_out_anchor->GetOwnerNode().get(), static_cast<uint32_t>(peer_out_anchor->GetIdx())));
+    GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(iter == out_lifetimes_.end(), return,
+                                   "Output %u of node %s reuses an input without memory.", index,
+                                   n->GetName().c_str());
+    lifetime_index = iter->second;
+    lifetimes_[lifetime_index].block->AddNodeTypeIndex({n, kOutput, index}, size);
+  } else {
+    vector<bool> workspace_reuse_flag;
+    GE_IF_BOOL_EXEC(!NewLifetime(n, kOutput, index, size, IsReuseMemory(n, index, workspace_reuse_flag)), return);
+  }
+  out_lifetimes_[std::make_pair(n.get(), index)] = lifetime_index;
+  UpdateLastStep(n, index, lifetimes_[lifetime_index]);
+}
+
+void LifetimeMemAssigner::AddWorkspaceLifetimes(const NodePtr &n) {
+  vector<int64_t> workspace_memory;
+  GetNodeWorkSpaceSize(n, workspace_memory);
+  if (workspace_memory.empty()) {
+    return;
+  }
+  vector<bool> workspace_reuse_flag;
+  GE_IF_BOOL_EXEC(!ge::AttrUtils::GetListBool(n->GetOpDesc(), kAttrNameWorkspaceReuseFlag, workspace_reuse_flag),
+                  GELOGD("OP %s get workspace_reuse_flag attr failed", n->GetName().c_str()));
+  for (size_t i = 0; i < workspace_memory.size(); i++) {
+    if (workspace_memory[i] == 0) {
+      zero_memory_list_.emplace_back(n, kWorkspace, static_cast<uint32_t>(i));
+      continue;
+    }
+    auto index = static_cast<uint32_t>(i);
+    GE_IF_BOOL_EXEC(!NewLifetime(n, kWorkspace, index, static_cast<size_t>(workspace_memory[i]),
+                                 IsReuseMemory(n, index, workspace_reuse_flag)),
+                    return);
+  }
+}
+
+bool LifetimeMemAssigner::NewLifetime(const NodePtr &n, MemoryType mem_type, uint32_t index, size_t size,
+                                      bool reuse_released) {
+  auto block = new (std::nothrow) MemoryBlock(size);
+  GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(block == nullptr, return false, "new an object failed.");
+  block->Init(size, mem_type, n, index);
+  block->stream_id_ = n->GetOpDesc()->GetStreamId();
+  memory_blocks_.emplace_back(block);
+
+  size_t step = node_steps_[n.get()];
+  lifetimes_.push_back({step, step, block->stream_id_, reuse_released, false, block});
+  return true;
+}
+
+void LifetimeMemAssigner::UpdateLastStep(const NodePtr &n, uint32_t index, TensorLifetime &lifetime) {
+  const string &type = n->GetType();
+  if ((type == DATA_TYPE) || (type == ENTER) || (type == REFENTER) || (type == AIPP_DATA_TYPE) ||
+      (type == NEXTITERATION) || (type == REFNEXTITERATION) || (type == CONSTANT) || (type == FASTRCNNPREDICTIONS) ||
+      (type == CONSTANTOP)) {
+    lifetime.keep_alive = true;
+    return;
+  }
+  auto out_data_anchor = n->GetOutDataAnchor(index);
+  if ((out_data_anchor == nullptr) || out_data_anchor->GetPeerInDataAnchors().empty()) {
+    lifetime.keep_alive = true;
+    return;
+  }
+  for (const auto &in_anchor : out_data_anchor->GetPeerInDataAnchors()) {
+    auto owner_node = in_anchor->GetOwnerNode();
+    auto iter = node_steps_.find(owner_node.get());
+    // Memory read by another stream is never released, the streams are not synchronized on it
+    if ((iter == node_steps_.end()) || (owner_node->GetOpDesc() == nullptr) ||
+        (owner_node->GetOpDesc()->GetStreamId() != lifetime.stream_id) || IsOutputBlock(in_anchor)) {
+      lifetime.keep_alive = true;
+      return;
+    }
+    lifetime.last_step = std::max(lifetime.last_step, iter->second);
+  }
+}
+
+bool LifetimeMemAssigner::CanShareMemory(const TensorLifetime &left, const TensorLifetime &right) const {
+  const TensorLifetime &prior = (left.first_step <= right.first_step) ? left : right;
+  const TensorLifetime &later = (left.first_step <= right.first_step) ? right : left;
+  if (prior.keep_alive || (later.first_step <= prior.last_step) || !later.reuse_released) {
+    return false;
+  }
+  return CanReuseStream(later.stream_id, prior.stream_id);
+}
+
+bool LifetimeMemAssigner::CanReuseStream(int64_t stream_id, int64_t prior_stream_id) const {
+  if (stream_id == prior_stream_id) {
+    return true;
+  }
+  // A node can reuse memory released by the same stream and preorder streams
+  auto map_iter = reusable_streams_map_.find(stream_id);
+  return (map_iter != reusable_streams_map_.end()) && (map_iter->second.count(prior_stream_id) > 0);
+}
+
+LifetimeMemAssigner::PlacedLifetimes::PlacedLifetimes(const LifetimeMemAssigner &assigner, size_t step_num)
+    : assigner_(assigner), leaf_num_(step_num), step_tree_(2 * step_num) {}
+
+std::pair<size_t, size_t> LifetimeMemAssigner::PlacedLifetimes::BusySteps(const TensorLifetime &lifetime) const {
+  // Memory not released is busy until the last step, memory that may not reuse released memory is busy from
+  // the first step, so two lifetimes may only share memory if their busy steps do not overlap
+  size_t first = lifetime.reuse_released ? lifetime.first_step : 0;
+  size_t last = lifetime.keep_alive ? (leaf_num_ - 1) : lifetime.last_step;
+  return std::make_pair(first, last);
+}
+
+void LifetimeMemAssigner::PlacedLifetimes::Add(size_t index) {
+  const TensorLifetime &lifetime = assigner_.lifetimes_[index];
+  auto busy = BusySteps(lifetime);
+  for (size_t left = busy.first + leaf_num_, right = busy.second + 1 + leaf_num_; left < right;
+       left >>= 1, right >>= 1) {
+    if ((left & 1) != 0) {
+      step_tree_[left++].emplace_back(index);
+    }
+    if ((right & 1) != 0) {
+      step_tree_[--right].emplace_back(index);
+    }
+  }
+  (void)busy_firsts_.emplace(busy.first, index);
+  (void)stream_firsts_[lifetime.stream_id].emplace(lifetime.first_step, index);
+}
+
+void LifetimeMemAssigner::PlacedLifetimes::GetConflicts(size_t index, std::vector<size_t> &conflicts) const {
+  const TensorLifetime &lifetime = assigner_.lifetimes_[index];
+  auto busy = BusySteps(lifetime);
+  // The placed lifetimes busy at the first busy step, and the ones that get busy later within the busy steps
+  for (size_t pos = busy.first + leaf_num_; pos > 0; pos >>= 1) {
+    conflicts.insert(conflicts.end(), step_tree_[pos].begin(), step_tree_[pos].end());
+  }
+  for (auto iter = busy_firsts_.upper_bound(busy.first); (iter != busy_firsts_.end()) && (iter->first <= busy.second);
+       ++iter) {
+    conflicts.emplace_back(iter->second);
+  }
+
+  // Lifetimes of other streams may not share memory even if their busy steps do not overlap
+  for (const auto &item : stream_firsts_) {
+    if (item.first == lifetime.stream_id) {
+      continue;
+    }
+    const std::multimap<size_t, size_t> &firsts = item.second;
+    if (!assigner_.CanReuseStream(lifetime.stream_id, item.first)) {
+      for (auto iter = firsts.begin(); iter != firsts.lower_bound(lifetime.first_step); ++iter) {
+        conflicts.emplace_back(iter->second);
+      }
+    }
+    if (!assigner_.CanReuseStream(item.first, lifetime.stream_id)) {
+      for (auto iter = firsts.upper_bound(lifetime.first_step); iter != firsts.end(); ++iter) {
+        conflicts.emplace_back(iter->second);
+      }
+    }
+  }
+}
+
+size_t LifetimeMemAssigner::BestFitOffset(const TensorLifetime &lifetime, const std::vector<size_t> &conflicts) const {
+  // offset -> end of the conflicting lifetimes
+  vector<std::pair<size_t, size_t>> ranges;
+  ranges.reserve(conflicts.size());
+  for (size_t index : conflicts) {
+    const MemoryBlock *block = lifetimes_[index].block;
+    ranges.emplace_back(block->HeadOffset(), block->HeadOffset() + block->Size());
+  }
+  std::sort(ranges.begin(), ranges.end());
+
+  size_t size = lifetime.block->Size();
+  size_t best_offset = 0;
+  size_t best_gap = 0;
+  bool found = false;
+  size_t conflict_end = 0;
+  for (const auto &range : ranges) {
+    if (range.first > conflict_end) {
+      size_t gap = range.first - conflict_end;
+      if ((gap >= size) && (!found || (gap < best_gap))) {
+        found = true;
+        best_gap = gap;
+        best_offset = conflict_end;
+      }
+    }
+    conflict_end = std::max(conflict_end, range.second);
+  }
+  return found ? best_offset : conflict_end;
+}
+
+void LifetimeMemAssigner::PlaceLifetimes() {
+  vector<size_t> order;
+  for (size_t i = 0; i < lifetimes_.size(); i++) {
+    lifetimes_[i].block->Resize();
+    order.emplace_back(i);
+  }
+  // The larger lifetimes are the hardest to fit, place them first
+  std::stable_sort(order.begin(), order.end(), [this](size_t left, size_t right) {
+    return lifetimes_[left].block->Size() > lifetimes_[right].block->Size();
+  });
+
+  // One more step for the memory never released
+  PlacedLifetimes placed(*this, node_steps_.size() + 1);
+  vector<size_t> conflicts;
+  for (size_t i : order) {
+    MemoryBlock *block = lifetimes_[i].block;
+    conflicts.clear();
+    placed.GetConflicts(i, conflicts);
+    size_t offset = BestFitOffset(lifetimes_[i], conflicts);
+    block->SetHeadOffset(offset);
+    block->SetTailOffset(offset + block->Size() - 1);
+    mem_offset_ = std::max(mem_offset_, offset + block->Size());
+    placed.Add(i);
+  }
+}
+}  // namespace ge
@@ -0,0 +1,142 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_GRAPH_BUILD_MEMORY_LIFETIME_MEM_ASSIGNER_H_
+#define GE_GRAPH_BUILD_MEMORY_LIFETIME_MEM_ASSIGNER_H_
+
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "graph/build/memory/block_mem_assigner.h"
+
+namespace ge {
+///
+/// @ingroup GE
+/// @brief Assigns every output and workspace the lifetime [producer step, last consumer step] in topological
+///        order, then places the lifetimes from the largest down, each into the smallest gap left between the
+///        placed lifetimes it cannot share memory with.
+///
+class LifetimeMemAssigner : public BlockMemAssigner {
+ public:
+  explicit LifetimeMemAssigner(ge::ComputeGraphPtr compute_graph) : BlockMemAssigner(std::move(compute_graph)) {}
+
+  LifetimeMemAssigner(const LifetimeMemAssigner &) = delete;
+
+  LifetimeMemAssigner &operator=(const LifetimeMemAssigner &) = delete;
+
+  ~LifetimeMemAssigner() override = default;
+
+  Status GetMemoryRanges(std::vector<int64_t> &ranges) override;
+
+  void AssignMemoryWithReuse(std::vector<int64_t> &ranges) override;
+
+ private:
+  struct TensorLifetime {
+    size_t first_step;
+    size_t last_step;
+    int64_t stream_id;
+    // may be placed in memory released by other tensors
+    bool reuse_released;
+    // never released, e.g. graph outputs, constants and data-like tensors
+    bool keep_alive;
+    MemoryBlock *block;
+  };
+
+  void ComputeLifetimes();
+
+  void AddOutputLifetime(const ge::NodePtr &n, uint32_t index, size_t size);
+
+  void AddWorkspaceLifetimes(const ge::NodePtr &n);
+
+  ///
+  /// @ingroup GE
+  /// @brief extend the lifetime of an output to its last consumer on the same stream
+  /// @param [in] n node owning the output
+  /// @param [in] index output index
+  /// @param [in&out] lifetime lifetime of the memory the output lives in
+  ///
+  void UpdateLastStep(const ge::NodePtr &n, uint32_t index, TensorLifetime &lifetime);
+
+  bool NewLifetime(const ge::NodePtr &n, MemoryType mem_type, uint32_t index, size_t size, bool reuse_released);
+
+  ///
+  /// @ingroup GE
+  /// @brief Determine whether two lifetimes may be placed in the same memory.
+  /// @return bool true: the later one may reuse the memory of the earlier one
+  ///
+  bool CanShareMemory(const TensorLifetime &left, const TensorLifetime &right) const;
+
+  ///
+  /// @ingroup GE
+  /// @brief Determine whether a stream may reuse the memory released by another stream.
+  ///
+  bool CanReuseStream(int64_t stream_id, int64_t prior_stream_id) const;
+
+  void PlaceLifetimes();
+
+  ///
+  /// @ingroup GE
+  /// @brief placed lifetimes indexed by step, so that placing a lifetime only visits the placed lifetimes it
+  ///        cannot share memory with
+  ///
+  class PlacedLifetimes {
+   public:
+    PlacedLifetimes(const LifetimeMemAssigner &assigner, size_t step_num);
+
+    void Add(size_t index);
+
+    ///
+    /// @ingroup GE
+    /// @brief get the placed lifetimes the lifetime cannot share memory with, a lifetime may be got twice
+    /// @param [in] index index in lifetimes_ of the lifetime to place
+    /// @param [out] conflicts indexes in lifetimes_ of the conflicting lifetimes
+    ///
+    void GetConflicts(size_t index, std::vector<size_t> &conflicts) const;
+
+   private:
+    // the steps in which no other lifetime may share the memory, see CanShareMemory
+    std::pair<size_t, size_t> BusySteps(const TensorLifetime &lifetime) const;
+
+    const LifetimeMemAssigner &assigner_;
+    size_t leaf_num_;
+    // segment tree over the steps, a node holds the lifetimes whose busy steps cover its whole range
+    std::vector<std::vector<size_t>> step_tree_;
+    // first busy step -> index in lifetimes_
+    std::multimap<size_t, size_t> busy_firsts_;
+    // stream id -> first step -> index in lifetimes_
+    std::map<int64_t, std::multimap<size_t, size_t>> stream_firsts_;
+  };
+
+  ///
+  /// @ingroup GE
+  /// @brief find the smallest gap between the placed lifetimes that conflict with the lifetime
+  /// @param [in] lifetime lifetime to place
+  /// @param [in] conflicts indexes in lifetimes_ of the placed lifetimes it conflicts with
+  /// @return size_t offset of the gap, or the end of the conflicting lifetimes if no gap is big enough
+  ///
+  size_t BestFitOffset(const TensorLifetime &lifetime, const std::vector<size_t> &conflicts) const;
+
+  std::vector<TensorLifetime> lifetimes_;
+
+  std::unordered_map<const Node *, size_t> node_steps_;
+
+  // (node, output index) -> index in lifetimes_
+  std::map<std::pair<const Node *, uint32_t>, size_t> out_lifetimes_;
+};
+}  // namespace ge
+#endif  // GE_GRAPH_BUILD_MEMORY_LIFETIME_MEM_ASSIGNER_H_
@@ -71,10 +71,12 @@ Status VarMemAssignUtil::AssignStaticMemory2Node(ge::ComputeGraphPtr &compute_gr
                             ->SetAllocatedGraphId(node_name, compute_graph->GetGraphID()));
     }
 
+    // the memory stays where it is built into the graph until the graph is removed
     uint8_t *dev_ptr = nullptr;
     rtMemType_t memory_type = RT_MEMORY_HBM;
     GE_CHK_STATUS_RET(VarManager::Instance(compute_graph->GetSessionID())
-                          ->GetVarAddr(node_name, *tensor_desc, &dev_ptr, memory_type));
+                          ->RefVarAddr(node_name, *tensor_desc, compute_graph->GetGraphID(),
+                                       n->GetType() == CONSTANTOP, &dev_ptr, memory_type));
     vector<int64_t> output_list = n->GetOpDesc()->GetOutputOffset();
     GE_IF_BOOL_EXEC(output_list.empty(), return FAILED);
     output_list[0] = static_cast<int64_t>(reinterpret_cast<intptr_t>(dev_ptr));
@@ -21,12 +21,19 @@
 
 #include "common/ge_inner_error_codes.h"
 #include "common/model_parser/base.h"
+#include "common/tracer.h"
+#include "framework/common/scope_guard.h"
 #include "graph/load/new_model_manager/model_manager.h"
 #include "omm/csa_interact.h"
 #include "runtime/dev.h"
 #include "runtime/mem.h"
 
 namespace ge {
+namespace {
+// host memory of the inputs and outputs kept for the next requests
+const uint64_t kMaxCachedHostSize = 256UL * 1024UL * 1024UL;
+}  // namespace
+
 GraphExecutor::GraphExecutor()
     : init_flag_(false),
       train_graph_flag_(false),
@@ -34,22 +41,12 @@ GraphExecutor::GraphExecutor()
       condition_(nullptr),
       graph_run_listener_(nullptr),
       graph_context_(nullptr),
-      last_graph_id_(UINT32_MAX),
-      malloc_flag_(false) {}
+      data_index_(0),
+      host_allocator_(RT_MEMORY_DEFAULT, true, kMaxCachedHostSize) {}
 
 GraphExecutor::~GraphExecutor() {
   outputs_desc_.clear();
-  if (malloc_flag_) {
-    for (auto &buffer_addr : buffer_addr_) {
-      rtError_t rt_ret;
-      rt_ret = rtFreeHost(buffer_addr);
-      if (rt_ret != RT_ERROR_NONE) {
-        GELOGE(RT_FAILED, "[GraphManager] subgraph free buffer failed, ret: 0x%X", rt_ret);
-      }
-    }
-  }
-  malloc_flag_ = false;
-  buffer_addr_.clear();
+  (void)FreeInOutBuffer();
 }
 
 Status GraphExecutor::SetCondition(std::mutex *mutex, std::condition_variable *cond,
@@ -89,77 +86,49 @@ Status GraphExecutor::SetGraphContext(GraphContextPtr graph_context_ptr) {
 void GraphExecutor::SetTrainFlag(bool is_train_graph) { train_graph_flag_ = is_train_graph; }
 
 Status GraphExecutor::FreeInOutBuffer() {
-  if (malloc_flag_) {
-    for (auto iter = buffer_addr_.begin(); iter != buffer_addr_.end(); ++iter) {
-      rtError_t rt_ret;
-      rt_ret = rtFreeHost(*iter);
-      if (rt_ret != RT_ERROR_NONE) {
-        GELOGE(RT_FAILED, "[GraphManager] subgraph free buffer failed, ret: 0x%X", rt_ret);
-        (void)buffer_addr_.erase(buffer_addr_.begin(), iter);
-        return GE_GRAPH_FREE_FAILED;
-      }
-    }
-    buffer_addr_.clear();
-
-    malloc_flag_ = false;
-    return SUCCESS;
-  } else {
-    GELOGI("[GraphManager] not malloc buffer.");
-    return SUCCESS;
-  }
+  CachingAllocatorStats stats = host_allocator_.GetStats();
+  GELOGI("[GraphManager] free in out buffers, %lu bytes cached, %lu in use, %lu of %lu mallocs reused.",
+         stats.cached_size, stats.in_use_size, stats.hit_num, stats.malloc_num);
+  host_allocator_.Trim(0);
+  return SUCCESS;
 }
 
-Status GraphExecutor::MallocInOutBuffer(const std::vector<uint32_t> &buffer_size, std::vector<void *> &data_addr) {
-  if (malloc_flag_) {
-    auto all_size_same = true;
-    if (buffer_size.size() == buffer_size_.size()) {
-      for (size_t i = 0; i < buffer_size.size(); i++) {
-        if (buffer_size[i] != buffer_size_[i]) {
-          all_size_same = false;
-          break;
-        }
-      }
-    } else {
-      all_size_same = false;
-    }
-    if (all_size_same) {
-      data_addr = buffer_addr_;
-      return SUCCESS;
-    }
-    buffer_size_.clear();
-    auto rt_ret = FreeInOutBuffer();
-    if (rt_ret != SUCCESS) {
-      GELOGE(RT_FAILED, "[SubGraphInfo] MallocInOutBuffer free buffer failed, ret: 0x%X", rt_ret);
-      return RT_FAILED;
-    }
-  }
-
-  rtError_t rt_ret;
+Status GraphExecutor::MallocInOutBuffer(const std::vector<uint32_t> &buffer_size, InOutBuffer &buffer) {
+  buffer.buffer_size = buffer_size;
   for (size_t i = 0; i < buffer_size.size(); ++i) {
-    void *tmp_buf = nullptr;
-    rt_ret = rtMallocHost(&tmp_buf, buffer_size[i]);
-    if (rt_ret != RT_ERROR_NONE) {
-      GELOGE(RT_FAILED, "[GraphManager] subgraph malloc buffer failed, ret: 0x%X", rt_ret);
+    uint8_t *tmp_buf = host_allocator_.Malloc(buffer_size[i]);
+    if (tmp_buf == nullptr) {
+      GELOGE(RT_FAILED, "[GraphManager] subgraph malloc buffer failed, size: %u", buffer_size[i]);
+      ReleaseInOutBuffer(buffer);
       return GE_GRAPH_MALLOC_FAILED;
     }
-    malloc_flag_ = true;
-    data_addr.push_back(tmp_buf);
-    buffer_addr_.push_back(tmp_buf);
+    buffer.buffer_addr.push_back(tmp_buf);
   }
-  buffer_size_ = buffer_size;
   return SUCCESS;
 }
 
+void GraphExecutor::ReleaseInOutBuffer(InOutBuffer &buffer) {
+  for (void *addr : buffer.buffer_addr) {
+    if (host_allocator_.Free(reinterpret_cast<uint8_t *>(addr)) != SUCCESS) {
+      GELOGW("[GraphManager] subgraph free buffer failed.");
+    }
+  }
+  buffer.buffer_addr.clear();
+  buffer.buffer_size.clear();
+}
+
 Status GraphExecutor::PrepareInputData(const std::vector<GeTensor> &input_tensor, InputData &graph_input_data,
-                                       OutputData &graph_output_data, std::vector<InputOutputDescInfo> &output_desc) {
+                                       OutputData &graph_output_data, std::vector<InputOutputDescInfo> &output_desc,
+                                       InOutBuffer &buffer) {
   // Preprocessing input data
-  graph_input_data.index = 0;
+  graph_input_data.index = data_index_.fetch_add(1);
   graph_input_data.timeout = 0;
   graph_input_data.timestamp = 0;
+  // the spans of the model run are of the request of the graph run
+  graph_input_data.request_id = Tracer::GetRequestId();
   std::size_t inputSize = input_tensor.size();
   std::size_t output_size = output_desc.size();
   std::vector<uint32_t> buffer_size_vec;
-  std::vector<void *> addr_vec;
 
   for (std::size_t i = 0; i < inputSize; ++i) {
     const GeTensor *InTensor = &input_tensor[i];
@@ -171,11 +140,12 @@ Status GraphExecutor::PrepareInputData(const std::vector<GeTensor> &input_tensor
     buffer_size_vec.push_back(desc.size);
   }
 
-  Status ret = MallocInOutBuffer(buffer_size_vec, addr_vec);
+  Status ret = MallocInOutBuffer(buffer_size_vec, buffer);
   if (ret != SUCCESS) {
     GELOGE(GE_GRAPH_MALLOC_FAILED, "[GraphExecutor] Malloc mem failed");
     return GE_GRAPH_MALLOC_FAILED;
   }
+  const std::vector<void *> &addr_vec = buffer.buffer_addr;
 
   for (std::size_t i = 0; i < input_tensor.size() && i < addr_vec.size(); ++i) {
     const GeTensor *in_tensor = &input_tensor[i];
@@ -194,7 +164,7 @@ Status GraphExecutor::PrepareInputData(const std::vector<GeTensor> &input_tensor
     graph_input_data.blobs.push_back(in_data_buf);
   }
 
-  graph_output_data.index = 0;
+  graph_output_data.index = graph_input_data.index;
 
   for (std::size_t j = 0; j < output_size; j++) {
     auto desc = output_desc[j];
@@ -210,7 +180,7 @@ Status GraphExecutor::PrepareInputData(const std::vector<GeTensor> &input_tensor
   return SUCCESS;
 }
 
-Status GraphExecutor::SyncExecuteModel(uint32_t model_id, const std::vector<GeTensor> &input_tensor,
+Status GraphExecutor::SyncExecuteModel(GraphId graph_id, uint32_t model_id, const std::vector<GeTensor> &input_tensor,
                                        std::vector<GeTensor> &output_tensor) {
   // Prepare input and output
   std::vector<InputOutputDescInfo> inputs_desc;
@@ -222,18 +192,24 @@ Status GraphExecutor::SyncExecuteModel(uint32_t model_id, const std::vector<GeTe
     GELOGE(GE_GRAPH_GET_IN_OUT_FAILED, "[GraphExecutor] GetInputOutputDescInfo failed, modelId=%u.", model_id);
     return GE_GRAPH_GET_IN_OUT_FAILED;
   }
-  outputs_desc_.assign(output_desc.begin(), output_desc.end());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    outputs_desc_[graph_id] = output_desc;
+  }
 
   InputData input_data;
   OutputData output_data;
   input_data.model_id = model_id;
-  ret = PrepareInputData(input_tensor, input_data, output_data, output_desc);
+  // the buffers go back to the cache once the outputs are copied out
+  InOutBuffer buffer;
+  GE_MAKE_GUARD(in_out_buffer, [&] { ReleaseInOutBuffer(buffer); });
+  ret = PrepareInputData(input_tensor, input_data, output_data, output_desc, buffer);
   if (ret != SUCCESS) {
     GELOGE(GE_GRAPH_PREPARE_FAILED, "[GraphExecutor] PrepareInputData failed, modelId=%u.", model_id);
     return GE_GRAPH_PREPARE_FAILED;
   }
 
-  if (graph_run_listener_->ResetResult() != SUCCESS) {
+  if (graph_run_listener_->ResetResult(model_id, input_data.index) != SUCCESS) {
     GELOGE(GE_GRAPH_EXECUTE_FAILED, "Reset result failed");
     return GE_GRAPH_EXECUTE_FAILED;
   }
@@ -242,25 +218,23 @@ Status GraphExecutor::SyncExecuteModel(uint32_t model_id, const std::vector<GeTe
   GELOGI("[ExecuteGraph] DataInput via new ome begin.");
   ret = DataInput(input_data, output_data);
   if (ret != SUCCESS) {
+    graph_run_listener_->EraseResult(model_id, input_data.index);
     GELOGE(GE_GRAPH_DATA_INPUT_FAILED, "[GraphExecutor] push data failed, modelId=%u.", model_id);
     return GE_GRAPH_DATA_INPUT_FAILED;
   }
   GELOGI("[GraphExecutor] input data push to wrapper finish, waiting for result...");
 
   // Pending until async execute graph complete
-  {
-    std::unique_lock<std::mutex> ulock(*sync_run_mutex_);
-    if (!graph_run_listener_->IsFinished()) {
-      (*condition_).wait(ulock);
-    }
-
-    // Run graph return
-    uint32_t result_code = graph_run_listener_->GetResultCode();
-    if (result_code != SUCCESS) {
-      GELOGE(GE_GRAPH_EXECUTE_FAILED, "[GraphExecutor] execute model failed, ret=%u, modelId=%u.", result_code,
-             model_id);
-      return GE_GRAPH_EXECUTE_FAILED;
-    }
+  uint32_t result_code = SUCCESS;
+  if (graph_run_listener_->WaitResult(model_id, input_data.index, result_code) != SUCCESS) {
+    GELOGE(GE_GRAPH_EXECUTE_FAILED, "[GraphExecutor] wait result failed, modelId=%u.", model_id);
+    return GE_GRAPH_EXECUTE_FAILED;
+  }
+  // Run graph return
+  if (result_code != SUCCESS) {
+    GELOGE(GE_GRAPH_EXECUTE_FAILED, "[GraphExecutor] execute model failed, ret=%u, modelId=%u.", result_code,
+           model_id);
+    return GE_GRAPH_EXECUTE_FAILED;
   }
   for (size_t i = 0; i < output_data.blobs.size(); ++i) {
     DataBuffer out_data_tmp = output_data.blobs[i];
@@ -309,6 +283,12 @@ void GraphExecutor::InitModelIdInfo(std::vector<uint32_t> &out_model_id_info,
   }
 }
 
+std::vector<InputOutputDescInfo> GraphExecutor::GetOutputsDesc(GraphId graph_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = outputs_desc_.find(graph_id);
+  return (iter == outputs_desc_.end()) ? std::vector<InputOutputDescInfo>() : iter->second;
+}
+
 Status GraphExecutor::FreeExecuteMemory() {
   auto ret = FreeInOutBuffer();
   if (ret != SUCCESS) {
@@ -321,20 +301,12 @@ Status GraphExecutor::FreeExecuteMemory() {
 
 Status GraphExecutor::ExecuteGraph(GraphId graph_id, const GeModelPtr &ge_model,
                                    const std::vector<GeTensor> &input_tensor, std::vector<GeTensor> &output_tensor) {
-  if (graph_id != last_graph_id_) {
-    auto ret = FreeExecuteMemory();
-    if (ret != SUCCESS) {
-      return ret;
-    }
-  }
-  last_graph_id_ = graph_id;
-
   if (!init_flag_) {
     GELOGE(GE_GRAPH_EXECUTE_NOT_INIT, "[GraphExecutor] AI Core Engine without calling SetCondition!");
     return GE_GRAPH_EXECUTE_NOT_INIT;
   }
   GE_CHECK_NOTNULL_EXEC(ge_model, return FAILED);
-  Status ret = SyncExecuteModel(ge_model->GetModelId(), input_tensor, output_tensor);
+  Status ret = SyncExecuteModel(graph_id, ge_model->GetModelId(), input_tensor, output_tensor);
   if (ret != SUCCESS) {
     GELOGE(GE_GRAPH_SYNC_MODEL_FAILED, "[GraphExecutor] SyncExecuteModel Error!");
     return GE_GRAPH_SYNC_MODEL_FAILED;
@@ -347,13 +319,6 @@ Status GraphExecutor::ExecuteGraphAsync(GraphId graph_id, const GeModelPtr &ge_m
                                         const std::vector<TensorInfo> &input_tensor,
                                         std::vector<TensorInfo> &output_tensor) {
   GELOGI("[GraphExecutor] Start to async execute graph, graph_id=%u", graph_id);
-  if (graph_id != last_graph_id_) {
-    auto ret = FreeExecuteMemory();
-    if (ret != SUCCESS) {
-      return ret;
-    }
-  }
-  last_graph_id_ = graph_id;
   GE_CHECK_NOTNULL_EXEC(ge_model, return FAILED);
   Status ret = AsyncExecuteModel(ge_model->GetModelId(), input_tensor, output_tensor);
   if (ret != SUCCESS) {
@@ -19,9 +19,12 @@
 
 #include <cstdarg>
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "common/debug/log.h"
@@ -33,6 +36,7 @@
 #include "common/util.h"
 #include "ge/ge_api_types.h"
 #include "graph/compute_graph.h"
+#include "graph/manager/caching_allocator.h"
 #include "graph/manager/graph_context.h"
 #include "graph/manager/graph_manager_utils.h"
 #include "graph/model.h"
@@ -58,7 +62,7 @@ class GraphExecutor {
 
   void SetTrainFlag(bool is_train_graph);
 
-  const std::vector<InputOutputDescInfo> &GetOutputsDesc() const { return outputs_desc_; }
+  std::vector<InputOutputDescInfo> GetOutputsDesc(GraphId graph_id);
 
   Status FreeExecuteMemory();
 
@@ -77,10 +81,17 @@ class GraphExecutor {
                                                   std::vector<uint32_t> &output_formats);
 
  private:
+  // host buffers of the inputs and outputs of one request
+  struct InOutBuffer {
+    std::vector<uint32_t> buffer_size;
+    std::vector<void *> buffer_addr;
+  };
+
   Status PrepareInputData(const std::vector<GeTensor> &input_tensor, InputData &graph_input_data,
-                          OutputData &graph_output_data, std::vector<InputOutputDescInfo> &output_desc);
+                          OutputData &graph_output_data, std::vector<InputOutputDescInfo> &output_desc,
+                          InOutBuffer &buffer);
 
-  Status SyncExecuteModel(uint32_t model_id, const std::vector<GeTensor> &input_tensor,
+  Status SyncExecuteModel(GraphId graph_id, uint32_t model_id, const std::vector<GeTensor> &input_tensor,
                           std::vector<GeTensor> &output_tensor);
 
   Status AsyncExecuteModel(uint32_t model_id, const std::vector<TensorInfo> &input_tensor,
@@ -91,9 +102,18 @@ class GraphExecutor {
 
   Status FreeInOutBuffer();
 
-  Status MallocInOutBuffer(const std::vector<uint32_t> &buffer_size, std::vector<void *> &data_addr);
+  ///
+  /// @ingroup ge_graph
+  /// @brief take the buffers from the host memory cached, or malloc new ones
+  /// @param [in] buffer_size sizes of the input and output buffers
+  /// @param [out] buffer buffers owned by the request until ReleaseInOutBuffer
+  ///
+  Status MallocInOutBuffer(const std::vector<uint32_t> &buffer_size, InOutBuffer &buffer);
+
+  // the buffers go back to the cache for the next requests
+  void ReleaseInOutBuffer(InOutBuffer &buffer);
 
-  bool init_flag_;
+  std::atomic<bool> init_flag_;
 
   bool train_graph_flag_;
   // For run graph synchronous return
@@ -105,12 +125,14 @@ class GraphExecutor {
 
   GraphContextPtr graph_context_;
 
-  std::vector<InputOutputDescInfo> outputs_desc_;
-  GraphId last_graph_id_;
+  // index of the next request, tells the concurrent requests of a model apart
+  std::atomic<uint32_t> data_index_;
 
-  bool malloc_flag_;
-  std::vector<void *> buffer_addr_;
-  std::vector<uint32_t> buffer_size_;
+  std::mutex mutex_;
+  // guarded by mutex_
+  std::map<GraphId, std::vector<InputOutputDescInfo>> outputs_desc_;
+  // pinned host memory of the inputs and outputs, kept across the requests
+  CachingAllocator host_allocator_;
 };
 }  // namespace ge
 
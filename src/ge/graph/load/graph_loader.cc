@@ -19,7 +19,6 @@
 #include <string>
 #include <vector>
 
-#include "common/helper/model_helper.h"
 #include "common/util.h"
 #include "graph/ge_context.h"
 #include "graph/load/new_model_manager/davinci_model_parser.h"
@@ -45,13 +44,8 @@ Status GraphLoader::LoadGraph(const std::shared_ptr<ge::GeModel> &ge_model_ptr,
     return GE_GRAPH_PARAM_NULLPTR;
   }
 
-  std::shared_ptr<ge::Model> model_ptr;
-  if (ModelHelper::TransGeModelToModel(ge_model_ptr, model_ptr) != SUCCESS) {
-    GELOGE(GE_GRAPH_PARAM_NULLPTR, "[LoadGraph] GE load graph ge_model_ptr trans to ModelPtr failed.");
-    return GE_GRAPH_PARAM_NULLPTR;
-  }
   GELOGI("[LoadGraph] GE load graph via new ome begin.");
-  Status ret = LoadModelOnline(model_id_info.model_id, model_ptr, model_listener);
+  Status ret = LoadModelOnline(model_id_info.model_id, ge_model_ptr, model_listener);
   if (ret != SUCCESS) {
     GELOGE(ret, "[LoadGraph] GE load graph  LoadGraph() return fail. err: %u", ret);
     return ret;
@@ -73,14 +67,8 @@ Status GraphLoader::LoadGraphAsync(const std::shared_ptr<ge::GeModel> &ge_model_
     return GE_GRAPH_PARAM_NULLPTR;
   }
 
-  std::shared_ptr<ge::Model> model_ptr;
-  if (ModelHelper::TransGeModelToModel(ge_model_ptr, model_ptr) != SUCCESS) {
-    GELOGE(GE_GRAPH_PARAM_NULLPTR, "[LoadGraph] GE load graph ge_model_ptr trans to ModelPtr failed.");
-    return GE_GRAPH_PARAM_NULLPTR;
-  }
-
   GELOGI("[LoadGraphAsync] GE load graph begin.");
-  Status ret = LoadModelOnline(model_id_info.model_id, model_ptr, model_async_listener);
+  Status ret = LoadModelOnline(model_id_info.model_id, ge_model_ptr, model_async_listener);
   if (ret != SUCCESS) {
     GELOGE(ret, "[LoadGraphAsync] GE load graph  LoadGraphAsync() return fail. err: %u", ret);
     return ret;
@@ -110,7 +98,7 @@ Status GraphLoader::UnloadModel(uint32_t model_id) {
   return SUCCESS;
 }
 
-Status GraphLoader::LoadModelOnline(uint32_t &model_id, std::shared_ptr<ge::Model> &model,
+Status GraphLoader::LoadModelOnline(uint32_t &model_id, const std::shared_ptr<ge::GeModel> &ge_model,
                                     const std::shared_ptr<ModelListener> &listener) {
   rtError_t rt_ret = rtSetDevice(GetContext().DeviceId());
   if (rt_ret != RT_ERROR_NONE) {
@@ -123,7 +111,7 @@ Status GraphLoader::LoadModelOnline(uint32_t &model_id, std::shared_ptr<ge::Mode
     GELOGI("Load begin, model_id:%u.", model_id);
     auto model_manager = ModelManager::GetInstance();
     GE_CHECK_NOTNULL(model_manager);
-    Status ret = model_manager->LoadModelOnline(model_id, model, listener);
+    Status ret = model_manager->LoadModelOnline(model_id, ge_model, listener);
     if (ret != SUCCESS) {
       GELOGE(ret, "LoadModel: Load failed. ret = %u", ret);
       CsaInteract::GetInstance().WriteErrorCode(ret, ERROR_MODULE_FMK, JOBSUBSTATE_GRAPH_LOAD);
@@ -193,7 +181,7 @@ Status GraphLoader::GetMaxUsedMemory(uint32_t model_id, uint64_t &max_size) {
 }
 
 Status GraphLoader::LoadDataFromFile(const std::string &path, const std::string &key_path, int32_t priority,
-                                     ModelData &model_data) {
+                                     ModelData &model_data, bool map_file) {
   Status ret;
   try {
     if (!CheckInputPathValid(path)) {
@@ -207,7 +195,8 @@ Status GraphLoader::LoadDataFromFile(const std::string &path, const std::string
       return PARAM_INVALID;
     }
 
-    ret = DavinciModelParser::LoadFromFile(path.c_str(), key_path.c_str(), priority, model_data);
+    ret = map_file ? DavinciModelParser::MapFromFile(path.c_str(), key_path.c_str(), priority, model_data)
+                   : DavinciModelParser::LoadFromFile(path.c_str(), key_path.c_str(), priority, model_data);
     if (ret != SUCCESS) {
       GELOGE(ret, "LoadModelFromFile: Load failed. ret = %u", ret);
       return ret;
@@ -222,10 +211,7 @@ Status GraphLoader::LoadDataFromFile(const std::string &path, const std::string
     ret = FAILED;
   }
 
-  if (model_data.model_data != nullptr) {
-    delete[] static_cast<char *>(model_data.model_data);
-    model_data.model_data = nullptr;
-  }
+  DavinciModelParser::FreeModelData(model_data);
   return ret;
 }
 
@@ -235,23 +221,18 @@ Status GraphLoader::LoadModelFromFile(const std::string &path, const std::string
   ModelData model_data;
 
   try {
-    ret = LoadDataFromFile(path, key_path, priority, model_data);
+    // the weights are uploaded from the mapped pages, the mapping is released once the model is loaded
+    ret = LoadDataFromFile(path, key_path, priority, model_data, true);
     if (ret != SUCCESS) {
       GELOGE(ret, "LoadModelFromFile: Load failed. ret = %u", ret);
-      if (model_data.model_data != nullptr) {
-        delete[] static_cast<char *>(model_data.model_data);
-        model_data.model_data = nullptr;
-      }
+      DavinciModelParser::FreeModelData(model_data);
       return ret;
     }
 
     ret = LoadModel(model_data, listener, model_id);
     if (ret != SUCCESS) {
       GELOGE(ret, "LoadModel: Load failed. ret = %u", ret);
-      if (model_data.model_data != nullptr) {
-        delete[] static_cast<char *>(model_data.model_data);
-        model_data.model_data = nullptr;
-      }
+      DavinciModelParser::FreeModelData(model_data);
     }
   } catch (std::bad_alloc &) {
     GELOGE(MEMALLOC_FAILED, "Load model from file failed, bad memory allocation");
@@ -261,10 +242,7 @@ Status GraphLoader::LoadModelFromFile(const std::string &path, const std::string
     ret = FAILED;
   }
 
-  if (model_data.model_data != nullptr) {
-    delete[] static_cast<char *>(model_data.model_data);
-    model_data.model_data = nullptr;
-  }
+  DavinciModelParser::FreeModelData(model_data);
 
   return ret;
 }
@@ -60,8 +60,14 @@ class GraphLoader {
 
   static Status GetMemoryInfo(int64_t &free);
 
+  ///
+  /// @ingroup ge
+  /// @brief Load data from model file to memory
+  /// @param [in] map_file map the file instead of reading it to the heap
+  /// @param [out] model_data model data, release it with DavinciModelParser::FreeModelData
+  ///
   static Status LoadDataFromFile(const std::string &path, const std::string &key_path, int32_t priority,
-                                 ModelData &model_data);
+                                 ModelData &model_data, bool map_file = false);
 
   static Status LoadModelFromData(uint32_t &model_id, const ModelData &model_data, void *dev_ptr, size_t mem_size,
                                   void *weight_ptr, size_t weight_size);
@@ -74,7 +80,7 @@ class GraphLoader {
                              OutputData &output_data);
 
  private:
-  static Status LoadModelOnline(uint32_t &model_id, std::shared_ptr<ge::Model> &model,
+  static Status LoadModelOnline(uint32_t &model_id, const std::shared_ptr<ge::GeModel> &ge_model,
                                 const std::shared_ptr<ModelListener> &listener);
 };
 }  // namespace ge
@@ -21,7 +21,7 @@
 #include <string>
 #include <vector>
 
-#include "common/blocking_queue.h"
+#include "common/lock_free_queue.h"
 #include "common/types.h"
 #include "common/ge_types.h"
 
@@ -137,9 +137,9 @@ class DataInputer {
  private:
   ///
   /// @ingroup domi_ome
-  /// @brief save input data queue
+  /// @brief save input data queue, lock free as many client threads may push to one model
   ///
-  BlockingQueue<std::shared_ptr<InputDataWrapper>> queue_;
+  LockFreeQueue<std::shared_ptr<InputDataWrapper>> queue_;
 };
 }  // namespace ge
 
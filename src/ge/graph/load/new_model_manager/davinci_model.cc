@@ -30,6 +30,7 @@
 #include "cce/dnn.h"
 #include "cce/optimizer/fusion_engine.h"
 #include "common/debug/log.h"
+#include "external/ge/ge_api_types.h"
 #include "common/formats/formats.h"
 #include "common/formats/utils/formats_trans_utils.h"
 #include "common/math/math_util.h"
@@ -37,16 +38,19 @@
 #include "common/profiling/profiling_manager.h"
 #include "common/properties_manager.h"
 #include "common/scope_guard.h"
-#include "common/thread_pool.h"
+#include "common/task_executor.h"
+#include "common/tracer.h"
 #include "framework/common/debug/ge_log.h"
 #include "graph/compute_graph.h"
 #include "graph/debug/ge_attr_define.h"
 #include "graph/ge_context.h"
 #include "graph/graph.h"
+#include "graph/load/new_model_manager/davinci_model_parser.h"
 #include "graph/load/new_model_manager/tbe_handle_store.h"
 #include "graph/load/output/output.h"
 #include "graph/manager/graph_mem_allocator.h"
 #include "graph/manager/graph_var_manager.h"
+#include "graph/manager/trans_var_data_utils.h"
 #include "graph/manager/util/debug.h"
 #include "graph/model_serialize.h"
 #include "graph/node.h"
@@ -79,9 +83,12 @@ namespace ge {
 namespace {
 const uint32_t DEFAULT_DATA_INDEX = 0;
 const uint32_t TRUE_BRANCH_STREAM_NUM = 1;
-const uint32_t THREAD_NUM = 16;
+// tasks initialized by one range of the task executor
+const size_t kInitTaskGrainSize = 64;
 const int kDecimal = 10;
 const int kBytes = 8;
+const int64_t kMinPipelineDepth = 2;
+const int64_t kMaxPipelineDepth = 8;
 
 class RtContextSwitchGuard {
  public:
@@ -198,73 +205,6 @@ Status CopyVarToDevice(const NodePtr &var, const formats::TransResult &trans_res
   return SUCCESS;
 }
 
-Status TransVarOnHost(uint8_t *var_data, const VarTransRoad &trans_road, formats::TransResult &result) {
-  formats::TransResult resultLastTime{};
-  bool use_init_data = true;
-  for (const auto &trans_info : trans_road) {
-    if (trans_info.node_type == RESHAPE || trans_info.node_type == REFORMAT) {
-      GELOGD("Skip to trans variable data on the reshape/reformat node");
-      continue;
-    }
-    uint8_t *src_data = nullptr;
-    if (use_init_data) {
-      src_data = var_data;
-      use_init_data = false;
-    } else {
-      src_data = resultLastTime.data.get();
-    }
-
-    formats::TransResult tmp_result{};
-    if (trans_info.node_type == TRANSDATA) {
-      auto src_format = trans_info.input.GetFormat();
-      auto src_shape = trans_info.input.GetShape().GetDims();
-      auto dst_format = trans_info.output.GetFormat();
-      auto dst_shape = trans_info.output.GetShape().GetDims();
-      auto data_type = trans_info.input.GetDataType();
-      GELOGD("Trans format from %s to %s, shape %s to %s, data-type %s",
-             TypeUtils::FormatToSerialString(src_format).c_str(), TypeUtils::FormatToSerialString(dst_format).c_str(),
-             formats::ShapeToString(src_shape).c_str(), formats::ShapeToString(dst_shape).c_str(),
-             TypeUtils::DataTypeToSerialString(data_type).c_str());
-      auto ret = formats::TransFormat({src_data, src_format, dst_format, src_shape, dst_shape, data_type}, tmp_result);
-      if (ret != SUCCESS) {
-        GELOGE(INTERNAL_ERROR,
-               "Failed to trans format from %s to %s, shape %s to %s, "
-               "data type %s error code %u",
-               TypeUtils::FormatToSerialString(src_format).c_str(), TypeUtils::FormatToSerialString(dst_format).c_str(),
-               formats::ShapeToString(src_shape).c_str(), formats::ShapeToString(dst_shape).c_str(),
-               TypeUtils::DataTypeToSerialString(data_type).c_str(), ret);
-        return ret;
-      }
-    } else if (trans_info.node_type == CAST) {
-      auto input_shape = trans_info.input.GetShape();
-      auto src_data_size = input_shape.GetShapeSize();
-      auto src_data_type = trans_info.input.GetDataType();
-      auto dst_data_type = trans_info.output.GetDataType();
-      GELOGD("Trans data type from %s to %s, input shape %s, data size %ld",
-             TypeUtils::DataTypeToSerialString(src_data_type).c_str(),
-             TypeUtils::DataTypeToSerialString(dst_data_type).c_str(), formats::ShapeToString(input_shape).c_str(),
-             src_data_size);
-      auto ret = formats::TransDataType({src_data, static_cast<size_t>(src_data_size), src_data_type, dst_data_type},
-                                        tmp_result);
-      if (ret != SUCCESS) {
-        GELOGE(INTERNAL_ERROR, "Failed to trans data type from %s to %s, input shape %s, data size %ld, error code %u",
-               TypeUtils::DataTypeToSerialString(src_data_type).c_str(),
-               TypeUtils::DataTypeToSerialString(dst_data_type).c_str(), formats::ShapeToString(input_shape).c_str(),
-               src_data_size, ret);
-        return ret;
-      }
-    } else {
-      GELOGE(UNSUPPORTED, "Failed to trans var data, the trans type %s does not supported",
-             trans_info.node_type.c_str());
-      return UNSUPPORTED;
-    }
-    resultLastTime = tmp_result;
-  }
-
-  result = resultLastTime;
-  return SUCCESS;
-}
-
 ///
 /// re-alloc var memory on device using var-manager
 /// free origin var memory(var manager does not support now)
@@ -296,7 +236,7 @@ Status ReAssignVarAddr(uint64_t session_id, const std::string &var_name, const G
   return SUCCESS;
 }
 
-Status TransVarData(const NodePtr &var, const VarTransRoad &trans_road, uint64_t session_id, uint32_t device_id) {
+Status TransVarData(const NodePtr &var, const VarTransRoad &trans_road, uint64_t session_id, VarTransfer &transfer) {
   // do not need to do anything if only all reshape/reformat node on the trans_road
   GE_CHECK_NOTNULL(var);
   bool need_trans = false;
@@ -310,23 +250,20 @@ Status TransVarData(const NodePtr &var, const VarTransRoad &trans_road, uint64_t
     return SUCCESS;
   }
 
-  // Sync var data from device
-  std::unique_ptr<uint8_t[]> var_data;
   if (trans_road.size() == 0) {
     GELOGE(INTERNAL_ERROR, "Failed to get trans_road, trans_road is empty.");
     return INTERNAL_ERROR;
   }
   const GeTensorDesc &input_desc = trans_road.begin()->input;
-  auto ret = CopyVarFromDevice(session_id, var, var_data, input_desc);
+  void *var_src = nullptr;
+  auto ret = ReAssignVarAddr(session_id, var->GetName(), input_desc, &var_src);
   if (ret != SUCCESS) {
+    GELOGE(ret, "Failed to copy var %s from device, can not get var addr", var->GetName().c_str());
     return ret;
   }
-
-  formats::TransResult trans_result{};
-  ret = TransVarOnHost(var_data.get(), trans_road, trans_result);
-  if (ret != SUCCESS) {
-    GELOGE(ret, "Failed to trans var data on host, error code %u", ret);
-    return ret;
+  int src_size = CalcVarSizeInBytes(input_desc);
+  if (src_size <= 0) {
+    return INTERNAL_ERROR;
   }
 
   void *var_device = nullptr;
@@ -336,16 +273,23 @@ Status TransVarData(const NodePtr &var, const VarTransRoad &trans_road, uint64_t
   /// size of the converted variable. To complete the final solution, the dependency of the variable manager on
   /// TensorDesc needs to be removed. This change is large and needs to be performed step by step.
   ///
-  ret = ReAssignVarAddr(session_id, var->GetName(), trans_road.rbegin()->output, &var_device);
+  const GeTensorDesc &output_desc = trans_road.rbegin()->output;
+  ret = ReAssignVarAddr(session_id, var->GetName(), output_desc, &var_device);
   if (ret != SUCCESS) {
-    GELOGE(ret, "Failed to re-assign memory on device, size %zu", trans_result.length);
+    GELOGE(ret, "Failed to re-assign memory on device, var %s", var->GetName().c_str());
     return ret;
   }
+  int dst_size = CalcVarSizeInBytes(output_desc);
+  if (dst_size <= 0) {
+    return INTERNAL_ERROR;
+  }
 
-  // sync new data to device
-  ret = CopyVarToDevice(var, trans_result, var_device);
+  // the data goes to host, along the trans road and back to device
+  VarTransferCost cost;
+  ret = transfer.Transfer(var->GetName(), static_cast<const uint8_t *>(var_src), static_cast<size_t>(src_size),
+                          trans_road, static_cast<uint8_t *>(var_device), static_cast<size_t>(dst_size), cost);
   if (ret != SUCCESS) {
-    GELOGE(ret, "Failed to send var data to device");
+    GELOGE(ret, "Failed to trans var %s data", var->GetName().c_str());
     return ret;
   }
 
@@ -380,7 +324,11 @@ DavinciModel::DavinciModel(int32_t priority, const std::shared_ptr<ModelListener
       device_id_(0),
       is_train_mode_(false),
       model_task_def_(nullptr),
-      maxDumpOpNum_(0) {
+      maxDumpOpNum_(0),
+      pipeline_depth_(0),
+      pipeline_input_stream_(nullptr),
+      pipeline_output_stream_(nullptr),
+      pipeline_stop_(false) {
   op_list_.clear();
 }
 
@@ -467,10 +415,8 @@ Status DavinciModel::InitModelMem(void *dev_ptr, size_t memsize, void *weight_pt
   }
   is_model_has_inited_ = true;
   std::size_t data_size = TotalMemSize();
-  ge::Buffer weights = ge_model_->GetWeight();
-
-  uint8_t *weights_addr = weights.GetData();
-  std::size_t weights_size = weights.GetSize();
+  const uint8_t *weights_addr = ge_model_->GetWeightData();
+  std::size_t weights_size = ge_model_->GetWeightSize();
 
   GE_CHECK_LE(weights_size, ALLOC_MEMORY_MAX_SIZE);
 
@@ -511,9 +457,14 @@ Status DavinciModel::InitModelMem(void *dev_ptr, size_t memsize, void *weight_pt
       }
       is_inner_weight_base_ = true;
     }
+    DavinciModelParser::AdviseSequential(weights_addr, weights_size);
     GE_CHK_RT_RET(rtMemcpy(weights_mem_base_, weights_size, weights_addr, weights_size, RT_MEMCPY_HOST_TO_DEVICE))
     GELOGI("copy weights data to device");
+    // the host weights of a mapped model file are not needed any more
+    DavinciModelParser::ReleasePages(weights_addr, weights_size);
   }
+  // the model data the weights may refer to is released after loading
+  ge_model_->ClearWeightRef();
 
   var_mem_base_ = VarManager::Instance(session_id_)->GetVarMemoryBase(RT_MEMORY_HBM);
   if (TotalVarMemSize() && var_mem_base_ == nullptr) {
@@ -747,7 +698,11 @@ Status DavinciModel::Init(void *dev_ptr, size_t memsize, void *weight_ptr, size_
   GE_TIMESTAMP_START(DoTaskSink);
   auto ret = DoTaskSink();
   GE_TIMESTAMP_END(DoTaskSink, "GraphLoader::DoTaskSink");
-  return ret;
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  return InitZeroCopy();
 }
 
 ///
@@ -1117,12 +1072,29 @@ Status DavinciModel::CopyTransData(const std::vector<DataBuffer> &data, uint32_t
   GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(outputs[0] == -1, return PARAM_INVALID, "output offset is -1");
   GE_CHK_BOOL_EXEC(data_index < data.size(), return PARAM_INVALID, "index:%u >= size:%zu", data_index, data.size());
 
+  formats::TransResult tmp_result{};
+  GE_CHK_STATUS_RET_NOLOG(TransInputData(data[data_index], data_op_index, tmp_result));
+
+  void *mem_addr = mem_base_ + outputs[0];
+  auto rt_ret = rtMemcpy(mem_addr, runtime_param_.mem_size - outputs[0], tmp_result.data.get(), tmp_result.length,
+                         RT_MEMCPY_HOST_TO_DEVICE);
+  if (rt_ret != RT_ERROR_NONE) {
+    GELOGE(RT_FAILED, "Failed to copy memory to device, size %zu", tmp_result.length);
+    return RT_FAILED;
+  }
+  GELOGI("[IMAS]CopyTransData memcpy graph_%u type[F] name[%s] output[%d] datasize[%zu]", runtime_param_.graph_id,
+         data_op_list_[data_op_index]->GetName().c_str(), 0, tmp_result.length);
+  return SUCCESS;
+}
+
+Status DavinciModel::TransInputData(const DataBuffer &data_buf, uint32_t data_op_index, formats::TransResult &result) {
   auto input_tensor_desc = data_op_input_tensor_desc_map_[data_op_list_[data_op_index]->GetName()];
   auto output_tensor_desc = data_op_output_tensor_desc_map_[data_op_list_[data_op_index]->GetName()];
+  GE_CHECK_NOTNULL(input_tensor_desc);
+  GE_CHECK_NOTNULL(output_tensor_desc);
 
-  uint8_t *src_data = reinterpret_cast<uint8_t *>(data[data_index].data);
+  uint8_t *src_data = reinterpret_cast<uint8_t *>(data_buf.data);
 
-  formats::TransResult tmp_result{};
   auto input_shape = input_tensor_desc->GetShape();
   auto src_data_size = input_shape.GetShapeSize();
   auto src_data_type = input_tensor_desc->GetDataType();
@@ -1132,7 +1104,7 @@ Status DavinciModel::CopyTransData(const std::vector<DataBuffer> &data, uint32_t
          TypeUtils::DataTypeToSerialString(dst_data_type).c_str(), formats::ShapeToString(input_shape).c_str(),
          src_data_size);
   auto ret =
-      formats::TransDataType({src_data, static_cast<size_t>(src_data_size), src_data_type, dst_data_type}, tmp_result);
+      formats::TransDataType({src_data, static_cast<size_t>(src_data_size), src_data_type, dst_data_type}, result);
   if (ret != SUCCESS) {
     GELOGE(INTERNAL_ERROR, "Failed to trans data type from %s to %s, input shape %s, data size %zu, error code %d",
            TypeUtils::DataTypeToSerialString(src_data_type).c_str(),
@@ -1140,16 +1112,6 @@ Status DavinciModel::CopyTransData(const std::vector<DataBuffer> &data, uint32_t
            src_data_size, ret);
     return ret;
   }
-
-  void *mem_addr = mem_base_ + outputs[0];
-  auto rt_ret = rtMemcpy(mem_addr, runtime_param_.mem_size - outputs[0], tmp_result.data.get(), tmp_result.length,
-                         RT_MEMCPY_HOST_TO_DEVICE);
-  if (rt_ret != RT_ERROR_NONE) {
-    GELOGE(RT_FAILED, "Failed to copy memory to device, size %zu", tmp_result.length);
-    return RT_FAILED;
-  }
-  GELOGI("[IMAS]CopyTransData memcpy graph_%u type[F] name[%s] output[%d] datasize[%zu]", runtime_param_.graph_id,
-         data_op_list_[data_op_index]->GetName().c_str(), 0, tmp_result.length);
   return SUCCESS;
 }
 
@@ -1458,6 +1420,8 @@ void *DavinciModel::Run(DavinciModel *model) {
     GE_IF_BOOL_EXEC(!model->RunFlag(), break);
 
     InputData current_data = data_wrapper->GetInput();
+    TraceRequestScope request_scope(current_data.request_id);
+    GE_TRACE_SCOPE("DavinciModel::Run");
     GELOGI("Model thread Run begin, model id:%u, data index:%d.", model_id, current_data.index);
 
     GE_TIMESTAMP_START(Model_SyncVarData);
@@ -1484,7 +1448,7 @@ void *DavinciModel::Run(DavinciModel *model) {
           (void)ProfilingManager::Instance().StartProfiling(i);  // just profiling, no need to check value
         }
         // collect profiling for ge
-        ProfilingManager::Instance().ReportProfilingData(model->GetTaskIdOpName());
+        ProfilingManager::Instance().ReportProfilingData(model_id, current_data.index, model->GetTaskIdOpName());
         GELOGI("rtModelExecute start.");
         rtError_t rt_ret_prof_on = rtModelExecute(model->rt_model_handle_, model->rt_model_stream_, 0);
         GE_IF_BOOL_EXEC(rt_ret_prof_on != RT_ERROR_NONE, rslt_flg = false; (void)model->ReturnResult(
@@ -1529,7 +1493,7 @@ void *DavinciModel::Run(DavinciModel *model) {
 
       // collect profiling for ge
       if (ProfilingManager::Instance().ProfilingOn()) {
-        ProfilingManager::Instance().ReportProfilingData(model->GetTaskIdOpName());
+        ProfilingManager::Instance().ReportProfilingData(model_id, current_data.index, model->GetTaskIdOpName());
       }
     }
 
@@ -1552,6 +1516,115 @@ void *DavinciModel::Run(DavinciModel *model) {
   return nullptr;
 }
 
+///
+/// @ingroup domi_ome
+/// @brief model thread of the pipelined run mode. The input copy of a request runs on the input stream while the
+///        model stream still executes the former request, and the output copy runs on the output stream while the
+///        model stream executes the next one. ReturnPipeline waits for the requests and returns the results.
+/// @param [in] model model to run
+///
+void *DavinciModel::RunPipeline(DavinciModel *model) {
+  GE_CHK_BOOL_EXEC(model != nullptr,
+                   CsaInteract::GetInstance().WriteErrorCode(FAILED, ERROR_MODULE_FMK, JOBSUBSTATE_GRAPH_EXEC);
+                   return nullptr, "model_pointer is null!")
+  uint32_t model_id = model->Id();
+  uint32_t device_id = model->GetDeviceId();
+
+  GELOGI("Model Run pipeline thread start, model_id:%u", model_id);
+  rtError_t rt_ret = rtSetDevice(static_cast<int32_t>(device_id));
+  if (rt_ret != RT_ERROR_NONE) {
+    GELOGE(FAILED, "Model run rtsetdevice failed.");
+    return nullptr;
+  }
+  // DeviceReset before thread run finished!
+  GE_MAKE_GUARD(not_used_var, [&] { GE_CHK_RT(rtDeviceReset(device_id)); });
+
+  while (model->RunFlag()) {
+    if (model->GetDataInputer() == nullptr) {
+      GELOGW("Data inputer is nullptr.");
+      CsaInteract::GetInstance().StoreInternalErrorCode(FAILED, ERROR_MODULE_FMK, JOBSUBSTATE_GRAPH_EXEC);
+      break;
+    }
+
+    std::shared_ptr<InputDataWrapper> data_wrapper;
+    Status ret = model->GetDataInputer()->Pop(data_wrapper);
+    if (data_wrapper == nullptr || ret != SUCCESS) {
+      GELOGI("data_wrapper is null!");
+      continue;
+    }
+
+    GE_IF_BOOL_EXEC(!model->RunFlag(), break);
+
+    size_t slot_id = model->AcquirePipelineSlot();
+    PipelineSlot &slot = model->pipeline_slots_[slot_id];
+    slot.data_wrapper = data_wrapper;
+    TraceRequestScope request_scope(data_wrapper->GetInput().request_id);
+    GE_TRACE_SCOPE("DavinciModel::LaunchPipelineSlot");
+    GELOGI("Model thread Run begin, model id:%u, data index:%u, slot:%zu.", model_id, data_wrapper->GetInput().index,
+           slot_id);
+
+    slot.result = model->LaunchPipelineSlot(slot);
+    if (slot.result != SUCCESS) {
+      GELOGE(slot.result, "Launch request failed, model id:%u, data index:%u.", model_id,
+             data_wrapper->GetInput().index);
+      CsaInteract::GetInstance().StoreInternalErrorCode(slot.result, ERROR_MODULE_FMK, JOBSUBSTATE_GRAPH_EXEC);
+      // the copies queued before the failure may still use the user buffers
+      GE_CHK_RT(rtStreamSynchronize(model->pipeline_input_stream_));
+      GE_CHK_RT(rtStreamSynchronize(model->rt_model_stream_));
+      GE_CHK_RT(rtStreamSynchronize(model->pipeline_output_stream_));
+    }
+    model->CommitPipelineSlot(slot_id);
+  }
+
+  CsaInteract::GetInstance().WriteInternalErrorCode();
+  GEEVENT("Model Run pipeline thread end, model_id:%u", model_id);
+  return nullptr;
+}
+
+void *DavinciModel::ReturnPipeline(DavinciModel *model) {
+  GE_CHK_BOOL_EXEC(model != nullptr, return nullptr, "model_pointer is null!")
+  uint32_t model_id = model->Id();
+  uint32_t device_id = model->GetDeviceId();
+
+  rtError_t rt_ret = rtSetDevice(static_cast<int32_t>(device_id));
+  if (rt_ret != RT_ERROR_NONE) {
+    GELOGE(FAILED, "Model return rtsetdevice failed.");
+    return nullptr;
+  }
+  // DeviceReset before thread run finished!
+  GE_MAKE_GUARD(not_used_var, [&] { GE_CHK_RT(rtDeviceReset(device_id)); });
+
+  size_t slot_id = 0;
+  while (model->WaitPipelineSlot(slot_id)) {
+    PipelineSlot &slot = model->pipeline_slots_[slot_id];
+    TraceRequestScope request_scope(slot.data_wrapper->GetInput().request_id);
+    GE_TRACE_SCOPE("DavinciModel::ReturnPipelineSlot");
+    uint32_t data_id = slot.data_wrapper->GetInput().index;
+    OutputData *output_data = slot.data_wrapper->GetOutput();
+    bool seq_end_flag = false;
+    bool rslt_flg = (slot.result == SUCCESS) && (model->WaitPipelineResult(slot, seq_end_flag) == SUCCESS);
+
+    if (!rslt_flg || (output_data == nullptr)) {
+      (void)model->ReturnResult(model_id, data_id, false, seq_end_flag, output_data);  // [No need to check value]
+    } else if (model->listener_ != nullptr) {
+      // the results are already in the user buffers
+      output_data->index = data_id;
+      output_data->model_id = model_id;
+      GE_CHK_STATUS(model->listener_->OnComputeDone(model_id, data_id, SUCCESS), "OnComputeDone failed");
+    }
+
+    if (rslt_flg && ProfilingManager::Instance().ProfilingOn()) {
+      ProfilingManager::Instance().ReportProfilingData(model_id, data_id, model->GetTaskIdOpName());
+    }
+
+    slot.data_wrapper = nullptr;
+    model->ReleasePipelineSlot(slot_id);
+  }
+
+  GEEVENT("Model Return pipeline thread end, model_id:%u", model_id);
+  return nullptr;
+}
+
 ///
 /// @ingroup domi_ome
 /// @brief call API provided by data inputer to destroy thread
@@ -1570,6 +1643,17 @@ Status DavinciModel::DestroyThread() {
     thread_id_.join();
   }
 
+  // the return thread leaves after the requests already launched are returned
+  {
+    std::lock_guard<std::mutex> lock(pipeline_mutex_);
+    pipeline_stop_ = true;
+  }
+  pipeline_cond_.notify_all();
+  if (pipeline_return_thread_.joinable()) {
+    pipeline_return_thread_.join();
+  }
+  DestroyPipeline();
+
   return SUCCESS;
 }
 
@@ -1603,7 +1687,13 @@ Status DavinciModel::ModelRunStart() {
   int64_t maxDumpOpNum = std::strtol(opt.c_str(), nullptr, kDecimal);
   maxDumpOpNum_ = maxDumpOpNum;
 
-  CREATE_STD_THREAD(thread_id_, DavinciModel::Run, this);
+  GE_CHK_STATUS_RET(InitPipeline(), "Init pipeline failed, model id:%u", model_id_);
+  if (pipeline_depth_ > 0) {
+    CREATE_STD_THREAD(pipeline_return_thread_, DavinciModel::ReturnPipeline, this);
+    CREATE_STD_THREAD(thread_id_, DavinciModel::RunPipeline, this);
+  } else {
+    CREATE_STD_THREAD(thread_id_, DavinciModel::Run, this);
+  }
   GELOGI("model tread create success, model id:%u", model_id_);
   return SUCCESS;
 }
@@ -1629,6 +1719,282 @@ Status DavinciModel::ModelRunStop() {
   return SUCCESS;
 }
 
+///
+/// @ingroup domi_ome
+/// @brief allocate the staging slots of the pipelined run mode when OPTION_EXEC_MODEL_PIPELINE_DEPTH asks for it.
+///        Models the mode does not fit keep running the requests one after another.
+/// @return Status result
+///
+Status DavinciModel::InitPipeline() {
+  pipeline_depth_ = 0;
+  pipeline_stop_ = false;
+  string opt = "0";
+  (void)ge::GetContext().GetOption(OPTION_EXEC_MODEL_PIPELINE_DEPTH, opt);  // option may not be set up
+  int64_t depth = std::strtol(opt.c_str(), nullptr, kDecimal);
+  if (depth < kMinPipelineDepth) {
+    return SUCCESS;
+  }
+  if (depth > kMaxPipelineDepth) {
+    GELOGW("Pipeline depth %ld is larger than %ld, model id:%u", depth, kMaxPipelineDepth, model_id_);
+    depth = kMaxPipelineDepth;
+  }
+
+  // variables are synchronized and dumped between two requests, which needs the model to be idle
+  bool supported = !output_op_list_.empty() && variable_op_list_.empty() && !support_mem_shared_flag_ &&
+                   !ProfilingManager::Instance().ProfilingOpTraceOn();
+  uint64_t input_size = 0;
+  uint64_t output_size = 0;
+  if (supported) {
+    GE_CHK_STATUS_RET(InitPipelineInputs(input_size, supported), "Init pipeline inputs failed.");
+  }
+  if (!supported) {
+    GELOGW("Model %u does not support pipelined run, run the requests one after another.", model_id_);
+    pipeline_inputs_.clear();
+    return SUCCESS;
+  }
+  // what is created before a failure is destroyed
+  GE_MAKE_GUARD(pipeline, [this] { DestroyPipeline(); });
+  GE_CHK_STATUS_RET(InitPipelineOutputs(output_size), "Init pipeline outputs failed.");
+
+  GE_CHK_RT_RET(rtStreamCreate(&pipeline_input_stream_, priority_));
+  GE_CHK_RT_RET(rtStreamCreate(&pipeline_output_stream_, priority_));
+  pipeline_slots_.resize(static_cast<size_t>(depth));
+  for (size_t i = 0; i < pipeline_slots_.size(); ++i) {
+    PipelineSlot &slot = pipeline_slots_[i];
+    if (input_size > 0) {
+      GE_CHK_RT_RET(rtMallocHost(reinterpret_cast<void **>(&slot.input_host), input_size));
+      GE_CHK_RT_RET(rtMalloc(reinterpret_cast<void **>(&slot.input_mem), input_size, RT_MEMORY_HBM));
+    }
+    if (output_size > 0) {
+      GE_CHK_RT_RET(rtMallocHost(reinterpret_cast<void **>(&slot.output_host), output_size));
+      GE_CHK_RT_RET(rtMalloc(reinterpret_cast<void **>(&slot.output_mem), output_size, RT_MEMORY_HBM));
+    }
+    GE_CHK_RT_RET(rtEventCreate(&slot.input_ready));
+    GE_CHK_RT_RET(rtEventCreate(&slot.output_ready));
+    GE_CHK_RT_RET(rtEventCreate(&slot.output_done));
+    slot.input_lengths.assign(pipeline_inputs_.size(), 0);
+    free_pipeline_slots_.push_back(i);
+  }
+  GE_DISMISS_GUARD(pipeline);
+  pipeline_depth_ = static_cast<uint32_t>(depth);
+  GEEVENT("Model %u keeps %u requests in flight, staging memory of a request: input %lu, output %lu.", model_id_,
+          pipeline_depth_, input_size, output_size);
+  return SUCCESS;
+}
+
+Status DavinciModel::InitPipelineInputs(uint64_t &total_size, bool &supported) {
+  pipeline_inputs_.clear();
+  for (size_t i = 0; i < data_op_list_.size(); ++i) {
+    auto op_desc = data_op_list_[i];
+    GE_CHECK_NOTNULL(op_desc);
+    GE_CHECK_NOTNULL(op_desc->GetOutputDescPtr(0));
+    uint32_t data_index = static_cast<uint32_t>(i);
+    (void)AttrUtils::GetInt(op_desc, "index", data_index);
+
+    bool need_memset = false;
+    (void)AttrUtils::GetBool(op_desc, "_need_memset", need_memset);
+    vector<GeAttrValue::INT> outputs = op_desc->GetOutputOffset();
+    if (need_memset || outputs.empty() || VarManager::Instance(session_id_)->IsVarAddr(outputs[0])) {
+      GELOGI("Data op %s is not staged, model id:%u", op_desc->GetName().c_str(), model_id_);
+      supported = false;
+      return SUCCESS;
+    }
+
+    uint32_t output_size = 0;
+    GE_CHK_STATUS_RET(TensorUtils::GetSize(*op_desc->GetOutputDescPtr(0), output_size), "get output size failed.");
+    GE_CHK_BOOL_RET_STATUS(static_cast<uint64_t>(outputs[0]) + output_size <= TotalMemSize(), INTERNAL_ERROR,
+                           "input offset add size is large than total memory.");
+    pipeline_inputs_.push_back({mem_base_ + outputs[0], output_size, total_size, data_index});
+    total_size += (static_cast<uint64_t>(output_size) + MEM_ALIGN_SIZE - 1) / MEM_ALIGN_SIZE * MEM_ALIGN_SIZE;
+  }
+  return SUCCESS;
+}
+
+Status DavinciModel::InitPipelineOutputs(uint64_t &total_size) {
+  pipeline_outputs_.clear();
+  uint32_t data_index = 0;
+  for (auto &op_desc : output_op_list_) {
+    Output model_output(op_desc, this);
+    GE_CHK_STATUS_RET(model_output.Init(), "Init output failed, op name: %s", op_desc->GetName().c_str());
+    vector<void *> addrs;
+    vector<uint32_t> sizes;
+    model_output.GetOutputData(addrs, sizes);
+    for (size_t i = 0; i < addrs.size(); ++i) {
+      auto tensor_desc = op_desc->GetInputDescPtr(static_cast<uint32_t>(i));
+      GE_CHECK_NOTNULL(tensor_desc);
+      uint32_t size = sizes[i];
+      GE_CHK_BOOL_RET_STATUS(TensorUtils::GetTensorSizeInBytes(*tensor_desc, size) == GRAPH_SUCCESS, FAILED,
+                             "GetTensorSizeInBytes failed, op name: %s", op_desc->GetName().c_str());
+      pipeline_outputs_.push_back({addrs[i], size, total_size, data_index++});
+      total_size += (static_cast<uint64_t>(size) + MEM_ALIGN_SIZE - 1) / MEM_ALIGN_SIZE * MEM_ALIGN_SIZE;
+    }
+  }
+  return SUCCESS;
+}
+
+void DavinciModel::DestroyPipeline() {
+  for (auto &slot : pipeline_slots_) {
+    GE_IF_BOOL_EXEC(slot.input_host != nullptr, GE_CHK_RT(rtFreeHost(slot.input_host)));
+    GE_IF_BOOL_EXEC(slot.output_host != nullptr, GE_CHK_RT(rtFreeHost(slot.output_host)));
+    GE_IF_BOOL_EXEC(slot.input_mem != nullptr, GE_CHK_RT(rtFree(slot.input_mem)));
+    GE_IF_BOOL_EXEC(slot.output_mem != nullptr, GE_CHK_RT(rtFree(slot.output_mem)));
+    GE_IF_BOOL_EXEC(slot.input_ready != nullptr, GE_CHK_RT(rtEventDestroy(slot.input_ready)));
+    GE_IF_BOOL_EXEC(slot.output_ready != nullptr, GE_CHK_RT(rtEventDestroy(slot.output_ready)));
+    GE_IF_BOOL_EXEC(slot.output_done != nullptr, GE_CHK_RT(rtEventDestroy(slot.output_done)));
+  }
+  pipeline_slots_.clear();
+  free_pipeline_slots_.clear();
+  busy_pipeline_slots_.clear();
+  pipeline_inputs_.clear();
+  pipeline_outputs_.clear();
+
+  GE_IF_BOOL_EXEC(pipeline_input_stream_ != nullptr, GE_CHK_RT(rtStreamDestroy(pipeline_input_stream_)));
+  GE_IF_BOOL_EXEC(pipeline_output_stream_ != nullptr, GE_CHK_RT(rtStreamDestroy(pipeline_output_stream_)));
+  pipeline_input_stream_ = nullptr;
+  pipeline_output_stream_ = nullptr;
+  pipeline_depth_ = 0;
+}
+
+Status DavinciModel::LaunchPipelineSlot(PipelineSlot &slot) {
+  const InputData &input_data = slot.data_wrapper->GetInput();
+  GE_CHK_BOOL_RET_STATUS(input_data.blobs.size() == data_op_list_.size(), PARAM_INVALID,
+                         "The input data list size (%zu) does not match the model input list size (%zu)",
+                         input_data.blobs.size(), data_op_list_.size());
+
+  // inputs: user buffers -> pinned staging memory -> device staging memory, the copy to device waits for nothing
+  // but the former user of the slot, which is returned before the slot is taken again
+  for (size_t i = 0; i < pipeline_inputs_.size(); ++i) {
+    const PipelineTensor &tensor = pipeline_inputs_[i];
+    GE_CHK_BOOL_RET_STATUS(tensor.data_index < input_data.blobs.size(), PARAM_INVALID, "index:%u >= size:%zu",
+                           tensor.data_index, input_data.blobs.size());
+    const DataBuffer &data_buf = input_data.blobs[tensor.data_index];
+    const void *src_addr = data_buf.data;
+    uint64_t length = data_buf.length;
+    formats::TransResult trans_result{};
+    if (ModelUtils::IsInputTensorNeedTrans(data_op_list_[i], 0)) {
+      GE_CHK_STATUS_RET_NOLOG(TransInputData(data_buf, static_cast<uint32_t>(i), trans_result));
+      src_addr = trans_result.data.get();
+      length = trans_result.length;
+    }
+    GE_CHK_BOOL_RET_STATUS(length <= tensor.size, PARAM_INVALID,
+                           "input data size(%lu) does not match model required size(%u), ret fail.", length,
+                           tensor.size);
+    slot.input_lengths[i] = static_cast<uint32_t>(length);
+    if (length > 0) {
+      errno_t ret = memcpy_s(slot.input_host + tensor.offset, tensor.size, src_addr, length);
+      GE_CHK_BOOL_RET_STATUS(ret == EOK, INTERNAL_ERROR, "Copy input %zu to the staging memory failed.", i);
+      GE_CHK_RT_RET(rtMemcpyAsync(slot.input_mem + tensor.offset, tensor.size, slot.input_host + tensor.offset,
+                                  length, RT_MEMCPY_HOST_TO_DEVICE, pipeline_input_stream_));
+    }
+  }
+  GE_CHK_RT_RET(rtEventRecord(slot.input_ready, pipeline_input_stream_));
+
+  // model stream: staging memory -> model inputs, execute, model outputs -> staging memory
+  GE_CHK_RT_RET(rtStreamWaitEvent(rt_model_stream_, slot.input_ready));
+  for (size_t i = 0; i < pipeline_inputs_.size(); ++i) {
+    const PipelineTensor &tensor = pipeline_inputs_[i];
+    if (slot.input_lengths[i] > 0) {
+      GE_CHK_RT_RET(rtMemcpyAsync(tensor.model_addr, tensor.size, slot.input_mem + tensor.offset,
+                                  slot.input_lengths[i], RT_MEMCPY_DEVICE_TO_DEVICE, rt_model_stream_));
+    }
+  }
+  GE_CHK_RT_RET(rtModelExecute(rt_model_handle_, rt_model_stream_, 0));
+  for (const auto &tensor : pipeline_outputs_) {
+    if (tensor.size > 0) {
+      GE_CHK_RT_RET(rtMemcpyAsync(slot.output_mem + tensor.offset, tensor.size, tensor.model_addr, tensor.size,
+                                  RT_MEMCPY_DEVICE_TO_DEVICE, rt_model_stream_));
+    }
+  }
+  GE_CHK_RT_RET(rtEventRecord(slot.output_ready, rt_model_stream_));
+
+  // outputs: device staging memory -> pinned staging memory, overlaps the execution of the next request. The
+  // return thread copies them to the user buffers
+  OutputData *output_data = slot.data_wrapper->GetOutput();
+  GE_CHECK_NOTNULL(output_data);
+  GE_CHK_RT_RET(rtStreamWaitEvent(pipeline_output_stream_, slot.output_ready));
+  for (const auto &tensor : pipeline_outputs_) {
+    GE_CHK_BOOL_RET_STATUS(tensor.data_index < output_data->blobs.size(), PARAM_INVALID, "index:%u >= size:%zu",
+                           tensor.data_index, output_data->blobs.size());
+    const DataBuffer &data_buf = output_data->blobs[tensor.data_index];
+    if ((data_buf.length == 0) || (tensor.size == 0)) {
+      continue;
+    }
+    GE_CHK_BOOL_RET_STATUS(tensor.size <= data_buf.length, PARAM_INVALID,
+                           "output data size(%lu) is smaller than the model output size(%u).", data_buf.length,
+                           tensor.size);
+    GE_CHK_RT_RET(rtMemcpyAsync(slot.output_host + tensor.offset, tensor.size, slot.output_mem + tensor.offset,
+                                tensor.size, RT_MEMCPY_DEVICE_TO_HOST, pipeline_output_stream_));
+  }
+  GE_CHK_RT_RET(rtEventRecord(slot.output_done, pipeline_output_stream_));
+  return SUCCESS;
+}
+
+Status DavinciModel::WaitPipelineResult(PipelineSlot &slot, bool &seq_end_flag) {
+  // the status of the execution, as the serial run gets it from the model stream
+  rtError_t model_ret = rtEventSynchronize(slot.output_ready);
+  // the copies to the staging memory are waited for even if the execution failed, the slot is reused next
+  rtError_t copy_ret = rtEventSynchronize(slot.output_done);
+  if (model_ret != RT_ERROR_NONE) {
+    seq_end_flag = (model_ret == RT_ERROR_END_OF_SEQUENCE);
+    GELOGI("seq_end_flg: %d", seq_end_flag);
+    CsaInteract::GetInstance().StoreInternalErrorCode(model_ret, ERROR_MODULE_RUNTIME, JOBSUBSTATE_GRAPH_EXEC);
+    return RT_FAILED;
+  }
+  if (copy_ret != RT_ERROR_NONE) {
+    GELOGE(RT_FAILED, "Copy outputs of model %u failed, ret: 0x%X", model_id_, copy_ret);
+    CsaInteract::GetInstance().StoreInternalErrorCode(copy_ret, ERROR_MODULE_RUNTIME, JOBSUBSTATE_GRAPH_EXEC);
+    return RT_FAILED;
+  }
+
+  OutputData *output_data = slot.data_wrapper->GetOutput();
+  GE_CHECK_NOTNULL(output_data);
+  for (const auto &tensor : pipeline_outputs_) {
+    const DataBuffer &data_buf = output_data->blobs[tensor.data_index];
+    if ((data_buf.length == 0) || (tensor.size == 0)) {
+      continue;
+    }
+    errno_t ret = memcpy_s(data_buf.data, data_buf.length, slot.output_host + tensor.offset, tensor.size);
+    GE_CHK_BOOL_RET_STATUS(ret == EOK, INTERNAL_ERROR, "Copy output %u to the user buffer failed.", tensor.data_index);
+  }
+  return SUCCESS;
+}
+
+size_t DavinciModel::AcquirePipelineSlot() {
+  std::unique_lock<std::mutex> lock(pipeline_mutex_);
+  // the return thread frees a slot as long as there are busy ones
+  pipeline_cond_.wait(lock, [this] { return !free_pipeline_slots_.empty(); });
+  size_t slot_id = free_pipeline_slots_.front();
+  free_pipeline_slots_.pop_front();
+  return slot_id;
+}
+
+void DavinciModel::CommitPipelineSlot(size_t slot_id) {
+  {
+    std::lock_guard<std::mutex> lock(pipeline_mutex_);
+    busy_pipeline_slots_.push_back(slot_id);
+  }
+  pipeline_cond_.notify_all();
+}
+
+bool DavinciModel::WaitPipelineSlot(size_t &slot_id) {
+  std::unique_lock<std::mutex> lock(pipeline_mutex_);
+  pipeline_cond_.wait(lock, [this] { return pipeline_stop_ || !busy_pipeline_slots_.empty(); });
+  if (busy_pipeline_slots_.empty()) {
+    return false;
+  }
+  slot_id = busy_pipeline_slots_.front();
+  busy_pipeline_slots_.pop_front();
+  return true;
+}
+
+void DavinciModel::ReleasePipelineSlot(size_t slot_id) {
+  {
+    std::lock_guard<std::mutex> lock(pipeline_mutex_);
+    free_pipeline_slots_.push_back(slot_id);
+  }
+  pipeline_cond_.notify_all();
+}
+
 void DavinciModel::UnbindTaskSinkStream() {
   // unbinding hcom stream
   UnbindHcomStream();
@@ -1648,9 +2014,6 @@ void DavinciModel::UnbindTaskSinkStream() {
 Status DavinciModel::InitTaskInfo(ModelTaskDef &model_task_def) {
   GELOGI("InitTaskInfo in,task size %zu", model_task_def.task().size());
   task_list_.resize(model_task_def.task_size());
-  std::vector<std::future<Status>> futures(model_task_def.task_size());
-  constexpr uint32_t thread_num = THREAD_NUM;
-  ThreadPool executor(thread_num);
   rtContext_t ctx = nullptr;
   rtError_t rt_ret = rtCtxGetCurrent(&ctx);
   if (rt_ret != RT_ERROR_NONE || ctx == nullptr) {
@@ -1658,33 +2021,30 @@ Status DavinciModel::InitTaskInfo(ModelTaskDef &model_task_def) {
     return RT_FAILED;
   }
 
-  for (int32_t i = 0; i < model_task_def.task_size(); ++i) {
-    futures[i] = executor.commit(
-        [](const domi::TaskDef &task, DavinciModel *model, rtContext_t ctx, int32_t idx) -> Status {
-          rtError_t ctx_ret = rtCtxSetCurrent(ctx);
-          if (ctx_ret != RT_ERROR_NONE) {
-            GELOGE(RT_FAILED, "Failed to set context from rt, error-code 0x%X.", ctx_ret);
-            return RT_FAILED;
+  // most tasks init in microseconds, so a range of them shares the context switch and the scheduling
+  Status ret = TaskExecutor::Instance().ParallelFor(
+      model_task_def.task_size(), kInitTaskGrainSize, [this, &model_task_def, ctx](size_t begin, size_t end) -> Status {
+        rtError_t ctx_ret = rtCtxSetCurrent(ctx);
+        if (ctx_ret != RT_ERROR_NONE) {
+          GELOGE(RT_FAILED, "Failed to set context from rt, error-code 0x%X.", ctx_ret);
+          return RT_FAILED;
+        }
+        for (size_t i = begin; i < end; ++i) {
+          const domi::TaskDef &task = model_task_def.task(static_cast<int32_t>(i));
+          task_list_[i] = TaskInfoFactory::Instance().Create(static_cast<rtModelTaskType_t>(task.type()));
+          Status init_ret = FAILED;
+          if (task_list_[i] != nullptr) {
+            init_ret = task_list_[i]->Init(task, this);
           }
-
-          model->task_list_[idx] = TaskInfoFactory::Instance().Create(static_cast<rtModelTaskType_t>(task.type()));
-
-          Status ret = FAILED;
-          if (model->task_list_[idx] != nullptr) {
-            ret = model->task_list_[idx]->Init(task, model);
+          if (init_ret != SUCCESS) {
+            GELOGE(init_ret, "Task index %zu init fail.", i);
+            return init_ret;
           }
-          return ret;
-        },
-        model_task_def.task(i), this, ctx, i);
-  }
-
-  Status ret;
-  for (size_t i = 0; i < futures.size(); ++i) {
-    ret = futures[i].get();
-    if (ret != SUCCESS) {
-      GELOGE(ret, "Task index %zu init fail.", i);
-      return ret;
-    }
+        }
+        return SUCCESS;
+      });
+  if (ret != SUCCESS) {
+    return ret;
   }
 
   GELOGI("InitTaskInfo out");
@@ -1771,9 +2131,10 @@ void DavinciModel::SetOutsideAddr(const std::vector<void *> &outside_addrs) {
 /// @return None.
 ///
 void DavinciModel::SetZeroCopyAddr(const std::vector<void *> &outside_addrs, void *args_offset) {
+  std::lock_guard<std::mutex> lock(outside_addrs_mutex_);
+  (void)zero_copy_args_begins_.insert(args_offset);
   size_t nums = outside_addrs.size();
   for (size_t i = 0; i < nums; ++i) {
-    std::lock_guard<std::mutex> lock(outside_addrs_mutex_);
     auto it = outside_addrs_.find(outside_addrs[i]);
     if (it == outside_addrs_.end()) {
       continue;
@@ -1784,24 +2145,143 @@ void DavinciModel::SetZeroCopyAddr(const std::vector<void *> &outside_addrs, voi
   }
 }
 
+///
+/// @ingroup domi_ome
+/// @brief Cache the Data and NetOutput info for ZeroCopy, group the args slots to patch into copies.
+///        The slots are kept in one host mirror ordered by address, adjacent slots of a task share one copy.
+/// @return SUCCESS handle successfully / others handle failed
+///
+Status DavinciModel::InitZeroCopy() {
+  zero_copy_inputs_.clear();
+  zero_copy_outputs_.clear();
+  zero_copy_mirror_.clear();
+  zero_copy_runs_.clear();
+  zero_copy_slot_runs_.clear();
+
+  for (size_t i = 0; i < data_op_list_.size(); ++i) {
+    auto op_desc = data_op_list_[i];
+    GE_CHK_BOOL_EXEC(op_desc != nullptr, return PARAM_INVALID, "op_desc is null!");
+    GE_CHK_BOOL_RET_STATUS(op_desc->GetInputsSize() == 1 && op_desc->GetOutputsSize() == 1, PARAM_INVALID,
+                           "Data Op has invalid input_desc_size(%zu) or output_desc_size(%zu)",
+                           op_desc->GetInputsSize(), op_desc->GetOutputsSize());
+
+    ZeroCopyTensor tensor = {nullptr, 0, static_cast<uint32_t>(i), nullptr, {}};
+    if (AttrUtils::GetInt(op_desc, "index", tensor.data_index)) {
+      GELOGI("ge_train:get new index %u , old %zu", tensor.data_index, i);
+    }
+    GE_CHK_STATUS(TensorUtils::GetSize(*op_desc->GetInputDescPtr(0), tensor.size), "get input size failed.");
+    const vector<void *> &outputs = ModelUtils::GetOutputDataAddrs(runtime_param_, op_desc);
+    if (!outputs.empty()) {
+      tensor.model_addr = outputs[0];
+    }
+    zero_copy_inputs_.push_back(tensor);
+  }
+
+  uint32_t output_data_index = 0;
+  for (auto &op_desc : output_op_list_) {
+    Output model_output(op_desc, this);
+    GE_CHK_BOOL_RET_STATUS(model_output.Init() == SUCCESS, PARAM_INVALID, "init model_output failed");
+    vector<uint32_t> v_output_size = ModelUtils::GetInputSize(op_desc);
+    vector<void *> v_output_data_addr = ModelUtils::GetInputDataAddrs(runtime_param_, op_desc);
+    GE_CHK_BOOL_RET_STATUS(op_desc->GetOutputsSize() <= v_output_size.size() &&
+                               op_desc->GetOutputsSize() <= v_output_data_addr.size(),
+                           PARAM_INVALID, "NetOutput %s has %zu outputs but %zu input sizes and %zu input addrs.",
+                           op_desc->GetName().c_str(), op_desc->GetOutputsSize(), v_output_size.size(),
+                           v_output_data_addr.size());
+    for (size_t i = 0; i < op_desc->GetOutputsSize(); ++i) {
+      zero_copy_outputs_.push_back({v_output_data_addr[i], v_output_size[i], output_data_index++, nullptr, {}});
+    }
+  }
+
+  // a slot holds the address of one tensor, when tensors share an address the outputs win as they are patched last
+  std::vector<ZeroCopyTensor *> tensors;
+  for (auto &tensor : zero_copy_inputs_) {
+    tensors.push_back(&tensor);
+  }
+  for (auto &tensor : zero_copy_outputs_) {
+    tensors.push_back(&tensor);
+  }
+  std::map<void *, ZeroCopyTensor *> slot_tensors;
+  for (auto tensor : tensors) {
+    tensor->user_addr = const_cast<void *>(tensor->model_addr);
+    auto it = outside_addrs_.find(tensor->model_addr);
+    if ((tensor->model_addr == nullptr) || (it == outside_addrs_.end())) {
+      continue;
+    }
+    for (auto slot : it->second) {
+      slot_tensors[slot] = tensor;
+    }
+  }
+
+  const void *run_end = nullptr;
+  for (const auto &slot_tensor : slot_tensors) {
+    if ((slot_tensor.first != run_end) || (zero_copy_args_begins_.count(slot_tensor.first) > 0)) {
+      zero_copy_runs_.push_back({slot_tensor.first, zero_copy_mirror_.size(), zero_copy_mirror_.size()});
+    }
+    slot_tensor.second->slots.push_back(zero_copy_mirror_.size());
+    zero_copy_slot_runs_.push_back(zero_copy_runs_.size() - 1);
+    // the task wrote the model address to the slot at init
+    zero_copy_mirror_.push_back(slot_tensor.second->user_addr);
+    zero_copy_runs_.back().end = zero_copy_mirror_.size();
+    run_end = static_cast<char *>(slot_tensor.first) + sizeof(void *);
+  }
+
+  GELOGI("Init zero copy of model %u: %zu inputs, %zu outputs, %zu args slots in %zu copies.", model_id_,
+         zero_copy_inputs_.size(), zero_copy_outputs_.size(), zero_copy_mirror_.size(), zero_copy_runs_.size());
+  return SUCCESS;
+}
+
 ///
 /// @ingroup domi_ome
 /// @brief Copy Inputs and Outputs addr to model for direct use.
+///        Only the copies holding a slot whose address changed since the former request are issued.
 /// @param [in] const domi::InputData &input_data: model input data.
 /// @param [in] domi::OutputData &output_data: model output data.
 /// @return SUCCESS handle successfully / PARAM_INVALID for failed
 ///
 Status DavinciModel::ModelZeroCopy(const InputData &input_data, OutputData &output_data) {
-  if (ZeroCopyInput(input_data) != SUCCESS) {
+  // the mirror may be ahead of the args after a failure, write every slot again with the next request
+  auto reset_user_addrs = [this]() {
+    for (auto &tensor : zero_copy_inputs_) {
+      tensor.user_addr = nullptr;
+    }
+    for (auto &tensor : zero_copy_outputs_) {
+      tensor.user_addr = nullptr;
+    }
+  };
+
+  std::vector<bool> dirty_runs(zero_copy_runs_.size(), false);
+  size_t patch_num = 0;
+  if (ZeroCopyInput(input_data, dirty_runs, patch_num) != SUCCESS) {
     GELOGE(PARAM_INVALID, "ZeroCopyInput failed.");
+    reset_user_addrs();
     return PARAM_INVALID;
   }
 
-  if (ZeroCopyOutput(output_data) != SUCCESS) {
+  if (ZeroCopyOutput(output_data, dirty_runs, patch_num) != SUCCESS) {
     GELOGE(PARAM_INVALID, "ZeroCopyOutput failed.");
+    reset_user_addrs();
     return PARAM_INVALID;
   }
 
+  size_t copy_num = 0;
+  for (size_t i = 0; i < zero_copy_runs_.size(); ++i) {
+    if (!dirty_runs[i]) {
+      continue;
+    }
+    const ZeroCopyRun &run = zero_copy_runs_[i];
+    uint64_t size = (run.end - run.begin) * sizeof(void *);
+    rtError_t rt_err = rtMemcpy(run.args_addr, size, &zero_copy_mirror_[run.begin], size, RT_MEMCPY_HOST_TO_DEVICE);
+    if (rt_err != RT_ERROR_NONE) {
+      GELOGE(FAILED, "ZeroCopy: rtMemcpy of %zu args failed.", run.end - run.begin);
+      reset_user_addrs();
+      return PARAM_INVALID;
+    }
+    ++copy_num;
+  }
+  GELOGD("ZeroCopy of model %u: %zu args patched, %zu copies of %zu.", model_id_, patch_num, copy_num,
+         zero_copy_runs_.size());
+
   output_data.index = input_data.index;
   output_data.model_id = model_id_;
   return SUCCESS;
@@ -1811,41 +2291,29 @@ Status DavinciModel::ModelZeroCopy(const InputData &input_data, OutputData &outp
 /// @ingroup domi_ome
 /// @brief Copy Data addr to model for direct use.
 /// @param [in] const domi::InputData &input_data: model input data info.
+/// @param [out] std::vector<bool> &dirty_runs: copies to issue.
+/// @param [out] size_t &patch_num: number of args slots patched.
 /// @return SUCCESS handle successfully / others handle failed
 ///
-Status DavinciModel::ZeroCopyInput(const InputData &input_data) {
-  GE_CHK_BOOL_RET_STATUS(!data_op_list_.empty(), SUCCESS, "data_op_list_ is empty!");
-  GE_CHK_BOOL_RET_STATUS(data_op_list_.size() == input_data.blobs.size(), PARAM_INVALID,
+Status DavinciModel::ZeroCopyInput(const InputData &input_data, std::vector<bool> &dirty_runs, size_t &patch_num) {
+  GE_CHK_BOOL_RET_STATUS(!zero_copy_inputs_.empty(), SUCCESS, "data_op_list_ is empty!");
+  GE_CHK_BOOL_RET_STATUS(zero_copy_inputs_.size() == input_data.blobs.size(), PARAM_INVALID,
                          "The input data list size (%zu) does not match the model input list size (%zu)",
-                         input_data.blobs.size(), data_op_list_.size());
+                         input_data.blobs.size(), zero_copy_inputs_.size());
 
   const std::vector<DataBuffer> &blobs = input_data.blobs;
-  for (size_t data_op_index = 0; data_op_index < data_op_list_.size(); ++data_op_index) {
-    auto op_desc = data_op_list_[data_op_index];
-    GE_CHK_BOOL_EXEC(op_desc != nullptr, return PARAM_INVALID, "op_desc is null!");
-
-    auto data_index = static_cast<uint32_t>(data_op_index);
-    if (AttrUtils::GetInt(op_desc, "index", data_index)) {
-      GELOGI("ge_train:get new index %u , old %zu", data_index, data_op_index);
-    }
-    GE_CHK_BOOL_EXEC(data_index < blobs.size(), return PARAM_INVALID, "index:%u >= size:%zu", data_index, blobs.size());
-    GE_CHK_BOOL_RET_STATUS(op_desc->GetInputsSize() == 1 && op_desc->GetOutputsSize() == 1, PARAM_INVALID,
-                           "Data Op has invalid input_desc_size(%zu) or output_desc_size(%zu)",
-                           op_desc->GetInputsSize(), op_desc->GetOutputsSize());
-
-    uint32_t input_size = 0;
-    const DataBuffer &data_buf = blobs[data_index];
-    GE_CHK_STATUS(TensorUtils::GetSize(*op_desc->GetInputDescPtr(0), input_size), "get input size failed.");
-    GE_CHK_BOOL_RET_STATUS(input_size >= data_buf.length, PARAM_INVALID,
+  for (auto &tensor : zero_copy_inputs_) {
+    GE_CHK_BOOL_EXEC(tensor.data_index < blobs.size(), return PARAM_INVALID, "index:%u >= size:%zu",
+                     tensor.data_index, blobs.size());
+    const DataBuffer &data_buf = blobs[tensor.data_index];
+    GE_CHK_BOOL_RET_STATUS(tensor.size >= data_buf.length, PARAM_INVALID,
                            "input data size(%u) does not match model required size(%u), ret fail.", data_buf.length,
-                           input_size);
-
-    const vector<void *> &outputs = ModelUtils::GetOutputDataAddrs(runtime_param_, op_desc);
+                           tensor.size);
     if (data_buf.data == nullptr) {
       GELOGE(INTERNAL_ERROR, "data_buf.data is nullptr");
       return INTERNAL_ERROR;
     }
-    if (!outputs.empty() && ZeroCopyImpl(outputs[0], data_buf) != SUCCESS) {
+    if ((tensor.model_addr != nullptr) && (ZeroCopyImpl(tensor, data_buf, dirty_runs, patch_num) != SUCCESS)) {
       return FAILED;
     }
   }
@@ -1857,39 +2325,25 @@ Status DavinciModel::ZeroCopyInput(const InputData &input_data) {
 /// @ingroup domi_ome
 /// @brief Copy NetOutput addr to model for direct use.
 /// @param [in] const domi::OutputData &output_data: model output data info.
+/// @param [out] std::vector<bool> &dirty_runs: copies to issue.
+/// @param [out] size_t &patch_num: number of args slots patched.
 /// @return SUCCESS handle successfully / others handle failed
 ///
-Status DavinciModel::ZeroCopyOutput(const OutputData &output_data) {
+Status DavinciModel::ZeroCopyOutput(const OutputData &output_data, std::vector<bool> &dirty_runs, size_t &patch_num) {
   GE_CHK_BOOL_RET_STATUS(output_data.blobs.size() == output_size_list_.size(), INTERNAL_ERROR,
                          "output buffer size[%zu] not equal output_size_list[%zu] size!", output_data.blobs.size(),
                          output_size_list_.size());
 
-  // index of data in output_data
-  uint32_t output_data_index = 0;
   const std::vector<DataBuffer> &blobs = output_data.blobs;
-  for (auto &op_desc : output_op_list_) {
-    Output model_output(op_desc, this);
-    GE_CHK_BOOL_RET_STATUS(model_output.Init() == SUCCESS, PARAM_INVALID, "init model_output failed");
-    vector<uint32_t> v_output_size = ModelUtils::GetInputSize(op_desc);
-    vector<void *> v_output_data_addr = ModelUtils::GetInputDataAddrs(runtime_param_, op_desc);
-
-    // for all output tensor, copy output data from op to designated position
-    for (size_t i = 0; i < op_desc->GetOutputsSize(); ++i) {
-      GE_CHK_BOOL_RET_STATUS(output_data_index < blobs.size(), PARAM_INVALID,
-                             "The blobs size:%zu, data_op size:%zu, curr output size:%zu", blobs.size(),
-                             data_op_list_.size(), op_desc->GetOutputsSize());
-      const DataBuffer &data_buf = blobs[output_data_index];
-      output_data_index++;
-      uint32_t size = data_buf.length;
-      GE_CHK_BOOL_RET_STATUS(size <= v_output_size[i], PARAM_INVALID,
-                             "Model output data size(%u) does not match required size(%u).", v_output_size[i],
-                             data_buf.length);
-
-      GELOGI("ZeroCopyOutput memcpy graph_%u type[F] name[%s] output[%lu] memsize[%u] datasize[%u]",
-             runtime_param_.graph_id, op_desc->GetName().c_str(), i, data_buf.length, v_output_size[i]);
-      if (ZeroCopyImpl(v_output_data_addr[i], data_buf) != SUCCESS) {
-        return FAILED;
-      }
+  for (auto &tensor : zero_copy_outputs_) {
+    GE_CHK_BOOL_RET_STATUS(tensor.data_index < blobs.size(), PARAM_INVALID, "The blobs size:%zu, output index:%u",
+                           blobs.size(), tensor.data_index);
+    const DataBuffer &data_buf = blobs[tensor.data_index];
+    GE_CHK_BOOL_RET_STATUS(data_buf.length <= tensor.size, PARAM_INVALID,
+                           "Model output data size(%u) does not match required size(%u).", data_buf.length,
+                           tensor.size);
+    if (ZeroCopyImpl(tensor, data_buf, dirty_runs, patch_num) != SUCCESS) {
+      return FAILED;
     }
   }
 
@@ -1898,18 +2352,15 @@ Status DavinciModel::ZeroCopyOutput(const OutputData &output_data) {
 
 ///
 /// @ingroup domi_ome
-/// @brief Copy address to args_ space for direct use.
-/// @param [in] const void *src_addr: source address of the Op.
-/// @param [in] const void *dst_addr: destination address of user data.
+/// @brief Patch the user address into the host mirror of the args slots of the tensor.
+/// @param [in] ZeroCopyTensor &tensor: model input or output.
+/// @param [in] const DataBuffer &data_buf: user data.
+/// @param [out] std::vector<bool> &dirty_runs: copies holding a patched slot.
+/// @param [out] size_t &patch_num: number of args slots patched.
 /// @return SUCCESS handle successfully / others handle failed
 ///
-Status DavinciModel::ZeroCopyImpl(const void *src_addr, const DataBuffer &data_buf) {
-  auto it = outside_addrs_.find(src_addr);
-  if (it == outside_addrs_.end()) {
-    GELOGE(FAILED, "ZeroCopyImpl failed to find outside_addrs.");
-    return FAILED;
-  }
-
+Status DavinciModel::ZeroCopyImpl(ZeroCopyTensor &tensor, const DataBuffer &data_buf, std::vector<bool> &dirty_runs,
+                                  size_t &patch_num) {
   auto dst_addr = static_cast<uint8_t *>(data_buf.data);
   auto dst_size = static_cast<uint64_t>(data_buf.length);
   Status ret = ModelUtils::ConvertVirtualAddressToPhysical(dst_addr, dst_size, dst_addr);
@@ -1918,15 +2369,15 @@ Status DavinciModel::ZeroCopyImpl(const void *src_addr, const DataBuffer &data_b
     return FAILED;
   }
 
-  for (auto &addr : it->second) {
-    __builtin_prefetch(addr);
-    rtError_t rt_err = rtMemcpy(addr, sizeof(void *), &dst_addr, sizeof(void *), RT_MEMCPY_HOST_TO_DEVICE);
-    if (rt_err != RT_ERROR_NONE) {
-      GELOGE(FAILED, "ZeroCopyImpl: rtMemcpy failed");
-      return FAILED;
-    }
+  if (tensor.user_addr == dst_addr) {
+    return SUCCESS;
   }
-
+  tensor.user_addr = dst_addr;
+  for (auto slot : tensor.slots) {
+    zero_copy_mirror_[slot] = dst_addr;
+    dirty_runs[zero_copy_slot_runs_[slot]] = true;
+  }
+  patch_num += tensor.slots.size();
   return SUCCESS;
 }
 
@@ -2209,6 +2660,8 @@ Status DavinciModel::InitModelStream(rtStream_t stream, bool async_mode) {
 ///
 Status DavinciModel::NnExecute(rtStream_t stream, bool async_mode, const InputData &input_data,
                                OutputData &output_data) {
+  TraceRequestScope request_scope(input_data.request_id);
+  GE_TRACE_SCOPE("DavinciModel::NnExecute");
   GELOGI("Model Run begin, model id:%u, data index:%d, flag:%d.", model_id_, input_data.index, async_mode);
   GE_CHK_STATUS(InitModelStream(stream, async_mode), "Init model stream fail.");
 
@@ -2234,7 +2687,7 @@ Status DavinciModel::NnExecute(rtStream_t stream, bool async_mode, const InputDa
 
   // collect profiling for ge
   if (ProfilingManager::Instance().ProfilingOn()) {
-    ProfilingManager::Instance().ReportProfilingData(op_task_id_map_);
+    ProfilingManager::Instance().ReportProfilingData(model_id_, input_data.index, op_task_id_map_);
     GELOGI("Acl Profiling Op name taskId report.");
   }
 
@@ -2317,9 +2770,6 @@ uint32_t DavinciModel::GetGraphID(const std::string &session_graph_id) {
 Status DavinciModel::TransAllVarData(ComputeGraphPtr &graph, uint32_t graph_id) {
   GELOGI("TransAllVarData start: session_id:%lu, graph_id: %u.", session_id_, graph_id);
 
-  ThreadPool executor(THREAD_NUM);
-  std::vector<std::future<Status>> vector_future;
-
   rtContext_t ctx = nullptr;
   rtError_t rt_ret = rtCtxGetCurrent(&ctx);
   if (rt_ret != RT_ERROR_NONE) {
@@ -2327,6 +2777,7 @@ Status DavinciModel::TransAllVarData(ComputeGraphPtr &graph, uint32_t graph_id)
     return RT_FAILED;
   }
 
+  std::vector<ge::NodePtr> variables;
   for (ge::NodePtr &node : graph->GetDirectNode()) {
     if (node == nullptr) {
       continue;
@@ -2334,55 +2785,52 @@ Status DavinciModel::TransAllVarData(ComputeGraphPtr &graph, uint32_t graph_id)
     if (node->GetType() != VARIABLE) {
       continue;
     }
-    vector_future.push_back(executor.commit(
-        [](ge::NodePtr &node, DavinciModel *model, rtContext_t ctx, uint32_t graph_id) -> Status {
-          if (model == nullptr) {
-            GELOGE(FAILED, "DavinciModel is NULL!");
-            return FAILED;
-          }
-          rtError_t rt_ret = rtCtxSetCurrent(ctx);
-          if (rt_ret != RT_ERROR_NONE) {
-            GELOGE(RT_FAILED, "Failed to set context, error_code is: 0x%X.", rt_ret);
-            return RT_FAILED;
-          }
+    variables.push_back(node);
+  }
+
+  // every variable is transferred on its own, the transfers share the pinned buffers and streams
+  VarTransfer transfer;
+  Status ret_status = TaskExecutor::Instance().ParallelFor(
+      variables.size(), 1, [this, &variables, &transfer, ctx, graph_id](size_t begin, size_t end) -> Status {
+        rtError_t rt_ret = rtCtxSetCurrent(ctx);
+        if (rt_ret != RT_ERROR_NONE) {
+          GELOGE(RT_FAILED, "Failed to set context, error_code is: 0x%X.", rt_ret);
+          return RT_FAILED;
+        }
+        for (size_t i = begin; i < end; ++i) {
+          ge::NodePtr &node = variables[i];
           uint32_t allocated_graph_id = 0;
-          Status ret =
-              VarManager::Instance(model->session_id_)->GetAllocatedGraphId(node->GetName(), allocated_graph_id);
+          Status ret = VarManager::Instance(session_id_)->GetAllocatedGraphId(node->GetName(), allocated_graph_id);
           if (ret != SUCCESS) {
             GELOGE(INTERNAL_ERROR, "var has not been allocated, node:%s, graph_id:%u.", node->GetName().c_str(),
                    graph_id);
             return INTERNAL_ERROR;
           }
           uint32_t changed_graph_id = 0;
-          ret = VarManager::Instance(model->session_id_)->GetChangedGraphId(node->GetName(), changed_graph_id);
+          ret = VarManager::Instance(session_id_)->GetChangedGraphId(node->GetName(), changed_graph_id);
           bool call_trans_var =
               (ret == SUCCESS && changed_graph_id == graph_id && changed_graph_id != allocated_graph_id);
-          if (call_trans_var) {
-            GELOGI("VarManager::GetChangedGraphId() success, node:%s, graph_id:%u.", node->GetName().c_str(), graph_id);
-            VarTransRoad *trans_road = VarManager::Instance(model->session_id_)->GetTransRoad(node->GetName());
-            if (trans_road == nullptr) {
-              GELOGI("The variable %s does not have any trans road", node->GetName().c_str());
-              return SUCCESS;
-            }
-            ret = TransVarData(node, *trans_road, model->session_id_, model->device_id_);
-            if (ret != SUCCESS) {
-              GELOGE(INTERNAL_ERROR, "TransVarData failed, node:%s, graph_id:%u.", node->GetName().c_str(), graph_id);
-              return INTERNAL_ERROR;
-            }
-            VarManager::Instance(model->session_id_)->RemoveChangedGraphId(node->GetName());
+          if (!call_trans_var) {
+            continue;
           }
-          return SUCCESS;
-        },
-        node, this, ctx, graph_id));
-  }
-
-  Status ret_status;
-  for (size_t i = 0; i < vector_future.size(); ++i) {
-    ret_status = vector_future[i].get();
-    if (ret_status != SUCCESS) {
-      GELOGE(ret_status, "TransAllVarData:: trans %zu vardata failed", i);
-      return ret_status;
-    }
+          GELOGI("VarManager::GetChangedGraphId() success, node:%s, graph_id:%u.", node->GetName().c_str(), graph_id);
+          VarTransRoad *trans_road = VarManager::Instance(session_id_)->GetTransRoad(node->GetName());
+          if (trans_road == nullptr) {
+            GELOGI("The variable %s does not have any trans road", node->GetName().c_str());
+            continue;
+          }
+          ret = TransVarData(node, *trans_road, session_id_, transfer);
+          if (ret != SUCCESS) {
+            GELOGE(INTERNAL_ERROR, "TransVarData failed, node:%s, graph_id:%u.", node->GetName().c_str(), graph_id);
+            return INTERNAL_ERROR;
+          }
+          VarManager::Instance(session_id_)->RemoveChangedGraphId(node->GetName());
+        }
+        return SUCCESS;
+      });
+  if (ret_status != SUCCESS) {
+    GELOGE(ret_status, "TransAllVarData:: trans vardata failed");
+    return ret_status;
   }
 
   GELOGI("TransAllVarData success.");
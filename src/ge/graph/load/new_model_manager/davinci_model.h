@@ -17,6 +17,8 @@
 #ifndef GE_GRAPH_LOAD_NEW_MODEL_MANAGER_DAVINCI_MODEL_H_
 #define GE_GRAPH_LOAD_NEW_MODEL_MANAGER_DAVINCI_MODEL_H_
 
+#include <condition_variable>
+#include <deque>
 #include <map>
 #include <memory>
 #include <set>
@@ -28,6 +30,7 @@
 #include "cce/dnn.h"
 #include "cce/dnn_base_def.hpp"
 #include "cce/taskdown_common.hpp"
+#include "common/formats/format_transfers/format_transfer.h"
 #include "common/ge_types.h"
 #include "common/helper/model_helper.h"
 #include "common/helper/om_file_helper.h"
@@ -110,6 +113,20 @@ class DavinciModel {
 
   static void *Run(DavinciModel *model_pointer);
 
+  ///
+  /// @ingroup domi_ome
+  /// @brief model thread of the pipelined run mode, launches the requests without waiting for them
+  /// @param [in] model_pointer model to run
+  ///
+  static void *RunPipeline(DavinciModel *model_pointer);
+
+  ///
+  /// @ingroup domi_ome
+  /// @brief waits for the launched requests and returns their results in submission order
+  /// @param [in] model_pointer model to run
+  ///
+  static void *ReturnPipeline(DavinciModel *model_pointer);
+
   ///
   /// @ingroup domi_ome
   /// @brief NnExecute
@@ -414,6 +431,51 @@ class DavinciModel {
   DavinciModel(const DavinciModel &model) = delete;
 
  private:
+  // position of a model input or output in the staging memory of a pipeline slot
+  struct PipelineTensor {
+    void *model_addr;
+    uint32_t size;
+    uint64_t offset;
+    // index of the user buffer in the request
+    uint32_t data_index;
+  };
+
+  // model input or output whose address in the task args is replaced by the user address for ZeroCopy
+  struct ZeroCopyTensor {
+    const void *model_addr;
+    uint32_t size;
+    // index of the user buffer in the request
+    uint32_t data_index;
+    // address now in the args, the model address until a request brings another one
+    void *user_addr;
+    // positions of the args slots of the tensor in zero_copy_mirror_
+    std::vector<size_t> slots;
+  };
+
+  // adjacent args slots of one task updated by one copy
+  struct ZeroCopyRun {
+    void *args_addr;
+    size_t begin;
+    size_t end;
+  };
+
+  // staging memory and events of one request in flight in the pipelined run mode
+  struct PipelineSlot {
+    // the user buffers are copied to and from pinned host memory, the runtime copies it asynchronously
+    uint8_t *input_host = nullptr;
+    uint8_t *output_host = nullptr;
+    uint8_t *input_mem = nullptr;
+    uint8_t *output_mem = nullptr;
+    rtEvent_t input_ready = nullptr;
+    // recorded on the model stream after the execution, its status is the status of the execution
+    rtEvent_t output_ready = nullptr;
+    rtEvent_t output_done = nullptr;
+    std::shared_ptr<InputDataWrapper> data_wrapper;
+    // length of every input copied to the staging memory, 0 if there is nothing to copy
+    std::vector<uint32_t> input_lengths;
+    Status result = SUCCESS;
+  };
+
   // memory address of weights
   uint8_t *weights_mem_base_;
   uint8_t *var_mem_base_;
@@ -434,9 +496,17 @@ class DavinciModel {
   ///
   void SetOutsideAddr(const std::vector<void *> &outside_addrs);
   Status ModelZeroCopy(const InputData &input_data, OutputData &output_data);
-  Status ZeroCopyInput(const InputData &input_data);
-  Status ZeroCopyOutput(const OutputData &output_data);
-  Status ZeroCopyImpl(const void *src_addr, const DataBuffer &data_buf);
+  Status ZeroCopyInput(const InputData &input_data, std::vector<bool> &dirty_runs, size_t &patch_num);
+  Status ZeroCopyOutput(const OutputData &output_data, std::vector<bool> &dirty_runs, size_t &patch_num);
+  Status ZeroCopyImpl(ZeroCopyTensor &tensor, const DataBuffer &data_buf, std::vector<bool> &dirty_runs,
+                      size_t &patch_num);
+
+  ///
+  /// @ingroup domi_ome
+  /// @brief Cache the Data and NetOutput info for ZeroCopy, group the args slots to patch into copies.
+  /// @return SUCCESS handle successfully / others handle failed
+  ///
+  Status InitZeroCopy();
 
   Status CopyInputData(const InputData &current_data, bool device_data = false);
 
@@ -452,6 +522,49 @@ class DavinciModel {
 
   Status SyncVarData();
 
+  ///
+  /// @ingroup domi_ome
+  /// @brief convert an input of a data op which needs data type transfer on host
+  /// @param [in] data_buf user input
+  /// @param [in] data_op_index index of the data op
+  /// @param [out] result converted data
+  /// @return Status result
+  ///
+  Status TransInputData(const DataBuffer &data_buf, uint32_t data_op_index, formats::TransResult &result);
+
+  Status InitPipeline();
+
+  Status InitPipelineInputs(uint64_t &total_size, bool &supported);
+
+  Status InitPipelineOutputs(uint64_t &total_size);
+
+  void DestroyPipeline();
+
+  ///
+  /// @ingroup domi_ome
+  /// @brief wait for a launched request and copy its outputs to the user buffers
+  /// @param [in] slot staging slot holding the request
+  /// @param [out] seq_end_flag whether the model stream reached the end of the sequence
+  /// @return Status result
+  ///
+  Status WaitPipelineResult(PipelineSlot &slot, bool &seq_end_flag);
+
+  ///
+  /// @ingroup domi_ome
+  /// @brief queue the input copy, the execution and the output copy of one request on the pipeline streams
+  /// @param [in] slot staging slot holding the request
+  /// @return Status result
+  ///
+  Status LaunchPipelineSlot(PipelineSlot &slot);
+
+  size_t AcquirePipelineSlot();
+
+  void CommitPipelineSlot(size_t slot_id);
+
+  bool WaitPipelineSlot(size_t &slot_id);
+
+  void ReleasePipelineSlot(size_t slot_id);
+
   Status SyncDataAndDump();
 
   Status InitModelMem(void *dev_ptr, size_t memsize, void *weight_ptr, size_t weightsize);
@@ -568,6 +681,15 @@ class DavinciModel {
 
   std::mutex outside_addrs_mutex_;
   std::map<const void *, std::vector<void *>> outside_addrs_;
+  // first args slot of every SetZeroCopyAddr call, a copy never runs across two of them
+  std::set<const void *> zero_copy_args_begins_;
+  std::vector<ZeroCopyTensor> zero_copy_inputs_;
+  std::vector<ZeroCopyTensor> zero_copy_outputs_;
+  // host copy of every args slot patched for ZeroCopy, ordered by the slot address
+  std::vector<void *> zero_copy_mirror_;
+  std::vector<ZeroCopyRun> zero_copy_runs_;
+  // run of every slot in zero_copy_mirror_
+  std::vector<size_t> zero_copy_slot_runs_;
 
   std::vector<TaskInfoPtr> task_list_;
   // rt_moodel_handle
@@ -613,6 +735,23 @@ class DavinciModel {
   std::map<uint32_t, std::string> op_task_id_map_;
 
   int64_t maxDumpOpNum_;
+
+  // for the pipelined run mode, enabled by OPTION_EXEC_MODEL_PIPELINE_DEPTH
+  uint32_t pipeline_depth_;
+  std::vector<PipelineTensor> pipeline_inputs_;
+  std::vector<PipelineTensor> pipeline_outputs_;
+  std::vector<PipelineSlot> pipeline_slots_;
+  // inputs are copied to the staging memory on the input stream, results are copied back on the output stream
+  rtStream_t pipeline_input_stream_;
+  rtStream_t pipeline_output_stream_;
+  std::thread pipeline_return_thread_;
+  std::mutex pipeline_mutex_;
+  std::condition_variable pipeline_cond_;
+  std::deque<size_t> free_pipeline_slots_;
+  // launched slots in submission order
+  std::deque<size_t> busy_pipeline_slots_;
+  bool pipeline_stop_;
+
   // for data dump
   DataDumper data_dumper_;
 };
@@ -23,6 +23,7 @@
 #include "common/l2_cache_optimize.h"
 #include "common/profiling/profiling_manager.h"
 #include "common/properties_manager.h"
+#include "common/tracer.h"
 #include "framework/common/debug/ge_log.h"
 #include "graph/load/new_model_manager/davinci_model.h"
 #include "graph/load/new_model_manager/davinci_model_parser.h"
@@ -142,7 +143,16 @@ Status ModelManager::SetDevice(int32_t deviceId) const {
 ///
 Status ModelManager::LoadModelOnline(uint32_t &model_id, shared_ptr<ge::Model> &model,
                                      std::shared_ptr<ModelListener> listener) {
+  GeModelPtr ge_model;
+  GE_CHK_STATUS_RET(ModelHelper::TransModelToGeModel(model, ge_model), "trans model to ge_model failed.");
+  return LoadModelOnline(model_id, ge_model, listener);
+}
+
+Status ModelManager::LoadModelOnline(uint32_t &model_id, const GeModelPtr &ge_model,
+                                     std::shared_ptr<ModelListener> listener) {
+  GE_TRACE_SCOPE("ModelManager::LoadModelOnline");
   GE_CHK_BOOL_RET_STATUS(listener.get() != nullptr, PARAM_INVALID, "Param incorrect, listener is null");
+  GE_CHK_BOOL_RET_STATUS(ge_model != nullptr, PARAM_INVALID, "Param incorrect, ge_model is null");
   GenModelId(&model_id);
 
   GE_CHK_STATUS_RET(SetDevice(static_cast<int32_t>(GetContext().DeviceId())), "Set device failed, model id:%u.",
@@ -159,10 +169,6 @@ Status ModelManager::LoadModelOnline(uint32_t &model_id, shared_ptr<ge::Model> &
 
   Status ret = SUCCESS;
   do {
-    GeModelPtr ge_model;
-    GE_IF_BOOL_EXEC(ModelHelper::TransModelToGeModel(model, ge_model) != SUCCESS,
-                      GELOGW("trans model to ge_model failed.");
-                      break;);
     GE_TIMESTAMP_START(Assign);
     GE_IF_BOOL_EXEC(SUCCESS != (ret = davinci_model->Assign(ge_model)), GELOGW("assign model to modeldef failed.");
                       break;);
@@ -576,6 +582,7 @@ Status ModelManager::GetInputOutputDescInfoForZeroCopy(const uint32_t model_id,
 
 Status ModelManager::LoadModelOffline(uint32_t &model_id, const ModelData &model, shared_ptr<ModelListener> listener,
                                       void *dev_ptr, size_t mem_size, void *weight_ptr, size_t weight_size) {
+  GE_TRACE_SCOPE("ModelManager::LoadModelOffline");
   GE_CHK_BOOL_RET_STATUS(model.key.empty() || access(model.key.c_str(), F_OK) == 0, PARAM_INVALID,
                            "input key file path is not valid!");
   GenModelId(&model_id);
@@ -583,7 +590,8 @@ Status ModelManager::LoadModelOffline(uint32_t &model_id, const ModelData &model
   shared_ptr<DavinciModel> davinci_model = nullptr;
 
   ModelHelper model_helper;
-  Status ret = model_helper.LoadModel(model);
+  // the model data outlives Init, which uploads the weights to the device
+  Status ret = model_helper.LoadModel(model, true);
   if (ret != SUCCESS) {
     GELOGE(ret, "load model failed.");
     return ret;
@@ -637,7 +645,7 @@ Status ModelManager::LoadModelWithQ(uint32_t &model_id, const ModelData &model_d
                            "input key file path is not valid!");
 
   ModelHelper model_helper;
-  Status ret = model_helper.LoadModel(model_data);
+  Status ret = model_helper.LoadModel(model_data, true);
   if (ret != SUCCESS) {
     GELOGE(ret, "load model failed.");
     return ret;
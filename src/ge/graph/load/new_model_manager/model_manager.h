@@ -69,6 +69,17 @@ class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY ModelManager {
   ge::Status LoadModelOnline(uint32_t &model_id, std::shared_ptr<ge::Model> &model,
                              std::shared_ptr<ModelListener> listener);
 
+  ///
+  /// @ingroup domi_ome
+  /// @brief load and init a model built online, the task def, weights and kernel store of the GeModel are
+  ///        assigned to the DavinciModel as they are, without a round-trip through ge::Model
+  /// @param [out] model_id model id
+  /// @param [in] ge_model built model
+  /// @param [in] listener used to return result
+  /// @return Status run result
+  ///
+  ge::Status LoadModelOnline(uint32_t &model_id, const GeModelPtr &ge_model, std::shared_ptr<ModelListener> listener);
+
   ///
   /// @ingroup ge
   /// @brief ACL case, Load task list with queue.
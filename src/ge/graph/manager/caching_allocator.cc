@@ -0,0 +1,251 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/manager/caching_allocator.h"
+
+#include <algorithm>
+
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/debug/log.h"
+
+namespace ge {
+namespace {
+const uint64_t kMinBlockSize = 512;
+// the larger blocks are rounded up to the alignment only
+const uint64_t kLargeBlockSize = 64UL * 1024UL * 1024UL;
+const uint64_t kLargeBlockAlign = 2UL * 1024UL * 1024UL;
+const uint64_t kBinsPerPowerOfTwo = 4;
+// a cached block serves the requests up to this part smaller, which only lets the large blocks serve other sizes
+const uint64_t kBinSlackShift = 3;
+}  // namespace
+
+CachingAllocator::CachingAllocator(rtMemType_t memory_type, bool is_host, uint64_t max_cached_size)
+    : memory_type_(memory_type), is_host_(is_host), max_cached_size_(max_cached_size), stats_() {}
+
+CachingAllocator::~CachingAllocator() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  TrimLocked(0);
+  if (!used_blocks_.empty()) {
+    GELOGW("%zu blocks of %lu bytes are still in use when the caching allocator is destroyed.", used_blocks_.size(),
+           stats_.in_use_size);
+  }
+  for (auto &used_block : used_blocks_) {
+    Block block = {used_block.first, used_block.second, nullptr, nullptr};
+    RtFree(block);
+  }
+  used_blocks_.clear();
+  for (rtEvent_t event : idle_events_) {
+    GE_CHK_RT(rtEventDestroy(event));
+  }
+  idle_events_.clear();
+}
+
+uint64_t CachingAllocator::GetBinSize(uint64_t size) {
+  if (size <= kMinBlockSize) {
+    return kMinBlockSize;
+  }
+  if (size > kLargeBlockSize) {
+    return (size > UINT64_MAX - kLargeBlockAlign) ? size : ((size + kLargeBlockAlign - 1) / kLargeBlockAlign *
+                                                            kLargeBlockAlign);
+  }
+  uint64_t power_of_two = kMinBlockSize;
+  while (power_of_two * 2 <= size) {
+    power_of_two *= 2;
+  }
+  uint64_t step = power_of_two / kBinsPerPowerOfTwo;
+  return (size + step - 1) / step * step;
+}
+
+uint8_t *CachingAllocator::Malloc(uint64_t size) { return DoMalloc(size, false, nullptr); }
+
+uint8_t *CachingAllocator::Malloc(uint64_t size, rtStream_t stream) { return DoMalloc(size, true, stream); }
+
+Status CachingAllocator::Free(uint8_t *addr) { return DoFree(addr, false, nullptr); }
+
+Status CachingAllocator::Free(uint8_t *addr, rtStream_t stream) { return DoFree(addr, true, stream); }
+
+void CachingAllocator::Trim(uint64_t max_cached_size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  TrimLocked(max_cached_size);
+}
+
+void CachingAllocator::SetMaxCachedSize(uint64_t max_cached_size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_cached_size_ = max_cached_size;
+  TrimLocked(max_cached_size_);
+}
+
+CachingAllocatorStats CachingAllocator::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+uint8_t *CachingAllocator::DoMalloc(uint64_t size, bool on_stream, rtStream_t stream) {
+  uint64_t bin_size = GetBinSize(size);
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.malloc_num++;
+  uint8_t *addr = nullptr;
+  if (TakeCachedBlock(bin_size, on_stream, stream, addr)) {
+    stats_.hit_num++;
+    return addr;
+  }
+
+  addr = RtMalloc(bin_size);
+  if ((addr == nullptr) && !cached_blocks_.empty()) {
+    GELOGW("Malloc memory of size %lu failed, give back %lu cached bytes and retry.", bin_size, stats_.cached_size);
+    TrimLocked(0);
+    addr = RtMalloc(bin_size);
+  }
+  if (addr == nullptr) {
+    GELOGE(MEMALLOC_FAILED, "Malloc memory of size %lu failed, %lu bytes in use.", bin_size, stats_.in_use_size);
+    return nullptr;
+  }
+  used_blocks_[addr] = bin_size;
+  stats_.in_use_size += bin_size;
+  stats_.peak_size = std::max(stats_.peak_size, stats_.in_use_size + stats_.cached_size);
+  return addr;
+}
+
+Status CachingAllocator::DoFree(uint8_t *addr, bool on_stream, rtStream_t stream) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = used_blocks_.find(addr);
+  if (iter == used_blocks_.end()) {
+    GELOGE(PARAM_INVALID, "Free memory %p which is not malloced by the caching allocator.", addr);
+    return PARAM_INVALID;
+  }
+  Block block = {addr, iter->second, stream, nullptr};
+  (void)used_blocks_.erase(iter);
+  stats_.in_use_size -= block.size;
+
+  if (on_stream) {
+    // without an event the block waits for nothing, so the stream is drained first
+    block.event = TakeEvent();
+    if ((block.event == nullptr) || (rtEventRecord(block.event, stream) != RT_ERROR_NONE)) {
+      GELOGW("Record the free of memory %p on stream failed, synchronize the stream instead.", addr);
+      ReturnEvent(block.event);
+      block.event = nullptr;
+      GE_CHK_RT(rtStreamSynchronize(stream));
+    }
+  }
+
+  if (block.size > max_cached_size_) {
+    RtFree(block);
+    return SUCCESS;
+  }
+  cached_blocks_.push_front(block);
+  // before the blocks of the same size, the most recently freed is taken first
+  (void)bins_.emplace_hint(bins_.lower_bound(block.size), block.size, cached_blocks_.begin());
+  stats_.cached_size += block.size;
+  TrimLocked(max_cached_size_);
+  return SUCCESS;
+}
+
+bool CachingAllocator::TakeCachedBlock(uint64_t size, bool on_stream, rtStream_t stream, uint8_t *&addr) {
+  uint64_t max_size = size + (size >> kBinSlackShift);
+  for (auto iter = bins_.lower_bound(size); (iter != bins_.end()) && (iter->first <= max_size); ++iter) {
+    BlockIter block = iter->second;
+    if (!IsBlockReady(*block, on_stream, stream)) {
+      continue;
+    }
+    addr = block->addr;
+    used_blocks_[addr] = block->size;
+    stats_.in_use_size += block->size;
+    stats_.cached_size -= block->size;
+    ReturnEvent(block->event);
+    (void)bins_.erase(iter);
+    (void)cached_blocks_.erase(block);
+    return true;
+  }
+  return false;
+}
+
+bool CachingAllocator::IsBlockReady(const Block &block, bool on_stream, rtStream_t stream) const {
+  if (block.event == nullptr) {
+    return true;
+  }
+  // the tasks of a stream run in order, the new ones start after the ones queued before the free
+  if (on_stream && (block.stream == stream)) {
+    return true;
+  }
+  return rtEventQuery(block.event) == RT_ERROR_NONE;
+}
+
+uint8_t *CachingAllocator::RtMalloc(uint64_t size) {
+  void *addr = nullptr;
+  rtError_t rt_ret = is_host_ ? rtMallocHost(&addr, size) : rtMalloc(&addr, size, memory_type_);
+  if (rt_ret != RT_ERROR_NONE) {
+    GELOGW("Call rt api to malloc memory of size %lu failed, ret: 0x%X", size, rt_ret);
+    return nullptr;
+  }
+  stats_.rt_malloc_num++;
+  GELOGD("Malloc memory of size %lu from runtime, host %d.", size, is_host_);
+  return reinterpret_cast<uint8_t *>(addr);
+}
+
+void CachingAllocator::RtFree(Block &block) {
+  if (block.event != nullptr) {
+    GE_CHK_RT(rtEventSynchronize(block.event));
+    ReturnEvent(block.event);
+    block.event = nullptr;
+  }
+  rtError_t rt_ret = is_host_ ? rtFreeHost(block.addr) : rtFree(block.addr);
+  if (rt_ret != RT_ERROR_NONE) {
+    GELOGE(RT_FAILED, "Call rt api to free memory %p failed, ret: 0x%X", block.addr, rt_ret);
+    return;
+  }
+  stats_.rt_free_num++;
+}
+
+void CachingAllocator::TrimLocked(uint64_t max_cached_size) {
+  while ((stats_.cached_size > max_cached_size) && !cached_blocks_.empty()) {
+    EraseCachedBlock(std::prev(cached_blocks_.end()));
+  }
+}
+
+void CachingAllocator::EraseCachedBlock(BlockIter iter) {
+  auto range = bins_.equal_range(iter->size);
+  for (auto bin_iter = range.first; bin_iter != range.second; ++bin_iter) {
+    if (bin_iter->second == iter) {
+      (void)bins_.erase(bin_iter);
+      break;
+    }
+  }
+  stats_.cached_size -= iter->size;
+  RtFree(*iter);
+  (void)cached_blocks_.erase(iter);
+}
+
+rtEvent_t CachingAllocator::TakeEvent() {
+  if (!idle_events_.empty()) {
+    rtEvent_t event = idle_events_.back();
+    idle_events_.pop_back();
+    return event;
+  }
+  rtEvent_t event = nullptr;
+  rtError_t rt_ret = rtEventCreate(&event);
+  if (rt_ret != RT_ERROR_NONE) {
+    GELOGW("Call rt api to create event failed, ret: 0x%X", rt_ret);
+    return nullptr;
+  }
+  return event;
+}
+
+void CachingAllocator::ReturnEvent(rtEvent_t event) {
+  if (event != nullptr) {
+    idle_events_.push_back(event);
+  }
+}
+}  // namespace ge
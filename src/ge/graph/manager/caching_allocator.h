@@ -0,0 +1,154 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_GRAPH_MANAGER_CACHING_ALLOCATOR_H_
+#define GE_GRAPH_MANAGER_CACHING_ALLOCATOR_H_
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "framework/common/ge_inner_error_codes.h"
+#include "runtime/event.h"
+#include "runtime/mem.h"
+#include "runtime/stream.h"
+
+namespace ge {
+struct CachingAllocatorStats {
+  // requests and the ones served from the cache
+  uint64_t malloc_num;
+  uint64_t hit_num;
+  // calls to the runtime
+  uint64_t rt_malloc_num;
+  uint64_t rt_free_num;
+  // bytes of the blocks handed out, and kept for reuse
+  uint64_t in_use_size;
+  uint64_t cached_size;
+  // highest in use plus cached
+  uint64_t peak_size;
+};
+
+///
+/// Keeps the freed blocks of device memory or of pinned host memory for the next requests instead of giving them
+/// back to the runtime. The sizes are rounded up to bins, four per power of two, so a block serves the requests of
+/// its bin. A block freed on a stream is taken again on the same stream at once, on other streams or without a
+/// stream once the work queued before the free is done. The blocks freed least recently are given back when the
+/// cached bytes pass the high-water mark, or when the runtime is out of memory.
+///
+class CachingAllocator {
+ public:
+  ///
+  /// @param [in] memory_type memory type of rtMalloc, ignored for host memory
+  /// @param [in] is_host pinned host memory of rtMallocHost
+  /// @param [in] max_cached_size high-water mark of the cached bytes
+  ///
+  CachingAllocator(rtMemType_t memory_type, bool is_host, uint64_t max_cached_size);
+
+  ~CachingAllocator();
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief take a block used by the host, or by streams synchronized before it is used
+  /// @return address of the block, nullptr if failed
+  ///
+  uint8_t *Malloc(uint64_t size);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief take a block used by the tasks of a stream
+  ///
+  uint8_t *Malloc(uint64_t size, rtStream_t stream);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief return a block no task uses any more
+  /// @return Status result of function
+  ///
+  Status Free(uint8_t *addr);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief return a block the tasks queued on a stream may still use
+  /// @return Status result of function
+  ///
+  Status Free(uint8_t *addr, rtStream_t stream);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief give the cached blocks back to the runtime until at most max_cached_size bytes are kept
+  ///
+  void Trim(uint64_t max_cached_size);
+
+  void SetMaxCachedSize(uint64_t max_cached_size);
+
+  CachingAllocatorStats GetStats() const;
+
+  static uint64_t GetBinSize(uint64_t size);
+
+  CachingAllocator(const CachingAllocator &) = delete;
+  CachingAllocator &operator=(const CachingAllocator &) = delete;
+
+ private:
+  struct Block {
+    uint8_t *addr;
+    uint64_t size;
+    // stream the block was freed on, and an event recorded there at the free
+    rtStream_t stream;
+    rtEvent_t event;
+  };
+  using BlockIter = std::list<Block>::iterator;
+
+  uint8_t *DoMalloc(uint64_t size, bool on_stream, rtStream_t stream);
+
+  Status DoFree(uint8_t *addr, bool on_stream, rtStream_t stream);
+
+  bool TakeCachedBlock(uint64_t size, bool on_stream, rtStream_t stream, uint8_t *&addr);
+
+  bool IsBlockReady(const Block &block, bool on_stream, rtStream_t stream) const;
+
+  uint8_t *RtMalloc(uint64_t size);
+
+  void RtFree(Block &block);
+
+  // guarded by mutex_
+  void TrimLocked(uint64_t max_cached_size);
+
+  void EraseCachedBlock(BlockIter iter);
+
+  rtEvent_t TakeEvent();
+
+  void ReturnEvent(rtEvent_t event);
+
+  const rtMemType_t memory_type_;
+  const bool is_host_;
+
+  mutable std::mutex mutex_;
+  uint64_t max_cached_size_;
+  CachingAllocatorStats stats_;
+  // address to size of the blocks handed out
+  std::unordered_map<uint8_t *, uint64_t> used_blocks_;
+  // cached blocks, the most recently freed first
+  std::list<Block> cached_blocks_;
+  // size to the cached blocks of the size
+  std::multimap<uint64_t, BlockIter> bins_;
+  std::vector<rtEvent_t> idle_events_;
+};
+}  // namespace ge
+
+#endif  // GE_GRAPH_MANAGER_CACHING_ALLOCATOR_H_
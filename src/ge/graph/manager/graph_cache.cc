@@ -0,0 +1,458 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/manager/graph_cache.h"
+
+#include <dirent.h>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+#include "common/helper/model_helper.h"
+#include "common/model_parser/base.h"
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/types.h"
+#include "framework/common/util.h"
+#include "framework/omg/version.h"
+#include "ge/ge_api_types.h"
+#include "graph/debug/ge_attr_define.h"
+#include "graph/detail/model_serialize_imp.h"
+#include "proto/ge_ir.pb.h"
+
+namespace ge {
+namespace {
+// bump it whenever the build changes the models it produces for the same graph
+const char *const kGraphCacheVersion = "ge_graph_cache_v1";
+const char *const kCacheFileSuffix = ".om";
+const char *const kTmpFileSuffix = ".tmp";
+const uint64_t kDefaultCacheMaxSize = 2UL * 1024 * 1024 * 1024;
+// temporary files older than this are left by crashed stores
+const uint64_t kNanosecondsPerSecond = 1000000000;
+const uint64_t kStaleTmpFileTime = 3600 * kNanosecondsPerSecond;
+const char *const kSummary = "Summary";
+const char *const kOppPathEnv = "ASCEND_OPP_PATH";
+const char *const kOppVersionFile = "/version.info";
+
+// options that do not change the model: ids of the run, dumps, loading and the cache itself
+const std::set<std::string> kOptionsNotInKey = {OPTION_EXEC_SESSION_ID,
+                                                OPTION_EXEC_DEVICE_ID,
+                                                OPTION_EXEC_JOB_ID,
+                                                OPTION_EXEC_POD_NAME,
+                                                OPTION_EXEC_ENABLE_DUMP,
+                                                OPTION_EXEC_DUMP_PATH,
+                                                OPTION_EXEC_MODEL_PIPELINE_DEPTH,
+                                                OPTION_EXEC_THREAD_NUM,
+                                                OPTION_EXEC_TRACE_FILE,
+                                                GRAPH_CACHE_DIR,
+                                                GRAPH_CACHE_MAX_SIZE};
+
+typedef unsigned __int128 uint128_t;
+
+// 128 bits FNV-1a, stable across processes and builds unlike std::hash
+class Fnv1a128 {
+ public:
+  Fnv1a128() : hash_((static_cast<uint128_t>(0x6c62272e07bb0142UL) << 64) | 0x62b821756295c58dUL) {}
+
+  void Update(const void *data, size_t size) {
+    const uint128_t kPrime = (static_cast<uint128_t>(1) << 88) | 0x13b;
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; ++i) {
+      hash_ ^= bytes[i];
+      hash_ *= kPrime;
+    }
+  }
+
+  // the length is hashed first, so neighbouring fields can not trade bytes
+  void Update(const std::string &str) {
+    uint64_t size = str.size();
+    Update(&size, sizeof(size));
+    Update(str.data(), str.size());
+  }
+
+  std::string HexDigest() const {
+    const char *const kHexDigits = "0123456789abcdef";
+    std::string digest;
+    for (int shift = 124; shift >= 0; shift -= 4) {
+      digest.push_back(kHexDigits[static_cast<uint32_t>(hash_ >> shift) & 0xf]);
+    }
+    return digest;
+  }
+
+ private:
+  uint128_t hash_;
+};
+
+uint64_t GetMtime(const struct stat &file_stat) {
+  return static_cast<uint64_t>(file_stat.st_mtim.tv_sec) * kNanosecondsPerSecond +
+         static_cast<uint64_t>(file_stat.st_mtim.tv_nsec);
+}
+
+bool EndsWith(const std::string &str, const std::string &suffix) {
+  return (str.size() >= suffix.size()) && (str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0);
+}
+
+// real path of the library holding the graph cache, which is the library that builds the models
+std::string GetLibraryPath() {
+  Dl_info dl_info;
+  if (dladdr(reinterpret_cast<void *>(&GetLibraryPath), &dl_info) == 0) {
+    return "";
+  }
+  char path[PATH_MAX] = {0};
+  if ((dl_info.dli_fname == nullptr) || (realpath(dl_info.dli_fname, path) == nullptr)) {
+    return "";
+  }
+  return path;
+}
+
+// the opp compiles the ops of the model, it is found the same way as the ops proto of GEInitialize
+std::string GetOppPath(const std::string &lib_path) {
+  const char *path_env = std::getenv(kOppPathEnv);
+  if (path_env != nullptr) {
+    return path_env;
+  }
+  std::string path_base = lib_path.substr(0, lib_path.rfind('/'));
+  path_base = path_base.substr(0, path_base.rfind('/') + 1);
+  return path_base + "ops";
+}
+
+// a model built by another GE or opp may not run with this one, an upgrade of either gives new keys
+std::string GetToolchainDigest() {
+  std::string digest;
+  std::string platform_version;
+  (void)PlatformVersionManager::GetPlatformVersion(platform_version);
+  digest.append("platform=").append(platform_version).append("\n");
+
+  std::string lib_path = GetLibraryPath();
+  struct stat lib_stat;
+  if (!lib_path.empty() && (stat(lib_path.c_str(), &lib_stat) == 0)) {
+    digest.append("lib=").append(lib_path).append(":").append(std::to_string(lib_stat.st_size));
+    digest.append(":").append(std::to_string(GetMtime(lib_stat))).append("\n");
+  } else {
+    GELOGW("[GraphCache] get the library of GE failed, the key does not cover its version.");
+  }
+
+  std::string opp_path = GetOppPath(lib_path);
+  digest.append("opp=").append(opp_path).append("\n");
+  std::ifstream version_file(opp_path + kOppVersionFile);
+  if (version_file.is_open()) {
+    std::stringstream version_stream;
+    version_stream << version_file.rdbuf();
+    digest.append(version_stream.str());
+  } else {
+    GELOGW("[GraphCache] read %s%s failed, the key does not cover the opp version.", opp_path.c_str(),
+           kOppVersionFile);
+  }
+  return digest;
+}
+
+// the data of a file reaches the disk before the file is renamed into place, a crash leaves no empty model
+Status SyncFile(const std::string &path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    GELOGE(FAILED, "[GraphCache] open %s failed.", path.c_str());
+    return FAILED;
+  }
+  int ret = fsync(fd);
+  (void)close(fd);
+  if (ret != 0) {
+    GELOGE(FAILED, "[GraphCache] sync %s failed.", path.c_str());
+    return FAILED;
+  }
+  return SUCCESS;
+}
+}  // namespace
+
+Status GraphCache::Initialize(const std::map<std::string, std::string> &options) {
+  cache_dir_.clear();
+  auto iter = options.find(GRAPH_CACHE_DIR);
+  if ((iter == options.end()) || iter->second.empty()) {
+    GELOGI("[GraphCache] no cache dir configured, the graph cache is disabled.");
+    return SUCCESS;
+  }
+  std::string cache_dir = iter->second;
+
+  max_size_ = kDefaultCacheMaxSize;
+  iter = options.find(GRAPH_CACHE_MAX_SIZE);
+  if (iter != options.end()) {
+    char *ptr = nullptr;
+    const int kDecimal = 10;
+    max_size_ = std::strtoull(iter->second.c_str(), &ptr, kDecimal);
+    if ((ptr == nullptr) || (*ptr != '\0') || iter->second.empty()) {
+      GELOGE(GE_GRAPH_OPTIONS_INVALID, "Key:%s, its value %s is invalid, must be uint64_t type.",
+             GRAPH_CACHE_MAX_SIZE.c_str(), iter->second.c_str());
+      return GE_GRAPH_OPTIONS_INVALID;
+    }
+  }
+
+  // the cache only saves time, a session without it still works
+  if (CreateDirectory(cache_dir) != 0) {
+    GELOGW("[GraphCache] create cache dir %s failed, the graph cache is disabled.", cache_dir.c_str());
+    return SUCCESS;
+  }
+  std::string real_dir = RealPath(cache_dir.c_str());
+  if (real_dir.empty()) {
+    GELOGW("[GraphCache] cache dir %s is invalid, the graph cache is disabled.", cache_dir.c_str());
+    return SUCCESS;
+  }
+
+  options_digest_.clear();
+  for (const auto &option : options) {
+    if (kOptionsNotInKey.count(option.first) == 0) {
+      options_digest_.append(option.first).append("=").append(option.second).append("\n");
+    }
+  }
+  toolchain_digest_ = GetToolchainDigest();
+  hit_count_ = 0;
+  miss_count_ = 0;
+  store_count_ = 0;
+  evict_count_ = 0;
+  cache_dir_ = real_dir;
+  GELOGI("[GraphCache] graph cache dir %s, max size %lu.", cache_dir_.c_str(), max_size_);
+  return SUCCESS;
+}
+
+void GraphCache::Finalize() {
+  if (!IsEnabled()) {
+    return;
+  }
+  GELOGI("[GraphCache] finalize, hits %lu, misses %lu, stores %lu, evictions %lu.", hit_count_.load(),
+         miss_count_.load(), store_count_.load(), evict_count_.load());
+  cache_dir_.clear();
+}
+
+bool GraphCache::IsGraphCacheable(const ComputeGraphPtr &compute_graph) {
+  if (compute_graph == nullptr) {
+    return false;
+  }
+  for (const auto &node : compute_graph->GetAllNodes()) {
+    const std::string &type = node->GetType();
+    if ((type == VARIABLE) || (type == VARIABLEV2) || (type == VARHANDLEOP) || (type == kSummary)) {
+      GELOGI("[GraphCache] graph %s has %s %s, it is not cached.", compute_graph->GetName().c_str(), type.c_str(),
+             node->GetName().c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+Status GraphCache::GenerateKey(const ComputeGraphPtr &compute_graph, const std::vector<GeTensor> &inputs,
+                               std::string &key) const {
+  GE_CHECK_NOTNULL(compute_graph);
+  proto::GraphDef graph_def;
+  ModelSerializeImp serialize_imp;
+  if (!serialize_imp.SerializeGraph(compute_graph, &graph_def)) {
+    GELOGE(FAILED, "[GraphCache] serialize graph %s failed.", compute_graph->GetName().c_str());
+    return FAILED;
+  }
+  // the session graph id differs in every process, it only names the model on the device
+  (void)graph_def.mutable_attr()->erase(ATTR_NAME_SESSION_GRAPH_ID);
+  for (auto &op_def : *graph_def.mutable_op()) {
+    (void)op_def.mutable_attr()->erase(ATTR_NAME_SESSION_GRAPH_ID);
+  }
+  // the attrs are proto maps, only a deterministic serialization gives the same bytes for the same graph
+  std::string graph_bytes;
+  {
+    google::protobuf::io::StringOutputStream string_stream(&graph_bytes);
+    google::protobuf::io::CodedOutputStream coded_stream(&string_stream);
+    coded_stream.SetSerializationDeterministic(true);
+    if (!graph_def.SerializeToCodedStream(&coded_stream)) {
+      GELOGE(FAILED, "[GraphCache] serialize graph %s failed.", compute_graph->GetName().c_str());
+      return FAILED;
+    }
+  }
+
+  Fnv1a128 hash;
+  hash.Update(kGraphCacheVersion);
+  hash.Update(toolchain_digest_);
+  hash.Update(options_digest_);
+  hash.Update(graph_bytes);
+  for (const auto &input : inputs) {
+    const GeTensorDesc &desc = input.GetTensorDesc();
+    std::string input_digest = std::to_string(desc.GetDataType()) + ":" + std::to_string(desc.GetFormat()) + ":";
+    for (int64_t dim : desc.GetShape().GetDims()) {
+      input_digest.append(std::to_string(dim)).append(",");
+    }
+    hash.Update(input_digest);
+  }
+  key = hash.HexDigest();
+  return SUCCESS;
+}
+
+std::string GraphCache::GetFilePath(const std::string &key) const { return cache_dir_ + "/" + key + kCacheFileSuffix; }
+
+GeModelPtr GraphCache::Lookup(const std::string &key) {
+  if (!IsEnabled() || key.empty()) {
+    return nullptr;
+  }
+  std::string path = GetFilePath(key);
+  struct stat file_stat;
+  if (stat(path.c_str(), &file_stat) != 0) {
+    ++miss_count_;
+    GELOGI("[GraphCache] miss %s, hits %lu, misses %lu.", key.c_str(), hit_count_.load(), miss_count_.load());
+    return nullptr;
+  }
+
+  ModelData model_data;
+  GeModelPtr ge_model = nullptr;
+  if (ModelParserBase::MapFromFile(path.c_str(), nullptr, 0, model_data) == SUCCESS) {
+    ModelHelper model_helper;
+    if (model_helper.LoadModel(model_data) == SUCCESS) {
+      ge_model = model_helper.GetGeModel();
+    }
+    ModelParserBase::FreeModelData(model_data);
+  }
+  if (ge_model == nullptr) {
+    // written by a different version or damaged, build it again
+    GELOGW("[GraphCache] load cached model %s failed, remove it.", path.c_str());
+    (void)remove(path.c_str());
+    ++miss_count_;
+    return nullptr;
+  }
+
+  // the mtime is the last use shared by all processes
+  if (utimensat(AT_FDCWD, path.c_str(), nullptr, 0) != 0) {
+    GELOGW("[GraphCache] touch %s failed.", path.c_str());
+  }
+  ++hit_count_;
+  GELOGI("[GraphCache] hit %s, hits %lu, misses %lu.", key.c_str(), hit_count_.load(), miss_count_.load());
+  return ge_model;
+}
+
+Status GraphCache::Store(const std::string &key, const GeModelPtr &ge_model) {
+  if (!IsEnabled()) {
+    return SUCCESS;
+  }
+  GE_CHECK_NOTNULL(ge_model);
+  if (key.empty()) {
+    GELOGE(PARAM_INVALID, "[GraphCache] key of model %s is empty.", ge_model->GetName().c_str());
+    return PARAM_INVALID;
+  }
+
+  if (ge_model->GetWeightSize() == 0) {
+    GELOGI("[GraphCache] model %s has no weights, the om format can not hold it.", ge_model->GetName().c_str());
+    return SUCCESS;
+  }
+
+  std::lock_guard<std::mutex> lock(store_mutex_);
+  // write a file of this process and rename it, readers never see a partial model
+  std::string path = GetFilePath(key);
+  std::string tmp_path =
+      path + "." + std::to_string(getpid()) + "_" + std::to_string(tmp_file_id_++) + kTmpFileSuffix;
+  ModelHelper model_helper;
+  SaveParam save_param;
+  Status ret = model_helper.SaveToOmModel(ge_model, save_param, tmp_path);
+  if (ret != SUCCESS) {
+    GELOGE(ret, "[GraphCache] save model %s to %s failed.", ge_model->GetName().c_str(), tmp_path.c_str());
+    (void)remove(tmp_path.c_str());
+    return ret;
+  }
+  if (SyncFile(tmp_path) != SUCCESS) {
+    (void)remove(tmp_path.c_str());
+    return FAILED;
+  }
+  if (rename(tmp_path.c_str(), path.c_str()) != 0) {
+    GELOGE(FAILED, "[GraphCache] rename %s to %s failed.", tmp_path.c_str(), path.c_str());
+    (void)remove(tmp_path.c_str());
+    return FAILED;
+  }
+  // the rename itself is durable once the directory is synced
+  int dir_fd = open(cache_dir_.c_str(), O_RDONLY);
+  if ((dir_fd < 0) || (fsync(dir_fd) != 0)) {
+    GELOGW("[GraphCache] sync cache dir %s failed.", cache_dir_.c_str());
+  }
+  if (dir_fd >= 0) {
+    (void)close(dir_fd);
+  }
+  ++store_count_;
+  GELOGI("[GraphCache] store %s, stores %lu.", key.c_str(), store_count_.load());
+
+  Evict();
+  return SUCCESS;
+}
+
+void GraphCache::ListCacheFiles(std::vector<CacheFile> &files) {
+  DIR *dir = opendir(cache_dir_.c_str());
+  if (dir == nullptr) {
+    GELOGW("[GraphCache] open cache dir %s failed.", cache_dir_.c_str());
+    return;
+  }
+  struct timespec now;
+  (void)clock_gettime(CLOCK_REALTIME, &now);
+  uint64_t now_ns = static_cast<uint64_t>(now.tv_sec) * kNanosecondsPerSecond + static_cast<uint64_t>(now.tv_nsec);
+
+  struct dirent *entry = nullptr;
+  while ((entry = readdir(dir)) != nullptr) {
+    std::string name = entry->d_name;
+    bool is_tmp_file = EndsWith(name, kTmpFileSuffix);
+    if (!is_tmp_file && !EndsWith(name, kCacheFileSuffix)) {
+      continue;
+    }
+    std::string path = cache_dir_ + "/" + name;
+    struct stat file_stat;
+    if ((stat(path.c_str(), &file_stat) != 0) || !S_ISREG(file_stat.st_mode)) {
+      continue;
+    }
+    uint64_t mtime = GetMtime(file_stat);
+    if (is_tmp_file) {
+      if (now_ns > mtime + kStaleTmpFileTime) {
+        GELOGI("[GraphCache] remove stale file %s.", path.c_str());
+        (void)remove(path.c_str());
+      }
+      continue;
+    }
+    files.push_back({path, static_cast<uint64_t>(file_stat.st_size), mtime});
+  }
+  (void)closedir(dir);
+}
+
+void GraphCache::Evict() {
+  // other processes add files too, the directory is the index
+  std::vector<CacheFile> files;
+  ListCacheFiles(files);
+  uint64_t total_size = 0;
+  for (const auto &file : files) {
+    total_size += file.size;
+  }
+  if (total_size <= max_size_) {
+    return;
+  }
+
+  std::sort(files.begin(), files.end(),
+            [](const CacheFile &lhs, const CacheFile &rhs) { return lhs.last_use < rhs.last_use; });
+  for (const auto &file : files) {
+    if (total_size <= max_size_) {
+      break;
+    }
+    // the file may be gone already, removed by another process
+    (void)remove(file.path.c_str());
+    total_size -= file.size;
+    ++evict_count_;
+    GELOGI("[GraphCache] evict %s of size %lu, evictions %lu.", file.path.c_str(), file.size, evict_count_.load());
+  }
+}
+}  // namespace ge
@@ -0,0 +1,134 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_GRAPH_MANAGER_GRAPH_CACHE_H_
+#define GE_GRAPH_MANAGER_GRAPH_CACHE_H_
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/ge_inner_error_codes.h"
+#include "graph/compute_graph.h"
+#include "graph/ge_tensor.h"
+#include "model/ge_model.h"
+
+namespace ge {
+///
+/// On-disk cache of built models shared by the processes that use the same directory.
+/// A model is stored as <key>.om in the om file format, the key is a hash of everything the build depends on:
+/// the graph given by the user, the input tensors, the options and the versions of GE and the opp.
+/// The modification time of a file is its last use, the least recently used files are evicted once the cache grows
+/// beyond its max size.
+///
+class GraphCache {
+ public:
+  GraphCache() = default;
+
+  ~GraphCache() = default;
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief enable the cache if the options configure a cache dir
+  /// @param [in] options global and session options, also the part of the key shared by all graphs
+  /// @return Status result of function
+  ///
+  Status Initialize(const std::map<std::string, std::string> &options);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief log the counters and disable the cache
+  ///
+  void Finalize();
+
+  bool IsEnabled() const { return !cache_dir_.empty(); }
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief whether the model of a graph depends on nothing but the graph and the options. Variables live in
+  ///        the VarManager of the session and summaries in the graph optimizer, both are set up by the build
+  /// @param [in] compute_graph graph given by the user
+  /// @return bool
+  ///
+  static bool IsGraphCacheable(const ComputeGraphPtr &compute_graph);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief generate the key of a graph, call it before the build changes the graph
+  /// @param [in] compute_graph graph given by the user
+  /// @param [in] inputs input tensors of the build
+  /// @param [out] key hex string
+  /// @return Status result of function
+  ///
+  Status GenerateKey(const ComputeGraphPtr &compute_graph, const std::vector<GeTensor> &inputs,
+                     std::string &key) const;
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief load the model of a key and mark it as used
+  /// @param [in] key key of the graph
+  /// @return model, nullptr if not cached
+  ///
+  GeModelPtr Lookup(const std::string &key);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief store the model of a key, the file appears at once or not at all, then evict the least recently used
+  ///        models beyond the max size
+  /// @param [in] key key of the graph
+  /// @param [in] ge_model built model
+  /// @return Status result of function
+  ///
+  Status Store(const std::string &key, const GeModelPtr &ge_model);
+
+  uint64_t GetHitCount() const { return hit_count_; }
+
+  uint64_t GetMissCount() const { return miss_count_; }
+
+ private:
+  struct CacheFile {
+    std::string path;
+    uint64_t size;
+    uint64_t last_use;  // mtime in ns
+  };
+
+  std::string GetFilePath(const std::string &key) const;
+
+  // also removes the temporary files left by crashed stores
+  void ListCacheFiles(std::vector<CacheFile> &files);
+
+  void Evict();
+
+  std::string cache_dir_;
+  uint64_t max_size_ = 0;
+  // options the models depend on, one "key=value\n" per option
+  std::string options_digest_;
+  // platform, library of GE and version.info of the opp
+  std::string toolchain_digest_;
+
+  // stores of this process run one at a time, other processes only ever see complete files
+  std::mutex store_mutex_;
+  std::atomic<uint64_t> hit_count_{0};
+  std::atomic<uint64_t> miss_count_{0};
+  std::atomic<uint64_t> store_count_{0};
+  std::atomic<uint64_t> evict_count_{0};
+  std::atomic<uint32_t> tmp_file_id_{0};
+};
+}  // namespace ge
+
+#endif  // GE_GRAPH_MANAGER_GRAPH_CACHE_H_
@@ -27,7 +27,8 @@
 
 #include "common/ge/ge_util.h"
 #include "common/math/math_util.h"
-#include "common/thread_pool.h"
+#include "common/task_executor.h"
+#include "common/tracer.h"
 #include "common/util.h"
 #include "external/graph/types.h"
 #include "framework/common/debug/ge_log.h"
@@ -38,6 +39,7 @@
 #include "graph/ge_global_options.h"
 #include "graph/ge_local_context.h"
 #include "graph/manager/graph_mem_allocator.h"
+#include "graph/manager/graph_var_manager.h"
 #include "graph/passes/atomic_addr_clean_pass.h"
 #include "graph/passes/compile_nodes_pass.h"
 #include "graph/passes/constant_folding_pass.h"
@@ -71,6 +73,8 @@ const char *const kRecv = "Recv";
 }  // namespace
 
 namespace ge {
+std::mutex GraphManager::build_mutex_;
+
 GraphManager::GraphManager() : thread_run_flag_(false), graph_run_listener_(nullptr), init_flag_(false) {}
 
 Status GraphManager::Initialize(const std::map<string, string> &options) {
@@ -90,6 +94,12 @@ Status GraphManager::Initialize(const std::map<string, string> &options) {
     GELOGE(ret, "[Initialize] mutex and cond is invalid.");
     return ret;
   }
+  // set once here, the runs of different graphs share the executor
+  ret = graph_executor_.SetCondition(&sync_run_mutex_, &condition_, graph_run_listener_);
+  if (ret != SUCCESS) {
+    GELOGE(ret, "[Initialize] set condition of graph executor failed.");
+    return ret;
+  }
   // graph context
   graph_context_ = MakeShared<GraphContext>();
   if (graph_context_ == nullptr) {
@@ -118,7 +128,19 @@ Status GraphManager::Initialize(const std::map<string, string> &options) {
     return ret;
   }
 
-  graph_map_.clear();
+  // the models depend on the global options too, the session options override them
+  std::map<std::string, std::string> cache_options = options;
+  cache_options.insert(GetMutableGlobalOptions().begin(), GetMutableGlobalOptions().end());
+  ret = graph_cache_.Initialize(cache_options);
+  if (ret != SUCCESS) {
+    GELOGE(ret, "[Initialize] GraphCache initialize failed.");
+    return ret;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(graph_map_mutex_);
+    graph_map_.clear();
+  }
   init_flag_ = true;
 
   thread_run_flag_ = true;
@@ -149,7 +171,12 @@ Status GraphManager::Finalize() {
   Status unload_model_ret = SUCCESS;
   Status ret;
   rtError_t rt_ret;
-  for (auto iter = graph_map_.begin(); iter != graph_map_.end(); ++iter) {
+  std::map<GraphId, GraphNodePtr> graph_map;
+  {
+    std::lock_guard<std::mutex> lock(graph_map_mutex_);
+    graph_map.swap(graph_map_);
+  }
+  for (auto iter = graph_map.begin(); iter != graph_map.end(); ++iter) {
     GraphNodePtr graph_node = iter->second;
     if (graph_node->GetRunFlag()) {
       GELOGW("[GraphManager] finalize failed, graphId=%u.", iter->first);
@@ -179,7 +206,8 @@ Status GraphManager::Finalize() {
       }
     }
   }
-  graph_map_.clear();
+
+  graph_cache_.Finalize();
 
   // graph context
   if (graph_context_ != nullptr) {
@@ -195,6 +223,7 @@ Status GraphManager::Finalize() {
 }
 
 Status GraphManager::AddGraph(const GraphId &graph_id, const Graph &graph) {
+  std::lock_guard<std::mutex> lock(graph_map_mutex_);
   if (graph_map_.find(graph_id) != graph_map_.end()) {
     GELOGE(GE_GRAPH_GRAPH_ALREADY_EXIST, "[GraphManager] graph exists, graph_id = %u.", graph_id);
     return GE_GRAPH_GRAPH_ALREADY_EXIST;
@@ -301,21 +330,22 @@ Status GraphManager::PreRun(const GraphNodePtr &graph_node, const std::vector<Ge
   }
   GE_TIMESTAMP_END(GraphPartition, "GraphPartitioner::Partition1");
   GE_TIMESTAMP_START(SetSubgraph);
-  // use default 16 multi thread
-  const uint32_t thread_num = 16;
-  ThreadPool executor(thread_num);
-  size_t sub_graph_list_size = sub_graph_list.size();
-  std::vector<std::future<Status>> vector_future(sub_graph_list_size);
-  for (size_t i = 0; i < sub_graph_list_size; ++i) {
-    vector_future[i] = executor.commit(GraphManager::ProcessSubGraphWithMultiThreads, this, sub_graph_list[i],
-                                       session_id, GetThreadLocalContext());
-  }
-  for (size_t i = 0; i < vector_future.size(); ++i) {
-    Status ret_status = vector_future[i].get();
-    if (ret_status != SUCCESS) {
-      GELOGE(ret_status, "subgraph %zu optimize failed", i);
-      return ret_status;
-    }
+  // every subgraph is optimized on its own with the context of this thread
+  const GEThreadLocalContext &context = GetThreadLocalContext();
+  ret = TaskExecutor::Instance().ParallelFor(
+      sub_graph_list.size(), 1, [this, &sub_graph_list, session_id, &context](size_t begin, size_t end) -> Status {
+        // the workers are shared, they get their own context back
+        GEThreadLocalContext worker_context = GetThreadLocalContext();
+        Status ret_status = SUCCESS;
+        for (size_t i = begin; i < end && ret_status == SUCCESS; ++i) {
+          ret_status = ProcessSubGraphWithMultiThreads(this, sub_graph_list[i], session_id, context);
+          GE_IF_BOOL_EXEC(ret_status != SUCCESS, GELOGE(ret_status, "subgraph %zu optimize failed", i));
+        }
+        GetThreadLocalContext() = worker_context;
+        return ret_status;
+      });
+  if (ret != SUCCESS) {
+    return ret;
   }
   GE_TIMESTAMP_END(SetSubgraph, "SetSubGraph");
 
@@ -387,6 +417,60 @@ Status GraphManager::PreRun(const GraphNodePtr &graph_node, const std::vector<Ge
   return ret;
 }
 
+Status GraphManager::PreRunWithCache(const GraphNodePtr &graph_node, const std::vector<GeTensor> &inputs,
+                                     vector<GeModelPtr> &ge_models, GeModelPtr &ge_model, uint64_t session_id) {
+  GE_CHECK_NOTNULL(graph_node);
+  GE_CHECK_NOTNULL(graph_node->GetGraph());
+  auto compute_graph = GraphUtils::GetComputeGraph(*graph_node->GetGraph());
+  GE_CHECK_NOTNULL(compute_graph);
+  // the build of a training graph sets up the variables and checkpoints of the session
+  std::string cache_key;
+  if (graph_cache_.IsEnabled() && !GetTrainFlag()) {
+    if (GraphCache::IsGraphCacheable(compute_graph) &&
+        (graph_cache_.GenerateKey(compute_graph, inputs, cache_key) != SUCCESS)) {
+      GELOGW("Generate the cache key of graph %u failed, build it without the cache.", graph_node->GetGraphId());
+      cache_key.clear();
+    }
+  }
+
+  if (!cache_key.empty()) {
+    ge_model = graph_cache_.Lookup(cache_key);
+    if (ge_model != nullptr) {
+      // the model was built in another session, it takes the ids of this one
+      GE_CHK_BOOL_RET_STATUS(AttrUtils::SetInt(ge_model, MODEL_ATTR_SESSION_ID, static_cast<int64_t>(session_id)),
+                             FAILED, "SetInt MODEL_ATTR_SESSION_ID failed.");
+      std::string session_graph_id;
+      auto model_graph = GraphUtils::GetComputeGraph(ge_model->GetGraph());
+      if (AttrUtils::GetStr(*compute_graph, ATTR_NAME_SESSION_GRAPH_ID, session_graph_id) && (model_graph != nullptr)) {
+        for (const auto &node : model_graph->GetAllNodes()) {
+          if (AttrUtils::HasAttr(node->GetOpDesc(), ATTR_NAME_SESSION_GRAPH_ID)) {
+            (void)AttrUtils::SetStr(node->GetOpDesc(), ATTR_NAME_SESSION_GRAPH_ID, session_graph_id);
+          }
+        }
+      }
+      // the built graph stands for the subgraphs, as the merged graph does after PreRun
+      auto sub_graph_info = MakeShared<SubGraphInfo>();
+      GE_CHECK_NOTNULL(sub_graph_info);
+      sub_graph_info->SetSubGraph(model_graph);
+      sub_graph_info->SetGeModelPtr(ge_model);
+      std::vector<SubGraphInfoPtr> sub_graph_list = {sub_graph_info};
+      graph_node->SetSubGraph(sub_graph_list);
+      ge_models.push_back(ge_model);
+      GELOGI("Graph %u is loaded from the graph cache, skip PreRun.", graph_node->GetGraphId());
+      return SUCCESS;
+    }
+  }
+
+  Status ret = PreRun(graph_node, inputs, ge_models, ge_model, session_id);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  if (!cache_key.empty() && (graph_cache_.Store(cache_key, ge_model) != SUCCESS)) {
+    GELOGW("Store graph %u to the graph cache failed.", graph_node->GetGraphId());
+  }
+  return SUCCESS;
+}
+
 Status GraphManager::StartForRunGraph(const GraphNodePtr &graph_node, const std::vector<GeTensor> &inputs,
                                       vector<GeModelPtr> &ge_models, uint64_t session_id) {
   // it will not execute graph prreprocess, optimize, parition, build if the graph has built successful.
@@ -399,8 +483,15 @@ Status GraphManager::StartForRunGraph(const GraphNodePtr &graph_node, const std:
              graph_node->GetGraphId());
       return PARAM_INVALID;
     }
+    // the variables left by the removed graphs are packed down before the graph takes new var memory
+    ret = VarManager::Instance(session_id)->CompactVarMem(
+        [this](const std::string &var_name) { return var_acc_ctrl_.IsVarInUse(var_name); });
+    if (ret != SUCCESS) {
+      GELOGE(ret, "Compact var mem failed.");
+      return ret;
+    }
     GeModelPtr ge_model = nullptr;
-    ret = PreRun(graph_node, inputs, ge_models, ge_model, session_id);
+    ret = PreRunWithCache(graph_node, inputs, ge_models, ge_model, session_id);
     if (ret != SUCCESS) {
       GELOGE(ret, "PreRun Failed.");
       return ret;
@@ -438,7 +529,6 @@ Status GraphManager::LoadGraph(const GeModelPtr &ge_model, const GraphNodePtr &g
     GE_TIMESTAMP_END(LoadGraph, "GraphManager::LoadGraph");
     if (ret != SUCCESS) {
       GELOGE(ret, "[StartForRunGraph] LoadGraph Failed");
-      graph_node->SetRunFlag(false);
       return ret;
     }
     graph_node->SetLoadFlag(true);
@@ -450,20 +540,11 @@ Status GraphManager::LoadGraph(const GeModelPtr &ge_model, const GraphNodePtr &g
 
 Status GraphManager::InnerRunGraph(GraphNodePtr &graph_node, const GraphId &graph_id,
                                    const std::vector<GeTensor> &inputs, std::vector<GeTensor> &outputs) {
-  Status ret = graph_executor_.SetCondition(&sync_run_mutex_, &condition_, graph_run_listener_);
-  if (ret != SUCCESS) {
-    GELOGE(GE_GRAPH_RUNGRAPH_FAILED, "[RunGraph] set condition failed, graph_id = %u.", graph_id);
-    graph_node->SetRunFlag(false);
-    return GE_GRAPH_RUNGRAPH_FAILED;
-  }
-
   if (GetTrainFlag()) {
     GE_CHK_STATUS_RET(graph_executor_.SetGraphContext(GetGraphContext()))
     graph_executor_.SetTrainFlag(options_.train_graph_flag);
   }
-  ret = graph_executor_.ExecuteGraph(graph_id, graph_node->GetGeModel(), inputs, outputs);
-
-  graph_node->SetRunFlag(false);
+  Status ret = graph_executor_.ExecuteGraph(graph_id, graph_node->GetGeModel(), inputs, outputs);
   if (ret != SUCCESS) {
     GELOGE(ret, "[RunGraph] execute graph failed, graph_id = %u.", graph_id);
     return ret;
@@ -473,7 +554,8 @@ Status GraphManager::InnerRunGraph(GraphNodePtr &graph_node, const GraphId &grap
 
 Status GraphManager::RunGraph(const GraphId &graph_id, const std::vector<GeTensor> &inputs,
                               std::vector<GeTensor> &outputs, uint64_t session_id) {
-  std::lock_guard<std::mutex> lock(run_mutex_);
+  TraceRequestScope request_scope(Tracer::IsOn() ? Tracer::NewRequestId() : 0);
+  GE_TRACE_SCOPE("GraphManager::RunGraph");
   GELOGI("[RunGraph] start to run graph, graph_id = %u, is_train_graph: %d", graph_id, GetTrainFlag());
 
   if (inputs.empty()) {
@@ -493,12 +575,20 @@ Status GraphManager::RunGraph(const GraphId &graph_id, const std::vector<GeTenso
     return GE_GRAPH_GRAPH_NODE_NULL;
   }
 
-  if (graph_node->GetRunFlag()) {
+  // training graphs update the shared variables, they still run one at a time.
+  // Other graphs run concurrently, also several runs of the same graph once it is loaded.
+  bool exclusive = GetTrainFlag();
+  std::unique_lock<std::mutex> train_lock(run_mutex_, std::defer_lock);
+  if (exclusive) {
+    train_lock.lock();
+  }
+
+  // set graph's run flag
+  if (!graph_node->TryStartRun(exclusive)) {
     GELOGE(GE_GRAPH_ALREADY_RUNNING, "[RunGraph] graph already running, graph id = %u", graph_id);
     return GE_GRAPH_ALREADY_RUNNING;
   }
-  // set graph's run flag
-  graph_node->SetRunFlag(true);
+  GE_MAKE_GUARD(run_flag, [&] { graph_node->EndRun(exclusive); });
   ComputeGraphPtr compute_graph_tmp = GraphUtils::GetComputeGraph(*(graph_node->GetGraph()));
 
   GE_IF_BOOL_EXEC(
@@ -512,15 +602,21 @@ Status GraphManager::RunGraph(const GraphId &graph_id, const std::vector<GeTenso
 
   std::vector<GeModelPtr> ge_models;
 
-  if (options_.local_fmk_op_flag) {
-    graph_optimize_.TranFrameOp(compute_graph_tmp);
-  }
+  // a loaded graph goes straight to execution, graphs are built and loaded one at a time
+  if (IsGraphNeedBuild(graph_node) || !graph_node->GetLoadFlag()) {
+    std::lock_guard<std::mutex> build_lock(build_mutex_);
+    if (options_.local_fmk_op_flag) {
+      graph_optimize_.TranFrameOp(compute_graph_tmp);
+    }
 
-  ret = StartForRunGraph(graph_node, inputs, ge_models, session_id);
-  if (ret != SUCCESS) {
-    GELOGE(ret, "[RunGraph] StartForRunGraph failed!");
-    graph_node->SetRunFlag(false);
-    return ret;
+    ret = StartForRunGraph(graph_node, inputs, ge_models, session_id);
+    // the output nodes of the user only apply to this build
+    domi::GetContext().out_nodes_map.clear();
+    domi::GetContext().user_out_nodes.clear();
+    if (ret != SUCCESS) {
+      GELOGE(ret, "[RunGraph] StartForRunGraph failed!");
+      return ret;
+    }
   }
 
   const std::vector<SubGraphInfoPtr> &all_sub_graph = graph_node->GetAllSubGraph();
@@ -574,21 +670,24 @@ Status GraphManager::BuildGraph(const GraphId &graph_id, const std::vector<GeTen
     return GE_GRAPH_GRAPH_NODE_NULL;
   }
 
-  if (graph_node->GetRunFlag()) {
+  // set graph's run flag
+  if (!graph_node->TryStartRun(true)) {
     GELOGE(GE_GRAPH_ALREADY_RUNNING, "[BuildGraph] graph already running, graph id = %u", graph_node->GetGraphId());
     return GE_GRAPH_ALREADY_RUNNING;
   }
-  // set graph's run flag
-  graph_node->SetRunFlag(true);
 
   struct timeval tv;
   if (gettimeofday(&tv, nullptr) != 0) {
     GELOGE(INTERNAL_ERROR, "get the time of day failed.");
+    graph_node->EndRun(true);
     return INTERNAL_ERROR;
   }
   uint64_t session_id = static_cast<uint64_t>(tv.tv_sec * 1000000 + tv.tv_usec);  // 1000000us
-  ret = StartForRunGraph(graph_node, inputs, models, session_id);
-  graph_node->SetRunFlag(false);
+  {
+    std::lock_guard<std::mutex> build_lock(build_mutex_);
+    ret = StartForRunGraph(graph_node, inputs, models, session_id);
+  }
+  graph_node->EndRun(true);
   if (ret != SUCCESS) {
     GELOGE(GE_GRAPH_PRERUN_FAILED, "[BuildGraph] StartForRunGraph failed!");
     return GE_GRAPH_PRERUN_FAILED;
@@ -627,16 +726,22 @@ Status GraphManager::SaveParams(ge::GeModel &model, const std::string &type, con
 }
 
 Status GraphManager::RemoveGraph(const GraphId &graph_id) {
-  auto it = graph_map_.find(graph_id);
-  if (it == graph_map_.end()) {
-    GELOGE(GE_GRAPH_GRAPH_NOT_EXIST, "[GraphManager] Id %u does not exists.", graph_id);
-    return GE_GRAPH_GRAPH_NOT_EXIST;
-  }
+  GraphNodePtr graph_node = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(graph_map_mutex_);
+    auto it = graph_map_.find(graph_id);
+    if (it == graph_map_.end()) {
+      GELOGE(GE_GRAPH_GRAPH_NOT_EXIST, "[GraphManager] Id %u does not exists.", graph_id);
+      return GE_GRAPH_GRAPH_NOT_EXIST;
+    }
 
-  GraphNodePtr graph_node = it->second;
-  if ((graph_node == nullptr) || (graph_node->GetRunFlag())) {
-    GELOGE(GE_GRAPH_GRAPH_IS_RUNNING, "[GraphManager] Id %u is running, can't be deleted.", graph_id);
-    return GE_GRAPH_GRAPH_IS_RUNNING;
+    graph_node = it->second;
+    // the graph stays marked running, no run can start on it while the model is unloaded
+    if ((graph_node == nullptr) || !graph_node->TryStartRun(true)) {
+      GELOGE(GE_GRAPH_GRAPH_IS_RUNNING, "[GraphManager] Id %u is running, can't be deleted.", graph_id);
+      return GE_GRAPH_GRAPH_IS_RUNNING;
+    }
+    graph_map_.erase(it);
   }
   Status ret = SUCCESS;
   Status middle_ret;
@@ -674,7 +779,6 @@ Status GraphManager::RemoveGraph(const GraphId &graph_id) {
     }
   }
   var_acc_ctrl_.RemoveGraph(graph_id);
-  graph_map_.erase(it);
   auto ge_model = graph_node->GetGeModel();
   if (ge_model != nullptr) {
     GELOGI("Unload model %u.", ge_model->GetModelId());
@@ -698,6 +802,14 @@ Status GraphManager::RemoveGraph(const GraphId &graph_id) {
     }
   }
   GE_CHK_STATUS_RET(ret, "[GraphManager:] Remove graph failed, graph_id=%u.", graph_id);
+  // its models are unloaded, the memory of the constants and replaced variables only it used goes back
+  ComputeGraphPtr compute_graph = nullptr;
+  if (graph_node->GetGraph() != nullptr) {
+    compute_graph = GraphUtils::GetComputeGraph(*graph_node->GetGraph());
+  }
+  if (compute_graph != nullptr) {
+    VarManager::Instance(compute_graph->GetSessionID())->ReleaseGraphVarMem(graph_id);
+  }
   GELOGI("[GraphManager] remove graph success, graph_id=%u.", graph_id);
   return SUCCESS;
 }
@@ -1009,6 +1121,7 @@ Status GraphManager::ParseParallelNum(const std::string &parallel_num, const std
 }
 
 Status GraphManager::GetGraphNode(const GraphId &graph_id, GraphNodePtr &out) {
+  std::lock_guard<std::mutex> lock(graph_map_mutex_);
   auto iter = graph_map_.find(graph_id);
   if (iter == graph_map_.end()) {
     out = nullptr;
@@ -1064,7 +1177,7 @@ Status GraphManager::SummaryHandle(const GraphId &graph_id, std::vector<GeTensor
 
 Status GraphManager::CheckpointHandle(const GraphId &graph_id, const std::vector<GeTensor> &outputs) {
   GELOGI("[GraphManager] CheckpointHandle, outputsSize=%zu.", outputs.size());
-  std::vector<InputOutputDescInfo> outputs_desc = graph_executor_.GetOutputsDesc();
+  std::vector<InputOutputDescInfo> outputs_desc = graph_executor_.GetOutputsDesc(graph_id);
   GELOGI("[GraphManager] CheckpointHandle, outputsDescSize=%zu.", outputs_desc.size());
   std::map<string, Tensor> save_results;
   for (size_t i = 0; i < outputs_desc.size(); ++i) {
@@ -1456,12 +1569,23 @@ Status GraphManager::CheckAndReleaseMemory(const GeModelPtr &ge_model, const Gra
     return SUCCESS;
   }
   rtError_t rt_ret;
-  for (auto &it : graph_map_) {
+  std::map<GraphId, GraphNodePtr> graph_map;
+  {
+    std::lock_guard<std::mutex> lock(graph_map_mutex_);
+    graph_map = graph_map_;
+  }
+  for (auto &it : graph_map) {
     auto graph_id = it.second->GetGraphId();
     auto model = it.second->GetGeModel();
     if (model == nullptr) {
       continue;
     }
+    // a running graph keeps its model, the graph is kept marked running until it is unloaded
+    if (!it.second->TryStartRun(true)) {
+      GELOGI("CheckAndReleaseMemory graph[%u] is running.", graph_id);
+      continue;
+    }
+    GE_MAKE_GUARD(run_flag, [&] { it.second->EndRun(true); });
     auto model_id = model->GetModelId();
     // not loaded,no need unload
     if (!it.second->GetLoadFlag()) {
@@ -1581,14 +1705,13 @@ void GraphManager::PreRunThread(GraphManager *graph_manager) {
 
     graph_node->Lock();
 
-    if (graph_node->GetRunFlag()) {
+    // set graph's run flag
+    if (!graph_node->TryStartRun(true)) {
       ReturnError(graph_manager, args.callback, GE_GRAPH_GRAPH_NODE_NULL,
                   "[RunGraph] graph already running, graph id=" + std::to_string(args.graph_id));
       graph_node->Unlock();
       return;
     }
-    // set graph's run flag
-    graph_node->SetRunFlag(true);
 
     ComputeGraphPtr compute_graph_tmp = GraphUtils::GetComputeGraph(*(graph_node->GetGraph()));
 
@@ -1607,6 +1730,8 @@ void GraphManager::PreRunThread(GraphManager *graph_manager) {
 
     std::vector<GeModelPtr> ge_models;
 
+    // graphs run synchronously may be built at the same time
+    std::unique_lock<std::mutex> build_lock(graph_manager->build_mutex_);
     if (graph_manager->options_.local_fmk_op_flag) {
       graph_manager->graph_optimize_.TranFrameOp(compute_graph_tmp);
     }
@@ -1625,7 +1750,7 @@ void GraphManager::PreRunThread(GraphManager *graph_manager) {
         return;
       }
 
-      ret = graph_manager->PreRun(graph_node, ge_inputs, ge_models, ge_model, args.session_id);
+      ret = graph_manager->PreRunWithCache(graph_node, ge_inputs, ge_models, ge_model, args.session_id);
       if (ret != SUCCESS) {
         graph_node->SetRunFlag(false);
         ReturnError(graph_manager, args.callback, ret, "PreRun Failed.");
@@ -1637,6 +1762,7 @@ void GraphManager::PreRunThread(GraphManager *graph_manager) {
     } else {
       ge_model = graph_node->GetGeModel();
     }
+    build_lock.unlock();
 
     graph_manager->run_args_q_.Push(RunArgs({graph_node, args.graph_id, args.input_tensor, args.output_tensor, ge_model,
                                              GetThreadLocalContext(), args.callback}));
@@ -1662,6 +1788,7 @@ void GraphManager::RunThread(GraphManager *graph_manager) {
 
     Status ret;
     if (!args.graph_node->GetLoadFlag()) {
+      std::lock_guard<std::mutex> build_lock(graph_manager->build_mutex_);
       ret = graph_manager->LoadGraphAsync(args.ge_model, args.graph_node);
       if (ret != SUCCESS) {
         StopQueue(graph_manager);
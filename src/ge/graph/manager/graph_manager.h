@@ -33,6 +33,7 @@
 #include "graph/execute/graph_execute.h"
 #include "graph/ge_local_context.h"
 #include "graph/load/graph_loader.h"
+#include "graph/manager/graph_cache.h"
 #include "graph/manager/graph_manager_utils.h"
 #include "graph/manager/util/variable_accelerate_ctrl.h"
 #include "graph/optimize/graph_optimize.h"
@@ -179,6 +180,13 @@ class GraphManager {
   Status PreRun(const GraphNodePtr &graph_node, const std::vector<GeTensor> &inputs, vector<GeModelPtr> &ge_models,
                 GeModelPtr &ge_model, uint64_t session_id = INVALID_SESSION_ID);
 
+  ///
+  /// @ingroup ge_graph
+  /// @brief PreRun, unless the model of the graph is in the graph cache, the graph is not changed then
+  ///
+  Status PreRunWithCache(const GraphNodePtr &graph_node, const std::vector<GeTensor> &inputs,
+                         vector<GeModelPtr> &ge_models, GeModelPtr &ge_model, uint64_t session_id);
+
   Status StartForRunGraph(const GraphNodePtr &graph_node, const std::vector<GeTensor> &inputs,
                           vector<GeModelPtr> &ge_models, uint64_t session_id = INVALID_SESSION_ID);
 
@@ -269,6 +277,8 @@ class GraphManager {
   std::thread prerun_thread_;
   std::thread run_thread_;
 
+  std::mutex graph_map_mutex_;
+  // guarded by graph_map_mutex_
   std::map<GraphId, GraphNodePtr> graph_map_;
 
   // for run graph synchronous return
@@ -291,10 +301,15 @@ class GraphManager {
   GraphLoader graph_loader_;
   GraphExecutor graph_executor_;
   GraphContextPtr graph_context_ = nullptr;
+  GraphCache graph_cache_;
 
   VarAccelerateCtrl var_acc_ctrl_;
 
+  // serializes the runs of training graphs
   std::mutex run_mutex_;
+  // serializes graph build and load of all sessions, a loaded graph runs without it. The builds share the
+  // out nodes of domi::GetContext(), so the sessions can not build at the same time
+  static std::mutex build_mutex_;
 };
 };  // namespace ge
 
@@ -33,6 +33,7 @@ namespace ge {
 GraphNode::GraphNode(GraphId graph_id)
     : graph_id_(graph_id),
       run_flag_(false),
+      run_count_(0),
       subgraph_ptr_list_(),
       graph_(nullptr),
       compute_graph_(nullptr),
@@ -48,6 +49,38 @@ GraphNode::GraphNode(GraphId graph_id)
 
 GraphNode::~GraphNode() = default;
 
+bool GraphNode::GetRunFlag() const {
+  std::lock_guard<std::mutex> lock(run_mutex_);
+  return run_flag_ || (run_count_ > 0);
+}
+
+void GraphNode::SetRunFlag(bool flag) {
+  std::lock_guard<std::mutex> lock(run_mutex_);
+  run_flag_ = flag;
+}
+
+bool GraphNode::TryStartRun(bool exclusive) {
+  std::lock_guard<std::mutex> lock(run_mutex_);
+  if (run_flag_ || (exclusive && (run_count_ > 0))) {
+    return false;
+  }
+  if (exclusive) {
+    run_flag_ = true;
+  } else {
+    ++run_count_;
+  }
+  return true;
+}
+
+void GraphNode::EndRun(bool exclusive) {
+  std::lock_guard<std::mutex> lock(run_mutex_);
+  if (exclusive) {
+    run_flag_ = false;
+  } else if (run_count_ > 0) {
+    --run_count_;
+  }
+}
+
 void GraphNode::Lock() {
   sem_.Push(0);
 }
@@ -96,7 +129,7 @@ Status SubGraphInfo::FreeInOutBuffer() {
   }
 }
 
-GraphModelListener::GraphModelListener() : result_code_(0), is_finished_(false), mutex_(nullptr), condition_(nullptr) {}
+GraphModelListener::GraphModelListener() : mutex_(nullptr), condition_(nullptr) {}
 
 Status GraphModelListener::SetCondition(std::mutex *mutex, std::condition_variable *cond) {
   if (mutex == nullptr || cond == nullptr) {
@@ -116,34 +149,60 @@ Status GraphModelListener::OnComputeDone(uint32_t model_id, uint32_t task_id, ui
       model_id, task_id, result);
   GE_IF_BOOL_EXEC(condition_ == nullptr, GELOGE(FAILED, "[GraphModelListener] condition is null."); return FAILED);
   std::lock_guard<std::mutex> lock(*mutex_);
-  result_code_ = result;
-  is_finished_ = true;
+  auto iter = results_.find(std::make_pair(model_id, task_id));
+  if (iter == results_.end()) {
+    GELOGW("[GraphModelListener] no request is waiting for model_id:%u, task_id:%u.", model_id, task_id);
+    return SUCCESS;
+  }
+  iter->second.result_code = result;
+  iter->second.is_finished = true;
+  // the waiters of all requests share the condition, each checks its own request
   condition_->notify_all();
 
   return SUCCESS;
 }
 
-uint32_t GraphModelListener::GetResultCode() const {
-  if (!is_finished_) {
-    GELOGE(INTERNAL_ERROR, "[GraphManager] model not run finish.");
-    return INTERNAL_ERROR;
+Status GraphModelListener::ResetResult(uint32_t model_id, uint32_t data_index) {
+  if (mutex_ == nullptr) {
+    GELOGE(GE_GRAPH_PARAM_NULLPTR, "[GraphManager] param is NULL.");
+    return GE_GRAPH_PARAM_NULLPTR;
   }
-  return result_code_;
+
+  std::lock_guard<std::mutex> lock(*mutex_);
+  results_[std::make_pair(model_id, data_index)] = {false, 0};
+
+  return SUCCESS;
 }
 
-Status GraphModelListener::ResetResult() {
-  if (mutex_ == nullptr) {
+Status GraphModelListener::WaitResult(uint32_t model_id, uint32_t data_index, uint32_t &result_code) {
+  if ((mutex_ == nullptr) || (condition_ == nullptr)) {
     GELOGE(GE_GRAPH_PARAM_NULLPTR, "[GraphManager] param is NULL.");
     return GE_GRAPH_PARAM_NULLPTR;
   }
 
-  std::lock_guard<std::mutex> lock(*mutex_);
-  result_code_ = 0;
-  is_finished_ = false;
+  std::unique_lock<std::mutex> lock(*mutex_);
+  auto iter = results_.find(std::make_pair(model_id, data_index));
+  if (iter == results_.end()) {
+    GELOGE(INTERNAL_ERROR, "[GraphManager] request is not registered, model_id:%u, data_index:%u.", model_id,
+           data_index);
+    return INTERNAL_ERROR;
+  }
+  // the entry is only erased by this waiter, the iterator stays valid while waiting
+  condition_->wait(lock, [&iter]() { return iter->second.is_finished; });
+  result_code = iter->second.result_code;
+  (void)results_.erase(iter);
 
   return SUCCESS;
 }
 
+void GraphModelListener::EraseResult(uint32_t model_id, uint32_t data_index) {
+  if (mutex_ == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(*mutex_);
+  (void)results_.erase(std::make_pair(model_id, data_index));
+}
+
 void RunAsyncListener::SetCallback(const std::function<void(Status)> &callback) {
   sem_.Push(0);
   callback_ = callback;
@@ -17,6 +17,7 @@
 #ifndef GE_GRAPH_MANAGER_GRAPH_MANAGER_UTILS_H_
 #define GE_GRAPH_MANAGER_GRAPH_MANAGER_UTILS_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <map>
 #include <memory>
@@ -145,8 +146,18 @@ class GraphNode {
   ComputeGraphPtr GetComputeGraph() const { return compute_graph_; }
   void SetComputeGraph(const ComputeGraphPtr &compute_graph) { compute_graph_ = compute_graph; }
 
-  bool GetRunFlag() const { return run_flag_; }
-  void SetRunFlag(bool flag) { run_flag_ = flag; }
+  bool GetRunFlag() const;
+  void SetRunFlag(bool flag);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief mark the graph running. Shared runs of a loaded graph may overlap each other,
+  ///        an exclusive run (build, training or asynchronous run) excludes any other run.
+  /// @param [in] exclusive whether the run excludes other runs
+  /// @return bool false: the graph is running and the run must not start
+  ///
+  bool TryStartRun(bool exclusive);
+  void EndRun(bool exclusive);
 
   void SetSubGraph(std::vector<SubGraphInfoPtr> &subgraph_ptr_list) { subgraph_ptr_list_ = subgraph_ptr_list; }
   const std::vector<SubGraphInfoPtr> &GetAllSubGraph() const { return subgraph_ptr_list_; }
@@ -165,13 +176,16 @@ class GraphNode {
 
  private:
   GraphId graph_id_;
+  mutable std::mutex run_mutex_;
   bool run_flag_;
+  uint32_t run_count_;
   std::vector<SubGraphInfoPtr> subgraph_ptr_list_;
 
   GraphPtr graph_;
   ComputeGraphPtr compute_graph_;
-  bool build_flag_;
-  bool load_flag_;
+  // read without the build lock by runs of a loaded graph
+  std::atomic<bool> build_flag_;
+  std::atomic<bool> load_flag_;
   GeModelPtr ge_model_;
   BlockingQueue<uint8_t> sem_;
 };
@@ -190,16 +204,34 @@ class GraphModelListener : public ge::ModelListener {
 
   Status SetCondition(std::mutex *mutex, std::condition_variable *cond);
 
-  Status ResetResult();
-
-  // need lock by caller
-  uint32_t GetResultCode() const;
-
-  bool IsFinished() const { return is_finished_; }
+  ///
+  /// @ingroup ge_graph
+  /// @brief register a request before its data is pushed to the model
+  /// @param [in] model_id model the request runs on
+  /// @param [in] data_index index of the input data, unique among the pending requests of the model
+  ///
+  Status ResetResult(uint32_t model_id, uint32_t data_index);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief wait until the model returns the request and take its result
+  /// @param [in] model_id model the request runs on
+  /// @param [in] data_index index of the input data
+  /// @param [out] result_code result returned by the model
+  ///
+  Status WaitResult(uint32_t model_id, uint32_t data_index, uint32_t &result_code);
+
+  // forget a request whose data was not accepted by the model
+  void EraseResult(uint32_t model_id, uint32_t data_index);
 
  private:
-  uint32_t result_code_;
-  bool is_finished_;
+  struct RequestResult {
+    bool is_finished;
+    uint32_t result_code;
+  };
+
+  // (model id, data index) -> result of the requests still waited for
+  std::map<std::pair<uint32_t, uint32_t>, RequestResult> results_;
 
   // not owner
   std::mutex *mutex_;
@@ -23,6 +23,14 @@
 #include "framework/common/debug/ge_log.h"
 
 namespace ge {
+namespace {
+// the feature maps and weights of the models unloaded, the larger blocks such as the var memory go back at once
+const uint64_t kMaxCachedMemorySize = 256UL * 1024UL * 1024UL;
+}  // namespace
+
+MemoryAllocator::MemoryAllocator(rtMemType_t memory_type)
+    : memory_type_(memory_type), mem_malloced_(false), caching_allocator_(memory_type, false, kMaxCachedMemorySize) {}
+
 void MemoryAllocator::Initialize(uint32_t device_id) {
   GELOGI("MemoryAllocator::Initialize");
 
@@ -45,12 +53,12 @@ void MemoryAllocator::Finalize(uint32_t device_id) {
     }
   }
   memory_base_map_.clear();
+  caching_allocator_.Trim(0);
 }
 
 uint8_t *MemoryAllocator::MallocMemory(uint64_t memory_size, uint32_t device_id) const {
-  uint8_t *memory_addr = nullptr;
-
-  if (rtMalloc(reinterpret_cast<void **>(&memory_addr), memory_size, memory_type_) != RT_ERROR_NONE) {
+  uint8_t *memory_addr = caching_allocator_.Malloc(memory_size);
+  if (memory_addr == nullptr) {
     GELOGE(ge::INTERNAL_ERROR,
            "MemoryAllocator::MallocMemory device_id = %u,"
            " size= %lu",
@@ -65,7 +73,7 @@ uint8_t *MemoryAllocator::MallocMemory(uint64_t memory_size, uint32_t device_id)
 
 Status MemoryAllocator::FreeMemory(uint8_t *memory_addr, uint32_t device_id) const {
   GELOGI("MemoryAllocator::FreeMemory device_id = %u", device_id);
-  if (rtFree(memory_addr) != RT_ERROR_NONE) {
+  if (caching_allocator_.Free(memory_addr) != SUCCESS) {
     GELOGE(ge::INTERNAL_ERROR, "MemoryAllocator::MallocMemory device_id = %u", device_id);
     return ge::INTERNAL_ERROR;
   }
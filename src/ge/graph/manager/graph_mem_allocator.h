@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "framework/common/ge_inner_error_codes.h"
+#include "graph/manager/caching_allocator.h"
 #include "graph/node.h"
 #include "runtime/mem.h"
 
@@ -61,7 +62,7 @@ class MemoryInfo {
 
 class MemoryAllocator {
  public:
-  explicit MemoryAllocator(rtMemType_t memory_type) : memory_type_(memory_type), mem_malloced_(false) {}
+  explicit MemoryAllocator(rtMemType_t memory_type);
 
   virtual ~MemoryAllocator() = default;
 
@@ -82,7 +83,7 @@ class MemoryAllocator {
 
   ///
   /// @ingroup ge_graph
-  /// @brief malloc memory
+  /// @brief malloc memory, the blocks freed before are reused
   /// @param [in] size memory size
   /// @param [in] device_id device id
   /// @return  memory address
@@ -126,10 +127,14 @@ class MemoryAllocator {
   ///
   uint8_t *GetMemoryAddr(const string &memory_key, uint32_t device_id = 0);
 
+  CachingAllocatorStats GetStats() const { return caching_allocator_.GetStats(); }
+
  private:
   rtMemType_t memory_type_;
   bool mem_malloced_;
   map<string, MemoryInfo> memory_base_map_;
+  // the memory freed is kept for the next mallocs, up to kMaxCachedMemorySize
+  mutable CachingAllocator caching_allocator_;
 };
 
 using MemoryAllocatorPtr = std::shared_ptr<MemoryAllocator>;
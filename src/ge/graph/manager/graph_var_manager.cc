@@ -34,6 +34,85 @@ using std::vector;
 using std::map;
 
 namespace ge {
+namespace {
+// the var key is the interned name over the format and the data type
+const uint32_t kVarKeyIdShift = 32;
+const uint32_t kVarKeyFormatShift = 16;
+const uint64_t kVarKeyFieldMask = 0xffff;
+
+///
+/// Device memory a var block is staged in while it slides over a hole smaller than itself,
+/// kept for the whole compaction and grown on demand.
+///
+class VarMemStage {
+ public:
+  explicit VarMemStage(rtMemType_t memory_type) : memory_type_(memory_type) {}
+
+  ~VarMemStage() { Release(); }
+
+  VarMemStage(const VarMemStage &) = delete;
+  VarMemStage &operator=(const VarMemStage &) = delete;
+
+  uint8_t *Get(uint64_t size) {
+    if (size <= size_) {
+      return addr_;
+    }
+    Release();
+    void *addr = nullptr;
+    rtError_t rt_ret = rtMalloc(&addr, size, memory_type_);
+    if (rt_ret != RT_ERROR_NONE) {
+      GELOGE(RT_FAILED, "Malloc var mem stage of %lu bytes failed, ret: 0x%X.", size, rt_ret);
+      return nullptr;
+    }
+    addr_ = reinterpret_cast<uint8_t *>(addr);
+    size_ = size;
+    return addr_;
+  }
+
+ private:
+  void Release() {
+    if (addr_ != nullptr) {
+      (void)rtFree(addr_);
+      addr_ = nullptr;
+      size_ = 0;
+    }
+  }
+
+  rtMemType_t memory_type_;
+  uint8_t *addr_ = nullptr;
+  uint64_t size_ = 0;
+};
+
+///
+/// Slide a var block down to a lower offset. The block either ends up whole at dst_offset, or is
+/// left as it was at src_offset, so the caller records the move only on success.
+///
+Status MoveVarBlock(uint8_t *mem_base, uint64_t src_offset, uint64_t dst_offset, uint64_t size, VarMemStage &stage) {
+  uint8_t *src = mem_base + src_offset;
+  uint8_t *dst = mem_base + dst_offset;
+  if (src_offset - dst_offset >= size) {
+    // the hole takes the whole block, the copy does not touch the block
+    GE_CHK_RT_RET(rtMemcpy(dst, size, src, size, RT_MEMCPY_DEVICE_TO_DEVICE));
+    return SUCCESS;
+  }
+
+  // the copy overwrites the head of the block, keep the block whole in the stage until it is done
+  uint8_t *staged = stage.Get(size);
+  if (staged == nullptr) {
+    return MEMALLOC_FAILED;
+  }
+  GE_CHK_RT_RET(rtMemcpy(staged, size, src, size, RT_MEMCPY_DEVICE_TO_DEVICE));
+  rtError_t rt_ret = rtMemcpy(dst, size, staged, size, RT_MEMCPY_DEVICE_TO_DEVICE);
+  if (rt_ret != RT_ERROR_NONE) {
+    rtError_t restore_ret = rtMemcpy(src, size, staged, size, RT_MEMCPY_DEVICE_TO_DEVICE);
+    GELOGE(RT_FAILED, "Copy var block from offset %lu to %lu failed, ret: 0x%X, restore ret: 0x%X.", src_offset,
+           dst_offset, rt_ret, restore_ret);
+    return RT_FAILED;
+  }
+  return SUCCESS;
+}
+}  // namespace
+
 VarResource::VarResource(uint64_t session_id) : session_id_(session_id) {}
 
 VarResource::~VarResource() {
@@ -49,12 +128,14 @@ ge::Status VarResource::GetVarAddr(const std::string &var_name, const ge::GeTens
     GELOGE(FAILED, "[GetVarAddr] dev_ptr is null!");
     return FAILED;
   }
-  std::string var_key = VarKey(var_name, tensor_desc);
-  GELOGD("VarResource::GetVarAddr , var_key = %s", var_key.c_str());
+  GELOGD("VarResource::GetVarAddr , var_name = %s, format = %d, data_type = %d", var_name.c_str(),
+         static_cast<int32_t>(tensor_desc.GetFormat()), static_cast<int32_t>(tensor_desc.GetDataType()));
 
-  auto iter = var_addr_mgr_map_.find(var_key);
+  uint64_t var_key = 0;
+  auto iter = FindVarKey(var_name, tensor_desc, var_key) ? var_addr_mgr_map_.find(var_key) : var_addr_mgr_map_.end();
   if (iter == var_addr_mgr_map_.end()) {
-    GELOGE(FAILED, "VarResource::GetVarAddr failed, var_key %s", var_key.c_str());
+    GELOGE(FAILED, "VarResource::GetVarAddr failed, var_name %s, format %d, data_type %d", var_name.c_str(),
+           static_cast<int32_t>(tensor_desc.GetFormat()), static_cast<int32_t>(tensor_desc.GetDataType()));
     return FAILED;
   }
 
@@ -66,8 +147,8 @@ ge::Status VarResource::GetVarAddr(const std::string &var_name, const ge::GeTens
 
 void VarResource::SetVarAddr(const std::string &var_name, const ge::GeTensorDesc &tensor_desc, uint8_t *dev_ptr,
                              rtMemType_t memory_type) {
-  std::string var_key = VarKey(var_name, tensor_desc);
-  GELOGI("VarResource::SetVarAddr , var_key = %s, mem_type:%u", var_key.c_str(), memory_type);
+  uint64_t var_key = VarKey(var_name, tensor_desc);
+  GELOGI("VarResource::SetVarAddr , var_key = %lu, mem_type:%u", var_key, memory_type);
   if (var_addr_mgr_map_.count(var_key) == 0) {
     GELOGI("SetVarAddr node_name %s, tensor_desc type %s, format %s", var_name.c_str(),
            TypeUtils::DataTypeToSerialString(tensor_desc.GetDataType()).c_str(),
@@ -84,8 +165,8 @@ void VarResource::SetVarAddr(const std::string &var_name, const ge::GeTensorDesc
 
 ge::Status VarResource::SaveVarAddr(const std::string &var_name, const ge::GeTensorDesc &tensor_desc, uint8_t *address,
                                     rtMemType_t memory_type) {
-  std::string var_key = VarKey(var_name, tensor_desc);
-  GELOGD("VarResource::SaveVarAddr, var_key = %s", var_key.c_str());
+  uint64_t var_key = VarKey(var_name, tensor_desc);
+  GELOGD("VarResource::SaveVarAddr, var_key = %lu", var_key);
   if (var_addr_mgr_map_.count(var_key) == 0) {
     uint64_t logic_address = VarManager::Instance(0)->GetVarMemLogicBase() +
                              reinterpret_cast<uint64_t>(reinterpret_cast<std::uintptr_t>(address));
@@ -99,34 +180,55 @@ ge::Status VarResource::SaveVarAddr(const std::string &var_name, const ge::GeTen
     var_addr_mgr.memory_type = memory_type;
     var_addr_mgr_map_[var_key] = var_addr_mgr;
     var_offset_set_.insert(logic_address);
+    var_mem_keys_.insert(var_key);
 
     return SUCCESS;
   }
 
-  GELOGE(FAILED, "VarResource::SaveVarAddr, var_key %s save addr conflict", var_key.c_str());
+  GELOGE(FAILED, "VarResource::SaveVarAddr, var_name %s, format %s, type %s save addr conflict", var_name.c_str(),
+         TypeUtils::FormatToSerialString(tensor_desc.GetFormat()).c_str(),
+         TypeUtils::DataTypeToSerialString(tensor_desc.GetDataType()).c_str());
   return FAILED;
 }
 
 bool VarResource::IsVarExist(const std::string &var_name, const ge::GeTensorDesc &tensor_desc) {
-  std::string var_key = VarKey(var_name, tensor_desc);
-  return var_addr_mgr_map_.count(var_key) != 0;
+  uint64_t var_key = 0;
+  return FindVarKey(var_name, tensor_desc, var_key) && (var_addr_mgr_map_.count(var_key) != 0);
 }
 
 bool VarResource::IsVarExist(const std::string &var_name) { return cur_var_tensor_desc_map_.count(var_name) != 0; }
 
-std::string VarResource::VarKey(const std::string &var_name, const ge::GeTensorDesc &tensor_desc) {
-  std::string var_key(var_name);
-  var_key.append(std::to_string(static_cast<int32_t>(tensor_desc.GetFormat())))
-      .append("_")
-      .append(std::to_string(static_cast<int32_t>(tensor_desc.GetDataType())));
-  return var_key;
+uint64_t VarResource::VarKey(const std::string &var_name, const ge::GeTensorDesc &tensor_desc) {
+  auto iter = var_ids_.find(var_name);
+  if (iter == var_ids_.end()) {
+    iter = var_ids_.emplace(var_name, static_cast<uint32_t>(var_names_.size())).first;
+    var_names_.push_back(var_name);
+  }
+  return (static_cast<uint64_t>(iter->second) << kVarKeyIdShift) |
+         ((static_cast<uint64_t>(tensor_desc.GetFormat()) & kVarKeyFieldMask) << kVarKeyFormatShift) |
+         (static_cast<uint64_t>(tensor_desc.GetDataType()) & kVarKeyFieldMask);
 }
 
+bool VarResource::FindVarKey(const std::string &var_name, const ge::GeTensorDesc &tensor_desc,
+                             uint64_t &var_key) const {
+  auto iter = var_ids_.find(var_name);
+  if (iter == var_ids_.end()) {
+    return false;
+  }
+  var_key = (static_cast<uint64_t>(iter->second) << kVarKeyIdShift) |
+            ((static_cast<uint64_t>(tensor_desc.GetFormat()) & kVarKeyFieldMask) << kVarKeyFormatShift) |
+            (static_cast<uint64_t>(tensor_desc.GetDataType()) & kVarKeyFieldMask);
+  return true;
+}
+
+const std::string &VarResource::VarKeyName(uint64_t var_key) const { return var_names_[var_key >> kVarKeyIdShift]; }
+
 ge::Status VarResource::GetCurVarDesc(const std::string &var_name, ge::GeTensorDesc &tensor_desc) {
-  if (cur_var_tensor_desc_map_.count(var_name) == 0) {
+  auto iter = cur_var_tensor_desc_map_.find(var_name);
+  if (iter == cur_var_tensor_desc_map_.end()) {
     return FAILED;
   }
-  tensor_desc = cur_var_tensor_desc_map_[var_name];
+  tensor_desc = iter->second;
   return SUCCESS;
 }
 
@@ -147,21 +249,39 @@ ge::Status VarResource::RenewCurVarDesc(const std::string &var_name, const ge::O
     GELOGE(FAILED, "[RenewCurVarDesc] Get var desc fail!");
     return FAILED;
   }
-  std::string key = VarKey(var_name, curr_desc);
+  uint64_t key = VarKey(var_name, curr_desc);
   curr_desc.SetOriginFormat((op_desc->GetOutputDesc(0)).GetOriginFormat());
   curr_desc.SetFormat((op_desc->GetOutputDesc(0)).GetFormat());
   cur_var_tensor_desc_map_[var_name] = curr_desc;
   auto iter = var_addr_mgr_map_.find(key);
   if (iter == var_addr_mgr_map_.end()) {
-    GELOGE(FAILED, "[RenewCurVarDesc] can't find ele with key [%s]", key.c_str());
+    GELOGE(FAILED, "[RenewCurVarDesc] can't find ele with key [%lu] of var %s", key, var_name.c_str());
     return FAILED;
   }
   auto val = iter->second;
   val.tensor_desc.SetOriginFormat((op_desc->GetOutputDesc(0)).GetOriginFormat());
   val.tensor_desc.SetFormat((op_desc->GetOutputDesc(0)).GetFormat());
   var_addr_mgr_map_.erase(iter);
-  key = VarKey(var_name, curr_desc);
-  var_addr_mgr_map_[key] = val;
+  uint64_t new_key = VarKey(var_name, curr_desc);
+  var_addr_mgr_map_[new_key] = val;
+
+  // the memory and the refs follow the var to its new key
+  if (var_mem_keys_.erase(key) > 0) {
+    var_mem_keys_.insert(new_key);
+  }
+  if (const_keys_.erase(key) > 0) {
+    const_keys_.insert(new_key);
+  }
+  auto graph_iter = var_key_graph_ids_.find(key);
+  if (graph_iter != var_key_graph_ids_.end()) {
+    for (uint32_t graph_id : graph_iter->second) {
+      graph_id_var_keys_[graph_id].erase(key);
+      graph_id_var_keys_[graph_id].insert(new_key);
+    }
+    std::unordered_set<uint32_t> graph_ids = std::move(graph_iter->second);
+    var_key_graph_ids_.erase(graph_iter);
+    var_key_graph_ids_[new_key] = std::move(graph_ids);
+  }
 
   return SUCCESS;
 }
@@ -170,24 +290,36 @@ void VarResource::SaveBroadCastInfo(uint32_t graph_id, const VarBroadCastInfo &b
   var_broad_cast_info_[graph_id][broad_cast_info.var_name] = broad_cast_info;
 }
 
-ge::Status VarResource::SyncVarData2BroadCast(uint32_t graph_id, const std::string &var_name,
+void VarResource::GetBroadCastInfo(uint32_t graph_id, const std::string &var_name,
+                                   VarBroadCastInfo &broad_cast_info) const {
+  broad_cast_info = VarBroadCastInfo();
+  auto graph_iter = var_broad_cast_info_.find(graph_id);
+  if (graph_iter == var_broad_cast_info_.end()) {
+    return;
+  }
+  auto iter = graph_iter->second.find(var_name);
+  if (iter != graph_iter->second.end()) {
+    broad_cast_info = iter->second;
+  }
+}
+
+ge::Status VarResource::SyncVarData2BroadCast(const VarBroadCastInfo &broad_cast_info, const std::string &var_name,
                                               const ge::ConstOpDescPtr &var_op_desc, uint8_t *base_ptr) {
   if (var_op_desc == nullptr) {
     GELOGE(FAILED, "[SyncVarData2BroadCast] var opdesc is null!");
     return FAILED;
   }
   GE_CHECK_NOTNULL(base_ptr);
-  GELOGI("SyncVarData2BroadCast graph_id: %u, var_name: %s.", graph_id, var_name.c_str());
+  GELOGI("SyncVarData2BroadCast var_name: %s.", var_name.c_str());
 
-  VarBroadCastInfo var_broadcast_info = var_broad_cast_info_[graph_id][var_name];
-  uint8_t *dst_addr = base_ptr + var_broadcast_info.input_offset;
+  uint8_t *dst_addr = base_ptr + broad_cast_info.input_offset;
   ge::GeTensorDesc var_tensor_desc = var_op_desc->GetOutputDesc(0);
 
-  return ge::TransVarDataUtils::SyncVarData2BroadCast(var_name, var_tensor_desc, dst_addr,
-                                                      var_broadcast_info.input_size, session_id_);
+  return ge::TransVarDataUtils::SyncVarData2BroadCast(var_name, var_tensor_desc, dst_addr, broad_cast_info.input_size,
+                                                      session_id_);
 }
 
-ge::Status VarResource::SyncBroadCastData2Var(uint32_t graph_id, const std::string &var_name,
+ge::Status VarResource::SyncBroadCastData2Var(const VarBroadCastInfo &broad_cast_info, const std::string &var_name,
                                               const ge::ConstOpDescPtr &var_op_desc, uint8_t *base_ptr) {
   GELOGI("SyncBroadCastData2Var var_name: %s", var_name.c_str());
   GE_CHECK_NOTNULL(var_op_desc);
@@ -197,16 +329,15 @@ ge::Status VarResource::SyncBroadCastData2Var(uint32_t graph_id, const std::stri
     return SUCCESS;
   }
 
-  VarBroadCastInfo var_broadcast_info = var_broad_cast_info_[graph_id][var_name];
   // subgraph base_ptr could be nullptr, task it as base 0
-  uint8_t *dst_addr = base_ptr + var_broadcast_info.output_offset;
+  uint8_t *dst_addr = base_ptr + broad_cast_info.output_offset;
   ge::GeTensorDesc var_tensor_desc = var_op_desc->GetOutputDesc(0);
 
-  return ge::TransVarDataUtils::SyncBroadCastData2Var(dst_addr, var_broadcast_info.output_size, var_name,
+  return ge::TransVarDataUtils::SyncBroadCastData2Var(dst_addr, broad_cast_info.output_size, var_name,
                                                       var_tensor_desc, session_id_);
 }
 
-ge::Status VarResource::SyncVarData(uint32_t graph_id, const std::string &var_name,
+ge::Status VarResource::SyncVarData(const VarBroadCastInfo &broad_cast_info, const std::string &var_name,
                                     const ge::ConstOpDescPtr &var_op_desc, uint8_t *base_ptr) {
   GE_CHECK_NOTNULL(var_op_desc);
   string var_is_broadcast;
@@ -215,7 +346,7 @@ ge::Status VarResource::SyncVarData(uint32_t graph_id, const std::string &var_na
     return SUCCESS;
   }
 
-  return SyncVarData2BroadCast(graph_id, var_name, var_op_desc, base_ptr);
+  return SyncVarData2BroadCast(broad_cast_info, var_name, var_op_desc, base_ptr);
 }
 
 bool VarResource::IsVarAddr(const int64_t &offset) { return var_offset_set_.count(offset) > 0; }
@@ -257,34 +388,181 @@ Status VarResource::SetAllocatedGraphId(const std::string &var_name, uint32_t gr
   return SUCCESS;
 }
 
-MemResource::MemResource() : total_size_(0), var_mem_base_(nullptr), var_mem_size_(0) {}
+ge::Status VarResource::RefVarAddr(const std::string &var_name, const ge::GeTensorDesc &tensor_desc, uint32_t graph_id,
+                                   bool is_const, uint8_t **dev_ptr, rtMemType_t &memory_type) {
+  GE_CHK_STATUS_RET_NOLOG(GetVarAddr(var_name, tensor_desc, dev_ptr, memory_type));
+  uint64_t var_key = VarKey(var_name, tensor_desc);
+  var_key_graph_ids_[var_key].insert(graph_id);
+  graph_id_var_keys_[graph_id].insert(var_key);
+  if (is_const) {
+    const_keys_.insert(var_key);
+  }
+  return SUCCESS;
+}
 
-Status MemResource::AssignVarMem(const std::string &var_name, uint64_t size, uint64_t session_id, size_t &mem_offset) {
-  size = (size + kSessionMemAlignSize - 1) / kSessionMemAlignSize * kSessionMemAlignSize;
+void VarResource::ReleaseGraph(uint32_t graph_id, std::vector<std::pair<rtMemType_t, uint64_t>> &free_offsets) {
+  auto graph_iter = graph_id_var_keys_.find(graph_id);
+  if (graph_iter == graph_id_var_keys_.end()) {
+    return;
+  }
+  std::unordered_set<uint64_t> released_keys = std::move(graph_iter->second);
+  graph_id_var_keys_.erase(graph_iter);
+  for (uint64_t var_key : released_keys) {
+    auto iter = var_key_graph_ids_.find(var_key);
+    if (iter != var_key_graph_ids_.end()) {
+      iter->second.erase(graph_id);
+      if (iter->second.empty()) {
+        var_key_graph_ids_.erase(iter);
+      }
+    }
+  }
 
-  total_size_ = VarManager::Instance(0)->GetVarMemMaxSize();
-  if (total_size_ < var_mem_size_) {
-    GELOGE(PARAM_INVALID, "total_size_: %lu is smaller than var_mem_size_: %lu", total_size_, var_mem_size_);
-    return PARAM_INVALID;
+  std::map<uint8_t *, std::vector<uint64_t>> addr_var_keys = GetAddrVarKeys();
+  for (uint64_t released_key : released_keys) {
+    auto addr_iter = var_addr_mgr_map_.find(released_key);
+    if (addr_iter == var_addr_mgr_map_.end()) {
+      continue;
+    }
+    auto keys_iter = addr_var_keys.find(addr_iter->second.address);
+    if ((keys_iter == addr_var_keys.end()) || !IsVarMemIdle(keys_iter->second)) {
+      continue;
+    }
+    const std::vector<uint64_t> &var_keys = keys_iter->second;
+    uint64_t mem_key = 0;
+    bool droppable = false;
+    for (uint64_t var_key : var_keys) {
+      if (var_mem_keys_.count(var_key) == 0) {
+        continue;
+      }
+      mem_key = var_key;
+      // a variable keeps its data in the current format, the session may run it in another graph
+      auto cur_iter = cur_var_tensor_desc_map_.find(VarKeyName(var_key));
+      uint64_t cur_key = 0;
+      bool is_cur = (cur_iter != cur_var_tensor_desc_map_.end()) &&
+                    FindVarKey(cur_iter->first, cur_iter->second, cur_key) && (cur_key == var_key);
+      droppable = (const_keys_.count(var_key) > 0) || !is_cur;
+    }
+    if (!droppable) {
+      continue;
+    }
+
+    const VarAddrMgr &mem_addr_mgr = var_addr_mgr_map_[mem_key];
+    free_offsets.emplace_back(mem_addr_mgr.memory_type, mem_addr_mgr.offset);
+    (void)var_offset_set_.erase(reinterpret_cast<uint64_t>(mem_addr_mgr.address));
+    GELOGI("Release var mem of %s at offset %lu, %zu vars on it.", VarKeyName(mem_key).c_str(), mem_addr_mgr.offset,
+           var_keys.size());
+    for (uint64_t var_key : var_keys) {
+      const std::string &name = VarKeyName(var_key);
+      auto cur_iter = cur_var_tensor_desc_map_.find(name);
+      uint64_t cur_key = 0;
+      if ((cur_iter != cur_var_tensor_desc_map_.end()) && FindVarKey(name, cur_iter->second, cur_key) &&
+          (cur_key == var_key)) {
+        cur_var_tensor_desc_map_.erase(cur_iter);
+      }
+      var_addr_mgr_map_.erase(var_key);
+      var_mem_keys_.erase(var_key);
+      const_keys_.erase(var_key);
+    }
+    addr_var_keys.erase(keys_iter);
   }
-  uint64_t free_size = total_size_ - var_mem_size_;
-  if (free_size < (size + kSessionMemAlignSize * 2)) {
-    GELOGE(PARAM_INVALID, "malloc var mem, size[%lu] > free_size[%lu]", size, free_size);
-    return PARAM_INVALID;
+}
+
+void VarResource::GetMovableOffsets(rtMemType_t memory_type,
+                                    const std::function<bool(const std::string &)> &is_var_in_use,
+                                    std::set<uint64_t> &offsets) const {
+  for (const auto &addr_var_keys : GetAddrVarKeys()) {
+    const std::vector<uint64_t> &var_keys = addr_var_keys.second;
+    if (!IsVarMemIdle(var_keys)) {
+      continue;
+    }
+    bool movable = true;
+    const VarAddrMgr *mem_addr_mgr = nullptr;
+    for (uint64_t var_key : var_keys) {
+      const std::string &name = VarKeyName(var_key);
+      if ((const_keys_.count(var_key) > 0) || is_var_in_use(name) || (var_names_to_changed_graph_id_.count(name) > 0)) {
+        movable = false;
+        break;
+      }
+      if (var_mem_keys_.count(var_key) > 0) {
+        mem_addr_mgr = &(var_addr_mgr_map_.at(var_key));
+      }
+    }
+    if (movable && (mem_addr_mgr != nullptr) && (mem_addr_mgr->memory_type == memory_type)) {
+      offsets.insert(mem_addr_mgr->offset);
+    }
   }
+}
 
-  mem_offset = var_mem_size_;
+void VarResource::MoveVarMem(rtMemType_t memory_type, const std::map<uint64_t, uint64_t> &moves) {
+  if (moves.empty()) {
+    return;
+  }
+  uint64_t logic_base = VarManager::Instance(0)->GetVarMemLogicBase();
+  // a var may move to where another one was
+  for (const auto &move : moves) {
+    (void)var_offset_set_.erase(logic_base + move.first);
+  }
+  for (auto &var_addr_mgr : var_addr_mgr_map_) {
+    VarAddrMgr &addr_mgr = var_addr_mgr.second;
+    uint64_t logic_address = reinterpret_cast<uint64_t>(addr_mgr.address);
+    if ((addr_mgr.memory_type != memory_type) || (logic_address < logic_base)) {
+      continue;
+    }
+    auto iter = moves.find(logic_address - logic_base);
+    if (iter == moves.end()) {
+      continue;
+    }
+    addr_mgr.address = reinterpret_cast<uint8_t *>(static_cast<std::uintptr_t>(logic_base + iter->second));
+    if (var_mem_keys_.count(var_addr_mgr.first) > 0) {
+      addr_mgr.offset = iter->second;
+      var_offset_set_.insert(logic_base + iter->second);
+    }
+  }
+}
 
-  // offset for next, align 512 BYTE
-  size = size + kSessionMemAlignSize;
-  var_mem_size_ = var_mem_size_ + size;
+bool VarResource::IsVarMemIdle(const std::vector<uint64_t> &var_keys) const {
+  for (uint64_t var_key : var_keys) {
+    if (var_key_graph_ids_.count(var_key) > 0) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  // align 512 BYTE
-  var_mem_size_ = var_mem_size_ + kSessionMemAlignSize;
+std::map<uint8_t *, std::vector<uint64_t>> VarResource::GetAddrVarKeys() const {
+  std::map<uint8_t *, std::vector<uint64_t>> addr_var_keys;
+  for (const auto &var_addr_mgr : var_addr_mgr_map_) {
+    addr_var_keys[var_addr_mgr.second.address].push_back(var_addr_mgr.first);
+  }
+  return addr_var_keys;
+}
+
+MemResource::MemResource() : total_size_(0), var_mem_base_(nullptr), allocator_(kSessionMemAlignSize) {}
+
+Status MemResource::AssignVarMem(const std::string &var_name, uint64_t size, uint64_t session_id, size_t &mem_offset) {
+  size = (size + kSessionMemAlignSize - 1) / kSessionMemAlignSize * kSessionMemAlignSize;
+
+  total_size_ = VarManager::Instance(0)->GetVarMemMaxSize();
+  // an align after the var and another before the next one, align 512 BYTE
+  uint64_t offset = 0;
+  Status ret = allocator_.Alloc(size + kSessionMemAlignSize * 2, total_size_, offset);
+  if (ret != SUCCESS) {
+    GELOGE(ret, "Assign var mem of %s failed, size %lu, total_size_ %lu.", var_name.c_str(), size, total_size_);
+    return ret;
+  }
+  mem_offset = offset;
   return SUCCESS;
 }
 
-int64_t MemResource::GetVarMemSize() const { return var_mem_size_; }
+Status MemResource::FreeVarMem(uint64_t mem_offset) { return allocator_.Free(mem_offset); }
+
+Status MemResource::CompactVarMem(const std::set<uint64_t> &movable_offsets, const VarMemAllocator::MoveFunc &move) {
+  return allocator_.Compact([&movable_offsets](uint64_t offset) { return movable_offsets.count(offset) > 0; }, move);
+}
+
+int64_t MemResource::GetVarMemSize() const { return static_cast<int64_t>(allocator_.GetTop()); }
+
+VarMemStats MemResource::GetVarMemStats() const { return allocator_.GetStats(); }
 
 VarManager::VarManager(uint64_t session_id)
     : version_(SessionVersion::OTHER_VERSION),
@@ -296,13 +574,15 @@ VarManager::VarManager(uint64_t session_id)
       var_mem_logic_base_(kMemoryVarLogicBase),
       use_max_mem_size_(kUseMaxMemorySize) {}
 
+VarManager::~VarManager() = default;
+
 VarManager *VarManager::Instance(uint64_t session_id) {
   GELOGD("VarManager::Instance, session id = %lu", session_id);
   return VarManagerPool::Instance().GetVarManager(session_id);
 }
 
 void VarManager::Destroy() {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  std::lock_guard<RwLock> lock(mutex_);
   GELOGI("VarManager::Destroy, session id = %lu.", session_id_);
   version_ = SessionVersion::OTHER_VERSION;
   device_id_ = 0;
@@ -314,11 +594,26 @@ void VarManager::Destroy() {
     }
   }
   mem_resource_map_.clear();
+
+  // the lanes hold streams and pinned memory of the device of the session
+  std::lock_guard<std::mutex> transfer_lock(broadcast_transfer_mutex_);
+  broadcast_transfer_.reset();
+}
+
+VarTransfer *VarManager::GetBroadCastTransfer() {
+  std::lock_guard<std::mutex> lock(broadcast_transfer_mutex_);
+  if (broadcast_transfer_ == nullptr) {
+    broadcast_transfer_.reset(new (std::nothrow) VarTransfer());
+    if (broadcast_transfer_ == nullptr) {
+      GELOGE(MEMALLOC_FAILED, "Make broadcast transfer failed, session id = %lu.", session_id_);
+    }
+  }
+  return broadcast_transfer_.get();
 }
 
 ge::Status VarManager::Init(const uint32_t &version, const uint64_t &session_id, const uint32_t &device_id,
                             const uint64_t &job_id) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  std::lock_guard<RwLock> lock(mutex_);
   GELOGI("VarManager::Init, session id = %lu.", session_id);
   version_ = version;
   device_id_ = device_id;
@@ -333,17 +628,17 @@ ge::Status VarManager::Init(const uint32_t &version, const uint64_t &session_id,
 }
 
 const uint64_t &VarManager::SessionId() const {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ReadLockGuard lock(mutex_);
   return session_id_;
 }
 
 const uint32_t &VarManager::DeviceId() const {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ReadLockGuard lock(mutex_);
   return device_id_;
 }
 
 const uint64_t &VarManager::JobId() const {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ReadLockGuard lock(mutex_);
   return job_id_;
 }
 
@@ -353,7 +648,7 @@ ge::Status VarManager::SetVarAddr(const std::string &var_name, const ge::GeTenso
          ge::TypeUtils::DataTypeToSerialString(tensor_desc.GetDataType()).c_str(),
          ge::TypeUtils::FormatToSerialString(tensor_desc.GetFormat()).c_str());
 
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  std::lock_guard<RwLock> lock(mutex_);
   if (var_resource_ == nullptr) {
     GELOGW("VarManager has not been init.");
     return ge::INTERNAL_ERROR;
@@ -364,7 +659,7 @@ ge::Status VarManager::SetVarAddr(const std::string &var_name, const ge::GeTenso
 
 ge::Status VarManager::GetVarAddr(const std::string &var_name, const ge::GeTensorDesc &tensor_desc, uint8_t **dev_ptr,
                                   rtMemType_t &memory_type) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ReadLockGuard lock(mutex_);
   GELOGD("VarManager::GetVarAddr var_name = %s, data_type = %s, data_format = %s", var_name.c_str(),
          ge::TypeUtils::DataTypeToSerialString(tensor_desc.GetDataType()).c_str(),
          ge::TypeUtils::FormatToSerialString(tensor_desc.GetFormat()).c_str());
@@ -382,13 +677,12 @@ ge::Status VarManager::GetVarAddr(const std::string &var_name, const ge::GeTenso
 }
 
 ge::Status VarManager::GetVarAddr(const std::string &var_name, const ge::GeTensorDesc &tensor_desc, uint8_t **dev_ptr) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
   rtMemType_t memory_type = RT_MEMORY_HBM;
   return GetVarAddr(var_name, tensor_desc, dev_ptr, memory_type);
 }
 
 int64_t VarManager::GetVarMemSize(rtMemType_t memory_type) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ReadLockGuard lock(mutex_);
   MemResource *mem_resource = nullptr;
   auto iter = mem_resource_map_.find(memory_type);
   if (iter == mem_resource_map_.end()) {
@@ -406,7 +700,7 @@ int64_t VarManager::GetVarMemSize(rtMemType_t memory_type) {
 
 ge::Status VarManager::AssignVarMem(const std::string &var_name, const ge::GeTensorDesc &tensor_desc,
                                     rtMemType_t memory_type) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  std::lock_guard<RwLock> lock(mutex_);
   GELOGI("VarManager::AssignVarMem var_name = %s, data_type = %s, data_format = %s.", var_name.c_str(),
          ge::TypeUtils::DataTypeToSerialString(tensor_desc.GetDataType()).c_str(),
          ge::TypeUtils::FormatToSerialString(tensor_desc.GetFormat()).c_str());
@@ -451,6 +745,7 @@ ge::Status VarManager::AssignVarMem(const std::string &var_name, const ge::GeTen
       var_name, tensor_desc, reinterpret_cast<uint8_t *>(reinterpret_cast<uintptr_t>(mem_offset)), memory_type);
   if (result != SUCCESS) {
     GELOGE(ge::INTERNAL_ERROR, "AssignVarMem by offset failed.");
+    (void)mem_resource->FreeVarMem(mem_offset);
     return ge::INTERNAL_ERROR;
   }
 
@@ -486,8 +781,96 @@ ge::Status VarManager::AssignVarMem(const std::string &var_name, const ge::GeTen
   return SUCCESS;
 }
 
+ge::Status VarManager::RefVarAddr(const std::string &var_name, const ge::GeTensorDesc &tensor_desc, uint32_t graph_id,
+                                  bool is_const, uint8_t **dev_ptr, rtMemType_t &memory_type) {
+  std::lock_guard<RwLock> lock(mutex_);
+  GELOGD("VarManager::RefVarAddr var_name = %s, graph_id = %u.", var_name.c_str(), graph_id);
+  if (var_resource_ == nullptr) {
+    GELOGW("VarManager has not been init.");
+    return ge::INTERNAL_ERROR;
+  }
+  auto ret = var_resource_->RefVarAddr(var_name, tensor_desc, graph_id, is_const, dev_ptr, memory_type);
+  if (ret != SUCCESS) {
+    GELOGW("RefVarAddr fail.");
+    return ge::INTERNAL_ERROR;
+  }
+  return SUCCESS;
+}
+
+void VarManager::ReleaseGraphVarMem(uint32_t graph_id) {
+  std::lock_guard<RwLock> lock(mutex_);
+  if (var_resource_ == nullptr) {
+    return;
+  }
+  std::vector<std::pair<rtMemType_t, uint64_t>> free_offsets;
+  var_resource_->ReleaseGraph(graph_id, free_offsets);
+  for (const auto &free_offset : free_offsets) {
+    auto iter = mem_resource_map_.find(free_offset.first);
+    if ((iter == mem_resource_map_.end()) || (iter->second == nullptr) ||
+        (iter->second->FreeVarMem(free_offset.second) != SUCCESS)) {
+      GELOGW("Free var mem at offset %lu failed, memory_type = %u.", free_offset.second, free_offset.first);
+    }
+  }
+  GELOGI("Release var mem of graph %u, %zu blocks freed.", graph_id, free_offsets.size());
+}
+
+ge::Status VarManager::CompactVarMem(const std::function<bool(const std::string &)> &is_var_in_use) {
+  std::lock_guard<RwLock> lock(mutex_);
+  if (var_resource_ == nullptr) {
+    return SUCCESS;
+  }
+  string memory_key = std::to_string(session_id_);
+  for (auto &memory_resource : mem_resource_map_) {
+    MemResource *mem_resource = memory_resource.second;
+    if (mem_resource == nullptr) {
+      continue;
+    }
+    VarMemStats stats = mem_resource->GetVarMemStats();
+    if ((stats.free_size == 0) || (stats.free_size * kVarMemCompactRatio < stats.top)) {
+      continue;
+    }
+    std::set<uint64_t> movable_offsets;
+    var_resource_->GetMovableOffsets(memory_resource.first, is_var_in_use, movable_offsets);
+    if (movable_offsets.empty()) {
+      continue;
+    }
+
+    // nothing to copy if the memory has not been malloced yet
+    MemoryAllocator *memory_allocator = MemManager::Instance(memory_resource.first);
+    uint8_t *mem_base = (memory_allocator == nullptr) ? nullptr : memory_allocator->GetMemoryAddr(memory_key);
+    std::map<uint64_t, uint64_t> moves;
+    VarMemStage stage(memory_resource.first);
+    Status ret = mem_resource->CompactVarMem(
+        movable_offsets, [mem_base, &stage, &moves](uint64_t src_offset, uint64_t dst_offset, uint64_t size) {
+          if (mem_base != nullptr) {
+            Status move_ret = MoveVarBlock(mem_base, src_offset, dst_offset, size, stage);
+            if (move_ret != SUCCESS) {
+              return move_ret;
+            }
+          }
+          moves[src_offset] = dst_offset;
+          return SUCCESS;
+        });
+    var_resource_->MoveVarMem(memory_resource.first, moves);
+    GELOGI("Compact var mem of session %lu, memory_type %u, %zu of %zu idle blocks moved, top %lu to %lu.",
+           session_id_, memory_resource.first, moves.size(), movable_offsets.size(), stats.top,
+           mem_resource->GetVarMemSize());
+    GE_CHK_STATUS_RET(ret, "Compact var mem failed, memory_type = %u.", memory_resource.first);
+  }
+  return SUCCESS;
+}
+
+VarMemStats VarManager::GetVarMemStats(rtMemType_t memory_type) {
+  ReadLockGuard lock(mutex_);
+  auto iter = mem_resource_map_.find(memory_type);
+  if ((iter == mem_resource_map_.end()) || (iter->second == nullptr)) {
+    return VarMemStats();
+  }
+  return iter->second->GetVarMemStats();
+}
+
 bool VarManager::IsVarExist(const std::string &var_name, const ge::GeTensorDesc &tensor_desc) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ReadLockGuard lock(mutex_);
   GELOGD("VarManager::IsVarExist var_name = %s, data_type = %s, data_format = %s", var_name.c_str(),
          ge::TypeUtils::FormatToSerialString(tensor_desc.GetFormat()).c_str(),
          ge::TypeUtils::DataTypeToSerialString(tensor_desc.GetDataType()).c_str());
@@ -500,7 +883,7 @@ bool VarManager::IsVarExist(const std::string &var_name, const ge::GeTensorDesc
 }
 
 bool VarManager::IsVarExist(const std::string &var_name) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ReadLockGuard lock(mutex_);
   if (var_resource_ == nullptr) {
     GELOGW("VarManager has not been init.");
     return false;
@@ -510,16 +893,22 @@ bool VarManager::IsVarExist(const std::string &var_name) {
 
 ge::Status VarManager::SyncVarData(uint32_t graph_id, const std::string &var_name, ge::ConstOpDescPtr var_op_desc,
                                    uint8_t *base_ptr) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
-  if (var_resource_ == nullptr) {
-    GELOGW("VarManager has not been init.");
-    return ge::INTERNAL_ERROR;
+  VarBroadCastInfo broad_cast_info;
+  VarResource *var_resource = nullptr;
+  {
+    ReadLockGuard lock(mutex_);
+    if (var_resource_ == nullptr) {
+      GELOGW("VarManager has not been init.");
+      return ge::INTERNAL_ERROR;
+    }
+    var_resource_->GetBroadCastInfo(graph_id, var_name, broad_cast_info);
+    var_resource = var_resource_.get();
   }
-  return var_resource_->SyncVarData(graph_id, var_name, std::move(var_op_desc), base_ptr);
+  return var_resource->SyncVarData(broad_cast_info, var_name, std::move(var_op_desc), base_ptr);
 }
 
 ge::Status VarManager::GetCurVarDesc(const std::string &var_name, ge::GeTensorDesc &tensor_desc) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ReadLockGuard lock(mutex_);
   GELOGI("VarManager::GetCurVarDesc var_name = %s.", var_name.c_str());
 
   if (var_resource_ == nullptr) {
@@ -530,7 +919,7 @@ ge::Status VarManager::GetCurVarDesc(const std::string &var_name, ge::GeTensorDe
 }
 
 ge::Status VarManager::SaveBroadCastInfo(uint32_t graph_id, const VarBroadCastInfo &broad_cast_info) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  std::lock_guard<RwLock> lock(mutex_);
   GELOGI(
       "VarManager::SaveBroadCastInfo var_name = %s, broadcast name = %s, "
       "idx = %d, input_offset = %ld, input_size = %lu, output_offset = %ld, "
@@ -547,7 +936,7 @@ ge::Status VarManager::SaveBroadCastInfo(uint32_t graph_id, const VarBroadCastIn
 }
 
 ge::Status VarManager::RenewCurVarDesc(const std::string &var_name, ge::OpDescPtr op_desc) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  std::lock_guard<RwLock> lock(mutex_);
   GELOGD("VarManager::RenewCurVarDesc var_name = %s.", var_name.c_str());
 
   if (var_resource_ == nullptr) {
@@ -559,16 +948,22 @@ ge::Status VarManager::RenewCurVarDesc(const std::string &var_name, ge::OpDescPt
 
 ge::Status VarManager::SyncBroadCastData2Var(uint32_t graph_id, const std::string &var_name,
                                              ge::ConstOpDescPtr var_op_desc, uint8_t *base_ptr) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
-  if (var_resource_ == nullptr) {
-    GELOGW("VarManager has not been init.");
-    return ge::INTERNAL_ERROR;
+  VarBroadCastInfo broad_cast_info;
+  VarResource *var_resource = nullptr;
+  {
+    ReadLockGuard lock(mutex_);
+    if (var_resource_ == nullptr) {
+      GELOGW("VarManager has not been init.");
+      return ge::INTERNAL_ERROR;
+    }
+    var_resource_->GetBroadCastInfo(graph_id, var_name, broad_cast_info);
+    var_resource = var_resource_.get();
   }
-  return var_resource_->SyncBroadCastData2Var(graph_id, var_name, std::move(var_op_desc), base_ptr);
+  return var_resource->SyncBroadCastData2Var(broad_cast_info, var_name, std::move(var_op_desc), base_ptr);
 }
 
 bool VarManager::IsVarAddr(const int64_t &offset) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ReadLockGuard lock(mutex_);
   if (var_resource_ == nullptr) {
     GELOGW("VarManager has not been init.");
     return false;
@@ -577,7 +972,7 @@ bool VarManager::IsVarAddr(const int64_t &offset) {
 }
 
 ge::Status VarManager::MallocVarMemory(size_t memory_size) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  std::lock_guard<RwLock> lock(mutex_);
   uint8_t *var_mem_base = nullptr;
   string memory_key = std::to_string(session_id_);
 
@@ -599,13 +994,13 @@ ge::Status VarManager::MallocVarMemory(size_t memory_size) {
 }
 
 uint8_t *VarManager::GetVarMemoryBase(rtMemType_t memory_type) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ReadLockGuard lock(mutex_);
   string memory_key = std::to_string(session_id_);
   return MemManager::Instance(memory_type)->GetMemoryAddr(memory_key);
 }
 
 uint8_t *VarManager::GetVarMemoryAddr(uint8_t *logic_addr, rtMemType_t memory_type) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ReadLockGuard lock(mutex_);
   string mem_key = std::to_string(session_id_);
   uint8_t *mem_base = MemManager::Instance(memory_type)->GetMemoryAddr(mem_key);
   if (mem_base == nullptr) {
@@ -616,13 +1011,13 @@ uint8_t *VarManager::GetVarMemoryAddr(uint8_t *logic_addr, rtMemType_t memory_ty
 }
 
 ge::Status VarManager::FreeVarMemory() {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
-  string memory_key = std::to_string(SessionId());
+  std::lock_guard<RwLock> lock(mutex_);
+  string memory_key = std::to_string(session_id_);
   return MemManager::Instance(RT_MEMORY_HBM)->FreeMemory(memory_key);
 }
 
 ge::Status VarManager::SetTransRoad(const std::string &var_name, const VarTransRoad &trans_road) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  std::lock_guard<RwLock> lock(mutex_);
   if (var_resource_ == nullptr) {
     GELOGW("VarManager has not been init.");
     return ge::INTERNAL_ERROR;
@@ -631,7 +1026,7 @@ ge::Status VarManager::SetTransRoad(const std::string &var_name, const VarTransR
 }
 
 VarTransRoad *VarManager::GetTransRoad(const std::string &var_name) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ReadLockGuard lock(mutex_);
   if (var_resource_ == nullptr) {
     GELOGW("VarManager has not been init.");
     return nullptr;
@@ -640,7 +1035,7 @@ VarTransRoad *VarManager::GetTransRoad(const std::string &var_name) {
 }
 
 Status VarManager::SetChangedGraphId(const std::string &var_name, uint32_t graph_id) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  std::lock_guard<RwLock> lock(mutex_);
   if (var_resource_ == nullptr) {
     GELOGW("VarManager has not been init.");
     return INTERNAL_ERROR;
@@ -649,7 +1044,7 @@ Status VarManager::SetChangedGraphId(const std::string &var_name, uint32_t graph
 }
 
 Status VarManager::GetChangedGraphId(const std::string &var_name, uint32_t &graph_id) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ReadLockGuard lock(mutex_);
   if (var_resource_ == nullptr) {
     GELOGW("VarManager has not been init.");
     return INTERNAL_ERROR;
@@ -745,7 +1140,7 @@ Status VarManager::ParseMemoryMallocSize(string &memory_size, size_t &result) {
 }
 
 void VarManager::RemoveChangedGraphId(const std::string &var_name) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  std::lock_guard<RwLock> lock(mutex_);
   if (var_resource_ == nullptr) {
     GELOGW("VarManager has not been init.");
     return;
@@ -754,7 +1149,7 @@ void VarManager::RemoveChangedGraphId(const std::string &var_name) {
 }
 
 Status VarManager::SetAllocatedGraphId(const std::string &var_name, uint32_t graph_id) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  std::lock_guard<RwLock> lock(mutex_);
   if (var_resource_ == nullptr) {
     GELOGW("VarManager has not been init.");
     return INTERNAL_ERROR;
@@ -763,7 +1158,7 @@ Status VarManager::SetAllocatedGraphId(const std::string &var_name, uint32_t gra
 }
 
 Status VarManager::GetAllocatedGraphId(const std::string &var_name, uint32_t &graph_id) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ReadLockGuard lock(mutex_);
   if (var_resource_ == nullptr) {
     GELOGW("VarManager has not been init.");
     return INTERNAL_ERROR;
@@ -772,7 +1167,7 @@ Status VarManager::GetAllocatedGraphId(const std::string &var_name, uint32_t &gr
 }
 
 void VarManager::RemoveAllocatedGraphId(const std::string &var_name) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  std::lock_guard<RwLock> lock(mutex_);
   if (var_resource_ == nullptr) {
     GELOGW("VarManager has not been init.");
     return;
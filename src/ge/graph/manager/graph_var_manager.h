@@ -18,17 +18,22 @@
 #define GE_GRAPH_MANAGER_GRAPH_VAR_MANAGER_H_
 
 #include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "common/rw_lock.h"
 #include "framework/common/ge_inner_error_codes.h"
 #include "framework/common/ge_types.h"
 #include "framework/common/l2_cache_optimize.h"
 #include "graph/ge_tensor.h"
+#include "graph/manager/var_mem_allocator.h"
 #include "graph/op_desc.h"
 #include "graph/tensor.h"
 #include "runtime/mem.h"
@@ -42,6 +47,8 @@ const size_t kGraphMemoryBuffer = 4UL * 1024UL * 1024UL * 1024UL;
 const size_t kMaxMemorySize = 256UL * 1024UL * 1024UL * 1024UL;
 const char kEnvGeuseStaticMemory[] = "GE_USE_STATIC_MEMORY";
 const uint64_t kSessionMemAlignSize = 512;
+// holes of the variable memory are packed when they take this part of it
+const uint64_t kVarMemCompactRatio = 4;
 
 enum MemStatus {
   NORMAL = 0,
@@ -93,6 +100,8 @@ struct TransNodeInfo {
 
 using VarTransRoad = std::vector<TransNodeInfo>;
 
+class VarTransfer;
+
 class VarResource {
  public:
   explicit VarResource(uint64_t session_id_);
@@ -113,14 +122,18 @@ class VarResource {
 
   void SaveBroadCastInfo(uint32_t graph_id, const VarBroadCastInfo &broad_cast_info);
 
-  ge::Status SyncVarData2BroadCast(uint32_t graph_id, const std::string &var_name,
+  // the info saved for the graph, zeros if there is none
+  void GetBroadCastInfo(uint32_t graph_id, const std::string &var_name, VarBroadCastInfo &broad_cast_info) const;
+
+  // the syncs look up the var addrs through the VarManager, they must run out of its lock
+  ge::Status SyncVarData2BroadCast(const VarBroadCastInfo &broad_cast_info, const std::string &var_name,
                                    const ge::ConstOpDescPtr &var_op_desc, uint8_t *base_ptr);
 
-  ge::Status SyncBroadCastData2Var(uint32_t graph_id, const std::string &var_name,
+  ge::Status SyncBroadCastData2Var(const VarBroadCastInfo &broad_cast_info, const std::string &var_name,
                                    const ge::ConstOpDescPtr &var_op_desc, uint8_t *base_ptr);
 
-  ge::Status SyncVarData(uint32_t graph_id, const std::string &var_name, const ge::ConstOpDescPtr &var_op_desc,
-                         uint8_t *base_ptr);
+  ge::Status SyncVarData(const VarBroadCastInfo &broad_cast_info, const std::string &var_name,
+                         const ge::ConstOpDescPtr &var_op_desc, uint8_t *base_ptr);
 
   Status SetTransRoad(const std::string &var_name, const VarTransRoad &trans_road) {
     if (var_to_trans_road_.find(var_name) != var_to_trans_road_.end()) {
@@ -153,12 +166,58 @@ class VarResource {
 
   bool IsVarAddr(const int64_t &offset);
 
+  ///
+  /// @ingroup ge_graph
+  /// @brief get the addr of a var for a graph, the memory is neither freed nor moved until the graph is released
+  /// @param [in] is_const whether the var is a constant, whose memory is freed when no graph uses it
+  ///
+  ge::Status RefVarAddr(const std::string &var_name, const ge::GeTensorDesc &tensor_desc, uint32_t graph_id,
+                        bool is_const, uint8_t **dev_ptr, rtMemType_t &memory_type);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief drop the refs of a graph, the memory no graph uses any more is dropped if it is of a constant or of a
+  ///        variable in a replaced format
+  /// @param [out] free_offsets offsets of the memory dropped by memory type
+  ///
+  void ReleaseGraph(uint32_t graph_id, std::vector<std::pair<rtMemType_t, uint64_t>> &free_offsets);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief offsets of the memory of the variables no graph uses, they may move
+  /// @param [in] is_var_in_use whether a var is in a graph of the session, built or not
+  ///
+  void GetMovableOffsets(rtMemType_t memory_type, const std::function<bool(const std::string &)> &is_var_in_use,
+                         std::set<uint64_t> &offsets) const;
+
+  // points the vars at the memory moved, by the old offset
+  void MoveVarMem(rtMemType_t memory_type, const std::map<uint64_t, uint64_t> &moves);
+
  private:
-  std::string VarKey(const std::string &var_name, const ge::GeTensorDesc &tensor_desc);
+  // the key of a var in a format, the name is interned
+  uint64_t VarKey(const std::string &var_name, const ge::GeTensorDesc &tensor_desc);
+
+  // the key if the name was interned, it does not change anything so the readers may look up
+  bool FindVarKey(const std::string &var_name, const ge::GeTensorDesc &tensor_desc, uint64_t &var_key) const;
+
+  const std::string &VarKeyName(uint64_t var_key) const;
+
+  // whether the memory at an addr may be dropped or moved, none of the vars on it is used
+  bool IsVarMemIdle(const std::vector<uint64_t> &var_keys) const;
+
+  // keys of the vars by their addr, the vars sharing memory have the same addr
+  std::map<uint8_t *, std::vector<uint64_t>> GetAddrVarKeys() const;
 
   uint64_t session_id_;
   std::unordered_set<uint64_t> var_offset_set_;
-  std::unordered_map<std::string, VarAddrMgr> var_addr_mgr_map_;
+  std::unordered_map<std::string, uint32_t> var_ids_;
+  std::vector<std::string> var_names_;
+  std::unordered_map<uint64_t, VarAddrMgr> var_addr_mgr_map_;
+  // keys whose memory was assigned to them, the other keys share it
+  std::unordered_set<uint64_t> var_mem_keys_;
+  std::unordered_set<uint64_t> const_keys_;
+  std::unordered_map<uint64_t, std::unordered_set<uint32_t>> var_key_graph_ids_;
+  std::unordered_map<uint32_t, std::unordered_set<uint64_t>> graph_id_var_keys_;
   std::unordered_map<std::string, ge::GeTensorDesc> cur_var_tensor_desc_map_;
   std::unordered_map<std::string, std::vector<TransNodeInfo>> var_to_trans_road_;
   std::unordered_map<std::string, uint32_t> var_names_to_changed_graph_id_;
@@ -173,19 +232,26 @@ class MemResource {
 
   Status AssignVarMem(const std::string &var_name, uint64_t size, uint64_t session_id, size_t &mem_offset);
 
+  Status FreeVarMem(uint64_t mem_offset);
+
+  Status CompactVarMem(const std::set<uint64_t> &movable_offsets, const VarMemAllocator::MoveFunc &move);
+
+  // end of the highest var
   int64_t GetVarMemSize() const;
 
+  VarMemStats GetVarMemStats() const;
+
  private:
   uint64_t total_size_;
   uint8_t *var_mem_base_;
-  uint64_t var_mem_size_;
+  VarMemAllocator allocator_;
 };
 
 class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY VarManager {
  public:
   static VarManager *Instance(uint64_t session_id);
   explicit VarManager(uint64_t session_id);
-  ~VarManager() = default;
+  ~VarManager();
 
   ge::Status Init(const uint32_t &version, const uint64_t &session_id, const uint32_t &device_id,
                   const uint64_t &job_id);
@@ -202,6 +268,39 @@ class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY VarManager {
 
   ge::Status GetVarAddr(const std::string &var_name, const ge::GeTensorDesc &tensor_desc, uint8_t **dev_ptr);
 
+  ///
+  /// @ingroup ge_graph
+  /// @brief get the addr of a variable or a constant for the graph being built, which keeps its memory until the
+  ///        graph is released
+  /// @param [in] var_name name of the var
+  /// @param [in] tensor_desc format of the var
+  /// @param [in] graph_id graph the addr is built into
+  /// @param [in] is_const whether the var is a constant, whose memory is freed when no graph uses it
+  /// @param [out] dev_ptr logic addr of the var
+  /// @param [out] memory_type memory type of the var
+  /// @return Status result of function
+  ///
+  ge::Status RefVarAddr(const std::string &var_name, const ge::GeTensorDesc &tensor_desc, uint32_t graph_id,
+                        bool is_const, uint8_t **dev_ptr, rtMemType_t &memory_type);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief free the memory of the constants no graph uses after the graph removed, and of the variables in the
+  ///        formats they were replaced by
+  /// @param [in] graph_id graph removed, its models must be unloaded
+  ///
+  void ReleaseGraphVarMem(uint32_t graph_id);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief slide the variables no graph uses down over the holes once they take enough of the var memory
+  /// @param [in] is_var_in_use whether a var is in a graph of the session, built or not
+  /// @return Status result of function
+  ///
+  ge::Status CompactVarMem(const std::function<bool(const std::string &)> &is_var_in_use);
+
+  VarMemStats GetVarMemStats(rtMemType_t memory_type);
+
   ge::Status SyncVarData(uint32_t graph_id, const std::string &var_name, ge::ConstOpDescPtr var_op_desc,
                          uint8_t *base_ptr);
 
@@ -262,6 +361,13 @@ class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY VarManager {
 
   uint8_t *GetVarMemoryAddr(uint8_t *logic_addr, rtMemType_t memory_type);
 
+  ///
+  /// @ingroup ge_graph
+  /// @brief the transfer shared by the broadcast syncs of the session, created on the first use
+  /// @return VarTransfer * nullptr if it can not be created
+  ///
+  VarTransfer *GetBroadCastTransfer();
+
  private:
   uint32_t version_;
   uint64_t session_id_;
@@ -273,7 +379,11 @@ class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY VarManager {
   size_t use_max_mem_size_;
   std::unique_ptr<ge::VarResource> var_resource_;
   map<rtMemType_t, MemResource *> mem_resource_map_;
-  mutable std::recursive_mutex mutex_;
+  // the lookups of the loads and runs share it, it is not recursive
+  mutable RwLock mutex_;
+  // the syncs transfer out of mutex_, as they look up the var addrs
+  std::mutex broadcast_transfer_mutex_;
+  std::unique_ptr<VarTransfer> broadcast_transfer_;
 
   Status ParseMemoryMallocSize(std::string &memory_size, size_t &my_size);
 };
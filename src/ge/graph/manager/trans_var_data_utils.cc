@@ -16,76 +16,469 @@
 
 #include "graph/manager/trans_var_data_utils.h"
 
+#include <algorithm>
+
 #include "common/debug/log.h"
 #include "common/debug/memory_dumper.h"
 #include "common/formats/formats.h"
 #include "common/formats/utils/formats_trans_utils.h"
 #include "common/op/ge_op_utils.h"
+#include "common/tracer.h"
 #include "framework/common/debug/ge_log.h"
-#include "graph/manager/graph_var_manager.h"
+#include "framework/common/types.h"
 #include "graph/types.h"
 #include "graph/utils/type_utils.h"
+#include "securec.h"
 
 namespace ge {
+namespace {
+// buffers of a lane in each direction, the copies of one run while the other is converted
+const size_t kLaneBufferNum = 2;
+
+bool IsSkippedTrans(const TransNodeInfo &trans_info) {
+  return (trans_info.node_type == RESHAPE) || (trans_info.node_type == REFORMAT);
+}
+
+// the element sizes of the input, the output and the largest one of a road of casts, false for other roads
+bool GetCastRoadElemSizes(const VarTransRoad &trans_road, size_t &in_size, size_t &out_size, size_t &max_size) {
+  bool first = true;
+  for (const auto &trans_info : trans_road) {
+    if (IsSkippedTrans(trans_info)) {
+      continue;
+    }
+    if (trans_info.node_type != CAST) {
+      return false;
+    }
+    int src_size = GetSizeByDataType(trans_info.input.GetDataType());
+    int dst_size = GetSizeByDataType(trans_info.output.GetDataType());
+    if ((src_size <= 0) || (dst_size <= 0)) {
+      return false;
+    }
+    if (first) {
+      in_size = static_cast<size_t>(src_size);
+      max_size = in_size;
+      first = false;
+    }
+    out_size = static_cast<size_t>(dst_size);
+    max_size = std::max(max_size, out_size);
+  }
+  if (first) {
+    // copied as it is
+    in_size = 1;
+    out_size = 1;
+    max_size = 1;
+  }
+  return true;
+}
+
+bool IsOverlapped(const uint8_t *src, size_t src_size, const uint8_t *dst, size_t dst_size) {
+  return (src < dst + dst_size) && (dst < src + src_size);
+}
+}  // namespace
+
+const size_t VarTransfer::kDefaultLaneNum;
+const size_t VarTransfer::kDefaultChunkSize;
+
+VarTransfer::VarTransfer(size_t lane_num, size_t chunk_size)
+    : lane_num_(std::max<size_t>(lane_num, 1)),
+      chunk_size_(std::max<size_t>(chunk_size, 1)),
+      copy_func_(rtMemcpyAsync) {}
+
+VarTransfer::~VarTransfer() {
+  for (auto &lane : lanes_) {
+    DestroyLane(*lane);
+  }
+}
+
+Status VarTransfer::Transfer(const std::string &var_name, const uint8_t *src, size_t src_size,
+                             const VarTransRoad &trans_road, uint8_t *dst, size_t dst_size, VarTransferCost &cost) {
+  GE_CHECK_NOTNULL(src);
+  GE_CHECK_NOTNULL(dst);
+  GE_TRACE_SCOPE("VarTransfer::Transfer");
+  uint64_t start = GetCurrentTimestap();
+  cost = {0, 0, 0, 0};
+  Lane *lane = nullptr;
+  GE_CHK_STATUS_RET(AcquireLane(lane), "Acquire transfer lane failed, var:%s.", var_name.c_str());
+
+  size_t in_size = 0;
+  size_t out_size = 0;
+  size_t max_size = 0;
+  bool by_chunk = GetCastRoadElemSizes(trans_road, in_size, out_size, max_size);
+  // a chunk written back must not overwrite the chunks not read yet
+  if (by_chunk && IsOverlapped(src, src_size, dst, dst_size) && ((src != dst) || (out_size > in_size))) {
+    by_chunk = false;
+  }
+  Status ret = by_chunk ? TransferByChunk(*lane, src, src_size, trans_road, dst, dst_size, cost)
+                        : TransferWhole(*lane, src, src_size, trans_road, dst, dst_size, cost);
+  if (ret != SUCCESS) {
+    // the buffers may still be in use by the copies queued
+    GE_CHK_RT(rtStreamSynchronize(lane->d2h_stream));
+    GE_CHK_RT(rtStreamSynchronize(lane->h2d_stream));
+    for (auto &buffer : lane->write_buffers) {
+      buffer.busy = false;
+    }
+  }
+  ReleaseLane(lane);
+  if (ret != SUCCESS) {
+    GELOGE(ret, "Transfer var %s failed, size %zu.", var_name.c_str(), src_size);
+    return ret;
+  }
+
+  cost.total_us = GetCurrentTimestap() - start;
+  GELOGI("Transfer var %s, size %zu, %s, chunks %zu, cost %lu us, wait copies %lu us, trans on host %lu us.",
+         var_name.c_str(), src_size, by_chunk ? "by chunk" : "whole", cost.chunk_num, cost.total_us, cost.wait_us,
+         cost.trans_us);
+  return SUCCESS;
+}
+
+Status VarTransfer::AcquireLane(Lane *&lane) {
+  std::unique_lock<std::mutex> lock(lane_mutex_);
+  if (free_lanes_.empty() && (lanes_.size() < lane_num_)) {
+    std::unique_ptr<Lane> new_lane(new (std::nothrow) Lane());
+    if (new_lane == nullptr) {
+      GELOGE(MEMALLOC_FAILED, "Make lane failed.");
+      return MEMALLOC_FAILED;
+    }
+    Status ret = InitLane(*new_lane);
+    if (ret != SUCCESS) {
+      DestroyLane(*new_lane);
+      return ret;
+    }
+    lanes_.emplace_back(std::move(new_lane));
+    lane = lanes_.back().get();
+    return SUCCESS;
+  }
+  lane_cond_.wait(lock, [this] { return !free_lanes_.empty(); });
+  lane = free_lanes_.back();
+  free_lanes_.pop_back();
+  return SUCCESS;
+}
+
+void VarTransfer::ReleaseLane(Lane *lane) {
+  {
+    std::lock_guard<std::mutex> lock(lane_mutex_);
+    free_lanes_.push_back(lane);
+  }
+  lane_cond_.notify_one();
+}
+
+Status VarTransfer::InitLane(Lane &lane) {
+  GE_CHK_RT_RET(rtStreamCreate(&lane.d2h_stream, 0));
+  GE_CHK_RT_RET(rtStreamCreate(&lane.h2d_stream, 0));
+  for (auto buffers : {&lane.read_buffers, &lane.write_buffers}) {
+    buffers->resize(kLaneBufferNum);
+    for (auto &buffer : *buffers) {
+      GE_CHK_RT_RET(rtMallocHost(reinterpret_cast<void **>(&buffer.data), chunk_size_));
+      GE_CHK_RT_RET(rtEventCreate(&buffer.event));
+    }
+  }
+  return SUCCESS;
+}
+
+void VarTransfer::DestroyLane(Lane &lane) {
+  for (auto buffers : {&lane.read_buffers, &lane.write_buffers}) {
+    for (auto &buffer : *buffers) {
+      if (buffer.data != nullptr) {
+        GE_CHK_RT(rtFreeHost(buffer.data));
+        buffer.data = nullptr;
+      }
+      if (buffer.event != nullptr) {
+        GE_CHK_RT(rtEventDestroy(buffer.event));
+        buffer.event = nullptr;
+      }
+    }
+  }
+  for (auto stream : {&lane.d2h_stream, &lane.h2d_stream}) {
+    if (*stream != nullptr) {
+      GE_CHK_RT(rtStreamDestroy(*stream));
+      *stream = nullptr;
+    }
+  }
+}
+
+Status VarTransfer::TransferByChunk(Lane &lane, const uint8_t *src, size_t src_size, const VarTransRoad &trans_road,
+                                    uint8_t *dst, size_t dst_size, VarTransferCost &cost) {
+  size_t in_size = 0;
+  size_t out_size = 0;
+  size_t max_size = 0;
+  (void)GetCastRoadElemSizes(trans_road, in_size, out_size, max_size);
+  size_t elem_num = src_size / in_size;
+  if ((elem_num * in_size != src_size) || (elem_num * out_size > dst_size)) {
+    GELOGE(PARAM_INVALID, "Size %zu of %zu bytes elements can not cast into %zu bytes.", src_size, in_size, dst_size);
+    return PARAM_INVALID;
+  }
+  // every element of a chunk fits the buffers in the largest type of the road
+  size_t chunk_elem_num = std::max<size_t>(chunk_size_ / max_size, 1);
+  if (chunk_elem_num * max_size > chunk_size_) {
+    GELOGE(PARAM_INVALID, "Chunk size %zu can not hold an element of %zu bytes.", chunk_size_, max_size);
+    return PARAM_INVALID;
+  }
+
+  auto cast_chunk = [this, &lane, &trans_road, dst, in_size, out_size, &cost](const uint8_t *data, size_t offset,
+                                                                            size_t len) -> Status {
+    uint64_t start = GetCurrentTimestap();
+    formats::TransResult result{};
+    Status ret = TransVarDataUtils::CastVarOnHost(data, len / in_size, trans_road, result);
+    cost.trans_us += GetCurrentTimestap() - start;
+    if (ret != SUCCESS) {
+      return ret;
+    }
+    return WriteChunk(lane, dst + offset / in_size * out_size, result.data.get(), result.length, cost);
+  };
+  GE_CHK_STATUS_RET(ReadChunks(lane, src, src_size, chunk_elem_num * in_size, cast_chunk, cost));
+  return SyncWrites(lane, cost);
+}
+
+Status VarTransfer::TransferWhole(Lane &lane, const uint8_t *src, size_t src_size, const VarTransRoad &trans_road,
+                                  uint8_t *dst, size_t dst_size, VarTransferCost &cost) {
+  std::unique_ptr<uint8_t[]> var_host(new (std::nothrow) uint8_t[src_size]);
+  if (var_host == nullptr) {
+    GELOGE(MEMALLOC_FAILED, "Malloc %zu bytes on host failed.", src_size);
+    return MEMALLOC_FAILED;
+  }
+  uint8_t *host = var_host.get();
+  auto gather_chunk = [host, src_size](const uint8_t *data, size_t offset, size_t len) -> Status {
+    if (memcpy_s(host + offset, src_size - offset, data, len) != EOK) {
+      GELOGE(INTERNAL_ERROR, "Gather %zu bytes at %zu failed.", len, offset);
+      return INTERNAL_ERROR;
+    }
+    return SUCCESS;
+  };
+  GE_CHK_STATUS_RET(ReadChunks(lane, src, src_size, chunk_size_, gather_chunk, cost));
+
+  formats::TransResult result{};
+  size_t in_size = 0;
+  size_t out_size = 0;
+  size_t max_size = 0;
+  uint64_t start = GetCurrentTimestap();
+  Status ret = GetCastRoadElemSizes(trans_road, in_size, out_size, max_size)
+                   ? TransVarDataUtils::CastVarOnHost(host, src_size / in_size, trans_road, result)
+                   : TransVarDataUtils::TransVarOnHost(host, trans_road, result);
+  cost.trans_us += GetCurrentTimestap() - start;
+  if (ret != SUCCESS) {
+    GELOGE(ret, "Failed to trans var data on host, error code %u", ret);
+    return ret;
+  }
+  if (result.length > dst_size) {
+    GELOGE(PARAM_INVALID, "The var of %zu bytes on host can not be written to %zu bytes.", result.length, dst_size);
+    return PARAM_INVALID;
+  }
+  for (size_t offset = 0; offset < result.length; offset += chunk_size_) {
+    GE_CHK_STATUS_RET(WriteChunk(lane, dst + offset, result.data.get() + offset,
+                                 std::min(chunk_size_, result.length - offset), cost));
+  }
+  return SyncWrites(lane, cost);
+}
+
+Status VarTransfer::ReadChunks(Lane &lane, const uint8_t *src, size_t size, size_t chunk_size, const ChunkFunc &func,
+                               VarTransferCost &cost) {
+  size_t chunk_num = (size + chunk_size - 1) / chunk_size;
+  auto issue = [this, &lane, src, size, chunk_size](size_t index) -> Status {
+    Buffer &buffer = lane.read_buffers[index % lane.read_buffers.size()];
+    size_t offset = index * chunk_size;
+    size_t len = std::min(chunk_size, size - offset);
+    GE_CHK_RT_RET(copy_func_(buffer.data, chunk_size_, src + offset, len, RT_MEMCPY_DEVICE_TO_HOST, lane.d2h_stream));
+    GE_CHK_RT_RET(rtEventRecord(buffer.event, lane.d2h_stream));
+    return SUCCESS;
+  };
+
+  for (size_t i = 0; (i < chunk_num) && (i < lane.read_buffers.size()); ++i) {
+    GE_CHK_STATUS_RET(issue(i));
+  }
+  for (size_t i = 0; i < chunk_num; ++i) {
+    Buffer &buffer = lane.read_buffers[i % lane.read_buffers.size()];
+    GE_CHK_STATUS_RET(WaitBuffer(buffer, cost));
+    size_t offset = i * chunk_size;
+    GE_CHK_STATUS_RET(func(buffer.data, offset, std::min(chunk_size, size - offset)));
+    if (i + lane.read_buffers.size() < chunk_num) {
+      GE_CHK_STATUS_RET(issue(i + lane.read_buffers.size()));
+    }
+  }
+  cost.chunk_num += chunk_num;
+  return SUCCESS;
+}
+
+Status VarTransfer::WriteChunk(Lane &lane, uint8_t *dst, const uint8_t *data, size_t len, VarTransferCost &cost) {
+  Buffer &buffer = lane.write_buffers[lane.write_num % lane.write_buffers.size()];
+  if (buffer.busy) {
+    GE_CHK_STATUS_RET(WaitBuffer(buffer, cost));
+    buffer.busy = false;
+  }
+  if (memcpy_s(buffer.data, chunk_size_, data, len) != EOK) {
+    GELOGE(INTERNAL_ERROR, "Copy %zu bytes to the pinned buffer of %zu bytes failed.", len, chunk_size_);
+    return INTERNAL_ERROR;
+  }
+  GE_CHK_RT_RET(copy_func_(dst, len, buffer.data, len, RT_MEMCPY_HOST_TO_DEVICE, lane.h2d_stream));
+  GE_CHK_RT_RET(rtEventRecord(buffer.event, lane.h2d_stream));
+  buffer.busy = true;
+  ++lane.write_num;
+  return SUCCESS;
+}
+
+Status VarTransfer::WaitBuffer(Buffer &buffer, VarTransferCost &cost) {
+  uint64_t start = GetCurrentTimestap();
+  GE_CHK_RT_RET(rtEventSynchronize(buffer.event));
+  cost.wait_us += GetCurrentTimestap() - start;
+  return SUCCESS;
+}
+
+Status VarTransfer::SyncWrites(Lane &lane, VarTransferCost &cost) {
+  for (auto &buffer : lane.write_buffers) {
+    if (buffer.busy) {
+      GE_CHK_STATUS_RET(WaitBuffer(buffer, cost));
+      buffer.busy = false;
+    }
+  }
+  return SUCCESS;
+}
+
 Status TransVarDataUtils::SyncVarData2BroadCast(const string &var_name, const ge::GeTensorDesc &src_tensor_desc,
                                                 uint8_t *dst_addr, uint32_t dst_addr_size, uint64_t session_id) {
   GE_CHK_BOOL_RET_STATUS(dst_addr != nullptr, FAILED, "dst addr is null. ");
-  uint8_t *src_host_addr = nullptr;
   uint32_t src_addr_size = 0;
-  GE_MAKE_GUARD_RTMEM(src_host_addr);
-  GE_CHK_STATUS_RET(SyncTensorToHost(var_name, src_tensor_desc, &src_host_addr, src_addr_size, session_id));
-
+  GE_CHK_STATUS_RET(ge::TensorUtils::GetSize(src_tensor_desc, src_addr_size), "get size from TensorDesc failed");
   GELOGI("src_addr_size: %u, dst_addr_size: %u", src_addr_size, dst_addr_size);
   GE_CHK_BOOL_RET_STATUS(src_addr_size == dst_addr_size, FAILED, "var data size is not equal broadcast ");
 
-  GE_CHK_RT_RET(rtMemcpy(dst_addr, dst_addr_size, src_host_addr, src_addr_size, RT_MEMCPY_HOST_TO_DEVICE));
-  return SUCCESS;
+  uint8_t *src_addr = nullptr;
+  GE_CHK_STATUS_RET(GetVarDeviceAddr(var_name, src_tensor_desc, session_id, &src_addr));
+  VarTransfer *transfer = nullptr;
+  GE_CHK_STATUS_RET(GetBroadCastTransfer(session_id, transfer));
+  VarTransferCost cost;
+  return transfer->Transfer(var_name, src_addr, src_addr_size, VarTransRoad(), dst_addr, dst_addr_size, cost);
 }
 
 Status TransVarDataUtils::SyncBroadCastData2Var(uint8_t *src_addr, uint32_t src_addr_size, const string &var_name,
                                                 const ge::GeTensorDesc &dst_tensor_desc, uint64_t session_id) {
   GE_CHK_BOOL_RET_STATUS(src_addr != nullptr, FAILED, "src addr is null. ");
-  uint8_t *host_addr = nullptr;
-  GE_MAKE_GUARD_RTMEM(host_addr);
-  GE_CHK_RT_RET(rtMallocHost(reinterpret_cast<void **>(&host_addr), src_addr_size));
-  GE_CHK_RT_RET(rtMemcpy(host_addr, src_addr_size, src_addr, src_addr_size, RT_MEMCPY_DEVICE_TO_HOST));
-
-  GE_CHK_STATUS_RET(
-      SyncTensorToDevice(var_name, reinterpret_cast<uint8_t *>(host_addr), src_addr_size, dst_tensor_desc, session_id));
-
-  return SUCCESS;
+  uint8_t *dst_addr = nullptr;
+  GE_CHK_STATUS_RET(GetVarDeviceAddr(var_name, dst_tensor_desc, session_id, &dst_addr));
+  VarTransfer *transfer = nullptr;
+  GE_CHK_STATUS_RET(GetBroadCastTransfer(session_id, transfer));
+  VarTransferCost cost;
+  return transfer->Transfer(var_name, src_addr, src_addr_size, VarTransRoad(), dst_addr, src_addr_size, cost);
 }
 
-Status TransVarDataUtils::SyncTensorToHost(const string &var_name, const ge::GeTensorDesc &src_tensor_desc,
-                                           uint8_t **host_addr, uint32_t &src_tensor_size, uint64_t session_id) {
-  GE_CHK_STATUS_RET(ge::TensorUtils::GetSize(src_tensor_desc, src_tensor_size), "get size from TensorDesc failed");
+Status TransVarDataUtils::TransVarOnHost(uint8_t *var_data, const VarTransRoad &trans_road,
+                                         formats::TransResult &result) {
+  formats::TransResult resultLastTime{};
+  bool use_init_data = true;
+  for (const auto &trans_info : trans_road) {
+    if (trans_info.node_type == RESHAPE || trans_info.node_type == REFORMAT) {
+      GELOGD("Skip to trans variable data on the reshape/reformat node");
+      continue;
+    }
+    uint8_t *src_data = nullptr;
+    if (use_init_data) {
+      src_data = var_data;
+      use_init_data = false;
+    } else {
+      src_data = resultLastTime.data.get();
+    }
 
-  uint8_t *src_addr = nullptr;
-  GE_CHK_STATUS_RET(VarManager::Instance(session_id)->GetVarAddr(var_name, src_tensor_desc, &src_addr));
-  uint8_t *mem_addr =
-      src_addr - static_cast<int64_t>(reinterpret_cast<uintptr_t>(VarManager::Instance(0)->GetVarMemLogicBase())) +
-      static_cast<int64_t>(
-          reinterpret_cast<uintptr_t>(VarManager::Instance(session_id)->GetVarMemoryBase(RT_MEMORY_HBM)));
-  GE_CHK_RT_RET(rtMallocHost(reinterpret_cast<void **>(host_addr), src_tensor_size));
+    formats::TransResult tmp_result{};
+    if (trans_info.node_type == TRANSDATA) {
+      auto src_format = trans_info.input.GetFormat();
+      auto src_shape = trans_info.input.GetShape().GetDims();
+      auto dst_format = trans_info.output.GetFormat();
+      auto dst_shape = trans_info.output.GetShape().GetDims();
+      auto data_type = trans_info.input.GetDataType();
+      GELOGD("Trans format from %s to %s, shape %s to %s, data-type %s",
+             TypeUtils::FormatToSerialString(src_format).c_str(), TypeUtils::FormatToSerialString(dst_format).c_str(),
+             formats::ShapeToString(src_shape).c_str(), formats::ShapeToString(dst_shape).c_str(),
+             TypeUtils::DataTypeToSerialString(data_type).c_str());
+      auto ret = formats::TransFormat({src_data, src_format, dst_format, src_shape, dst_shape, data_type}, tmp_result);
+      if (ret != SUCCESS) {
+        GELOGE(INTERNAL_ERROR,
+               "Failed to trans format from %s to %s, shape %s to %s, "
+               "data type %s error code %u",
+               TypeUtils::FormatToSerialString(src_format).c_str(), TypeUtils::FormatToSerialString(dst_format).c_str(),
+               formats::ShapeToString(src_shape).c_str(), formats::ShapeToString(dst_shape).c_str(),
+               TypeUtils::DataTypeToSerialString(data_type).c_str(), ret);
+        return ret;
+      }
+    } else if (trans_info.node_type == CAST) {
+      auto input_shape = trans_info.input.GetShape();
+      auto src_data_size = input_shape.GetShapeSize();
+      auto src_data_type = trans_info.input.GetDataType();
+      auto dst_data_type = trans_info.output.GetDataType();
+      GELOGD("Trans data type from %s to %s, input shape %s, data size %ld",
+             TypeUtils::DataTypeToSerialString(src_data_type).c_str(),
+             TypeUtils::DataTypeToSerialString(dst_data_type).c_str(), formats::ShapeToString(input_shape).c_str(),
+             src_data_size);
+      auto ret = formats::TransDataType({src_data, static_cast<size_t>(src_data_size), src_data_type, dst_data_type},
+                                        tmp_result);
+      if (ret != SUCCESS) {
+        GELOGE(INTERNAL_ERROR, "Failed to trans data type from %s to %s, input shape %s, data size %ld, error code %u",
+               TypeUtils::DataTypeToSerialString(src_data_type).c_str(),
+               TypeUtils::DataTypeToSerialString(dst_data_type).c_str(), formats::ShapeToString(input_shape).c_str(),
+               src_data_size, ret);
+        return ret;
+      }
+    } else {
+      GELOGE(UNSUPPORTED, "Failed to trans var data, the trans type %s does not supported",
+             trans_info.node_type.c_str());
+      return UNSUPPORTED;
+    }
+    resultLastTime = tmp_result;
+  }
 
-  GE_CHK_RT_RET(rtMemcpy(*host_addr, src_tensor_size, mem_addr, src_tensor_size, RT_MEMCPY_DEVICE_TO_HOST));
+  result = resultLastTime;
+  return SUCCESS;
+}
 
-  GELOGI("SyncTensorToHost var_name %s, src_tensor_size %u", var_name.c_str(), src_tensor_size);
+Status TransVarDataUtils::CastVarOnHost(const uint8_t *var_data, size_t elem_num, const VarTransRoad &trans_road,
+                                        formats::TransResult &result) {
+  // not owned, only kept if there is nothing to cast
+  result.data = std::shared_ptr<uint8_t>(const_cast<uint8_t *>(var_data), [](uint8_t *) {});
+  result.length = 0;
+  bool first = true;
+  for (const auto &trans_info : trans_road) {
+    if (IsSkippedTrans(trans_info)) {
+      continue;
+    }
+    if (trans_info.node_type != CAST) {
+      GELOGE(UNSUPPORTED, "Failed to cast var data, the trans type %s is not a cast", trans_info.node_type.c_str());
+      return UNSUPPORTED;
+    }
+    auto src_data_type = trans_info.input.GetDataType();
+    auto dst_data_type = trans_info.output.GetDataType();
+    if (first) {
+      result.length = elem_num * GetSizeByDataType(src_data_type);
+      first = false;
+    }
+    formats::TransResult tmp_result{};
+    auto ret = formats::TransDataType({result.data.get(), elem_num, src_data_type, dst_data_type}, tmp_result);
+    if (ret != SUCCESS) {
+      GELOGE(INTERNAL_ERROR, "Failed to trans data type from %s to %s, data size %zu, error code %u",
+             TypeUtils::DataTypeToSerialString(src_data_type).c_str(),
+             TypeUtils::DataTypeToSerialString(dst_data_type).c_str(), elem_num, ret);
+      return ret;
+    }
+    result = tmp_result;
+  }
+  if (first) {
+    result.length = elem_num;
+  }
   return SUCCESS;
 }
 
-Status TransVarDataUtils::SyncTensorToDevice(const string &var_name, const uint8_t *host_addr, uint32_t addr_size,
-                                             const ge::GeTensorDesc &dst_tensor_desc, uint64_t session_id) {
-  uint8_t *dst_addr = nullptr;
-  GE_CHK_STATUS_RET(VarManager::Instance(session_id)->GetVarAddr(var_name, dst_tensor_desc, &dst_addr));
-  uint8_t *mem_addr =
-      dst_addr - static_cast<int64_t>(reinterpret_cast<uintptr_t>(VarManager::Instance(0)->GetVarMemLogicBase())) +
+Status TransVarDataUtils::GetVarDeviceAddr(const string &var_name, const ge::GeTensorDesc &tensor_desc,
+                                           uint64_t session_id, uint8_t **dev_addr) {
+  uint8_t *logic_addr = nullptr;
+  GE_CHK_STATUS_RET(VarManager::Instance(session_id)->GetVarAddr(var_name, tensor_desc, &logic_addr));
+  *dev_addr =
+      logic_addr - static_cast<int64_t>(reinterpret_cast<uintptr_t>(VarManager::Instance(0)->GetVarMemLogicBase())) +
       static_cast<int64_t>(
           reinterpret_cast<uintptr_t>(VarManager::Instance(session_id)->GetVarMemoryBase(RT_MEMORY_HBM)));
-  GE_CHK_RT_RET(rtMemcpy(mem_addr, addr_size, host_addr, addr_size, RT_MEMCPY_HOST_TO_DEVICE));
-
-  GELOGI("SyncTensorToDevice var_name %s, addr_size %u", var_name.c_str(), addr_size);
+  return SUCCESS;
+}
 
+Status TransVarDataUtils::GetBroadCastTransfer(uint64_t session_id, VarTransfer *&transfer) {
+  auto var_manager = VarManager::Instance(session_id);
+  GE_CHECK_NOTNULL(var_manager);
+  transfer = var_manager->GetBroadCastTransfer();
+  GE_CHECK_NOTNULL(transfer);
   return SUCCESS;
 }
 }  // namespace ge
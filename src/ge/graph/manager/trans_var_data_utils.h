@@ -17,13 +17,125 @@
 #ifndef GE_GRAPH_MANAGER_TRANS_VAR_DATA_UTILS_H_
 #define GE_GRAPH_MANAGER_TRANS_VAR_DATA_UTILS_H_
 
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
+#include "common/formats/format_transfers/format_transfer.h"
 #include "framework/common/ge_inner_error_codes.h"
 #include "framework/common/ge_types.h"
+#include "graph/manager/graph_var_manager.h"
 #include "graph/utils/tensor_utils.h"
+#include "runtime/rt.h"
 
 namespace ge {
+// cost of the transfer of a variable, in us
+struct VarTransferCost {
+  size_t chunk_num;
+  uint64_t total_us;
+  // waiting for the copies between host and device
+  uint64_t wait_us;
+  // converting on host
+  uint64_t trans_us;
+};
+
+///
+/// Moves variables from device to host and back, converting them along their trans roads on the way.
+/// A variable is cut into chunks copied through pinned buffers, so the copies to host, the conversion and the copies
+/// to device of neighbouring chunks overlap. Roads of casts only are converted chunk by chunk, the other roads need
+/// the whole variable on host, their conversion overlaps the copies of the variables transferred at the same time.
+/// A transfer takes a lane, a pair of copy streams with its pinned buffers, which the following transfers reuse.
+///
+class VarTransfer {
+ public:
+  ///
+  /// @param [in] lane_num transfers running at the same time
+  /// @param [in] chunk_size bytes of a pinned buffer
+  ///
+  explicit VarTransfer(size_t lane_num = kDefaultLaneNum, size_t chunk_size = kDefaultChunkSize);
+
+  ~VarTransfer();
+
+  ///
+  /// @ingroup ge
+  /// @brief transfer a variable, blocks for a free lane if they are all taken
+  /// @param [in] var_name name of the variable
+  /// @param [in] src device addr of the variable
+  /// @param [in] src_size bytes of the variable
+  /// @param [in] trans_road conversions on host, empty to copy it as it is
+  /// @param [in] dst device addr the result is written to, may be src
+  /// @param [in] dst_size bytes dst holds
+  /// @param [out] cost cost of the transfer
+  /// @return Status result of function
+  ///
+  Status Transfer(const std::string &var_name, const uint8_t *src, size_t src_size, const VarTransRoad &trans_road,
+                  uint8_t *dst, size_t dst_size, VarTransferCost &cost);
+
+  VarTransfer(const VarTransfer &) = delete;
+  VarTransfer &operator=(const VarTransfer &) = delete;
+
+  static const size_t kDefaultLaneNum = 4;
+  static const size_t kDefaultChunkSize = 2 * 1024 * 1024;
+
+ private:
+  using CopyFunc = rtError_t (*)(void *, uint64_t, const void *, uint64_t, rtMemcpyKind_t, rtStream_t);
+  using ChunkFunc = std::function<Status(const uint8_t *, size_t, size_t)>;
+
+  struct Buffer {
+    uint8_t *data = nullptr;
+    rtEvent_t event = nullptr;
+    bool busy = false;
+  };
+
+  struct Lane {
+    rtStream_t d2h_stream = nullptr;
+    rtStream_t h2d_stream = nullptr;
+    std::vector<Buffer> read_buffers;
+    std::vector<Buffer> write_buffers;
+    size_t write_num = 0;
+  };
+
+  Status AcquireLane(Lane *&lane);
+
+  void ReleaseLane(Lane *lane);
+
+  Status InitLane(Lane &lane);
+
+  static void DestroyLane(Lane &lane);
+
+  // casts chunk by chunk
+  Status TransferByChunk(Lane &lane, const uint8_t *src, size_t src_size, const VarTransRoad &trans_road, uint8_t *dst,
+                         size_t dst_size, VarTransferCost &cost);
+
+  // converts the whole variable on host
+  Status TransferWhole(Lane &lane, const uint8_t *src, size_t src_size, const VarTransRoad &trans_road, uint8_t *dst,
+                       size_t dst_size, VarTransferCost &cost);
+
+  // copies size bytes to host in chunks of at most chunk_size, func gets every chunk with its offset in order
+  Status ReadChunks(Lane &lane, const uint8_t *src, size_t size, size_t chunk_size, const ChunkFunc &func,
+                    VarTransferCost &cost);
+
+  // queues the copy of at most chunk_size_ bytes to device
+  Status WriteChunk(Lane &lane, uint8_t *dst, const uint8_t *data, size_t len, VarTransferCost &cost);
+
+  Status WaitBuffer(Buffer &buffer, VarTransferCost &cost);
+
+  Status SyncWrites(Lane &lane, VarTransferCost &cost);
+
+  size_t lane_num_;
+  size_t chunk_size_;
+  // the copies are queued by it, the unit tests replace it as the copies of the runtime stub do nothing
+  CopyFunc copy_func_;
+
+  std::mutex lane_mutex_;
+  std::condition_variable lane_cond_;
+  std::vector<std::unique_ptr<Lane>> lanes_;
+  std::vector<Lane *> free_lanes_;
+};
+
 class TransVarDataUtils {
  public:
   static ge::Status SyncVarData2BroadCast(const string &var_name, const ge::GeTensorDesc &src_tensor_desc,
@@ -31,12 +143,33 @@ class TransVarDataUtils {
   static ge::Status SyncBroadCastData2Var(uint8_t *src_addr, uint32_t src_addr_size, const string &var_name,
                                           const ge::GeTensorDesc &dst_tensor_desc, uint64_t session_id_);
 
+  ///
+  /// @ingroup ge
+  /// @brief convert the data of a variable on host along its trans road
+  /// @param [in] var_data data of the variable in the input desc of the road
+  /// @param [in] trans_road trans road of the variable
+  /// @param [out] result data in the output desc of the road
+  /// @return Status result of function
+  ///
+  static ge::Status TransVarOnHost(uint8_t *var_data, const VarTransRoad &trans_road, formats::TransResult &result);
+
+  ///
+  /// @ingroup ge
+  /// @brief convert some elements of a variable whose road only has casts, reshapes and reformats
+  /// @param [in] var_data elements in the data type of the input desc of the road
+  /// @param [in] elem_num number of the elements
+  /// @param [in] trans_road trans road of the variable
+  /// @param [out] result elements in the data type of the output desc of the road, var_data if there is no cast
+  /// @return Status result of function
+  ///
+  static ge::Status CastVarOnHost(const uint8_t *var_data, size_t elem_num, const VarTransRoad &trans_road,
+                                  formats::TransResult &result);
+
  private:
-  static ge::Status SyncTensorToHost(const string &var_name, const ge::GeTensorDesc &src_tensor_desc,
-                                     uint8_t **host_addr, uint32_t &addr_size, uint64_t session_id_);
+  static ge::Status GetVarDeviceAddr(const string &var_name, const ge::GeTensorDesc &tensor_desc,
+                                     uint64_t session_id, uint8_t **dev_addr);
 
-  static ge::Status SyncTensorToDevice(const string &var_name, const uint8_t *host_addr, uint32_t addr_size,
-                                       const ge::GeTensorDesc &dst_tensor_desc, uint64_t session_id_);
+  static ge::Status GetBroadCastTransfer(uint64_t session_id, VarTransfer *&transfer);
 };
 }  // namespace ge
 
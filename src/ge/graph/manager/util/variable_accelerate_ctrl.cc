@@ -28,6 +28,7 @@ inline bool IsVariable(const std::string &node_type) {
 }
 
 bool VarAccelerateCtrl::IsVarPermitToChangeFormats(const std::string &var_name) {
+  std::lock_guard<std::mutex> lock(mutex_);
   auto iter = var_names_to_change_times_.find(var_name);
   if (iter == var_names_to_change_times_.end()) {
     return true;
@@ -35,7 +36,18 @@ bool VarAccelerateCtrl::IsVarPermitToChangeFormats(const std::string &var_name)
   return iter->second < kMaxVarChangeTimes_;
 }
 
+bool VarAccelerateCtrl::IsVarInUse(const std::string &var_name) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto &graph_id_to_var_names : graph_ids_to_var_names_) {
+    if (graph_id_to_var_names.second.count(var_name) > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void VarAccelerateCtrl::SetVarChanged(const std::string &var_name) {
+  std::lock_guard<std::mutex> lock(mutex_);
   auto times = ++var_names_to_change_times_[var_name];
   for (auto &graph_id_to_var_names : graph_ids_to_var_names_) {
     if (graph_id_to_var_names.second.count(var_name) > 0) {
@@ -54,6 +66,7 @@ void VarAccelerateCtrl::AddGraph(uint32_t graph_id, const ComputeGraphPtr &compu
     GELOGE(PARAM_INVALID, "Failed to add graph %u, the compute graph is null", graph_id);
     return;
   }
+  std::lock_guard<std::mutex> lock(mutex_);
   auto &var_names = graph_ids_to_var_names_[graph_id];
   for (auto &node : compute_graph->GetAllNodes()) {
     auto node_type = node->GetType();
@@ -66,14 +79,17 @@ void VarAccelerateCtrl::AddGraph(uint32_t graph_id, const ComputeGraphPtr &compu
 }
 
 void VarAccelerateCtrl::RemoveGraph(uint32_t graph_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
   GELOGD("Remove graph %u", graph_id);
   graph_ids_to_var_names_.erase(graph_id);
   graph_ids_need_rebuild_.erase(graph_id);
 }
 bool VarAccelerateCtrl::IsGraphNeedRebuild(uint32_t graph_id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
   return graph_ids_need_rebuild_.count(graph_id) > 0;
 }
 void VarAccelerateCtrl::SetGraphBuildEnd(uint32_t graph_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
   graph_ids_need_rebuild_.erase(graph_id);
   GELOGD("The graph %u has built end, remove it from the rebuild-set", graph_id);
 }
@@ -18,6 +18,7 @@
 #define GE_GRAPH_MANAGER_UTIL_VARIABLE_ACCELERATE_CTRL_H_
 
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -39,6 +40,9 @@ class VarAccelerateCtrl {
 
   bool IsVarPermitToChangeFormats(const std::string &var_name);
 
+  // whether a graph added contains the variable, built or not
+  bool IsVarInUse(const std::string &var_name) const;
+
  private:
   ///
   /// the variable and graph relationships will construct when `AddGraph`
@@ -59,6 +63,9 @@ class VarAccelerateCtrl {
   ///
   std::map<std::string, int> var_names_to_change_times_;
   static const int kMaxVarChangeTimes_ = 1;
+
+  // graphs may be built while loaded graphs check whether they need a rebuild
+  mutable std::mutex mutex_;
 };
 }  // namespace ge
 
@@ -0,0 +1,174 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/manager/var_mem_allocator.h"
+
+#include <algorithm>
+
+#include "framework/common/debug/ge_log.h"
+
+namespace ge {
+namespace {
+const size_t kSizeClassNum = 48;
+}  // namespace
+
+VarMemAllocator::VarMemAllocator(uint64_t align) : align_(std::max<uint64_t>(align, 1)), size_classes_(kSizeClassNum) {}
+
+Status VarMemAllocator::Alloc(uint64_t size, uint64_t limit, uint64_t &offset) {
+  if ((size == 0) || (size % align_ != 0)) {
+    GELOGE(PARAM_INVALID, "Var mem size %lu is not a multiple of %lu.", size, align_);
+    return PARAM_INVALID;
+  }
+
+  // the best fit of its own class, else the smallest block of a larger class
+  size_t size_class = GetSizeClass(size);
+  for (size_t i = size_class; i < size_classes_.size(); ++i) {
+    auto &blocks = size_classes_[i];
+    auto iter = (i == size_class) ? blocks.lower_bound(std::make_pair(size, static_cast<uint64_t>(0))) : blocks.begin();
+    while ((iter != blocks.end()) && (iter->second + size > limit)) {
+      ++iter;
+    }
+    if (iter == blocks.end()) {
+      continue;
+    }
+    uint64_t block_offset = iter->second;
+    uint64_t block_size = iter->first;
+    EraseFreeBlock(free_blocks_.find(block_offset));
+    if (block_size > size) {
+      InsertFreeBlock(block_offset + size, block_size - size);
+    }
+    used_blocks_[block_offset] = size;
+    offset = block_offset;
+    return SUCCESS;
+  }
+
+  if ((top_ > limit) || (limit - top_ < size)) {
+    GELOGE(PARAM_INVALID, "Malloc var mem, size[%lu] > free_size[%lu]", size, (top_ > limit) ? 0 : (limit - top_));
+    return PARAM_INVALID;
+  }
+  offset = top_;
+  used_blocks_[offset] = size;
+  top_ += size;
+  return SUCCESS;
+}
+
+Status VarMemAllocator::Free(uint64_t offset) {
+  auto iter = used_blocks_.find(offset);
+  if (iter == used_blocks_.end()) {
+    GELOGE(PARAM_INVALID, "Var mem at offset %lu is not in use.", offset);
+    return PARAM_INVALID;
+  }
+  uint64_t size = iter->second;
+  used_blocks_.erase(iter);
+
+  auto next = free_blocks_.lower_bound(offset);
+  if (next != free_blocks_.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == offset) {
+      offset = prev->first;
+      size += prev->second;
+      EraseFreeBlock(prev);
+    }
+  }
+  if ((next != free_blocks_.end()) && (offset + size == next->first)) {
+    size += next->second;
+    EraseFreeBlock(next);
+  }
+
+  // the memory on the top goes back to it
+  if (offset + size == top_) {
+    top_ = offset;
+  } else {
+    InsertFreeBlock(offset, size);
+  }
+  return SUCCESS;
+}
+
+Status VarMemAllocator::Compact(const std::function<bool(uint64_t)> &is_movable, const MoveFunc &move) {
+  Status ret = SUCCESS;
+  std::map<uint64_t, uint64_t> blocks;
+  uint64_t cursor = 0;
+  size_t move_num = 0;
+  for (const auto &block : used_blocks_) {
+    uint64_t offset = block.first;
+    uint64_t size = block.second;
+    if ((ret == SUCCESS) && (offset > cursor) && is_movable(offset)) {
+      ret = move(offset, cursor, size);
+      if (ret == SUCCESS) {
+        blocks[cursor] = size;
+        cursor += size;
+        ++move_num;
+        continue;
+      }
+      GELOGE(ret, "Move var mem from offset %lu to %lu failed, size %lu.", offset, cursor, size);
+    }
+    blocks[offset] = size;
+    cursor = offset + size;
+  }
+
+  used_blocks_.swap(blocks);
+  top_ = used_blocks_.empty() ? 0 : (used_blocks_.rbegin()->first + used_blocks_.rbegin()->second);
+  RebuildFreeBlocks();
+  GELOGI("Compact var mem, %zu blocks moved, top %lu.", move_num, top_);
+  return ret;
+}
+
+VarMemStats VarMemAllocator::GetStats() const {
+  VarMemStats stats = {0, 0, top_, 0, used_blocks_.size(), free_blocks_.size()};
+  for (const auto &block : used_blocks_) {
+    stats.used_size += block.second;
+  }
+  for (const auto &block : free_blocks_) {
+    stats.free_size += block.second;
+    stats.max_free_block_size = std::max(stats.max_free_block_size, block.second);
+  }
+  return stats;
+}
+
+size_t VarMemAllocator::GetSizeClass(uint64_t size) const {
+  uint64_t align_num = size / align_;
+  size_t size_class = 0;
+  while ((align_num > 1) && (size_class + 1 < kSizeClassNum)) {
+    align_num >>= 1;
+    ++size_class;
+  }
+  return size_class;
+}
+
+void VarMemAllocator::InsertFreeBlock(uint64_t offset, uint64_t size) {
+  free_blocks_[offset] = size;
+  (void)size_classes_[GetSizeClass(size)].insert(std::make_pair(size, offset));
+}
+
+void VarMemAllocator::EraseFreeBlock(std::map<uint64_t, uint64_t>::iterator iter) {
+  (void)size_classes_[GetSizeClass(iter->second)].erase(std::make_pair(iter->second, iter->first));
+  (void)free_blocks_.erase(iter);
+}
+
+void VarMemAllocator::RebuildFreeBlocks() {
+  free_blocks_.clear();
+  for (auto &blocks : size_classes_) {
+    blocks.clear();
+  }
+  uint64_t cursor = 0;
+  for (const auto &block : used_blocks_) {
+    if (block.first > cursor) {
+      InsertFreeBlock(cursor, block.first - cursor);
+    }
+    cursor = block.first + block.second;
+  }
+}
+}  // namespace ge
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_GRAPH_MANAGER_VAR_MEM_ALLOCATOR_H_
+#define GE_GRAPH_MANAGER_VAR_MEM_ALLOCATOR_H_
+
+#include <functional>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "framework/common/ge_inner_error_codes.h"
+
+namespace ge {
+struct VarMemStats {
+  // bytes of the blocks in use
+  uint64_t used_size;
+  // bytes of the holes below the top
+  uint64_t free_size;
+  // end of the highest block, the memory of the variables must hold it
+  uint64_t top;
+  uint64_t max_free_block_size;
+  size_t used_block_num;
+  size_t free_block_num;
+};
+
+///
+/// Places the blocks of the variables in the offsets [0, limit) of the variable memory.
+/// The freed blocks are coalesced with their free neighbours and kept in free lists by size class, a block is taken
+/// from the smallest fitting class before the memory above the top is used. Compaction slides the blocks allowed to
+/// move down over the holes, the caller copies their data.
+///
+class VarMemAllocator {
+ public:
+  // src offset, dst offset, size, dst is below src and they may overlap
+  using MoveFunc = std::function<Status(uint64_t, uint64_t, uint64_t)>;
+
+  ///
+  /// @param [in] align alignment of the offsets and sizes
+  ///
+  explicit VarMemAllocator(uint64_t align);
+
+  ~VarMemAllocator() = default;
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief take a block
+  /// @param [in] size bytes of the block, a multiple of the alignment
+  /// @param [in] limit offsets the block must stay below
+  /// @param [out] offset offset of the block
+  /// @return Status result of function
+  ///
+  Status Alloc(uint64_t size, uint64_t limit, uint64_t &offset);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief return a block taken by Alloc
+  /// @return Status result of function
+  ///
+  Status Free(uint64_t offset);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief slide the blocks down over the holes below them
+  /// @param [in] is_movable whether the block at an offset may move
+  /// @param [in] move copies the data of a block, the layout is left as it was moved so far if it fails
+  /// @return Status result of function
+  ///
+  Status Compact(const std::function<bool(uint64_t)> &is_movable, const MoveFunc &move);
+
+  uint64_t GetTop() const { return top_; }
+
+  VarMemStats GetStats() const;
+
+  VarMemAllocator(const VarMemAllocator &) = delete;
+  VarMemAllocator &operator=(const VarMemAllocator &) = delete;
+
+ private:
+  size_t GetSizeClass(uint64_t size) const;
+
+  void InsertFreeBlock(uint64_t offset, uint64_t size);
+
+  void EraseFreeBlock(std::map<uint64_t, uint64_t>::iterator iter);
+
+  // free lists rebuilt from the holes between the used blocks
+  void RebuildFreeBlocks();
+
+  uint64_t align_;
+  uint64_t top_ = 0;
+  // offset to size
+  std::map<uint64_t, uint64_t> used_blocks_;
+  // offset to size, coalesced, all below the top
+  std::map<uint64_t, uint64_t> free_blocks_;
+  // size and offset of the free blocks by the log2 of their size in alignments
+  std::vector<std::set<std::pair<uint64_t, uint64_t>>> size_classes_;
+};
+}  // namespace ge
+
+#endif  // GE_GRAPH_MANAGER_VAR_MEM_ALLOCATOR_H_
@@ -166,6 +166,9 @@ void ge::GraphPartitioner::ClearAllPartitionData(Mode mode) {
   cluster_2_partition_.clear();
   clusters_.clear();
   node_2_cluster_.clear();
+  cluster_ranks_.clear();
+  merged_to_.clear();
+  visited_marks_.clear();
   pld_2_end_.clear();
   end_2_pld_.clear();
   if (mode_ == kMerging) {
@@ -532,7 +535,7 @@ Status ge::GraphPartitioner::Initialize(ge::ComputeGraphPtr compute_graph) {
       }
     }
     node_2_cluster_[node] = new_cluster;
-    clusters_[temp_index] = new_cluster;
+    clusters_.push_back(new_cluster);
     GELOGD("Node name is %s, engine is %s, cluster index is %zu, stream label is %s", node->GetName().c_str(),
            new_cluster->engine_name_.c_str(), new_cluster->index_, new_cluster->stream_label_.c_str());
     temp_index++;
@@ -633,10 +636,14 @@ void ge::GraphPartitioner::MergeTwoClusters(size_t parent_cluster, size_t &child
     child_cluster = small_cluster;
   }
 
-  // update node_2_cluster_ map
-  for (auto &node : clusters_[big_cluster]->nodes_) {
-    node_2_cluster_[node] = clusters_[small_cluster];
-  }
+  /// The merged cluster takes the rank of the parent, then only the inputs of the child may be ranked after it,
+  /// or the rank of the child, then only the outputs of the parent may be ranked before it. Check the fewer.
+  const ClusterSet &child_inputs = clusters_[child_cluster_original]->in_clu_;
+  const ClusterSet &parent_outputs = clusters_[parent_cluster]->out_clu_;
+  bool take_parent_rank = child_inputs.size() <= parent_outputs.size();
+  size_t merged_rank = take_parent_rank ? cluster_ranks_[parent_cluster] : cluster_ranks_[child_cluster_original];
+  std::vector<size_t> checked_clusters(take_parent_rank ? child_inputs.begin() : parent_outputs.begin(),
+                                       take_parent_rank ? child_inputs.end() : parent_outputs.end());
   // merge nodes
   clusters_[small_cluster]->nodes_.splice(clusters_[small_cluster]->nodes_.end(), clusters_[big_cluster]->nodes_);
   // merge all input & output to small cluster
@@ -656,6 +663,78 @@ void ge::GraphPartitioner::MergeTwoClusters(size_t parent_cluster, size_t &child
     clusters_[out_clu]->in_clu_.erase(big_cluster);
   }
   clusters_[big_cluster] = clusters_[small_cluster];
+  // node_2_cluster_ is updated once after marking
+  merged_to_[big_cluster] = small_cluster;
+  cluster_ranks_[small_cluster] = merged_rank;
+  for (auto cluster : checked_clusters) {
+    if ((cluster == parent_cluster) || (cluster == child_cluster_original)) {
+      continue;
+    }
+    if (take_parent_rank && (cluster_ranks_[cluster] > cluster_ranks_[small_cluster])) {
+      ReorderClusters(cluster, small_cluster);
+    } else if (!take_parent_rank && (cluster_ranks_[cluster] < cluster_ranks_[small_cluster])) {
+      ReorderClusters(small_cluster, cluster);
+    }
+  }
+}
+
+size_t ge::GraphPartitioner::FindCluster(size_t cluster) {
+  while (merged_to_[cluster] != cluster) {
+    merged_to_[cluster] = merged_to_[merged_to_[cluster]];
+    cluster = merged_to_[cluster];
+  }
+  return cluster;
+}
+
+void ge::GraphPartitioner::ReorderClusters(size_t from, size_t to) {
+  // Pearce-Kelly: the clusters reachable from to and the clusters reaching from, which are ranked between them,
+  // swap their ranks so that the ones reaching from come first
+  std::vector<size_t> forward;
+  std::vector<size_t> backward;
+  CollectClusters(to, true, cluster_ranks_[from], forward);
+  CollectClusters(from, false, cluster_ranks_[to], backward);
+  auto comp_func = [this](size_t cluster1, size_t cluster2) -> bool {
+    return cluster_ranks_[cluster1] < cluster_ranks_[cluster2];
+  };
+  std::sort(forward.begin(), forward.end(), comp_func);
+  std::sort(backward.begin(), backward.end(), comp_func);
+  std::vector<size_t> ranks;
+  ranks.reserve(forward.size() + backward.size());
+  for (auto cluster : backward) {
+    ranks.push_back(cluster_ranks_[cluster]);
+  }
+  for (auto cluster : forward) {
+    ranks.push_back(cluster_ranks_[cluster]);
+  }
+  std::sort(ranks.begin(), ranks.end());
+  size_t rank_index = 0;
+  for (auto cluster : backward) {
+    cluster_ranks_[cluster] = ranks[rank_index++];
+  }
+  for (auto cluster : forward) {
+    cluster_ranks_[cluster] = ranks[rank_index++];
+  }
+}
+
+void ge::GraphPartitioner::CollectClusters(size_t start, bool forward, size_t bound_rank,
+                                           std::vector<size_t> &collected) {
+  ++search_times_;
+  std::vector<size_t> temp_stack;
+  temp_stack.push_back(start);
+  visited_marks_[start] = search_times_;
+  while (!temp_stack.empty()) {
+    size_t cluster = temp_stack.back();
+    temp_stack.pop_back();
+    collected.push_back(cluster);
+    const ClusterSet &next_clusters = forward ? clusters_[cluster]->out_clu_ : clusters_[cluster]->in_clu_;
+    for (auto next : next_clusters) {
+      bool in_bound = forward ? (cluster_ranks_[next] < bound_rank) : (cluster_ranks_[next] > bound_rank);
+      if (in_bound && visited_marks_[next] != search_times_) {
+        visited_marks_[next] = search_times_;
+        temp_stack.push_back(next);
+      }
+    }
+  }
 }
 
 void ge::GraphPartitioner::RemoveEdge(size_t parent_cluster, size_t child_cluster) {
@@ -677,6 +756,15 @@ void ge::GraphPartitioner::InsertEdge(size_t from, size_t to) {
 void ge::GraphPartitioner::MarkClusters() {
   GELOGI("MarkClusters starts. cluster size is %zu", clusters_.size());
   size_t cluster_size = clusters_.size();
+  // nodes are sorted, so are the clusters before merging
+  cluster_ranks_.resize(cluster_size);
+  merged_to_.resize(cluster_size);
+  for (size_t cluster = 0; cluster < cluster_size; ++cluster) {
+    cluster_ranks_[cluster] = cluster;
+    merged_to_[cluster] = cluster;
+  }
+  visited_marks_.assign(cluster_size, 0);
+  search_times_ = 0;
   for (size_t child_cluster = 0; child_cluster < cluster_size; child_cluster++) {
     auto found_child_cluster = clusters_[child_cluster];
     if (found_child_cluster == nullptr) {
@@ -701,6 +789,10 @@ void ge::GraphPartitioner::MarkClusters() {
       }
     }
   }
+  for (auto &node_cluster : node_2_cluster_) {
+    // the clusters in node_2_cluster_ are still the ones the nodes are initialized in
+    node_cluster.second = clusters_[FindCluster(node_cluster.second->index_)];
+  }
   GELOGI("MarkClusters ends.");
 }
 
@@ -781,23 +873,40 @@ bool ge::GraphPartitioner::HasSecondPath(size_t src, size_t dst, size_t upper_bo
     return false;
   }
   /// Avoid recursion since stack space might be limited.
-  /// We instead keep a stack of nodes to visit.
-  std::vector<size_t> temp_stack;
-  std::unordered_set<size_t> visited;
-  temp_stack.push_back(src);
-  while (!temp_stack.empty()) {
-    size_t cluster = temp_stack.back();
-    temp_stack.pop_back();
-    ClusterPtr cur_cluster = clusters_[cluster];
-    if (!visited.insert(cluster).second) {
-      continue;
-    }
-    for (auto out : cur_cluster->out_clu_) {
-      if (out == dst) {
-        return true;  // There is cycle
+  /// We instead keep stacks of nodes to visit, forward from src and backward from dst, and visit the one with
+  /// fewer edges first, there is a path once they meet. A path only passes the clusters ranked between src and dst.
+  size_t src_rank = cluster_ranks_[src];
+  size_t dst_rank = cluster_ranks_[dst];
+  size_t forward_mark = ++search_times_;
+  size_t backward_mark = ++search_times_;
+  std::vector<size_t> forward_stack = {src};
+  std::vector<size_t> backward_stack = {dst};
+  visited_marks_[src] = forward_mark;
+  visited_marks_[dst] = backward_mark;
+  while (!forward_stack.empty() && !backward_stack.empty()) {
+    const ClusterSet &out_clusters = clusters_[forward_stack.back()]->out_clu_;
+    const ClusterSet &in_clusters = clusters_[backward_stack.back()]->in_clu_;
+    if (out_clusters.size() <= in_clusters.size()) {
+      forward_stack.pop_back();
+      for (auto out : out_clusters) {
+        if (visited_marks_[out] == backward_mark) {
+          return true;  // There is cycle
+        }
+        if ((out < upper_bound) && (cluster_ranks_[out] < dst_rank) && (visited_marks_[out] != forward_mark)) {
+          visited_marks_[out] = forward_mark;
+          forward_stack.push_back(out);
+        }
       }
-      if (out < upper_bound) {
-        temp_stack.push_back(out);
+    } else {
+      backward_stack.pop_back();
+      for (auto in : in_clusters) {
+        if (visited_marks_[in] == forward_mark) {
+          return true;
+        }
+        if ((cluster_ranks_[in] > src_rank) && (visited_marks_[in] != backward_mark)) {
+          visited_marks_[in] = backward_mark;
+          backward_stack.push_back(in);
+        }
       }
     }
   }
@@ -117,6 +117,14 @@ class GraphPartitioner {
   // Check if there's a second path between two clusters. The max path length is upper_bound
   bool HasSecondPath(size_t src, size_t dst, size_t upper_bound);
 
+  // Find the cluster a cluster index is merged to
+  size_t FindCluster(size_t cluster);
+
+  /// Restore the topological ranks after an edge from->to is added with from ranked after to,
+  /// only the clusters ranked between them are moved
+  void ReorderClusters(size_t from, size_t to);
+  void CollectClusters(size_t start, bool forward, size_t bound_rank, std::vector<size_t> &collected);
+
   // Mark all clusters
   void MarkClusters();
 
@@ -146,8 +154,12 @@ class GraphPartitioner {
   Mode mode_ = kPartitioning;
   uint32_t partition_times_ = 0;                                          // times of call partition
   std::vector<ComputeGraphPtr> transfer_graph_;                           // contains all transfer graphs
-  std::unordered_map<size_t, ClusterPtr> clusters_;                     // index to cluster ptr, contains all nodes
+  std::vector<ClusterPtr> clusters_;                                      // index to cluster ptr, contains all nodes
   std::unordered_map<NodePtr, std::shared_ptr<Cluster>> node_2_cluster_;  // node map to cluster
+  std::vector<size_t> cluster_ranks_;   // index to topological rank in the graph of clusters, ranks may have gaps
+  std::vector<size_t> merged_to_;       // index to the index it is merged to, union find of the marking
+  std::vector<size_t> visited_marks_;   // index to the last search visiting it
+  size_t search_times_ = 0;
   std::unordered_map<std::shared_ptr<Cluster>, ComputeGraphPtr> cluster_2_partition_;  // cluster map to subgraph
 };
 }  // namespace ge
@@ -17,9 +17,11 @@
 #include "graph/passes/base_pass.h"
 
 #include <queue>
-#include <unordered_set>
+#include <unordered_map>
+#include <vector>
 
 #include "common/debug/log.h"
+#include "common/tracer.h"
 #include "framework/common/debug/ge_log.h"
 #include "graph/compute_graph.h"
 #include "graph/utils/graph_utils.h"
@@ -29,42 +31,204 @@ namespace {
 const int kMaxRePassTimes = 1000;
 const size_t kMaxOneInNodes = 1000;
 
+bool IsNextIterationNode(const NodePtr &node) {
+  auto type = node->GetType();
+  return (type == NEXTITERATION) || (type == REFNEXTITERATION);
+}
+
+enum NodePassFlag : uint8_t {
+  kNodeSeen = 0x1,
+  kNodeDeleted = 0x2,
+  kNodeRePass = 0x4,
+  kNodeLast = 0x8,
+};
+
+///
+/// Per-run bookkeeping of GEPass. GetAllNodesNoInputEdge numbers every node of the graph once at
+/// the start of the run, so the seen/deleted/re-pass marks are bit flags indexed by that number.
+/// Only the nodes added to the graph by a pass are numbered on demand. The numbers live in this
+/// run's own table, so runs over the same nodes do not interfere.
+///
+class NodePassStates {
+ public:
+  explicit NodePassStates(size_t node_num) {
+    ids_.reserve(node_num);
+    flags_.reserve(node_num);
+  }
+
+  size_t GetId(const Node *node) {
+    auto ret = ids_.emplace(node, flags_.size());
+    if (ret.second) {
+      flags_.push_back(0);
+    }
+    return ret.first->second;
+  }
+
+  bool HasFlag(const Node *node, NodePassFlag flag) const {
+    auto iter = ids_.find(node);
+    return iter != ids_.end() && (flags_[iter->second] & flag) != 0;
+  }
+
+  ///
+  /// @return true if the flag was not set before
+  ///
+  bool SetFlag(Node *node, NodePassFlag flag) {
+    auto &flags = flags_[GetId(node)];
+    if ((flags & flag) != 0) {
+      return false;
+    }
+    flags |= flag;
+    if (flag == kNodeRePass) {
+      ++re_pass_count_;
+    }
+    return true;
+  }
+
+  ///
+  /// @return true if the flag was set before
+  ///
+  bool ClearFlag(Node *node, NodePassFlag flag) {
+    auto &flags = flags_[GetId(node)];
+    if ((flags & flag) == 0) {
+      return false;
+    }
+    flags &= static_cast<uint8_t>(~flag);
+    if (flag == kNodeRePass) {
+      --re_pass_count_;
+    }
+    return true;
+  }
+
+  bool IsSeen(const Node *node) const { return HasFlag(node, kNodeSeen); }
+
+  size_t GetRePassCount() const { return re_pass_count_; }
+
+  ///
+  /// Same rule as Node::IsAllInNodesSeen, but walks the anchors directly and
+  /// checks the seen bits, without building the in-nodes vector.
+  ///
+  bool IsAllInNodesSeen(const NodePtr &node) const {
+    auto in_data_anchor_size = static_cast<int>(node->GetAllInDataAnchorsSize());
+    for (int i = 0; i < in_data_anchor_size; ++i) {
+      auto in_anchor = node->GetInDataAnchor(i);
+      if (in_anchor == nullptr) {
+        continue;
+      }
+      auto out_anchor = in_anchor->GetPeerOutAnchor();
+      if (out_anchor == nullptr) {
+        continue;
+      }
+      auto in_node = out_anchor->GetOwnerNode();
+      if (in_node == nullptr || IsNextIterationNode(in_node)) {
+        continue;
+      }
+      if (!IsSeen(in_node.get())) {
+        return false;
+      }
+    }
+
+    auto in_control_anchor = node->GetInControlAnchor();
+    if (in_control_anchor == nullptr || in_control_anchor->IsPeerOutAnchorsEmpty()) {
+      return true;
+    }
+    for (const auto &out_control_anchor : in_control_anchor->GetPeerOutControlAnchors()) {
+      if (out_control_anchor == nullptr) {
+        continue;
+      }
+      auto in_node = out_control_anchor->GetOwnerNode();
+      if (in_node == nullptr || IsNextIterationNode(in_node)) {
+        continue;
+      }
+      if (!IsSeen(in_node.get())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  std::unordered_map<const Node *, size_t> ids_;
+  std::vector<uint8_t> flags_;
+  size_t re_pass_count_ = 0;
+};
+
+///
+/// Same count as Node::GetInNodes().size(), without building the vector.
+///
+size_t GetInNodesSize(const NodePtr &node) {
+  size_t in_nums = 0;
+  auto in_data_anchor_size = static_cast<int>(node->GetAllInDataAnchorsSize());
+  for (int i = 0; i < in_data_anchor_size; ++i) {
+    auto in_anchor = node->GetInDataAnchor(i);
+    if (in_anchor != nullptr && in_anchor->GetPeerOutAnchor() != nullptr) {
+      ++in_nums;
+    }
+  }
+  auto in_control_anchor = node->GetInControlAnchor();
+  if (in_control_anchor != nullptr) {
+    in_nums += in_control_anchor->GetPeerAnchorsSize();
+  }
+  return in_nums;
+}
+
 void GetAllNodesNoInputEdge(const ComputeGraphPtr &graph, std::queue<NodePtr> &input_edge_nodes,
-                            std::unordered_set<Node *> &nodes_seen, std::unordered_set<NodePtr> &nodes_last) {
+                            NodePassStates &states, std::vector<NodePtr> &nodes_last) {
   nodes_last.clear();
   for (auto &node : graph->GetAllNodes()) {
     if (node == nullptr) {
       continue;
     }
-    size_t in_nums = node->GetInNodes().size();
+    (void)states.GetId(node.get());
+    size_t in_nums = GetInNodesSize(node);
     if (in_nums == 0) {
       input_edge_nodes.push(node);
-      nodes_seen.insert(node.get());
+      (void)states.SetFlag(node.get(), kNodeSeen);
     } else if (in_nums > kMaxOneInNodes) {
-      nodes_last.insert(node);
+      nodes_last.push_back(node);
+      (void)states.SetFlag(node.get(), kNodeLast);
     }
   }
 }
 
-void AddNextIterNodes(const Node::Vistor<NodePtr> &nodes, std::queue<NodePtr> &nodes_to_pass,
-                      std::unordered_set<Node *> &nodes_seen, std::unordered_set<NodePtr> &nodes_last) {
-  for (auto &node : nodes) {
-    if (node == nullptr) {
+void TryAddNextIterNode(const NodePtr &node, std::queue<NodePtr> &nodes_to_pass, NodePassStates &states) {
+  if (node == nullptr) {
+    return;
+  }
+  if (states.HasFlag(node.get(), kNodeLast) || states.IsSeen(node.get())) {
+    return;
+  }
+  if (states.IsAllInNodesSeen(node)) {
+    (void)states.SetFlag(node.get(), kNodeSeen);
+    nodes_to_pass.push(node);
+  }
+}
+
+void AddNextIterNodes(const NodePtr &node, std::queue<NodePtr> &nodes_to_pass, NodePassStates &states) {
+  auto out_data_anchor_size = static_cast<int>(node->GetAllOutDataAnchorsSize());
+  for (int i = 0; i < out_data_anchor_size; ++i) {
+    auto out_anchor = node->GetOutDataAnchor(i);
+    if (out_anchor == nullptr) {
       continue;
     }
-    if (nodes_last.count(node) != 0) {
-      continue;
+    for (const auto &peer_in_anchor : out_anchor->GetPeerInDataAnchors()) {
+      if (peer_in_anchor != nullptr) {
+        TryAddNextIterNode(peer_in_anchor->GetOwnerNode(), nodes_to_pass, states);
+      }
     }
-
-    bool all_in_nodes_seen = node->IsAllInNodesSeen(nodes_seen);
-    if (all_in_nodes_seen && nodes_seen.insert(node.get()).second) {
-      nodes_to_pass.push(node);
+  }
+  auto out_control_anchor = node->GetOutControlAnchor();
+  if (out_control_anchor == nullptr) {
+    return;
+  }
+  for (const auto &peer_in_anchor : out_control_anchor->GetPeerInControlAnchors()) {
+    if (peer_in_anchor != nullptr) {
+      TryAddNextIterNode(peer_in_anchor->GetOwnerNode(), nodes_to_pass, states);
     }
   }
 }
 
-Status RunPasses(NodePtr &node, const NamesToPass &names_to_passes, std::unordered_set<NodePtr> &nodes_re_pass,
-                 std::unordered_set<Node *> &nodes_deleted, std::unordered_set<Node *> &nodes_seen) {
+Status RunPasses(NodePtr &node, const NamesToPass &names_to_passes, std::vector<NodePtr> &nodes_re_pass,
+                 NodePassStates &states) {
   if (node == nullptr) {
     GELOGE(FAILED, "parameter is null.");
     return FAILED;
@@ -87,24 +251,28 @@ Status RunPasses(NodePtr &node, const NamesToPass &names_to_passes, std::unorder
       return result;
     }
 
-    auto nodes_to_re_pass = name_to_pass.second->GetNodesNeedRePass();
-    for (const auto &node_to_re_pass : nodes_to_re_pass) {
+    for (const auto &node_to_re_pass : name_to_pass.second->GetNodesNeedRePass()) {
       if (node_to_re_pass == nullptr) {
         GELOGW("Found null re-pass node when executing %s on node %s type %s", name_to_pass.first.c_str(),
                node->GetName().c_str(), node->GetType().c_str());
         continue;
       }
-      if (node_to_re_pass->IsAllInNodesSeen(nodes_seen)) {
+      if (states.IsAllInNodesSeen(node_to_re_pass)) {
         GELOGD("The node %s will be re-pass later", node_to_re_pass->GetName().c_str());
-        nodes_re_pass.insert(node_to_re_pass);
+        if (states.SetFlag(node_to_re_pass.get(), kNodeRePass)) {
+          nodes_re_pass.push_back(node_to_re_pass);
+        }
       } else {
         GELOGD("The node %s are not all seen, don't set repass this time", node_to_re_pass->GetName().c_str());
       }
     }
 
-    auto nodes_deleted_by_pass = name_to_pass.second->GetNodesDeleted();
-    nodes_deleted.insert(nodes_deleted_by_pass.begin(), nodes_deleted_by_pass.end());
-    if (nodes_deleted_by_pass.count(node.get()) > 0) {
+    for (auto node_deleted : name_to_pass.second->GetNodesDeleted()) {
+      if (node_deleted != nullptr) {
+        (void)states.SetFlag(node_deleted, kNodeDeleted);
+      }
+    }
+    if (states.HasFlag(node.get(), kNodeDeleted)) {
       GELOGD("The node %s was deleted by pass %s, stop the remain passes", node->GetName().c_str(),
              name_to_pass.first.c_str());
       break;
@@ -154,20 +322,23 @@ Status GEPass::Run(const NamesToPass &names_to_passes) {
     return INTERNAL_ERROR;
   }
 
+  GE_TRACE_SCOPE("GEPass::Run");
   GELOGD("Begin to run pass on graph, passes count %zu", names_to_passes.size());
   std::queue<NodePtr> nodes;
-  std::unordered_set<Node *> nodes_seen;
-  std::unordered_set<Node *> nodes_deleted;
-  std::unordered_set<NodePtr> nodes_re_pass;
-  std::unordered_set<NodePtr> nodes_last;
-  GetAllNodesNoInputEdge(graph_, nodes, nodes_seen, nodes_last);
+  NodePassStates states(graph_->GetDirectNodesSize());
+  std::vector<NodePtr> nodes_re_pass;
+  std::vector<NodePtr> nodes_last;
+  GetAllNodesNoInputEdge(graph_, nodes, states, nodes_last);
   GELOGD("Start points count %zu", nodes.size());
   int re_pass_times = 0;
 
   do {
     for (auto &node : nodes_re_pass) {
-      nodes.push(node);
-      nodes_seen.insert(node.get());
+      // the mark was cleared if the node has been passed again in this round already
+      if (states.ClearFlag(node.get(), kNodeRePass)) {
+        nodes.push(node);
+        (void)states.SetFlag(node.get(), kNodeSeen);
+      }
     }
     nodes_re_pass.clear();
 
@@ -175,16 +346,16 @@ Status GEPass::Run(const NamesToPass &names_to_passes) {
       NodePtr node = nodes.front();
       nodes.pop();
 
-      (void)nodes_re_pass.erase(node);
       GE_IF_BOOL_EXEC(node == nullptr, GELOGW("node is null"); continue);
-      if (nodes_deleted.count(node.get()) > 0) {
+      (void)states.ClearFlag(node.get(), kNodeRePass);
+      if (states.HasFlag(node.get(), kNodeDeleted)) {
         GELOGD("The node %s was deleted before, skip it.", node->GetName().c_str());
         continue;
       }
 
-      AddNextIterNodes(node->GetOutNodes(), nodes, nodes_seen, nodes_last);
+      AddNextIterNodes(node, nodes, states);
 
-      auto ret = RunPasses(node, names_to_passes, nodes_re_pass, nodes_deleted, nodes_seen);
+      auto ret = RunPasses(node, names_to_passes, nodes_re_pass, states);
       if (ret != SUCCESS) {
         GELOGE(INTERNAL_ERROR,
                "Failed to process passes on node %s type %s,"
@@ -195,13 +366,13 @@ Status GEPass::Run(const NamesToPass &names_to_passes) {
     }
 
     for (auto &node : nodes_last) {
-      bool all_in_nodes_seen = node->IsAllInNodesSeen(nodes_seen);
-      if (all_in_nodes_seen && nodes_seen.insert(node.get()).second) {
-         nodes.push(node);
+      (void)states.ClearFlag(node.get(), kNodeLast);
+      if (states.IsAllInNodesSeen(node) && states.SetFlag(node.get(), kNodeSeen)) {
+        nodes.push(node);
       }
     }
     nodes_last.clear();
-  } while ((!nodes_re_pass.empty() || !nodes.empty()) && ++re_pass_times < kMaxRePassTimes);
+  } while ((states.GetRePassCount() > 0 || !nodes.empty()) && ++re_pass_times < kMaxRePassTimes);
 
   if (re_pass_times == kMaxRePassTimes) {
     GELOGW("re_pass_times should not come to %d", kMaxRePassTimes);
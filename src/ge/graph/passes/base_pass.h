@@ -19,7 +19,6 @@
 
 #include <set>
 #include <string>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -41,9 +40,14 @@ class BaseNodePass {
 
   virtual ~BaseNodePass() = default;
 
-  std::unordered_set<NodePtr> GetNodesNeedRePass() { return nodes_need_re_pass_; }
+  ///
+  /// The nodes are recorded in the order they were added and may contain
+  /// duplicates, the GEPass driver de-duplicates them with its own marks.
+  /// The returned references are valid until the next call of init().
+  ///
+  const std::vector<NodePtr> &GetNodesNeedRePass() const { return nodes_need_re_pass_; }
 
-  std::unordered_set<Node *> GetNodesDeleted() { return nodes_deleted_; }
+  const std::vector<Node *> &GetNodesDeleted() const { return nodes_deleted_; }
 
   void init() {
     nodes_need_re_pass_.clear();
@@ -63,7 +67,7 @@ class BaseNodePass {
   /// optimized by other passes, call this function.
   /// @param node
   ///
-  void AddRePassNode(NodePtr &node) { nodes_need_re_pass_.insert(node); }
+  void AddRePassNode(NodePtr &node) { nodes_need_re_pass_.push_back(node); }
 
   ///
   /// Add a node and it's input/output data nodes to be optimized again.
@@ -89,11 +93,11 @@ class BaseNodePass {
   /// next iterations.
   /// @param node
   ///
-  void AddNodeDeleted(Node *node) { nodes_deleted_.insert(node); }
+  void AddNodeDeleted(Node *node) { nodes_deleted_.push_back(node); }
 
  private:
-  std::unordered_set<NodePtr> nodes_need_re_pass_;
-  std::unordered_set<Node *> nodes_deleted_;
+  std::vector<NodePtr> nodes_need_re_pass_;
+  std::vector<Node *> nodes_deleted_;
 };
 
 using NamesToPass = std::vector<std::pair<std::string, BaseNodePass *>>;
@@ -16,9 +16,10 @@
 
 #include "graph/passes/folding_kernel/add_kernel.h"
 
-#include <cfloat>
+#include <limits>
+#include <type_traits>
 
-#include "graph/common/bcast.h"
+#include "graph/passes/folding_kernel/folding_compute.h"
 #include "graph/utils/type_utils.h"
 #include "inc/kernel_factory.h"
 
@@ -35,104 +36,75 @@ const size_t kAddOutputSize = 1;
     ret = BCastAdd<TYPE>(op_desc_ptr, input, v_output); \
     break;
 
-#define SET_OVERFLOW_CHECK_SIGNED_CASE(DTYPE, MAX_VALUE, MIN_VALUE)                 \
-  case (DTYPE):                                                                     \
-    if (((y > 0) && (x > ((MAX_VALUE)-y))) || ((y < 0) && (x < ((MIN_VALUE)-y)))) { \
-      overflow_flag = true;                                                         \
-    }                                                                               \
-    break;
+template <typename T>
+struct AddFunc {
+  T operator()(const T &x, const T &y) const { return x + y; }
+};
 
-#define SET_OVERFLOW_CHECK_UNSIGNED_CASE(DTYPE, TYPE, MAX_VALUE)          \
-  case (DTYPE): {                                                         \
-    TYPE threshold = static_cast<TYPE>(static_cast<TYPE>(MAX_VALUE) - y); \
-    if (static_cast<TYPE>(x) > threshold) {                               \
-      overflow_flag = true;                                               \
-    }                                                                     \
-    break;                                                                \
+// exact for the signed integers: the sum wraps iff its sign differs from the signs of both
+template <typename T>
+struct AddOverflowCheck {
+  bool operator()(const T &x, const T &y) const {
+    using UnsignedT = typename std::make_unsigned<T>::type;
+    T sum = static_cast<T>(static_cast<UnsignedT>(x) + static_cast<UnsignedT>(y));
+    return ((x ^ sum) & (y ^ sum)) < 0;
   }
-}  // namespace
-
+};
+
+template <>
+struct AddOverflowCheck<uint8_t> {
+  bool operator()(const uint8_t &x, const uint8_t &y) const { return static_cast<uint8_t>(x + y) < x; }
+};
+template <>
+struct AddOverflowCheck<uint16_t> {
+  bool operator()(const uint16_t &x, const uint16_t &y) const { return static_cast<uint16_t>(x + y) < x; }
+};
+template <>
+struct AddOverflowCheck<uint32_t> {
+  bool operator()(const uint32_t &x, const uint32_t &y) const { return x + y < x; }
+};
+template <>
+struct AddOverflowCheck<uint64_t> {
+  bool operator()(const uint64_t &x, const uint64_t &y) const { return x + y < x; }
+};
+
+// the bounds of the floating point types are checked as they always were, against their max and normalized min
 template <typename T>
-bool AddKernel::OverflowCheck(const T &x, const T &y, DataType data_type) {
-  bool overflow_flag = false;
-
-  switch (data_type) {
-    SET_OVERFLOW_CHECK_SIGNED_CASE(DT_INT8, INT8_MAX, INT8_MIN)
-    SET_OVERFLOW_CHECK_SIGNED_CASE(DT_INT16, INT16_MAX, INT16_MIN)
-    SET_OVERFLOW_CHECK_SIGNED_CASE(DT_INT32, INT32_MAX, INT32_MIN)
-    SET_OVERFLOW_CHECK_SIGNED_CASE(DT_INT64, INT64_MAX, INT64_MIN)
-    SET_OVERFLOW_CHECK_SIGNED_CASE(DT_FLOAT, FLT_MAX, FLT_MIN)
-    SET_OVERFLOW_CHECK_SIGNED_CASE(DT_DOUBLE, DBL_MAX, DBL_MIN)
-    SET_OVERFLOW_CHECK_UNSIGNED_CASE(DT_UINT8, uint8_t, UINT8_MAX)
-    SET_OVERFLOW_CHECK_UNSIGNED_CASE(DT_UINT16, uint16_t, UINT16_MAX)
-    SET_OVERFLOW_CHECK_UNSIGNED_CASE(DT_UINT32, uint32_t, UINT32_MAX)
-    SET_OVERFLOW_CHECK_UNSIGNED_CASE(DT_UINT64, uint64_t, UINT64_MAX)
-    default:
-      break;
+struct FloatAddOverflowCheck {
+  bool operator()(const T &x, const T &y) const {
+    return ((y > 0) & (x > (std::numeric_limits<T>::max() - y))) |
+           ((y < 0) & (x < (std::numeric_limits<T>::min() - y)));
   }
-
-  return overflow_flag;
-}
+};
+template <>
+struct AddOverflowCheck<float> : FloatAddOverflowCheck<float> {};
+template <>
+struct AddOverflowCheck<double> : FloatAddOverflowCheck<double> {};
+}  // namespace
 
 template <typename InT>
 Status AddKernel::BCastAdd(const OpDescPtr &op_desc_ptr, const std::vector<ConstGeTensorPtr> &input,
                            std::vector<GeTensorPtr> &v_output) {
-  // only broadcast shape
-  BCast bcast;
-  Status ret = bcast.GenerateBcastInfo(ge::BCast::TransShapeToDimVec(input[kAddFirstInput]->GetTensorDesc()),
-                                       ge::BCast::TransShapeToDimVec(input[kAddSecondInput]->GetTensorDesc()));
+  std::vector<InT> data;
+  BroadcastInfo info;
+  Status ret = FoldingCompute::BroadcastCompute<InT, InT>(input[kAddFirstInput], input[kAddSecondInput],
+                                                          AddFunc<InT>(), AddOverflowCheck<InT>(), data, info);
   if (ret != SUCCESS) {
-    GELOGE(ret, "Greater broadcasting failed.");
+    GELOGE(ret, "Add broadcasting failed, or the result of add is overflow.");
     return ret;
   }
 
-  std::vector<int64_t> x_indexes;
-  std::vector<int64_t> y_indexes;
-  bcast.BCastIndexes(x_indexes, y_indexes);
-
-  if (input[kAddFirstInput]->GetData().size() < sizeof(InT)) {
-    GELOGE(FAILED, "The size of the first input is less than the size of the InT.");
-    return FAILED;
-  }
-  auto x1_data = reinterpret_cast<const InT *>(input[kAddFirstInput]->GetData().data());
-
-  if (input[kAddSecondInput]->GetData().size() < sizeof(InT)) {
-    GELOGE(FAILED, "The size of the second input is less than the size of the InT.");
-    return FAILED;
-  }
-  auto x2_data = reinterpret_cast<const InT *>(input[kAddSecondInput]->GetData().data());
-
-  size_t data_num = x_indexes.size();
-  InT *data = nullptr;
-  data = new (std::nothrow) InT[data_num]();
-  GE_CHECK_NOTNULL(data);
-
-  DataType data_type = input[kAddFirstInput]->GetTensorDesc().GetDataType();
-  for (size_t i = 0; i < data_num; i++) {
-    auto x_index = *(x1_data + x_indexes[i]);
-    auto y_index = *(x2_data + y_indexes[i]);
-    if (OverflowCheck<InT>(x_index, y_index, data_type)) {
-      GELOGE(PARAM_INVALID, "Result of add is overflow.");
-      GE_DELETE_NEW_ARRAY(data);
-      return PARAM_INVALID;
-    }
-    data[i] = x_index + y_index;
-  }
-
   GeTensorPtr output_ptr = MakeShared<GeTensor>(op_desc_ptr->GetOutputDesc(kAddFirstOutput));
   if (output_ptr == nullptr) {
     GELOGE(MEMALLOC_FAILED, "Make shared failed");
-    GE_DELETE_NEW_ARRAY(data);
     return MEMALLOC_FAILED;
   }
-  if (output_ptr->SetData(reinterpret_cast<uint8_t *>(data), data_num * sizeof(InT))) {
+  if (output_ptr->SetData(reinterpret_cast<uint8_t *>(data.data()), data.size() * sizeof(InT))) {
     GELOGW("GetRange: SetData failed");
   }
-  GE_DELETE_NEW_ARRAY(data);
 
-  output_ptr->MutableTensorDesc().SetDataType(data_type);
-  vector<int64_t> bcast_dims = bcast.GetOutputShape();
-  output_ptr->MutableTensorDesc().SetShape(GeShape(bcast_dims));
+  output_ptr->MutableTensorDesc().SetDataType(input[kAddFirstInput]->GetTensorDesc().GetDataType());
+  output_ptr->MutableTensorDesc().SetShape(GeShape(info.output_shape));
   v_output.push_back(output_ptr);
 
   return SUCCESS;
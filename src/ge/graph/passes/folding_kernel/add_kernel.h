@@ -24,9 +24,6 @@
 namespace ge {
 class AddKernel: public Kernel {
  public:
-  template <typename T>
-  bool OverflowCheck(const T &x, const T &y, DataType data_type);
-
   template <typename InT>
   Status BCastAdd(const OpDescPtr &op_desc_ptr,
                   const std::vector<ConstGeTensorPtr> &input,
@@ -24,7 +24,7 @@
 #include "common/op/ge_op_utils.h"
 #include "common/types.h"
 #include "framework/common/debug/ge_log.h"
-#include "graph/passes/folding_kernel/kernel_utils.h"
+#include "graph/passes/folding_kernel/folding_compute.h"
 #include "graph/utils/type_utils.h"
 #include "inc/kernel_factory.h"
 
@@ -36,6 +36,34 @@ const size_t kFloorDivTensorShapeIsEmpty = 0;
 const size_t kFloorDivInputSize = 2;
 const std::set<DataType> kFloorDivSupportedType = {DT_FLOAT,  DT_DOUBLE, DT_UINT8, DT_INT8,
                                                    DT_UINT16, DT_INT16,  DT_INT32, DT_INT64};
+
+template <typename T>
+struct FloorDivFunc {
+  T operator()(const T &x_i, const T &y_i) const {
+    if ((x_i < static_cast<T>(0)) != (y_i < static_cast<T>(0))) {
+      T abs_x_i = std::abs(x_i);
+      T abs_y_i = std::abs(y_i);
+      return static_cast<T>(static_cast<int32_t>(-(abs_x_i + abs_y_i - 1) / abs_y_i));
+    } else {
+      return static_cast<T>(static_cast<int32_t>(x_i / y_i));
+    }
+  }
+};
+
+template <typename T>
+struct ZeroDivisorCheck {
+  bool operator()(const T &, const T &y_i) const { return y_i == 0; }
+};
+
+template <>
+struct ZeroDivisorCheck<float> {
+  bool operator()(const float &, const float &y_i) const { return fabs(y_i) < FLT_EPSILON; }
+};
+
+template <>
+struct ZeroDivisorCheck<double> {
+  bool operator()(const double &, const double &y_i) const { return fabs(y_i) < DBL_EPSILON; }
+};
 }  // namespace
 Status FloorDivKernel::FloorDivCheck(const OpDescPtr &op_desc_ptr,
                                      const std::vector<ge::ConstGeTensorPtr> &input) const {
@@ -109,106 +137,20 @@ void FloorDivKernel::ShapeCal(const std::vector<ge::ConstGeTensorPtr> &input, Ge
   output_ptr->MutableTensorDesc().SetShape(GeShape(output_dims));
 }
 
-template <typename T>
-T FloorDivKernel::DivCal(const T &x_i, const T &y_i) {
-  if ((x_i < static_cast<T>(0)) != (y_i < static_cast<T>(0))) {
-    T abs_x_i = std::abs(x_i);
-    T abs_y_i = std::abs(y_i);
-    return static_cast<T>(static_cast<int32_t>(-(abs_x_i + abs_y_i - 1) / abs_y_i));
-  } else {
-    return static_cast<T>(static_cast<int32_t>(x_i / y_i));
-  }
-}
-
-template <typename T>
-bool FloorDivKernel::ZeroCheck(const T &element, DataType data_type) {
-  bool result = false;
-  if (data_type == DT_UINT8 || data_type == DT_INT8 || data_type == DT_UINT16 || data_type == DT_INT16 ||
-      data_type == DT_INT32 || data_type == DT_INT64) {
-    result = (element == 0);
-  } else if (data_type == DT_FLOAT) {
-    result = (fabs(element) < FLT_EPSILON);
-  } else if (data_type == DT_DOUBLE) {
-    result = (fabs(element) < DBL_EPSILON);
-  }
-  return result;
-}
-
-template <typename T>
-Status FloorDivKernel::DataCalBroadcast(const T &x, const T &y, size_t num_x, size_t num_y, DataType data_type,
-                                        GeTensorPtr output_ptr) {
-  size_t data_num = (num_x > num_y) ? num_x : num_y;
-  unique_ptr<T[]> buf(new (std::nothrow) T[data_num]());
-  if (buf == nullptr) {
-    GELOGE(MEMALLOC_FAILED, "new buf failed");
-    return INTERNAL_ERROR;
-  }
-
-  if (num_x > num_y) {
-    if (ZeroCheck<T>(y, data_type)) {
-      GELOGE(PARAM_INVALID, "The divisor of FloorDiv con not be zero");
-      return PARAM_INVALID;
-    }
-    for (size_t i = 0; i < num_x; ++i) {
-      buf[i] = DivCal<T>((&x)[i], y);
-    }
-  } else {
-    for (size_t i = 0; i < num_y; ++i) {
-      if (ZeroCheck<T>((&y)[i], data_type)) {
-        GELOGE(PARAM_INVALID, "The divisor of FloorDiv con not be zero");
-        return PARAM_INVALID;
-      }
-      buf[i] = DivCal<T>(x, (&y)[i]);
-    }
-  }
-  if (output_ptr->SetData(reinterpret_cast<uint8_t *>(buf.get()), data_num * sizeof(T)) != GRAPH_SUCCESS) {
-    GELOGE(PARAM_INVALID, "set data failed");
-    return PARAM_INVALID;
-  }
-
-  return SUCCESS;
-}
-
 template <typename T>
 Status FloorDivKernel::DataCal(const std::vector<ConstGeTensorPtr> &input, GeTensorPtr output_ptr) {
-  ConstGeTensorPtr x_tensor = input.at(kFloorDivInputX);
-  ConstGeTensorPtr y_tensor = input.at(kFloorDivInputY);
-  GE_CHECK_NOTNULL(x_tensor);
-  GE_CHECK_NOTNULL(y_tensor);
-  T *x = const_cast<T *>(reinterpret_cast<const T *>(x_tensor->GetData().GetData()));
-  T *y = const_cast<T *>(reinterpret_cast<const T *>(y_tensor->GetData().GetData()));
-  if (x == nullptr || y == nullptr) {
-    GELOGE(PARAM_INVALID, "Input tensor is nullptr.");
+  // x and y are of the same shape, or one of them is a scalar
+  std::vector<T> buf;
+  BroadcastInfo info;
+  Status ret = FoldingCompute::BroadcastCompute<T, T>(input.at(kFloorDivInputX), input.at(kFloorDivInputY),
+                                                      FloorDivFunc<T>(), ZeroDivisorCheck<T>(), buf, info);
+  if (ret != SUCCESS) {
+    GELOGE(PARAM_INVALID, "The divisor of FloorDiv con not be zero, or the inputs do not match");
     return PARAM_INVALID;
   }
-
-  size_t data_num_x = x_tensor->GetData().size() / sizeof(T);
-  size_t data_num_y = y_tensor->GetData().size() / sizeof(T);
-  DataType data_type = x_tensor->GetTensorDesc().GetDataType();
-  if (x_tensor->GetTensorDesc().GetShape().GetDimNum() == y_tensor->GetTensorDesc().GetShape().GetDimNum()) {
-    // x and y are both scalars or vector, no need broadcast
-    unique_ptr<T[]> buf(new (std::nothrow) T[data_num_x]());
-    if (buf == nullptr) {
-      GELOGE(MEMALLOC_FAILED, "new buf failed");
-      return INTERNAL_ERROR;
-    }
-
-    for (size_t i = 0; i < data_num_x; ++i) {
-      if (ZeroCheck<T>(y[i], data_type)) {
-        GELOGE(PARAM_INVALID, "The divisor of FloorDiv con not be zero");
-        return PARAM_INVALID;
-      }
-      buf[i] = DivCal<T>(x[i], y[i]);
-    }
-    if (output_ptr->SetData(reinterpret_cast<uint8_t *>(buf.get()), data_num_x * sizeof(T)) != GRAPH_SUCCESS) {
-      GELOGE(PARAM_INVALID, "set data failed");
-      return PARAM_INVALID;
-    }
-  } else {
-    // x-y is vector-scalar, need broadcast
-    if (DataCalBroadcast<T>(*x, *y, data_num_x, data_num_y, data_type, output_ptr) != SUCCESS) {
-      return PARAM_INVALID;
-    }
+  if (output_ptr->SetData(reinterpret_cast<uint8_t *>(buf.data()), buf.size() * sizeof(T)) != GRAPH_SUCCESS) {
+    GELOGE(PARAM_INVALID, "set data failed");
+    return PARAM_INVALID;
   }
   return SUCCESS;
 }
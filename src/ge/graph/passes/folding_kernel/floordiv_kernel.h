@@ -31,13 +31,6 @@ class FloorDivKernel : public Kernel {
   Status FloorDivCheck(const OpDescPtr &op_desc_ptr, const std::vector<ConstGeTensorPtr> &input) const;
   void ShapeCal(const std::vector<ConstGeTensorPtr> &input, GeTensorPtr output_ptr);
   template <typename T>
-  T DivCal(const T &x_i, const T &y_i);
-  template <typename T>
-  bool ZeroCheck(const T &element, DataType data_type);
-  template <typename T>
-  Status DataCalBroadcast(const T &x, const T &y, size_t num_x, size_t num_y, DataType data_type,
-                          GeTensorPtr output_ptr);
-  template <typename T>
   Status DataCal(const std::vector<ConstGeTensorPtr> &input, ge::GeTensorPtr output_ptr);
   Status ComputeByDataType(DataType data_type, const std::vector<ConstGeTensorPtr> &input, GeTensorPtr output_ptr);
 
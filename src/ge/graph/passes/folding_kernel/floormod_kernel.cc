@@ -23,7 +23,7 @@
 #include "common/util.h"
 #include "framework/common/debug/ge_log.h"
 #include "framework/common/ge_inner_error_codes.h"
-#include "graph/common/bcast.h"
+#include "graph/passes/folding_kernel/folding_compute.h"
 #include "graph/utils/type_utils.h"
 #include "inc/kernel_factory.h"
 namespace ge {
@@ -46,43 +46,28 @@ T FloorDiv(T const &x, T const &y) {
   }
 }
 
+// mod(x,y) equals to x - y * floor(x/y)
 template <typename T>
-Status CheckYIsZero(T const &y, DataType &type) {
-  switch (type) {
-    case DT_INT32:
-      if (y == static_cast<T>(0)) {
-        GELOGE(INTERNAL_ERROR, "CheckYIsZero failed, y is zero.");
-        return INTERNAL_ERROR;
-      }
-      break;
-    default:
-      return INTERNAL_ERROR;
-  }
-  return SUCCESS;
-}
+struct FloorModFunc {
+  T operator()(const T &a, const T &b) const { return (a - b * FloorDiv(a, b)); }
+};
 
-// mod(x,y) equals to x - y * floor(x/y)
-#define DEFINE_FUNC_BY_TYPE(TYPE)                                                         \
-  std::function<TYPE(TYPE const &, TYPE const &, DataType &, Status &)> func_##TYPE = []( \
-      TYPE const &a, TYPE const &b, DataType &type, Status &ret) -> TYPE {                \
-    ret = CheckYIsZero(b, type);                                                          \
-    if (ret != SUCCESS) {                                                                 \
-      return static_cast<TYPE>(0);                                                        \
-    }                                                                                     \
-    return (a - b * FloorDiv(a, b));                                                      \
-  };
-
-#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                           \
-  case DTYPE:                                                         \
-    ret = bcast.BCastComputeCheck(input, y_data_##TYPE, func_##TYPE); \
+template <typename T>
+struct ZeroDivisorCheck {
+  bool operator()(const T &, const T &b) const { return b == static_cast<T>(0); }
+};
+
+#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                                                            \
+  case DTYPE:                                                                                          \
+    ret = FoldingCompute::BroadcastCompute<TYPE, TYPE>(input[kFloorModInputX], input[kFloorModInputY], \
+                                                       FloorModFunc<TYPE>(), ZeroDivisorCheck<TYPE>(), \
+                                                       y_data_##TYPE, info);                           \
     break;
 
 #define SET_OUTPUT(DTYPE, TYPE)                                                                                  \
   case DTYPE:                                                                                                    \
     (void)output_ptr->SetData(reinterpret_cast<uint8_t *>(y_data_##TYPE.data()), y_data_##TYPE.size() * length); \
     break;
-
-DEFINE_FUNC_BY_TYPE(int32_t)
 }  // namespace
 
 Status FloorModKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<ConstGeTensorPtr> &input,
@@ -99,7 +84,7 @@ Status FloorModKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<Co
 
   std::vector<int32_t> y_data_int32_t;
   DataType data_type = input[kFloorModInputX]->GetTensorDesc().GetDataType();
-  BCast bcast;
+  BroadcastInfo info;
   switch (data_type) {
     SET_BCAST_COMPUTE_CASE(DT_INT32, int32_t)
     default:
@@ -108,7 +93,7 @@ Status FloorModKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<Co
   }
 
   if (ret != SUCCESS) {
-    GELOGW("BCastCompute fail, data_type: %s, ret: %s", TypeUtils::DataTypeToSerialString(data_type).c_str(),
+    GELOGW("BroadcastCompute fail, data_type: %s, ret: %s", TypeUtils::DataTypeToSerialString(data_type).c_str(),
            GET_ERRORNO_STR(ret).c_str());
     return NOT_CHANGED;
   }
@@ -125,7 +110,7 @@ Status FloorModKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<Co
     return NOT_CHANGED;
   }
 
-  output_ptr->MutableTensorDesc().SetShape(GeShape(bcast.GetOutputShape()));
+  output_ptr->MutableTensorDesc().SetShape(GeShape(info.output_shape));
   // only return GRAPH_SUCCESS here
   switch (data_type) {
     SET_OUTPUT(DT_INT32, int32_t)
@@ -0,0 +1,106 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "graph/passes/folding_kernel/folding_compute.h"
+
+#include "common/task_executor.h"
+#include "framework/common/util.h"
+
+namespace ge {
+namespace {
+// outputs of fewer elements are computed on the calling thread
+const int64_t kParallelElementNum = 128 * 1024;
+const size_t kParallelGrainSize = 32 * 1024;
+}  // namespace
+
+Status FoldingCompute::GetBroadcastInfo(const std::vector<int64_t> &x_dims, const std::vector<int64_t> &y_dims,
+                                        BroadcastInfo &info) {
+  info = BroadcastInfo();
+  size_t rank = std::max(x_dims.size(), y_dims.size());
+  info.element_num = 1;
+  info.x_element_num = 1;
+  info.y_element_num = 1;
+  // the merged dims and whether x and y are broadcast on them
+  std::vector<bool> x_broadcast;
+  std::vector<bool> y_broadcast;
+  for (size_t i = 0; i < rank; ++i) {
+    int64_t x_dim = (i + x_dims.size() < rank) ? 1 : x_dims[i + x_dims.size() - rank];
+    int64_t y_dim = (i + y_dims.size() < rank) ? 1 : y_dims[i + y_dims.size() - rank];
+    if ((x_dim < 0) || (y_dim < 0)) {
+      GELOGW("Broadcast of unknown dims %ld and %ld is not supported.", x_dim, y_dim);
+      return PARAM_INVALID;
+    }
+    if ((x_dim != y_dim) && (x_dim != 1) && (y_dim != 1)) {
+      GELOGW("Dims %ld and %ld of the shapes are not compatible according to the broadcasting rule.", x_dim, y_dim);
+      return PARAM_INVALID;
+    }
+    int64_t output_dim = (x_dim == 1) ? y_dim : x_dim;
+    info.output_shape.push_back(output_dim);
+    if (!CheckInt64MulOverflow(info.element_num, output_dim)) {
+      GELOGW("Element num of the output overflows, dim %ld.", output_dim);
+      return PARAM_INVALID;
+    }
+    info.element_num *= output_dim;
+    info.x_element_num *= x_dim;
+    info.y_element_num *= y_dim;
+    if (output_dim == 1) {
+      continue;
+    }
+
+    bool x_broadcast_i = (x_dim == 1);
+    bool y_broadcast_i = (y_dim == 1);
+    if (!info.dims.empty() && (x_broadcast.back() == x_broadcast_i) && (y_broadcast.back() == y_broadcast_i)) {
+      info.dims.back() *= output_dim;
+    } else {
+      info.dims.push_back(output_dim);
+      x_broadcast.push_back(x_broadcast_i);
+      y_broadcast.push_back(y_broadcast_i);
+    }
+  }
+
+  if (info.dims.empty()) {
+    info.dims.push_back(1);
+    x_broadcast.push_back(true);
+    y_broadcast.push_back(true);
+  }
+  size_t merged_rank = info.dims.size();
+  info.x_strides.resize(merged_rank);
+  info.y_strides.resize(merged_rank);
+  int64_t x_stride = 1;
+  int64_t y_stride = 1;
+  for (size_t i = merged_rank; i > 0; --i) {
+    info.x_strides[i - 1] = x_broadcast[i - 1] ? 0 : x_stride;
+    info.y_strides[i - 1] = y_broadcast[i - 1] ? 0 : y_stride;
+    x_stride *= x_broadcast[i - 1] ? 1 : info.dims[i - 1];
+    y_stride *= y_broadcast[i - 1] ? 1 : info.dims[i - 1];
+  }
+  return SUCCESS;
+}
+
+Status FoldingCompute::ParallelFor(int64_t num, const std::function<Status(int64_t, int64_t)> &func) {
+  if (num <= 0) {
+    return SUCCESS;
+  }
+  if (num < kParallelElementNum) {
+    return func(0, num);
+  }
+  return TaskExecutor::Instance().ParallelFor(static_cast<size_t>(num), kParallelGrainSize,
+                                              [&func](size_t begin, size_t end) -> Status {
+                                                return func(static_cast<int64_t>(begin), static_cast<int64_t>(end));
+                                              });
+}
+}  // namespace ge
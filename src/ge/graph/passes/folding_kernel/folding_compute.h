@@ -0,0 +1,194 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GE_GRAPH_PASSES_FOLDING_KERNEL_FOLDING_COMPUTE_H_
+#define GE_GRAPH_PASSES_FOLDING_KERNEL_FOLDING_COMPUTE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "common/ge_inner_error_codes.h"
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/debug/log.h"
+#include "graph/ge_attr_value.h"
+#include "graph/ge_tensor.h"
+
+namespace ge {
+///
+/// Broadcast of two inputs by the numpy rule. The output dims of size 1 are dropped and the neighbouring dims an input
+/// is broadcast on in the same way are merged, so most folds run over one or two dims. The strides are in elements,
+/// 0 along the dims an input is broadcast on.
+///
+struct BroadcastInfo {
+  std::vector<int64_t> output_shape;
+  int64_t element_num = 0;
+  int64_t x_element_num = 0;
+  int64_t y_element_num = 0;
+  std::vector<int64_t> dims;
+  std::vector<int64_t> x_strides;
+  std::vector<int64_t> y_strides;
+};
+
+///
+/// Elementwise compute of the folding kernels. The innermost dim runs in blocks through loops specialized on whether
+/// each input moves, which the compiler vectorizes, and the large outputs are split over the task executor.
+///
+class FoldingCompute {
+ public:
+  FoldingCompute() = delete;
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief broadcast the shapes of two inputs
+  /// @return PARAM_INVALID if a dim is negative or the shapes are not compatible
+  ///
+  static Status GetBroadcastInfo(const std::vector<int64_t> &x_dims, const std::vector<int64_t> &y_dims,
+                                 BroadcastInfo &info);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief run func on the ranges [begin, end) of [0, num), on the task executor when num is large
+  /// @return Status the failure of the first range that failed, SUCCESS if none
+  ///
+  static Status ParallelFor(int64_t num, const std::function<Status(int64_t, int64_t)> &func);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief compute output[i] = func(x, y) over the broadcast of the inputs of InT
+  /// @param [in] is_invalid true for the inputs the fold gives up on, such as an overflow or a zero divisor. A block
+  ///        of elements is checked before any of them is computed, so func never gets the inputs rejected
+  /// @param [out] output the elements of the output
+  /// @param [out] info the broadcast, output_shape is the shape of the output
+  /// @return PARAM_INVALID if the shapes or the data sizes do not match, or any input is invalid
+  ///
+  template <typename InT, typename OutT, typename Func, typename CheckFunc>
+  static Status BroadcastCompute(const ConstGeTensorPtr &x, const ConstGeTensorPtr &y, const Func &func,
+                                 const CheckFunc &is_invalid, std::vector<OutT> &output, BroadcastInfo &info) {
+    GE_CHECK_NOTNULL(x);
+    GE_CHECK_NOTNULL(y);
+    Status ret = GetBroadcastInfo(x->GetTensorDesc().GetShape().GetDims(), y->GetTensorDesc().GetShape().GetDims(),
+                                  info);
+    if (ret != SUCCESS) {
+      return ret;
+    }
+    if ((x->GetData().size() / sizeof(InT) < static_cast<size_t>(info.x_element_num)) ||
+        (y->GetData().size() / sizeof(InT) < static_cast<size_t>(info.y_element_num))) {
+      GELOGW("Data size of inputs %zu and %zu are less than the shapes of %ld and %ld elements.", x->GetData().size(),
+             y->GetData().size(), info.x_element_num, info.y_element_num);
+      return PARAM_INVALID;
+    }
+
+    output.resize(static_cast<size_t>(info.element_num));
+    const InT *x_data = reinterpret_cast<const InT *>(x->GetData().data());
+    const InT *y_data = reinterpret_cast<const InT *>(y->GetData().data());
+    OutT *output_data = output.data();
+    return ParallelFor(info.element_num, [&](int64_t begin, int64_t end) -> Status {
+      return ComputeRange<InT, OutT>(info, x_data, y_data, output_data, begin, end, func, is_invalid);
+    });
+  }
+
+  template <typename InT, typename OutT, typename Func>
+  static Status BroadcastCompute(const ConstGeTensorPtr &x, const ConstGeTensorPtr &y, const Func &func,
+                                 std::vector<OutT> &output, BroadcastInfo &info) {
+    return BroadcastCompute<InT, OutT>(x, y, func, NoCheck<InT>(), output, info);
+  }
+
+ private:
+  // elements checked and computed at a time, small enough to stay in the cache between the two passes
+  static const int64_t kBlockSize = 1024;
+
+  template <typename T>
+  struct NoCheck {
+    bool operator()(const T &, const T &) const { return false; }
+  };
+
+  // x and y move by kXStep and kYStep, 0 or 1, with the output
+  template <int64_t kXStep, int64_t kYStep, typename InT, typename OutT, typename Func, typename CheckFunc>
+  static bool ComputeBlocks(const InT *x, const InT *y, OutT *output, int64_t num, const Func &func,
+                            const CheckFunc &is_invalid) {
+    for (int64_t begin = 0; begin < num; begin += kBlockSize) {
+      int64_t end = std::min(begin + kBlockSize, num);
+      bool invalid = false;
+      for (int64_t i = begin; i < end; ++i) {
+        invalid = invalid | is_invalid(x[i * kXStep], y[i * kYStep]);
+      }
+      if (invalid) {
+        return false;
+      }
+      for (int64_t i = begin; i < end; ++i) {
+        output[i] = func(x[i * kXStep], y[i * kYStep]);
+      }
+    }
+    return true;
+  }
+
+  template <typename InT, typename OutT, typename Func, typename CheckFunc>
+  static Status ComputeRange(const BroadcastInfo &info, const InT *x, const InT *y, OutT *output, int64_t begin,
+                             int64_t end, const Func &func, const CheckFunc &is_invalid) {
+    size_t rank = info.dims.size();
+    size_t inner = rank - 1;
+    // coordinates of begin
+    std::vector<int64_t> coord(rank, 0);
+    int64_t x_offset = 0;
+    int64_t y_offset = 0;
+    int64_t index = begin;
+    for (size_t i = rank; i > 0; --i) {
+      coord[i - 1] = index % info.dims[i - 1];
+      index /= info.dims[i - 1];
+      x_offset += coord[i - 1] * info.x_strides[i - 1];
+      y_offset += coord[i - 1] * info.y_strides[i - 1];
+    }
+
+    int64_t x_step = info.x_strides[inner];
+    int64_t y_step = info.y_strides[inner];
+    for (int64_t pos = begin; pos < end;) {
+      int64_t num = std::min(info.dims[inner] - coord[inner], end - pos);
+      bool valid = false;
+      if ((x_step != 0) && (y_step != 0)) {
+        valid = ComputeBlocks<1, 1>(x + x_offset, y + y_offset, output + pos, num, func, is_invalid);
+      } else if (x_step != 0) {
+        valid = ComputeBlocks<1, 0>(x + x_offset, y + y_offset, output + pos, num, func, is_invalid);
+      } else if (y_step != 0) {
+        valid = ComputeBlocks<0, 1>(x + x_offset, y + y_offset, output + pos, num, func, is_invalid);
+      } else {
+        valid = ComputeBlocks<0, 0>(x + x_offset, y + y_offset, output + pos, num, func, is_invalid);
+      }
+      if (!valid) {
+        GELOGW("Inputs invalid to fold are found in elements [%ld, %ld).", pos, pos + num);
+        return PARAM_INVALID;
+      }
+
+      pos += num;
+      coord[inner] += num;
+      x_offset += num * x_step;
+      y_offset += num * y_step;
+      // carry to the outer dims
+      for (size_t i = inner; (i > 0) && (coord[i] == info.dims[i]); --i) {
+        x_offset += info.x_strides[i - 1] - coord[i] * info.x_strides[i];
+        y_offset += info.y_strides[i - 1] - coord[i] * info.y_strides[i];
+        coord[i] = 0;
+        ++coord[i - 1];
+      }
+    }
+    return SUCCESS;
+  }
+};
+}  // namespace ge
+
+#endif  // GE_GRAPH_PASSES_FOLDING_KERNEL_FOLDING_COMPUTE_H_
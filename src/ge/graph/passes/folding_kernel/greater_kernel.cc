@@ -25,7 +25,7 @@
 #include "common/util.h"
 #include "framework/common/debug/ge_log.h"
 #include "framework/common/ge_inner_error_codes.h"
-#include "graph/common/bcast.h"
+#include "graph/passes/folding_kernel/folding_compute.h"
 #include "graph/utils/type_utils.h"
 #include "inc/kernel_factory.h"
 
@@ -36,28 +36,16 @@ namespace ge {
 namespace {
 const size_t kGreaterInputNum = 2;
 
-#define DEFINE_FUNC_BY_TYPE(TYPE)                                                                                \
-  std::function<uint8_t(TYPE const &, TYPE const &)> func_##TYPE = [](TYPE const &a, TYPE const &b) -> uint8_t { \
-    return a > b;                                                                                                \
-  };
+template <typename T>
+struct GreaterFunc {
+  uint8_t operator()(const T &a, const T &b) const { return a > b; }
+};
 
-#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)               \
-  case DTYPE:                                             \
-    ret = bcast.BCastCompute(input, y_data, func_##TYPE); \
+#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                                                                       \
+  case DTYPE:                                                                                                     \
+    ret = FoldingCompute::BroadcastCompute<TYPE, uint8_t>(input[0], input[1], GreaterFunc<TYPE>(), y_data, info); \
     break;
 
-DEFINE_FUNC_BY_TYPE(int8_t)
-DEFINE_FUNC_BY_TYPE(int16_t)
-DEFINE_FUNC_BY_TYPE(int32_t)
-DEFINE_FUNC_BY_TYPE(int64_t)
-DEFINE_FUNC_BY_TYPE(uint8_t)
-DEFINE_FUNC_BY_TYPE(uint16_t)
-DEFINE_FUNC_BY_TYPE(uint32_t)
-DEFINE_FUNC_BY_TYPE(uint64_t)
-DEFINE_FUNC_BY_TYPE(fp16_t)
-DEFINE_FUNC_BY_TYPE(float)
-DEFINE_FUNC_BY_TYPE(double)
-DEFINE_FUNC_BY_TYPE(bool)
 }  // namespace
 
 Status GreaterKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<ConstGeTensorPtr> &input,
@@ -75,7 +63,7 @@ Status GreaterKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<Con
   std::vector<uint8_t> y_data;
   GE_CHECK_NOTNULL(input[0]);
   DataType data_type = input[0]->GetTensorDesc().GetDataType();
-  BCast bcast;
+  BroadcastInfo info;
   switch (data_type) {
     SET_BCAST_COMPUTE_CASE(DT_INT8, int8_t)
     SET_BCAST_COMPUTE_CASE(DT_INT16, int16_t)
@@ -95,7 +83,7 @@ Status GreaterKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<Con
   }
 
   if (ret != SUCCESS) {
-    GELOGW("BCastCompute fail, data_type:%s, ret:%s", TypeUtils::DataTypeToSerialString(data_type).c_str(),
+    GELOGW("BroadcastCompute fail, data_type:%s, ret:%s", TypeUtils::DataTypeToSerialString(data_type).c_str(),
            GET_ERRORNO_STR(ret).c_str());
     return NOT_CHANGED;
   }
@@ -107,7 +95,7 @@ Status GreaterKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<Con
     return MEMALLOC_FAILED;
   }
 
-  output_ptr->MutableTensorDesc().SetShape(GeShape(bcast.GetOutputShape()));
+  output_ptr->MutableTensorDesc().SetShape(GeShape(info.output_shape));
   // only return GRAPH_SUCCESS here
   GE_CHK_STATUS_RET(output_ptr->SetData(y_data));
   output_ptr->MutableTensorDesc().SetDataType(DT_BOOL);
@@ -17,6 +17,7 @@
 #ifndef GE_GRAPH_PASSES_FOLDING_KERNEL_KERNEL_UTILS_H_
 #define GE_GRAPH_PASSES_FOLDING_KERNEL_KERNEL_UTILS_H_
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -49,15 +50,14 @@ class KernelUtils {
         return PARAM_INVALID;
       }
 
-      std::unique_ptr<T[]> buf(new (std::nothrow) T[data_num]());
+      // written once by the fill, which the compiler turns into wide stores
+      std::unique_ptr<T[]> buf(new (std::nothrow) T[data_num]);
       if (buf == nullptr) {
         GELOGE(MEMALLOC_FAILED, "new sizeof(T) * data_num(%ld) memory failed", sizeof(T) * data_num);
         return MEMALLOC_FAILED;
       }
 
-      for (int64_t i = 0; i < data_num; ++i) {
-        buf[i] = value;
-      }
+      std::fill_n(buf.get(), data_num, value);
       Status ret = output->SetData(reinterpret_cast<uint8_t *>(buf.get()), data_num * sizeof(T));
       if (ret != SUCCESS) {
         GELOGE(ret, " buf must not be null.");
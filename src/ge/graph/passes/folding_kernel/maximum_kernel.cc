@@ -25,7 +25,7 @@
 #include "common/util.h"
 #include "framework/common/debug/ge_log.h"
 #include "framework/common/ge_inner_error_codes.h"
-#include "graph/common/bcast.h"
+#include "graph/passes/folding_kernel/folding_compute.h"
 #include "graph/utils/type_utils.h"
 #include "inc/kernel_factory.h"
 
@@ -38,14 +38,15 @@ const size_t kMaximumFirstOutput = 0;
 const std::set<DataType> kMaximumSupportedType = {DT_FLOAT, DT_FLOAT16, DT_INT8,   DT_INT16,  DT_UINT16, DT_UINT8,
                                                   DT_INT32, DT_INT64,   DT_UINT32, DT_UINT64, DT_DOUBLE};
 
-#define DEFINE_FUNC_BY_TYPE(TYPE)                                                                          \
-  std::function<TYPE(TYPE const &, TYPE const &)> func_##TYPE = [](TYPE const &a, TYPE const &b) -> TYPE { \
-    return (a > b ? a : b);                                                                                \
-  };
+template <typename T>
+struct MaximumFunc {
+  T operator()(const T &a, const T &b) const { return (a > b ? a : b); }
+};
 
-#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                      \
-  case DTYPE:                                                    \
-    ret = bcast.BCastCompute(input, y_data_##TYPE, func_##TYPE); \
+#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                                                                   \
+  case DTYPE:                                                                                                 \
+    ret = FoldingCompute::BroadcastCompute<TYPE, TYPE>(input[kMaximumFirstInput], input[kMaximumSecondInput], \
+                                                       MaximumFunc<TYPE>(), y_data_##TYPE, info);             \
     break;
 
 #define SET_OUTPUT(DTYPE, TYPE)                                                                                  \
@@ -56,17 +57,6 @@ const std::set<DataType> kMaximumSupportedType = {DT_FLOAT, DT_FLOAT16, DT_INT8,
     }                                                                                                            \
     break;
 
-DEFINE_FUNC_BY_TYPE(int8_t)
-DEFINE_FUNC_BY_TYPE(int16_t)
-DEFINE_FUNC_BY_TYPE(int32_t)
-DEFINE_FUNC_BY_TYPE(int64_t)
-DEFINE_FUNC_BY_TYPE(uint8_t)
-DEFINE_FUNC_BY_TYPE(uint16_t)
-DEFINE_FUNC_BY_TYPE(uint32_t)
-DEFINE_FUNC_BY_TYPE(uint64_t)
-DEFINE_FUNC_BY_TYPE(fp16_t)
-DEFINE_FUNC_BY_TYPE(float)
-DEFINE_FUNC_BY_TYPE(double)
 }  // namespace
 
 Status MaximumKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<ConstGeTensorPtr> &input,
@@ -98,7 +88,7 @@ Status MaximumKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<Con
     return FAILED;
   }
   DataType data_type = input[kMaximumFirstInput]->GetTensorDesc().GetDataType();
-  BCast bcast;
+  BroadcastInfo info;
   switch (data_type) {
     SET_BCAST_COMPUTE_CASE(DT_INT8, int8_t)
     SET_BCAST_COMPUTE_CASE(DT_INT16, int16_t)
@@ -117,7 +107,7 @@ Status MaximumKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<Con
   }
 
   if (ret != SUCCESS) {
-    GELOGW("BCastCompute fail, data_type: %s, ret: %s", TypeUtils::DataTypeToSerialString(data_type).c_str(),
+    GELOGW("BroadcastCompute fail, data_type: %s, ret: %s", TypeUtils::DataTypeToSerialString(data_type).c_str(),
            GET_ERRORNO_STR(ret).c_str());
     return NOT_CHANGED;
   }
@@ -134,7 +124,7 @@ Status MaximumKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<Con
     return MEMALLOC_FAILED;
   }
 
-  output_ptr->MutableTensorDesc().SetShape(GeShape(bcast.GetOutputShape()));
+  output_ptr->MutableTensorDesc().SetShape(GeShape(info.output_shape));
   // only return GRAPH_SUCCESS here
   switch (data_type) {
     SET_OUTPUT(DT_INT8, int8_t)
@@ -20,12 +20,11 @@
 #include <set>
 
 #include "common/debug/log.h"
-#include "common/math/math_util.h"
 #include "common/types.h"
 #include "common/util.h"
 #include "framework/common/debug/ge_log.h"
 #include "framework/common/ge_inner_error_codes.h"
-#include "graph/common/bcast.h"
+#include "graph/passes/folding_kernel/folding_compute.h"
 #include "graph/utils/type_utils.h"
 #include "inc/kernel_factory.h"
 
@@ -34,38 +33,31 @@ namespace {
 const std::set<DataType> mul_supported_type = {DT_INT32, DT_UINT32};
 
 template <typename T>
-Status IsOverflow(T const &a, T const &b, DataType &type) {
-  switch (type) {
-    case DT_INT32:
-      return CheckInt32MulOverflow(a, b);
-    case DT_UINT32:
-      return CheckUint32MulOverflow(a, b);
-    default:
-      return FAILED;
+struct MulFunc {
+  T operator()(const T &a, const T &b) const { return a * b; }
+};
+
+// exact, the products of 32 bits fit in 64 bits
+struct MulOverflowCheck {
+  bool operator()(const int32_t &a, const int32_t &b) const {
+    int64_t product = static_cast<int64_t>(a) * static_cast<int64_t>(b);
+    return (product > INT32_MAX) | (product < INT32_MIN);
   }
-}
+  bool operator()(const uint32_t &a, const uint32_t &b) const {
+    return static_cast<uint64_t>(a) * static_cast<uint64_t>(b) > UINT32_MAX;
+  }
+};
 
-#define DEFINE_FUNC_WITH_STATUS_BY_TYPE(TYPE)                                             \
-  std::function<TYPE(TYPE const &, TYPE const &, DataType &, Status &)> func_##TYPE = []( \
-      TYPE const &a, TYPE const &b, DataType &type, Status &ret) -> TYPE {                \
-    ret = IsOverflow(a, b, type);                                                         \
-    if (ret != SUCCESS) {                                                                 \
-      return static_cast<TYPE>(0);                                                        \
-    }                                                                                     \
-    return a * b;                                                                         \
-  };
-
-#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                           \
-  case DTYPE:                                                         \
-    ret = bcast.BCastComputeCheck(input, y_data_##TYPE, func_##TYPE); \
+#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                                                                     \
+  case DTYPE:                                                                                                   \
+    ret = FoldingCompute::BroadcastCompute<TYPE, TYPE>(input[0], input[1], MulFunc<TYPE>(), MulOverflowCheck(), \
+                                                       y_data_##TYPE, info);                                    \
     break;
 
 #define SET_OUTPUT(DTYPE, TYPE)                                                                                  \
   case DTYPE:                                                                                                    \
     (void)output_ptr->SetData(reinterpret_cast<uint8_t *>(y_data_##TYPE.data()), y_data_##TYPE.size() * length); \
     break;
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(int32_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(uint32_t)
 }  // namespace
 
 Status MulKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<ConstGeTensorPtr> &input,
@@ -83,7 +75,7 @@ Status MulKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<ConstGe
   std::vector<int32_t> y_data_int32_t;
   std::vector<uint32_t> y_data_uint32_t;
   DataType data_type = input[0]->GetTensorDesc().GetDataType();
-  BCast bcast;
+  BroadcastInfo info;
   switch (data_type) {
     SET_BCAST_COMPUTE_CASE(DT_INT32, int32_t)
     SET_BCAST_COMPUTE_CASE(DT_UINT32, uint32_t)
@@ -93,7 +85,7 @@ Status MulKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<ConstGe
   }
 
   if (ret != SUCCESS) {
-    GELOGW("BCastCompute fail, data_type: %s, ret: %s", TypeUtils::DataTypeToSerialString(data_type).c_str(),
+    GELOGW("BroadcastCompute fail, data_type: %s, ret: %s", TypeUtils::DataTypeToSerialString(data_type).c_str(),
            GET_ERRORNO_STR(ret).c_str());
     return NOT_CHANGED;
   }
@@ -110,7 +102,7 @@ Status MulKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<ConstGe
     return MEMALLOC_FAILED;
   }
 
-  output_ptr->MutableTensorDesc().SetShape(GeShape(bcast.GetOutputShape()));
+  output_ptr->MutableTensorDesc().SetShape(GeShape(info.output_shape));
   // only return GRAPH_SUCCESS here
   switch (data_type) {
     SET_OUTPUT(DT_INT32, int32_t)
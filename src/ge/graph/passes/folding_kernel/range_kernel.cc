@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <set>
+#include <type_traits>
 
 #include "common/debug/log.h"
 #include "common/fp16_t.h"
@@ -139,8 +140,20 @@ Status RangeKernel::GetRange(const T start, const T limit, const T delta, GeTens
     return PARAM_INVALID;
   }
 
-  int64_t size = (std::is_integral<T>::value ? ((std::abs(limit - start) + std::abs(delta) - 1) / std::abs(delta))
-                                             : std::ceil(std::abs((limit - start) / delta)));
+  // limit - start, and i * delta of the elements, may overflow T, the integers are computed modulo 2^64 and the
+  // values of the elements narrowed, as they are all between start and limit
+  uint64_t base = 0;
+  uint64_t step = 0;
+  int64_t size = 0;
+  if (std::is_integral<T>::value) {
+    base = static_cast<uint64_t>(start);
+    step = static_cast<uint64_t>(delta);
+    uint64_t distance = (delta > 0) ? (static_cast<uint64_t>(limit) - base) : (base - static_cast<uint64_t>(limit));
+    uint64_t abs_step = (delta > 0) ? step : (0UL - step);
+    size = static_cast<int64_t>(distance / abs_step + ((distance % abs_step) != 0 ? 1 : 0));
+  } else {
+    size = std::ceil(std::abs((limit - start) / delta));
+  }
   output->MutableTensorDesc().SetShape(GeShape());  // when size is 0
 
   if (size > 0) {
@@ -150,10 +163,18 @@ Status RangeKernel::GetRange(const T start, const T limit, const T delta, GeTens
       return MEMALLOC_FAILED;
     }
 
-    T val = start;
-    for (int64_t i = 0; i < size; ++i) {
-      buf[i] = val;
-      val += delta;
+    if (std::is_integral<T>::value) {
+      // the same values as the running sum, without the dependency between the elements
+      for (int64_t i = 0; i < size; ++i) {
+        buf[i] = static_cast<T>(base + static_cast<uint64_t>(i) * step);
+      }
+    } else {
+      // the rounding of the running sum is kept
+      T val = start;
+      for (int64_t i = 0; i < size; ++i) {
+        buf[i] = val;
+        val += delta;
+      }
     }
     if (output->SetData(reinterpret_cast<uint8_t *>(buf.get()), size * sizeof(T)) != GRAPH_SUCCESS) {
       GELOGW("GetRange: SetData failed");
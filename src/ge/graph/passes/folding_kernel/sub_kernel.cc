@@ -21,7 +21,7 @@
 #include "common/debug/log.h"
 #include "common/fp16_t.h"
 #include "common/op/ge_op_utils.h"
-#include "graph/common/bcast.h"
+#include "graph/passes/folding_kernel/folding_compute.h"
 #include "graph/utils/type_utils.h"
 #include "inc/kernel_factory.h"
 
@@ -33,14 +33,15 @@ const size_t kSubFirstOutput = 0;
 const size_t kSubOutputSize = 1;
 const size_t kSubInputSize = 2;
 
-#define DEFINE_FUNC_BY_TYPE(TYPE)                                                                          \
-  std::function<TYPE(TYPE const &, TYPE const &)> func_##TYPE = [](TYPE const &a, TYPE const &b) -> TYPE { \
-    return a - b;                                                                                          \
-  };
+template <typename T>
+struct SubFunc {
+  T operator()(const T &a, const T &b) const { return a - b; }
+};
 
-#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                      \
-  case DTYPE:                                                    \
-    ret = bcast.BCastCompute(input, y_data_##TYPE, func_##TYPE); \
+#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                                                                            \
+  case DTYPE:                                                                                                          \
+    ret = FoldingCompute::BroadcastCompute<TYPE, TYPE>(input[kSubFirstInput], input[kSubSecondInput], SubFunc<TYPE>(), \
+                                                       y_data_##TYPE, info);                                           \
     break;
 
 #define SET_OUTPUT(DTYPE, TYPE)                                                                                  \
@@ -48,16 +49,6 @@ const size_t kSubInputSize = 2;
     (void)output_ptr->SetData(reinterpret_cast<uint8_t *>(y_data_##TYPE.data()), y_data_##TYPE.size() * length); \
     break;
 
-DEFINE_FUNC_BY_TYPE(int8_t)
-DEFINE_FUNC_BY_TYPE(int16_t)
-DEFINE_FUNC_BY_TYPE(int32_t)
-DEFINE_FUNC_BY_TYPE(int64_t)
-DEFINE_FUNC_BY_TYPE(uint8_t)
-DEFINE_FUNC_BY_TYPE(uint16_t)
-DEFINE_FUNC_BY_TYPE(uint32_t)
-DEFINE_FUNC_BY_TYPE(uint64_t)
-DEFINE_FUNC_BY_TYPE(float)
-DEFINE_FUNC_BY_TYPE(double)
 }  // namespace
 
 Status SubKernel::Compute(const ge::OpDescPtr op_desc_ptr, const std::vector<ge::ConstGeTensorPtr> &input,
@@ -89,7 +80,7 @@ Status SubKernel::Compute(const ge::OpDescPtr op_desc_ptr, const std::vector<ge:
 
   Status ret;
   DataType data_type = input[kSubFirstInput]->GetTensorDesc().GetDataType();
-  BCast bcast;
+  BroadcastInfo info;
   switch (data_type) {
     SET_BCAST_COMPUTE_CASE(DT_INT8, int8_t)
     SET_BCAST_COMPUTE_CASE(DT_INT16, int16_t)
@@ -107,7 +98,7 @@ Status SubKernel::Compute(const ge::OpDescPtr op_desc_ptr, const std::vector<ge:
   }
 
   if (ret != SUCCESS) {
-    GELOGW("BCastCompute fail, data_type:%s, ret:%s", TypeUtils::DataTypeToSerialString(data_type).c_str(),
+    GELOGW("BroadcastCompute fail, data_type:%s, ret:%s", TypeUtils::DataTypeToSerialString(data_type).c_str(),
            GET_ERRORNO_STR(ret).c_str());
     return NOT_CHANGED;
   }
@@ -125,7 +116,7 @@ Status SubKernel::Compute(const ge::OpDescPtr op_desc_ptr, const std::vector<ge:
     return NOT_CHANGED;
   }
 
-  output_ptr->MutableTensorDesc().SetShape(GeShape(bcast.GetOutputShape()));
+  output_ptr->MutableTensorDesc().SetShape(GeShape(info.output_shape));
   // only return GRAPH_SUCCESS here
   switch (data_type) {
     SET_OUTPUT(DT_INT8, int8_t)
@@ -16,6 +16,7 @@
 
 #include "inc/pass_manager.h"
 #include "common/debug/log.h"
+#include "common/tracer.h"
 #include "common/types.h"
 #include "common/util.h"
 #include "graph/utils/node_utils.h"
@@ -41,6 +42,7 @@ Status PassManager::Run(const ComputeGraphPtr &graph, vector<GraphPass *> &passe
   for (auto &pass : passes) {
     GE_CHECK_NOTNULL(pass);
 
+    GE_TRACE_SCOPE(typeid(*pass));
     Status status = pass->Run(graph);
     if (status == SUCCESS) {
       not_changed = false;
@@ -29,6 +29,8 @@
 #include "common/ge/plugin_manager.h"
 #include "common/ge/ge_util.h"
 #include "common/profiling/profiling_manager.h"
+#include "common/task_executor.h"
+#include "common/tracer.h"
 #include "graph/manager/graph_mem_allocator.h"
 #include "graph/manager/graph_var_manager.h"
 #include "runtime/kernel.h"
@@ -46,6 +48,7 @@ using Json = nlohmann::json;
 namespace ge {
 namespace {
 const int kDecimal = 10;
+const char *const kEnvTraceFile = "GE_TRACE_FILE";
 }  // namespace
 static std::shared_ptr<GELib> instancePtr_ = nullptr;
 
@@ -79,6 +82,23 @@ Status GELib::InnerInitialize(const map<string, string> &options) {
     return SUCCESS;
   }
 
+  auto thread_num_iter = options.find(OPTION_EXEC_THREAD_NUM);
+  if (thread_num_iter != options.end()) {
+    (void)TaskExecutor::Instance().SetThreadNum(
+        static_cast<uint32_t>(std::strtoul(thread_num_iter->second.c_str(), nullptr, kDecimal)));
+  }
+
+  std::string trace_file;
+  auto trace_file_iter = options.find(OPTION_EXEC_TRACE_FILE);
+  if (trace_file_iter != options.end()) {
+    trace_file = trace_file_iter->second;
+  } else if (std::getenv(kEnvTraceFile) != nullptr) {
+    trace_file = std::getenv(kEnvTraceFile);
+  }
+  if (!trace_file.empty()) {
+    Tracer::Instance().Start(trace_file);
+  }
+
   GELOGI("GE System initial.");
   Status init_system_status = SystemInitialize(options);
   if (init_system_status != SUCCESS) {
@@ -349,6 +369,11 @@ Status GELib::Finalize() {
   GELOGI("MemManager finalization.");
   MemManager::Instance().Finalize();
 
+  GELOGI("Tracer finalization.");
+  if (Tracer::Instance().Stop() != SUCCESS) {
+    GELOGW("Write the trace file failed.");
+  }
+
 #ifdef DAVINCI_CLOUD
   if (is_train_mode_) {
     GELOGI("System ShutDown.");
@@ -44,7 +44,20 @@ std::shared_ptr<domi::ModelTaskDef> GeModel::GetModelTaskDefPtr() const { return
 
 const TBEKernelStore &GeModel::GetTBEKernelStore() const { return this->tbe_kernal_store_; }
 
-Buffer GeModel::GetWeight() const { return this->weights_buffer_; }
+Buffer GeModel::GetWeight() const {
+  if (this->weight_ref_data_ != nullptr) {
+    return Buffer::CopyFrom(this->weight_ref_data_, this->weight_ref_size_);
+  }
+  return this->weights_buffer_;
+}
+
+const uint8_t *GeModel::GetWeightData() const {
+  return (this->weight_ref_data_ != nullptr) ? this->weight_ref_data_ : this->weights_buffer_.GetData();
+}
+
+size_t GeModel::GetWeightSize() const {
+  return (this->weight_ref_data_ != nullptr) ? this->weight_ref_size_ : this->weights_buffer_.GetSize();
+}
 
 std::string GeModel::GetName() const { return this->name_; }
 
@@ -62,7 +75,20 @@ void GeModel::SetTBEKernelStore(const TBEKernelStore &tbe_kernal_store) {
   this->tbe_kernal_store_ = tbe_kernal_store;
 }
 
-void GeModel::SetWeight(const Buffer &weights_buffer) { this->weights_buffer_ = weights_buffer; }
+void GeModel::SetWeight(const Buffer &weights_buffer) {
+  this->weights_buffer_ = weights_buffer;
+  ClearWeightRef();
+}
+
+void GeModel::SetWeightRef(const uint8_t *data, size_t size) {
+  this->weight_ref_data_ = data;
+  this->weight_ref_size_ = size;
+}
+
+void GeModel::ClearWeightRef() {
+  this->weight_ref_data_ = nullptr;
+  this->weight_ref_size_ = 0;
+}
 
 void GeModel::SetName(const std::string &name) { this->name_ = name; }
 
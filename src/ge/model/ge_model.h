@@ -52,6 +52,18 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeModel : public AttrHolder
   void SetTBEKernelStore(const TBEKernelStore &tbe_kernal_store);
   void SetWeight(const Buffer &weights_buffer);
 
+  ///
+  /// @ingroup ge
+  /// @brief Refer to host weights owned by the caller instead of copying them, e.g. the weights partition of a
+  ///        mapped om file. The caller keeps them alive until ClearWeightRef
+  ///
+  void SetWeightRef(const uint8_t *data, size_t size);
+  void ClearWeightRef();
+
+  // data and size of the referred weights if any, else of the weights buffer
+  const uint8_t *GetWeightData() const;
+  size_t GetWeightSize() const;
+
   void SetName(const std::string &name);
   void SetVersion(uint32_t version);
   void SetPlatformVersion(const std::string &platform_version);
@@ -80,6 +92,8 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeModel : public AttrHolder
   std::shared_ptr<domi::ModelTaskDef> task_;
   TBEKernelStore tbe_kernal_store_;
   Buffer weights_buffer_;
+  const uint8_t *weight_ref_data_ = nullptr;
+  size_t weight_ref_size_ = 0;
 
   std::string name_;
   uint32_t version_ = {0};
@@ -31,7 +31,6 @@
 #include "runtime/mem.h"
 
 namespace ge {
-static std::mutex mutex_;  // BuildGraph and RunGraph use
 
 InnerSession::InnerSession(uint64_t session_id, const std::map<string, string> &options)
     : init_flag_(false), session_id_(session_id), options_(options) {}
@@ -109,36 +108,29 @@ Status InnerSession::AddGraph(uint32_t graph_id, const Graph &graph) {
 
 Status InnerSession::RunGraph(uint32_t graph_id, const std::vector<Tensor> &inputs, std::vector<Tensor> &outputs) {
   GELOGI("[InnerSession:%lu] run graph on session, graph_id=%u.", session_id_, graph_id);
-  if (mutex_.try_lock()) {
-    std::lock_guard<std::mutex> lock(mutex_, std::adopt_lock);
-    if (!init_flag_) {
-      GELOGE(GE_SESS_INIT_FAILED, "[InnerSession:%lu] initialize failed.", session_id_);
-      return GE_SESS_INIT_FAILED;
-    }
-    UpdateThreadContext();
-    vector<GeTensor> geInputs;
-    for (auto &item : inputs) {
-      geInputs.push_back(TensorAdapter::AsGeTensor(item));
-    }
-    vector<GeTensor> geOutputs;
-    Status ret = graph_manager_.RunGraph(graph_id, geInputs, geOutputs, session_id_);
-    domi::GetContext().out_nodes_map.clear();
-    domi::GetContext().user_out_nodes.clear();
-    if (ret != SUCCESS) {
-      GELOGE(ret, "[InnerSession:%lu] run graph failed, graph_id=%u.", session_id_, graph_id);
-      return ret;
-    }
-    outputs.clear();
-    for (auto &item : geOutputs) {
-      outputs.push_back(TensorAdapter::AsTensor(item));
-    }
-
-    GELOGI("[InnerSession:%lu] run graph success, graph_id=%u.", session_id_, graph_id);
-    return SUCCESS;
-  } else {
-    GELOGE(GE_SESS_ALREADY_RUNNING, "[InnerSession:%lu] run graph failed, graph_id=%u.", session_id_, graph_id);
-    return GE_SESS_ALREADY_RUNNING;
+  // graphs of the session may run concurrently, the graph manager serializes what must not overlap
+  if (!init_flag_) {
+    GELOGE(GE_SESS_INIT_FAILED, "[InnerSession:%lu] initialize failed.", session_id_);
+    return GE_SESS_INIT_FAILED;
+  }
+  UpdateThreadContext();
+  vector<GeTensor> geInputs;
+  for (auto &item : inputs) {
+    geInputs.push_back(TensorAdapter::AsGeTensor(item));
+  }
+  vector<GeTensor> geOutputs;
+  Status ret = graph_manager_.RunGraph(graph_id, geInputs, geOutputs, session_id_);
+  if (ret != SUCCESS) {
+    GELOGE(ret, "[InnerSession:%lu] run graph failed, graph_id=%u.", session_id_, graph_id);
+    return ret;
+  }
+  outputs.clear();
+  for (auto &item : geOutputs) {
+    outputs.push_back(TensorAdapter::AsTensor(item));
   }
+
+  GELOGI("[InnerSession:%lu] run graph success, graph_id=%u.", session_id_, graph_id);
+  return SUCCESS;
 }
 
 Status InnerSession::RemoveGraph(uint32_t graph_id) {
@@ -17,6 +17,7 @@
 #ifndef GE_SESSION_INNER_SESSION_H_
 #define GE_SESSION_INNER_SESSION_H_
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <vector>
@@ -56,7 +57,7 @@ class InnerSession {
   bool IsGraphNeedRebuild(uint32_t graph_id);
 
  private:
-  bool init_flag_;
+  std::atomic<bool> init_flag_;
   uint64_t session_id_;
   std::map<string, string> options_;
   GraphManager graph_manager_;
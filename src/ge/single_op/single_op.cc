@@ -75,53 +75,69 @@ Status SingleOp::ValidateArgs(const std::vector<DataBuffer> &inputs, const std::
   return SUCCESS;
 }
 
-Status SingleOp::UpdateArgs(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs) {
-  size_t arg_index = 0;
+Status SingleOp::GetArgValue(const DataBuffer &buffer, size_t arg_index, uintptr_t &value) const {
+  auto *addr = reinterpret_cast<uint8_t *>(buffer.data);
   if (use_physical_addr_) {
-    for (auto &input : inputs) {
-      auto *addr = reinterpret_cast<uint8_t *>(input.data);
-      size_t aligned_size = GetAlignedSize(input.length);
-      auto ret = ModelUtils::ConvertVirtualAddressToPhysical(addr, aligned_size, addr);
-      if (ret != SUCCESS) {
-        GELOGE(ret, "ConvertVirtualAddressToPhysical failed. Arg index = %zu", arg_index);
-        return ret;
-      }
-      args_[arg_index++] = reinterpret_cast<uintptr_t>(addr);
+    size_t aligned_size = GetAlignedSize(buffer.length);
+    auto ret = ModelUtils::ConvertVirtualAddressToPhysical(addr, aligned_size, addr);
+    if (ret != SUCCESS) {
+      GELOGE(ret, "ConvertVirtualAddressToPhysical failed. Arg index = %zu", arg_index);
+      return ret;
     }
+  }
+  value = reinterpret_cast<uintptr_t>(addr);
+  return SUCCESS;
+}
 
-    for (auto &output : outputs) {
-      auto *addr = reinterpret_cast<uint8_t *>(output.data);
-      size_t aligned_size = GetAlignedSize(output.length);
-      auto ret = ModelUtils::ConvertVirtualAddressToPhysical(addr, aligned_size, addr);
-      if (ret != SUCCESS) {
-        GELOGE(ret, "ConvertVirtualAddressToPhysical failed. Arg index = %zu", arg_index);
-        return ret;
-      }
-      args_[arg_index++] = reinterpret_cast<uintptr_t>(addr);
-    }
-  } else {
-    for (auto &input : inputs) {
-      args_[arg_index++] = reinterpret_cast<uintptr_t>(input.data);
+void SingleOp::BuildArgPatchLayout() {
+  size_t num_args = args_.size();
+  arg_slots_.clear();
+  arg_offsets_.assign(1, 0);
+  for (size_t i = 0; i < num_args; ++i) {
+    if ((i >= arg_table_.size()) || arg_table_[i].empty()) {
+      GELOGW("found NO arg address to update for arg[%zu]", i);
+    } else {
+      arg_slots_.insert(arg_slots_.end(), arg_table_[i].begin(), arg_table_[i].end());
     }
+    arg_offsets_.emplace_back(arg_slots_.size());
+  }
+  args_patched_ = false;
+}
 
-    for (auto &output : outputs) {
-      args_[arg_index++] = reinterpret_cast<uintptr_t>(output.data);
-    }
+void SingleOp::PatchArg(size_t arg_index, uintptr_t value) {
+  // the tasks keep the addresses of the last launch, the ones given again are not written
+  if (args_patched_ && (args_[arg_index] == value)) {
+    return;
+  }
+  args_[arg_index] = value;
+  for (size_t i = arg_offsets_[arg_index]; i < arg_offsets_[arg_index + 1]; ++i) {
+    *arg_slots_[i] = value;
   }
+}
 
-  size_t num_args = arg_table_.size();
-  for (size_t i = 0; i < num_args; ++i) {
-    std::vector<uintptr_t *> &ptr_to_arg_in_tasks = arg_table_[i];
-    if (ptr_to_arg_in_tasks.empty()) {
-      GELOGW("found NO arg address to update for arg[%lu]", i);
-      continue;
-    }
+Status SingleOp::UpdateArgs(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs) {
+  if (arg_offsets_.size() != args_.size() + 1) {
+    BuildArgPatchLayout();
+  }
 
-    for (uintptr_t *arg_addr : ptr_to_arg_in_tasks) {
-      *arg_addr = args_[i];
+  size_t arg_index = 0;
+  uintptr_t value = 0;
+  for (auto &input : inputs) {
+    Status ret = GetArgValue(input, arg_index, value);
+    if (ret != SUCCESS) {
+      return ret;
     }
+    PatchArg(arg_index++, value);
   }
 
+  for (auto &output : outputs) {
+    Status ret = GetArgValue(output, arg_index, value);
+    if (ret != SUCCESS) {
+      return ret;
+    }
+    PatchArg(arg_index++, value);
+  }
+  args_patched_ = true;
   return SUCCESS;
 }
 
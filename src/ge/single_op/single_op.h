@@ -39,6 +39,9 @@ class SingleOp {
  private:
   Status ValidateArgs(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs);
   Status UpdateArgs(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs);
+  Status GetArgValue(const DataBuffer &buffer, size_t arg_index, uintptr_t &value) const;
+  void PatchArg(size_t arg_index, uintptr_t value);
+  void BuildArgPatchLayout();
 
   friend class SingleOpModel;
   rtStream_t stream_ = nullptr;
@@ -51,6 +54,12 @@ class SingleOp {
   std::vector<OpTask *> tasks_;
   std::vector<std::vector<uintptr_t *>> arg_table_;
   bool use_physical_addr_ = false;
+
+  // arg_table_ flattened, the addresses to patch of arg i are arg_slots_[arg_offsets_[i], arg_offsets_[i + 1])
+  std::vector<uintptr_t *> arg_slots_;
+  std::vector<size_t> arg_offsets_;
+  // args_ hold the values last written to the tasks
+  bool args_patched_ = false;
 };
 }  // namespace ge
 #endif  // GE_SINGLE_OP_SINGLE_OP_H_
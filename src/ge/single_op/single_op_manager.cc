@@ -23,12 +23,39 @@
 #include "framework/common/debug/ge_log.h"
 
 namespace ge {
+namespace {
+const uint32_t kThreadOpCacheBits = 6;
+const size_t kThreadOpCacheSize = 1UL << kThreadOpCacheBits;
+const uint64_t kHashMultiplier = 0x9E3779B97F4A7C15UL;
+const uint64_t kMaxCachedMemorySize = 256UL * 1024UL * 1024UL;
+
+struct ThreadOpCacheEntry {
+  uint64_t generation;
+  uintptr_t resource_id;
+  const void *key;
+  SingleOp *op;
+};
+
+// direct mapped, zeroed entries never match as the generations start from 1
+thread_local ThreadOpCacheEntry thread_op_cache[kThreadOpCacheSize];
+
+ThreadOpCacheEntry &GetThreadOpCacheEntry(uintptr_t resource_id, const void *key) {
+  uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key)) ^ (static_cast<uint64_t>(resource_id) << 1U);
+  hash *= kHashMultiplier;
+  return thread_op_cache[hash >> (64U - kThreadOpCacheBits)];
+}
+}  // namespace
+
+SingleOpManager::SingleOpManager() : allocator_(RT_MEMORY_HBM, false, kMaxCachedMemorySize) {}
+
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY
 SingleOpManager::~SingleOpManager() {
   for (auto &it : stream_resources_) {
     delete it.second;
     it.second = nullptr;
   }
+  stream_resources_.clear();
+  allocator_.Trim(0);
 }
 
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY
@@ -57,23 +84,42 @@ Status SingleOpManager::GetOpFromModel(const std::string &model_name,
     resource_id = reinterpret_cast<uintptr_t>(stream);
   }
 
+  // read before the lookups, an op found when a resource is being released is cached as stale
+  uint64_t generation = generation_.load(std::memory_order_acquire);
+  SingleOp *op = GetThreadCachedOp(resource_id, model_data.model_data, generation);
+  if (op != nullptr) {
+    *single_op = op;
+    return SUCCESS;
+  }
+
   GELOGI("GetOpFromModel in. model name = %s, resource id = 0x%lx",
          model_name.c_str(),
          static_cast<uint64_t>(resource_id));
 
-  StreamResource *res = GetResource(resource_id);
+  StreamResource *res = GetResource(resource_id, stream);
   if (res == nullptr) {
       GELOGE(MEMALLOC_FAILED, "GetResource failed");
       return MEMALLOC_FAILED;
   }
 
-  SingleOp *op = res->GetOperator(model_data.model_data);
+  std::lock_guard<std::mutex> lock(res->GetMutex());
+  op = res->GetOperator(model_data.model_data);
   if (op != nullptr) {
     GELOGD("Got operator from stream cache");
-    *single_op = op;
-    return SUCCESS;
+  } else {
+    auto ret = CreateOp(model_name, model_data, stream, resource_id, *res, op);
+    if (ret != SUCCESS) {
+      return ret;
+    }
   }
 
+  ThreadCacheOp(resource_id, model_data.model_data, generation, op);
+  *single_op = op;
+  return SUCCESS;
+}
+
+Status SingleOpManager::CreateOp(const std::string &model_name, const ModelData &model_data, void *stream,
+                                 uintptr_t resource_id, StreamResource &res, SingleOp *&single_op) {
   SingleOpModel model(model_name, model_data.model_data, model_data.model_len);
   auto ret = model.Init();
   if (ret != SUCCESS) {
@@ -88,7 +134,7 @@ Status SingleOpManager::GetOpFromModel(const std::string &model_name,
   }
 
   GELOGI("To build operator: %s", model_name.c_str());
-  ret = model.BuildOp(*res, *new_op);
+  ret = model.BuildOp(res, *new_op);
   if (ret != SUCCESS) {
     GELOGE(ret, "Build op failed. op = %s, resource id = 0x%lx, ret = %u",
            model_name.c_str(),
@@ -101,11 +147,28 @@ Status SingleOpManager::GetOpFromModel(const std::string &model_name,
 
   // stream is nullable
   new_op->SetStream(stream);
-  res->CacheOperator(model_data.model_data, new_op);
-  *single_op = new_op;
+  res.CacheOperator(model_data.model_data, new_op);
+  single_op = new_op;
   return SUCCESS;
 }
 
+SingleOp *SingleOpManager::GetThreadCachedOp(uintptr_t resource_id, const void *key, uint64_t generation) const {
+  const ThreadOpCacheEntry &entry = GetThreadOpCacheEntry(resource_id, key);
+  if ((entry.generation != generation) || (entry.resource_id != resource_id) || (entry.key != key)) {
+    return nullptr;
+  }
+  return entry.op;
+}
+
+void SingleOpManager::ThreadCacheOp(uintptr_t resource_id, const void *key, uint64_t generation,
+                                    SingleOp *single_op) const {
+  ThreadOpCacheEntry &entry = GetThreadOpCacheEntry(resource_id, key);
+  entry.generation = generation;
+  entry.resource_id = resource_id;
+  entry.key = key;
+  entry.op = single_op;
+}
+
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY
 Status SingleOpManager::ReleaseResource(void *stream) {
   auto resource_id = reinterpret_cast<uintptr_t>(stream);
@@ -115,18 +178,22 @@ Status SingleOpManager::ReleaseResource(void *stream) {
   if (it == stream_resources_.end()) {
     return SUCCESS;
   }
+  // the ops of the resource may be cached by any thread
+  (void)generation_.fetch_add(1, std::memory_order_acq_rel);
   delete it->second;
   it->second = nullptr;
   (void)stream_resources_.erase(it);
+  // the stream may be destroyed next, the blocks freed on it are not kept waiting on its events
+  allocator_.Trim(0);
   return SUCCESS;
 }
 
-StreamResource *SingleOpManager::GetResource(uintptr_t resource_id) {
+StreamResource *SingleOpManager::GetResource(uintptr_t resource_id, rtStream_t stream) {
   std::lock_guard<std::mutex> lock(mutex_);
   auto it = stream_resources_.find(resource_id);
   StreamResource *res = nullptr;
   if (it == stream_resources_.end()) {
-    res = new (std::nothrow)StreamResource();
+    res = new (std::nothrow)StreamResource(stream, allocator_);
     if (res != nullptr) {
       stream_resources_.emplace(resource_id, res);
     }
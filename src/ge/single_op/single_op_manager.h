@@ -17,10 +17,12 @@
 #ifndef GE_SINGLE_OP_SINGLE_OP_MANAGER_H_
 #define GE_SINGLE_OP_SINGLE_OP_MANAGER_H_
 
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
 #include <string>
 
+#include "graph/manager/caching_allocator.h"
 #include "single_op/single_op_model.h"
 #include "single_op/stream_resource.h"
 
@@ -34,14 +36,35 @@ class SingleOpManager {
     return instance;
   }
 
+  ///
+  /// @ingroup ge
+  /// @brief get the op of a model on a stream, built on the first call. The ops a thread got lately are found again
+  ///        without locks, until the resource of any stream is released
+  ///
   Status GetOpFromModel(const std::string &key, const ge::ModelData &model_data, void *stream, SingleOp **single_op);
 
+  ///
+  /// @ingroup ge
+  /// @brief release the ops and the memory of a stream, the cached device memory is given back to the runtime
+  ///
   Status ReleaseResource(void *stream);
 
  private:
-  StreamResource *GetResource(uintptr_t resource_id);
+  SingleOpManager();
+
+  StreamResource *GetResource(uintptr_t resource_id, rtStream_t stream);
   StreamResource *TryGetResource(uintptr_t resource_id);
 
+  Status CreateOp(const std::string &model_name, const ModelData &model_data, void *stream, uintptr_t resource_id,
+                  StreamResource &res, SingleOp *&single_op);
+
+  SingleOp *GetThreadCachedOp(uintptr_t resource_id, const void *key, uint64_t generation) const;
+  void ThreadCacheOp(uintptr_t resource_id, const void *key, uint64_t generation, SingleOp *single_op) const;
+
+  // bumped when a resource is released, the ops cached by the threads before are dropped
+  std::atomic<uint64_t> generation_{1};
+  // the device memory of the single ops of all streams, destroyed after the resources freeing to it
+  CachingAllocator allocator_;
   std::mutex mutex_;
   std::unordered_map<uintptr_t, StreamResource *> stream_resources_;
 };
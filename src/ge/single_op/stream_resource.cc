@@ -29,19 +29,19 @@ StreamResource::~StreamResource() {
     it.second = nullptr;
   }
 
-  for (auto mem : memory_list_) {
-    if (mem != nullptr) {
-      auto rt_ret = rtFree(mem);
-      GE_IF_BOOL_EXEC(rt_ret != RT_ERROR_NONE, GELOGE(RT_FAILED, "rtFree failed"));
-    }
-  }
+  FreeMemory(memory_list_);
+  FreeMemory(weight_list_);
+}
 
-  for (auto weight : weight_list_) {
-    if (weight != nullptr) {
-      auto rt_ret = rtFree(weight);
-      GE_IF_BOOL_EXEC(rt_ret != RT_ERROR_NONE, GELOGE(RT_FAILED, "rtFree failed"));
+void StreamResource::FreeMemory(std::vector<uint8_t *> &allocated) {
+  // the tasks launched on the stream may still run, the blocks are reused once they are done
+  for (auto mem : allocated) {
+    if (mem != nullptr) {
+      auto ret = allocator_.Free(mem, stream_);
+      GE_IF_BOOL_EXEC(ret != SUCCESS, GELOGE(RT_FAILED, "Free memory failed"));
     }
   }
+  allocated.clear();
 }
 
 void StreamResource::CacheOperator(const void *key, SingleOp *single_op) {
@@ -63,18 +63,17 @@ uint8_t *StreamResource::DoMallocMemory(size_t size, size_t &max_allocated, std:
     return allocated.back();
   }
 
-  uint8_t *buffer = nullptr;
-  auto ret = rtMalloc(reinterpret_cast<void **>(&buffer), size, RT_MEMORY_HBM);
-  if (ret != RT_ERROR_NONE) {
-    GELOGE(RT_FAILED, "rtMalloc failed, size = %zu, ret = %d", size, ret);
+  uint8_t *buffer = allocator_.Malloc(size, stream_);
+  if (buffer == nullptr) {
+    GELOGE(RT_FAILED, "Malloc memory failed, size = %zu", size);
     return nullptr;
   }
 
-  ret = rtMemset(buffer, size, 0U, size);
+  auto ret = rtMemset(buffer, size, 0U, size);
   if (ret != RT_ERROR_NONE) {
     GELOGE(RT_FAILED, "rtMemset failed, ret = %d", ret);
-    auto rt_ret = rtFree(buffer);
-    GE_IF_BOOL_EXEC(rt_ret != RT_ERROR_NONE, GELOGE(RT_FAILED, "rtFree failed"));
+    auto free_ret = allocator_.Free(buffer, stream_);
+    GE_IF_BOOL_EXEC(free_ret != SUCCESS, GELOGE(RT_FAILED, "Free memory failed"));
     return nullptr;
   }
 
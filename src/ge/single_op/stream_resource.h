@@ -19,17 +19,23 @@
 
 #include <string>
 #include <cstdint>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 
 #include "common/ge_inner_error_codes.h"
+#include "graph/manager/caching_allocator.h"
 #include "runtime/stream.h"
 #include "single_op/single_op.h"
 
 namespace ge {
 class StreamResource {
  public:
-  StreamResource() = default;
+  ///
+  /// @param [in] stream stream the ops run on
+  /// @param [in] allocator device memory of the single ops of all streams, outlives the resource
+  ///
+  StreamResource(rtStream_t stream, CachingAllocator &allocator) : stream_(stream), allocator_(allocator) {}
   ~StreamResource();
 
   StreamResource(const StreamResource &) = delete;
@@ -44,9 +50,18 @@ class StreamResource {
   uint8_t *MallocMemory(size_t size);
   uint8_t *MallocWeight(size_t size);
 
+  // guards the ops and the memory, the ops of a stream are looked up and built under it
+  std::mutex &GetMutex() { return mutex_; }
+
  private:
-  static uint8_t *DoMallocMemory(size_t size, size_t &max_allocated, std::vector<uint8_t *> &allocated);
+  uint8_t *DoMallocMemory(size_t size, size_t &max_allocated, std::vector<uint8_t *> &allocated);
+
+  void FreeMemory(std::vector<uint8_t *> &allocated);
 
+  rtStream_t stream_;
+  // shared by the resources of all streams, owned by SingleOpManager
+  CachingAllocator &allocator_;
+  std::mutex mutex_;
   size_t max_memory_size_ = 0;
   size_t max_weight_size_ = 0;
   std::vector<uint8_t *> memory_list_;
@@ -17,8 +17,28 @@
 #include <cce/dnn.h>
 #include <securec.h>
 
+#include <map>
+#include <mutex>
+
 #define EVENT_LENTH 10
 
+namespace {
+// the tasks of these streams fail, and so do the events recorded on them
+std::mutex stream_error_mutex;
+std::map<rtStream_t, rtError_t> stream_errors;
+std::map<rtEvent_t, rtError_t> event_errors;
+}  // namespace
+
+// not a runtime api, lets the tests fail the work queued on a stream, RT_ERROR_NONE clears the error
+void rtStubSetStreamError(rtStream_t stream, rtError_t error) {
+  std::lock_guard<std::mutex> lock(stream_error_mutex);
+  if (error == RT_ERROR_NONE) {
+    (void)stream_errors.erase(stream);
+  } else {
+    stream_errors[stream] = error;
+  }
+}
+
 rtError_t rtCtxSetCurrent(rtContext_t ctx) { return RT_ERROR_NONE; }
 
 rtError_t rtGetStreamId(rtStream_t stream, int32_t *stream_id) {
@@ -43,11 +63,30 @@ rtError_t rtEventCreate(rtEvent_t *event) {
   *event = new int[EVENT_LENTH];
   return RT_ERROR_NONE;
 }
-rtError_t rtEventRecord(rtEvent_t event, rtStream_t stream) { return RT_ERROR_NONE; }
+rtError_t rtEventRecord(rtEvent_t event, rtStream_t stream) {
+  std::lock_guard<std::mutex> lock(stream_error_mutex);
+  auto iter = stream_errors.find(stream);
+  if (iter == stream_errors.end()) {
+    (void)event_errors.erase(event);
+  } else {
+    event_errors[event] = iter->second;
+  }
+  return RT_ERROR_NONE;
+}
+
+rtError_t rtEventSynchronize(rtEvent_t event) {
+  std::lock_guard<std::mutex> lock(stream_error_mutex);
+  auto iter = event_errors.find(event);
+  return (iter == event_errors.end()) ? RT_ERROR_NONE : iter->second;
+}
 
-rtError_t rtEventSynchronize(rtEvent_t event) { return RT_ERROR_NONE; }
+rtError_t rtEventQuery(rtEvent_t event) { return RT_ERROR_NONE; }
 
 rtError_t rtEventDestroy(rtEvent_t event) {
+  {
+    std::lock_guard<std::mutex> lock(stream_error_mutex);
+    (void)event_errors.erase(event);
+  }
   delete[](int *) event;
   return RT_ERROR_NONE;
 }
@@ -80,6 +119,7 @@ rtError_t rtStreamCreate(rtStream_t *stream, int32_t priority) {
 }
 
 rtError_t rtStreamDestroy(rtStream_t stream) {
+  rtStubSetStreamError(stream, RT_ERROR_NONE);
   if (stream != nullptr) {
     delete (uint32_t *)stream;
   }
@@ -88,7 +128,11 @@ rtError_t rtStreamDestroy(rtStream_t stream) {
 
 rtError_t rtSetDevice(int32_t device) { return RT_ERROR_NONE; }
 
-rtError_t rtStreamSynchronize(rtStream_t stream) { return RT_ERROR_NONE; }
+rtError_t rtStreamSynchronize(rtStream_t stream) {
+  std::lock_guard<std::mutex> lock(stream_error_mutex);
+  auto iter = stream_errors.find(stream);
+  return (iter == stream_errors.end()) ? RT_ERROR_NONE : iter->second;
+}
 
 rtError_t rtMemcpy(void *dst, uint64_t dest_max, const void *src, uint64_t count, rtMemcpyKind_t kind) {
 #ifdef OTQT_UT
@@ -0,0 +1,205 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#define private public
+#include "graph/compute_graph.h"
+#undef private
+#include "graph/utils/graph_utils.h"
+
+using namespace std;
+using namespace ge;
+
+class UtestGeComputeGraph : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+namespace {
+ComputeGraphPtr BuildChainGraph(int node_num) {
+  auto graph = std::make_shared<ComputeGraph>("chain");
+  NodePtr pre_node = nullptr;
+  for (int i = 0; i < node_num; ++i) {
+    auto op_desc = std::make_shared<OpDesc>("node" + std::to_string(i), "Relu");
+    op_desc->AddInputDesc(GeTensorDesc(GeShape({1}), FORMAT_NCHW));
+    op_desc->AddOutputDesc(GeTensorDesc(GeShape({1}), FORMAT_NCHW));
+    auto node = graph->AddNode(op_desc);
+    if (pre_node != nullptr) {
+      GraphUtils::AddEdge(pre_node->GetOutDataAnchor(0), node->GetInDataAnchor(0));
+    }
+    pre_node = node;
+  }
+  return graph;
+}
+}  // namespace
+
+TEST_F(UtestGeComputeGraph, find_and_remove_node) {
+  auto graph = BuildChainGraph(10);
+  EXPECT_EQ(graph->GetDirectNodesSize(), 10);
+  auto node3 = graph->FindNode("node3");
+  ASSERT_NE(node3, nullptr);
+  EXPECT_EQ(node3->GetName(), "node3");
+  EXPECT_EQ(graph->FindNode("node10"), nullptr);
+
+  EXPECT_EQ(graph->RemoveNode(node3), GRAPH_SUCCESS);
+  EXPECT_EQ(graph->RemoveNode(node3), GRAPH_FAILED);
+  EXPECT_EQ(graph->FindNode("node3"), nullptr);
+  EXPECT_EQ(graph->GetDirectNodesSize(), 9);
+
+  // the order of the remain nodes is kept
+  std::vector<std::string> names;
+  for (const auto &node : graph->GetDirectNode()) {
+    names.push_back(node->GetName());
+  }
+  std::vector<std::string> expect_names = {"node0", "node1", "node2", "node4", "node5",
+                                           "node6", "node7", "node8", "node9"};
+  EXPECT_EQ(names, expect_names);
+}
+
+TEST_F(UtestGeComputeGraph, find_renamed_node) {
+  auto graph = BuildChainGraph(3);
+  auto node1 = graph->FindNode("node1");
+  ASSERT_NE(node1, nullptr);
+  node1->GetOpDesc()->SetName("renamed");
+  EXPECT_EQ(graph->FindNode("node1"), nullptr);
+  EXPECT_EQ(graph->FindNode("renamed"), node1);
+}
+
+TEST_F(UtestGeComputeGraph, add_node_front) {
+  auto graph = BuildChainGraph(3);
+  auto node = graph->AddNodeFront(std::make_shared<OpDesc>("front", "Relu"));
+  ASSERT_NE(node, nullptr);
+  EXPECT_EQ(graph->GetDirectNode().at(0), node);
+  EXPECT_EQ(graph->FindNode("front"), node);
+  EXPECT_EQ(graph->FindNode("node2")->GetName(), "node2");
+
+  auto data_graph = std::make_shared<ComputeGraph>("data_graph");
+  auto data = data_graph->AddNode(std::make_shared<OpDesc>("data", "Data"));
+  auto front = data_graph->AddNodeFront(std::make_shared<OpDesc>("front", "Relu"));
+  EXPECT_EQ(data_graph->GetDirectNode().at(0), data);
+  EXPECT_EQ(data_graph->GetDirectNode().at(1), front);
+}
+
+TEST_F(UtestGeComputeGraph, reuse_removed_slots) {
+  auto graph = BuildChainGraph(4);
+  auto node1 = graph->FindNode("node1");
+  auto node2 = graph->FindNode("node2");
+  EXPECT_EQ(graph->RemoveNode(node1), GRAPH_SUCCESS);
+  EXPECT_EQ(graph->RemoveNode(node2), GRAPH_SUCCESS);
+  // the new nodes take the removed slots, the order is still the order they were added
+  auto node4 = graph->AddNode(std::make_shared<OpDesc>("node4", "Relu"));
+  auto front = graph->AddNodeFront(std::make_shared<OpDesc>("front", "Relu"));
+  EXPECT_EQ(graph->nodes_.slots_.size(), 4);
+  std::vector<std::string> names;
+  for (const auto &node : graph->GetDirectNode()) {
+    names.push_back(node->GetName());
+  }
+  std::vector<std::string> expect_names = {"front", "node0", "node3", "node4"};
+  EXPECT_EQ(names, expect_names);
+  EXPECT_EQ(graph->FindNode("node4"), node4);
+  EXPECT_EQ(graph->FindNode("front"), front);
+  EXPECT_EQ(graph->FindNode("node1"), nullptr);
+}
+
+TEST_F(UtestGeComputeGraph, find_duplicated_names) {
+  auto graph = BuildChainGraph(3);
+  auto dup = graph->AddNodeFront(std::make_shared<OpDesc>("node2", "Relu"));
+  EXPECT_EQ(graph->FindNode("node2"), dup);
+  EXPECT_EQ(graph->RemoveNode(dup), GRAPH_SUCCESS);
+  EXPECT_EQ(graph->FindNode("node2"), graph->GetDirectNode().at(2));
+
+  // a copied op desc shares the op def with the node it was copied from, renaming it renames the node
+  auto node0 = graph->FindNode("node0");
+  auto copied = std::make_shared<OpDesc>(*node0->GetOpDesc());
+  copied->SetName("copied");
+  EXPECT_EQ(node0->GetName(), "copied");
+  EXPECT_EQ(graph->FindNode("copied"), node0);
+  EXPECT_EQ(graph->FindNode("node0"), nullptr);
+
+  // the node is indexed by the name of the op desc it is updated to
+  auto node1 = graph->FindNode("node1");
+  auto updated = std::make_shared<OpDesc>("updated", "Relu");
+  updated->AddInputDesc(GeTensorDesc(GeShape({1}), FORMAT_NCHW));
+  updated->AddOutputDesc(GeTensorDesc(GeShape({1}), FORMAT_NCHW));
+  EXPECT_EQ(node1->UpdateOpDesc(updated), GRAPH_SUCCESS);
+  EXPECT_EQ(graph->FindNode("updated"), node1);
+  EXPECT_EQ(graph->FindNode("node1"), nullptr);
+  node1->GetOpDesc()->SetName("renamed");
+  EXPECT_EQ(graph->FindNode("renamed"), node1);
+  EXPECT_EQ(graph->FindNode("updated"), nullptr);
+}
+
+TEST_F(UtestGeComputeGraph, read_concurrently) {
+  auto graph = BuildChainGraph(1000);
+  std::vector<std::thread> threads;
+  std::atomic<int> failed_num(0);
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&graph, &failed_num]() {
+      for (int i = 0; i < 1000; ++i) {
+        std::string name = "node" + std::to_string(i);
+        auto node = graph->FindNode(name);
+        if ((node == nullptr) || (node->GetName() != name) || (graph->GetDirectNode().size() != 1000)) {
+          ++failed_num;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(failed_num, 0);
+}
+
+TEST_F(UtestGeComputeGraph, topo_sorting_after_remove) {
+  auto graph = BuildChainGraph(6);
+  for (const auto &name : {"node1", "node3"}) {
+    auto node = graph->FindNode(name);
+    ASSERT_NE(node, nullptr);
+    EXPECT_EQ(GraphUtils::IsolateNode(node, {0}), GRAPH_SUCCESS);
+    EXPECT_EQ(GraphUtils::RemoveNodeWithoutRelink(graph, node), GRAPH_SUCCESS);
+  }
+  EXPECT_EQ(graph->TopologicalSorting(), GRAPH_SUCCESS);
+  EXPECT_EQ(graph->GetDirectNodesSize(), 4);
+  int64_t id = 0;
+  for (const auto &node : graph->GetDirectNode()) {
+    EXPECT_EQ(node->GetOpDesc()->GetId(), id++);
+  }
+}
+
+/// Node storage benchmark, run with --gtest_also_run_disabled_tests
+TEST_F(UtestGeComputeGraph, DISABLED_benchmark_remove_half_of_100k) {
+  const int node_num = 100000;
+  auto graph = BuildChainGraph(node_num);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < node_num; i += 2) {
+    auto node = graph->FindNode("node" + std::to_string(i));
+    ASSERT_NE(node, nullptr);
+    (void)GraphUtils::IsolateNode(node, {0});
+    EXPECT_EQ(GraphUtils::RemoveNodeWithoutRelink(graph, node), GRAPH_SUCCESS);
+  }
+  EXPECT_EQ(graph->GetDirectNodesSize(), node_num / 2);
+  EXPECT_EQ(graph->GetDirectNode().size(), node_num / 2);
+  auto cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  std::cout << "Find and remove " << node_num / 2 << " of " << node_num << " nodes: " << cost.count() << " ms"
+            << std::endl;
+}
@@ -15,17 +15,23 @@
  */
 
 #include <gtest/gtest.h>
+#include <chrono>
 #include <iostream>
 
+#include "proto/ge_ir.pb.h"
+
 #define protected public
 #define private public
 #include "graph/op_desc.h"
 
 #include "graph/compute_graph.h"
+#include "graph/debug/ge_attr_define.h"
+#include "graph/detail/attr_typed_table.h"
 #include "graph/ge_attr_value.h"
 #include "graph/ge_tensor.h"
 #include "graph/node.h"
 #include "graph/operator_factory.h"
+#include "utils/attr_utils.h"
 #include "utils/op_desc_utils.h"
 #undef protected
 #undef private
@@ -236,3 +242,174 @@ TEST_F(UtestGeOpdesc, add_dynamic_output_desc) {
   OpDescPtr desc_ptr2 = std::make_shared<OpDesc>("name2", "type2");
   EXPECT_EQ(desc_ptr2->AddDynamicOutputDesc("x", 1), GRAPH_SUCCESS);
 }
+
+TEST_F(UtestGeOpdesc, attr_utils_typed_values) {
+  OpDescPtr op_desc = std::make_shared<OpDesc>("data", "Data");
+  EXPECT_TRUE(AttrUtils::SetInt(op_desc, "index", 3));
+  EXPECT_TRUE(AttrUtils::SetListInt(op_desc, "axis", vector<int64_t>({0, 2, 3})));
+  EXPECT_TRUE(AttrUtils::SetListStr(op_desc, "names", vector<string>({"a", "b"})));
+  EXPECT_TRUE(AttrUtils::SetListBool(op_desc, "flags", vector<bool>({true, false})));
+
+  ConstOpDescPtr const_op_desc = op_desc;
+  int64_t index = 0;
+  EXPECT_TRUE(AttrUtils::GetInt(const_op_desc, "index", index));
+  EXPECT_EQ(index, 3);
+  vector<int64_t> axis = {7};
+  EXPECT_TRUE(AttrUtils::GetListInt(const_op_desc, "axis", axis));
+  EXPECT_EQ(axis, vector<int64_t>({0, 2, 3}));
+  vector<string> names;
+  EXPECT_TRUE(AttrUtils::GetListStr(op_desc, "names", names));
+  EXPECT_EQ(names, vector<string>({"a", "b"}));
+  vector<bool> flags;
+  EXPECT_TRUE(AttrUtils::GetListBool(op_desc, "flags", flags));
+  EXPECT_EQ(flags, vector<bool>({true, false}));
+
+  // type mismatch and missing keys
+  float value = 0.0f;
+  EXPECT_FALSE(AttrUtils::GetFloat(op_desc, "index", value));
+  EXPECT_FALSE(AttrUtils::GetInt(op_desc, "not_exist", index));
+  EXPECT_FALSE(AttrUtils::SetFloat(op_desc, "index", 1.0f));
+
+  GeTensorDesc tensor_desc(GeShape({1, 2}), FORMAT_NCHW, DT_INT8);
+  EXPECT_TRUE(AttrUtils::SetTensorDesc(op_desc, "desc", tensor_desc));
+  GeTensorDesc out_desc;
+  EXPECT_TRUE(AttrUtils::GetTensorDesc(op_desc, "desc", out_desc));
+  EXPECT_EQ(out_desc.GetDataType(), DT_INT8);
+  EXPECT_EQ(out_desc.GetShape().GetDims(), vector<int64_t>({1, 2}));
+}
+
+TEST_F(UtestGeOpdesc, typed_attrs_follow_proto) {
+  OpDescPtr op_desc = std::make_shared<OpDesc>("data", "Data");
+  ASSERT_NE(op_desc->typed_attrs_, nullptr);
+  int64_t index = 0;
+
+  // interned key, the first read builds the typed table
+  EXPECT_TRUE(AttrUtils::SetInt(op_desc, ATTR_NAME_INDEX, 3));
+  EXPECT_FALSE(op_desc->typed_attrs_->InSync());
+  EXPECT_TRUE(AttrUtils::GetInt(op_desc, ATTR_NAME_INDEX, index));
+  EXPECT_EQ(index, 3);
+  EXPECT_TRUE(op_desc->typed_attrs_->InSync());
+  EXPECT_TRUE(op_desc->typed_attrs_->Get(ATTR_NAME_INDEX, index));
+  // the same key passed as another string is found by its content
+  EXPECT_TRUE(op_desc->typed_attrs_->Get(string(ATTR_NAME_INDEX), index));
+  EXPECT_EQ(index, 3);
+  // and written through it, the table follows
+  EXPECT_TRUE(AttrUtils::SetInt(op_desc, string(ATTR_NAME_INDEX), 4));
+  EXPECT_TRUE(AttrUtils::GetInt(op_desc, ATTR_NAME_INDEX, index));
+  EXPECT_EQ(index, 4);
+
+  // writes through AttrHolder
+  EXPECT_EQ(op_desc->SetAttr(ATTR_NAME_INDEX, GeAttrValue::CreateFrom<int64_t>(5)), GRAPH_SUCCESS);
+  EXPECT_TRUE(AttrUtils::GetInt(op_desc, ATTR_NAME_INDEX, index));
+  EXPECT_EQ(index, 5);
+  EXPECT_EQ(op_desc->DelAttr(ATTR_NAME_INDEX), GRAPH_SUCCESS);
+  EXPECT_FALSE(AttrUtils::GetInt(op_desc, ATTR_NAME_INDEX, index));
+
+  // other types replace the typed value
+  EXPECT_TRUE(AttrUtils::SetStr(op_desc, ATTR_NAME_INDEX, "str"));
+  EXPECT_FALSE(AttrUtils::GetInt(op_desc, ATTR_NAME_INDEX, index));
+  EXPECT_FALSE(AttrUtils::SetInt(op_desc, ATTR_NAME_INDEX, 6));
+  string str;
+  EXPECT_TRUE(AttrUtils::GetStr(op_desc, ATTR_NAME_INDEX, str));
+  EXPECT_EQ(str, "str");
+
+  vector<int64_t> axis;
+  EXPECT_TRUE(AttrUtils::SetListInt(op_desc, ATTR_NAME_AXIS, vector<int32_t>({1, 2})));
+  EXPECT_TRUE(AttrUtils::GetListInt(op_desc, ATTR_NAME_AXIS, axis));
+  EXPECT_EQ(axis, vector<int64_t>({1, 2}));
+  EXPECT_TRUE(AttrUtils::SetListInt(op_desc, ATTR_NAME_AXIS, {3}));
+  EXPECT_TRUE(AttrUtils::GetListInt(op_desc, ATTR_NAME_AXIS, axis));
+  EXPECT_EQ(axis, vector<int64_t>({3}));
+  float alpha = 0.0f;
+  bool is_const = true;
+  EXPECT_TRUE(AttrUtils::SetFloat(op_desc, ATTR_NAME_ALPHA, 0.5f));
+  EXPECT_TRUE(AttrUtils::SetBool(op_desc, ATTR_NAME_IS_CONST, false));
+  EXPECT_TRUE(AttrUtils::GetFloat(op_desc, ATTR_NAME_ALPHA, alpha));
+  EXPECT_TRUE(AttrUtils::GetBool(op_desc, ATTR_NAME_IS_CONST, is_const));
+  EXPECT_EQ(alpha, 0.5f);
+  EXPECT_FALSE(is_const);
+  EXPECT_FALSE(AttrUtils::GetInt(op_desc, ATTR_NAME_ALPHA, index));
+
+  // copies, and op descs made from the proto, read the same values
+  OpDescPtr copied = std::make_shared<OpDesc>("copied", "Data");
+  copied->CopyAttrsFrom(*op_desc);
+  EXPECT_TRUE(AttrUtils::GetFloat(copied, ATTR_NAME_ALPHA, alpha));
+  EXPECT_EQ(alpha, 0.5f);
+  for (const auto &clone : {AttrUtils::CloneOpDesc(op_desc), AttrUtils::CopyOpDesc(op_desc)}) {
+    ASSERT_NE(clone, nullptr);
+    ASSERT_NE(clone->typed_attrs_, nullptr);
+    EXPECT_TRUE(AttrUtils::GetBool(clone, ATTR_NAME_IS_CONST, is_const));
+    EXPECT_FALSE(is_const);
+    EXPECT_TRUE(clone->typed_attrs_->Get(ATTR_NAME_AXIS, axis));
+    EXPECT_EQ(axis, vector<int64_t>({3}));
+    EXPECT_TRUE(AttrUtils::GetStr(clone, ATTR_NAME_INDEX, str));
+    EXPECT_EQ(str, "str");
+  }
+}
+
+TEST_F(UtestGeOpdesc, typed_attrs_stale_after_raw_writes) {
+  OpDescPtr op_desc = std::make_shared<OpDesc>("data", "Data");
+  int64_t index = 0;
+  EXPECT_TRUE(AttrUtils::SetInt(op_desc, ATTR_NAME_INDEX, 1));
+  EXPECT_TRUE(AttrUtils::GetInt(op_desc, ATTR_NAME_INDEX, index));
+  EXPECT_TRUE(op_desc->typed_attrs_->InSync());
+
+  // writes through the proto map leave the table stale, the next read rebuilds it
+  auto attr_map = op_desc->MutableAttrMap().GetProtoMsg();
+  ASSERT_NE(attr_map, nullptr);
+  EXPECT_FALSE(op_desc->typed_attrs_->InSync());
+  (*attr_map)[ATTR_NAME_INDEX].set_i(2);
+  EXPECT_TRUE(AttrUtils::GetInt(op_desc, ATTR_NAME_INDEX, index));
+  EXPECT_EQ(index, 2);
+
+  // a shallow copy shares the proto and the table, writes through either are seen by both
+  OpDescPtr shallow = std::make_shared<OpDesc>(*op_desc);
+  EXPECT_TRUE(AttrUtils::SetInt(shallow, ATTR_NAME_INDEX, 3));
+  EXPECT_TRUE(AttrUtils::GetInt(op_desc, ATTR_NAME_INDEX, index));
+  EXPECT_EQ(index, 3);
+  EXPECT_EQ(op_desc->DelAttr(ATTR_NAME_INDEX), GRAPH_SUCCESS);
+  EXPECT_FALSE(AttrUtils::GetInt(shallow, ATTR_NAME_INDEX, index));
+  EXPECT_TRUE(shallow->typed_attrs_->InSync());
+
+  // every name of ge_attr_define.def is interned, the last one as well
+  vector<int64_t> nums;
+  EXPECT_TRUE(AttrUtils::SetListInt(op_desc, "DynamicStitchN_", vector<int64_t>({4})));
+  EXPECT_TRUE(AttrUtils::GetListInt(op_desc, DYNAMIC_STITCH_ATTR_NAME_NUM, nums));
+  EXPECT_TRUE(op_desc->typed_attrs_->Get(DYNAMIC_STITCH_ATTR_NAME_NUM, nums));
+  EXPECT_EQ(nums, vector<int64_t>({4}));
+}
+
+TEST_F(UtestGeOpdesc, DISABLED_benchmark_attr_utils_get) {
+  const int kLoops = 1000000;
+  OpDescPtr op_desc = std::make_shared<OpDesc>("conv", "Conv2D");
+  for (int i = 0; i < 32; ++i) {
+    (void)AttrUtils::SetInt(op_desc, "attr_" + std::to_string(i), i);
+  }
+  (void)AttrUtils::SetListInt(op_desc, "pads", vector<int64_t>({1, 1, 1, 1}));
+  const string key = "attr_17";
+  int64_t sum = 0;
+  vector<int64_t> pads;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kLoops; ++i) {
+    int64_t value = 0;
+    (void)AttrUtils::GetInt(op_desc, key, value);
+    (void)AttrUtils::GetListInt(op_desc, "pads", pads);
+    sum += value + static_cast<int64_t>(pads.size());
+  }
+  auto cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  std::cout << kLoops << " attr reads cost " << cost.count() << " ms, checksum " << sum << std::endl;
+
+  // the same reads with interned keys
+  (void)AttrUtils::SetInt(op_desc, ATTR_NAME_INDEX, 17);
+  (void)AttrUtils::SetListInt(op_desc, ATTR_NAME_PADS, vector<int64_t>({1, 1, 1, 1}));
+  sum = 0;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kLoops; ++i) {
+    int64_t value = 0;
+    (void)AttrUtils::GetInt(op_desc, ATTR_NAME_INDEX, value);
+    (void)AttrUtils::GetListInt(op_desc, ATTR_NAME_PADS, pads);
+    sum += value + static_cast<int64_t>(pads.size());
+  }
+  cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  std::cout << kLoops << " interned attr reads cost " << cost.count() << " ms, checksum " << sum << std::endl;
+}
@@ -15,8 +15,10 @@
  */
 
 #include <gtest/gtest.h>
+#include <chrono>
 #include <iostream>
 #include <string>
+#include <thread>
 
 #define private public
 #define protected public
@@ -28,6 +30,13 @@
 #undef private
 #undef protected
 
+#include "graph/compute_graph.h"
+#include "graph/model_serialize.h"
+#include "graph/op_desc.h"
+#include "graph/utils/attr_utils.h"
+#include "graph/utils/graph_utils.h"
+#include "proto/ge_ir.pb.h"
+
 using namespace std;
 using namespace ge;
 
@@ -376,3 +385,362 @@ TEST_F(UtestGeTensor, test_tensor_invalid) {
   Tensor tensor6(tensor_desc6, &data6, 1);
   EXPECT_EQ(tensor6.IsValid(), GRAPH_SUCCESS);
 }
+
+TEST_F(UtestGeTensor, shape_inline_and_heap_dims) {
+  vector<int64_t> dims;
+  for (int64_t i = 1; i <= 12; ++i) {
+    dims.push_back(i);
+    GeShape shape(dims);
+    EXPECT_EQ(shape.GetDimNum(), dims.size());
+    EXPECT_EQ(shape.GetDims(), dims);
+    EXPECT_EQ(shape.GetDim(i - 1), i);
+    EXPECT_EQ(shape.GetDim(i), 0);
+  }
+  GeShape shape(dims);
+  EXPECT_EQ(shape.SetDim(11, 2), GRAPH_SUCCESS);
+  EXPECT_EQ(shape.GetDim(11), 2);
+  EXPECT_EQ(shape.ToString(), "1,2,3,4,5,6,7,8,9,10,11,2");
+
+  GeShape copied(shape);
+  GeShape moved(std::move(shape));
+  EXPECT_EQ(copied.GetDims(), moved.GetDims());
+  copied = GeShape({2, 3});
+  EXPECT_EQ(copied.GetShapeSize(), 6);
+  EXPECT_EQ(moved.GetDimNum(), 12);
+}
+
+TEST_F(UtestGeTensor, shape_reference_writes_through_desc) {
+  GeTensorDesc desc(GeShape({1, 3, 224, 224}), FORMAT_NCHW, DT_FLOAT16);
+  GeShape shape = desc.GetShape();
+  EXPECT_EQ(shape.SetDim(0, 8), GRAPH_SUCCESS);
+  EXPECT_EQ(desc.GetShape().GetDim(0), 1);
+
+  EXPECT_EQ(desc.MutableShape().SetDim(0, 8), GRAPH_SUCCESS);
+  EXPECT_EQ(desc.GetShape().GetDim(0), 8);
+  EXPECT_EQ(desc.GetShape().GetShapeSize(), 8 * 3 * 224 * 224);
+
+  desc.MutableShape() = GeShape({2, 2});
+  EXPECT_EQ(desc.GetShape().ToString(), "2,2");
+
+  GeTensorDesc copied(desc);
+  desc.SetShape(GeShape({4}));
+  EXPECT_EQ(copied.GetShape().GetDims(), vector<int64_t>({2, 2}));
+  EXPECT_EQ(desc.GetShape().GetDims(), vector<int64_t>({4}));
+}
+
+TEST_F(UtestGeTensor, desc_typed_properties) {
+  GeTensorDesc desc;
+  EXPECT_EQ(desc.GetDataType(), DT_FLOAT);
+  EXPECT_EQ(desc.GetOriginFormat(), FORMAT_ND);
+  EXPECT_EQ(desc.GetOriginDataType(), DT_UNDEFINED);
+
+  desc.SetDataType(DT_QINT8);
+  EXPECT_EQ(desc.GetDataType(), DT_QINT8);
+  desc.SetDataType(DT_INT64);
+  EXPECT_EQ(desc.GetDataType(), DT_INT64);
+
+  desc.SetOriginDataType(DT_FLOAT16);
+  desc.SetOriginFormat(FORMAT_NHWC);
+  EXPECT_EQ(desc.GetOriginDataType(), DT_FLOAT16);
+  EXPECT_EQ(desc.GetOriginFormat(), FORMAT_NHWC);
+  desc.SetOriginFormat(FORMAT_RESERVED);
+  EXPECT_EQ(desc.GetOriginFormat(), FORMAT_RESERVED);
+}
+
+TEST_F(UtestGeTensor, DISABLED_benchmark_desc_reads) {
+  const int kDescNum = 1000;
+  const int kRounds = 1000;
+  vector<GeTensorDesc> descs;
+  for (int i = 0; i < kDescNum; ++i) {
+    GeTensorDesc desc(GeShape({1, 64 + i % 64, 56, 56}), FORMAT_NCHW, DT_FLOAT16);
+    desc.SetOriginFormat(FORMAT_NCHW);
+    desc.SetOriginDataType(DT_FLOAT);
+    descs.push_back(desc);
+  }
+  int64_t checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < kRounds; ++round) {
+    for (const auto &desc : descs) {
+      checksum += desc.GetShape().GetShapeSize();
+      checksum += desc.GetDataType() + desc.GetOriginFormat() + desc.GetOriginDataType();
+    }
+  }
+  auto cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  std::cout << kDescNum * kRounds << " desc reads cost " << cost.count() << " ms, checksum " << checksum << std::endl;
+}
+
+TEST_F(UtestGeTensor, desc_typed_values_materialized) {
+  GeTensorDesc desc(GeShape({1, 3, 16, 16}), FORMAT_NC1HWC0, DT_QINT8);
+  desc.SetOriginFormat(FORMAT_NCHW);
+  desc.SetOriginDataType(DT_FLOAT16);
+  TensorUtils::SetSize(desc, 768);
+  TensorUtils::SetRealDimCnt(desc, 4);
+  TensorUtils::SetDataOffset(desc, 512);
+  EXPECT_EQ(desc.tensor_descriptor_.GetProtoMsg(), nullptr);
+
+  auto op_desc = std::make_shared<OpDesc>("op", "Relu");
+  EXPECT_TRUE(AttrUtils::SetTensorDesc(op_desc, "desc", desc));
+  GeTensorDesc loaded;
+  EXPECT_TRUE(AttrUtils::GetTensorDesc(op_desc, "desc", loaded));
+  EXPECT_EQ(loaded.GetShape().GetDims(), vector<int64_t>({1, 3, 16, 16}));
+  EXPECT_EQ(loaded.GetFormat(), FORMAT_NC1HWC0);
+  EXPECT_EQ(loaded.GetDataType(), DT_QINT8);
+  EXPECT_EQ(loaded.GetOriginFormat(), FORMAT_NCHW);
+  EXPECT_EQ(loaded.GetOriginDataType(), DT_FLOAT16);
+  uint32_t size = 0;
+  uint32_t real_dim_cnt = 0;
+  int64_t data_offset = 0;
+  EXPECT_EQ(TensorUtils::GetSize(loaded, size), GRAPH_SUCCESS);
+  EXPECT_EQ(TensorUtils::GetRealDimCnt(loaded, real_dim_cnt), GRAPH_SUCCESS);
+  EXPECT_EQ(TensorUtils::GetDataOffset(loaded, data_offset), GRAPH_SUCCESS);
+  EXPECT_EQ(size, 768);
+  EXPECT_EQ(real_dim_cnt, 4);
+  EXPECT_EQ(data_offset, 512);
+  EXPECT_TRUE(loaded == desc);
+
+  // the proto written for the attr holds the typed values, the desc still has none
+  proto::TensorDescriptor proto_msg;
+  EXPECT_TRUE(desc.MaterializeTo(proto_msg));
+  EXPECT_EQ(proto_msg.layout(), "NC1HWC0");
+  EXPECT_EQ(proto_msg.shape().dim_size(), 4);
+  EXPECT_EQ(proto_msg.size(), 768);
+  EXPECT_EQ(proto_msg.attr().at("origin_format").s(), "NCHW");
+  EXPECT_EQ(desc.tensor_descriptor_.GetProtoMsg(), nullptr);
+}
+
+TEST_F(UtestGeTensor, desc_typed_values_follow_attr_writes) {
+  GeTensorDesc desc;
+  EXPECT_TRUE(desc.HasAttr("origin_format"));
+  desc.SetOriginDataType(DT_INT8);
+  string origin_data_type;
+  EXPECT_TRUE(AttrUtils::GetStr(desc, "origin_data_type", origin_data_type));
+  EXPECT_EQ(origin_data_type, "DT_INT8");
+
+  EXPECT_TRUE(AttrUtils::SetStr(desc, "origin_format", "NHWC"));
+  EXPECT_EQ(desc.GetOriginFormat(), FORMAT_NHWC);
+  desc.SetOriginFormat(FORMAT_HWCN);
+  string origin_format;
+  EXPECT_TRUE(AttrUtils::GetStr(desc, "origin_format", origin_format));
+  EXPECT_EQ(origin_format, "HWCN");
+
+  // a copy keeps the values and reads them typed again
+  GeTensorDesc copied(desc);
+  EXPECT_TRUE(desc.attrs_in_proto_);
+  EXPECT_FALSE(copied.attrs_in_proto_);
+  EXPECT_EQ(copied.GetOriginFormat(), FORMAT_HWCN);
+  EXPECT_EQ(copied.GetOriginDataType(), DT_INT8);
+  copied.SetOriginFormat(FORMAT_NCHW);
+  EXPECT_TRUE(AttrUtils::GetStr(copied, "origin_format", origin_format));
+  EXPECT_EQ(origin_format, "NCHW");
+  EXPECT_EQ(desc.GetOriginFormat(), FORMAT_HWCN);
+}
+
+TEST_F(UtestGeTensor, desc_attrs_read_concurrently) {
+  GeTensorDesc desc;
+  desc.SetOriginFormat(FORMAT_NHWC);
+  std::vector<std::thread> threads;
+  std::atomic<int> failed_num(0);
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&desc, &failed_num]() {
+      string origin_format;
+      if (!AttrUtils::GetStr(desc, "origin_format", origin_format) || origin_format != "NHWC") {
+        ++failed_num;
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(failed_num, 0);
+}
+
+TEST_F(UtestGeTensor, desc_referencing_tensor_proto) {
+  GeTensorDesc desc(GeShape({2, 3}), FORMAT_NHWC, DT_INT32);
+  TensorUtils::SetSize(desc, 24);
+  GeTensor tensor(desc);
+  GeTensorDesc &tensor_desc = tensor.MutableTensorDesc();
+  EXPECT_EQ(tensor_desc.GetShape().GetDims(), vector<int64_t>({2, 3}));
+  EXPECT_EQ(tensor_desc.GetFormat(), FORMAT_NHWC);
+  EXPECT_EQ(tensor_desc.GetDataType(), DT_INT32);
+
+  TensorUtils::SetSize(tensor.MutableTensorDesc(), 32);
+  tensor.MutableTensorDesc().MutableShape().SetDim(0, 4);
+  GeTensorDesc copied = tensor.GetTensorDesc();
+  uint32_t size = 0;
+  EXPECT_EQ(TensorUtils::GetSize(copied, size), GRAPH_SUCCESS);
+  EXPECT_EQ(size, 32);
+  EXPECT_EQ(copied.GetShape().GetDims(), vector<int64_t>({4, 3}));
+  EXPECT_EQ(TensorUtils::GetSize(desc, size), GRAPH_SUCCESS);
+  EXPECT_EQ(size, 24);
+}
+
+namespace {
+///
+/// A ResNet-50 graph of Conv2D/BatchNorm/Relu/Add nodes. The shapes are set by
+/// the build steps, the nodes hold the parameters they are inferred from.
+///
+class ResNet50Builder {
+ public:
+  ComputeGraphPtr Build() {
+    graph_ = std::make_shared<ComputeGraph>("resnet50");
+    auto input = AddNode("Data", nullptr, 0, 0, 0);
+    auto x = AddConvBnRelu(input, 64, 7, 2, true);
+    x = AddNode("MaxPool", x, 64, 3, 2);
+    const int stage_blocks[] = {3, 4, 6, 3};
+    int width = 64;
+    for (int stage = 0; stage < 4; ++stage) {
+      for (int block = 0; block < stage_blocks[stage]; ++block) {
+        int stride = (stage > 0 && block == 0) ? 2 : 1;
+        auto shortcut = x;
+        if (block == 0) {
+          shortcut = AddConvBnRelu(x, width * 4, 1, stride, false);
+        }
+        auto y = AddConvBnRelu(x, width, 1, 1, true);
+        y = AddConvBnRelu(y, width, 3, stride, true);
+        y = AddConvBnRelu(y, width * 4, 1, 1, false);
+        auto add = AddNode("Add", y, 0, 0, 0);
+        (void)GraphUtils::AddEdge(shortcut->GetOutDataAnchor(0), add->GetInDataAnchor(1));
+        x = AddNode("Relu", add, 0, 0, 0);
+      }
+      width *= 2;
+    }
+    x = AddNode("AvgPool", x, 0, 7, 7);
+    (void)AddNode("FullConnection", x, 1000, 1, 1);
+    return graph_;
+  }
+
+ private:
+  NodePtr AddConvBnRelu(const NodePtr &input, int64_t out_channel, int64_t kernel, int64_t stride, bool relu) {
+    auto x = AddNode("Conv2D", input, out_channel, kernel, stride);
+    x = AddNode("BatchNorm", x, 0, 0, 0);
+    return relu ? AddNode("Relu", x, 0, 0, 0) : x;
+  }
+
+  NodePtr AddNode(const string &type, const NodePtr &input, int64_t out_channel, int64_t kernel, int64_t stride) {
+    auto op_desc = std::make_shared<OpDesc>(type + std::to_string(node_num_++), type);
+    int input_num = (type == "Add") ? 2 : ((input == nullptr) ? 0 : 1);
+    for (int i = 0; i < input_num; ++i) {
+      op_desc->AddInputDesc(GeTensorDesc(GeShape(), FORMAT_NCHW, DT_FLOAT16));
+    }
+    op_desc->AddOutputDesc(GeTensorDesc(GeShape(), FORMAT_NCHW, DT_FLOAT16));
+    (void)AttrUtils::SetInt(op_desc, "out_channel", out_channel);
+    (void)AttrUtils::SetInt(op_desc, "kernel", kernel);
+    (void)AttrUtils::SetInt(op_desc, "stride", stride);
+    auto node = graph_->AddNode(op_desc);
+    if (input != nullptr) {
+      (void)GraphUtils::AddEdge(input->GetOutDataAnchor(0), node->GetInDataAnchor(0));
+    }
+    return node;
+  }
+
+  ComputeGraphPtr graph_;
+  int node_num_ = 0;
+};
+
+void InferShapes(const ComputeGraphPtr &graph) {
+  for (const auto &node : graph->GetDirectNode()) {
+    auto op_desc = node->GetOpDesc();
+    GeTensorDesc output = op_desc->GetOutputDesc(0);
+    if (op_desc->GetInputsSize() == 0) {
+      output.SetShape(GeShape({1, 3, 224, 224}));
+    } else {
+      GeTensorDesc input = op_desc->GetInputDesc(0);
+      vector<int64_t> dims = input.GetShape().GetDims();
+      int64_t out_channel = 0;
+      int64_t stride = 0;
+      (void)AttrUtils::GetInt(op_desc, "out_channel", out_channel);
+      (void)AttrUtils::GetInt(op_desc, "stride", stride);
+      if (out_channel > 0) {
+        dims[1] = out_channel;
+      }
+      if (stride > 1) {
+        dims[2] = (dims[2] + stride - 1) / stride;
+        dims[3] = (dims[3] + stride - 1) / stride;
+      }
+      output.SetShape(GeShape(dims));
+      output.SetFormat(input.GetFormat());
+      output.SetDataType(input.GetDataType());
+    }
+    output.SetOriginFormat(FORMAT_NCHW);
+    output.SetOriginDataType(DT_FLOAT);
+    TensorUtils::SetRealDimCnt(output, static_cast<uint32_t>(output.GetShape().GetDimNum()));
+    (void)op_desc->UpdateOutputDesc(0, output);
+    for (const auto &peer_in_anchor : node->GetOutDataAnchor(0)->GetPeerInDataAnchors()) {
+      auto peer_op_desc = peer_in_anchor->GetOwnerNode()->GetOpDesc();
+      (void)peer_op_desc->UpdateInputDesc(static_cast<uint32_t>(peer_in_anchor->GetIdx()), output);
+    }
+  }
+}
+
+int64_t AssignMemory(const ComputeGraphPtr &graph) {
+  int64_t offset = 0;
+  for (const auto &node : graph->GetDirectNode()) {
+    auto output = node->GetOpDesc()->MutableOutputDesc(0);
+    int64_t size = output->GetShape().GetShapeSize() * GetSizeByDataType(output->GetDataType());
+    TensorUtils::SetSize(*output, static_cast<uint32_t>(size));
+    TensorUtils::SetDataOffset(*output, offset);
+    offset += (size + 511) / 512 * 512;
+  }
+  return offset;
+}
+
+int64_t GenerateTasks(const ComputeGraphPtr &graph) {
+  int64_t checksum = 0;
+  for (const auto &node : graph->GetDirectNode()) {
+    auto op_desc = node->GetOpDesc();
+    for (const auto &desc : op_desc->GetAllInputsDesc()) {
+      uint32_t size = 0;
+      uint32_t real_dim_cnt = 0;
+      (void)TensorUtils::GetSize(desc, size);
+      (void)TensorUtils::GetRealDimCnt(desc, real_dim_cnt);
+      checksum += size + real_dim_cnt + desc.GetFormat() + desc.GetOriginFormat() + desc.GetDataType();
+    }
+    for (const auto &desc : op_desc->GetAllOutputsDesc()) {
+      int64_t data_offset = 0;
+      (void)TensorUtils::GetDataOffset(desc, data_offset);
+      checksum += data_offset + desc.GetShape().GetShapeSize() + desc.GetOriginDataType();
+    }
+  }
+  return checksum;
+}
+}  // namespace
+
+TEST_F(UtestGeTensor, resnet50_build_steps) {
+  auto graph = ResNet50Builder().Build();
+  InferShapes(graph);
+  auto fc = graph->GetDirectNode().at(graph->GetDirectNodesSize() - 1)->GetOpDesc();
+  EXPECT_EQ(fc->GetOutputDesc(0).GetShape().GetDims(), vector<int64_t>({1, 1000, 1, 1}));
+  EXPECT_GT(AssignMemory(graph), 0);
+  EXPECT_GT(GenerateTasks(graph), 0);
+  EXPECT_GT(ModelSerialize().SerializeGraph(graph).GetSize(), 0);
+}
+
+TEST_F(UtestGeTensor, DISABLED_benchmark_resnet50_build) {
+  const int kRounds = 100;
+  int64_t checksum = 0;
+  std::chrono::steady_clock::duration costs[4] = {};
+  for (int round = 0; round < kRounds; ++round) {
+    auto start = std::chrono::steady_clock::now();
+    auto graph = ResNet50Builder().Build();
+    auto built = std::chrono::steady_clock::now();
+    InferShapes(graph);
+    auto inferred = std::chrono::steady_clock::now();
+    checksum += AssignMemory(graph) + GenerateTasks(graph);
+    auto generated = std::chrono::steady_clock::now();
+    checksum += static_cast<int64_t>(ModelSerialize().SerializeGraph(graph).GetSize());
+    auto serialized = std::chrono::steady_clock::now();
+    costs[0] += built - start;
+    costs[1] += inferred - built;
+    costs[2] += generated - inferred;
+    costs[3] += serialized - generated;
+  }
+  const char *steps[] = {"construct", "infer shape", "assign memory and generate tasks", "serialize"};
+  std::chrono::steady_clock::duration total{};
+  for (int i = 0; i < 4; ++i) {
+    total += costs[i];
+    std::cout << steps[i] << ": " << std::chrono::duration_cast<std::chrono::microseconds>(costs[i]).count() / kRounds
+              << " us per build" << std::endl;
+  }
+  std::cout << "resnet50 build: " << std::chrono::duration_cast<std::chrono::microseconds>(total).count() / kRounds
+            << " us per build, checksum " << checksum << std::endl;
+}
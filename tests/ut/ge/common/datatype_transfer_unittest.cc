@@ -16,6 +16,12 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
 #include "common/formats/format_transfers/datatype_transfer.h"
 
 #include "common/formats/format_transfers/format_transfer.h"
@@ -397,5 +403,148 @@ TEST_F(UtestDataTypeTransfer, unsupprot_trans2) {
   EXPECT_EQ(transfer.TransDataType(args, result), UNSUPPORTED);
   EXPECT_EQ(TransDataType(args, result), UNSUPPORTED);
 }
+namespace {
+template <typename SrcT, typename DstT>
+std::vector<DstT> Cast(const std::vector<SrcT> &src, DataType src_data_type, DataType dst_data_type) {
+  TransResult result;
+  CastArgs args{reinterpret_cast<const uint8_t *>(src.data()), src.size(), src_data_type, dst_data_type};
+  EXPECT_EQ(TransDataType(args, result), SUCCESS);
+  EXPECT_EQ(result.length, src.size() * sizeof(DstT));
+  const DstT *dst = reinterpret_cast<const DstT *>(result.data.get());
+  return std::vector<DstT>(dst, dst + src.size());
+}
+
+uint32_t FloatBits(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+float BitsToFloat(uint32_t bits) {
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+uint16_t ToFp16(float value) {
+  fp16_t fp16;
+  fp16 = value;
+  return fp16.val;
+}
+
+template <typename SrcT, typename DstT>
+void ExpectStaticCast(DataType src_data_type, DataType dst_data_type) {
+  // odd length so the vectorized casts leave a scalar tail
+  std::vector<SrcT> src(1003);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<SrcT>((i * 2654435761u) ^ (i << 7));
+  }
+  auto dst = Cast<SrcT, DstT>(src, src_data_type, dst_data_type);
+  for (size_t i = 0; i < src.size(); ++i) {
+    ASSERT_EQ(dst[i], static_cast<DstT>(src[i])) << "index " << i;
+  }
+}
+}  // namespace
+
+TEST_F(UtestDataTypeTransfer, fp16_all_values) {
+  std::vector<uint16_t> src(65536);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<uint16_t>(i);
+  }
+  auto floats = Cast<uint16_t, float>(src, DT_FLOAT16, DT_FLOAT);
+  auto ints = Cast<uint16_t, int32_t>(src, DT_FLOAT16, DT_INT32);
+  for (size_t i = 0; i < src.size(); ++i) {
+    fp16_t fp16;
+    fp16.val = src[i];
+    ASSERT_EQ(FloatBits(floats[i]), FloatBits(fp16.toFloat())) << "fp16 " << src[i];
+    ASSERT_EQ(ints[i], fp16.toInt32()) << "fp16 " << src[i];
+  }
+}
+
+TEST_F(UtestDataTypeTransfer, fp32_to_fp16_rounding) {
+  // every fp16 value, the midpoints between neighbours and one ulp around them
+  std::vector<float> src;
+  for (uint32_t i = 0; i < 0x7C00; ++i) {
+    fp16_t low;
+    low.val = static_cast<uint16_t>(i);
+    fp16_t high;
+    high.val = static_cast<uint16_t>(i + 1);
+    float mid = (low.toFloat() + high.toFloat()) / 2;
+    for (float value : {low.toFloat(), mid, BitsToFloat(FloatBits(mid) - 1), BitsToFloat(FloatBits(mid) + 1)}) {
+      src.push_back(value);
+      src.push_back(-value);
+    }
+  }
+  for (uint32_t bits : {0x00000001u, 0x007FFFFFu, 0x33000000u, 0x33000001u, 0x477FEFFFu, 0x477FF000u, 0x47800000u,
+                        0x4F000000u, 0x7F7FFFFFu, 0x7F800000u, 0x7FC00000u, 0x7F800001u}) {
+    src.push_back(BitsToFloat(bits));
+    src.push_back(BitsToFloat(bits | 0x80000000u));
+  }
+  auto dst = Cast<float, uint16_t>(src, DT_FLOAT, DT_FLOAT16);
+  for (size_t i = 0; i < src.size(); ++i) {
+    ASSERT_EQ(dst[i], ToFp16(src[i])) << "fp32 bits " << FloatBits(src[i]);
+  }
+}
+
+TEST_F(UtestDataTypeTransfer, int32_to_fp16_range) {
+  std::vector<int32_t> src;
+  for (int32_t i = -70000; i <= 70000; ++i) {
+    src.push_back(i);
+  }
+  for (int32_t value : {INT_MIN, INT_MIN + 1, INT_MAX, 1 << 24, (1 << 24) + 1, -(1 << 30)}) {
+    src.push_back(value);
+  }
+  auto dst = Cast<int32_t, uint16_t>(src, DT_INT32, DT_FLOAT16);
+  for (size_t i = 0; i < src.size(); ++i) {
+    fp16_t fp16;
+    fp16 = src[i];
+    ASSERT_EQ(dst[i], fp16.val) << "int32 " << src[i];
+  }
+}
+
+TEST_F(UtestDataTypeTransfer, integer_casts_with_tail) {
+  ExpectStaticCast<float, int32_t>(DT_FLOAT, DT_INT32);
+  ExpectStaticCast<int32_t, float>(DT_INT32, DT_FLOAT);
+  ExpectStaticCast<int32_t, uint8_t>(DT_INT32, DT_UINT8);
+  ExpectStaticCast<int32_t, int8_t>(DT_INT32, DT_INT8);
+  ExpectStaticCast<uint8_t, float>(DT_UINT8, DT_FLOAT);
+  ExpectStaticCast<uint8_t, int32_t>(DT_UINT8, DT_INT32);
+  ExpectStaticCast<int8_t, float>(DT_INT8, DT_FLOAT);
+  ExpectStaticCast<int8_t, int32_t>(DT_INT8, DT_INT32);
+  ExpectStaticCast<int64_t, int32_t>(DT_INT64, DT_INT32);
+}
+
+TEST_F(UtestDataTypeTransfer, fp32_fp16_large_buffer) {
+  // big enough to be split across threads
+  std::vector<float> src(3 * 1024 * 1024 + 5);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<float>(i % 100003) * 0.731f - 30000.0f;
+  }
+  auto dst = Cast<float, uint16_t>(src, DT_FLOAT, DT_FLOAT16);
+  for (size_t i = 0; i < src.size(); ++i) {
+    ASSERT_EQ(dst[i], ToFp16(src[i])) << "index " << i;
+  }
+}
+
+TEST_F(UtestDataTypeTransfer, DISABLED_benchmark_fp32_fp16) {
+  std::vector<float> src(16 * 1024 * 1024);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<float>(i % 4096) / 64.0f;
+  }
+  std::vector<uint16_t> scalar_dst(src.size());
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < src.size(); ++i) {
+    scalar_dst[i] = ToFp16(src[i]);
+  }
+  auto scalar_cost = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  auto dst = Cast<float, uint16_t>(src, DT_FLOAT, DT_FLOAT16);
+  auto cost = std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(dst, scalar_dst);
+  std::cout << "fp32 to fp16 of " << src.size() << " elements, scalar cost "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(scalar_cost).count() << " ms, cast cost "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(cost).count() << " ms" << std::endl;
+}
 }  // namespace formats
 }  // namespace ge
@@ -16,7 +16,13 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
 #include "common/formats/format_transfers/format_transfer_transpose.h"
+#include "common/formats/utils/formats_trans_utils.h"
 
 namespace ge {
 namespace formats {
@@ -4652,5 +4658,63 @@ TEST_F(UtestFormatTranspose, chwn_to_hwcn2) {
     EXPECT_EQ((reinterpret_cast<uint16_t *>(result.data.get()))[i], ret[i]);
   }
 }
+namespace {
+void ExpectSameAsReference(const std::vector<int64_t> &shape, const std::vector<int64_t> &perm, DataType data_type) {
+  std::vector<uint8_t> src(GetItemNumByShape(shape) * GetSizeByDataType(data_type));
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<uint8_t>((i * 131 + 7) % 251);
+  }
+  TransResult result;
+  TransResult reference;
+  ASSERT_EQ(Transpose(src.data(), shape, data_type, perm, result), SUCCESS);
+  ASSERT_EQ(TransposeByElement(src.data(), shape, data_type, perm, reference), SUCCESS);
+  ASSERT_EQ(result.length, reference.length);
+  EXPECT_EQ(memcmp(result.data.get(), reference.data.get(), result.length), 0)
+      << "shape " << ShapeToString(shape) << " perm " << ShapeToString(perm) << " data type " << data_type;
+}
+}  // namespace
+
+TEST_F(UtestFormatTranspose, all_perms_match_reference) {
+  // covers size 1 dims, dims that merge, tiles with tails and element sizes without a typed kernel
+  std::vector<std::vector<int64_t>> shapes = {{7}, {33, 65}, {1, 40, 3}, {5, 1, 37, 2},
+                                              {3, 34, 2, 33}, {2, 3, 1, 5, 7}};
+  std::vector<DataType> data_types = {DT_INT8, DT_FLOAT16, DT_FLOAT, DT_INT64, DT_COMPLEX128, DT_DUAL};
+  for (const auto &shape : shapes) {
+    std::vector<int64_t> perm(shape.size());
+    for (size_t i = 0; i < perm.size(); ++i) {
+      perm[i] = static_cast<int64_t>(i);
+    }
+    do {
+      for (auto data_type : data_types) {
+        ExpectSameAsReference(shape, perm, data_type);
+      }
+    } while (std::next_permutation(perm.begin(), perm.end()));
+  }
+}
+
+TEST_F(UtestFormatTranspose, large_shape_match_reference) {
+  // big enough to be split across threads
+  ExpectSameAsReference({4, 300, 50, 47}, {0, 2, 3, 1}, DT_FLOAT);
+  ExpectSameAsReference({4, 300, 50, 47}, {2, 3, 1, 0}, DT_FLOAT16);
+  ExpectSameAsReference({1, 1000, 1500}, {0, 2, 1}, DT_INT8);
+}
+
+TEST_F(UtestFormatTranspose, DISABLED_benchmark_transpose) {
+  std::vector<int64_t> shape = {32, 256, 56, 56};
+  std::vector<uint8_t> src(GetItemNumByShape(shape) * sizeof(float));
+  std::vector<std::vector<int64_t>> perms = {{0, 2, 3, 1}, {2, 3, 1, 0}, {1, 2, 3, 0}, {3, 0, 1, 2}};
+  for (const auto &perm : perms) {
+    TransResult result;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(Transpose(src.data(), shape, DT_FLOAT, perm, result), SUCCESS);
+    auto cost = std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    EXPECT_EQ(TransposeByElement(src.data(), shape, DT_FLOAT, perm, result), SUCCESS);
+    auto reference_cost = std::chrono::steady_clock::now() - start;
+    std::cout << "transpose " << ShapeToString(shape) << " by " << ShapeToString(perm) << " cost "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(cost).count() << " ms, by element cost "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(reference_cost).count() << " ms" << std::endl;
+  }
+}
 }  // namespace formats
 }  // namespace ge
\ No newline at end of file
@@ -16,10 +16,19 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include "common/formats/format_transfers/format_transfer_nc1hwc0_nchw.h"
+#include "common/formats/format_transfers/format_transfer_nc1hwc0_nhwc.h"
 #include "common/formats/format_transfers/format_transfer_nchw_nc1hwc0.h"
+#include "common/formats/format_transfers/format_transfer_nhwc_nc1hwc0.h"
 
 #include "common/formats/format_transfers/format_transfer.h"
+#include "common/formats/formats.h"
 #include "common/formats/utils/formats_trans_utils.h"
+#include "graph/utils/type_utils.h"
 
 namespace ge {
 namespace formats {
@@ -30,6 +39,130 @@ class UtestFormatTransfer : public testing::Test {
   void TearDown() {}
 };
 
+namespace {
+std::vector<int64_t> ShapeOf(Format format, int64_t n, int64_t c, int64_t h, int64_t w) {
+  switch (format) {
+    case FORMAT_NHWC:
+      return {n, h, w, c};
+    case FORMAT_HWCN:
+      return {h, w, c, n};
+    case FORMAT_CHWN:
+      return {c, h, w, n};
+    default:
+      return {n, c, h, w};
+  }
+}
+
+std::vector<uint8_t> MakeData(const std::vector<int64_t> &shape, DataType data_type) {
+  std::vector<uint8_t> data(GetItemNumByShape(shape) * GetSizeByDataType(data_type));
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>((i * 131 + 7) % 251);
+  }
+  return data;
+}
+
+template <typename T>
+void ExpectSameAsReference(const TransArgs &args) {
+  T transfer;
+  TransResult fast;
+  TransResult reference;
+  ASSERT_EQ(transfer.TransFormat(args, fast), SUCCESS);
+  ASSERT_EQ(transfer.TransFormatByElement(args, reference), SUCCESS);
+  ASSERT_EQ(fast.length, reference.length);
+  EXPECT_EQ(memcmp(fast.data.get(), reference.data.get(), fast.length), 0);
+}
+}  // namespace
+
+TEST_F(UtestFormatTransfer, nc1hwc0_transfers_match_reference) {
+  // {n, c, h, w}, covering c < c0, c % c0 == 0, c % c0 != 0, hw == 1 and a shape large enough to go parallel
+  std::vector<std::vector<int64_t>> dims_list = {{1, 1, 1, 1},    {1, 3, 4, 4},   {2, 16, 3, 5},    {2, 17, 5, 3},
+                                                 {3, 33, 1, 1},   {1, 70, 7, 9},  {8, 70, 64, 64}};
+  std::vector<DataType> data_types = {DT_UINT8, DT_FLOAT16, DT_FLOAT, DT_INT64};
+  for (const auto &dims : dims_list) {
+    int64_t n = dims[0];
+    int64_t c = dims[1];
+    int64_t h = dims[2];
+    int64_t w = dims[3];
+    for (auto data_type : data_types) {
+      if (n * c * h * w > 1000000 && data_type != DT_FLOAT) {
+        continue;
+      }
+      int64_t c0 = GetCubeSizeByDataType(data_type);
+      std::vector<int64_t> shape_5d = {n, Ceil(c, c0), h, w, c0};
+      auto nchw = MakeData(ShapeOf(FORMAT_NCHW, n, c, h, w), data_type);
+      auto nhwc = MakeData(ShapeOf(FORMAT_NHWC, n, c, h, w), data_type);
+      auto nc1hwc0 = MakeData(shape_5d, data_type);
+
+      ExpectSameAsReference<FormatTransferNchwNc1hwc0>(
+          {nchw.data(), FORMAT_NCHW, FORMAT_NC1HWC0, ShapeOf(FORMAT_NCHW, n, c, h, w), shape_5d, data_type});
+      ExpectSameAsReference<FormatTransferNhwcNc1hwc0>(
+          {nhwc.data(), FORMAT_NHWC, FORMAT_NC1HWC0, ShapeOf(FORMAT_NHWC, n, c, h, w), shape_5d, data_type});
+      ExpectSameAsReference<FormatTransferNc1hwc0Nchw>(
+          {nc1hwc0.data(), FORMAT_NC1HWC0, FORMAT_NCHW, shape_5d, ShapeOf(FORMAT_NCHW, n, c, h, w), data_type});
+      ExpectSameAsReference<FormatTransferNc1hwc0Nhwc>(
+          {nc1hwc0.data(), FORMAT_NC1HWC0, FORMAT_NHWC, shape_5d, ShapeOf(FORMAT_NHWC, n, c, h, w), data_type});
+    }
+  }
+}
+
+TEST_F(UtestFormatTransfer, DISABLED_benchmark_registered_transfers) {
+  struct TransferCase {
+    Format src_format;
+    Format dst_format;
+    // the plain format the packed side is derived from
+    Format plain_format;
+  };
+  std::vector<TransferCase> cases = {
+      {FORMAT_NCHW, FORMAT_NC1HWC0, FORMAT_NCHW},          {FORMAT_NHWC, FORMAT_NC1HWC0, FORMAT_NHWC},
+      {FORMAT_NC1HWC0, FORMAT_NCHW, FORMAT_NCHW},          {FORMAT_NC1HWC0, FORMAT_NHWC, FORMAT_NCHW},
+      {FORMAT_NCHW, FORMAT_FRACTAL_Z, FORMAT_NCHW},        {FORMAT_HWCN, FORMAT_FRACTAL_Z, FORMAT_HWCN},
+      {FORMAT_NHWC, FORMAT_FRACTAL_Z, FORMAT_NHWC},        {FORMAT_FRACTAL_Z, FORMAT_NCHW, FORMAT_NCHW},
+      {FORMAT_FRACTAL_Z, FORMAT_NHWC, FORMAT_NCHW},        {FORMAT_FRACTAL_Z, FORMAT_HWCN, FORMAT_NCHW},
+      {FORMAT_ND, FORMAT_FRACTAL_NZ, FORMAT_ND},           {FORMAT_NCHW, FORMAT_FRACTAL_NZ, FORMAT_NCHW},
+      {FORMAT_NHWC, FORMAT_FRACTAL_NZ, FORMAT_NHWC},       {FORMAT_FRACTAL_NZ, FORMAT_ND, FORMAT_ND},
+      {FORMAT_FRACTAL_NZ, FORMAT_NCHW, FORMAT_NCHW},       {FORMAT_FRACTAL_NZ, FORMAT_NHWC, FORMAT_NHWC},
+      {FORMAT_ND, FORMAT_FRACTAL_ZZ, FORMAT_ND},           {FORMAT_NCHW, FORMAT_FRACTAL_ZZ, FORMAT_NCHW},
+      {FORMAT_NHWC, FORMAT_FRACTAL_ZZ, FORMAT_NHWC},       {FORMAT_FRACTAL_ZZ, FORMAT_ND, FORMAT_ND},
+      {FORMAT_FRACTAL_ZZ, FORMAT_NCHW, FORMAT_NCHW},       {FORMAT_FRACTAL_ZZ, FORMAT_NHWC, FORMAT_NHWC},
+      {FORMAT_HWCN, FORMAT_C1HWNCoC0, FORMAT_HWCN},        {FORMAT_C1HWNCoC0, FORMAT_HWCN, FORMAT_HWCN},
+      {FORMAT_NCHW, FORMAT_NHWC, FORMAT_NCHW},             {FORMAT_NCHW, FORMAT_HWCN, FORMAT_NCHW},
+      {FORMAT_NCHW, FORMAT_CHWN, FORMAT_NCHW},             {FORMAT_NHWC, FORMAT_NCHW, FORMAT_NHWC},
+      {FORMAT_NHWC, FORMAT_CHWN, FORMAT_NHWC},             {FORMAT_NHWC, FORMAT_HWCN, FORMAT_NHWC},
+      {FORMAT_HWCN, FORMAT_NCHW, FORMAT_HWCN},             {FORMAT_HWCN, FORMAT_NHWC, FORMAT_HWCN},
+      {FORMAT_HWCN, FORMAT_CHWN, FORMAT_HWCN},             {FORMAT_CHWN, FORMAT_NCHW, FORMAT_CHWN},
+      {FORMAT_CHWN, FORMAT_NHWC, FORMAT_CHWN},             {FORMAT_CHWN, FORMAT_HWCN, FORMAT_CHWN},
+  };
+  std::vector<std::vector<int64_t>> dims_list = {{1, 3, 224, 224}, {32, 64, 56, 56}, {16, 255, 28, 28}};
+  const int kLoopCount = 5;
+  for (const auto &dims : dims_list) {
+    for (const auto &trans_case : cases) {
+      // 5d/fractal shapes can not be derived back to 4d, so build both sides from the same plain shape
+      auto plain_shape = ShapeOf(trans_case.plain_format, dims[0], dims[1], dims[2], dims[3]);
+      TransArgs args{nullptr, trans_case.src_format, trans_case.dst_format, {}, {}, DT_FLOAT16};
+      if (trans_case.src_format == trans_case.plain_format) {
+        args.src_shape = plain_shape;
+        ASSERT_EQ(TransShape(args.src_format, args.src_shape, DT_FLOAT16, args.dst_format, args.dst_shape), SUCCESS);
+      } else {
+        ASSERT_EQ(TransShape(trans_case.plain_format, plain_shape, DT_FLOAT16, args.src_format, args.src_shape),
+                  SUCCESS);
+        args.dst_shape = ShapeOf(args.dst_format, dims[0], dims[1], dims[2], dims[3]);
+      }
+      auto src = MakeData(args.src_shape, DT_FLOAT16);
+      args.data = src.data();
+
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < kLoopCount; ++i) {
+        TransResult result;
+        ASSERT_EQ(TransFormat(args, result), SUCCESS);
+      }
+      auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+      std::cout << "trans " << TypeUtils::FormatToSerialString(args.src_format) << " to "
+                << TypeUtils::FormatToSerialString(args.dst_format) << " shape " << ShapeToString(args.src_shape)
+                << " cost " << cost.count() / kLoopCount / 1000.0 << " ms" << std::endl;
+    }
+  }
+}
+
 TEST_F(UtestFormatTransfer, build_transfer_success) {
   uint8_t data[1 * 3 * 224 * 224 * 2];
   TransArgs args{data, FORMAT_NCHW, FORMAT_NC1HWC0, {1, 3, 224, 224}, {1, 1, 224, 224, 16}, DT_FLOAT16};
@@ -0,0 +1,170 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/blocking_queue.h"
+#include "common/lock_free_queue.h"
+
+namespace ge {
+class UtestLockFreeQueue : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+namespace {
+// every producer pushes item_num items of value 1, every consumer pops until it reads a 0
+template <typename Queue>
+uint64_t RunProducersConsumers(Queue &queue, uint32_t producer_num, uint32_t consumer_num, uint32_t item_num) {
+  std::atomic<uint64_t> sum(0);
+  std::vector<std::thread> consumers;
+  for (uint32_t i = 0; i < consumer_num; ++i) {
+    consumers.emplace_back([&queue, &sum]() {
+      uint64_t local_sum = 0;
+      std::shared_ptr<uint32_t> item;
+      while (queue.Pop(item) && (*item != 0)) {
+        local_sum += *item;
+      }
+      sum += local_sum;
+    });
+  }
+  std::vector<std::thread> producers;
+  for (uint32_t i = 0; i < producer_num; ++i) {
+    producers.emplace_back([&queue, item_num]() {
+      auto item = std::make_shared<uint32_t>(1);
+      for (uint32_t j = 0; j < item_num; ++j) {
+        queue.Push(item);
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  for (uint32_t i = 0; i < consumer_num; ++i) {
+    queue.Push(std::make_shared<uint32_t>(0));
+  }
+  for (auto &consumer : consumers) {
+    consumer.join();
+  }
+  return sum;
+}
+}  // namespace
+
+TEST_F(UtestLockFreeQueue, push_pop_in_order) {
+  LockFreeQueue<int> queue(4);
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 4; ++i) {
+      EXPECT_TRUE(queue.Push(round * 4 + i, false));
+    }
+    EXPECT_TRUE(queue.IsFull());
+    EXPECT_FALSE(queue.Push(100, false));
+    for (int i = 0; i < 4; ++i) {
+      int item = -1;
+      EXPECT_TRUE(queue.Pop(item));
+      EXPECT_EQ(item, round * 4 + i);
+    }
+    EXPECT_FALSE(queue.IsFull());
+  }
+}
+
+TEST_F(UtestLockFreeQueue, pop_released_item) {
+  LockFreeQueue<std::shared_ptr<int>> queue(2);
+  auto item = std::make_shared<int>(1);
+  EXPECT_TRUE(queue.Push(item));
+  std::shared_ptr<int> popped;
+  EXPECT_TRUE(queue.Pop(popped));
+  popped.reset();
+  // the ring does not keep a reference to a popped item
+  EXPECT_EQ(item.use_count(), 1);
+}
+
+TEST_F(UtestLockFreeQueue, stop_wakes_up_waiters) {
+  LockFreeQueue<int> queue(1);
+  std::thread consumer([&queue]() {
+    int item = 0;
+    EXPECT_FALSE(queue.Pop(item));
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  queue.Stop();
+  consumer.join();
+
+  queue.Restart();
+  EXPECT_TRUE(queue.Push(1));
+  std::thread producer([&queue]() { EXPECT_FALSE(queue.Push(2)); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  queue.Stop();
+  producer.join();
+  EXPECT_FALSE(queue.Push(3));
+}
+
+TEST_F(UtestLockFreeQueue, get_remain_items_after_stop) {
+  LockFreeQueue<int> queue(8);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(queue.Push(i));
+  }
+  EXPECT_TRUE(queue.GetRemainItems().empty());
+  queue.Stop();
+  auto items = queue.GetRemainItems();
+  ASSERT_EQ(items.size(), 5);
+  int expect = 0;
+  for (int item : items) {
+    EXPECT_EQ(item, expect++);
+  }
+
+  queue.Restart();
+  EXPECT_TRUE(queue.Push(1));
+  queue.Clear();
+  EXPECT_TRUE(queue.Push(2));
+  int item = 0;
+  EXPECT_TRUE(queue.Pop(item));
+  EXPECT_EQ(item, 2);
+}
+
+TEST_F(UtestLockFreeQueue, multi_producer_multi_consumer) {
+  LockFreeQueue<std::shared_ptr<uint32_t>> queue(16);
+  EXPECT_EQ(RunProducersConsumers(queue, 8, 4, 10000), 8 * 10000);
+}
+
+TEST_F(UtestLockFreeQueue, DISABLED_benchmark_contention) {
+  const uint32_t total_items = 1 << 20;
+  for (uint32_t producer_num = 1; producer_num <= 64; producer_num *= 2) {
+    uint32_t item_num = total_items / producer_num;
+
+    BlockingQueue<std::shared_ptr<uint32_t>> blocking_queue;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(RunProducersConsumers(blocking_queue, producer_num, 1, item_num), total_items);
+    auto blocking_cost =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    LockFreeQueue<std::shared_ptr<uint32_t>> lock_free_queue;
+    start = std::chrono::steady_clock::now();
+    EXPECT_EQ(RunProducersConsumers(lock_free_queue, producer_num, 1, item_num), total_items);
+    auto lock_free_cost =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << producer_num << " producers, BlockingQueue cost " << blocking_cost << " ms, LockFreeQueue cost "
+              << lock_free_cost << " ms" << std::endl;
+  }
+}
+}  // namespace ge
@@ -0,0 +1,230 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "common/helper/model_helper.h"
+#include "common/helper/om_file_helper.h"
+#include "common/types.h"
+#include "graph/model.h"
+#include "graph/utils/graph_utils.h"
+#include "proto/ge_ir.pb.h"
+
+using namespace std;
+
+namespace ge {
+namespace {
+const char *const kBufferedFile = "ut_om_file_buffered.om";
+const char *const kStreamedFile = "ut_om_file_streamed.om";
+const char *const kModelFile = "ut_om_file_model.om";
+
+vector<uint8_t> ReadFile(const string &file_path) {
+  ifstream fs(file_path, ifstream::binary);
+  return vector<uint8_t>(istreambuf_iterator<char>(fs), istreambuf_iterator<char>());
+}
+
+vector<uint8_t> CreateData(size_t size, uint8_t seed) {
+  vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<uint8_t>((i + seed) % 251);
+  }
+  return data;
+}
+
+// writes the data in pieces of an uneven size
+PartitionProducer CreateProducer(const vector<uint8_t> &data, size_t piece_size) {
+  return [&data, piece_size](PartitionOutput &output) -> Status {
+    for (size_t offset = 0; offset < data.size(); offset += piece_size) {
+      Status ret = output.Write(data.data() + offset, min(piece_size, data.size() - offset));
+      if (ret != SUCCESS) {
+        return ret;
+      }
+    }
+    return SUCCESS;
+  };
+}
+
+// the attr maps are serialized in no fixed order unless asked to
+string DeterministicModelDef(const uint8_t *data, size_t size) {
+  proto::ModelDef model_def;
+  if (!model_def.ParseFromArray(data, static_cast<int>(size))) {
+    return "";
+  }
+  string bytes;
+  {
+    google::protobuf::io::StringOutputStream string_stream(&bytes);
+    google::protobuf::io::CodedOutputStream coded_stream(&string_stream);
+    coded_stream.SetSerializationDeterministic(true);
+    (void)model_def.SerializeToCodedStream(&coded_stream);
+  }
+  return bytes;
+}
+
+ModelPartition CreatePartition(ModelPartitionType type, const vector<uint8_t> &data) {
+  ModelPartition partition;
+  partition.type = type;
+  partition.data = const_cast<uint8_t *>(data.data());
+  partition.size = static_cast<uint32_t>(data.size());
+  return partition;
+}
+
+GeModelPtr CreateGeModel(const vector<uint8_t> &weights) {
+  auto compute_graph = make_shared<ComputeGraph>("graph");
+  (void)compute_graph->AddNode(make_shared<OpDesc>("data", DATA));
+  auto ge_model = make_shared<GeModel>();
+  ge_model->SetName("model");
+  ge_model->SetGraph(GraphUtils::CreateGraphFromComputeGraph(compute_graph));
+  ge_model->SetWeight(Buffer::CopyFrom(weights.data(), weights.size()));
+  auto task_def = make_shared<domi::ModelTaskDef>();
+  task_def->set_memory_size(weights.size());
+  task_def->set_stream_num(1);
+  ge_model->SetModelTaskDef(task_def);
+  return ge_model;
+}
+}  // namespace
+
+class UtestOmFileHelper : public testing::Test {
+ protected:
+  void TearDown() {
+    (void)remove(kBufferedFile);
+    (void)remove(kStreamedFile);
+    (void)remove(kModelFile);
+  }
+};
+
+TEST_F(UtestOmFileHelper, streamed_partitions_equal_buffered) {
+  vector<uint8_t> model_def = CreateData(1000, 1);
+  vector<uint8_t> weights = CreateData(3 * 4096 + 7, 2);
+  vector<uint8_t> task_info = CreateData(333, 3);
+
+  OmFileSaveHelper buffered;
+  ModelPartition model_def_partition = CreatePartition(ModelPartitionType::MODEL_DEF, model_def);
+  ModelPartition weights_partition = CreatePartition(ModelPartitionType::WEIGHTS_DATA, weights);
+  ModelPartition task_info_partition = CreatePartition(ModelPartitionType::TASK_INFO, task_info);
+  ASSERT_EQ(buffered.AddPartition(model_def_partition), SUCCESS);
+  ASSERT_EQ(buffered.AddPartition(weights_partition), SUCCESS);
+  ASSERT_EQ(buffered.AddPartition(task_info_partition), SUCCESS);
+  ASSERT_EQ(buffered.SaveModelToFile(kBufferedFile), SUCCESS);
+
+  // producers and data may be mixed
+  OmFileSaveHelper streamed;
+  ASSERT_EQ(streamed.AddPartition(ModelPartitionType::MODEL_DEF, model_def.size(), CreateProducer(model_def, 7)),
+            SUCCESS);
+  ASSERT_EQ(streamed.AddPartition(weights_partition), SUCCESS);
+  ASSERT_EQ(streamed.AddPartition(ModelPartitionType::TASK_INFO, task_info.size(), CreateProducer(task_info, 100)),
+            SUCCESS);
+  EXPECT_EQ(streamed.GetModelDataSize(), buffered.GetModelDataSize());
+  ASSERT_EQ(streamed.SaveModelToFile(kStreamedFile), SUCCESS);
+
+  vector<uint8_t> buffered_file = ReadFile(kBufferedFile);
+  vector<uint8_t> streamed_file = ReadFile(kStreamedFile);
+  size_t table_size = sizeof(ModelPartitionTable) + 3 * sizeof(ModelPartitionMemInfo);
+  ASSERT_EQ(buffered_file.size(), sizeof(ModelFileHeader) + table_size + model_def.size() + weights.size() +
+                                      task_info.size());
+  EXPECT_TRUE(streamed_file == buffered_file);
+}
+
+TEST_F(UtestOmFileHelper, partition_of_wrong_size_fails) {
+  vector<uint8_t> data = CreateData(100, 1);
+
+  OmFileSaveHelper short_partition;
+  ASSERT_EQ(short_partition.AddPartition(ModelPartitionType::MODEL_DEF, data.size() + 1, CreateProducer(data, 10)),
+            SUCCESS);
+  EXPECT_NE(short_partition.SaveModelToFile(kStreamedFile), SUCCESS);
+
+  OmFileSaveHelper long_partition;
+  ASSERT_EQ(long_partition.AddPartition(ModelPartitionType::MODEL_DEF, data.size() - 1, CreateProducer(data, 10)),
+            SUCCESS);
+  EXPECT_NE(long_partition.SaveModelToFile(kStreamedFile), SUCCESS);
+
+  OmFileSaveHelper failed_partition;
+  ASSERT_EQ(failed_partition.AddPartition(ModelPartitionType::MODEL_DEF, data.size(),
+                                          [](PartitionOutput &) -> Status { return FAILED; }),
+            SUCCESS);
+  EXPECT_NE(failed_partition.SaveModelToFile(kStreamedFile), SUCCESS);
+
+  OmFileSaveHelper null_producer;
+  EXPECT_NE(null_producer.AddPartition(ModelPartitionType::MODEL_DEF, data.size(), nullptr), SUCCESS);
+}
+
+TEST_F(UtestOmFileHelper, save_ge_model_equal_to_buffered) {
+  vector<uint8_t> weights = CreateData(4096 + 13, 5);
+  GeModelPtr ge_model = CreateGeModel(weights);
+  SaveParam save_param;
+  ModelHelper model_helper;
+  ASSERT_EQ(model_helper.SaveToOmModel(ge_model, save_param, kModelFile), SUCCESS);
+  vector<uint8_t> streamed_file = ReadFile(kModelFile);
+  ASSERT_GT(streamed_file.size(), sizeof(ModelFileHeader));
+
+  // the partitions as they were serialized into memory before
+  Model model(ge_model->GetName(), ge_model->GetPlatformVersion());
+  model.SetGraph(ge_model->GetGraph());
+  model.SetVersion(ge_model->GetVersion());
+  model.SetAttr(ge_model->MutableAttrMap());
+  Buffer model_buffer;
+  ASSERT_EQ(model.Save(model_buffer), GRAPH_SUCCESS);
+  string task_buffer;
+  ASSERT_TRUE(ge_model->GetModelTaskDefPtr()->SerializePartialToString(&task_buffer));
+
+  OmFileSaveHelper buffered;
+  memcpy(&buffered.GetModelFileHeader(), streamed_file.data(), sizeof(ModelFileHeader));
+  ModelPartition model_def_partition;
+  model_def_partition.type = ModelPartitionType::MODEL_DEF;
+  model_def_partition.data = model_buffer.GetData();
+  model_def_partition.size = model_buffer.GetSize();
+  ModelPartition weights_partition = CreatePartition(ModelPartitionType::WEIGHTS_DATA, weights);
+  ModelPartition task_info_partition;
+  task_info_partition.type = ModelPartitionType::TASK_INFO;
+  task_info_partition.data = reinterpret_cast<uint8_t *>(&task_buffer[0]);
+  task_info_partition.size = task_buffer.size();
+  ASSERT_EQ(buffered.AddPartition(model_def_partition), SUCCESS);
+  ASSERT_EQ(buffered.AddPartition(weights_partition), SUCCESS);
+  ASSERT_EQ(buffered.AddPartition(task_info_partition), SUCCESS);
+  ASSERT_EQ(buffered.SaveModelToFile(kBufferedFile), SUCCESS);
+  vector<uint8_t> buffered_file = ReadFile(kBufferedFile);
+  ASSERT_EQ(buffered_file.size(), streamed_file.size());
+  size_t model_def_offset = sizeof(ModelFileHeader) + sizeof(ModelPartitionTable) + 3 * sizeof(ModelPartitionMemInfo);
+  size_t model_def_end = model_def_offset + model_buffer.GetSize();
+  EXPECT_EQ(DeterministicModelDef(streamed_file.data() + model_def_offset, model_buffer.GetSize()),
+            DeterministicModelDef(model_buffer.GetData(), model_buffer.GetSize()));
+  EXPECT_TRUE(equal(buffered_file.begin(), buffered_file.begin() + model_def_offset, streamed_file.begin()));
+  EXPECT_TRUE(equal(buffered_file.begin() + model_def_end, buffered_file.end(), streamed_file.begin() + model_def_end));
+
+  // and the saved model loads
+  ModelData model_data;
+  model_data.model_data = streamed_file.data();
+  model_data.model_len = streamed_file.size();
+  ModelHelper load_helper;
+  ASSERT_EQ(load_helper.LoadModel(model_data), SUCCESS);
+  GeModelPtr loaded = load_helper.GetGeModel();
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_EQ(loaded->GetModelTaskDefPtr()->memory_size(), weights.size());
+  const uint8_t *loaded_weights = loaded->GetWeightData();
+  ASSERT_EQ(loaded->GetWeightSize(), weights.size());
+  EXPECT_EQ(vector<uint8_t>(loaded_weights, loaded_weights + weights.size()), weights);
+}
+}  // namespace ge
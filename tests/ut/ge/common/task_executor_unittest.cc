@@ -0,0 +1,171 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "common/task_executor.h"
+#include "common/thread_pool.h"
+
+using namespace std;
+
+namespace ge {
+namespace {
+const size_t kBenchmarkTaskNum = 50000;
+
+// a few hundred nanoseconds like the init of a task
+uint64_t InitTask(size_t index) {
+  uint64_t hash = 14695981039346656037UL;
+  for (size_t i = 0; i < 64; ++i) {
+    hash = (hash ^ (index + i)) * 1099511628211UL;
+  }
+  return hash;
+}
+}  // namespace
+
+class UtestTaskExecutor : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+TEST_F(UtestTaskExecutor, commit_returns_results) {
+  vector<future<size_t>> futures;
+  for (size_t i = 0; i < 100; ++i) {
+    futures.push_back(TaskExecutor::Instance().commit([](size_t value) { return value * 2; }, i));
+  }
+  for (size_t i = 0; i < futures.size(); ++i) {
+    EXPECT_EQ(futures[i].get(), i * 2);
+  }
+
+  future<int> failed = TaskExecutor::Instance().commit([]() -> int { throw runtime_error("failed"); });
+  EXPECT_THROW(failed.get(), runtime_error);
+
+  uint32_t thread_num = TaskExecutor::Instance().GetThreadNum();
+  EXPECT_GE(thread_num, 1);
+  EXPECT_LE(thread_num, max(thread::hardware_concurrency(), 1U));
+  // the workers are started
+  EXPECT_NE(TaskExecutor::Instance().SetThreadNum(1), SUCCESS);
+}
+
+TEST_F(UtestTaskExecutor, parallel_for_runs_every_item_once) {
+  const size_t count = 10007;
+  vector<atomic<int>> runs(count);
+  for (auto &run : runs) {
+    run = 0;
+  }
+  Status ret = TaskExecutor::Instance().ParallelFor(count, 13, [&runs](size_t begin, size_t end) -> Status {
+    if (end <= begin || end - begin > 13) {
+      return FAILED;
+    }
+    for (size_t i = begin; i < end; ++i) {
+      ++runs[i];
+    }
+    return SUCCESS;
+  });
+  EXPECT_EQ(ret, SUCCESS);
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(runs[i], 1) << "item " << i;
+  }
+
+  EXPECT_EQ(TaskExecutor::Instance().ParallelFor(0, 1, nullptr), SUCCESS);
+  EXPECT_EQ(TaskExecutor::Instance().ParallelFor(1, 0, [](size_t begin, size_t end) -> Status {
+    return (begin == 0 && end == 1) ? SUCCESS : FAILED;
+  }), SUCCESS);
+}
+
+TEST_F(UtestTaskExecutor, parallel_for_returns_failure) {
+  atomic<size_t> run_num(0);
+  Status ret = TaskExecutor::Instance().ParallelFor(1000, 1, [&run_num](size_t begin, size_t end) -> Status {
+    ++run_num;
+    return begin == 10 ? PARAM_INVALID : SUCCESS;
+  });
+  EXPECT_EQ(ret, PARAM_INVALID);
+  EXPECT_LT(run_num, 1000);
+
+  ret = TaskExecutor::Instance().ParallelFor(10, 1, [](size_t begin, size_t end) -> Status {
+    if (begin == 5) {
+      throw runtime_error("failed");
+    }
+    return SUCCESS;
+  });
+  EXPECT_EQ(ret, FAILED);
+}
+
+TEST_F(UtestTaskExecutor, nested_parallel_for_does_not_block_workers) {
+  // more tasks than workers, every one waits for a parallel for of its own
+  size_t task_num = TaskExecutor::Instance().GetThreadNum() * 4 + 1;
+  vector<future<Status>> futures;
+  atomic<size_t> item_num(0);
+  for (size_t i = 0; i < task_num; ++i) {
+    futures.push_back(TaskExecutor::Instance().commit([&item_num]() -> Status {
+      return TaskExecutor::Instance().ParallelFor(100, 3, [&item_num](size_t begin, size_t end) -> Status {
+        return TaskExecutor::Instance().ParallelFor(end - begin, 1, [&item_num](size_t inner_begin, size_t inner_end) {
+          item_num += inner_end - inner_begin;
+          return SUCCESS;
+        });
+      });
+    }));
+  }
+  for (auto &task_future : futures) {
+    EXPECT_EQ(task_future.get(), SUCCESS);
+  }
+  EXPECT_EQ(item_num, task_num * 100);
+}
+
+TEST_F(UtestTaskExecutor, DISABLED_benchmark_init_tasks) {
+  vector<uint64_t> results(kBenchmarkTaskNum);
+
+  // a pool per model and a future per task
+  auto start = chrono::steady_clock::now();
+  {
+    ThreadPool executor(16);
+    vector<future<Status>> futures(kBenchmarkTaskNum);
+    for (size_t i = 0; i < kBenchmarkTaskNum; ++i) {
+      futures[i] = executor.commit(
+          [&results](size_t index) -> Status {
+            results[index] = InitTask(index);
+            return SUCCESS;
+          },
+          i);
+    }
+    for (auto &task_future : futures) {
+      ASSERT_EQ(task_future.get(), SUCCESS);
+    }
+  }
+  auto cost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+  cout << "init " << kBenchmarkTaskNum << " tasks on thread pool cost " << cost << " ms" << endl;
+
+  start = chrono::steady_clock::now();
+  Status ret = TaskExecutor::Instance().ParallelFor(kBenchmarkTaskNum, 64, [&results](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      results[i] = InitTask(i);
+    }
+    return SUCCESS;
+  });
+  ASSERT_EQ(ret, SUCCESS);
+  cost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+  cout << "init " << kBenchmarkTaskNum << " tasks on task executor cost " << cost << " ms" << endl;
+}
+}  // namespace ge
@@ -0,0 +1,202 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/tracer.h"
+#include "framework/common/debug/ge_log.h"
+
+using namespace std;
+
+namespace ge {
+class UtestTracerPass {};
+
+namespace {
+size_t CountEvents(const vector<TraceEvent> &events, const string &name) {
+  size_t count = 0;
+  for (const auto &event : events) {
+    count += (name == event.name) ? 1 : 0;
+  }
+  return count;
+}
+}  // namespace
+
+class UtestTracer : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() { (void)Tracer::Instance().Stop(); }
+};
+
+TEST_F(UtestTracer, spans_recorded_only_when_on) {
+  { GE_TRACE_SCOPE("stage"); }
+  Tracer::Instance().Start("");
+  EXPECT_TRUE(Tracer::IsOn());
+  EXPECT_TRUE(IsTraceOn());
+  EXPECT_TRUE(Tracer::Instance().Collect().empty());
+
+  {
+    GE_TRACE_SCOPE("stage");
+    GE_TRACE_SCOPE(string("built_") + "stage");
+    GE_TRACE_SCOPE(typeid(UtestTracerPass));
+    GE_TIMESTAMP_START(Timestamp);
+    GE_TIMESTAMP_END(Timestamp, "timestamp_stage");
+  }
+  EXPECT_EQ(Tracer::Instance().Stop(), SUCCESS);
+  { GE_TRACE_SCOPE("stage"); }
+
+  vector<TraceEvent> events = Tracer::Instance().Collect();
+  ASSERT_EQ(events.size(), 4);
+  EXPECT_EQ(CountEvents(events, "stage"), 1);
+  EXPECT_EQ(CountEvents(events, "built_stage"), 1);
+  EXPECT_EQ(CountEvents(events, "ge::UtestTracerPass"), 1);
+  EXPECT_EQ(CountEvents(events, "timestamp_stage"), 1);
+  for (size_t i = 1; i < events.size(); ++i) {
+    EXPECT_LE(events[i - 1].start, events[i].start);
+  }
+}
+
+TEST_F(UtestTracer, spans_of_threads_and_requests) {
+  Tracer::Instance().Start("");
+  const uint32_t thread_num = 4;
+  const uint32_t span_num = 100;
+  vector<thread> threads;
+  vector<uint64_t> request_ids;
+  for (uint32_t i = 0; i < thread_num; ++i) {
+    request_ids.push_back(Tracer::NewRequestId());
+  }
+  for (uint32_t i = 0; i < thread_num; ++i) {
+    threads.emplace_back([i, span_num, &request_ids]() {
+      TraceRequestScope request_scope(request_ids[i]);
+      for (uint32_t j = 0; j < span_num; ++j) {
+        GE_TRACE_SCOPE("worker");
+      }
+    });
+  }
+  for (auto &worker : threads) {
+    worker.join();
+  }
+  EXPECT_EQ(Tracer::GetRequestId(), 0);
+
+  vector<TraceEvent> events = Tracer::Instance().Collect();
+  ASSERT_EQ(events.size(), thread_num * span_num);
+  // every thread writes its own ring, all under the request it set
+  vector<uint32_t> request_nums(thread_num, 0);
+  for (const auto &event : events) {
+    ASSERT_LT(event.thread_index, thread_num);
+    EXPECT_GE(event.request_id, request_ids[0]);
+    ++request_nums[event.request_id - request_ids[0]];
+  }
+  for (uint32_t num : request_nums) {
+    EXPECT_EQ(num, span_num);
+  }
+  EXPECT_EQ(Tracer::Instance().GetDropNum(), 0);
+}
+
+TEST_F(UtestTracer, ring_keeps_newest_spans) {
+  Tracer::Instance().Start("", 8);
+  for (uint64_t i = 0; i < 20; ++i) {
+    Tracer::Instance().Record("span", i * 10, i * 10 + i);
+  }
+  // the oldest one of a full ring may be being overwritten, it is skipped
+  vector<TraceEvent> events = Tracer::Instance().Collect();
+  ASSERT_EQ(events.size(), 7);
+  EXPECT_EQ(events.front().start, 130);
+  EXPECT_EQ(events.back().start, 190);
+  EXPECT_EQ(Tracer::Instance().GetDropNum(), 12);
+
+  // a new start clears them
+  Tracer::Instance().Start("");
+  EXPECT_TRUE(Tracer::Instance().Collect().empty());
+  EXPECT_EQ(Tracer::Instance().GetDropNum(), 0);
+}
+
+TEST_F(UtestTracer, summarize_percentiles) {
+  Tracer::Instance().Start("");
+  for (uint64_t i = 1; i <= 100; ++i) {
+    Tracer::Instance().Record("short", 0, i);
+  }
+  Tracer::Instance().Record("long", 0, 100000);
+  vector<TraceStats> stats = Tracer::Instance().Summarize();
+  ASSERT_EQ(stats.size(), 2);
+  EXPECT_EQ(stats[0].name, "long");
+  EXPECT_EQ(stats[0].count, 1);
+  EXPECT_EQ(stats[0].p99, 100000);
+  EXPECT_EQ(stats[1].name, "short");
+  EXPECT_EQ(stats[1].count, 100);
+  EXPECT_EQ(stats[1].total, 5050);
+  EXPECT_EQ(stats[1].p50, 50);
+  EXPECT_EQ(stats[1].p90, 90);
+  EXPECT_EQ(stats[1].p99, 99);
+  EXPECT_EQ(stats[1].max, 100);
+}
+
+TEST_F(UtestTracer, dump_chrome_trace) {
+  const string file = "./ut_tracer_dump.json";
+  Tracer::Instance().Start(file);
+  {
+    TraceRequestScope request_scope(7);
+    Tracer::Instance().Record("run \"graph\"", 1000, 1500);
+  }
+  EXPECT_EQ(Tracer::Instance().Stop(), SUCCESS);
+
+  ifstream in(file);
+  ASSERT_TRUE(in.is_open());
+  stringstream content;
+  content << in.rdbuf();
+  string json = content.str();
+  EXPECT_EQ(json.find("{\"traceEvents\":["), 0);
+  EXPECT_NE(json.find("\"name\":\"run \\\"graph\\\"\""), string::npos);
+  EXPECT_NE(json.find("\"ph\":\"X\""), string::npos);
+  EXPECT_NE(json.find("\"ts\":1000,\"dur\":500,\"args\":{\"request\":7}"), string::npos);
+  (void)remove(file.c_str());
+}
+
+TEST_F(UtestTracer, DISABLED_benchmark_trace_scope) {
+  const uint32_t span_num = 1000000;
+  auto start = chrono::steady_clock::now();
+  for (uint32_t i = 0; i < span_num; ++i) {
+    GE_TRACE_SCOPE("off");
+  }
+  auto cost = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count() / span_num;
+  cout << "span when off cost " << cost << " ns" << endl;
+
+  Tracer::Instance().Start("");
+  start = chrono::steady_clock::now();
+  for (uint32_t i = 0; i < span_num; ++i) {
+    GE_TRACE_SCOPE("on");
+  }
+  cost = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count() / span_num;
+  cout << "span when on cost " << cost << " ns" << endl;
+
+  start = chrono::steady_clock::now();
+  for (uint32_t i = 0; i < span_num / 1000; ++i) {
+    uint64_t begin = GetCurrentTimestap();
+    GEEVENT("[GEPERFTRACE] The time cost of %s is [%lu] micro second.", "log", GetCurrentTimestap() - begin);
+  }
+  cost = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count() / (span_num / 1000);
+  cout << "timestamp log cost " << cost << " ns" << endl;
+}
+}  // namespace ge
@@ -15,6 +15,10 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
 #include <memory>
 
 #include "graph/anchor.h"
@@ -24,12 +28,14 @@
 #include "graph/utils/node_utils.h"
 #include "graph/utils/op_desc_utils.h"
 #include "graph/utils/tensor_utils.h"
+#include "graph/ge_local_context.h"
 #include "omg/omg_inner_types.h"
 
 #define protected public
 #define private public
 #include "graph/build/memory/binary_block_mem_assigner.h"
 #include "graph/build/memory/hybrid_mem_assigner.h"
+#include "graph/build/memory/lifetime_mem_assigner.h"
 #include "graph/build/memory/max_block_mem_assigner.h"
 #undef protected
 #undef private
@@ -141,6 +147,66 @@ class UtestMemoryAssignerTest : public testing::Test {
     graph->TopologicalSorting();
   }
 
+  // op i consumes the outputs of ops i - 1 and i - skip, output sizes cycle through sizes
+  void make_chain_graph(ge::ComputeGraphPtr graph, int op_num, int skip, const vector<uint32_t> &sizes) {
+    vector<ge::NodePtr> nodes;
+    for (int i = 0; i < op_num; ++i) {
+      ge::OpDescPtr op_def = make_shared<ge::OpDesc>("op" + std::to_string(i), "some");
+      ge::GeTensorDesc desc;
+      TensorUtils::SetSize(desc, sizes[i % sizes.size()]);
+      op_def->AddInputDesc(desc);
+      op_def->AddInputDesc(desc);
+      op_def->AddOutputDesc(desc);
+      op_def->SetWorkspaceBytes({static_cast<int64_t>(sizes[(i + 1) % sizes.size()] / 4)});
+      op_def->SetStreamId(0);
+      nodes.emplace_back(graph->AddNode(op_def));
+      if (i > 0) {
+        ge::GraphUtils::AddEdge(nodes[i - 1]->GetOutDataAnchor(0), nodes[i]->GetInDataAnchor(0));
+      }
+      if ((skip > 1) && (i >= skip)) {
+        ge::GraphUtils::AddEdge(nodes[i - skip]->GetOutDataAnchor(0), nodes[i]->GetInDataAnchor(1));
+      }
+    }
+    graph->TopologicalSorting();
+  }
+
+  // memory blocks whose tensors are alive at the same step must not overlap
+  void check_no_live_overlap(ge::ComputeGraphPtr graph, const vector<MemoryBlock *> &blocks) {
+    map<const Node *, size_t> steps;
+    size_t step_num = 0;
+    for (const auto &node : graph->GetDirectNode()) {
+      steps[node.get()] = step_num++;
+    }
+    vector<pair<size_t, size_t>> lives;
+    for (auto block : blocks) {
+      size_t first = step_num;
+      size_t last = 0;
+      for (const auto &node_type_index : block->NodeTypeIndexList()) {
+        size_t step = steps[node_type_index.node_.get()];
+        first = std::min(first, step);
+        last = std::max(last, step);
+        if (node_type_index.mem_type_ != kOutput) {
+          continue;
+        }
+        auto out_anchor = node_type_index.node_->GetOutDataAnchor(node_type_index.index_);
+        for (const auto &in_anchor : out_anchor->GetPeerInDataAnchors()) {
+          last = std::max(last, steps[in_anchor->GetOwnerNode().get()]);
+        }
+      }
+      lives.emplace_back(first, last);
+    }
+    for (size_t i = 0; i < blocks.size(); ++i) {
+      for (size_t j = i + 1; j < blocks.size(); ++j) {
+        if ((lives[i].second < lives[j].first) || (lives[j].second < lives[i].first)) {
+          continue;
+        }
+        EXPECT_TRUE((blocks[i]->TailOffset() < blocks[j]->HeadOffset()) ||
+                    (blocks[j]->TailOffset() < blocks[i]->HeadOffset()))
+            << blocks[i]->String() << " overlaps " << blocks[j]->String();
+      }
+    }
+  }
+
  protected:
   void SetUp() {}
 
@@ -182,3 +248,99 @@ TEST_F(UtestMemoryAssignerTest, Mock_block_mem_assigner_failed) {
 
   EXPECT_EQ(mock_assigner.Assign(), FAILED);
 }
+
+TEST_F(UtestMemoryAssignerTest, lifetime_mem_assigner_no_live_overlap) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+  make_graph(graph);
+  LifetimeMemAssigner lifetime_assigner(graph);
+
+  EXPECT_EQ(lifetime_assigner.Assign(), SUCCESS);
+  EXPECT_GT(lifetime_assigner.GetMemOffset(), 0);
+  check_no_live_overlap(graph, lifetime_assigner.memory_blocks_);
+}
+
+TEST_F(UtestMemoryAssignerTest, lifetime_mem_assigner_reuse_chain) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+  make_chain_graph(graph, 8, 0, {1024});
+  LifetimeMemAssigner lifetime_assigner(graph);
+
+  EXPECT_EQ(lifetime_assigner.Assign(), SUCCESS);
+  check_no_live_overlap(graph, lifetime_assigner.memory_blocks_);
+  // the outputs take turns in two places and the workspaces share one, the last op has no consumer so its
+  // output and workspace do not reuse memory
+  EXPECT_EQ(lifetime_assigner.GetMemOffset(), 1024 + 1024 + 512 + 1024 + 512);
+}
+
+TEST_F(UtestMemoryAssignerTest, lifetime_mem_assigner_reuse_input) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+  make_reuse_graph(graph);
+  LifetimeMemAssigner lifetime_assigner(graph);
+
+  EXPECT_EQ(lifetime_assigner.Assign(), SUCCESS);
+  check_no_live_overlap(graph, lifetime_assigner.memory_blocks_);
+  auto node_a = graph->FindNode("A");
+  auto node_c = graph->FindNode("C");
+  ASSERT_NE(node_a, nullptr);
+  ASSERT_NE(node_c, nullptr);
+  EXPECT_EQ(node_a->GetOpDesc()->GetOutputOffset().at(0), node_c->GetOpDesc()->GetOutputOffset().at(0));
+}
+
+TEST_F(UtestMemoryAssignerTest, hybrid_mem_assigner_use_smallest) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+  make_chain_graph(graph, 64, 3, {1024, 4096, 512, 30000, 2048});
+
+  size_t min_size = SIZE_MAX;
+  BinaryBlockMemAssigner binary_assigner(graph);
+  EXPECT_EQ(binary_assigner.Assign(), SUCCESS);
+  min_size = std::min(min_size, binary_assigner.GetMemOffset());
+  MaxBlockMemAssigner max_assigner(graph);
+  EXPECT_EQ(max_assigner.Assign(), SUCCESS);
+  min_size = std::min(min_size, max_assigner.GetMemOffset());
+  LifetimeMemAssigner lifetime_assigner(graph);
+  EXPECT_EQ(lifetime_assigner.Assign(), SUCCESS);
+  check_no_live_overlap(graph, lifetime_assigner.memory_blocks_);
+  min_size = std::min(min_size, lifetime_assigner.GetMemOffset());
+
+  HybridMemAssigner hybrid_assigner(graph);
+  EXPECT_EQ(hybrid_assigner.Assign(), SUCCESS);
+  EXPECT_EQ(hybrid_assigner.GetMemOffset(), min_size);
+}
+
+TEST_F(UtestMemoryAssignerTest, hybrid_mem_assigner_disable_reuse) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+  make_chain_graph(graph, 8, 0, {1024});
+  GetThreadLocalContext().SetSessionOption({{"ge.exec.disableReuseMemory", "1"}});
+  HybridMemAssigner hybrid_assigner(graph);
+  Status ret = hybrid_assigner.Assign();
+  GetThreadLocalContext().SetSessionOption({});
+
+  // the assigners run on other threads but must still see the session option
+  EXPECT_EQ(ret, SUCCESS);
+  EXPECT_EQ(hybrid_assigner.GetMemOffset(), 8 * (1024 + 512));
+}
+
+TEST_F(UtestMemoryAssignerTest, DISABLED_benchmark_mem_assigners) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+  make_chain_graph(graph, 4000, 7, {1024, 65536, 4096, 300000, 16384, 2048, 131072});
+
+  auto run = [](const string &name, BlockMemAssigner &assigner) {
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(assigner.Assign(), SUCCESS);
+    auto cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << name << " memory size " << assigner.GetMemOffset() << ", cost " << cost.count() << " ms"
+              << std::endl;
+  };
+  BinaryBlockMemAssigner binary_assigner(graph);
+  run("binary-block", binary_assigner);
+  MaxBlockMemAssigner max_assigner(graph);
+  run("max-block", max_assigner);
+  LifetimeMemAssigner lifetime_assigner(graph);
+  run("lifetime", lifetime_assigner);
+
+  HybridMemAssigner hybrid_assigner(graph);
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(hybrid_assigner.Assign(), SUCCESS);
+  auto cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  std::cout << "hybrid memory size " << hybrid_assigner.GetMemOffset() << ", cost " << cost.count() << " ms"
+            << std::endl;
+}
@@ -0,0 +1,219 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#define private public
+#include "graph/manager/caching_allocator.h"
+#undef private
+
+using namespace std;
+
+namespace ge {
+class UtestCachingAllocator : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+TEST_F(UtestCachingAllocator, bin_size) {
+  EXPECT_EQ(CachingAllocator::GetBinSize(0), 512);
+  EXPECT_EQ(CachingAllocator::GetBinSize(1), 512);
+  EXPECT_EQ(CachingAllocator::GetBinSize(512), 512);
+  EXPECT_EQ(CachingAllocator::GetBinSize(513), 640);
+  EXPECT_EQ(CachingAllocator::GetBinSize(1000), 1024);
+  EXPECT_EQ(CachingAllocator::GetBinSize(1025), 1280);
+  EXPECT_EQ(CachingAllocator::GetBinSize(3 * 1024 * 1024 + 1), 3584 * 1024);
+  // the large blocks are aligned only
+  EXPECT_EQ(CachingAllocator::GetBinSize(100UL * 1024 * 1024 + 1), 102UL * 1024 * 1024);
+}
+
+TEST_F(UtestCachingAllocator, reuse_freed_blocks) {
+  CachingAllocator allocator(RT_MEMORY_HBM, false, 1UL << 20);
+  uint8_t *addr1 = allocator.Malloc(1000);
+  uint8_t *addr2 = allocator.Malloc(1000);
+  ASSERT_NE(addr1, nullptr);
+  ASSERT_NE(addr2, nullptr);
+  EXPECT_EQ(allocator.Free(addr1), SUCCESS);
+  EXPECT_EQ(allocator.Free(addr1), PARAM_INVALID);
+  EXPECT_EQ(allocator.Free(addr2), SUCCESS);
+
+  // the most recently freed of the bin first
+  EXPECT_EQ(allocator.Malloc(900), addr2);
+  // another bin
+  uint8_t *addr3 = allocator.Malloc(1500);
+  EXPECT_NE(addr3, addr1);
+  CachingAllocatorStats stats = allocator.GetStats();
+  EXPECT_EQ(stats.malloc_num, 4);
+  EXPECT_EQ(stats.hit_num, 1);
+  EXPECT_EQ(stats.rt_malloc_num, 3);
+  EXPECT_EQ(stats.in_use_size, 1024 + 1536);
+  EXPECT_EQ(stats.cached_size, 1024);
+  EXPECT_EQ(stats.peak_size, 1024 * 2 + 1536);
+
+  allocator.Trim(0);
+  stats = allocator.GetStats();
+  EXPECT_EQ(stats.cached_size, 0);
+  EXPECT_EQ(stats.rt_free_num, 1);
+  EXPECT_EQ(allocator.Free(addr2), SUCCESS);
+  EXPECT_EQ(allocator.Free(addr3), SUCCESS);
+}
+
+TEST_F(UtestCachingAllocator, trim_least_recently_freed) {
+  CachingAllocator allocator(RT_MEMORY_HBM, true, 4096);
+  vector<uint8_t *> addrs;
+  for (int i = 0; i < 4; ++i) {
+    addrs.push_back(allocator.Malloc(2048));
+  }
+  for (auto addr : addrs) {
+    EXPECT_EQ(allocator.Free(addr), SUCCESS);
+  }
+  // the first two are given back
+  CachingAllocatorStats stats = allocator.GetStats();
+  EXPECT_EQ(stats.cached_size, 4096);
+  EXPECT_EQ(stats.rt_free_num, 2);
+  ASSERT_EQ(allocator.cached_blocks_.size(), 2);
+  EXPECT_EQ(allocator.cached_blocks_.front().addr, addrs[3]);
+  EXPECT_EQ(allocator.cached_blocks_.back().addr, addrs[2]);
+
+  // too large to keep
+  uint8_t *large = allocator.Malloc(8192);
+  EXPECT_EQ(allocator.Free(large), SUCCESS);
+  EXPECT_EQ(allocator.GetStats().rt_free_num, 3);
+
+  allocator.SetMaxCachedSize(2048);
+  EXPECT_EQ(allocator.GetStats().cached_size, 2048);
+  EXPECT_EQ(allocator.cached_blocks_.front().addr, addrs[3]);
+}
+
+TEST_F(UtestCachingAllocator, stream_aware_reuse) {
+  CachingAllocator allocator(RT_MEMORY_HBM, false, 1UL << 20);
+  rtStream_t stream1 = nullptr;
+  rtStream_t stream2 = nullptr;
+  ASSERT_EQ(rtStreamCreate(&stream1, 0), RT_ERROR_NONE);
+  ASSERT_EQ(rtStreamCreate(&stream2, 0), RT_ERROR_NONE);
+
+  uint8_t *addr = allocator.Malloc(4096, stream1);
+  EXPECT_EQ(allocator.Free(addr, stream1), SUCCESS);
+  ASSERT_EQ(allocator.cached_blocks_.size(), 1);
+  EXPECT_NE(allocator.cached_blocks_.front().event, nullptr);
+  EXPECT_EQ(allocator.cached_blocks_.front().stream, stream1);
+
+  // the same stream takes it without waiting
+  EXPECT_TRUE(allocator.IsBlockReady(allocator.cached_blocks_.front(), true, stream1));
+  EXPECT_EQ(allocator.Malloc(4096, stream1), addr);
+  EXPECT_EQ(allocator.idle_events_.size(), 1);
+
+  // other streams once the event is done, the event is recycled
+  EXPECT_EQ(allocator.Free(addr, stream1), SUCCESS);
+  EXPECT_EQ(allocator.idle_events_.size(), 0);
+  EXPECT_EQ(allocator.Malloc(4096, stream2), addr);
+  EXPECT_EQ(allocator.Free(addr, stream2), SUCCESS);
+  EXPECT_EQ(allocator.Malloc(4096), addr);
+  EXPECT_EQ(allocator.Free(addr), SUCCESS);
+  EXPECT_EQ(allocator.cached_blocks_.front().event, nullptr);
+
+  CachingAllocatorStats stats = allocator.GetStats();
+  EXPECT_EQ(stats.rt_malloc_num, 1);
+  EXPECT_EQ(stats.hit_num, 3);
+  EXPECT_EQ(rtStreamDestroy(stream1), RT_ERROR_NONE);
+  EXPECT_EQ(rtStreamDestroy(stream2), RT_ERROR_NONE);
+}
+
+TEST_F(UtestCachingAllocator, malloc_free_concurrently) {
+  CachingAllocator allocator(RT_MEMORY_HBM, true, 1UL << 20);
+  vector<thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&allocator, t]() {
+      mt19937 engine(t);
+      uniform_int_distribution<uint64_t> distribution(1, 64 * 1024);
+      vector<uint8_t *> addrs;
+      for (int i = 0; i < 1000; ++i) {
+        addrs.push_back(allocator.Malloc(distribution(engine)));
+        EXPECT_NE(addrs.back(), nullptr);
+        if (addrs.size() > 8) {
+          EXPECT_EQ(allocator.Free(addrs.front()), SUCCESS);
+          addrs.erase(addrs.begin());
+        }
+      }
+      for (auto addr : addrs) {
+        EXPECT_EQ(allocator.Free(addr), SUCCESS);
+      }
+    });
+  }
+  for (auto &worker : threads) {
+    worker.join();
+  }
+  CachingAllocatorStats stats = allocator.GetStats();
+  EXPECT_EQ(stats.in_use_size, 0);
+  EXPECT_LE(stats.cached_size, 1UL << 20);
+  EXPECT_EQ(stats.rt_malloc_num - stats.rt_free_num, allocator.cached_blocks_.size());
+  EXPECT_EQ(stats.malloc_num, 4000);
+}
+
+TEST_F(UtestCachingAllocator, DISABLED_benchmark_caching_allocator) {
+  const int round_num = 200000;
+  mt19937 engine(0);
+  uniform_int_distribution<uint64_t> distribution(1, 1024 * 1024);
+  vector<uint64_t> sizes(round_num);
+  for (auto &size : sizes) {
+    size = distribution(engine);
+  }
+
+  // buffers of variable shapes, a few alive at a time
+  auto start = chrono::steady_clock::now();
+  vector<void *> addrs;
+  for (auto size : sizes) {
+    void *addr = nullptr;
+    (void)rtMallocHost(&addr, size);
+    addrs.push_back(addr);
+    if (addrs.size() > 4) {
+      (void)rtFreeHost(addrs.front());
+      addrs.erase(addrs.begin());
+    }
+  }
+  for (auto addr : addrs) {
+    (void)rtFreeHost(addr);
+  }
+  auto cost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+  cout << round_num << " rt mallocs cost " << cost << " ms" << endl;
+
+  CachingAllocator allocator(RT_MEMORY_HBM, true, 64UL << 20);
+  start = chrono::steady_clock::now();
+  vector<uint8_t *> cached_addrs;
+  for (auto size : sizes) {
+    cached_addrs.push_back(allocator.Malloc(size));
+    if (cached_addrs.size() > 4) {
+      (void)allocator.Free(cached_addrs.front());
+      cached_addrs.erase(cached_addrs.begin());
+    }
+  }
+  for (auto addr : cached_addrs) {
+    (void)allocator.Free(addr);
+  }
+  cost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+  CachingAllocatorStats stats = allocator.GetStats();
+  cout << round_num << " caching mallocs cost " << cost << " ms, " << stats.rt_malloc_num << " rt mallocs, peak "
+       << stats.peak_size << " bytes" << endl;
+}
+}  // namespace ge
@@ -0,0 +1,315 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "common/types.h"
+#include "ge/ge_api_types.h"
+#include "graph/debug/ge_attr_define.h"
+#include "graph/manager/graph_cache.h"
+#include "graph/utils/attr_utils.h"
+#include "graph/utils/graph_utils.h"
+
+using namespace std;
+
+namespace ge {
+namespace {
+const char *const kCacheDir = "ut_graph_cache";
+const int64_t kMemorySize = 4096;
+
+vector<string> ListDir(const string &dir_path) {
+  vector<string> names;
+  DIR *dir = opendir(dir_path.c_str());
+  if (dir == nullptr) {
+    return names;
+  }
+  struct dirent *entry = nullptr;
+  while ((entry = readdir(dir)) != nullptr) {
+    string name = entry->d_name;
+    if ((name != ".") && (name != "..")) {
+      names.push_back(name);
+    }
+  }
+  (void)closedir(dir);
+  return names;
+}
+
+void RemoveDir(const string &dir_path) {
+  for (const auto &name : ListDir(dir_path)) {
+    (void)remove((dir_path + "/" + name).c_str());
+  }
+  (void)rmdir(dir_path.c_str());
+}
+
+// data -> add <- const, add -> netoutput
+ComputeGraphPtr CreateGraph(const vector<int64_t> &dims, float weight, int64_t node_num = 1) {
+  auto compute_graph = make_shared<ComputeGraph>("graph");
+  GeTensorDesc tensor_desc(GeShape(dims), FORMAT_ND, DT_FLOAT);
+  auto data_op = make_shared<OpDesc>("data", DATA);
+  data_op->AddOutputDesc(tensor_desc);
+  NodePtr prev = compute_graph->AddNode(data_op);
+  for (int64_t i = 0; i < node_num; ++i) {
+    auto const_op = make_shared<OpDesc>("const_" + to_string(i), CONSTANT);
+    const_op->AddOutputDesc(tensor_desc);
+    GeTensorPtr tensor = make_shared<GeTensor>(tensor_desc, reinterpret_cast<uint8_t *>(&weight), sizeof(weight));
+    (void)AttrUtils::SetTensor(const_op, ATTR_NAME_WEIGHTS, tensor);
+    (void)AttrUtils::SetInt(const_op, "index", i);
+    auto add_op = make_shared<OpDesc>("add_" + to_string(i), ADD);
+    add_op->AddInputDesc(tensor_desc);
+    add_op->AddInputDesc(tensor_desc);
+    add_op->AddOutputDesc(tensor_desc);
+    NodePtr const_node = compute_graph->AddNode(const_op);
+    NodePtr add_node = compute_graph->AddNode(add_op);
+    (void)GraphUtils::AddEdge(prev->GetOutDataAnchor(0), add_node->GetInDataAnchor(0));
+    (void)GraphUtils::AddEdge(const_node->GetOutDataAnchor(0), add_node->GetInDataAnchor(1));
+    prev = add_node;
+  }
+  auto output_op = make_shared<OpDesc>("output", NETOUTPUT);
+  output_op->AddInputDesc(tensor_desc);
+  NodePtr output_node = compute_graph->AddNode(output_op);
+  (void)GraphUtils::AddEdge(prev->GetOutDataAnchor(0), output_node->GetInDataAnchor(0));
+  return compute_graph;
+}
+
+GeModelPtr CreateModel(size_t weight_size) {
+  auto ge_model = make_shared<GeModel>();
+  ge_model->SetName("model");
+  ge_model->SetGraph(GraphUtils::CreateGraphFromComputeGraph(CreateGraph({1, 16}, 1.0f)));
+  ge_model->SetWeight(Buffer(weight_size, 1));
+  auto model_task_def = make_shared<domi::ModelTaskDef>();
+  model_task_def->set_memory_size(kMemorySize);
+  ge_model->SetModelTaskDef(model_task_def);
+  (void)AttrUtils::SetInt(ge_model, ATTR_MODEL_MEMORY_SIZE, kMemorySize);
+  return ge_model;
+}
+
+string GenerateKey(GraphCache &cache, const ComputeGraphPtr &compute_graph, const vector<int64_t> &input_dims) {
+  vector<GeTensor> inputs = {GeTensor(GeTensorDesc(GeShape(input_dims), FORMAT_ND, DT_FLOAT))};
+  string key;
+  EXPECT_EQ(cache.GenerateKey(compute_graph, inputs, key), SUCCESS);
+  return key;
+}
+
+void SetMtime(const string &path, time_t mtime) {
+  struct timespec times[2];
+  times[0].tv_sec = mtime;
+  times[0].tv_nsec = 0;
+  times[1] = times[0];
+  (void)utimensat(AT_FDCWD, path.c_str(), times, 0);
+}
+}  // namespace
+
+class UtestGraphCache : public testing::Test {
+ protected:
+  void SetUp() { RemoveDir(kCacheDir); }
+
+  void TearDown() { RemoveDir(kCacheDir); }
+};
+
+TEST_F(UtestGraphCache, disabled_without_cache_dir) {
+  GraphCache cache;
+  EXPECT_EQ(cache.Initialize({}), SUCCESS);
+  EXPECT_FALSE(cache.IsEnabled());
+  EXPECT_EQ(cache.Lookup("0123"), nullptr);
+  EXPECT_EQ(cache.Store("0123", CreateModel(64)), SUCCESS);
+  EXPECT_TRUE(ListDir(kCacheDir).empty());
+
+  EXPECT_NE(cache.Initialize({{GRAPH_CACHE_DIR, kCacheDir}, {GRAPH_CACHE_MAX_SIZE, "1G"}}), SUCCESS);
+  EXPECT_FALSE(cache.IsEnabled());
+}
+
+TEST_F(UtestGraphCache, key_depends_on_graph_inputs_and_options) {
+  GraphCache cache;
+  ASSERT_EQ(cache.Initialize({{GRAPH_CACHE_DIR, kCacheDir}, {OPTION_EXEC_SESSION_ID, "1"}, {STREAM_NUM, "1"}}),
+            SUCCESS);
+  ASSERT_TRUE(cache.IsEnabled());
+
+  auto compute_graph = CreateGraph({1, 16}, 1.0f);
+  string key = GenerateKey(cache, compute_graph, {1, 16});
+  EXPECT_EQ(key.size(), 32);
+
+  // the same graph built in another session of another process
+  auto same_graph = CreateGraph({1, 16}, 1.0f);
+  (void)AttrUtils::SetStr(*same_graph, ATTR_NAME_SESSION_GRAPH_ID, "5_3");
+  GraphCache other_session_cache;
+  ASSERT_EQ(other_session_cache.Initialize(
+                {{GRAPH_CACHE_DIR, kCacheDir}, {OPTION_EXEC_SESSION_ID, "2"}, {STREAM_NUM, "1"}}),
+            SUCCESS);
+  EXPECT_EQ(GenerateKey(other_session_cache, same_graph, {1, 16}), key);
+
+  EXPECT_NE(GenerateKey(cache, CreateGraph({1, 16}, 2.0f), {1, 16}), key);
+  EXPECT_NE(GenerateKey(cache, CreateGraph({1, 16}, 1.0f, 2), {1, 16}), key);
+  EXPECT_NE(GenerateKey(cache, compute_graph, {2, 16}), key);
+  (void)AttrUtils::SetInt(compute_graph->FindNode("add_0")->GetOpDesc(), "axis", 1);
+  EXPECT_NE(GenerateKey(cache, compute_graph, {1, 16}), key);
+
+  GraphCache other_options_cache;
+  ASSERT_EQ(other_options_cache.Initialize({{GRAPH_CACHE_DIR, kCacheDir}, {STREAM_NUM, "2"}}), SUCCESS);
+  EXPECT_NE(GenerateKey(other_options_cache, same_graph, {1, 16}), key);
+}
+
+TEST_F(UtestGraphCache, key_depends_on_opp_version) {
+  const string opp_dir = string(kCacheDir) + "_opp";
+  RemoveDir(opp_dir);
+  ASSERT_EQ(mkdir(opp_dir.c_str(), S_IRWXU), 0);
+  const char *old_opp_path = getenv("ASCEND_OPP_PATH");
+  string saved_opp_path = (old_opp_path != nullptr) ? old_opp_path : "";
+  (void)setenv("ASCEND_OPP_PATH", opp_dir.c_str(), 1);
+
+  auto compute_graph = CreateGraph({1, 16}, 1.0f);
+  ofstream(opp_dir + "/version.info") << "Version=1.0.0" << endl;
+  GraphCache cache;
+  ASSERT_EQ(cache.Initialize({{GRAPH_CACHE_DIR, kCacheDir}}), SUCCESS);
+  string key = GenerateKey(cache, compute_graph, {1, 16});
+
+  GraphCache same_opp_cache;
+  ASSERT_EQ(same_opp_cache.Initialize({{GRAPH_CACHE_DIR, kCacheDir}}), SUCCESS);
+  EXPECT_EQ(GenerateKey(same_opp_cache, compute_graph, {1, 16}), key);
+
+  // the opp is upgraded, the ops it compiled before may not match it
+  ofstream(opp_dir + "/version.info") << "Version=1.1.0" << endl;
+  GraphCache upgraded_opp_cache;
+  ASSERT_EQ(upgraded_opp_cache.Initialize({{GRAPH_CACHE_DIR, kCacheDir}}), SUCCESS);
+  EXPECT_NE(GenerateKey(upgraded_opp_cache, compute_graph, {1, 16}), key);
+
+  if (old_opp_path != nullptr) {
+    (void)setenv("ASCEND_OPP_PATH", saved_opp_path.c_str(), 1);
+  } else {
+    (void)unsetenv("ASCEND_OPP_PATH");
+  }
+  RemoveDir(opp_dir);
+}
+
+TEST_F(UtestGraphCache, graphs_with_session_state_are_not_cacheable) {
+  EXPECT_TRUE(GraphCache::IsGraphCacheable(CreateGraph({1, 16}, 1.0f)));
+  EXPECT_FALSE(GraphCache::IsGraphCacheable(nullptr));
+
+  auto compute_graph = CreateGraph({1, 16}, 1.0f);
+  (void)compute_graph->AddNode(make_shared<OpDesc>("var", VARIABLE));
+  EXPECT_FALSE(GraphCache::IsGraphCacheable(compute_graph));
+
+  compute_graph = CreateGraph({1, 16}, 1.0f);
+  (void)compute_graph->AddNode(make_shared<OpDesc>("summary", "Summary"));
+  EXPECT_FALSE(GraphCache::IsGraphCacheable(compute_graph));
+}
+
+TEST_F(UtestGraphCache, store_and_lookup) {
+  GraphCache cache;
+  ASSERT_EQ(cache.Initialize({{GRAPH_CACHE_DIR, kCacheDir}}), SUCCESS);
+  string key = GenerateKey(cache, CreateGraph({1, 16}, 1.0f), {1, 16});
+
+  EXPECT_EQ(cache.Lookup(key), nullptr);
+  EXPECT_EQ(cache.GetMissCount(), 1);
+  EXPECT_EQ(cache.Store(key, CreateModel(1024)), SUCCESS);
+  // no temporary file is left behind
+  EXPECT_EQ(ListDir(kCacheDir), vector<string>({key + ".om"}));
+
+  // another process finds the model
+  GraphCache other_cache;
+  ASSERT_EQ(other_cache.Initialize({{GRAPH_CACHE_DIR, kCacheDir}}), SUCCESS);
+  GeModelPtr ge_model = other_cache.Lookup(key);
+  ASSERT_NE(ge_model, nullptr);
+  EXPECT_EQ(other_cache.GetHitCount(), 1);
+  EXPECT_EQ(other_cache.GetMissCount(), 0);
+  EXPECT_EQ(ge_model->GetName(), "model");
+  EXPECT_EQ(ge_model->GetWeightSize(), 1024);
+  EXPECT_EQ(ge_model->GetWeightData()[1023], 1);
+  EXPECT_EQ(ge_model->GetModelTaskDefPtr()->memory_size(), kMemorySize);
+  int64_t memory_size = 0;
+  EXPECT_TRUE(AttrUtils::GetInt(ge_model, ATTR_MODEL_MEMORY_SIZE, memory_size));
+  EXPECT_EQ(memory_size, kMemorySize);
+  auto compute_graph = GraphUtils::GetComputeGraph(ge_model->GetGraph());
+  ASSERT_NE(compute_graph, nullptr);
+  EXPECT_NE(compute_graph->FindNode("add_0"), nullptr);
+
+  // a model without weights does not fit the om format, it is not stored
+  EXPECT_EQ(cache.Store("0123", CreateModel(0)), SUCCESS);
+  EXPECT_EQ(ListDir(kCacheDir).size(), 1);
+  cache.Finalize();
+  EXPECT_FALSE(cache.IsEnabled());
+}
+
+TEST_F(UtestGraphCache, damaged_model_is_removed) {
+  GraphCache cache;
+  ASSERT_EQ(cache.Initialize({{GRAPH_CACHE_DIR, kCacheDir}}), SUCCESS);
+  string path = string(kCacheDir) + "/0123.om";
+  {
+    ofstream fs(path, ofstream::binary);
+    fs << "not a model";
+  }
+  EXPECT_EQ(cache.Lookup("0123"), nullptr);
+  EXPECT_EQ(cache.GetMissCount(), 1);
+  EXPECT_TRUE(ListDir(kCacheDir).empty());
+}
+
+TEST_F(UtestGraphCache, evict_least_recently_used) {
+  const size_t weight_size = 64 * 1024;
+  GraphCache cache;
+  // room for three models
+  ASSERT_EQ(cache.Initialize({{GRAPH_CACHE_DIR, kCacheDir}, {GRAPH_CACHE_MAX_SIZE, to_string(weight_size * 7 / 2)}}),
+            SUCCESS);
+  EXPECT_EQ(cache.Store("a", CreateModel(weight_size)), SUCCESS);
+  EXPECT_EQ(cache.Store("b", CreateModel(weight_size)), SUCCESS);
+  EXPECT_EQ(cache.Store("c", CreateModel(weight_size)), SUCCESS);
+  string dir = kCacheDir;
+  SetMtime(dir + "/a.om", 1000);
+  SetMtime(dir + "/b.om", 2000);
+  SetMtime(dir + "/c.om", 3000);
+  // a stale temporary file of a crashed store, and one of a store in progress
+  {
+    ofstream stale(dir + "/d.om.1_0.tmp", ofstream::binary);
+    stale << "stale";
+    ofstream fresh(dir + "/d.om.2_0.tmp", ofstream::binary);
+    fresh << "fresh";
+  }
+  SetMtime(dir + "/d.om.1_0.tmp", 1000);
+
+  // a is used again, b is the least recently used now
+  EXPECT_NE(cache.Lookup("a"), nullptr);
+  EXPECT_EQ(cache.Store("d", CreateModel(weight_size)), SUCCESS);
+  vector<string> names = ListDir(kCacheDir);
+  sort(names.begin(), names.end());
+  EXPECT_EQ(names, vector<string>({"a.om", "c.om", "d.om", "d.om.2_0.tmp"}));
+
+  // a model beyond the max size is not kept
+  EXPECT_EQ(cache.Store("e", CreateModel(weight_size * 4)), SUCCESS);
+  EXPECT_EQ(cache.Lookup("e"), nullptr);
+}
+
+TEST_F(UtestGraphCache, DISABLED_benchmark_generate_key) {
+  GraphCache cache;
+  ASSERT_EQ(cache.Initialize({{GRAPH_CACHE_DIR, kCacheDir}}), SUCCESS);
+  for (int64_t node_num = 1000; node_num <= 8000; node_num *= 2) {
+    auto compute_graph = CreateGraph({64, 64}, 1.0f, node_num);
+    auto start = chrono::steady_clock::now();
+    string key = GenerateKey(cache, compute_graph, {64, 64});
+    auto cost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    cout << node_num * 2 + 2 << " nodes, generate key cost " << cost << " ms" << endl;
+  }
+}
+}  // namespace ge
@@ -0,0 +1,237 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/types.h"
+#include "graph/utils/tensor_utils.h"
+
+#define protected public
+#define private public
+#include "graph/execute/graph_execute.h"
+#include "graph/load/new_model_manager/davinci_model.h"
+#include "graph/load/new_model_manager/model_manager.h"
+#include "graph/manager/graph_manager_utils.h"
+#undef private
+#undef protected
+
+using namespace std;
+
+namespace ge {
+class UtestGraphExecute : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+namespace {
+const uint32_t kTestModelIdBase = 1000;
+
+// Data(64 bytes at offset 0) -> NetOutput(64 bytes at offset 512)
+struct TestModel {
+  TestModel(uint32_t model_id, const shared_ptr<GraphModelListener> &listener) : mem(1024) {
+    model = make_shared<DavinciModel>(0, listener);
+    model->model_id_ = model_id;
+    model->mem_base_ = mem.data();
+    model->runtime_param_.mem_size = mem.size();
+
+    GeTensorDesc tensor_desc(GeShape({16}), FORMAT_ND, DT_FLOAT);
+    TensorUtils::SetSize(tensor_desc, 64);
+
+    auto data_op = make_shared<OpDesc>("data", DATA);
+    data_op->AddInputDesc(tensor_desc);
+    data_op->AddOutputDesc(tensor_desc);
+    data_op->SetOutputOffset({0});
+    model->data_op_list_.push_back(data_op);
+    model->data_op_input_tensor_desc_map_[data_op->GetName()] = data_op->GetInputDescPtr(0);
+    model->data_op_output_tensor_desc_map_[data_op->GetName()] = data_op->GetOutputDescPtr(0);
+
+    auto output_op = make_shared<OpDesc>("output", NETOUTPUT);
+    output_op->AddInputDesc(tensor_desc);
+    output_op->SetInputOffset({512});
+    // the output desc of the model is taken from the output tensors of NetOutput
+    GeTensorDesc output_desc(tensor_desc);
+    TensorUtils::SetOutputTensor(output_desc, true);
+    output_op->AddOutputDesc(output_desc);
+    output_op->SetSrcName({"data"});
+    output_op->SetSrcIndex({0});
+    model->output_op_list_.push_back(output_op);
+    model->output_size_list_.push_back(64);
+
+    model->data_inputer_ = new DataInputer();
+    ModelManager::GetInstance()->InsertModel(model_id, model);
+  }
+
+  ~TestModel() {
+    (void)model->ModelRunStop();
+    (void)ModelManager::GetInstance()->DeleteModel(model->model_id_);
+  }
+
+  vector<uint8_t> mem;
+  shared_ptr<DavinciModel> model;
+};
+
+// every thread runs the graphs in turn, returns the number of successful runs
+uint32_t RunGraphs(GraphExecutor &executor, const vector<GeModelPtr> &ge_models, uint32_t thread_num,
+                   uint32_t run_num) {
+  atomic<uint32_t> success_num(0);
+  vector<thread> threads;
+  for (uint32_t i = 0; i < thread_num; ++i) {
+    threads.emplace_back([&executor, &ge_models, &success_num, i, run_num]() {
+      vector<float> data(16, 1.0f);
+      GeTensor input(GeTensorDesc(GeShape({16}), FORMAT_ND, DT_FLOAT), reinterpret_cast<uint8_t *>(data.data()),
+                     data.size() * sizeof(float));
+      for (uint32_t j = 0; j < run_num; ++j) {
+        size_t graph_index = (i + j) % ge_models.size();
+        vector<GeTensor> outputs;
+        if ((executor.ExecuteGraph(graph_index, ge_models[graph_index], {input}, outputs) == SUCCESS) &&
+            (outputs.size() == 1) && (outputs[0].GetData().size() == 64)) {
+          ++success_num;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return success_num;
+}
+}  // namespace
+
+TEST_F(UtestGraphExecute, listener_returns_result_of_each_request) {
+  mutex sync_run_mutex;
+  condition_variable condition;
+  GraphModelListener listener;
+  EXPECT_EQ(listener.SetCondition(&sync_run_mutex, &condition), SUCCESS);
+
+  EXPECT_EQ(listener.ResetResult(1, 0), SUCCESS);
+  EXPECT_EQ(listener.ResetResult(1, 1), SUCCESS);
+  EXPECT_EQ(listener.ResetResult(2, 0), SUCCESS);
+
+  // the requests are returned out of order, each waiter gets its own result
+  thread waiter([&listener]() {
+    uint32_t result_code = SUCCESS;
+    EXPECT_EQ(listener.WaitResult(1, 0, result_code), SUCCESS);
+    EXPECT_EQ(result_code, INTERNAL_ERROR);
+  });
+  EXPECT_EQ(listener.OnComputeDone(2, 0, SUCCESS), SUCCESS);
+  EXPECT_EQ(listener.OnComputeDone(1, 1, END_OF_SEQUENCE), SUCCESS);
+  EXPECT_EQ(listener.OnComputeDone(1, 0, INTERNAL_ERROR), SUCCESS);
+  waiter.join();
+
+  uint32_t result_code = INTERNAL_ERROR;
+  EXPECT_EQ(listener.WaitResult(2, 0, result_code), SUCCESS);
+  EXPECT_EQ(result_code, SUCCESS);
+  EXPECT_EQ(listener.WaitResult(1, 1, result_code), SUCCESS);
+  EXPECT_EQ(result_code, END_OF_SEQUENCE);
+
+  // results of unknown requests are dropped
+  EXPECT_EQ(listener.OnComputeDone(3, 0, SUCCESS), SUCCESS);
+  EXPECT_NE(listener.WaitResult(3, 0, result_code), SUCCESS);
+  EXPECT_TRUE(listener.results_.empty());
+}
+
+TEST_F(UtestGraphExecute, graph_node_shared_and_exclusive_runs) {
+  GraphNode graph_node(0);
+  EXPECT_FALSE(graph_node.GetRunFlag());
+
+  EXPECT_TRUE(graph_node.TryStartRun(false));
+  EXPECT_TRUE(graph_node.TryStartRun(false));
+  EXPECT_TRUE(graph_node.GetRunFlag());
+  EXPECT_FALSE(graph_node.TryStartRun(true));
+  graph_node.EndRun(false);
+  graph_node.EndRun(false);
+  EXPECT_FALSE(graph_node.GetRunFlag());
+
+  EXPECT_TRUE(graph_node.TryStartRun(true));
+  EXPECT_FALSE(graph_node.TryStartRun(false));
+  EXPECT_FALSE(graph_node.TryStartRun(true));
+  graph_node.EndRun(true);
+  EXPECT_TRUE(graph_node.TryStartRun(false));
+  graph_node.EndRun(false);
+  EXPECT_FALSE(graph_node.GetRunFlag());
+}
+
+TEST_F(UtestGraphExecute, execute_graphs_concurrently) {
+  mutex sync_run_mutex;
+  condition_variable condition;
+  auto listener = make_shared<GraphModelListener>();
+  EXPECT_EQ(listener->SetCondition(&sync_run_mutex, &condition), SUCCESS);
+  GraphExecutor executor;
+  EXPECT_EQ(executor.SetCondition(&sync_run_mutex, &condition, listener), SUCCESS);
+
+  const uint32_t graph_num = 2;
+  vector<unique_ptr<TestModel>> models;
+  vector<GeModelPtr> ge_models;
+  for (uint32_t i = 0; i < graph_num; ++i) {
+    models.emplace_back(new TestModel(kTestModelIdBase + i, listener));
+    EXPECT_EQ(models.back()->model->ModelRunStart(), SUCCESS);
+    ge_models.push_back(make_shared<GeModel>());
+    ge_models.back()->SetModelId(kTestModelIdBase + i);
+  }
+
+  EXPECT_EQ(RunGraphs(executor, ge_models, 4, 16), 4 * 16);
+  EXPECT_TRUE(listener->results_.empty());
+  EXPECT_EQ(executor.GetOutputsDesc(0).size(), 1);
+  EXPECT_EQ(executor.GetOutputsDesc(1).size(), 1);
+  EXPECT_TRUE(executor.GetOutputsDesc(graph_num).empty());
+
+  // the buffers of the finished requests are kept for the next ones
+  CachingAllocatorStats stats = executor.host_allocator_.GetStats();
+  EXPECT_EQ(stats.in_use_size, 0);
+  EXPECT_GT(stats.cached_size, 0);
+  EXPECT_GT(stats.hit_num, 0);
+  EXPECT_EQ(executor.FreeExecuteMemory(), SUCCESS);
+  EXPECT_EQ(executor.host_allocator_.GetStats().cached_size, 0);
+}
+
+TEST_F(UtestGraphExecute, DISABLED_benchmark_concurrent_run) {
+  mutex sync_run_mutex;
+  condition_variable condition;
+  auto listener = make_shared<GraphModelListener>();
+  EXPECT_EQ(listener->SetCondition(&sync_run_mutex, &condition), SUCCESS);
+  GraphExecutor executor;
+  EXPECT_EQ(executor.SetCondition(&sync_run_mutex, &condition, listener), SUCCESS);
+
+  const uint32_t total_run_num = 1 << 14;
+  for (uint32_t graph_num = 1; graph_num <= 4; graph_num *= 2) {
+    vector<unique_ptr<TestModel>> models;
+    vector<GeModelPtr> ge_models;
+    for (uint32_t i = 0; i < graph_num; ++i) {
+      models.emplace_back(new TestModel(kTestModelIdBase + i, listener));
+      EXPECT_EQ(models.back()->model->ModelRunStart(), SUCCESS);
+      ge_models.push_back(make_shared<GeModel>());
+      ge_models.back()->SetModelId(kTestModelIdBase + i);
+    }
+    for (uint32_t thread_num = 1; thread_num <= 16; thread_num *= 2) {
+      auto start = chrono::steady_clock::now();
+      EXPECT_EQ(RunGraphs(executor, ge_models, thread_num, total_run_num / thread_num), total_run_num);
+      auto cost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+      cout << thread_num << " threads x " << graph_num << " graphs, " << total_run_num << " runs cost " << cost
+           << " ms" << endl;
+    }
+  }
+}
+}  // namespace ge
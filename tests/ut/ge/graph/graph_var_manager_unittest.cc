@@ -0,0 +1,321 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#define private public
+#include "graph/manager/graph_var_manager.h"
+#include "graph/manager/var_mem_allocator.h"
+#undef private
+
+#include "graph/utils/tensor_utils.h"
+
+using namespace std;
+
+namespace ge {
+namespace {
+const uint64_t kAlign = 512;
+
+GeTensorDesc MakeDesc(Format format, uint32_t size) {
+  GeTensorDesc desc(GeShape({static_cast<int64_t>(size / sizeof(float))}), format, DT_FLOAT);
+  TensorUtils::SetSize(desc, size);
+  return desc;
+}
+
+uint64_t GetOffset(uint64_t session_id, const string &var_name, const GeTensorDesc &desc) {
+  uint8_t *dev_ptr = nullptr;
+  rtMemType_t memory_type = RT_MEMORY_HBM;
+  EXPECT_EQ(VarManager::Instance(session_id)->GetVarAddr(var_name, desc, &dev_ptr, memory_type), SUCCESS);
+  return reinterpret_cast<uint64_t>(dev_ptr) - VarManager::Instance(session_id)->GetVarMemLogicBase();
+}
+
+void AddVar(uint64_t session_id, const string &var_name, const GeTensorDesc &desc, uint32_t graph_id, bool is_const) {
+  VarManager *var_manager = VarManager::Instance(session_id);
+  ASSERT_EQ(var_manager->AssignVarMem(var_name, desc, RT_MEMORY_HBM), SUCCESS);
+  uint8_t *dev_ptr = nullptr;
+  rtMemType_t memory_type = RT_MEMORY_HBM;
+  ASSERT_EQ(var_manager->RefVarAddr(var_name, desc, graph_id, is_const, &dev_ptr, memory_type), SUCCESS);
+}
+}  // namespace
+
+class UtestGraphVarManager : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+TEST_F(UtestGraphVarManager, alloc_free_coalesce) {
+  VarMemAllocator allocator(kAlign);
+  uint64_t offset0 = 0;
+  uint64_t offset1 = 0;
+  uint64_t offset2 = 0;
+  ASSERT_EQ(allocator.Alloc(kAlign, 1UL << 20, offset0), SUCCESS);
+  ASSERT_EQ(allocator.Alloc(2 * kAlign, 1UL << 20, offset1), SUCCESS);
+  ASSERT_EQ(allocator.Alloc(kAlign, 1UL << 20, offset2), SUCCESS);
+  EXPECT_EQ(offset0, 0);
+  EXPECT_EQ(offset1, kAlign);
+  EXPECT_EQ(offset2, 3 * kAlign);
+  EXPECT_EQ(allocator.GetTop(), 4 * kAlign);
+
+  // the neighbours merge into one hole
+  EXPECT_EQ(allocator.Free(offset1), SUCCESS);
+  EXPECT_EQ(allocator.Free(offset0), SUCCESS);
+  VarMemStats stats = allocator.GetStats();
+  EXPECT_EQ(stats.free_block_num, 1);
+  EXPECT_EQ(stats.max_free_block_size, 3 * kAlign);
+  EXPECT_EQ(allocator.Free(offset0), PARAM_INVALID);
+
+  // taken from the hole before the top
+  uint64_t offset = 0;
+  ASSERT_EQ(allocator.Alloc(2 * kAlign, 1UL << 20, offset), SUCCESS);
+  EXPECT_EQ(offset, 0);
+  EXPECT_EQ(allocator.GetTop(), 4 * kAlign);
+
+  // the hole left under the top goes back to it
+  EXPECT_EQ(allocator.Free(offset2), SUCCESS);
+  stats = allocator.GetStats();
+  EXPECT_EQ(stats.top, 2 * kAlign);
+  EXPECT_EQ(stats.free_size, 0);
+  EXPECT_EQ(stats.used_size, 2 * kAlign);
+
+  EXPECT_EQ(allocator.Alloc(kAlign + 1, 1UL << 20, offset), PARAM_INVALID);
+  EXPECT_EQ(allocator.Alloc(4 * kAlign, 5 * kAlign, offset), PARAM_INVALID);
+}
+
+TEST_F(UtestGraphVarManager, alloc_best_fit) {
+  VarMemAllocator allocator(kAlign);
+  // holes of 4, 2 and 3 aligns between blocks of 1
+  vector<uint64_t> sizes = {4, 1, 2, 1, 3, 1};
+  vector<uint64_t> offsets;
+  for (uint64_t size : sizes) {
+    uint64_t offset = 0;
+    ASSERT_EQ(allocator.Alloc(size * kAlign, 1UL << 20, offset), SUCCESS);
+    offsets.push_back(offset);
+  }
+  for (size_t i = 0; i < sizes.size(); i += 2) {
+    ASSERT_EQ(allocator.Free(offsets[i]), SUCCESS);
+  }
+  EXPECT_EQ(allocator.GetStats().free_block_num, 3);
+
+  uint64_t offset = 0;
+  ASSERT_EQ(allocator.Alloc(3 * kAlign, 1UL << 20, offset), SUCCESS);
+  EXPECT_EQ(offset, offsets[4]);
+  ASSERT_EQ(allocator.Alloc(2 * kAlign, 1UL << 20, offset), SUCCESS);
+  EXPECT_EQ(offset, offsets[2]);
+  // only the hole of 4 is left, split
+  ASSERT_EQ(allocator.Alloc(kAlign, 1UL << 20, offset), SUCCESS);
+  EXPECT_EQ(offset, offsets[0]);
+  VarMemStats stats = allocator.GetStats();
+  EXPECT_EQ(stats.free_size, 3 * kAlign);
+  EXPECT_EQ(stats.top, 12 * kAlign);
+
+  // a hole above the limit is not taken
+  ASSERT_EQ(allocator.Alloc(kAlign, 2 * kAlign, offset), SUCCESS);
+  EXPECT_EQ(offset, offsets[0] + kAlign);
+  EXPECT_EQ(allocator.Alloc(kAlign, 2 * kAlign, offset), PARAM_INVALID);
+}
+
+TEST_F(UtestGraphVarManager, compact_movable_blocks) {
+  VarMemAllocator allocator(kAlign);
+  vector<uint64_t> offsets;
+  for (int i = 0; i < 4; ++i) {
+    uint64_t offset = 0;
+    ASSERT_EQ(allocator.Alloc(2 * kAlign, 1UL << 20, offset), SUCCESS);
+    offsets.push_back(offset);
+  }
+  ASSERT_EQ(allocator.Free(offsets[0]), SUCCESS);
+  ASSERT_EQ(allocator.Free(offsets[2]), SUCCESS);
+
+  // the block of 3 is pinned, the one of 1 slides to the bottom
+  vector<pair<uint64_t, uint64_t>> moves;
+  ASSERT_EQ(allocator.Compact([&offsets](uint64_t offset) { return offset != offsets[3]; },
+                              [&moves](uint64_t src, uint64_t dst, uint64_t size) {
+                                EXPECT_EQ(size, 2 * kAlign);
+                                moves.emplace_back(src, dst);
+                                return SUCCESS;
+                              }),
+            SUCCESS);
+  ASSERT_EQ(moves.size(), 1);
+  EXPECT_EQ(moves[0], make_pair(offsets[1], static_cast<uint64_t>(0)));
+  VarMemStats stats = allocator.GetStats();
+  EXPECT_EQ(stats.free_size, 4 * kAlign);
+  EXPECT_EQ(stats.top, 8 * kAlign);
+
+  // the layout stops at the block failed to move
+  ASSERT_EQ(allocator.Free(offsets[3]), SUCCESS);
+  ASSERT_EQ(allocator.Alloc(2 * kAlign, 1UL << 20, offsets[3]), SUCCESS);
+  EXPECT_EQ(offsets[3], 2 * kAlign);
+  ASSERT_EQ(allocator.Free(0), SUCCESS);
+  EXPECT_EQ(allocator.Compact([](uint64_t) { return true; },
+                              [](uint64_t, uint64_t, uint64_t) { return FAILED; }),
+            FAILED);
+  EXPECT_EQ(allocator.GetTop(), 4 * kAlign);
+  EXPECT_EQ(allocator.GetStats().free_block_num, 1);
+}
+
+TEST_F(UtestGraphVarManager, release_graph_and_compact) {
+  const uint64_t session_id = 221;
+  VarManager *var_manager = VarManager::Instance(session_id);
+  ASSERT_EQ(var_manager->Init(0, session_id, 0, 0), SUCCESS);
+
+  // 1000 bytes take 1024 and two aligns
+  GeTensorDesc nd_desc = MakeDesc(FORMAT_ND, 1000);
+  GeTensorDesc nz_desc = MakeDesc(FORMAT_FRACTAL_NZ, 1000);
+  AddVar(session_id, "const", nd_desc, 1, true);
+  AddVar(session_id, "var", nd_desc, 1, false);
+  AddVar(session_id, "var", nz_desc, 2, false);
+  EXPECT_EQ(GetOffset(session_id, "var", nz_desc), 4096);
+  EXPECT_EQ(var_manager->GetVarMemSize(RT_MEMORY_HBM), 6144);
+
+  // the constant and the variable in the replaced format are dropped, the other graph keeps the current one
+  var_manager->ReleaseGraphVarMem(1);
+  VarMemStats stats = var_manager->GetVarMemStats(RT_MEMORY_HBM);
+  EXPECT_EQ(stats.used_block_num, 1);
+  EXPECT_EQ(stats.free_size, 4096);
+  EXPECT_FALSE(var_manager->IsVarExist("const"));
+  EXPECT_FALSE(var_manager->IsVarExist("var", nd_desc));
+  EXPECT_TRUE(var_manager->IsVarExist("var", nz_desc));
+  EXPECT_FALSE(var_manager->IsVarAddr(var_manager->GetVarMemLogicBase() + 2048));
+
+  // a graph still uses it
+  EXPECT_EQ(var_manager->CompactVarMem([](const string &) { return false; }), SUCCESS);
+  EXPECT_EQ(GetOffset(session_id, "var", nz_desc), 4096);
+
+  // the data of a variable outlives its graphs
+  var_manager->ReleaseGraphVarMem(2);
+  EXPECT_TRUE(var_manager->IsVarExist("var", nz_desc));
+  EXPECT_EQ(var_manager->CompactVarMem([](const string &var_name) { return var_name == "var"; }), SUCCESS);
+  EXPECT_EQ(GetOffset(session_id, "var", nz_desc), 4096);
+
+  EXPECT_EQ(var_manager->CompactVarMem([](const string &) { return false; }), SUCCESS);
+  EXPECT_EQ(GetOffset(session_id, "var", nz_desc), 0);
+  EXPECT_TRUE(var_manager->IsVarAddr(var_manager->GetVarMemLogicBase()));
+  EXPECT_FALSE(var_manager->IsVarAddr(var_manager->GetVarMemLogicBase() + 4096));
+  EXPECT_EQ(var_manager->GetVarMemSize(RT_MEMORY_HBM), 2048);
+
+  // the top comes back once the constant is dropped
+  AddVar(session_id, "const", nd_desc, 3, true);
+  EXPECT_EQ(GetOffset(session_id, "const", nd_desc), 2048);
+  var_manager->ReleaseGraphVarMem(3);
+  EXPECT_EQ(var_manager->GetVarMemSize(RT_MEMORY_HBM), 2048);
+  var_manager->Destroy();
+}
+
+TEST_F(UtestGraphVarManager, lookup_while_assign) {
+  const uint64_t session_id = 222;
+  const int var_num = 64;
+  VarManager *var_manager = VarManager::Instance(session_id);
+  ASSERT_EQ(var_manager->Init(0, session_id, 0, 0), SUCCESS);
+  GeTensorDesc desc = MakeDesc(FORMAT_ND, 4096);
+  for (int i = 0; i < var_num; ++i) {
+    AddVar(session_id, "var" + to_string(i), desc, 1, false);
+  }
+
+  atomic<bool> stop(false);
+  vector<thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&]() {
+      while (!stop) {
+        for (int i = 0; i < var_num; ++i) {
+          uint8_t *dev_ptr = nullptr;
+          rtMemType_t memory_type = RT_MEMORY_HBM;
+          EXPECT_EQ(var_manager->GetVarAddr("var" + to_string(i), desc, &dev_ptr, memory_type), SUCCESS);
+          EXPECT_TRUE(var_manager->IsVarAddr(reinterpret_cast<uint64_t>(dev_ptr)));
+        }
+      }
+    });
+  }
+  for (int i = 0; i < var_num; ++i) {
+    AddVar(session_id, "const" + to_string(i), desc, 2 + i, true);
+    var_manager->ReleaseGraphVarMem(2 + i);
+  }
+  stop = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(var_manager->GetVarMemStats(RT_MEMORY_HBM).used_block_num, var_num);
+  var_manager->Destroy();
+}
+
+TEST_F(UtestGraphVarManager, DISABLED_benchmark_var_mem_reuse) {
+  const uint64_t session_id = 223;
+  const uint32_t graph_num = 1000;
+  VarManager *var_manager = VarManager::Instance(session_id);
+  ASSERT_EQ(var_manager->Init(0, session_id, 0, 0), SUCCESS);
+
+  // graphs added and removed with constants of their own, two alive at a time
+  uint64_t bump_size = 0;
+  auto start = chrono::steady_clock::now();
+  for (uint32_t graph_id = 0; graph_id < graph_num; ++graph_id) {
+    for (uint32_t i = 0; i < 8; ++i) {
+      GeTensorDesc desc = MakeDesc(FORMAT_ND, (1 + (graph_id * 7 + i * 13) % 64) * 4096);
+      AddVar(session_id, "const" + to_string(graph_id) + "_" + to_string(i), desc, graph_id, true);
+      uint32_t size = 0;
+      (void)TensorUtils::GetSize(desc, size);
+      bump_size += size + kAlign * 2;
+    }
+    if (graph_id > 0) {
+      var_manager->ReleaseGraphVarMem(graph_id - 1);
+    }
+  }
+  auto cost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+  VarMemStats stats = var_manager->GetVarMemStats(RT_MEMORY_HBM);
+  cout << graph_num << " graphs take var mem " << stats.top << " bytes instead of " << bump_size << ", cost " << cost
+       << " ms" << endl;
+  var_manager->Destroy();
+}
+
+TEST_F(UtestGraphVarManager, DISABLED_benchmark_var_addr_lookup) {
+  const uint64_t session_id = 224;
+  const int var_num = 1000;
+  const int thread_num = 8;
+  VarManager *var_manager = VarManager::Instance(session_id);
+  ASSERT_EQ(var_manager->Init(0, session_id, 0, 0), SUCCESS);
+  GeTensorDesc desc = MakeDesc(FORMAT_ND, 4096);
+  vector<string> names;
+  for (int i = 0; i < var_num; ++i) {
+    names.push_back("var" + to_string(i));
+    AddVar(session_id, names.back(), desc, 1, false);
+  }
+
+  auto start = chrono::steady_clock::now();
+  vector<thread> threads;
+  for (int t = 0; t < thread_num; ++t) {
+    threads.emplace_back([&]() {
+      for (int round = 0; round < 200; ++round) {
+        for (const auto &name : names) {
+          uint8_t *dev_ptr = nullptr;
+          rtMemType_t memory_type = RT_MEMORY_HBM;
+          (void)var_manager->GetVarAddr(name, desc, &dev_ptr, memory_type);
+        }
+      }
+    });
+  }
+  for (auto &worker : threads) {
+    worker.join();
+  }
+  auto cost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+  cout << thread_num << " threads look up " << var_num << " vars 200 times cost " << cost << " ms" << endl;
+  var_manager->Destroy();
+}
+}  // namespace ge
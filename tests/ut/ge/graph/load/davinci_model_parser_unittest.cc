@@ -0,0 +1,181 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "common/helper/model_helper.h"
+#include "common/types.h"
+#include "graph/load/new_model_manager/davinci_model_parser.h"
+#include "graph/load/new_model_manager/model_manager.h"
+#include "graph/model.h"
+#include "graph/utils/graph_utils.h"
+
+using namespace std;
+
+namespace ge {
+namespace {
+const char *const kModelFile = "ut_davinci_model_parser.om";
+const uint32_t kWeightsSize = 3 * 4096 + 100;
+const int64_t kMemorySize = 2048;
+
+void AppendBytes(vector<uint8_t> &data, const void *bytes, size_t size) {
+  const uint8_t *begin = static_cast<const uint8_t *>(bytes);
+  data.insert(data.end(), begin, begin + size);
+}
+
+// header | partition table | model def | weights | task info
+void WriteModelFile(const vector<uint8_t> &weights) {
+  auto compute_graph = make_shared<ComputeGraph>("graph");
+  (void)compute_graph->AddNode(make_shared<OpDesc>("data", DATA));
+  Model model("model", "");
+  model.SetGraph(GraphUtils::CreateGraphFromComputeGraph(compute_graph));
+  Buffer model_def;
+  ASSERT_EQ(model.Save(model_def), GRAPH_SUCCESS);
+
+  domi::ModelTaskDef task_def;
+  task_def.set_memory_size(kMemorySize);
+  string task_info;
+  ASSERT_TRUE(task_def.SerializeToString(&task_info));
+
+  vector<uint8_t> table(sizeof(ModelPartitionTable) + 3 * sizeof(ModelPartitionMemInfo));
+  auto partition_table = reinterpret_cast<ModelPartitionTable *>(table.data());
+  partition_table->num = 3;
+  partition_table->partition[0] = {ModelPartitionType::MODEL_DEF, 0, static_cast<uint32_t>(model_def.GetSize())};
+  partition_table->partition[1] = {ModelPartitionType::WEIGHTS_DATA, 0, static_cast<uint32_t>(weights.size())};
+  partition_table->partition[2] = {ModelPartitionType::TASK_INFO, 0, static_cast<uint32_t>(task_info.size())};
+
+  vector<uint8_t> body;
+  AppendBytes(body, table.data(), table.size());
+  AppendBytes(body, model_def.GetData(), model_def.GetSize());
+  AppendBytes(body, weights.data(), weights.size());
+  AppendBytes(body, task_info.data(), task_info.size());
+
+  ModelFileHeader header;
+  header.length = static_cast<uint32_t>(body.size());
+  ofstream fs(kModelFile, ofstream::binary);
+  (void)fs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  (void)fs.write(reinterpret_cast<const char *>(body.data()), body.size());
+}
+}  // namespace
+
+class UtestDavinciModelParser : public testing::Test {
+ protected:
+  void SetUp() {
+    for (uint32_t i = 0; i < kWeightsSize; ++i) {
+      weights_.push_back(static_cast<uint8_t>(i % 251));
+    }
+    WriteModelFile(weights_);
+  }
+
+  void TearDown() { (void)remove(kModelFile); }
+
+  vector<uint8_t> weights_;
+};
+
+TEST_F(UtestDavinciModelParser, map_model_file_and_refer_weights) {
+  ModelData model_data;
+  ASSERT_EQ(DavinciModelParser::MapFromFile(kModelFile, nullptr, 1, model_data), SUCCESS);
+  ASSERT_NE(model_data.model_data, nullptr);
+  EXPECT_EQ(model_data.priority, 1);
+  EXPECT_TRUE(model_data.key.empty());
+
+  ModelHelper model_helper;
+  ASSERT_EQ(model_helper.LoadModel(model_data, true), SUCCESS);
+  GeModelPtr ge_model = model_helper.GetGeModel();
+  ASSERT_NE(ge_model, nullptr);
+  EXPECT_EQ(ge_model->GetModelTaskDefPtr()->memory_size(), kMemorySize);
+
+  // the weights are a view into the mapped file
+  const uint8_t *begin = static_cast<const uint8_t *>(model_data.model_data);
+  const uint8_t *weights = ge_model->GetWeightData();
+  ASSERT_EQ(ge_model->GetWeightSize(), kWeightsSize);
+  EXPECT_GT(weights, begin);
+  EXPECT_LT(weights, begin + model_data.model_len);
+  EXPECT_EQ(vector<uint8_t>(weights, weights + kWeightsSize), weights_);
+  Buffer weight_copy = ge_model->GetWeight();
+  EXPECT_EQ(vector<uint8_t>(weight_copy.GetData(), weight_copy.GetData() + weight_copy.GetSize()), weights_);
+
+  // dropped pages are read from the file again
+  DavinciModelParser::AdviseSequential(weights, kWeightsSize);
+  DavinciModelParser::ReleasePages(weights, kWeightsSize);
+  EXPECT_EQ(vector<uint8_t>(weights, weights + kWeightsSize), weights_);
+
+  ge_model->ClearWeightRef();
+  EXPECT_EQ(ge_model->GetWeightSize(), 0);
+  DavinciModelParser::FreeModelData(model_data);
+  EXPECT_EQ(model_data.model_data, nullptr);
+  EXPECT_EQ(model_data.model_len, 0);
+}
+
+TEST_F(UtestDavinciModelParser, copy_weights_by_default) {
+  ModelData model_data;
+  ASSERT_EQ(DavinciModelParser::MapFromFile(kModelFile, nullptr, 0, model_data), SUCCESS);
+  ModelHelper model_helper;
+  ASSERT_EQ(model_helper.LoadModel(model_data), SUCCESS);
+  DavinciModelParser::FreeModelData(model_data);
+
+  // the model outlives the mapping
+  GeModelPtr ge_model = model_helper.GetGeModel();
+  ASSERT_EQ(ge_model->GetWeightSize(), kWeightsSize);
+  const uint8_t *weights = ge_model->GetWeightData();
+  EXPECT_EQ(vector<uint8_t>(weights, weights + kWeightsSize), weights_);
+}
+
+TEST_F(UtestDavinciModelParser, get_mem_and_weight_size_from_mapped_file) {
+  ModelData model_data;
+  ASSERT_EQ(DavinciModelParser::MapFromFile(kModelFile, nullptr, 0, model_data), SUCCESS);
+  size_t mem_size = 0;
+  size_t weight_size = 0;
+  EXPECT_EQ(ModelManager::GetModelMemAndWeightSize(model_data, mem_size, weight_size), SUCCESS);
+  EXPECT_EQ(mem_size, kMemorySize);
+  EXPECT_EQ(weight_size, kWeightsSize);
+  DavinciModelParser::FreeModelData(model_data);
+}
+
+TEST_F(UtestDavinciModelParser, map_invalid_file) {
+  ModelData model_data;
+  EXPECT_NE(DavinciModelParser::MapFromFile("not_exist.om", nullptr, 0, model_data), SUCCESS);
+  EXPECT_EQ(model_data.model_data, nullptr);
+
+  ofstream fs("ut_empty.om", ofstream::binary);
+  fs.close();
+  EXPECT_NE(DavinciModelParser::MapFromFile("ut_empty.om", nullptr, 0, model_data), SUCCESS);
+  EXPECT_EQ(model_data.model_data, nullptr);
+  (void)remove("ut_empty.om");
+}
+
+TEST_F(UtestDavinciModelParser, heap_model_data_is_not_advised) {
+  ModelData model_data;
+  model_data.model_data = new char[kWeightsSize];
+  model_data.model_len = kWeightsSize;
+  memcpy(model_data.model_data, weights_.data(), kWeightsSize);
+
+  // madvise would zero the pages of heap memory
+  DavinciModelParser::AdviseSequential(model_data.model_data, kWeightsSize);
+  DavinciModelParser::ReleasePages(model_data.model_data, kWeightsSize);
+  const uint8_t *data = static_cast<const uint8_t *>(model_data.model_data);
+  EXPECT_EQ(vector<uint8_t>(data, data + kWeightsSize), weights_);
+
+  DavinciModelParser::FreeModelData(model_data);
+  EXPECT_EQ(model_data.model_data, nullptr);
+}
+}  // namespace ge
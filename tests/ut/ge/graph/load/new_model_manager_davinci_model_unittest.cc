@@ -15,6 +15,10 @@
  */
 
 #include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+
 #include "common/debug/log.h"
 #include "common/debug/memory_dumper.h"
 #include "common/types.h"
@@ -54,6 +58,7 @@
 
 #include "new_op_test_utils.h"
 #include "graph/debug/ge_attr_define.h"
+#include "graph/ge_local_context.h"
 
 using namespace std;
 using namespace testing;
@@ -65,6 +70,9 @@ using domi::ModelTaskDef;
 using domi::StreamActiveDef;
 using domi::TaskDef;
 
+// defined in the runtime stub
+void rtStubSetStreamError(rtStream_t stream, rtError_t error);
+
 namespace ge {
 class UtestModelManagerDavinciModel : public testing::Test {
  protected:
@@ -1438,4 +1446,285 @@ TEST_F(UtestModelManagerDavinciModel, init_tbe_handle_ge_registered) {
   EXPECT_EQ(it->second, 3);
   DavinciModel::tvm_bin_kernel_.clear();
 }
+
+class PipelineModelListener : public ge::ModelListener {
+ public:
+  uint32_t OnComputeDone(uint32_t model_id, uint32_t data_index, uint32_t result_code) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    data_indexes_.push_back(data_index);
+    result_codes_.push_back(result_code);
+    cond_.notify_all();
+    return 0;
+  }
+
+  bool WaitFor(size_t count) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cond_.wait_for(lock, std::chrono::seconds(10), [this, count] { return data_indexes_.size() >= count; });
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::vector<uint32_t> data_indexes_;
+  std::vector<uint32_t> result_codes_;
+};
+
+// Data(64 bytes at offset 0) -> NetOutput(64 bytes at offset 512)
+static void InitPipelineModel(DavinciModel &model, uint8_t *mem_base, size_t mem_size) {
+  model.mem_base_ = mem_base;
+  model.runtime_param_.mem_size = mem_size;
+
+  GeTensorDesc tensor_desc(GeShape({16}), FORMAT_ND, DT_FLOAT);
+  TensorUtils::SetSize(tensor_desc, 64);
+
+  auto data_op = CreateOpDesc("data", "Data");
+  data_op->AddInputDesc(tensor_desc);
+  data_op->AddOutputDesc(tensor_desc);
+  data_op->SetOutputOffset({0});
+  model.data_op_list_.push_back(data_op);
+  model.data_op_input_tensor_desc_map_[data_op->GetName()] = data_op->GetInputDescPtr(0);
+  model.data_op_output_tensor_desc_map_[data_op->GetName()] = data_op->GetOutputDescPtr(0);
+
+  auto output_op = CreateOpDesc("output", "NetOutput");
+  output_op->AddInputDesc(tensor_desc);
+  output_op->SetInputOffset({512});
+  model.output_op_list_.push_back(output_op);
+
+  model.data_inputer_ = new DataInputer();
+}
+
+TEST_F(UtestModelManagerDavinciModel, pipeline_run_return_in_order) {
+  auto listener = make_shared<PipelineModelListener>();
+  DavinciModel model(0, listener);
+  std::vector<uint8_t> mem(1024);
+  InitPipelineModel(model, mem.data(), mem.size());
+
+  GetThreadLocalContext().SetSessionOption({{OPTION_EXEC_MODEL_PIPELINE_DEPTH, "2"}});
+  EXPECT_EQ(model.ModelRunStart(), SUCCESS);
+  GetThreadLocalContext().SetSessionOption({});
+  EXPECT_EQ(model.pipeline_depth_, 2);
+  EXPECT_EQ(model.pipeline_slots_.size(), 2);
+  ASSERT_EQ(model.pipeline_inputs_.size(), 1);
+  EXPECT_EQ(model.pipeline_inputs_[0].model_addr, mem.data());
+  ASSERT_EQ(model.pipeline_outputs_.size(), 1);
+  EXPECT_EQ(model.pipeline_outputs_[0].model_addr, mem.data() + 512);
+  EXPECT_EQ(model.pipeline_outputs_[0].size, 64);
+
+  const uint32_t request_num = 16;
+  std::vector<float> input(16);
+  std::vector<float> output(16);
+  for (uint32_t i = 0; i < request_num; ++i) {
+    InputData input_data;
+    input_data.index = i;
+    input_data.model_id = 0;
+    input_data.blobs.push_back(DataBuffer(input.data(), 64, false));
+    OutputData output_data;
+    output_data.blobs.push_back(DataBuffer(output.data(), 64, false));
+    auto data_wrapper = make_shared<InputDataWrapper>();
+    EXPECT_EQ(data_wrapper->Init(input_data, output_data), SUCCESS);
+    EXPECT_EQ(model.data_inputer_->Push(data_wrapper), SUCCESS);
+  }
+
+  EXPECT_TRUE(listener->WaitFor(request_num));
+  EXPECT_EQ(model.ModelRunStop(), SUCCESS);
+  EXPECT_TRUE(model.pipeline_slots_.empty());
+
+  ASSERT_EQ(listener->data_indexes_.size(), request_num);
+  for (uint32_t i = 0; i < request_num; ++i) {
+    EXPECT_EQ(listener->data_indexes_[i], i);
+    EXPECT_EQ(listener->result_codes_[i], SUCCESS);
+  }
+}
+
+TEST_F(UtestModelManagerDavinciModel, pipeline_run_bad_input_return_in_order) {
+  auto listener = make_shared<PipelineModelListener>();
+  DavinciModel model(0, listener);
+  std::vector<uint8_t> mem(1024);
+  InitPipelineModel(model, mem.data(), mem.size());
+
+  GetThreadLocalContext().SetSessionOption({{OPTION_EXEC_MODEL_PIPELINE_DEPTH, "3"}});
+  EXPECT_EQ(model.ModelRunStart(), SUCCESS);
+  GetThreadLocalContext().SetSessionOption({});
+  EXPECT_EQ(model.pipeline_depth_, 3);
+
+  // the second request is larger than the model input
+  std::vector<float> input(32);
+  std::vector<float> output(16);
+  for (uint32_t i = 0; i < 3; ++i) {
+    InputData input_data;
+    input_data.index = i;
+    input_data.blobs.push_back(DataBuffer(input.data(), (i == 1) ? 128 : 64, false));
+    OutputData output_data;
+    output_data.blobs.push_back(DataBuffer(output.data(), 64, false));
+    auto data_wrapper = make_shared<InputDataWrapper>();
+    EXPECT_EQ(data_wrapper->Init(input_data, output_data), SUCCESS);
+    EXPECT_EQ(model.data_inputer_->Push(data_wrapper), SUCCESS);
+  }
+
+  EXPECT_TRUE(listener->WaitFor(3));
+  EXPECT_EQ(model.ModelRunStop(), SUCCESS);
+
+  ASSERT_EQ(listener->data_indexes_.size(), 3);
+  EXPECT_EQ(listener->data_indexes_[0], 0);
+  EXPECT_EQ(listener->result_codes_[0], SUCCESS);
+  EXPECT_EQ(listener->data_indexes_[1], 1);
+  EXPECT_EQ(listener->result_codes_[1], INTERNAL_ERROR);
+  EXPECT_EQ(listener->data_indexes_[2], 2);
+  EXPECT_EQ(listener->result_codes_[2], SUCCESS);
+}
+
+TEST_F(UtestModelManagerDavinciModel, pipeline_run_model_stream_failed) {
+  auto listener = make_shared<PipelineModelListener>();
+  DavinciModel model(0, listener);
+  std::vector<uint8_t> mem(1024);
+  InitPipelineModel(model, mem.data(), mem.size());
+
+  GetThreadLocalContext().SetSessionOption({{OPTION_EXEC_MODEL_PIPELINE_DEPTH, "2"}});
+  EXPECT_EQ(model.ModelRunStart(), SUCCESS);
+  GetThreadLocalContext().SetSessionOption({});
+  EXPECT_EQ(model.pipeline_depth_, 2);
+
+  std::vector<float> input(16);
+  std::vector<float> output(16);
+  auto run = [&](uint32_t index, size_t returned_num) {
+    InputData input_data;
+    input_data.index = index;
+    input_data.blobs.push_back(DataBuffer(input.data(), 64, false));
+    OutputData output_data;
+    output_data.blobs.push_back(DataBuffer(output.data(), 64, false));
+    auto data_wrapper = make_shared<InputDataWrapper>();
+    EXPECT_EQ(data_wrapper->Init(input_data, output_data), SUCCESS);
+    EXPECT_EQ(model.data_inputer_->Push(data_wrapper), SUCCESS);
+    EXPECT_TRUE(listener->WaitFor(returned_num));
+  };
+  // the launches succeed, the model stream fails when it executes
+  rtStubSetStreamError(model.rt_model_stream_, RT_ERROR_END_OF_SEQUENCE);
+  run(0, 1);
+  rtStubSetStreamError(model.rt_model_stream_, RT_ERROR_MODEL_STREAM_EXE_FAILED);
+  run(1, 2);
+  rtStubSetStreamError(model.rt_model_stream_, RT_ERROR_NONE);
+  run(2, 3);
+  EXPECT_EQ(model.ModelRunStop(), SUCCESS);
+
+  ASSERT_EQ(listener->data_indexes_.size(), 3);
+  EXPECT_EQ(listener->data_indexes_, std::vector<uint32_t>({0, 1, 2}));
+  EXPECT_EQ(listener->result_codes_[0], END_OF_SEQUENCE);
+  EXPECT_EQ(listener->result_codes_[1], INTERNAL_ERROR);
+  EXPECT_EQ(listener->result_codes_[2], SUCCESS);
+}
+
+TEST_F(UtestModelManagerDavinciModel, pipeline_fallback_to_serial_run) {
+  DavinciModel model(0, g_label_call_back);
+  std::vector<uint8_t> mem(1024);
+  InitPipelineModel(model, mem.data(), mem.size());
+
+  // option not set
+  EXPECT_EQ(model.InitPipeline(), SUCCESS);
+  EXPECT_EQ(model.pipeline_depth_, 0);
+
+  // a model without outputs
+  GetThreadLocalContext().SetSessionOption({{OPTION_EXEC_MODEL_PIPELINE_DEPTH, "2"}});
+  model.output_op_list_.clear();
+  EXPECT_EQ(model.InitPipeline(), SUCCESS);
+  EXPECT_EQ(model.pipeline_depth_, 0);
+  EXPECT_TRUE(model.pipeline_slots_.empty());
+  GetThreadLocalContext().SetSessionOption({});
+}
+
+TEST_F(UtestModelManagerDavinciModel, zero_copy_patches_changed_args_only) {
+  DavinciModel model(0, g_label_call_back);
+  std::vector<uint8_t> mem(1024);
+  InitPipelineModel(model, mem.data(), mem.size());
+  model.runtime_param_.mem_base = mem.data();
+  model.output_size_list_.push_back(64);
+  model.output_op_list_[0]->AddOutputDesc(model.output_op_list_[0]->GetInputDesc(0));
+  void *input_addr = mem.data();
+  void *output_addr = mem.data() + 512;
+  model.SetOutsideAddr({input_addr});
+  model.SetOutsideAddr({output_addr});
+
+  // args of two tasks, the second one starts right after the first one
+  void *args[5] = {};
+  model.SetZeroCopyAddr({input_addr, mem.data() + 256, output_addr}, &args[0]);
+  model.SetZeroCopyAddr({input_addr, output_addr}, &args[3]);
+  EXPECT_EQ(model.InitZeroCopy(), SUCCESS);
+  ASSERT_EQ(model.zero_copy_runs_.size(), 3);
+  EXPECT_EQ(model.zero_copy_runs_[2].args_addr, &args[3]);
+  EXPECT_EQ(model.zero_copy_runs_[2].end - model.zero_copy_runs_[2].begin, 2);
+  EXPECT_EQ(model.zero_copy_mirror_, std::vector<void *>({input_addr, output_addr, input_addr, output_addr}));
+
+  std::vector<float> input1(16);
+  std::vector<float> input2(16);
+  std::vector<float> output(16);
+  InputData input_data;
+  input_data.blobs.push_back(DataBuffer(input1.data(), 64, false));
+  OutputData output_data;
+  output_data.blobs.push_back(DataBuffer(output.data(), 64, false));
+  EXPECT_EQ(model.ModelZeroCopy(input_data, output_data), SUCCESS);
+  EXPECT_EQ(model.zero_copy_mirror_,
+            std::vector<void *>({input1.data(), output.data(), input1.data(), output.data()}));
+
+  // same addresses, nothing to patch
+  model.zero_copy_mirror_[1] = nullptr;
+  EXPECT_EQ(model.ModelZeroCopy(input_data, output_data), SUCCESS);
+  EXPECT_EQ(model.zero_copy_mirror_[1], nullptr);
+
+  input_data.blobs[0].data = input2.data();
+  EXPECT_EQ(model.ModelZeroCopy(input_data, output_data), SUCCESS);
+  EXPECT_EQ(model.zero_copy_mirror_, std::vector<void *>({input2.data(), nullptr, input2.data(), output.data()}));
+
+  // a failed request leaves the args unknown, the next one writes all of them
+  input_data.blobs[0].length = 128;
+  EXPECT_EQ(model.ModelZeroCopy(input_data, output_data), PARAM_INVALID);
+  input_data.blobs[0].length = 64;
+  EXPECT_EQ(model.ModelZeroCopy(input_data, output_data), SUCCESS);
+  EXPECT_EQ(model.zero_copy_mirror_,
+            std::vector<void *>({input2.data(), output.data(), input2.data(), output.data()}));
+}
+
+// task_num event record tasks on one stream
+static void InitEventRecordTasks(DavinciModel &model, ModelTaskDef &model_task_def, size_t task_num) {
+  rtStream_t stream = nullptr;
+  rtStreamCreate(&stream, 0);
+  model.stream_list_.push_back(stream);
+  rtEvent_t event = nullptr;
+  rtEventCreate(&event);
+  model.runtime_param_.event_num = 1;
+  model.event_list_.push_back(event);
+  for (size_t i = 0; i < task_num; ++i) {
+    TaskDef *task_def = model_task_def.add_task();
+    task_def->set_type(RT_MODEL_TASK_EVENT_RECORD);
+    task_def->set_stream_id(0);
+    task_def->set_event_id(0);
+  }
+}
+
+TEST_F(UtestModelManagerDavinciModel, init_task_info_of_every_task) {
+  DavinciModel model(0, g_label_call_back);
+  ModelTaskDef model_task_def;
+  InitEventRecordTasks(model, model_task_def, 1000);
+  EXPECT_EQ(model.InitTaskInfo(model_task_def), SUCCESS);
+  ASSERT_EQ(model.task_list_.size(), 1000);
+  for (const auto &task : model.task_list_) {
+    ASSERT_NE(task, nullptr);
+  }
+
+  // a task that fails fails the init
+  model_task_def.mutable_task(700)->set_event_id(1);
+  EXPECT_NE(model.InitTaskInfo(model_task_def), SUCCESS);
+}
+
+TEST_F(UtestModelManagerDavinciModel, DISABLED_benchmark_init_task_info) {
+  const size_t task_num = 50000;
+  DavinciModel model(0, g_label_call_back);
+  ModelTaskDef model_task_def;
+  InitEventRecordTasks(model, model_task_def, task_num);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(model.InitTaskInfo(model_task_def), SUCCESS);
+  }
+  auto cost =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() / 10;
+  std::cout << "init " << task_num << " tasks cost " << cost << " ms" << std::endl;
+}
 }  // namespace ge
@@ -16,6 +16,9 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <iostream>
+
 #include <cce/compiler_stub.h>
 #include "common/debug/log.h"
 #include "common/model_parser/base.h"
@@ -27,11 +30,13 @@
 #define protected public
 #include "graph/load/new_model_manager/model_manager.h"
 
+#include "common/helper/model_helper.h"
 #include "common/helper/om_file_helper.h"
 #include "common/op/ge_op_utils.h"
 #include "graph/load/graph_loader.h"
 #include "graph/load/new_model_manager/davinci_model.h"
 #include "graph/load/new_model_manager/davinci_model_parser.h"
+#include "graph/manager/graph_mem_allocator.h"
 #include "new_op_test_utils.h"
 #undef private
 #undef protected
@@ -441,4 +446,60 @@ TEST_F(UtestModelManagerModelManager, destroy_aicpu_session) {
   manager.DestroyAicpuSession(0);
 }
 
+namespace {
+GeModelPtr CreateOnlineModel(uint32_t task_num) {
+  auto ge_model = make_shared<GeModel>();
+  auto compute_graph = make_shared<ComputeGraph>("graph");
+  ge_model->SetGraph(GraphUtils::CreateGraphFromComputeGraph(compute_graph));
+  auto model_task_def = make_shared<domi::ModelTaskDef>();
+  for (uint32_t i = 0; i < task_num; ++i) {
+    domi::TaskDef *task_def = model_task_def->add_task();
+    task_def->set_type(RT_MODEL_TASK_KERNEL);
+    domi::KernelDef *kernel_def = task_def->mutable_kernel();
+    kernel_def->set_stub_func("stub_func");
+    kernel_def->set_args(string(256, 'a'));
+    kernel_def->set_args_size(256);
+    kernel_def->mutable_context()->set_op_index(i);
+  }
+  ge_model->SetModelTaskDef(model_task_def);
+  return ge_model;
+}
+}  // namespace
+
+// the built model is assigned as it is
+TEST_F(UtestModelManagerModelManager, load_model_online_from_ge_model) {
+  ModelManager manager;
+  uint32_t model_id = 0;
+  EXPECT_EQ(manager.LoadModelOnline(model_id, GeModelPtr(), UTEST_CALL_BACK_FUN), PARAM_INVALID);
+
+  MemManager::Instance().Initialize(std::vector<rtMemType_t>({RT_MEMORY_HBM}));
+  GeModelPtr ge_model = CreateOnlineModel(0);
+  EXPECT_EQ(manager.LoadModelOnline(model_id, ge_model, UTEST_CALL_BACK_FUN), SUCCESS);
+  std::shared_ptr<DavinciModel> davinci_model = manager.GetModel(model_id);
+  ASSERT_NE(davinci_model, nullptr);
+  EXPECT_EQ(davinci_model->ge_model_, ge_model);
+  EXPECT_EQ(davinci_model->model_task_def_, ge_model->GetModelTaskDefPtr());
+  EXPECT_EQ(manager.DeleteModel(model_id), SUCCESS);
+  davinci_model.reset();
+  MemManager::Instance().Finalize();
+}
+
+TEST_F(UtestModelManagerModelManager, DISABLED_benchmark_load_online_large_task_list) {
+  for (uint32_t task_num = 10000; task_num <= 80000; task_num *= 2) {
+    GeModelPtr ge_model = CreateOnlineModel(task_num);
+
+    // what loading a built model cost before it was assigned directly
+    auto start = chrono::steady_clock::now();
+    ModelPtr model;
+    EXPECT_EQ(ModelHelper::TransGeModelToModel(ge_model, model), SUCCESS);
+    GeModelPtr round_trip_model;
+    EXPECT_EQ(ModelHelper::TransModelToGeModel(model, round_trip_model), SUCCESS);
+    auto round_trip_cost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(round_trip_model->GetModelTaskDefPtr()->task_size(), task_num);
+
+    cout << task_num << " tasks, round trip through ge::Model cost " << round_trip_cost
+         << " ms, direct assign cost 0 ms" << endl;
+  }
+}
+
 }  // namespace ge
@@ -0,0 +1,243 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <set>
+#include <string>
+#include <vector>
+
+#define protected public
+#define private public
+#include "graph/partition/graph_partition.h"
+#undef protected
+#undef private
+
+#include "graph/compute_graph.h"
+#include "graph/utils/graph_utils.h"
+
+using namespace std;
+
+namespace ge {
+namespace {
+const vector<string> kEngines = {"AIcoreEngine", "AICPUEngine", "ops_kernel_info_hccl"};
+
+class GraphBuilder {
+ public:
+  explicit GraphBuilder(const string &name) : graph_(make_shared<ComputeGraph>(name)) {}
+
+  NodePtr AddNode(const string &engine, const vector<NodePtr> &inputs) {
+    OpDescPtr op_desc = make_shared<OpDesc>("node" + to_string(engines_.size()), "Op");
+    op_desc->AddInputDesc(GeTensorDesc());
+    op_desc->AddOutputDesc(GeTensorDesc());
+    NodePtr node = graph_->AddNode(op_desc);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      if (i == 0) {
+        (void)GraphUtils::AddEdge(inputs[i]->GetOutDataAnchor(0), node->GetInDataAnchor(0));
+      } else {
+        (void)GraphUtils::AddEdge(inputs[i]->GetOutControlAnchor(), node->GetInControlAnchor());
+      }
+    }
+    engines_.push_back(engine);
+    return node;
+  }
+
+  const ComputeGraphPtr &GetGraph() const { return graph_; }
+
+  const vector<string> &GetEngines() const { return engines_; }
+
+ private:
+  ComputeGraphPtr graph_;
+  vector<string> engines_;
+};
+
+// lanes of nodes whose engine changes every few layers, linked to the next lane and to a few layers before
+GraphBuilder BuildInterleavedGraph(size_t lane_num, size_t layer_num) {
+  GraphBuilder builder("interleaved");
+  vector<vector<NodePtr>> layers;
+  for (size_t layer = 0; layer < layer_num; ++layer) {
+    vector<NodePtr> nodes;
+    for (size_t lane = 0; lane < lane_num; ++lane) {
+      vector<NodePtr> inputs;
+      if (layer > 0) {
+        inputs.push_back(layers[layer - 1][lane]);
+        if ((layer + lane) % 2 == 0) {
+          inputs.push_back(layers[layer - 1][(lane + 1) % lane_num]);
+        }
+      }
+      if (layer >= 5 && (layer * 7 + lane) % 5 == 0) {
+        inputs.push_back(layers[layer - 5][(lane + 3) % lane_num]);
+      }
+      const string &engine = kEngines[((layer / 3) + lane * (layer % 4 == 0 ? 2 : 1)) % kEngines.size()];
+      nodes.push_back(builder.AddNode(engine, inputs));
+    }
+    layers.push_back(nodes);
+  }
+  return builder;
+}
+
+// layers of lanes of AI core ops with a few AI cpu ops, closed by an all reduce, every layer reads the mask too
+GraphBuilder BuildLayeredGraph(size_t lane_num, size_t layer_num) {
+  GraphBuilder builder("layered");
+  NodePtr mask = builder.AddNode(kEngines[0], {});
+  vector<NodePtr> lanes(lane_num, mask);
+  for (size_t layer = 0; layer < layer_num; ++layer) {
+    for (size_t lane = 0; lane < lane_num; ++lane) {
+      NodePtr node = builder.AddNode(kEngines[0], {lanes[lane], mask});
+      node = builder.AddNode(kEngines[0], {node});
+      if ((layer + lane) % 3 == 0) {
+        node = builder.AddNode(kEngines[1], {node});
+      }
+      lanes[lane] = builder.AddNode(kEngines[0], {node, mask});
+    }
+    NodePtr all_reduce = builder.AddNode(kEngines[2], lanes);
+    for (size_t lane = 0; lane < lane_num; ++lane) {
+      lanes[lane] = builder.AddNode(kEngines[0], {all_reduce, lanes[lane]});
+    }
+  }
+  return builder;
+}
+
+// same as the clusters made by Initialize, without placing the engines
+void InitClusters(GraphPartitioner &partitioner, const GraphBuilder &builder) {
+  size_t index = 0;
+  for (const auto &node : builder.GetGraph()->GetDirectNode()) {
+    ClusterPtr cluster = make_shared<Cluster>(index, builder.GetEngines()[index], "");
+    cluster->nodes_.push_back(node);
+    for (const auto &parent : node->GetInAllNodes()) {
+      cluster->in_clu_.insert(partitioner.node_2_cluster_.at(parent)->index_);
+      partitioner.node_2_cluster_.at(parent)->out_clu_.insert(index);
+    }
+    partitioner.node_2_cluster_[node] = cluster;
+    partitioner.clusters_.push_back(cluster);
+    ++index;
+  }
+}
+
+// node names of every cluster, ordered by the first node
+vector<vector<string>> GetClusters(GraphPartitioner &partitioner, const ComputeGraphPtr &graph) {
+  map<ClusterPtr, size_t> cluster_2_index;
+  vector<vector<string>> clusters;
+  for (const auto &node : graph->GetDirectNode()) {
+    ClusterPtr cluster = partitioner.node_2_cluster_.at(node);
+    auto iter = cluster_2_index.emplace(cluster, clusters.size()).first;
+    if (iter->second == clusters.size()) {
+      clusters.emplace_back();
+    }
+    clusters[iter->second].push_back(node->GetName());
+  }
+  return clusters;
+}
+
+// every cluster is of one engine, the graph of the clusters is acyclic and ranked topologically
+void CheckClusters(const GraphBuilder &builder) {
+  GraphPartitioner partitioner;
+  InitClusters(partitioner, builder);
+  partitioner.MarkClusters();
+
+  set<pair<ClusterPtr, ClusterPtr>> edges;
+  map<ClusterPtr, size_t> in_nums;
+  size_t index = 0;
+  for (const auto &node : builder.GetGraph()->GetDirectNode()) {
+    ClusterPtr cluster = partitioner.node_2_cluster_.at(node);
+    EXPECT_EQ(cluster->engine_name_, builder.GetEngines()[index++]);
+    auto node_num = count_if(partitioner.node_2_cluster_.begin(), partitioner.node_2_cluster_.end(),
+                             [&cluster](const pair<const NodePtr, ClusterPtr> &node_cluster) {
+                               return node_cluster.second == cluster;
+                             });
+    EXPECT_EQ(cluster->nodes_.size(), static_cast<size_t>(node_num));
+    in_nums.emplace(cluster, 0);
+    for (const auto &parent : node->GetInAllNodes()) {
+      ClusterPtr parent_cluster = partitioner.node_2_cluster_.at(parent);
+      if (parent_cluster == cluster) {
+        continue;
+      }
+      // the ranks kept while merging are topological
+      EXPECT_LT(partitioner.cluster_ranks_[parent_cluster->index_], partitioner.cluster_ranks_[cluster->index_]);
+      if (edges.emplace(parent_cluster, cluster).second) {
+        ++in_nums[cluster];
+      }
+    }
+  }
+  EXPECT_LT(in_nums.size(), builder.GetEngines().size() / 2);
+
+  queue<ClusterPtr> ready;
+  for (const auto &in_num : in_nums) {
+    if (in_num.second == 0) {
+      ready.push(in_num.first);
+    }
+  }
+  size_t sorted_num = 0;
+  while (!ready.empty()) {
+    ClusterPtr cluster = ready.front();
+    ready.pop();
+    ++sorted_num;
+    for (const auto &edge : edges) {
+      if ((edge.first == cluster) && (--in_nums[edge.second] == 0)) {
+        ready.push(edge.second);
+      }
+    }
+  }
+  EXPECT_EQ(sorted_num, in_nums.size());
+}
+}  // namespace
+
+class UtestGraphPartition : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+TEST_F(UtestGraphPartition, mark_clusters_merges_same_engine) {
+  GraphBuilder builder("graph");
+  NodePtr node0 = builder.AddNode(kEngines[0], {});
+  NodePtr node1 = builder.AddNode(kEngines[1], {node0});
+  NodePtr node2 = builder.AddNode(kEngines[0], {node1, node0});
+  NodePtr node3 = builder.AddNode(kEngines[0], {node2});
+  NodePtr node4 = builder.AddNode(kEngines[1], {node1});
+  (void)builder.AddNode(kEngines[1], {node3, node4});
+
+  GraphPartitioner partitioner;
+  InitClusters(partitioner, builder);
+  partitioner.MarkClusters();
+
+  // node0 and node2 can not merge for the path through node1, neither can node4 and node5 for the one through node3
+  vector<vector<string>> expect = {{"node0"}, {"node1", "node4"}, {"node2", "node3"}, {"node5"}};
+  EXPECT_EQ(GetClusters(partitioner, builder.GetGraph()), expect);
+}
+
+TEST_F(UtestGraphPartition, mark_clusters_keeps_clusters_acyclic) {
+  CheckClusters(BuildInterleavedGraph(6, 60));
+  CheckClusters(BuildLayeredGraph(4, 20));
+}
+
+TEST_F(UtestGraphPartition, DISABLED_benchmark_mark_clusters) {
+  GraphBuilder builder = BuildLayeredGraph(16, 250);
+  GraphPartitioner partitioner;
+  InitClusters(partitioner, builder);
+  auto start = chrono::steady_clock::now();
+  partitioner.MarkClusters();
+  auto cost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+  cout << "mark clusters of " << builder.GetEngines().size() << " nodes into "
+       << GetClusters(partitioner, builder.GetGraph()).size() << " clusters cost " << cost << " ms" << endl;
+}
+}  // namespace ge
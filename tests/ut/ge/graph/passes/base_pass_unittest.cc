@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <iostream>
 #include <map>
 #include <set>
@@ -93,6 +94,38 @@ class TestDelPass : public BaseNodePass {
   Status Run(NodePtr &node) override { return SUCCESS; }
 };
 
+class RePassOutPass : public BaseNodePass {
+ public:
+  Status Run(NodePtr &node) override {
+    // touch the out nodes once, like the shape/folding passes do after changing a node
+    if (!visited_.insert(node.get()).second) {
+      return SUCCESS;
+    }
+    for (auto &out_node : node->GetOutDataNodes()) {
+      AddRePassNode(out_node);
+    }
+    return SUCCESS;
+  }
+
+ private:
+  std::unordered_set<Node *> visited_;
+};
+
+class NestedRunPass : public BaseNodePass {
+ public:
+  Status Run(NodePtr &node) override {
+    // walk the whole graph again from inside the outer walk, once
+    if (inner_pass_.GetRunTimes() == 0) {
+      NamesToPass names_to_pass;
+      names_to_pass.push_back(std::make_pair("inner", &inner_pass_));
+      auto graph = node->GetOwnerComputeGraph();
+      EXPECT_EQ(GEPass(graph).Run(names_to_pass), SUCCESS);
+    }
+    return SUCCESS;
+  }
+  UtestTestPass inner_pass_{false};
+};
+
 class UTESTGraphPassesBasePass : public testing::Test {
  protected:
   UTESTGraphPassesBasePass() {
@@ -430,6 +463,50 @@ TEST_F(UTESTGraphPassesBasePass, dead_loop) {
   EXPECT_EQ(test_pass.GetRunTimes(), 1007);
 }
 
+size_t CountIterNodes(UtestTestPass &pass, const std::string &name) {
+  size_t count = 0;
+  for (const auto &node : pass.GetIterNodes()) {
+    if (node->GetName() == name) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+TEST_F(UTESTGraphPassesBasePass, re_pass_node_queued_once) {
+  NamesToPass names_to_pass;
+  auto test_pass1 = UtestTestPass();
+  auto test_pass2 = UtestTestPass();
+  names_to_pass.push_back(std::make_pair("test1", &test_pass1));
+  names_to_pass.push_back(std::make_pair("test2", &test_pass2));
+
+  // data1 is asked for by several nodes and by both passes, it runs again only once
+  test_pass1.AddRePassNodeName("add1", "data1");
+  test_pass1.AddRePassNodeName("addn1", "data1");
+  test_pass2.AddRePassNodeName("add1", "data1");
+  test_pass2.AddRePassNodeName("sum1", "data1");
+  // add1 is asked for while it is still waiting in the queue, it runs only once
+  test_pass1.AddRePassNodeName("const2", "add1");
+  test_pass2.AddRePassNodeName("shape1", "add1");
+
+  auto graph = BuildGraph2();
+  auto ge_pass = GEPass(graph);
+  EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
+  EXPECT_EQ(test_pass1.GetIterNodes().size(), 9);
+  EXPECT_EQ(test_pass2.GetIterNodes().size(), 9);
+  EXPECT_EQ(CountIterNodes(test_pass1, "data1"), 2);
+  EXPECT_EQ(CountIterNodes(test_pass2, "data1"), 2);
+  EXPECT_EQ(CountIterNodes(test_pass1, "add1"), 1);
+  EXPECT_EQ(test_pass1.GetIterNodes().back()->GetName(), "data1");
+
+  // a second run on the same graph starts from clean marks
+  test_pass1.clear();
+  test_pass2.clear();
+  EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
+  EXPECT_EQ(test_pass1.GetIterNodes().size(), 8);
+  EXPECT_EQ(CountIterNodes(test_pass1, "data1"), 1);
+}
+
 TEST_F(UTESTGraphPassesBasePass, while_loop) {
   NamesToPass names_to_pass;
   auto test_pass = UtestTestPass(true);
@@ -439,4 +516,62 @@ TEST_F(UTESTGraphPassesBasePass, while_loop) {
   auto ge_pass = GEPass(graph);
   EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
 }
+
+///  every node i (i > 1) consumes node i-1 and node i-2, with a control edge
+///  from node i-3, which keeps the ready checks of the driver busy
+ComputeGraphPtr BuildLadderGraph(int node_num) {
+  auto builder = ut::GraphBuilder("ladder");
+  std::vector<NodePtr> nodes;
+  nodes.reserve(node_num);
+  nodes.push_back(builder.AddNode("data0", DATA, 0, 1, FORMAT_NCHW, DT_FLOAT, {1}));
+  nodes.push_back(builder.AddNode("data1", DATA, 0, 1, FORMAT_NCHW, DT_FLOAT, {1}));
+  for (int i = 2; i < node_num; ++i) {
+    nodes.push_back(builder.AddNode("add" + std::to_string(i), ADD, 2, 1, FORMAT_NCHW, DT_FLOAT, {1}));
+    builder.AddDataEdge(nodes[i - 1], 0, nodes[i], 0);
+    builder.AddDataEdge(nodes[i - 2], 0, nodes[i], 1);
+    if (i > 2) {
+      builder.AddControlEdge(nodes[i - 3], nodes[i]);
+    }
+  }
+  return builder.GetGraph();
+}
+
+TEST_F(UTESTGraphPassesBasePass, nested_run) {
+  auto graph = BuildGraph1();
+  NestedRunPass nested_pass;
+  NamesToPass names_to_pass = names_to_pass_;
+  names_to_pass.push_back(std::make_pair("nested", &nested_pass));
+  EXPECT_EQ(GEPass(graph).Run(names_to_pass), SUCCESS);
+
+  // both walks see every node once, in order
+  EXPECT_EQ(nested_pass.inner_pass_.GetIterNodes().size(), 4);
+  auto *pass = dynamic_cast<UtestTestPass *>(names_to_pass_[0].second);
+  EXPECT_EQ(pass->GetIterNodes().size(), 4);
+  std::vector<std::unordered_set<std::string>> layers;
+  layers.push_back({"data1", "const1"});
+  layers.push_back({"add1"});
+  layers.push_back({"reshape1"});
+  CheckIterOrder(pass, layers);
+}
+
+void RunDriverBenchmark(int node_num) {
+  auto graph = BuildLadderGraph(node_num);
+  TestDelPass empty_pass;
+  RePassOutPass re_pass;
+  NamesToPass names_to_pass;
+  names_to_pass.push_back(std::make_pair("empty", &empty_pass));
+  names_to_pass.push_back(std::make_pair("re_pass", &re_pass));
+
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(GEPass(graph).Run(names_to_pass), SUCCESS);
+  auto cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  std::cout << "GEPass driver, " << node_num << " nodes: " << cost.count() << " ms" << std::endl;
+}
+
+/// Driver microbenchmarks, run with --gtest_also_run_disabled_tests
+TEST_F(UTESTGraphPassesBasePass, DISABLED_benchmark_driver_10k) { RunDriverBenchmark(10000); }
+
+TEST_F(UTESTGraphPassesBasePass, DISABLED_benchmark_driver_50k) { RunDriverBenchmark(50000); }
+
+TEST_F(UTESTGraphPassesBasePass, DISABLED_benchmark_driver_100k) { RunDriverBenchmark(100000); }
 }  // namespace ge
@@ -0,0 +1,246 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#define protected public
+#define private public
+#include "graph/passes/folding_kernel/folding_compute.h"
+
+#include "common/types.h"
+#include "graph/common/bcast.h"
+#include "graph/debug/ge_attr_define.h"
+#include "graph/op_desc.h"
+#include "graph/utils/attr_utils.h"
+#include "inc/kernel.h"
+#include "inc/kernel_factory.h"
+#undef protected
+#undef private
+
+using namespace std;
+using namespace testing;
+using namespace ge;
+
+namespace {
+template <typename T>
+ConstGeTensorPtr CreateTensor(const vector<int64_t> &dims, const vector<T> &data, DataType data_type) {
+  GeTensorDesc tensor_desc(GeShape(dims), FORMAT_NCHW, data_type);
+  return make_shared<GeTensor>(tensor_desc, reinterpret_cast<const uint8_t *>(data.data()), data.size() * sizeof(T));
+}
+
+vector<int32_t> RandomData(int64_t num, mt19937 &engine) {
+  uniform_int_distribution<int32_t> distribution(-1000, 1000);
+  vector<int32_t> data(static_cast<size_t>(num));
+  for (auto &value : data) {
+    value = distribution(engine);
+  }
+  return data;
+}
+
+int64_t GetElementNum(const vector<int64_t> &dims) {
+  int64_t num = 1;
+  for (auto dim : dims) {
+    num *= dim;
+  }
+  return num;
+}
+
+int32_t AddInt32(const int32_t &x, const int32_t &y) { return x * 3 + y; }
+}  // namespace
+
+class UtestFoldingCompute : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+TEST_F(UtestFoldingCompute, broadcast_info) {
+  BroadcastInfo info;
+  EXPECT_EQ(FoldingCompute::GetBroadcastInfo({2, 3, 4}, {3, 1}, info), SUCCESS);
+  EXPECT_EQ(info.output_shape, vector<int64_t>({2, 3, 4}));
+  EXPECT_EQ(info.element_num, 24);
+  EXPECT_EQ(info.x_element_num, 24);
+  EXPECT_EQ(info.y_element_num, 3);
+  EXPECT_EQ(info.dims, vector<int64_t>({2, 3, 4}));
+  EXPECT_EQ(info.x_strides, vector<int64_t>({12, 4, 1}));
+  EXPECT_EQ(info.y_strides, vector<int64_t>({0, 1, 0}));
+
+  // the dims broadcast in the same way are merged
+  EXPECT_EQ(FoldingCompute::GetBroadcastInfo({2, 3, 4}, {1}, info), SUCCESS);
+  EXPECT_EQ(info.dims, vector<int64_t>({24}));
+  EXPECT_EQ(info.x_strides, vector<int64_t>({1}));
+  EXPECT_EQ(info.y_strides, vector<int64_t>({0}));
+  EXPECT_EQ(FoldingCompute::GetBroadcastInfo({5, 1, 6}, {1, 4, 1}, info), SUCCESS);
+  EXPECT_EQ(info.output_shape, vector<int64_t>({5, 4, 6}));
+  EXPECT_EQ(info.dims, vector<int64_t>({5, 4, 6}));
+  EXPECT_EQ(info.y_strides, vector<int64_t>({0, 1, 0}));
+
+  EXPECT_EQ(FoldingCompute::GetBroadcastInfo({}, {}, info), SUCCESS);
+  EXPECT_TRUE(info.output_shape.empty());
+  EXPECT_EQ(info.element_num, 1);
+  EXPECT_EQ(info.dims, vector<int64_t>({1}));
+
+  EXPECT_EQ(FoldingCompute::GetBroadcastInfo({2, 3}, {2}, info), PARAM_INVALID);
+  EXPECT_EQ(FoldingCompute::GetBroadcastInfo({-1, 3}, {3}, info), PARAM_INVALID);
+}
+
+TEST_F(UtestFoldingCompute, same_as_bcast_compute) {
+  mt19937 engine(0);
+  vector<pair<vector<int64_t>, vector<int64_t>>> shapes = {{{4}, {}},
+                                                            {{}, {4}},
+                                                            {{3, 4}, {4}},
+                                                            {{3, 1}, {1, 4}},
+                                                            {{2, 3, 4}, {3, 1}},
+                                                            {{5, 1, 6, 1}, {4, 1, 7}},
+                                                            {{1, 2, 1, 3}, {2, 2, 2, 1}},
+                                                            // the output is split over the task executor
+                                                            {{256, 1, 600}, {1, 3, 600}}};
+  for (const auto &shape : shapes) {
+    vector<int32_t> x_data = RandomData(GetElementNum(shape.first), engine);
+    vector<int32_t> y_data = RandomData(GetElementNum(shape.second), engine);
+    vector<ConstGeTensorPtr> input = {CreateTensor(shape.first, x_data, DT_INT32),
+                                      CreateTensor(shape.second, y_data, DT_INT32)};
+
+    BCast bcast;
+    vector<int32_t> expect;
+    ASSERT_EQ((bcast.BCastCompute<int32_t, int32_t>(input, expect, AddInt32)), SUCCESS);
+    BroadcastInfo info;
+    vector<int32_t> output;
+    ASSERT_EQ(FoldingCompute::BroadcastCompute<int32_t>(input[0], input[1], AddInt32, output, info), SUCCESS);
+    EXPECT_EQ(info.output_shape, bcast.GetOutputShape());
+    EXPECT_EQ(output, expect);
+  }
+
+  // no elements
+  vector<int32_t> y_data = {1, 2, 3};
+  BroadcastInfo info;
+  vector<int32_t> output;
+  EXPECT_EQ(FoldingCompute::BroadcastCompute<int32_t>(CreateTensor({0, 3}, vector<int32_t>(), DT_INT32),
+                                                      CreateTensor({3}, y_data, DT_INT32), AddInt32, output, info),
+            SUCCESS);
+  EXPECT_EQ(info.output_shape, vector<int64_t>({0, 3}));
+  EXPECT_TRUE(output.empty());
+}
+
+TEST_F(UtestFoldingCompute, invalid_inputs) {
+  vector<int64_t> dims = {2000};
+  vector<int32_t> x_data(2000, 1);
+  vector<int32_t> y_data(2000, 1);
+  y_data[1500] = 0;
+  ConstGeTensorPtr x = CreateTensor(dims, x_data, DT_INT32);
+  ConstGeTensorPtr y = CreateTensor(dims, y_data, DT_INT32);
+  auto div = [](const int32_t &a, const int32_t &b) { return a / b; };
+  auto is_zero = [](const int32_t &, const int32_t &b) { return b == 0; };
+  BroadcastInfo info;
+  vector<int32_t> output;
+  EXPECT_EQ(FoldingCompute::BroadcastCompute<int32_t>(x, y, div, is_zero, output, info), PARAM_INVALID);
+
+  // the data is shorter than the shape
+  ConstGeTensorPtr short_y = CreateTensor({3000}, y_data, DT_INT32);
+  EXPECT_EQ(FoldingCompute::BroadcastCompute<int32_t>(x, short_y, div, output, info), PARAM_INVALID);
+
+  OpDescPtr op_desc = make_shared<OpDesc>("Add", ADD);
+  (void)op_desc->AddOutputDesc(GeTensorDesc(GeShape(dims), FORMAT_NCHW, DT_INT32));
+  shared_ptr<Kernel> kernel = KernelFactory::Instance().Create(ADD);
+  ASSERT_NE(kernel, nullptr);
+  vector<GeTensorPtr> v_output;
+  EXPECT_EQ(kernel->Compute(op_desc, {x, y}, v_output), SUCCESS);
+  // the fold is given up on an overflow
+  vector<int32_t> max_data(2000, INT32_MAX);
+  v_output.clear();
+  EXPECT_EQ(kernel->Compute(op_desc, {x, CreateTensor(dims, max_data, DT_INT32)}, v_output), NOT_CHANGED);
+}
+
+TEST_F(UtestFoldingCompute, parallel_for) {
+  const int64_t num = 1000000;
+  vector<atomic<int>> hits(num);
+  auto count_hits = [&hits](int64_t begin, int64_t end) -> Status {
+    for (int64_t i = begin; i < end; ++i) {
+      hits[i]++;
+    }
+    return SUCCESS;
+  };
+  EXPECT_EQ(FoldingCompute::ParallelFor(num, count_hits), SUCCESS);
+  int64_t wrong_num = 0;
+  for (auto &hit : hits) {
+    wrong_num += (hit != 1) ? 1 : 0;
+  }
+  EXPECT_EQ(wrong_num, 0);
+
+  auto fail_later_ranges = [](int64_t begin, int64_t) -> Status { return (begin == 0) ? SUCCESS : PARAM_INVALID; };
+  EXPECT_EQ(FoldingCompute::ParallelFor(num, fail_later_ranges), PARAM_INVALID);
+}
+
+TEST_F(UtestFoldingCompute, DISABLED_benchmark_folding_kernels) {
+  const int round_num = 5;
+  mt19937 engine(0);
+  vector<int64_t> x_dims = {128, 1, 256};
+  vector<int64_t> y_dims = {1, 128, 256};
+  vector<int32_t> x_data = RandomData(GetElementNum(x_dims), engine);
+  vector<int32_t> y_data = RandomData(GetElementNum(y_dims), engine);
+  // no zero divisors
+  for (auto &value : y_data) {
+    value = (value == 0) ? 1 : value;
+  }
+  vector<ConstGeTensorPtr> input = {CreateTensor(x_dims, x_data, DT_INT32), CreateTensor(y_dims, y_data, DT_INT32)};
+
+  auto start = chrono::steady_clock::now();
+  for (int i = 0; i < round_num; ++i) {
+    BCast bcast;
+    vector<int32_t> output;
+    (void)bcast.BCastCompute<int32_t, int32_t>(input, output, AddInt32);
+  }
+  auto cost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+  cout << round_num << " index broadcasts cost " << cost << " ms" << endl;
+
+  start = chrono::steady_clock::now();
+  for (int i = 0; i < round_num; ++i) {
+    BroadcastInfo info;
+    vector<int32_t> output;
+    (void)FoldingCompute::BroadcastCompute<int32_t>(input[0], input[1], AddInt32, output, info);
+  }
+  cost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+  cout << round_num << " stride broadcasts cost " << cost << " ms" << endl;
+
+  // floordiv takes the inputs of the same shape or a scalar only
+  vector<int64_t> output_dims = {128, 128, 256};
+  vector<int32_t> output_data = RandomData(GetElementNum(output_dims), engine);
+  vector<int32_t> scalar_data = {7};
+  vector<ConstGeTensorPtr> scalar_input = {CreateTensor(output_dims, output_data, DT_INT32),
+                                           CreateTensor({}, scalar_data, DT_INT32)};
+  for (const string &type : {ADD, MUL, SUB, GREATER, MAXIMUM, FLOORDIV, FLOORMOD}) {
+    OpDescPtr op_desc = make_shared<OpDesc>(type, type);
+    (void)AttrUtils::SetInt(op_desc, ATTR_NAME_T, static_cast<int64_t>(DT_INT32));
+    DataType output_type = (type == GREATER) ? DT_BOOL : DT_INT32;
+    (void)op_desc->AddOutputDesc(GeTensorDesc(GeShape(output_dims), FORMAT_NCHW, output_type));
+    shared_ptr<Kernel> kernel = KernelFactory::Instance().Create(type);
+    ASSERT_NE(kernel, nullptr);
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < round_num; ++i) {
+      vector<GeTensorPtr> v_output;
+      EXPECT_EQ(kernel->Compute(op_desc, (type == FLOORDIV) ? scalar_input : input, v_output), SUCCESS);
+    }
+    cost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    cout << round_num << " folds of " << type << " cost " << cost << " ms" << endl;
+  }
+}
@@ -328,6 +328,33 @@ TEST_F(UtestGraphPassesFoldingKernelRangeKernel, NegativeSuccess) {
   EXPECT_EQ(outputs[0]->GetTensorDesc().GetShape().GetDim(0), 7);
 }
 
+TEST_F(UtestGraphPassesFoldingKernelRangeKernel, Int32BoundsSuccess) {
+  OpDescPtr op_desc_ptr = std::make_shared<OpDesc>("Range", RANGE);
+  AttrUtils::SetInt(op_desc_ptr, ATTR_NAME_T, (int64_t)DT_INT32);
+  shared_ptr<Kernel> kernel = KernelFactory::Instance().Create(RANGE);
+
+  // limit - start and i * delta do not fit in int32
+  auto compute = [&](int32_t start, int32_t limit, int32_t delta) {
+    vector<ConstGeTensorPtr> input;
+    for (int32_t value : {start, limit, delta}) {
+      GeTensorDesc tensor_desc(GeShape(), FORMAT_NCHW, DT_INT32);
+      input.push_back(std::make_shared<GeTensor>(tensor_desc, (uint8_t *)&value, sizeof(int32_t)));
+    }
+    vector<GeTensorPtr> outputs;
+    EXPECT_EQ(kernel->Compute(op_desc_ptr, input, outputs), SUCCESS);
+    vector<int32_t> values;
+    if (!outputs.empty()) {
+      auto data = reinterpret_cast<const int32_t *>(outputs[0]->GetData().data());
+      values.assign(data, data + outputs[0]->GetData().size() / sizeof(int32_t));
+    }
+    return values;
+  };
+  EXPECT_EQ(compute(-2000000000, 2000000000, 1000000000),
+            vector<int32_t>({-2000000000, -1000000000, 0, 1000000000}));
+  EXPECT_EQ(compute(2000000000, -2000000000, -1500000000), vector<int32_t>({2000000000, 500000000, -1000000000}));
+  EXPECT_EQ(compute(INT32_MIN, INT32_MAX, INT32_MAX), vector<int32_t>({INT32_MIN, -1, INT32_MAX - 1}));
+}
+
 TEST_F(UtestGraphPassesFoldingKernelRangeKernel, RangeError) {
   OpDescPtr op_desc_ptr = std::make_shared<OpDesc>("Range", RANGE);
   AttrUtils::SetInt(op_desc_ptr, ATTR_NAME_T, (int64_t)DT_INT32);
@@ -0,0 +1,241 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+#define private public
+#include "graph/manager/trans_var_data_utils.h"
+#undef private
+
+#include "framework/common/types.h"
+
+using namespace std;
+
+namespace ge {
+namespace {
+// the memory of the runtime stub is on host, the copies are done at once
+rtError_t HostMemcpyAsync(void *dst, uint64_t dest_max, const void *src, uint64_t count, rtMemcpyKind_t kind,
+                          rtStream_t stream) {
+  EXPECT_LE(count, dest_max);
+  memcpy(dst, src, count);
+  return RT_ERROR_NONE;
+}
+
+mutex overlap_mutex;
+condition_variable overlap_cond;
+set<thread::id> overlap_threads;
+
+// the first copies wait for another thread to copy, so two transfers hold a lane at the same time
+rtError_t OverlappedMemcpyAsync(void *dst, uint64_t dest_max, const void *src, uint64_t count, rtMemcpyKind_t kind,
+                                rtStream_t stream) {
+  {
+    unique_lock<mutex> lock(overlap_mutex);
+    overlap_threads.insert(this_thread::get_id());
+    overlap_cond.notify_all();
+    overlap_cond.wait(lock, [] { return overlap_threads.size() >= 2; });
+  }
+  return HostMemcpyAsync(dst, dest_max, src, count, kind, stream);
+}
+
+TransNodeInfo MakeTrans(const string &node_type, Format src_format, const vector<int64_t> &src_shape,
+                        DataType src_type, Format dst_format, const vector<int64_t> &dst_shape, DataType dst_type) {
+  return {node_type, GeTensorDesc(GeShape(src_shape), src_format, src_type),
+          GeTensorDesc(GeShape(dst_shape), dst_format, dst_type)};
+}
+
+vector<uint8_t> MakeFloatData(size_t elem_num) {
+  mt19937 engine(elem_num);
+  uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+  vector<float> values(elem_num);
+  for (auto &value : values) {
+    value = distribution(engine);
+  }
+  vector<uint8_t> data(elem_num * sizeof(float));
+  memcpy(data.data(), values.data(), data.size());
+  return data;
+}
+
+// the result of the whole variable converted on host at once
+vector<uint8_t> TransWhole(vector<uint8_t> data, const VarTransRoad &trans_road) {
+  formats::TransResult result{};
+  EXPECT_EQ(TransVarDataUtils::TransVarOnHost(data.data(), trans_road, result), SUCCESS);
+  return vector<uint8_t>(result.data.get(), result.data.get() + result.length);
+}
+
+void InitTransfer(VarTransfer &transfer) { transfer.copy_func_ = HostMemcpyAsync; }
+}  // namespace
+
+class UtestTransVarDataUtils : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+TEST_F(UtestTransVarDataUtils, cast_by_chunk_same_as_whole) {
+  const int64_t elem_num = 10007;
+  VarTransRoad trans_road = {
+      MakeTrans(RESHAPE, FORMAT_ND, {elem_num}, DT_FLOAT, FORMAT_ND, {1, elem_num}, DT_FLOAT),
+      MakeTrans(CAST, FORMAT_ND, {1, elem_num}, DT_FLOAT, FORMAT_ND, {1, elem_num}, DT_FLOAT16)};
+  vector<uint8_t> src = MakeFloatData(elem_num);
+  vector<uint8_t> expect = TransWhole(src, trans_road);
+  ASSERT_EQ(expect.size(), elem_num * 2);
+
+  VarTransfer transfer(1, 1000);
+  InitTransfer(transfer);
+  vector<uint8_t> dst(expect.size());
+  VarTransferCost cost;
+  ASSERT_EQ(transfer.Transfer("var", src.data(), src.size(), trans_road, dst.data(), dst.size(), cost), SUCCESS);
+  EXPECT_EQ(dst, expect);
+  // 250 float elements in a chunk
+  EXPECT_EQ(cost.chunk_num, (elem_num + 249) / 250);
+
+  // written back in place, the chunks shrink
+  ASSERT_EQ(transfer.Transfer("var", src.data(), src.size(), trans_road, src.data(), src.size(), cost), SUCCESS);
+  EXPECT_EQ(vector<uint8_t>(src.begin(), src.begin() + expect.size()), expect);
+
+  // too small to hold the result
+  EXPECT_EQ(transfer.Transfer("var", src.data(), src.size(), trans_road, dst.data(), dst.size() - 1, cost),
+            PARAM_INVALID);
+}
+
+TEST_F(UtestTransVarDataUtils, cast_growing_in_place_same_as_whole) {
+  const int64_t elem_num = 3001;
+  VarTransRoad to_half = {MakeTrans(CAST, FORMAT_ND, {elem_num}, DT_FLOAT, FORMAT_ND, {elem_num}, DT_FLOAT16)};
+  VarTransRoad to_float = {MakeTrans(CAST, FORMAT_ND, {elem_num}, DT_FLOAT16, FORMAT_ND, {elem_num}, DT_FLOAT)};
+  vector<uint8_t> half = TransWhole(MakeFloatData(elem_num), to_half);
+  vector<uint8_t> expect = TransWhole(half, to_float);
+
+  // the chunks written would overwrite the ones not read yet, so it is read as a whole first
+  vector<uint8_t> buffer(elem_num * sizeof(float));
+  memcpy(buffer.data(), half.data(), half.size());
+  VarTransfer transfer(1, 512);
+  InitTransfer(transfer);
+  VarTransferCost cost;
+  ASSERT_EQ(transfer.Transfer("var", buffer.data(), half.size(), to_float, buffer.data(), buffer.size(), cost),
+            SUCCESS);
+  EXPECT_EQ(buffer, expect);
+}
+
+TEST_F(UtestTransVarDataUtils, trans_format_same_as_whole) {
+  VarTransRoad trans_road = {
+      MakeTrans(CAST, FORMAT_NCHW, {2, 20, 7, 7}, DT_FLOAT, FORMAT_NCHW, {2, 20, 7, 7}, DT_FLOAT16),
+      MakeTrans(TRANSDATA, FORMAT_NCHW, {2, 20, 7, 7}, DT_FLOAT16, FORMAT_NC1HWC0, {2, 2, 7, 7, 16}, DT_FLOAT16)};
+  vector<uint8_t> src = MakeFloatData(2 * 20 * 7 * 7);
+  vector<uint8_t> expect = TransWhole(src, trans_road);
+  ASSERT_EQ(expect.size(), 2 * 2 * 7 * 7 * 16 * 2);
+
+  VarTransfer transfer(1, 256);
+  InitTransfer(transfer);
+  vector<uint8_t> dst(expect.size());
+  VarTransferCost cost;
+  ASSERT_EQ(transfer.Transfer("var", src.data(), src.size(), trans_road, dst.data(), dst.size(), cost), SUCCESS);
+  EXPECT_EQ(dst, expect);
+  EXPECT_EQ(cost.chunk_num, (src.size() + 255) / 256);
+}
+
+TEST_F(UtestTransVarDataUtils, transfers_share_lanes) {
+  const size_t var_num = 16;
+  const size_t thread_num = 4;
+  VarTransRoad to_half = {MakeTrans(CAST, FORMAT_ND, {4099}, DT_FLOAT, FORMAT_ND, {4099}, DT_FLOAT16)};
+  VarTransRoad copy_road;
+  vector<vector<uint8_t>> srcs;
+  vector<vector<uint8_t>> expects;
+  vector<vector<uint8_t>> dsts;
+  for (size_t i = 0; i < var_num; ++i) {
+    srcs.push_back(MakeFloatData(4099 + i));
+    expects.push_back((i % 2 == 0) ? TransWhole(vector<uint8_t>(srcs[i].begin(), srcs[i].begin() + 4099 * 4), to_half)
+                                   : srcs[i]);
+    dsts.emplace_back(expects[i].size());
+  }
+
+  VarTransfer transfer(2, 1024);
+  transfer.copy_func_ = OverlappedMemcpyAsync;
+  overlap_threads.clear();
+  vector<thread> threads;
+  for (size_t t = 0; t < thread_num; ++t) {
+    threads.emplace_back([&, t]() {
+      for (size_t i = t; i < var_num; i += thread_num) {
+        VarTransferCost cost;
+        size_t src_size = (i % 2 == 0) ? 4099 * 4 : srcs[i].size();
+        EXPECT_EQ(transfer.Transfer("var" + to_string(i), srcs[i].data(), src_size,
+                                    (i % 2 == 0) ? to_half : copy_road, dsts[i].data(), dsts[i].size(), cost),
+                  SUCCESS);
+      }
+    });
+  }
+  for (auto &worker : threads) {
+    worker.join();
+  }
+  for (size_t i = 0; i < var_num; ++i) {
+    EXPECT_EQ(dsts[i], expects[i]);
+  }
+  // the lanes are created once and reused by the other transfers
+  EXPECT_EQ(transfer.lanes_.size(), 2);
+  EXPECT_EQ(transfer.free_lanes_.size(), 2);
+}
+
+TEST_F(UtestTransVarDataUtils, broadcast_transfer_shared) {
+  const uint64_t session_id = 1234;
+  VarManager *var_manager = VarManager::Instance(session_id);
+  ASSERT_NE(var_manager, nullptr);
+  VarTransfer *transfer = nullptr;
+  ASSERT_EQ(TransVarDataUtils::GetBroadCastTransfer(session_id, transfer), SUCCESS);
+  ASSERT_NE(transfer, nullptr);
+  VarTransfer *shared_transfer = nullptr;
+  ASSERT_EQ(TransVarDataUtils::GetBroadCastTransfer(session_id, shared_transfer), SUCCESS);
+  EXPECT_EQ(shared_transfer, transfer);
+
+  var_manager->Destroy();
+  EXPECT_EQ(var_manager->broadcast_transfer_, nullptr);
+}
+
+TEST_F(UtestTransVarDataUtils, DISABLED_benchmark_trans_var) {
+  const int64_t elem_num = 64 * 1024 * 1024;
+  VarTransRoad trans_road = {MakeTrans(CAST, FORMAT_ND, {elem_num}, DT_FLOAT, FORMAT_ND, {elem_num}, DT_FLOAT16)};
+  vector<uint8_t> src = MakeFloatData(elem_num);
+  vector<uint8_t> dst(elem_num * 2);
+
+  // the whole variable to host, converted and back
+  auto start = chrono::steady_clock::now();
+  vector<uint8_t> host(src.size());
+  HostMemcpyAsync(host.data(), host.size(), src.data(), src.size(), RT_MEMCPY_DEVICE_TO_HOST, nullptr);
+  formats::TransResult result{};
+  ASSERT_EQ(TransVarDataUtils::TransVarOnHost(host.data(), trans_road, result), SUCCESS);
+  HostMemcpyAsync(dst.data(), dst.size(), result.data.get(), result.length, RT_MEMCPY_HOST_TO_DEVICE, nullptr);
+  auto cost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+  cout << "trans " << src.size() << " bytes as a whole cost " << cost << " ms" << endl;
+
+  VarTransfer transfer;
+  InitTransfer(transfer);
+  VarTransferCost transfer_cost;
+  start = chrono::steady_clock::now();
+  ASSERT_EQ(transfer.Transfer("var", src.data(), src.size(), trans_road, dst.data(), dst.size(), transfer_cost),
+            SUCCESS);
+  cost = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+  cout << "trans " << src.size() << " bytes by chunk cost " << cost << " ms" << endl;
+}
+}  // namespace ge
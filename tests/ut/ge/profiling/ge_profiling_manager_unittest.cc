@@ -116,7 +116,7 @@ TEST_F(UtestGeProfilinganager, report_profiling_data_success) {
   map<uint32_t, string> op_task_id_map;
   op_task_id_map[0] = "conv";
   op_task_id_map.insert(pair<uint32_t, string>(1, "mul"));
-  ProfilingManager::Instance().ReportProfilingData(op_task_id_map);
+  ProfilingManager::Instance().ReportProfilingData(1, 0, op_task_id_map);
 }
 
 TEST_F(UtestGeProfilinganager, plugin_impl_success) {
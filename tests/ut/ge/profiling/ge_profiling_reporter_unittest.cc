@@ -0,0 +1,282 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/profiling/profiling_reporter.h"
+
+using namespace ge;
+using namespace std;
+
+namespace {
+struct ReportHead {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t reserved;
+  uint32_t model_id;
+  uint32_t num;
+};
+
+class RecordReporter : public Msprof::Engine::Reporter {
+ public:
+  int Report(const Msprof::Engine::ReporterData *data) {
+    lock_guard<mutex> lock(mutex_);
+    if (fail_) {
+      return -1;
+    }
+    tags_.emplace_back(data->tag);
+    datas_.emplace_back(data->data, data->data + data->dataLen);
+    return 0;
+  }
+
+  int Flush() { return 0; }
+
+  // records of the run batches sent
+  vector<ProfilingRunRecord> GetRecords() {
+    lock_guard<mutex> lock(mutex_);
+    vector<ProfilingRunRecord> records;
+    for (size_t i = 0; i < datas_.size(); ++i) {
+      if (tags_[i] != "framework_model_run") {
+        continue;
+      }
+      ReportHead head;
+      memcpy(&head, datas_[i].data(), sizeof(head));
+      EXPECT_EQ(datas_[i].size(), sizeof(head) + head.num * sizeof(ProfilingRunRecord));
+      EXPECT_LE(head.num, ProfilingReporter::kBatchSize);
+      auto begin = reinterpret_cast<const ProfilingRunRecord *>(datas_[i].data() + sizeof(head));
+      records.insert(records.end(), begin, begin + head.num);
+    }
+    return records;
+  }
+
+  mutex mutex_;
+  bool fail_ = false;
+  vector<string> tags_;
+  vector<vector<uint8_t>> datas_;
+};
+
+// task id to op name of every task table sent
+map<uint32_t, string> ParseTaskTables(const RecordReporter &reporter, uint32_t model_id, size_t &blob_num) {
+  map<uint32_t, string> op_task_id_map;
+  blob_num = 0;
+  for (size_t i = 0; i < reporter.datas_.size(); ++i) {
+    if (reporter.tags_[i] != "framework_task_table") {
+      continue;
+    }
+    const vector<uint8_t> &data = reporter.datas_[i];
+    ReportHead head;
+    memcpy(&head, data.data(), sizeof(head));
+    EXPECT_EQ(head.model_id, model_id);
+    ++blob_num;
+    size_t offset = sizeof(head);
+    for (uint32_t j = 0; j < head.num; ++j) {
+      uint32_t task_id = 0;
+      uint16_t name_len = 0;
+      memcpy(&task_id, data.data() + offset, sizeof(task_id));
+      memcpy(&name_len, data.data() + offset + sizeof(task_id), sizeof(name_len));
+      offset += sizeof(task_id) + sizeof(name_len);
+      op_task_id_map[task_id] = string(reinterpret_cast<const char *>(data.data() + offset), name_len);
+      offset += name_len;
+    }
+    EXPECT_EQ(offset, data.size());
+  }
+  return op_task_id_map;
+}
+}  // namespace
+
+class UtestGeProfilingReporter : public testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(UtestGeProfilingReporter, task_table_sent_once_per_session) {
+  map<uint32_t, string> op_task_id_map;
+  for (uint32_t i = 0; i < 10000; ++i) {
+    op_task_id_map[i] = "model/layer_" + to_string(i) + "/conv";
+  }
+  RecordReporter reporter;
+  ProfilingReporter run_reporter;
+  // nothing is sent before the session starts
+  EXPECT_EQ(run_reporter.ReportTaskTable(1, op_task_id_map), SUCCESS);
+  EXPECT_FALSE(run_reporter.Push({1, 0, 0}));
+  EXPECT_TRUE(reporter.datas_.empty());
+
+  EXPECT_EQ(run_reporter.Start(&reporter, 0), SUCCESS);
+  EXPECT_EQ(run_reporter.ReportTaskTable(1, op_task_id_map), SUCCESS);
+  EXPECT_EQ(run_reporter.ReportTaskTable(1, op_task_id_map), SUCCESS);
+  size_t blob_num = 0;
+  EXPECT_EQ(ParseTaskTables(reporter, 1, blob_num), op_task_id_map);
+  // split into blobs the profiler takes
+  EXPECT_GT(blob_num, 1);
+  EXPECT_LT(blob_num, 10);
+
+  // a new session sends it again
+  run_reporter.Stop();
+  EXPECT_EQ(run_reporter.Start(&reporter, 0), SUCCESS);
+  EXPECT_EQ(run_reporter.ReportTaskTable(1, op_task_id_map), SUCCESS);
+  size_t second_blob_num = 0;
+  (void)ParseTaskTables(reporter, 1, second_blob_num);
+  EXPECT_EQ(second_blob_num, blob_num * 2);
+  run_reporter.Stop();
+}
+
+TEST_F(UtestGeProfilingReporter, task_table_of_models_sharing_cache_slot) {
+  map<uint32_t, string> op_task_id_map = {{0, "conv"}, {1, "relu"}};
+  auto table_num = [](const RecordReporter &reporter) {
+    return count(reporter.tags_.begin(), reporter.tags_.end(), string("framework_task_table"));
+  };
+  RecordReporter reporter;
+  ProfilingReporter run_reporter;
+  EXPECT_EQ(run_reporter.Start(&reporter, 0), SUCCESS);
+
+  // a failed send is retried by the next run
+  reporter.fail_ = true;
+  EXPECT_EQ(run_reporter.ReportTaskTable(1, op_task_id_map), FAILED);
+  reporter.fail_ = false;
+  EXPECT_EQ(run_reporter.ReportTaskTable(1, op_task_id_map), SUCCESS);
+  EXPECT_EQ(table_num(reporter), 1);
+
+  // the models take turns on one slot of the cache
+  uint32_t other_model = 1 + ProfilingReporter::kReportedCacheSize;
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(run_reporter.ReportTaskTable(1, op_task_id_map), SUCCESS);
+    EXPECT_EQ(run_reporter.ReportTaskTable(other_model, op_task_id_map), SUCCESS);
+  }
+  EXPECT_EQ(table_num(reporter), 2);
+
+  // the cache of the former session is not taken by the new one
+  run_reporter.Stop();
+  EXPECT_EQ(run_reporter.Start(&reporter, 0), SUCCESS);
+  EXPECT_EQ(run_reporter.ReportTaskTable(other_model, op_task_id_map), SUCCESS);
+  EXPECT_EQ(run_reporter.ReportTaskTable(other_model, op_task_id_map), SUCCESS);
+  EXPECT_EQ(table_num(reporter), 3);
+  run_reporter.Stop();
+}
+
+TEST_F(UtestGeProfilingReporter, records_sent_in_batches) {
+  RecordReporter reporter;
+  ProfilingReporter run_reporter;
+  EXPECT_EQ(run_reporter.Start(&reporter, 0), SUCCESS);
+
+  // producers of several models at the same time
+  const uint32_t thread_num = 4;
+  const uint32_t record_num = 1000;
+  vector<thread> threads;
+  for (uint32_t model_id = 0; model_id < thread_num; ++model_id) {
+    threads.emplace_back([&run_reporter, model_id, record_num]() {
+      for (uint32_t i = 0; i < record_num; ++i) {
+        while (!run_reporter.Push({model_id, i, 0})) {
+          this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto &producer : threads) {
+    producer.join();
+  }
+  run_reporter.Stop();
+
+  vector<ProfilingRunRecord> records = reporter.GetRecords();
+  ASSERT_EQ(records.size(), thread_num * record_num);
+  EXPECT_LT(reporter.datas_.size(), records.size() / 16);
+  // the records of a producer keep their order
+  vector<uint32_t> next_indexes(thread_num, 0);
+  for (const auto &record : records) {
+    ASSERT_LT(record.model_id, thread_num);
+    EXPECT_EQ(record.data_index, next_indexes[record.model_id]++);
+  }
+  ProfilingReportStats stats = run_reporter.GetStats();
+  EXPECT_EQ(stats.reported_num, thread_num * record_num);
+  EXPECT_EQ(stats.drop_num, 0);
+}
+
+TEST_F(UtestGeProfilingReporter, overflow_and_drop_counted) {
+  RecordReporter reporter;
+  ProfilingReporter run_reporter(16);
+  reporter.fail_ = true;
+  EXPECT_EQ(run_reporter.Start(&reporter, 0), SUCCESS);
+  size_t pushed = 0;
+  for (uint32_t i = 0; i < 100; ++i) {
+    pushed += run_reporter.Push({0, i, 0}) ? 1 : 0;
+  }
+  EXPECT_GE(pushed, 16);
+  run_reporter.Flush();
+  ProfilingReportStats stats = run_reporter.GetStats();
+  EXPECT_EQ(stats.overflow_num + pushed, 100);
+  EXPECT_EQ(stats.drop_num, pushed);
+  EXPECT_EQ(stats.reported_num, 0);
+
+  {
+    lock_guard<mutex> lock(reporter.mutex_);
+    reporter.fail_ = false;
+  }
+  EXPECT_TRUE(run_reporter.Push({0, 100, 0}));
+  run_reporter.Stop();
+  EXPECT_EQ(run_reporter.GetStats().reported_num, 1);
+  ASSERT_EQ(reporter.GetRecords().size(), 1);
+  EXPECT_EQ(reporter.GetRecords()[0].data_index, 100);
+}
+
+TEST_F(UtestGeProfilingReporter, DISABLED_benchmark_report_runs) {
+  const uint32_t op_num = 10000;
+  const uint32_t run_num = 100;
+  map<uint32_t, string> op_task_id_map;
+  for (uint32_t i = 0; i < op_num; ++i) {
+    op_task_id_map[i] = "model/layer_" + to_string(i) + "/conv";
+  }
+  RecordReporter reporter;
+
+  // one string and one report per op on every run
+  auto start = chrono::steady_clock::now();
+  for (uint32_t run = 0; run < run_num; ++run) {
+    string data;
+    for (const auto &iter : op_task_id_map) {
+      data = iter.second + ' ' + to_string(iter.first) + ';';
+      Msprof::Engine::ReporterData reporter_data{};
+      reporter_data.data = (unsigned char *)data.c_str();
+      reporter_data.dataLen = data.size();
+      strncpy(reporter_data.tag, "framework", MSPROF_ENGINE_MAX_TAG_LEN);
+      reporter.Report(&reporter_data);
+    }
+  }
+  auto cost = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count() / run_num;
+  cout << "report " << op_num << " ops per run cost " << cost << " us" << endl;
+
+  reporter.tags_.clear();
+  reporter.datas_.clear();
+  ProfilingReporter run_reporter;
+  ASSERT_EQ(run_reporter.Start(&reporter, 0), SUCCESS);
+  start = chrono::steady_clock::now();
+  for (uint32_t run = 0; run < run_num; ++run) {
+    ASSERT_EQ(run_reporter.ReportTaskTable(1, op_task_id_map), SUCCESS);
+    run_reporter.Push({1, run, 0});
+  }
+  cost = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count() / run_num;
+  cout << "report table once and a record per run cost " << cost << " us" << endl;
+  run_reporter.Stop();
+}
@@ -15,6 +15,9 @@
  */
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <thread>
 #include <vector>
 
 #include "cce/taskdown_common.hpp"
@@ -37,11 +40,29 @@ class UtestSingleOpManager : public testing::Test {
   void TearDown() {}
 };
 
+namespace {
+// an op of one kernel reading one input and writing one output
+SingleOp *CreateOp(rtStream_t stream) {
+  auto *op = new SingleOp();
+  auto *task = new TbeOpTask();
+  void *args = nullptr;
+  EXPECT_EQ(rtMallocHost(&args, 2 * sizeof(uintptr_t)), RT_ERROR_NONE);
+  task->SetKernelArgs(args, 2 * sizeof(uintptr_t), 1);
+  op->tasks_.push_back(task);
+  op->input_sizes_ = {64};
+  op->output_sizes_ = {64};
+  op->args_.resize(2);
+  op->arg_table_ = {{reinterpret_cast<uintptr_t *>(args)}, {reinterpret_cast<uintptr_t *>(args) + 1}};
+  op->SetStream(stream);
+  return op;
+}
+}  // namespace
+
 TEST_F(UtestSingleOpManager, test_get_resource) {
   uintptr_t resource_id = 0x1;
   auto &instance = SingleOpManager::GetInstance();
   ASSERT_EQ(instance.TryGetResource(resource_id), nullptr);
-  ASSERT_NE(instance.GetResource(resource_id), nullptr);
+  ASSERT_NE(instance.GetResource(resource_id, (rtStream_t)resource_id), nullptr);
 }
 
 TEST_F(UtestSingleOpManager, test_get_op_from_model) {
@@ -56,7 +77,7 @@ TEST_F(UtestSingleOpManager, test_get_op_from_model) {
   model_data.model_len = model_str.size();
 
   ASSERT_EQ(instance.GetOpFromModel("model", model_data, stream, &single_op), FAILED);
-  ASSERT_EQ(instance.GetResource(resource_id)->GetOperator(model_data.model_data), nullptr);
+  ASSERT_EQ(instance.GetResource(resource_id, stream)->GetOperator(model_data.model_data), nullptr);
 }
 
 TEST_F(UtestSingleOpManager, test_relesase_resource) {
@@ -64,8 +85,13 @@ TEST_F(UtestSingleOpManager, test_relesase_resource) {
   auto &instance = SingleOpManager::GetInstance();
 
   ASSERT_EQ(instance.ReleaseResource(stream), SUCCESS);
-  instance.GetResource(0x99);
+  StreamResource *res = instance.GetResource(0x99, stream);
+  ASSERT_NE(res, nullptr);
+  ASSERT_NE(res->MallocMemory(4000), nullptr);
   ASSERT_EQ(instance.ReleaseResource(stream), SUCCESS);
+  // the memory of the stream is not left cached
+  EXPECT_EQ(instance.allocator_.GetStats().cached_size, 0);
+  EXPECT_EQ(instance.allocator_.GetStats().in_use_size, 0);
 }
 
 TEST_F(UtestSingleOpManager, test_get_op_from_model_with_null_stream) {
@@ -92,4 +118,85 @@ TEST_F(UtestSingleOpManager, get_resource_failed) {
   auto &instance = SingleOpManager::GetInstance();
 
   ASSERT_EQ(instance.GetOpFromModel("model", model_data, stream, &single_op), FAILED);
-}
\ No newline at end of file
+}
+
+TEST_F(UtestSingleOpManager, thread_cached_op) {
+  auto stream = (rtStream_t)0x77;
+  uintptr_t resource_id = 0x77;
+  auto &instance = SingleOpManager::GetInstance();
+  string model_str = "thread_cached_op";
+  ModelData model_data;
+  model_data.model_data = (void *)model_str.c_str();
+  model_data.model_len = model_str.size();
+  SingleOp *op = CreateOp(stream);
+  instance.GetResource(resource_id, stream)->CacheOperator(model_data.model_data, op);
+
+  SingleOp *single_op = nullptr;
+  ASSERT_EQ(instance.GetOpFromModel("model", model_data, stream, &single_op), SUCCESS);
+  EXPECT_EQ(single_op, op);
+  uint64_t generation = instance.generation_.load();
+  EXPECT_EQ(instance.GetThreadCachedOp(resource_id, model_data.model_data, generation), op);
+
+  // cached by the thread only
+  thread other([&]() {
+    EXPECT_EQ(instance.GetThreadCachedOp(resource_id, model_data.model_data, generation), nullptr);
+  });
+  other.join();
+
+  // dropped once a resource is released
+  ASSERT_EQ(instance.ReleaseResource(stream), SUCCESS);
+  EXPECT_EQ(instance.GetThreadCachedOp(resource_id, model_data.model_data, instance.generation_.load()), nullptr);
+}
+
+TEST_F(UtestSingleOpManager, DISABLED_benchmark_launch_rate) {
+  const int thread_num = 8;
+  const int launch_num = 200000;
+  auto &instance = SingleOpManager::GetInstance();
+  string model_str = "benchmark_launch_rate";
+  ModelData model_data;
+  model_data.model_data = (void *)model_str.c_str();
+  model_data.model_len = model_str.size();
+  for (int t = 0; t < thread_num; ++t) {
+    auto stream = (rtStream_t)(0x1000 + t);
+    instance.GetResource(0x1000 + t, stream)->CacheOperator(model_data.model_data, CreateOp(stream));
+  }
+
+  auto run = [&](bool locked) {
+    vector<thread> threads;
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < thread_num; ++t) {
+      threads.emplace_back([&, t]() {
+        auto stream = (rtStream_t)(0x1000 + t);
+        uint8_t buffers[4][64];
+        vector<DataBuffer> inputs(1);
+        vector<DataBuffer> outputs(1);
+        for (int i = 0; i < launch_num; ++i) {
+          SingleOp *op = nullptr;
+          if (locked) {
+            // the lookups of every launch under the locks
+            StreamResource *res = instance.GetResource(0x1000 + t, stream);
+            lock_guard<mutex> lock(res->GetMutex());
+            op = res->GetOperator(model_data.model_data);
+          } else {
+            (void)instance.GetOpFromModel("model", model_data, stream, &op);
+          }
+          inputs[0] = DataBuffer(buffers[i % 2], 64, false);
+          outputs[0] = DataBuffer(buffers[2 + i % 2], 64, false);
+          EXPECT_EQ(op->ExecuteAsync(inputs, outputs), SUCCESS);
+        }
+      });
+    }
+    for (auto &worker : threads) {
+      worker.join();
+    }
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+  };
+  auto cost = run(true);
+  cout << thread_num << " threads, " << launch_num << " locked launches each cost " << cost << " ms" << endl;
+  cost = run(false);
+  cout << thread_num << " threads, " << launch_num << " thread cached launches each cost " << cost << " ms" << endl;
+
+  for (int t = 0; t < thread_num; ++t) {
+    (void)instance.ReleaseResource((rtStream_t)(0x1000 + t));
+  }
+}
@@ -0,0 +1,68 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "runtime/rt.h"
+
+#define protected public
+#define private public
+#include "single_op/single_op.h"
+#undef private
+#undef protected
+
+using namespace std;
+using namespace testing;
+using namespace ge;
+
+class UtestSingleOp : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+TEST_F(UtestSingleOp, update_args_patches_changed_ones) {
+  SingleOp op;
+  op.input_sizes_ = {64};
+  op.output_sizes_ = {64};
+  op.args_.resize(2);
+  // the input is read by two tasks
+  uintptr_t task_args[3] = {0};
+  op.arg_table_ = {{&task_args[0], &task_args[2]}, {&task_args[1]}};
+
+  uint8_t input[64];
+  uint8_t output[64];
+  uint8_t other_output[64];
+  vector<DataBuffer> inputs = {DataBuffer(input, sizeof(input), false)};
+  vector<DataBuffer> outputs = {DataBuffer(output, sizeof(output), false)};
+  ASSERT_EQ(op.ExecuteAsync(inputs, outputs), SUCCESS);
+  EXPECT_EQ(op.arg_offsets_, vector<size_t>({0, 2, 3}));
+  EXPECT_EQ(task_args[0], reinterpret_cast<uintptr_t>(input));
+  EXPECT_EQ(task_args[1], reinterpret_cast<uintptr_t>(output));
+  EXPECT_EQ(task_args[2], reinterpret_cast<uintptr_t>(input));
+
+  // the addresses given again are not written
+  task_args[0] = 0;
+  outputs[0].data = other_output;
+  ASSERT_EQ(op.ExecuteAsync(inputs, outputs), SUCCESS);
+  EXPECT_EQ(task_args[0], 0);
+  EXPECT_EQ(task_args[1], reinterpret_cast<uintptr_t>(other_output));
+
+  outputs.clear();
+  EXPECT_EQ(op.ExecuteAsync(inputs, outputs), PARAM_INVALID);
+}
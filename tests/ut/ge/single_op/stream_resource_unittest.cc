@@ -36,10 +36,11 @@ class UtestStreamResource : public testing::Test {
   void TearDown() {}
 
   rtStream_t stream;
+  CachingAllocator allocator{RT_MEMORY_HBM, false, 1024UL * 1024UL};
 };
 
 TEST_F(UtestStreamResource, test_cache_op) {
-  StreamResource res;
+  StreamResource res(nullptr, allocator);
   auto *op = new SingleOp();
   string stub_name = "stubFunc";
   const void *key = stub_name.c_str();
@@ -49,7 +50,7 @@ TEST_F(UtestStreamResource, test_cache_op) {
 }
 
 TEST_F(UtestStreamResource, test_malloc_memory) {
-  StreamResource res;
+  StreamResource res(nullptr, allocator);
 
   ASSERT_NE(res.MallocMemory(100), nullptr);
   ASSERT_NE(res.MallocMemory(100), nullptr);
@@ -57,21 +58,47 @@ TEST_F(UtestStreamResource, test_malloc_memory) {
 }
 
 TEST_F(UtestStreamResource, test_do_malloc_memory) {
+  StreamResource res(nullptr, allocator);
   size_t max_allocated = 0;
   vector<uint8_t *> allocated;
 
-  uint8_t *ret = StreamResource::DoMallocMemory(100, max_allocated, allocated);
+  uint8_t *ret = res.DoMallocMemory(100, max_allocated, allocated);
   ASSERT_EQ(allocated.size(), 1);
   ASSERT_NE(allocated.back(), nullptr);
   ASSERT_EQ(max_allocated, 100);
 
-  StreamResource::DoMallocMemory(50, max_allocated, allocated);
-  StreamResource::DoMallocMemory(99, max_allocated, allocated);
-  StreamResource::DoMallocMemory(100, max_allocated, allocated);
+  res.DoMallocMemory(50, max_allocated, allocated);
+  res.DoMallocMemory(99, max_allocated, allocated);
+  res.DoMallocMemory(100, max_allocated, allocated);
   ASSERT_EQ(allocated.size(), 1);
   ASSERT_EQ(max_allocated, 100);
 
-  StreamResource::DoMallocMemory(101, max_allocated, allocated);
+  res.DoMallocMemory(101, max_allocated, allocated);
   ASSERT_EQ(allocated.size(), 2);
   ASSERT_EQ(max_allocated, 101);
+  res.FreeMemory(allocated);
+  ASSERT_TRUE(allocated.empty());
+}
+
+TEST_F(UtestStreamResource, test_memory_reused_by_other_stream) {
+  rtStream_t stream1 = nullptr;
+  rtStream_t stream2 = nullptr;
+  ASSERT_EQ(rtStreamCreate(&stream1, 0), RT_ERROR_NONE);
+  ASSERT_EQ(rtStreamCreate(&stream2, 0), RT_ERROR_NONE);
+
+  uint8_t *memory = nullptr;
+  {
+    StreamResource res(stream1, allocator);
+    memory = res.MallocMemory(4000);
+    ASSERT_NE(memory, nullptr);
+  }
+  // the block waits for the tasks of stream1 before stream2 takes it
+  CachingAllocatorStats stats = allocator.GetStats();
+  StreamResource res(stream2, allocator);
+  EXPECT_EQ(res.MallocMemory(3900), memory);
+  EXPECT_EQ(allocator.GetStats().hit_num, stats.hit_num + 1);
+  EXPECT_EQ(allocator.GetStats().rt_malloc_num, stats.rt_malloc_num);
+
+  EXPECT_EQ(rtStreamDestroy(stream1), RT_ERROR_NONE);
+  EXPECT_EQ(rtStreamDestroy(stream2), RT_ERROR_NONE);
 }